@@ -12,6 +12,7 @@
 
 #include "sea_types.h"
 #include "sea_arena.h"
+#include "sea_db.h"
 
 /* ── Message Types ───────────────────────────────────────── */
 
@@ -49,11 +50,39 @@ typedef struct {
     bool        success;
     const char* output;     /* Result text */
     u32         latency_ms;
+    u64         latency_us; /* Monotonic, request start to answer */
     const char* agent_name; /* Which agent handled it */
     bool        verified;   /* Shield-verified output */
     const char* error;      /* Error message if !success */
+    u32         votes;      /* Peers that returned this output */
 } SeaA2aResult;
 
+/* ── Multi-peer Delegation ───────────────────────────────── */
+
+typedef enum {
+    SEA_A2A_FIRST_SUCCESS = 0,  /* First verified success wins; the rest are cancelled */
+    SEA_A2A_QUORUM        = 1,  /* Succeed once `quorum` peers return the same output  */
+} SeaA2aMode;
+
+typedef struct {
+    SeaA2aMode mode;
+    u32        quorum;      /* QUORUM: agreeing answers required (k of n) */
+    u32        fanout;      /* Peers to ask, best-ranked first; 0 = all   */
+} SeaA2aPolicy;
+
+/* ── Peer Latency Stats ──────────────────────────────────── */
+
+#define SEA_A2A_HIST_BUCKETS 104   /* Log-linear, 4 per power of two (µs) */
+#define SEA_A2A_MAX_TRACKED  64    /* Peers with a histogram              */
+
+typedef struct {
+    u64 samples;            /* Successful answers timed */
+    u64 failures;           /* Errors, timeouts, rejected output */
+    u64 p50_us;
+    u64 p90_us;
+    u64 p99_us;
+} SeaA2aPeerStats;
+
 /* ── API ──────────────────────────────────────────────────── */
 
 /* Delegate a task to a remote agent.
@@ -63,6 +92,110 @@ SeaA2aResult sea_a2a_delegate(const SeaA2aPeer* peer,
                                const SeaA2aRequest* req,
                                SeaArena* arena);
 
+/* Delegate to several peers at once, each bounded by req->timeout_ms.
+ * FIRST_SUCCESS returns the first verified success and cancels the
+ * other requests; QUORUM returns once `quorum` peers agree on the
+ * output (votes), and gives up as soon as that can no longer happen.
+ * With a fanout below count, the best-ranked peers are asked. If
+ * per_peer is given (count entries), it receives each peer's outcome
+ * in input order; peers cut off early report error "Cancelled",
+ * peers beyond the fanout "Not asked". */
+SeaA2aResult sea_a2a_delegate_multi(const SeaA2aPeer* peers, u32 count,
+                                    const SeaA2aRequest* req,
+                                    const SeaA2aPolicy* policy,
+                                    SeaArena* arena, SeaA2aResult* per_peer);
+
+/* Latency percentiles and failures recorded for a peer (keyed by
+ * endpoint). Returns false if the peer has never been asked. */
+bool sea_a2a_peer_stats(const SeaA2aPeer* peer, SeaA2aPeerStats* out);
+
+/* Order peers best-first into order[count]: p90 latency scaled up by
+ * the failure rate. Peers never measured come first, so they get
+ * measured. */
+void sea_a2a_rank_peers(const SeaA2aPeer* peers, u32 count, u32* order);
+
+/* Forget all recorded latencies. */
+void sea_a2a_stats_reset(void);
+
+/* ── Peer Registry ───────────────────────────────────────── */
+/*
+ * Long-lived view of known peers. Discovery results are cached for a
+ * TTL; a background thread heartbeats every peer on an interval and
+ * backs off exponentially while a peer keeps failing. Health, latency
+ * and capabilities are kept in memory and mirrored to SQLite, so a
+ * restart starts warm and delegation never probes on the request path.
+ */
+
+#define SEA_A2A_REGISTRY_MAX       64
+#define SEA_A2A_CAPS_MAX           16
+#define SEA_A2A_CAP_NAME_MAX       32
+#define SEA_A2A_DISCOVERY_TTL_SEC  300
+#define SEA_A2A_PROBE_INTERVAL_MS  15000
+#define SEA_A2A_PROBE_BACKOFF_MS   600000   /* Cap on a failing peer's delay */
+#define SEA_A2A_PROBE_TIMEOUT_MS   3000
+
+typedef struct SeaA2aRegistry SeaA2aRegistry;
+
+typedef struct {
+    const char* discovery_url;    /* NULL = only peers added by hand    */
+    u32         ttl_sec;          /* 0 = SEA_A2A_DISCOVERY_TTL_SEC      */
+    u32         interval_ms;      /* 0 = SEA_A2A_PROBE_INTERVAL_MS      */
+    u32         backoff_max_ms;   /* 0 = SEA_A2A_PROBE_BACKOFF_MS       */
+    u32         probe_timeout_ms; /* 0 = SEA_A2A_PROBE_TIMEOUT_MS       */
+} SeaA2aRegistryConfig;
+
+typedef struct {
+    char name[64];
+    char endpoint[256];
+    char api_key[128];
+    char caps[SEA_A2A_CAPS_MAX][SEA_A2A_CAP_NAME_MAX];
+    u32  cap_count;
+    bool healthy;
+    u32  fail_streak;       /* Consecutive failed probes or delegations  */
+    u64  last_seen;         /* Epoch seconds of the last success; 0 = never */
+    u64  next_probe_ms;     /* Monotonic deadline of the next heartbeat  */
+    u64  latency_us;        /* EWMA of heartbeat round trips             */
+    u64  probes;
+    u64  probe_failures;
+} SeaA2aRegistryPeer;
+
+/* Create a registry; with a db, restores the peers and the discovery
+ * timestamp saved by a previous run. cfg may be NULL for defaults. */
+SeaError sea_a2a_registry_create(SeaA2aRegistry** out, SeaDb* db,
+                                 const SeaA2aRegistryConfig* cfg);
+
+/* Stop the probe thread, save state and free. */
+void sea_a2a_registry_destroy(SeaA2aRegistry* reg);
+
+/* Add or update a peer by endpoint. New peers are probed next round. */
+SeaError sea_a2a_registry_add(SeaA2aRegistry* reg, const SeaA2aPeer* peer,
+                              const char* const* caps, u32 cap_count);
+
+/* Fetch the discovery URL unless the last fetch is younger than the
+ * TTL (or force). found, if given, receives the agents listed (0 on a
+ * cache hit). */
+SeaError sea_a2a_registry_refresh(SeaA2aRegistry* reg, bool force, u32* found);
+
+/* Heartbeat every peer whose probe is due, concurrently. Returns the
+ * number probed. The background thread calls this on its own. */
+u32 sea_a2a_registry_probe(SeaA2aRegistry* reg);
+
+/* Run refresh and probes on a background thread. */
+SeaError sea_a2a_registry_start(SeaA2aRegistry* reg);
+
+/* Feed a delegation outcome back: failures count like failed probes. */
+void sea_a2a_registry_report(SeaA2aRegistry* reg, const char* endpoint, bool ok);
+
+/* Healthy peers offering capability (NULL = any), best-ranked first.
+ * Strings are copied into arena. Returns count. */
+u32 sea_a2a_registry_pick(SeaA2aRegistry* reg, const char* capability,
+                          SeaA2aPeer* out, u32 max, SeaArena* arena);
+
+/* Copy up to max entries. Returns count. */
+u32 sea_a2a_registry_snapshot(SeaA2aRegistry* reg, SeaA2aRegistryPeer* out, u32 max);
+
+/* ── Single-shot Probes ──────────────────────────────────── */
+
 /* Send heartbeat to a peer. Returns true if peer is alive. */
 bool sea_a2a_heartbeat(const SeaA2aPeer* peer, SeaArena* arena);
 
@@ -5,6 +5,22 @@
  * Zero memory leaks. Zero pauses. Absolute predictability.
  *
  * "Open the notebook. Write sequentially. Rip out the page."
+ *
+ * A growable arena chains further segments when the current one is
+ * full instead of returning NULL. Offsets stay monotonic across the
+ * chain, so saving `offset` and restoring it later still works; the
+ * next allocation steps back into the right segment. On reset, pages
+ * above `retain` are handed back to the kernel (MADV_DONTNEED) and
+ * segments beyond it unmapped, so a rare large request does not pin
+ * its memory for the life of the worker.
+ *
+ * Marks roll back temporary allocations; scratch arenas give a
+ * function per-thread temporary space without mapping memory per call.
+ *
+ * Arenas created with a name join a process-wide registry, so /status
+ * and the benchmarks can show what each subsystem really uses. Built
+ * with SEA_ARENA_SITES (make ARENA_SITES=1), every allocation is also
+ * charged to its file:line.
  */
 
 #ifndef SEA_ARENA_H
@@ -12,21 +28,51 @@
 
 #include "sea_types.h"
 
+#define SEA_ARENA_GROW   (1u << 0)   /* Chain new segments when full          */
+#define SEA_ARENA_HUGE   (1u << 1)   /* Huge pages (MAP_HUGETLB, else THP hint) */
+
+typedef struct SeaArenaSeg SeaArenaSeg;
+
 typedef struct {
-    u8* base;          /* The notebook paper                    */
+    u8* base;          /* The notebook paper (current segment)  */
     u64 size;          /* Total capacity in bytes               */
     u64 offset;        /* Current writing position (bump ptr)   */
     u64 high_water;    /* Peak usage tracker                    */
+    u64 seg_start;     /* Offset at which base begins           */
+    u64 seg_end;       /* Offset at which base ends             */
+    u64 touched;       /* Peak offset since pages were released */
+    u64 retain;        /* Bytes kept resident on reset (0 = all) */
+    u64 max;           /* Growth ceiling (0 = unlimited)        */
+    u64 resets;        /* sea_arena_reset calls                 */
+    u64 failed;        /* Allocations that returned NULL        */
+    u32 flags;
+    SeaArenaSeg* segs; /* Segment chain (growable arenas only)  */
+    SeaArenaSeg* cur;
 } SeaArena;
 
+typedef struct {
+    u64 size;          /* Whole arena, or first segment if growable */
+    u64 max;           /* Growable: total capacity ceiling, 0 = none */
+    u64 retain;        /* Resident bytes kept across reset, 0 = all  */
+    u32 flags;         /* SEA_ARENA_GROW | SEA_ARENA_HUGE            */
+    const char* name;  /* Registry name, NULL = not registered       */
+} SeaArenaConfig;
+
 /* Create arena with given capacity. Returns SEA_OK or SEA_ERR_OOM. */
 SeaError sea_arena_create(SeaArena* arena, u64 size);
 
+/* Same, and list it in the registry under `name`. The arena must not
+ * move while registered (sea_arena_destroy removes it). */
+SeaError sea_arena_create_named(SeaArena* arena, const char* name, u64 size);
+
+/* Create arena from a config (growth, huge pages, page release). */
+SeaError sea_arena_create_ex(SeaArena* arena, const SeaArenaConfig* cfg);
+
 /* Destroy arena and free backing memory. */
 void sea_arena_destroy(SeaArena* arena);
 
 /* Allocate `size` bytes from arena, aligned to `align`.
- * Returns NULL if arena is full. */
+ * Returns NULL if arena is full (and cannot grow). */
 void* sea_arena_alloc(SeaArena* arena, u64 size, u64 align);
 
 /* Convenience: allocate with default alignment (8 bytes). */
@@ -40,19 +86,65 @@ SeaSlice sea_arena_push_cstr(SeaArena* arena, const char* cstr);
 /* Copy raw bytes into the arena. Returns pointer or NULL. */
 void* sea_arena_push_bytes(SeaArena* arena, const void* data, u64 len);
 
-/* Reset arena — instant, one pointer move. Zero residue. */
+/* Give pages above `retain` back to the kernel. Called by reset. */
+void sea_arena_release(SeaArena* arena);
+
+/* Reset arena — instant, one pointer move. Zero residue.
+ * Syscalls only when the last use went past `retain`. */
 static inline void sea_arena_reset(SeaArena* arena) {
     arena->offset = 0;
+    arena->resets++;
+    if (arena->retain && arena->touched > arena->retain) sea_arena_release(arena);
 }
 
+/* ── Marks ────────────────────────────────────────────────── */
+
+typedef struct {
+    u64 offset;
+} SeaArenaMark;
+
+/* Remember the current position. */
+static inline SeaArenaMark sea_arena_mark(const SeaArena* arena) {
+    return (SeaArenaMark){ .offset = arena->offset };
+}
+
+/* Free everything allocated since the mark. */
+static inline void sea_arena_rewind(SeaArena* arena, SeaArenaMark mark) {
+    if (mark.offset < arena->offset) arena->offset = mark.offset;
+}
+
+/* ── Scratch ──────────────────────────────────────────────── */
+
+/* Each thread owns SEA_SCRATCH_COUNT growable scratch arenas, created
+ * on first use and freed at thread exit. Pass the arena the caller
+ * handed you (if any) as `conflict`, so temporary allocations never
+ * land in memory that must outlive the call:
+ *
+ *   SeaScratch tmp = sea_scratch_begin(out_arena);
+ *   ... allocate from tmp.arena, results into out_arena ...
+ *   sea_scratch_end(tmp);
+ */
+#define SEA_SCRATCH_COUNT   2
+#define SEA_SCRATCH_SIZE    (64 * 1024)           /* First segment      */
+#define SEA_SCRATCH_RETAIN  (256 * 1024)          /* Kept across uses   */
+#define SEA_SCRATCH_MAX     (64 * 1024 * 1024)    /* Growth ceiling     */
+
+typedef struct {
+    SeaArena*    arena;     /* NULL if no scratch could be mapped */
+    SeaArenaMark mark;
+} SeaScratch;
+
+SeaScratch sea_scratch_begin(const SeaArena* conflict);
+void       sea_scratch_end(SeaScratch scratch);
+
 /* Query: bytes used */
 static inline u64 sea_arena_used(const SeaArena* arena) {
     return arena->offset;
 }
 
-/* Query: bytes remaining */
+/* Query: bytes remaining (contiguous, without growing) */
 static inline u64 sea_arena_remaining(const SeaArena* arena) {
-    return arena->size - arena->offset;
+    return arena->seg_end > arena->offset ? arena->seg_end - arena->offset : 0;
 }
 
 /* Query: usage percentage (0.0 - 100.0) */
@@ -61,4 +153,62 @@ static inline f64 sea_arena_usage_pct(const SeaArena* arena) {
     return (f64)arena->offset / (f64)arena->size * 100.0;
 }
 
+/* ── Registry ─────────────────────────────────────────────── */
+
+#define SEA_ARENA_REGISTRY_MAX  64
+#define SEA_ARENA_NAME_MAX      32
+
+typedef struct {
+    char name[SEA_ARENA_NAME_MAX];
+    u32  instances;    /* Live arenas sharing the name     */
+    u64  used;         /* Summed over instances            */
+    u64  high_water;   /* Largest single instance          */
+    u64  capacity;     /* Mapped bytes, summed             */
+    u64  resets;
+    u64  failed;
+} SeaArenaStats;
+
+/* Snapshot registered arenas, one entry per name, in creation order.
+ * Fields of arenas owned by other threads are read without their
+ * owners' cooperation: good for sizing, not for exact accounting.
+ * Returns the number of entries written. */
+u32 sea_arena_stats(SeaArenaStats* out, u32 max);
+
+/* Format the snapshot as a table (and the top call sites, if built
+ * with SEA_ARENA_SITES) into buf. Returns the length written. */
+u32 sea_arena_report(char* buf, u32 cap);
+
+/* ── Call-site attribution ────────────────────────────────── */
+
+#define SEA_ARENA_SITES_MAX  512
+
+typedef struct {
+    const char* file;
+    u32 line;
+    u64 calls;
+    u64 bytes;
+} SeaArenaSite;
+
+/* Heaviest call sites by bytes, largest first. Returns 0 unless the
+ * tree was built with SEA_ARENA_SITES. */
+u32 sea_arena_sites(SeaArenaSite* out, u32 max);
+
+#ifdef SEA_ARENA_SITES
+void*    sea_arena_alloc_at(SeaArena* arena, u64 size, u64 align, const char* file, u32 line);
+SeaSlice sea_arena_push_cstr_at(SeaArena* arena, const char* cstr, const char* file, u32 line);
+void*    sea_arena_push_bytes_at(SeaArena* arena, const void* data, u64 len,
+                                 const char* file, u32 line);
+
+#ifndef SEA_ARENA_IMPL
+#define sea_arena_alloc(a, size, align) \
+    sea_arena_alloc_at((a), (size), (align), __FILE__, __LINE__)
+#define sea_arena_push(a, size) \
+    sea_arena_alloc_at((a), (size), 8, __FILE__, __LINE__)
+#define sea_arena_push_cstr(a, cstr) \
+    sea_arena_push_cstr_at((a), (cstr), __FILE__, __LINE__)
+#define sea_arena_push_bytes(a, data, len) \
+    sea_arena_push_bytes_at((a), (data), (len), __FILE__, __LINE__)
+#endif
+#endif /* SEA_ARENA_SITES */
+
 #endif /* SEA_ARENA_H */
@@ -10,12 +10,22 @@
  *   "telegram_token": "123456:ABC...",
  *   "telegram_chat_id": 99887766,
  *   "db_path": "seaclaw.db",
+ *   "audit_retain_days": 30,
+ *   "audit_retain_rows": 100000,
  *   "log_level": "info",
+ *   "log_overflow": "drop",
+ *   "metrics_port": 9464,
+ *   "trace": "all",
  *   "arena_size_mb": 16,
  *   "llm_provider": "openai",
  *   "llm_api_key": "sk-...",
  *   "llm_model": "gpt-4o-mini",
  *   "llm_api_url": "",
+ *   "a2a_discovery_url": "http://hub.local:8080/agents",
+ *   "mesh_secret": "change-me",
+ *   "mesh_allowed_subnet": "192.168.1.0/24",
+ *   "llm_cache_ttl_sec": 3600,
+ *   "llm_cache_max_mb": 64,
  *   "llm_fallbacks": [
  *     { "provider": "local", "model": "qwen2.5", "api_url": "http://localhost:1234/v1/chat/completions" },
  *     { "provider": "anthropic", "api_key": "sk-ant-...", "model": "claude-3-haiku-20240307" }
@@ -36,9 +46,14 @@ typedef struct {
 
     /* Database */
     const char* db_path;
+    u32         audit_retain_days;   /* trajectory / cron_log age limit   */
+    u32         audit_retain_rows;   /* Approximate row cap per table     */
 
     /* System */
     const char* log_level;
+    const char* log_overflow;        /* "drop" or "block" when a log ring fills */
+    u32         metrics_port;        /* Loopback /metrics port, 0 = off       */
+    const char* trace;               /* "all", "off" or "1/N" requests traced */
     u32         arena_size_mb;
 
     /* LLM Agent */
@@ -56,6 +71,17 @@ typedef struct {
     } llm_fallbacks[4];
     u32 llm_fallback_count;
 
+    /* LLM response cache */
+    u32 llm_cache_ttl_sec;     /* Stored response lifetime          */
+    u32 llm_cache_max_mb;      /* Stored bodies before LRU eviction */
+
+    /* A2A */
+    const char* a2a_discovery_url;  /* Peer registry discovery source */
+
+    /* Mesh */
+    const char* mesh_secret;          /* X-Mesh-Token key; no server without it */
+    const char* mesh_allowed_subnet;  /* CIDR peers may connect from            */
+
     /* State */
     bool        loaded;
 } SeaConfig;
@@ -6,11 +6,21 @@
  * Jobs survive restarts. Execution results are logged.
  *
  * Supports:
- *   - Standard cron expressions (min hour dom mon dow)
+ *   - Standard cron expressions (min hour dom mon dow), compiled to
+ *     bitmasks and evaluated exactly in local time
+ *   - @hourly, @daily, @weekly, @monthly, @yearly shorthands
  *   - Interval-based scheduling (@every 5m, @every 1h)
  *   - One-shot delayed execution (@once 30s)
  *   - Job types: shell command, tool call, bus message
  *
+ * Active jobs sit in a min-heap keyed on next_run. sea_cron_start()
+ * runs a scheduler thread that sleeps on a timerfd armed for the
+ * earliest deadline, so there is no polling and a tick costs
+ * O(k log n) for k due jobs. Due jobs are handed to a bounded pool
+ * of worker threads, each with its own arena; shell jobs are killed
+ * when they exceed their timeout, and a job still running when it
+ * comes due again follows its overlap policy.
+ *
  * "The clock never stops. The Vault keeps its schedule."
  */
 
@@ -21,6 +31,7 @@
 #include "sea_arena.h"
 #include "sea_db.h"
 #include "sea_bus.h"
+#include <pthread.h>
 
 /* ── Job Types ────────────────────────────────────────────── */
 
@@ -37,6 +48,13 @@ typedef enum {
     SEA_CRON_FAILED,
 } SeaCronJobState;
 
+/* What to do when a job comes due while a previous run is in flight. */
+typedef enum {
+    SEA_CRON_OVERLAP_SKIP = 0,  /* Drop the new run (default)           */
+    SEA_CRON_OVERLAP_QUEUE,     /* Run once more when the current ends  */
+    SEA_CRON_OVERLAP_ALLOW,     /* Start it concurrently                */
+} SeaCronOverlap;
+
 /* ── Schedule Types ───────────────────────────────────────── */
 
 typedef enum {
@@ -45,11 +63,26 @@ typedef enum {
     SEA_SCHED_ONCE,         /* @once Ns (fire once after delay) */
 } SeaSchedType;
 
+/* ── Compiled Cron Expression ─────────────────────────────── */
+
+#define SEA_CRON_DOM_STAR  (1u << 0)  /* Day-of-month field began with '*' */
+#define SEA_CRON_DOW_STAR  (1u << 1)  /* Day-of-week field began with '*'  */
+
+typedef struct {
+    u64 minutes;    /* Bit n set = minute n (0-59)        */
+    u32 hours;      /* Bit n set = hour n (0-23)          */
+    u32 days;       /* Bit n set = day of month n (1-31)  */
+    u16 months;     /* Bit n set = month n (1-12)         */
+    u8  weekdays;   /* Bit n set = weekday n (0-6, Sun=0) */
+    u8  flags;      /* SEA_CRON_DOM_STAR | SEA_CRON_DOW_STAR */
+} SeaCronExpr;
+
 /* ── Cron Job ─────────────────────────────────────────────── */
 
 #define SEA_CRON_NAME_MAX    64
 #define SEA_CRON_EXPR_MAX    64
 #define SEA_CRON_CMD_MAX     512
+#define SEA_CRON_TIMEOUT_SEC 300    /* Default per-run timeout          */
 
 typedef struct {
     i32             id;
@@ -60,26 +93,61 @@ typedef struct {
     char            schedule[SEA_CRON_EXPR_MAX];  /* cron expr or @every/@once     */
     char            command[SEA_CRON_CMD_MAX];     /* Shell cmd, tool name, or bus msg */
     char            args[SEA_CRON_CMD_MAX];        /* Tool args or bus channel:chat_id */
-    u64             interval_sec;                  /* Computed interval in seconds     */
+    SeaCronExpr     expr;                          /* Compiled, for SEA_SCHED_CRON     */
+    u64             interval_sec;                  /* Interval (cron: gap between the next two runs) */
     u64             next_run;                      /* Next execution time (epoch sec)  */
     u64             last_run;                      /* Last execution time              */
     u32             run_count;                     /* Total executions                 */
     u32             fail_count;                    /* Total failures                   */
+    u32             skip_count;                    /* Runs dropped by overlap policy   */
+    SeaCronOverlap  overlap;
+    u32             timeout_sec;                   /* Shell jobs are killed after this */
+    u32             in_flight;                     /* Runs currently executing         */
+    bool            queued;                        /* QUEUE: one more run pending      */
+    u64             last_duration_ms;              /* Monotonic, of the last run       */
     u64             created_at;
 } SeaCronJob;
 
 /* ── Cron Scheduler ───────────────────────────────────────── */
 
-#define SEA_MAX_CRON_JOBS 64
+#define SEA_MAX_CRON_JOBS 4096
+#define SEA_CRON_WORKERS     4      /* Default concurrency cap          */
+#define SEA_CRON_MAX_WORKERS 32
+#define SEA_CRON_QUEUE_MAX   256    /* Dispatched runs awaiting a worker */
+#define SEA_CRON_WORKER_ARENA (1024 * 1024)
+
+struct SeaCronScheduler;
 
 typedef struct {
-    SeaCronJob  jobs[SEA_MAX_CRON_JOBS];
-    u32         count;
-    SeaDb*      db;
-    SeaBus*     bus;        /* Optional: for SEA_CRON_BUS_MSG jobs */
-    SeaArena    arena;
-    bool        running;
-    u64         tick_count;
+    struct SeaCronScheduler* sched;
+    pthread_t                tid;
+    SeaArena                 arena;  /* Reset before every run */
+} SeaCronWorker;
+
+typedef struct SeaCronScheduler {
+    SeaCronJob*     jobs;       /* SEA_MAX_CRON_JOBS slots, in creation order */
+    u32             count;
+    i32             next_id;
+    u32*            heap;       /* Slots of active jobs, min-heap on next_run */
+    u32*            heap_pos;   /* Slot → heap index, or UINT32_MAX           */
+    u32             heap_len;
+    SeaDb*          db;
+    SeaBus*         bus;        /* Optional: for SEA_CRON_BUS_MSG jobs */
+    SeaArena        arena;      /* Scratch for tool jobs run inline    */
+    SeaArena        store;      /* Backs jobs, heap, heap_pos, queue   */
+    SeaCronJob*     queue;      /* Ring of job snapshots to run        */
+    u32             q_head;
+    u32             q_len;
+    u32             max_workers;  /* Concurrency cap; 0 = SEA_CRON_WORKERS. Set before start */
+    u32             worker_count;
+    u32             active_runs;
+    SeaCronWorker   workers[SEA_CRON_MAX_WORKERS];
+    pthread_cond_t  work_cond;
+    bool            running;
+    u64             tick_count;
+    pthread_mutex_t lock;       /* Recursive: tool jobs may call back in */
+    pthread_t       thread;
+    int             timer_fd;   /* -1 until sea_cron_start()           */
 } SeaCronScheduler;
 
 /* ── API ──────────────────────────────────────────────────── */
@@ -87,9 +155,14 @@ typedef struct {
 /* Initialize the scheduler. Creates DB tables if needed. */
 SeaError sea_cron_init(SeaCronScheduler* sched, SeaDb* db, SeaBus* bus);
 
-/* Destroy the scheduler. */
+/* Destroy the scheduler, stopping its thread if started. */
 void sea_cron_destroy(SeaCronScheduler* sched);
 
+/* Start the worker pool and the scheduler thread. The thread sleeps
+ * on a timerfd until the earliest next_run (re-armed whenever jobs
+ * change, and woken by wall-clock jumps) and calls sea_cron_tick(). */
+SeaError sea_cron_start(SeaCronScheduler* sched);
+
 /* Add a new job. Returns the job ID (>= 0) or -1 on error. */
 i32 sea_cron_add(SeaCronScheduler* sched, const char* name,
                   SeaCronJobType type, const char* schedule,
@@ -104,16 +177,25 @@ SeaError sea_cron_pause(SeaCronScheduler* sched, i32 job_id);
 /* Resume a paused job. */
 SeaError sea_cron_resume(SeaCronScheduler* sched, i32 job_id);
 
-/* Tick: check all jobs and execute any that are due.
- * Call this once per second from a dedicated thread.
- * Returns the number of jobs executed this tick. */
+/* Set a job's overlap policy and timeout (0 keeps the current one).
+ * Tool and bus jobs cannot be interrupted; one that overruns its
+ * timeout is recorded as failed when it returns. */
+SeaError sea_cron_set_policy(SeaCronScheduler* sched, i32 job_id,
+                             SeaCronOverlap overlap, u32 timeout_sec);
+
+/* Tick: reschedule every job whose next_run has passed and run it.
+ * Once started, runs are dispatched to the worker pool; before
+ * sea_cron_start() they execute inline on the caller's thread.
+ * Returns the number of runs started this tick. */
 u32 sea_cron_tick(SeaCronScheduler* sched);
 
-/* Get a job by ID. Returns NULL if not found. */
-SeaCronJob* sea_cron_get(SeaCronScheduler* sched, i32 job_id);
+/* Copy a job by ID into *out. Workers update jobs and removal
+ * compacts the table, so callers get a snapshot, never a pointer.
+ * Returns false if not found. */
+bool sea_cron_get(SeaCronScheduler* sched, i32 job_id, SeaCronJob* out);
 
-/* List all jobs. Returns count. */
-u32 sea_cron_list(SeaCronScheduler* sched, SeaCronJob** out, u32 max_count);
+/* Copy up to max_count jobs, in creation order. Returns count. */
+u32 sea_cron_list(SeaCronScheduler* sched, SeaCronJob* out, u32 max_count);
 
 /* Get job count. */
 u32 sea_cron_count(SeaCronScheduler* sched);
@@ -129,4 +211,16 @@ SeaError sea_cron_load(SeaCronScheduler* sched);
 SeaError sea_cron_parse_schedule(const char* schedule, SeaSchedType* out_type,
                                   u64* out_interval, u64* out_next_run);
 
+/* Compile "min hour dom mon dow" (or an @hourly-style shorthand).
+ * Fields take *, N, N-M, lists and /step; months and weekdays also
+ * take three-letter names, and weekday 7 is Sunday. When both day
+ * fields are restricted a day matching either one fires, as in
+ * Vixie cron. SEA_ERR_INVALID_INPUT on a malformed expression. */
+SeaError sea_cron_compile(const char* expr, SeaCronExpr* out);
+
+/* First matching minute strictly after `after` (epoch seconds),
+ * evaluated in local time. SEA_ERR_NOT_FOUND if nothing matches
+ * within eight years (e.g. "0 0 30 2 *"). */
+SeaError sea_cron_next(const SeaCronExpr* expr, u64 after, u64* out_next);
+
 #endif /* SEA_CRON_H */
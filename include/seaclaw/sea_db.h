@@ -22,7 +22,7 @@ typedef struct SeaDb SeaDb;
  * Creates tables if they don't exist. */
 SeaError sea_db_open(SeaDb** db, const char* path);
 
-/* Close and flush */
+/* Close and flush. Drains and stops the audit writer, if running. */
 void sea_db_close(SeaDb* db);
 
 /* ── Trajectory (audit log) ───────────────────────────────── */
@@ -35,13 +35,68 @@ typedef struct {
     const char* created_at;
 } SeaDbEvent;
 
+/* Append a trajectory row. With the audit writer running this only
+ * queues the record (content truncated to fit a ring slot) and returns
+ * SEA_ERR_ARENA_FULL if the ring is full; otherwise it is a synchronous
+ * insert. */
 SeaError sea_db_log_event(SeaDb* db, const char* entry_type,
                           const char* title, const char* content);
 
-/* Load last N events. Returns count loaded. */
+/* Append a cron_log row. Same queueing rules as sea_db_log_event. */
+SeaError sea_db_log_cron(SeaDb* db, i32 job_id, const char* job_name,
+                         const char* status, const char* output,
+                         u64 executed_at, u64 duration_ms);
+
+/* Load last N events (queued records are flushed first). Returns
+ * count loaded. */
 i32 sea_db_recent_events(SeaDb* db, SeaDbEvent* out, i32 max_count,
                          SeaArena* arena);
 
+/* ── Audit Writer ─────────────────────────────────────────── */
+/*
+ * Background writer for trajectory and cron_log. Producers claim a slot
+ * in a bounded lock-free ring and return; one thread drains it in
+ * batched transactions through prepared statements on its own
+ * connection. A full ring drops the record and counts it rather than
+ * blocking the caller. The same thread applies retention.
+ */
+
+#define SEA_DB_AUDIT_SLOTS      4096    /* Ring capacity (power of two)  */
+#define SEA_DB_AUDIT_TEXT       1024    /* Packed text bytes per record  */
+#define SEA_DB_AUDIT_FLUSH_MS   200
+#define SEA_DB_AUDIT_BATCH      512     /* Max records per transaction   */
+#define SEA_DB_AUDIT_COMPACT_SEC 600
+
+typedef struct {
+    u32 ring_slots;       /* 0 = SEA_DB_AUDIT_SLOTS; rounded up to pow2   */
+    u32 flush_ms;         /* Max delay before a queued record is written  */
+    u32 retain_days;      /* Delete rows older than this; 0 = keep        */
+    u32 retain_rows;      /* Keep about this many rows per table; 0 = all */
+    u32 downsample_days;  /* Thin successful cron runs older than this to
+                             one per job per hour; 0 = off                */
+    u32 compact_sec;      /* Retention interval; 0 = SEA_DB_AUDIT_COMPACT_SEC */
+} SeaDbAuditConfig;
+
+typedef struct {
+    u64 queued;           /* Records accepted into the ring    */
+    u64 written;          /* Rows committed                    */
+    u64 dropped;          /* Ring full or record rejected      */
+    u64 batches;          /* Transactions committed            */
+    u64 pruned;           /* Rows removed by retention         */
+    u32 pending;          /* Records waiting in the ring       */
+} SeaDbAuditStats;
+
+/* Start the writer thread. cfg may be NULL for defaults (no retention). */
+SeaError sea_db_audit_start(SeaDb* db, const SeaDbAuditConfig* cfg);
+
+/* Block until every record queued before the call is committed. */
+SeaError sea_db_audit_flush(SeaDb* db);
+
+/* Apply retention now on the caller's thread. Returns rows removed. */
+u64 sea_db_audit_compact(SeaDb* db, const SeaDbAuditConfig* cfg);
+
+void sea_db_audit_stats(SeaDb* db, SeaDbAuditStats* out);
+
 /* ── Key-Value Config ─────────────────────────────────────── */
 
 SeaError sea_db_config_set(SeaDb* db, const char* key, const char* value);
@@ -85,8 +140,83 @@ i32 sea_db_chat_history(SeaDb* db, i64 chat_id,
 /* Clear chat history for a chat */
 SeaError sea_db_chat_clear(SeaDb* db, i64 chat_id);
 
+/* ── SeaZero (v3) ─────────────────────────────────────────── */
+/*
+ * Agent Zero instances, the tasks delegated to them, LLM usage seen by
+ * the proxy and a security audit trail. Synchronous writes on the
+ * shared connection. Strings in list results live in the arena.
+ */
+
+typedef struct {
+    i32         id;
+    const char* agent_id;
+    const char* status;     /* stopped, starting, ready, busy, error */
+    const char* container;
+    i32         port;
+    const char* provider;
+    const char* model;
+    const char* last_seen;
+} SeaDbAgent;
+
+typedef struct {
+    i32         id;
+    const char* task_id;
+    const char* agent_id;
+    i64         chat_id;
+    const char* status;     /* pending, running, completed, failed */
+    const char* task_text;
+    const char* result;     /* NULL until completed */
+    const char* error;      /* NULL unless failed   */
+    i32         steps_taken;
+    f64         elapsed_sec;
+} SeaDbSzTask;
+
+/* Insert or update an agent; marks it ready. */
+SeaError sea_db_sz_agent_register(SeaDb* db, const char* agent_id,
+                                  const char* container, i32 port,
+                                  const char* provider, const char* model);
+SeaError sea_db_sz_agent_update_status(SeaDb* db, const char* agent_id,
+                                       const char* status);
+SeaError sea_db_sz_agent_heartbeat(SeaDb* db, const char* agent_id);
+i32 sea_db_sz_agent_list(SeaDb* db, SeaDbAgent* out, i32 max_count, SeaArena* arena);
+
+SeaError sea_db_sz_task_create(SeaDb* db, const char* task_id, const char* agent_id,
+                               i64 chat_id, const char* task_text, const char* context);
+SeaError sea_db_sz_task_start(SeaDb* db, const char* task_id);
+SeaError sea_db_sz_task_complete(SeaDb* db, const char* task_id, const char* result,
+                                 const char* files, i32 steps_taken, f64 elapsed_sec);
+SeaError sea_db_sz_task_fail(SeaDb* db, const char* task_id, const char* error,
+                             f64 elapsed_sec);
+
+/* List tasks, optionally by status. Returns count. */
+i32 sea_db_sz_task_list(SeaDb* db, const char* status_filter,
+                        SeaDbSzTask* out, i32 max_count, SeaArena* arena);
+
+SeaError sea_db_sz_llm_log(SeaDb* db, const char* caller, const char* provider,
+                           const char* model, i32 tokens_in, i32 tokens_out,
+                           f64 cost_usd, i32 latency_ms, const char* status,
+                           const char* task_id);
+
+/* Tokens (in + out) logged for caller since UTC midnight. */
+i64 sea_db_sz_llm_total_tokens(SeaDb* db, const char* caller);
+
+/* target and detail may be NULL; severity defaults to "info". */
+SeaError sea_db_sz_audit(SeaDb* db, const char* event_type, const char* source,
+                         const char* target, const char* detail, const char* severity);
+
 /* ── Raw SQL (escape hatch) ───────────────────────────────── */
 
 SeaError sea_db_exec(SeaDb* db, const char* sql);
 
+struct sqlite3;
+
+/* The shared connection. Every thread writes through it, so never
+ * leave a transaction open on it. */
+struct sqlite3* sea_db_handle(SeaDb* db);
+
+/* A connection of its own to the same file, for a subsystem that
+ * batches writes in transactions from its own thread. NULL for
+ * in-memory databases. Close with sqlite3_close(). */
+struct sqlite3* sea_db_connect(SeaDb* db);
+
 #endif /* SEA_DB_H */
@@ -0,0 +1,52 @@
+/*
+ * sea_diff.h — Line diff engine
+ *
+ * Myers' O(ND) algorithm with the linear-space middle-snake
+ * refinement. Lines are interned into integer ids through a hash
+ * table first, so the inner loops compare u32s only. Common prefix
+ * and suffix are trimmed before the search, and very expensive inputs
+ * fall back to a near-minimal split rather than running unbounded.
+ *
+ * All working memory comes from the caller's arena; nothing is copied
+ * out of the input buffers. Used by diff_text and edit_file.
+ */
+
+#ifndef SEA_DIFF_H
+#define SEA_DIFF_H
+
+#include "sea_types.h"
+#include "sea_arena.h"
+
+/* One run of changed lines: a_count lines of A starting at a_start
+ * are replaced by b_count lines of B starting at b_start (0-based).
+ * Either count may be zero. */
+typedef struct {
+    u32 a_start;
+    u32 a_count;
+    u32 b_start;
+    u32 b_count;
+} SeaDiffChange;
+
+typedef struct {
+    SeaSlice*      a_lines;   /* Each line includes its '\n', if any */
+    u32            a_count;
+    SeaSlice*      b_lines;
+    u32            b_count;
+    SeaDiffChange* changes;   /* In file order                       */
+    u32            change_count;
+    u32            removed;   /* Total lines deleted from A           */
+    u32            added;     /* Total lines inserted from B          */
+} SeaDiff;
+
+/* Diff two texts line by line. Returns SEA_ERR_ARENA_FULL if the
+ * arena cannot hold the working set (roughly 64 bytes per line). */
+SeaError sea_diff_lines(const u8* a, u64 a_len, const u8* b, u64 b_len,
+                        SeaArena* arena, SeaDiff* out);
+
+/* Render a unified diff (--- / +++ / @@ hunks) with `context` lines
+ * around each change. Output is capped at max_bytes; a truncated
+ * diff ends with a "... (diff truncated)" line. Empty if no changes. */
+SeaError sea_diff_unified(const SeaDiff* diff, const char* a_name, const char* b_name,
+                          u32 context, u32 max_bytes, SeaArena* arena, SeaSlice* out);
+
+#endif /* SEA_DIFF_H */
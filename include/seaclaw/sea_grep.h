@@ -0,0 +1,87 @@
+/*
+ * sea_grep.h — The Net
+ *
+ * Line-oriented search over memory-mapped files of any size.
+ * Literal patterns are located with a SIMD first/last-byte filter
+ * (AVX2 / NEON) or Boyer-Moore-Horspool on portable builds, across
+ * the whole buffer rather than line by line. Regex patterns are
+ * compiled once per search and run over line-aligned windows.
+ *
+ * Hits are handed to a visitor in file order, with line numbers and
+ * optional surrounding context lines. Nothing is copied.
+ */
+
+#ifndef SEA_GREP_H
+#define SEA_GREP_H
+
+#include "sea_types.h"
+#include "sea_arena.h"
+#include <regex.h>
+
+/* ── Flags ────────────────────────────────────────────────── */
+
+#define SEA_GREP_ICASE  (1u << 0)  /* ASCII case-insensitive           */
+#define SEA_GREP_REGEX  (1u << 1)  /* POSIX extended regex             */
+
+#define SEA_GREP_MAX_PATTERN 256
+#define SEA_GREP_MAX_CONTEXT 10
+
+/* ── Compiled pattern ─────────────────────────────────────── */
+
+typedef struct {
+    u32     flags;
+    u8      needle[SEA_GREP_MAX_PATTERN]; /* Case-folded if ICASE       */
+    u32     needle_len;
+    u32     skip[256];                    /* Horspool shift table      */
+    regex_t re;
+    bool    re_ok;
+} SeaGrepPattern;
+
+/* ── Hit ──────────────────────────────────────────────────── */
+
+typedef struct {
+    u64       line_no;   /* 1-based                              */
+    u64       offset;    /* Byte offset of the line start        */
+    const u8* line;      /* Points into the searched buffer      */
+    u32       line_len;  /* Without the trailing '\n'            */
+    bool      context;   /* true = context line, false = match   */
+} SeaGrepHit;
+
+/* Visitor. Return false to stop the search. */
+typedef bool (*SeaGrepVisit)(const SeaGrepHit* hit, void* ctx);
+
+typedef struct {
+    u64  matches;        /* Matching lines                        */
+    u64  lines;          /* Lines in the buffer (or up to stop)   */
+    u64  bytes;          /* Bytes searched                        */
+    bool stopped;        /* Visitor returned false                */
+} SeaGrepStats;
+
+/* ── API ──────────────────────────────────────────────────── */
+
+/* Compile a pattern. On a bad regex returns SEA_ERR_PARSE and writes
+ * the reason into err (if given). */
+SeaError sea_grep_compile(SeaGrepPattern* pat, const char* pattern, u32 flags,
+                          char* err, u32 err_len);
+
+/* Release regex state. Safe to call on a literal pattern. */
+void sea_grep_free(SeaGrepPattern* pat);
+
+/* Search a buffer. context = lines before/after each match (clamped
+ * to SEA_GREP_MAX_CONTEXT). One hit per matching line. */
+SeaError sea_grep_buffer(const SeaGrepPattern* pat, const u8* data, u64 len,
+                         u32 context, SeaGrepVisit visit, void* ctx,
+                         SeaGrepStats* stats);
+
+/* Memory-map a file and search it. Files that cannot be mapped
+ * (e.g. /proc entries) are read into the scratch arena instead,
+ * if one is given. Returns SEA_ERR_IO if the file cannot be read. */
+SeaError sea_grep_file(const SeaGrepPattern* pat, const char* path,
+                       u32 context, SeaGrepVisit visit, void* ctx,
+                       SeaArena* scratch, SeaGrepStats* stats);
+
+/* Offset of the first occurrence of the pattern in data, or -1.
+ * Literal patterns only; exposed for tools and benchmarks. */
+i64 sea_grep_find(const SeaGrepPattern* pat, const u8* data, u64 len);
+
+#endif /* SEA_GREP_H */
@@ -0,0 +1,102 @@
+/*
+ * sea_hash.h — Checksums and digests
+ *
+ * CRC32 (IEEE), CRC32C (Castagnoli), xxHash64, FNV-1a and SHA-256
+ * behind one interface. The fastest implementation the CPU offers is
+ * picked once at first use:
+ *
+ *   CRC32   PCLMULQDQ folding (x86) / CRC32 instructions (ARMv8),
+ *           else slicing-by-8 tables
+ *   CRC32C  SSE4.2 crc32 (x86) / CRC32C instructions (ARMv8),
+ *           else slicing-by-8 tables
+ *   SHA-256 SHA-NI (x86) / ARMv8 crypto extensions, else portable C
+ *
+ * Files are memory-mapped and hashed in a single pass over all the
+ * requested algorithms.
+ */
+
+#ifndef SEA_HASH_H
+#define SEA_HASH_H
+
+#include "sea_types.h"
+
+/* ── Algorithms (bit set for sea_hash_file/buffer) ────────── */
+
+typedef enum {
+    SEA_HASH_CRC32  = 1 << 0,
+    SEA_HASH_CRC32C = 1 << 1,
+    SEA_HASH_XXH64  = 1 << 2,
+    SEA_HASH_FNV1A  = 1 << 3,
+    SEA_HASH_SHA256 = 1 << 4,
+} SeaHashAlgo;
+
+#define SEA_HASH_ALL  (SEA_HASH_CRC32 | SEA_HASH_CRC32C | SEA_HASH_XXH64 | \
+                       SEA_HASH_FNV1A | SEA_HASH_SHA256)
+
+typedef struct {
+    u64 size;
+    u32 crc32;
+    u32 crc32c;
+    u64 xxh64;
+    u64 fnv1a;
+    u8  sha256[32];
+} SeaHashDigest;
+
+/* ── One-shot / incremental primitives ────────────────────── */
+
+/* CRC32 / CRC32C. Start with crc = 0; feed the previous result to continue. */
+u32 sea_crc32(u32 crc, const u8* data, u64 len);
+u32 sea_crc32c(u32 crc, const u8* data, u64 len);
+
+/* FNV-1a 64-bit. Start with SEA_FNV1A_INIT to continue across calls. */
+#define SEA_FNV1A_INIT 0xcbf29ce484222325ULL
+u64 sea_fnv1a(u64 hash, const u8* data, u64 len);
+
+/* xxHash64 of a whole buffer. */
+u64 sea_xxh64(const u8* data, u64 len, u64 seed);
+
+/* SHA-256 of a whole buffer. */
+void sea_sha256(const u8* data, u64 len, u8 out[32]);
+
+/* ── Streaming state ──────────────────────────────────────── */
+
+typedef struct {
+    u64 v[4];
+    u64 seed;
+    u64 total;
+    u8  buf[32];
+    u32 buf_len;
+} SeaXxh64;
+
+void sea_xxh64_init(SeaXxh64* s, u64 seed);
+void sea_xxh64_update(SeaXxh64* s, const u8* data, u64 len);
+u64  sea_xxh64_final(const SeaXxh64* s);
+
+typedef struct {
+    u32 h[8];
+    u64 total;
+    u8  buf[64];
+    u32 buf_len;
+} SeaSha256;
+
+void sea_sha256_init(SeaSha256* s);
+void sea_sha256_update(SeaSha256* s, const u8* data, u64 len);
+void sea_sha256_final(SeaSha256* s, u8 out[32]);
+
+/* ── Bulk ─────────────────────────────────────────────────── */
+
+/* Compute every algorithm in `algos` in one pass over the buffer. */
+void sea_hash_buffer(const u8* data, u64 len, u32 algos, SeaHashDigest* out);
+
+/* mmap a file and hash it. Files that cannot be mapped are streamed
+ * with read(). Returns SEA_ERR_IO if the file cannot be opened. */
+SeaError sea_hash_file(const char* path, u32 algos, SeaHashDigest* out);
+
+/* Name of the implementation selected for an algorithm, e.g.
+ * "pclmulqdq", "sse4.2", "sha-ni", "slice-by-8", "portable". */
+const char* sea_hash_impl(SeaHashAlgo algo);
+
+/* Lowercase hex of `len` bytes into out (2*len + 1 bytes). */
+void sea_hash_hex(const u8* data, u32 len, char* out);
+
+#endif /* SEA_HASH_H */
@@ -16,6 +16,8 @@ typedef struct {
     i32      status_code;
     SeaSlice body;
     SeaSlice headers;
+    u64      ttfb_us;       /* Request start to first response byte */
+    u64      total_us;      /* Request start to completion (also on failure) */
 } SeaHttpResponse;
 
 /* HTTP GET — response body allocated in arena */
@@ -34,4 +36,50 @@ SeaError sea_http_post_json_auth(const char* url, SeaSlice json_body,
                                  const char* auth_header,
                                  SeaArena* arena, SeaHttpResponse* resp);
 
+/* ── Streaming ────────────────────────────────────────────── */
+
+/* Receives the response body as it arrives; status is the HTTP status
+ * it belongs to. Return false to abort the transfer. */
+typedef bool (*SeaHttpStreamFn)(i32 status, const u8* data, u32 len, void* ctx);
+
+/* HTTP POST with JSON body + optional auth header, passing the body to
+ * on_data piece by piece instead of buffering it. No overall timeout;
+ * the transfer fails if nothing arrives for two minutes. resp gets the
+ * status and timings only. Returns SEA_ERR_IO if on_data aborted. */
+SeaError sea_http_post_stream(const char* url, SeaSlice json_body,
+                              const char* auth_header, SeaHttpStreamFn on_data,
+                              void* ctx, SeaHttpResponse* resp);
+
+/* ── Concurrent requests ──────────────────────────────────── */
+
+typedef struct {
+    const char*     url;
+    SeaSlice        body;        /* JSON body to POST; no data = GET       */
+    const char*     header;      /* Extra header line, or NULL             */
+    u32             timeout_ms;  /* Whole-request deadline; 0 = 10s        */
+    /* Filled in by sea_http_multi */
+    SeaError        err;         /* SEA_OK, SEA_ERR_TIMEOUT or _CONNECT     */
+    SeaHttpResponse resp;        /* Valid when err == SEA_OK               */
+    u32             elapsed_ms;
+    u64             elapsed_us;
+    bool            done;        /* false: the batch stopped first         */
+} SeaHttpRequest;
+
+/* Called as each request of a batch finishes, in completion order.
+ * Return false to abort the requests still running. */
+typedef bool (*SeaHttpDoneFn)(SeaHttpRequest* req, u32 index, void* ctx);
+
+/* Run every request at once on the calling thread (curl multi) and
+ * return when each has finished or passed its own deadline, so the
+ * total time is the slowest request rather than the sum. Response
+ * bodies are allocated in arena. Fails only if the batch cannot be set
+ * up; per-request outcomes are in err / resp. */
+SeaError sea_http_multi(SeaHttpRequest* reqs, u32 count, SeaArena* arena);
+
+/* sea_http_multi with a completion callback that can end the batch
+ * early (first answer wins, quorum reached). Aborted requests keep
+ * done = false. */
+SeaError sea_http_multi_until(SeaHttpRequest* reqs, u32 count, SeaArena* arena,
+                              SeaHttpDoneFn on_done, void* ctx);
+
 #endif /* SEA_HTTP_H */
@@ -73,6 +73,17 @@ bool sea_json_get_bool(const SeaJsonValue* obj, const char* key, bool fallback);
 /* Get array item by index. Returns NULL if out of bounds. */
 const SeaJsonValue* sea_json_array_get(const SeaJsonValue* arr, u32 index);
 
+/* ── Strings ──────────────────────────────────────────────── */
+
+/* Parsed strings are raw slices of the input, escapes included.
+ * Decode one (\n, \", \uXXXX incl. surrogate pairs, ...) into the
+ * arena as a NUL-terminated string. Returns an empty slice on OOM. */
+SeaSlice sea_json_unescape(SeaSlice raw, SeaArena* arena);
+
+/* Escape text for use inside a JSON string literal (no quotes added).
+ * Control characters become \uXXXX. Result is NUL-terminated. */
+SeaSlice sea_json_escape(SeaSlice text, SeaArena* arena);
+
 /* ── Utility ──────────────────────────────────────────────── */
 
 /* Print a JSON value for debugging. */
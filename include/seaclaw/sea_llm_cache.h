@@ -0,0 +1,101 @@
+/*
+ * sea_llm_cache.h — LLM Response Cache
+ *
+ * Exact-match cache for chat-completion calls, shared by the agent
+ * loop and the SeaZero proxy. The key is a SHA-256 over the upstream
+ * URL and a canonical form of the request body: object keys sorted,
+ * whitespace dropped, numbers normalised, and the transport-only
+ * fields (stream, stream_options, user) left out.
+ *
+ * Only deterministic requests are stored — temperature present and
+ * no higher than the configured ceiling (0 by default). Entries live
+ * in SQLite with a TTL and are evicted least-recently-hit first once
+ * the stored bodies exceed max_bytes.
+ *
+ * Identical requests that arrive while one is already in flight are
+ * coalesced whether or not they are cacheable: the first caller leads
+ * the upstream call, the rest wait and receive a copy of its result.
+ *
+ *   SeaLlmCacheKey key;
+ *   sea_llm_cache_key(cache, url, body, arena, &key);
+ *   switch (sea_llm_cache_begin(cache, &key, arena, &out)) {
+ *       case SEA_CACHE_HIT: case SEA_CACHE_SHARED: use out; break;
+ *       case SEA_CACHE_LEADER: call upstream;
+ *                              sea_llm_cache_complete(cache, &key, resp, ok);
+ *       case SEA_CACHE_BYPASS: call upstream; break;
+ *   }
+ *
+ * "Ask the sea the same question twice, hear the same wave."
+ */
+
+#ifndef SEA_LLM_CACHE_H
+#define SEA_LLM_CACHE_H
+
+#include "sea_types.h"
+#include "sea_arena.h"
+#include "sea_db.h"
+
+#define SEA_LLM_CACHE_TTL_SEC    3600
+#define SEA_LLM_CACHE_MAX_BYTES  (64ULL * 1024 * 1024)
+#define SEA_LLM_CACHE_ENTRY_MAX  (4 * 1024 * 1024)   /* Larger bodies are not stored */
+
+typedef struct SeaLlmCache SeaLlmCache;
+
+typedef struct {
+    u32 ttl_sec;            /* 0 = SEA_LLM_CACHE_TTL_SEC                */
+    u64 max_bytes;          /* 0 = SEA_LLM_CACHE_MAX_BYTES              */
+    f64 max_temperature;    /* Highest temperature that is still stored */
+} SeaLlmCacheConfig;
+
+typedef struct {
+    char hex[65];           /* SHA-256 of URL + canonical body */
+    bool cacheable;         /* Deterministic enough to store   */
+} SeaLlmCacheKey;
+
+typedef enum {
+    SEA_CACHE_BYPASS = 0,   /* Call upstream; nothing to complete         */
+    SEA_CACHE_HIT,          /* Stored response returned                   */
+    SEA_CACHE_SHARED,       /* Waited on an identical in-flight call      */
+    SEA_CACHE_LEADER,       /* Call upstream, then sea_llm_cache_complete */
+} SeaCacheResult;
+
+typedef struct {
+    u64 hits;
+    u64 shared;
+    u64 misses;
+    u64 stored;
+    u64 evicted;
+    u64 entries;
+    u64 bytes;
+} SeaLlmCacheStats;
+
+/* Create the cache. db may be NULL: nothing is stored, but in-flight
+ * requests are still coalesced. cfg may be NULL for defaults. */
+SeaLlmCache* sea_llm_cache_create(SeaDb* db, const SeaLlmCacheConfig* cfg);
+
+/* Free. No call may be in flight. */
+void sea_llm_cache_destroy(SeaLlmCache* cache);
+
+/* Hash url + canonical body into key. Returns SEA_ERR_PARSE if the
+ * body is not JSON; the caller should then bypass the cache. */
+SeaError sea_llm_cache_key(SeaLlmCache* cache, const char* url, SeaSlice body,
+                           SeaArena* arena, SeaLlmCacheKey* key);
+
+/* Look the key up and join or lead its flight. On HIT and SHARED,
+ * out holds the response body, copied into arena. A LEADER must call
+ * sea_llm_cache_complete exactly once, or its followers wait forever. */
+SeaCacheResult sea_llm_cache_begin(SeaLlmCache* cache, const SeaLlmCacheKey* key,
+                                   SeaArena* arena, SeaSlice* out);
+
+/* Finish a led flight. ok: body is a good response — stored if the
+ * key is cacheable and handed to the waiters. Otherwise the waiters
+ * get BYPASS and make their own calls. */
+void sea_llm_cache_complete(SeaLlmCache* cache, const SeaLlmCacheKey* key,
+                            SeaSlice body, bool ok);
+
+/* Drop expired entries. Returns the number removed. */
+u32 sea_llm_cache_purge(SeaLlmCache* cache);
+
+void sea_llm_cache_stats(SeaLlmCache* cache, SeaLlmCacheStats* out);
+
+#endif /* SEA_LLM_CACHE_H */
@@ -3,6 +3,17 @@
  *
  * Every subsystem logs with a bracketed tag and millisecond timestamps.
  * Matches the TUI status line format: T+0ms [SENSES] Parsing...
+ *
+ * Until sea_log_start() a line is written straight to stdout/stderr.
+ * After it, each thread formats into its own lock-free ring and a
+ * background writer drains every ring with writev(), so the calling
+ * thread never takes a lock or makes a syscall. When a ring is full
+ * the line is dropped and counted, or — SEA_LOG_BLOCK — the caller
+ * drains the rings itself before going on.
+ *
+ * Levels below SEA_LOG_COMPILE_MIN compile to nothing: the call and
+ * its arguments are type-checked but never evaluated. It defaults to
+ * DEBUG in debug builds and INFO otherwise.
  */
 
 #ifndef SEA_LOG_H
@@ -17,9 +28,39 @@ typedef enum {
     SEA_LOG_ERROR,
 } SeaLogLevel;
 
+typedef enum {
+    SEA_LOG_DROP = 0,       /* Full ring: drop the line, count it       */
+    SEA_LOG_BLOCK,          /* Full ring: drain it in the calling thread */
+} SeaLogOverflow;
+
+#define SEA_LOG_RING_SIZE   (64 * 1024)   /* Bytes per thread           */
+#define SEA_LOG_LINE_MAX    2048          /* Longer lines are truncated */
+#define SEA_LOG_FLUSH_MS    20            /* Writer wakeup interval     */
+
+typedef struct {
+    SeaLogOverflow overflow;
+    u32 ring_size;          /* Power of two, 0 = SEA_LOG_RING_SIZE */
+    int fd_out;             /* DEBUG/INFO lines, 0 = stdout        */
+    int fd_err;             /* WARN/ERROR lines, 0 = stderr        */
+} SeaLogConfig;
+
 /* Initialize logging. Call once at startup. */
 void sea_log_init(SeaLogLevel min_level);
 
+/* Switch to asynchronous output. cfg may be NULL for defaults.
+ * Returns SEA_ERR_OOM if the writer thread cannot be started. */
+SeaError sea_log_start(const SeaLogConfig* cfg);
+
+/* Write out everything queued, stop the writer and go back to
+ * synchronous output. Also runs at exit. */
+void sea_log_stop(void);
+
+/* Write out everything queued so far. */
+void sea_log_flush(void);
+
+/* Lines dropped because a ring was full. */
+u64 sea_log_dropped(void);
+
 /* Get elapsed milliseconds since sea_log_init() */
 u64 sea_log_elapsed_ms(void);
 
@@ -27,10 +68,22 @@ u64 sea_log_elapsed_ms(void);
 void sea_log(SeaLogLevel level, const char* tag, const char* fmt, ...)
     __attribute__((format(printf, 3, 4)));
 
+/* Compile-time floor: 0 debug, 1 info, 2 warn, 3 error */
+#ifndef SEA_LOG_COMPILE_MIN
+#ifdef DEBUG
+#define SEA_LOG_COMPILE_MIN 0
+#else
+#define SEA_LOG_COMPILE_MIN 1
+#endif
+#endif
+
 /* Convenience macros — C11 compatible (fmt folded into __VA_ARGS__) */
-#define SEA_LOG_DEBUG(tag, ...) sea_log(SEA_LOG_DEBUG, tag, __VA_ARGS__)
-#define SEA_LOG_INFO(tag, ...)  sea_log(SEA_LOG_INFO,  tag, __VA_ARGS__)
-#define SEA_LOG_WARN(tag, ...)  sea_log(SEA_LOG_WARN,  tag, __VA_ARGS__)
-#define SEA_LOG_ERROR(tag, ...) sea_log(SEA_LOG_ERROR, tag, __VA_ARGS__)
+#define SEA_LOG_AT_(min, level, tag, ...) \
+    (SEA_LOG_COMPILE_MIN <= (min) ? sea_log(level, tag, __VA_ARGS__) : (void)0)
+
+#define SEA_LOG_DEBUG(tag, ...) SEA_LOG_AT_(0, SEA_LOG_DEBUG, tag, __VA_ARGS__)
+#define SEA_LOG_INFO(tag, ...)  SEA_LOG_AT_(1, SEA_LOG_INFO,  tag, __VA_ARGS__)
+#define SEA_LOG_WARN(tag, ...)  SEA_LOG_AT_(2, SEA_LOG_WARN,  tag, __VA_ARGS__)
+#define SEA_LOG_ERROR(tag, ...) SEA_LOG_AT_(3, SEA_LOG_ERROR, tag, __VA_ARGS__)
 
 #endif /* SEA_LOG_H */
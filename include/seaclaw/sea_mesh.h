@@ -16,6 +16,7 @@
 #include "sea_types.h"
 #include "sea_arena.h"
 #include "sea_db.h"
+#include <pthread.h>
 
 /* ── Node Role ───────────────────────────────────────────── */
 
@@ -33,6 +34,7 @@ typedef enum {
 typedef struct {
     char        name[SEA_MESH_NODE_NAME_MAX];
     char        endpoint[256];          /* http://ip:port              */
+    u64         id;                     /* Registration serial, never reused */
     char        capabilities[SEA_MESH_MAX_CAPABILITIES][64]; /* tool names */
     u32         capability_count;
     bool        healthy;
@@ -40,14 +42,46 @@ typedef struct {
     u64         registered_at;
     u32         tasks_completed;
     u32         tasks_failed;
+
+    /* Routing state, updated by sea_mesh_route_release */
+    u32         in_flight;              /* Dispatched, not yet finished */
+    double      ewma_latency_ms;        /* 0 until the first sample     */
+    double      ewma_error;             /* 0..1                         */
 } SeaMeshNode;
 
+/* A task's claim on a node, held by value while the task runs. The
+ * registry compacts nodes[] on removal, so release finds the node again
+ * by index and id under the lock; a claim on a removed node is dropped. */
+typedef struct {
+    u32         index;                  /* Where the node was           */
+    u64         id;                     /* 0 = no node                  */
+    char        name[SEA_MESH_NODE_NAME_MAX];
+    char        endpoint[256];
+} SeaMeshRoute;
+
+/* ── Capability Index ────────────────────────────────────── */
+
+/* Open-addressed map from tool name hash to the set of nodes offering
+ * it (bit i = nodes[i]). Rebuilt whenever the registry changes; each
+ * slot points back at one node's copy of the name to confirm hits. */
+#define SEA_MESH_CAP_SLOTS 4096   /* >= 2x NODES * CAPABILITIES */
+
+typedef struct {
+    u64 hash;                     /* 0 = empty                  */
+    u64 nodes;
+    u8  node;                     /* Where the name is stored   */
+    u8  cap;
+} SeaMeshCapSlot;
+
+#define SEA_MESH_EWMA_LATENCY 0.2  /* Weight of the newest sample */
+#define SEA_MESH_EWMA_ERROR   0.1
+
 /* ── Mesh Configuration ──────────────────────────────────── */
 
 typedef struct {
     SeaMeshRole role;
     char        node_name[SEA_MESH_NODE_NAME_MAX];
-    u16         port;                   /* Listen port (9100/9101)     */
+    u16         port;                   /* Listen port; 0 = 9100/9101  */
     char        captain_url[256];       /* Crew: captain endpoint      */
     char        shared_secret[128];     /* HMAC auth secret            */
     char        allowed_subnet[64];     /* e.g. "192.168.1.0/24"      */
@@ -61,9 +95,14 @@ typedef struct {
     SeaMeshConfig config;
     SeaMeshNode   nodes[SEA_MESH_MAX_NODES];
     u32           node_count;
+    SeaMeshCapSlot cap_index[SEA_MESH_CAP_SLOTS];
+    u64           rng;                  /* xorshift state for routing  */
+    u64           next_node_id;
     SeaDb*        db;
     bool          running;
     bool          initialized;
+    pthread_mutex_t lock;               /* Registry and routing state  */
+    struct SeaMeshTasks* tasks;         /* Async dispatch engine, lazy */
 } SeaMesh;
 
 /* ── Task Dispatch ───────────────────────────────────────── */
@@ -101,13 +140,85 @@ SeaError sea_mesh_register_node(SeaMesh* mesh, const char* name,
 /* Captain: remove a node. */
 SeaError sea_mesh_remove_node(SeaMesh* mesh, const char* name);
 
-/* Captain: find the best node for a tool. Returns node or NULL. */
-const SeaMeshNode* sea_mesh_route_tool(SeaMesh* mesh, const char* tool_name);
+/* Captain: find the best node for a tool. Fills out (as
+ * sea_mesh_route_acquire does, without counting a task) and returns
+ * true, or false if no healthy node offers the tool.
+ *
+ * Power of two choices: two random healthy nodes offering the tool are
+ * compared on (in_flight + 1) x EWMA latency, scaled up by the EWMA
+ * error rate, and the cheaper one wins. A node with no samples yet
+ * borrows the other candidate's latency, so it is judged on load
+ * alone until it has answered once. */
+bool sea_mesh_route_tool(SeaMesh* mesh, const char* tool_name, SeaMeshRoute* out);
+
+/* Captain: route and count the task as in flight on the chosen node.
+ * Fills out (name and endpoint copied) and returns true, or false if
+ * no node offers the tool. Every acquired route must be released
+ * exactly once. */
+bool sea_mesh_route_acquire(SeaMesh* mesh, const char* tool_name, SeaMeshRoute* out);
+
+/* Captain: finish a task started with sea_mesh_route_acquire, folding
+ * its latency and outcome into the node's EWMAs. A negative latency
+ * releases without sampling (the task was cancelled). */
+void sea_mesh_route_release(SeaMesh* mesh, const SeaMeshRoute* route,
+                            bool success, double latency_ms);
 
-/* Captain: dispatch a tool call to the best node. */
+/* Captain: dispatch a tool call to the best node and wait for it. */
 SeaMeshResult sea_mesh_dispatch(SeaMesh* mesh, SeaMeshTask* task,
                                  SeaArena* arena);
 
+/* ── Async Tasks ─────────────────────────────────────────── */
+/*
+ * One engine thread per captain drives every remote tool call through
+ * curl multi, so any number of long-running tasks cost no threads of
+ * their own; connections to a node are kept alive and reused, at most
+ * SEA_MESH_TASK_HOST_CONNS at a time (HTTP/1.1 runs one task per
+ * connection, so the rest queue). Crew nodes stream the tool's
+ * progress back as it is produced; the final output is authoritative.
+ */
+
+#define SEA_MESH_TASK_HOST_CONNS 16
+
+typedef enum {
+    SEA_MESH_TASK_PENDING   = 0,   /* Queued or running on a node        */
+    SEA_MESH_TASK_DONE      = 1,   /* The node answered (see success)    */
+    SEA_MESH_TASK_FAILED    = 2,   /* No node, transport error, timeout  */
+    SEA_MESH_TASK_CANCELLED = 3,
+} SeaMeshTaskState;
+
+typedef struct SeaMeshFuture SeaMeshFuture;
+
+/* Captain: start a tool call and return at once. The task is copied;
+ * timeout_ms 0 uses config.task_timeout_ms. NULL only when out of
+ * memory — a task that cannot be routed fails through its future. */
+SeaMeshFuture* sea_mesh_dispatch_async(SeaMesh* mesh, const SeaMeshTask* task);
+
+/* Current state without blocking. */
+SeaMeshTaskState sea_mesh_future_state(SeaMeshFuture* f);
+
+/* Streamed output received since the last poll, copied into arena
+ * (empty if none). Returns the state at the time of the copy. */
+SeaMeshTaskState sea_mesh_future_poll(SeaMeshFuture* f, SeaArena* arena, SeaSlice* chunk);
+
+/* Block until the task leaves PENDING or timeout_ms passes (0 = no
+ * limit beyond the task's own timeout). Returns the state. */
+SeaMeshTaskState sea_mesh_future_wait(SeaMeshFuture* f, u32 timeout_ms);
+
+/* Outcome, with strings copied into arena. Pending tasks report
+ * success = false and no output. */
+SeaMeshResult sea_mesh_future_result(SeaMeshFuture* f, SeaArena* arena);
+
+/* Abort the call: the connection is dropped, which stops a queued
+ * tool from running on the crew and discards a running one's result. */
+void sea_mesh_future_cancel(SeaMeshFuture* f);
+
+/* Release the handle; a still-pending task is cancelled first. */
+void sea_mesh_future_free(SeaMeshFuture* f);
+
+/* Stop the engine, failing whatever is in flight. Called by
+ * sea_mesh_destroy. */
+void sea_mesh_tasks_shutdown(SeaMesh* mesh);
+
 /* Crew: register with captain. */
 SeaError sea_mesh_crew_register(SeaMesh* mesh, SeaArena* arena);
 
@@ -117,22 +228,100 @@ SeaError sea_mesh_crew_heartbeat(SeaMesh* mesh, SeaArena* arena);
 /* Captain: process heartbeat from a node. */
 SeaError sea_mesh_process_heartbeat(SeaMesh* mesh, const char* node_name);
 
-/* Captain: get list of healthy nodes. */
-u32 sea_mesh_healthy_nodes(SeaMesh* mesh, const SeaMeshNode** out, u32 max);
+/* Captain: copy up to max healthy nodes into out; returns how many. */
+u32 sea_mesh_healthy_nodes(SeaMesh* mesh, SeaMeshRoute* out, u32 max);
+
+/* ── Fan-out ──────────────────────────────────────────────── */
+/*
+ * Broadcasts and health probes contact every node at once (curl multi
+ * on the calling thread), each with its own deadline, so one slow node
+ * costs its timeout instead of delaying the rest.
+ */
+
+#define SEA_MESH_FANOUT_TIMEOUT_MS 2000
+
+typedef struct {
+    char     name[SEA_MESH_NODE_NAME_MAX];
+    SeaError err;          /* Transport outcome                   */
+    i32      status;       /* HTTP status; 0 if nothing came back */
+    u32      latency_ms;
+} SeaMeshFanoutResult;
 
-/* Captain: broadcast a message to all nodes. */
+/* Captain: broadcast a message to all healthy nodes. */
 SeaError sea_mesh_broadcast(SeaMesh* mesh, const char* message, SeaArena* arena);
 
+/* Captain: broadcast and report per node. Up to max outcomes go to out
+ * (may be NULL). Returns how many nodes answered 200. */
+u32 sea_mesh_broadcast_status(SeaMesh* mesh, const char* message, SeaArena* arena,
+                              SeaMeshFanoutResult* out, u32 max);
+
+/* Captain: GET /mesh/health on every registered node, stale ones
+ * included. A 200 counts as a heartbeat and marks the node healthy;
+ * anything else marks it unhealthy. Returns how many are healthy. */
+u32 sea_mesh_probe_health(SeaMesh* mesh, SeaArena* arena,
+                          SeaMeshFanoutResult* out, u32 max);
+
 /* Get node count. */
 u32 sea_mesh_node_count(SeaMesh* mesh);
 
 /* Build mesh status string. */
 const char* sea_mesh_status(SeaMesh* mesh, SeaArena* arena);
 
-/* Validate HMAC token for a request. */
+/* Validate HMAC token for a request. Always false without a shared
+ * secret: an unkeyed mesh accepts nobody. */
 bool sea_mesh_validate_token(SeaMesh* mesh, const char* token);
 
-/* Generate HMAC token for outgoing request. */
+/* Generate HMAC token for outgoing request. Sent as the X-Mesh-Token
+ * header on every mesh POST when a shared secret is configured. */
 const char* sea_mesh_generate_token(SeaMesh* mesh, SeaArena* arena);
 
+/* ── HTTP Server ─────────────────────────────────────────── */
+/*
+ * In-process HTTP/1.1 endpoint for both roles: one epoll thread owns
+ * every socket (non-blocking, keep-alive, pipelined requests answered
+ * in order) and hands /node/exec to a pool of tool workers, each with
+ * its own arena. Routes:
+ *
+ *   POST /node/exec        {"task_id","tool","args"} → tool output
+ *                          ("stream":true: chunked NDJSON {"chunk"}… {"done"})
+ *   POST /mesh/register    {"name","endpoint","capabilities":[...]}  (captain)
+ *   POST /mesh/heartbeat   {"name"}                                  (captain)
+ *   POST /mesh/broadcast   {"message"}
+ *   GET  /mesh/health      → {"ok":true,"node"}
+ *
+ * Every request must carry a valid X-Mesh-Token, so the server will
+ * not start without config.shared_secret. Peers outside
+ * config.allowed_subnet (loopback excepted) are refused at accept.
+ */
+
+#define SEA_MESH_SERVER_CONNS    256
+#define SEA_MESH_SERVER_WORKERS  4
+#define SEA_MESH_MAX_REQUEST     (1024 * 1024)   /* Headers + body        */
+#define SEA_MESH_IDLE_MS         60000           /* Keep-alive timeout    */
+#define SEA_MESH_WORKER_ARENA    (4 * 1024 * 1024)
+
+typedef struct SeaMeshServer SeaMeshServer;
+
+typedef struct {
+    u64 connections;      /* Accepted                          */
+    u64 requests;         /* Parsed requests                   */
+    u64 tasks;            /* /node/exec runs completed         */
+    u64 rejected;         /* Answered with 4xx / 5xx           */
+    u64 broadcasts;       /* /mesh/broadcast messages received */
+    u64 abandoned;        /* Tool calls whose caller hung up   */
+} SeaMeshServerStats;
+
+/* Listen on bind_ip (NULL = all interfaces) at mesh->config.port.
+ * sea_mesh_init turns a configured port of 0 into 9100 (captain) or
+ * 9101 (crew); to get a free port instead, set config.port to 0 after
+ * init, and the bound port is written back to the config.
+ * workers = 0 uses SEA_MESH_SERVER_WORKERS. */
+SeaError sea_mesh_server_start(SeaMesh* mesh, const char* bind_ip, u32 workers,
+                               SeaMeshServer** out);
+
+/* Stop accepting, finish running tools, close every connection. */
+void sea_mesh_server_stop(SeaMeshServer* srv);
+
+void sea_mesh_server_stats(SeaMeshServer* srv, SeaMeshServerStats* out);
+
 #endif /* SEA_MESH_H */
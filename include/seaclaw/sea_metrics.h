@@ -0,0 +1,83 @@
+/*
+ * sea_metrics.h — Counters, gauges and histograms
+ *
+ * A process-wide table of series, each a metric name plus at most one
+ * label (tool="shell_exec", provider="openai"). Every series sits on
+ * its own cache lines and is updated with relaxed atomics, so hot
+ * paths on different threads never share a line or take a lock.
+ *
+ * Look a series up once and keep the pointer where you can; lookup
+ * is a hash and a short probe, and registers the series on first use:
+ *
+ *   SeaMetric* m = sea_metric_histogram("sea_tool_seconds", "Tool latency",
+ *                                       "tool", name, &SEA_METRICS_LATENCY);
+ *   sea_metric_observe(m, seconds);
+ *
+ * sea_metrics_render() writes the Prometheus text format (0.0.4);
+ * sea_metrics_serve() answers GET /metrics with it on a loopback port.
+ * Every function accepts a NULL series, so a full table only loses
+ * the new series, never crashes the caller.
+ */
+
+#ifndef SEA_METRICS_H
+#define SEA_METRICS_H
+
+#include "sea_types.h"
+#include "sea_arena.h"
+
+#define SEA_METRICS_MAX       512     /* Series in the table        */
+#define SEA_METRICS_BUCKETS   16      /* Histogram bounds, at most  */
+#define SEA_METRICS_NAME_MAX  64
+#define SEA_METRICS_LABEL_MAX 48
+
+typedef struct SeaMetric SeaMetric;
+
+/* Bucket upper bounds, ascending; +Inf is implied. */
+typedef struct {
+    f64 bounds[SEA_METRICS_BUCKETS];
+    u32 count;
+} SeaMetricBuckets;
+
+/* 1ms .. 60s, for request and call latencies (seconds) */
+extern const SeaMetricBuckets SEA_METRICS_LATENCY;
+/* 10us .. 1s, for in-process work such as SQL statements */
+extern const SeaMetricBuckets SEA_METRICS_FAST;
+
+/* Find or register a series. label/value may be NULL for none.
+ * help must outlive the process (a string literal). buckets NULL =
+ * SEA_METRICS_LATENCY; only the first registration's bounds count.
+ * NULL if the table is full or the series exists with another type. */
+SeaMetric* sea_metric_counter(const char* name, const char* help,
+                              const char* label, const char* value);
+SeaMetric* sea_metric_gauge(const char* name, const char* help,
+                            const char* label, const char* value);
+SeaMetric* sea_metric_histogram(const char* name, const char* help,
+                                const char* label, const char* value,
+                                const SeaMetricBuckets* buckets);
+
+void sea_metric_add(SeaMetric* m, u64 n);       /* Counter           */
+void sea_metric_set(SeaMetric* m, i64 v);       /* Gauge, or counter snapshot */
+void sea_metric_gauge_add(SeaMetric* m, i64 d); /* Gauge up/down     */
+void sea_metric_observe(SeaMetric* m, f64 v);   /* Histogram         */
+
+static inline void sea_metric_inc(SeaMetric* m) { sea_metric_add(m, 1); }
+
+/* Current value: counter/gauge value, or histogram sample count. */
+i64 sea_metric_value(const SeaMetric* m);
+
+/* Called at the start of every render, to set gauges that are cheaper
+ * to sample than to track (queue depths, arena peaks). */
+typedef void (*SeaMetricsCollectFn)(void* ctx);
+void sea_metrics_on_collect(SeaMetricsCollectFn fn, void* ctx);
+
+/* Prometheus text exposition of every series, into arena. */
+SeaError sea_metrics_render(SeaArena* arena, SeaSlice* out);
+
+/* Serve GET /metrics on 127.0.0.1:port from a background thread. */
+SeaError sea_metrics_serve(u16 port);
+void     sea_metrics_stop(void);
+
+/* Microsecond clock for timing spans */
+u64 sea_metrics_now_us(void);
+
+#endif /* SEA_METRICS_H */
@@ -0,0 +1,64 @@
+/*
+ * sea_sort.h — Line sort engine
+ *
+ * Keys are extracted once per line into a (key, index) array and
+ * ordered without re-parsing:
+ *
+ *   numeric  parsed once to a double, mapped to an order-preserving
+ *            u64, LSD radix sorted
+ *   string   first 16 key bytes radix sorted as big-endian words;
+ *            large groups sharing that prefix are radix sorted on the
+ *            next 16 bytes, small ones finished with a stable merge
+ *            sort (byte order, like strcmp)
+ *
+ * Both paths are stable: lines with equal keys keep input order.
+ * When the arena cannot hold every line at once the input is sorted
+ * in runs that are spilled to unlinked temp files and k-way merged.
+ */
+
+#ifndef SEA_SORT_H
+#define SEA_SORT_H
+
+#include "sea_types.h"
+#include "sea_arena.h"
+
+/* ── Options ──────────────────────────────────────────────── */
+
+#define SEA_SORT_REVERSE (1u << 0)  /* Descending                          */
+#define SEA_SORT_NUMERIC (1u << 1)  /* Leading number of the key, like -n  */
+#define SEA_SORT_UNIQUE  (1u << 2)  /* Emit only the first of equal keys   */
+
+typedef struct {
+    u32         flags;
+    u32         key_field;   /* 1-based field to sort on; 0 = whole line    */
+    char        separator;   /* Field separator; 0 = runs of blanks         */
+    u32         run_lines;   /* Max lines per in-memory run; 0 = arena size */
+    const char* tmp_dir;     /* Spill directory; NULL = /tmp                */
+} SeaSortOpts;
+
+/* Receives lines in sorted order, without the '\n'. Return false to stop. */
+typedef bool (*SeaSortEmit)(const u8* line, u32 len, void* ctx);
+
+typedef struct {
+    u64  lines;      /* Lines read                              */
+    u64  emitted;    /* Lines handed to emit (after unique)     */
+    u32  runs;       /* Spilled runs; 0 = sorted in memory      */
+    bool stopped;    /* emit returned false                     */
+} SeaSortStats;
+
+/* ── API ──────────────────────────────────────────────────── */
+
+/* Sort the lines of a buffer. Empty lines are skipped. Working memory
+ * (about 80 bytes per line of a run) comes from the arena and is
+ * released before returning. */
+SeaError sea_sort_buffer(const u8* data, u64 len, const SeaSortOpts* opts,
+                         SeaArena* arena, SeaSortEmit emit, void* ctx,
+                         SeaSortStats* stats);
+
+/* Memory-map a file and sort its lines. SEA_ERR_IO if it cannot be
+ * mapped. */
+SeaError sea_sort_file(const char* path, const SeaSortOpts* opts,
+                       SeaArena* arena, SeaSortEmit emit, void* ctx,
+                       SeaSortStats* stats);
+
+#endif /* SEA_SORT_H */
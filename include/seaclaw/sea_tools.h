@@ -41,4 +41,17 @@ SeaError sea_tool_exec(const char* name, SeaSlice args, SeaArena* arena, SeaSlic
 /* List all tools (for /tools command) */
 void sea_tools_list(void);
 
+/* ── Progress ─────────────────────────────────────────────── */
+
+/* Receives partial output while a tool runs on this thread. */
+typedef void (*SeaToolProgressFn)(const u8* data, u32 len, void* ctx);
+
+/* Install (or clear, with NULL) the current thread's progress sink.
+ * Mesh workers use it to stream output back to the captain. */
+void sea_tool_set_progress(SeaToolProgressFn fn, void* ctx);
+
+/* Hand partial output to the sink, if any. Long-running tools call
+ * this as output appears; the returned output stays authoritative. */
+void sea_tool_progress(const u8* data, u32 len);
+
 #endif /* SEA_TOOLS_H */
@@ -0,0 +1,127 @@
+/*
+ * sea_trace.h — Per-request phase spans, exported as Chrome traces
+ *
+ * A request (one inbound message) is traced when it is sampled; every
+ * span the handling thread then opens is stamped with the cycle
+ * counter and, on close, stored in that thread's ring together with
+ * the request and the agent round. Old spans are overwritten, so the
+ * rings always hold the most recent work.
+ *
+ *   sea_trace_request_begin("telegram:42");
+ *   SeaTraceSpan s = sea_trace_begin("llm.http");
+ *   ...
+ *   sea_trace_end(s);
+ *   sea_trace_request_end();
+ *
+ * sea_trace_dump() writes every ring as Chrome trace_event JSON, for
+ * chrome://tracing or ui.perfetto.dev. Inside a sampled request a
+ * span is two counter reads and one inline store into the thread's
+ * ring; outside one it costs a thread-local load. Build with
+ * SEA_TRACE_DISABLED (make NO_TRACE=1) and spans compile to nothing.
+ */
+
+#ifndef SEA_TRACE_H
+#define SEA_TRACE_H
+
+#include "sea_types.h"
+#include <stdio.h>
+#include <time.h>
+#include <stdatomic.h>
+
+#define SEA_TRACE_RING      4096    /* Spans kept per thread, power of two */
+#define SEA_TRACE_REQUESTS  256     /* Recent requests whose key is kept   */
+#define SEA_TRACE_KEY_MAX   48      /* Session key bytes kept per request  */
+
+typedef struct {
+    u64         start;              /* 0 = not recording */
+    const char* name;
+} SeaTraceSpan;
+
+/* Trace one request in every `every`: 1 = all, 0 = none. */
+void sea_trace_init(u32 every);
+
+/* Open and close the calling thread's request. Nested calls join the
+ * outer request. The key is copied. */
+void sea_trace_request_begin(const char* session_key);
+void sea_trace_request_end(void);
+
+/* Tag the spans that follow with an agent round (1-based). */
+void sea_trace_round(u32 round);
+
+/* Write every ring as Chrome trace_event JSON. spans may be NULL. */
+SeaError sea_trace_export(FILE* out, u32* spans);
+SeaError sea_trace_dump(const char* path, u32* spans);
+
+/* Cycle counter (nanoseconds where there is none) */
+static inline u64 sea_trace_ticks(void) {
+#if defined(SEA_ARCH_X86)
+    return __builtin_ia32_rdtsc();
+#elif defined(SEA_ARCH_ARM) && defined(__aarch64__)
+    u64 v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+#endif
+}
+
+/* ── Spans ────────────────────────────────────────────────── */
+/* name must outlive the process: a literal or a registry string. */
+
+/* A stored span, 32 bytes */
+typedef struct {
+    const char* name;
+    u64         start;
+    u64         end;
+    u32         request;
+    u16         round;
+    u16         tid;
+} SeaTraceRecord;
+
+/* The calling thread's writer state. Internal to sea_trace.c and the
+ * inline span functions below. */
+typedef struct {
+    SeaTraceRecord* spans;          /* Ring, set when a request is sampled */
+    _Atomic u64*    head;           /* Spans published to the exporter     */
+    u64             next;           /* This thread's copy of *head          */
+    SeaTraceRecord  tag;            /* request, round and tid of new spans */
+    bool            on;             /* Inside a sampled request            */
+} SeaTraceThread;
+
+extern _Thread_local SeaTraceThread sea_trace_thread_;
+
+#ifndef SEA_TRACE_DISABLED
+
+static inline SeaTraceSpan sea_trace_begin(const char* name) {
+    SeaTraceSpan s = { 0, name };
+    if (sea_trace_thread_.on) s.start = sea_trace_ticks();
+    return s;
+}
+
+/* Only this thread writes its ring: fill the slot, then publish it. */
+static inline void sea_trace_end(SeaTraceSpan s) {
+    if (!s.start) return;
+    u64 end = sea_trace_ticks();
+    SeaTraceThread* t = &sea_trace_thread_;
+    SeaTraceRecord rec = t->tag;
+    rec.name  = s.name;
+    rec.start = s.start;
+    rec.end   = end;
+    t->spans[t->next & (SEA_TRACE_RING - 1)] = rec;
+    atomic_store_explicit(t->head, ++t->next, memory_order_release);
+}
+
+#else
+
+static inline SeaTraceSpan sea_trace_begin(const char* name) {
+    SeaTraceSpan s = { 0, name };
+    return s;
+}
+
+static inline void sea_trace_end(SeaTraceSpan s) { (void)s; }
+
+#endif /* SEA_TRACE_DISABLED */
+
+#endif /* SEA_TRACE_H */
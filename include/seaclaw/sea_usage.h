@@ -4,6 +4,13 @@
  * Tracks token consumption per session, per provider, per day.
  * Persisted to SQLite for billing/audit. Lightweight counters.
  *
+ * Recording is lock-free: each thread bumps relaxed atomic counters
+ * in its own cache-line-aligned shard, and readers sum the shards.
+ * Per-provider latency histograms (time to first byte, total) use
+ * log-linear buckets, eight per power of two (~12% resolution).
+ * Daily totals and the SQLite upsert batch are produced by
+ * sea_usage_flush, off the hot path.
+ *
  * "Every token has a cost. The Vault keeps the ledger."
  */
 
@@ -12,6 +19,8 @@
 
 #include "sea_types.h"
 #include "sea_db.h"
+#include <pthread.h>
+#include <stdatomic.h>
 
 /* ── Provider Stats ───────────────────────────────────────── */
 
@@ -24,6 +33,11 @@ typedef struct {
     u64   tokens_out;
     u64   requests;
     u64   errors;
+    u64   timed;            /* Requests with a latency sample */
+    u64   ttfb_p50_us;
+    u64   ttfb_p99_us;
+    u64   total_p50_us;
+    u64   total_p99_us;
 } SeaUsageProvider;
 
 /* ── Daily Stats ──────────────────────────────────────────── */
@@ -36,20 +50,58 @@ typedef struct {
     u64   errors;
 } SeaUsageDay;
 
+/* ── Shards ───────────────────────────────────────────────── */
+
+#define SEA_USAGE_SHARDS        8      /* Threads beyond this share shards  */
+#define SEA_USAGE_HIST_SUB_BITS 3      /* 2^3 buckets per power of two      */
+#define SEA_USAGE_HIST_BUCKETS  216    /* Up to 2^28µs (~4.5 min)           */
+#define SEA_USAGE_FLUSH_MS      5000
+
+typedef struct {
+    _Atomic u64 tokens_in;
+    _Atomic u64 tokens_out;
+    _Atomic u64 requests;
+    _Atomic u64 errors;
+    _Atomic u32 ttfb[SEA_USAGE_HIST_BUCKETS];
+    _Atomic u32 total[SEA_USAGE_HIST_BUCKETS];
+} SeaUsageCell;
+
+typedef struct {
+    _Alignas(64) SeaUsageCell cells[SEA_USAGE_PROVIDER_MAX];
+} SeaUsageShard;
+
+/* Provider ids are slots claimed once by CAS on the name hash */
+typedef struct {
+    _Atomic u64  hash;      /* 0 = free              */
+    _Atomic bool ready;     /* name written          */
+    char         name[SEA_USAGE_PROVIDER_NAME_MAX];
+} SeaUsageSlot;
+
 /* ── Usage Tracker ────────────────────────────────────────── */
 
 #define SEA_USAGE_DAYS_MAX 30
 
 typedef struct {
-    SeaUsageProvider providers[SEA_USAGE_PROVIDER_MAX];
-    u32              provider_count;
+    /* Hot path */
+    SeaUsageSlot     slots[SEA_USAGE_PROVIDER_MAX];
+    SeaUsageShard    shards[SEA_USAGE_SHARDS];
+
+    /* Cold path, guarded by lock */
+    pthread_mutex_t  lock;
     SeaUsageDay      days[SEA_USAGE_DAYS_MAX];
     u32              day_count;
-    u64              total_tokens_in;
-    u64              total_tokens_out;
-    u64              total_requests;
-    u64              total_errors;
+    SeaUsageDay      flushed[SEA_USAGE_PROVIDER_MAX];  /* Totals at last flush */
+    SeaUsageDay      base[SEA_USAGE_PROVIDER_MAX];     /* Loaded from the DB   */
     SeaDb*           db;
+    struct sqlite3*  conn;              /* Flushes and loads go through this */
+    bool             own_conn;          /* conn is ours, not the shared one  */
+
+    /* Periodic flusher */
+    pthread_t        thread;
+    pthread_cond_t   wake;
+    bool             running;
+    bool             has_thread;
+    u32              flush_ms;
 } SeaUsageTracker;
 
 /* ── API ──────────────────────────────────────────────────── */
@@ -57,27 +109,45 @@ typedef struct {
 /* Initialize the usage tracker. Creates DB table if needed. */
 SeaError sea_usage_init(SeaUsageTracker* tracker, SeaDb* db);
 
-/* Record a completed request. */
+/* Stop the flusher, flush and release. */
+void sea_usage_destroy(SeaUsageTracker* tracker);
+
+/* Record a completed request. Lock-free; safe from any thread. */
 void sea_usage_record(SeaUsageTracker* tracker, const char* provider,
                        u32 tokens_in, u32 tokens_out, bool error);
 
-/* Get stats for a specific provider. Returns NULL if not found. */
-const SeaUsageProvider* sea_usage_provider(const SeaUsageTracker* tracker,
-                                            const char* provider);
+/* Record a completed request with its latencies (0 = not measured). */
+void sea_usage_record_timed(SeaUsageTracker* tracker, const char* provider,
+                            u32 tokens_in, u32 tokens_out, bool error,
+                            u64 ttfb_us, u64 total_us);
 
-/* Get today's stats. Returns NULL if no activity today. */
-const SeaUsageDay* sea_usage_today(const SeaUsageTracker* tracker);
+/* Aggregated stats for a provider. Returns false if never recorded. */
+bool sea_usage_provider(SeaUsageTracker* tracker, const char* provider,
+                        SeaUsageProvider* out);
+
+/* Today's stats, including unflushed counts. Returns false if no
+ * activity today. */
+bool sea_usage_today(SeaUsageTracker* tracker, SeaUsageDay* out);
 
 /* Get total token count (in + out). */
-u64 sea_usage_total_tokens(const SeaUsageTracker* tracker);
+u64 sea_usage_total_tokens(SeaUsageTracker* tracker);
+
+/* Fold counts since the last flush into today's totals and upsert
+ * them to the DB in one transaction. */
+SeaError sea_usage_flush(SeaUsageTracker* tracker);
+
+/* Flush every interval_ms (0 = SEA_USAGE_FLUSH_MS) on a background
+ * thread. */
+SeaError sea_usage_start(SeaUsageTracker* tracker, u32 interval_ms);
 
-/* Save stats to DB. */
+/* Save stats to DB (same as sea_usage_flush). */
 SeaError sea_usage_save(SeaUsageTracker* tracker);
 
-/* Load stats from DB. */
+/* Load per-provider totals and the last SEA_USAGE_DAYS_MAX days from
+ * the DB. */
 SeaError sea_usage_load(SeaUsageTracker* tracker);
 
 /* Format a human-readable summary into a buffer. Returns length. */
-u32 sea_usage_summary(const SeaUsageTracker* tracker, char* buf, u32 buf_size);
+u32 sea_usage_summary(SeaUsageTracker* tracker, char* buf, u32 buf_size);
 
 #endif /* SEA_USAGE_H */
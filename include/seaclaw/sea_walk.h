@@ -0,0 +1,100 @@
+/*
+ * sea_walk.h — The Tide Walker
+ *
+ * In-process parallel directory traversal. Workers read directories
+ * with openat()/getdents64() and share the tree through per-worker
+ * work-stealing deques. No shell, no find, no xargs.
+ *
+ * Entries are filtered by name in the workers; matches are handed to
+ * a visitor that runs serialised, so it may append straight into the
+ * caller's arena while the scan is still running.
+ *
+ * "Send every crab down a different tunnel. Meet at the surface."
+ */
+
+#ifndef SEA_WALK_H
+#define SEA_WALK_H
+
+#include "sea_types.h"
+
+/* ── Entry types ──────────────────────────────────────────── */
+
+typedef enum {
+    SEA_WALK_FILE = 0,
+    SEA_WALK_DIR,
+    SEA_WALK_LINK,
+    SEA_WALK_OTHER,
+} SeaWalkType;
+
+/* ── Flags ────────────────────────────────────────────────── */
+
+#define SEA_WALK_FILES_ONLY   (1u << 0)  /* Visit regular files only          */
+#define SEA_WALK_STAT         (1u << 1)  /* Fill size / disk_bytes            */
+#define SEA_WALK_COUNT_LINES  (1u << 2)  /* Read files once, fill lines       */
+#define SEA_WALK_SKIP_HIDDEN  (1u << 3)  /* Skip dot-files and dot-dirs       */
+#define SEA_WALK_XDEV         (1u << 4)  /* Stay on the root's filesystem     */
+
+#define SEA_WALK_MAX_THREADS  16
+#define SEA_WALK_MAX_EXTS     8
+
+/* ── Visited entry (valid only for the duration of the call) ── */
+
+typedef struct {
+    const char* path;        /* Full path, NUL-terminated            */
+    u32         path_len;
+    const char* name;        /* Basename, points into path           */
+    SeaWalkType type;
+    u32         depth;       /* 1 = direct child of root             */
+    u64         size;        /* Apparent size (SEA_WALK_STAT)        */
+    u64         disk_bytes;  /* Allocated blocks * 512 (SEA_WALK_STAT) */
+    u64         lines;       /* Newline count (SEA_WALK_COUNT_LINES) */
+} SeaWalkEntry;
+
+/* Visitor. Calls are serialised across workers.
+ * Return false to stop the walk early. */
+typedef bool (*SeaWalkVisit)(const SeaWalkEntry* entry, void* ctx);
+
+/* ── Options ──────────────────────────────────────────────── */
+
+typedef struct {
+    const char*   root;         /* Directory to scan                        */
+    u32           max_depth;    /* 0 = unlimited                            */
+    u32           threads;      /* 0 = one per online CPU (capped)          */
+    u32           flags;        /* SEA_WALK_* bit set                       */
+    const char*   name_pattern; /* Glob if it has * ? [, else substring.
+                                 * NULL matches everything.                 */
+    const char*   exts[SEA_WALK_MAX_EXTS]; /* Suffix filter, any-of. NULL-terminated */
+    SeaWalkVisit  visit;        /* Called for every matching entry          */
+    void*         ctx;
+} SeaWalkOpts;
+
+/* ── Totals (over every entry seen, matched or not) ───────── */
+
+typedef struct {
+    u64 dirs;
+    u64 files;
+    u64 matched;
+    u64 bytes;       /* Sum of size over matched entries        */
+    u64 disk_bytes;  /* Sum of disk_bytes over matched entries  */
+    u64 lines;       /* Sum of lines over matched entries       */
+    u64 errors;      /* Unreadable directories / files          */
+    bool stopped;    /* Visitor returned false                  */
+} SeaWalkStats;
+
+/* ── API ──────────────────────────────────────────────────── */
+
+/* Walk opts->root. Blocks until every worker is done.
+ * Returns SEA_ERR_IO if the root cannot be opened, SEA_ERR_OOM if the
+ * worker scratch arenas cannot be mapped. */
+SeaError sea_walk(const SeaWalkOpts* opts, SeaWalkStats* stats);
+
+/* True if name matches the pattern (glob or substring, see SeaWalkOpts). */
+bool sea_walk_name_match(const char* pattern, const char* name);
+
+/* Count '\n' bytes in a buffer. AVX2 / NEON when the build allows it. */
+u64 sea_count_newlines(const u8* data, u64 len);
+
+/* Count newlines in an open file. Returns SEA_ERR_IO on read failure. */
+SeaError sea_count_lines_fd(int fd, u64* lines, u64* bytes);
+
+#endif /* SEA_WALK_H */
@@ -0,0 +1,302 @@
+/*
+ * sea_budget.c — SeaZero Token Budget Ledger
+ *
+ * Callers are interned into a fixed table by CAS on the name hash, so
+ * a budget check is a hash, a short probe and an atomic load. Callers
+ * that find the table full share one overflow counter, held to the
+ * same limit, so a flood of names cannot get past the budget. Usage
+ * rows go into a bounded ring under a mutex and are written to
+ * seazero_llm_usage in one transaction per flush by a background
+ * thread on its own connection; the ring is the only thing the
+ * request path ever waits on.
+ */
+
+#include "sea_budget.h"
+#include "seaclaw/sea_log.h"
+#include "seaclaw/sea_hash.h"
+
+#include <sqlite3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+/* ── State ─────────────────────────────────────────────────── */
+
+typedef struct {
+    _Atomic u64  hash;          /* 0 = free     */
+    _Atomic bool ready;         /* name written */
+    char         name[SEA_BUDGET_NAME_MAX];
+    _Atomic i64  used;          /* Tokens today */
+} Caller;
+
+typedef struct {
+    char caller[SEA_BUDGET_NAME_MAX];
+    char provider[32];
+    char model[64];
+    char status[16];
+    i32  tokens_in;
+    i32  tokens_out;
+    i32  latency_ms;
+} Row;
+
+struct SeaBudget {
+    Caller          callers[SEA_BUDGET_CALLERS];
+    Caller          overflow;       /* Everyone the table has no room for */
+    _Atomic bool    overflowed;     /* Warned about it */
+    _Atomic i64     day;            /* UTC day the counters belong to */
+    i64             daily_limit;
+    sqlite3*        conn;           /* Writer's; NULL without a db */
+    bool            own_conn;
+
+    pthread_mutex_t lock;           /* Ring */
+    Row*            ring;
+    u32             head;
+    u32             count;
+    u64             dropped;
+    pthread_mutex_t write_lock;     /* One writer at a time */
+
+    pthread_t       thread;
+    pthread_cond_t  wake;
+    bool            running;
+    bool            has_thread;
+};
+
+static i64 utc_day(void) {
+    return (i64)(time(NULL) / 86400);
+}
+
+static u64 name_hash(const char* s) {
+    u64 h = sea_fnv1a(SEA_FNV1A_INIT, (const u8*)s, strlen(s));
+    return h ? h : 1;
+}
+
+/* Caller's entry; claims a free one if create. NULL if absent, the
+ * overflow entry if the table is full. */
+static Caller* find_caller(SeaBudget* b, const char* name, bool create) {
+    u64 h = name_hash(name);
+    for (u32 n = 0; n < SEA_BUDGET_CALLERS; n++) {
+        Caller* c = &b->callers[(h + n) % SEA_BUDGET_CALLERS];
+        u64 cur = atomic_load_explicit(&c->hash, memory_order_acquire);
+        if (cur == 0) {
+            if (!create) return NULL;
+            if (atomic_compare_exchange_strong(&c->hash, &cur, h)) {
+                strncpy(c->name, name, SEA_BUDGET_NAME_MAX - 1);
+                atomic_store_explicit(&c->ready, true, memory_order_release);
+                return c;
+            }
+            if (cur != h) continue;           /* Lost the slot to another name */
+        }
+        if (cur != h) continue;
+        while (!atomic_load_explicit(&c->ready, memory_order_acquire)) { /* Being named */ }
+        if (strncmp(c->name, name, SEA_BUDGET_NAME_MAX - 1) == 0) return c;
+    }
+    if (create && !atomic_exchange(&b->overflowed, true))
+        SEA_LOG_WARN("BUDGET", "Caller table full; '%s' and later callers share "
+                     "one budget", name);
+    return &b->overflow;
+}
+
+/* Start a new day: the first thread to notice zeroes every counter.
+ * Tokens added by a racing call at the boundary may land either side. */
+static void roll_over(SeaBudget* b) {
+    i64 today = utc_day();
+    i64 day = atomic_load_explicit(&b->day, memory_order_relaxed);
+    if (day == today) return;
+    if (!atomic_compare_exchange_strong(&b->day, &day, today)) return;
+    for (u32 i = 0; i < SEA_BUDGET_CALLERS; i++)
+        atomic_store_explicit(&b->callers[i].used, 0, memory_order_relaxed);
+    atomic_store_explicit(&b->overflow.used, 0, memory_order_relaxed);
+    SEA_LOG_INFO("BUDGET", "New budget day; counters reset");
+}
+
+/* ── Load / Write ──────────────────────────────────────────── */
+
+static void load_today(SeaBudget* b) {
+    if (!b->conn) return;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(b->conn,
+            "SELECT caller, SUM(tokens_in + tokens_out) FROM seazero_llm_usage"
+            " WHERE created_at >= datetime('now', 'start of day') GROUP BY caller",
+            -1, &stmt, NULL) != SQLITE_OK) {
+        SEA_LOG_WARN("BUDGET", "Cannot load usage: %s", sqlite3_errmsg(b->conn));
+        return;
+    }
+    u32 loaded = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const char* name = (const char*)sqlite3_column_text(stmt, 0);
+        if (!name) continue;
+        Caller* c = find_caller(b, name, true);     /* Overflow sums */
+        atomic_fetch_add(&c->used, (i64)sqlite3_column_int64(stmt, 1));
+        loaded++;
+    }
+    sqlite3_finalize(stmt);
+    SEA_LOG_INFO("BUDGET", "Loaded today's usage for %u callers", loaded);
+}
+
+static void write_batch(SeaBudget* b, const Row* batch, u32 n) {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(b->conn,
+            "INSERT INTO seazero_llm_usage (caller, provider, model, tokens_in,"
+            " tokens_out, latency_ms, status) VALUES (?, ?, ?, ?, ?, ?, ?)",
+            -1, &stmt, NULL) != SQLITE_OK) {
+        SEA_LOG_WARN("BUDGET", "Cannot write usage: %s", sqlite3_errmsg(b->conn));
+        return;
+    }
+    /* A shared (in-memory) handle must never be left inside a txn */
+    if (b->own_conn) sqlite3_exec(b->conn, "BEGIN", NULL, NULL, NULL);
+    for (u32 i = 0; i < n; i++) {
+        const Row* r = &batch[i];
+        sqlite3_bind_text(stmt, 1, r->caller, -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 2, r->provider, -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 3, r->model, -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 4, r->tokens_in);
+        sqlite3_bind_int(stmt, 5, r->tokens_out);
+        sqlite3_bind_int(stmt, 6, r->latency_ms);
+        sqlite3_bind_text(stmt, 7, r->status, -1, SQLITE_STATIC);
+        if (sqlite3_step(stmt) != SQLITE_DONE)
+            SEA_LOG_WARN("BUDGET", "Usage row lost: %s", sqlite3_errmsg(b->conn));
+        sqlite3_reset(stmt);
+    }
+    if (b->own_conn) sqlite3_exec(b->conn, "COMMIT", NULL, NULL, NULL);
+    sqlite3_finalize(stmt);
+}
+
+void sea_budget_flush(SeaBudget* budget) {
+    if (!budget) return;
+    pthread_mutex_lock(&budget->write_lock);
+
+    Row batch[64];
+    for (;;) {
+        pthread_mutex_lock(&budget->lock);
+        u32 n = 0;
+        while (budget->count > 0 && n < 64) {
+            batch[n++] = budget->ring[budget->head];
+            budget->head = (budget->head + 1) % SEA_BUDGET_QUEUE_MAX;
+            budget->count--;
+        }
+        pthread_mutex_unlock(&budget->lock);
+        if (n == 0) break;
+        if (budget->conn) write_batch(budget, batch, n);
+    }
+    pthread_mutex_unlock(&budget->write_lock);
+}
+
+static void* writer_thread(void* arg) {
+    SeaBudget* b = (SeaBudget*)arg;
+    pthread_mutex_lock(&b->lock);
+    while (b->running) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        u64 ns = (u64)ts.tv_nsec + (u64)SEA_BUDGET_FLUSH_MS * 1000000;
+        ts.tv_sec += (time_t)(ns / 1000000000);
+        ts.tv_nsec = (long)(ns % 1000000000);
+        pthread_cond_timedwait(&b->wake, &b->lock, &ts);
+        if (!b->running) break;
+        if (b->count == 0) continue;
+        pthread_mutex_unlock(&b->lock);
+        sea_budget_flush(b);
+        pthread_mutex_lock(&b->lock);
+    }
+    pthread_mutex_unlock(&b->lock);
+    return NULL;
+}
+
+/* ── Public API ────────────────────────────────────────────── */
+
+SeaBudget* sea_budget_create(SeaDb* db, i64 daily_limit) {
+    SeaBudget* b = calloc(1, sizeof(SeaBudget));
+    if (!b) return NULL;
+    b->ring = calloc(SEA_BUDGET_QUEUE_MAX, sizeof(Row));
+    if (!b->ring) { free(b); return NULL; }
+    b->conn = sea_db_connect(db);
+    b->own_conn = b->conn != NULL;
+    if (!b->conn) b->conn = sea_db_handle(db);
+    b->daily_limit = daily_limit;
+    atomic_store(&b->day, utc_day());
+    pthread_mutex_init(&b->lock, NULL);
+    pthread_mutex_init(&b->write_lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&b->wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    load_today(b);
+
+    b->running = true;
+    if (pthread_create(&b->thread, NULL, writer_thread, b) == 0) {
+        b->has_thread = true;
+    } else {
+        b->running = false;
+        SEA_LOG_WARN("BUDGET", "No writer thread; usage rows written on destroy");
+    }
+    return b;
+}
+
+void sea_budget_destroy(SeaBudget* budget) {
+    if (!budget) return;
+    pthread_mutex_lock(&budget->lock);
+    budget->running = false;
+    pthread_cond_broadcast(&budget->wake);
+    pthread_mutex_unlock(&budget->lock);
+    if (budget->has_thread) pthread_join(budget->thread, NULL);
+    sea_budget_flush(budget);
+    if (budget->dropped)
+        SEA_LOG_WARN("BUDGET", "%llu usage rows dropped (queue full)",
+                     (unsigned long long)budget->dropped);
+    pthread_cond_destroy(&budget->wake);
+    pthread_mutex_destroy(&budget->write_lock);
+    pthread_mutex_destroy(&budget->lock);
+    if (budget->own_conn) sqlite3_close(budget->conn);
+    free(budget->ring);
+    free(budget);
+}
+
+bool sea_budget_allow(SeaBudget* budget, const char* caller, i64* used) {
+    if (used) *used = 0;
+    if (!budget || !caller) return true;
+    roll_over(budget);
+    Caller* c = find_caller(budget, caller, false);
+    i64 spent = c ? atomic_load_explicit(&c->used, memory_order_relaxed) : 0;
+    if (used) *used = spent;
+    return budget->daily_limit <= 0 || spent < budget->daily_limit;
+}
+
+i64 sea_budget_used(SeaBudget* budget, const char* caller) {
+    i64 used;
+    sea_budget_allow(budget, caller, &used);
+    return used;
+}
+
+static void copy_field(char* dst, size_t cap, const char* src) {
+    snprintf(dst, cap, "%s", src ? src : "unknown");
+}
+
+void sea_budget_record(SeaBudget* budget, const SeaBudgetRecord* rec) {
+    if (!budget || !rec || !rec->caller) return;
+    roll_over(budget);
+    Caller* c = find_caller(budget, rec->caller, true);
+    i64 tokens = (i64)rec->tokens_in + rec->tokens_out;
+    if (tokens > 0) atomic_fetch_add_explicit(&c->used, tokens, memory_order_relaxed);
+
+    pthread_mutex_lock(&budget->lock);
+    if (budget->count == SEA_BUDGET_QUEUE_MAX) {
+        budget->dropped++;
+    } else {
+        Row* r = &budget->ring[(budget->head + budget->count) % SEA_BUDGET_QUEUE_MAX];
+        copy_field(r->caller, sizeof(r->caller), rec->caller);
+        copy_field(r->provider, sizeof(r->provider), rec->provider);
+        copy_field(r->model, sizeof(r->model), rec->model);
+        copy_field(r->status, sizeof(r->status), rec->status);
+        r->tokens_in  = rec->tokens_in;
+        r->tokens_out = rec->tokens_out;
+        r->latency_ms = rec->latency_ms;
+        budget->count++;
+        if (budget->count == SEA_BUDGET_QUEUE_MAX / 2)
+            pthread_cond_signal(&budget->wake);     /* Write early under load */
+    }
+    pthread_mutex_unlock(&budget->lock);
+}
@@ -0,0 +1,62 @@
+/*
+ * sea_budget.h — SeaZero Token Budget Ledger
+ *
+ * Keeps today's token spend per caller in memory so the proxy can
+ * check a budget without touching SQLite. Counters are atomics in a
+ * fixed caller table; the day rolls over at UTC midnight, matching
+ * the created_at timestamps in seazero_llm_usage.
+ *
+ * Design:
+ *   - Today's totals are loaded from seazero_llm_usage at startup
+ *   - Callers beyond SEA_BUDGET_CALLERS share one overflow total,
+ *     held to the same daily limit
+ *   - sea_budget_allow / sea_budget_record never block on the DB
+ *   - Usage rows are queued and written by a background thread
+ */
+
+#ifndef SEA_BUDGET_H
+#define SEA_BUDGET_H
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_db.h"
+
+#define SEA_BUDGET_CALLERS      32
+#define SEA_BUDGET_NAME_MAX     64
+#define SEA_BUDGET_FLUSH_MS     1000
+#define SEA_BUDGET_QUEUE_MAX    1024     /* Unwritten rows before dropping */
+
+typedef struct SeaBudget SeaBudget;
+
+/* One proxied call, as logged to seazero_llm_usage. */
+typedef struct {
+    const char* caller;
+    const char* provider;
+    const char* model;
+    i32         tokens_in;
+    i32         tokens_out;
+    i32         latency_ms;
+    const char* status;         /* ok, error, cancelled, cached, shared */
+} SeaBudgetRecord;
+
+/* Create the ledger, load today's totals from db (may be NULL) and
+ * start the writer. daily_limit <= 0 means unlimited. */
+SeaBudget* sea_budget_create(SeaDb* db, i64 daily_limit);
+
+/* Stop the writer, write what is queued, free. */
+void sea_budget_destroy(SeaBudget* budget);
+
+/* True if caller is under today's limit. used (optional) gets today's
+ * spend. Lock-free. */
+bool sea_budget_allow(SeaBudget* budget, const char* caller, i64* used);
+
+/* Add a call's tokens to the caller's total and queue its usage row. */
+void sea_budget_record(SeaBudget* budget, const SeaBudgetRecord* rec);
+
+/* Today's spend for caller (0 if unknown; the shared overflow total
+ * once the caller table is full). */
+i64 sea_budget_used(SeaBudget* budget, const char* caller);
+
+/* Write queued usage rows now. */
+void sea_budget_flush(SeaBudget* budget);
+
+#endif /* SEA_BUDGET_H */
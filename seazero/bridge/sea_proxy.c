@@ -3,7 +3,27 @@
  *
  * Lightweight HTTP server that proxies Agent Zero's LLM requests
  * through SeaClaw. Validates internal token, checks budget, forwards
- * to real LLM, logs usage. Pure POSIX sockets + pthread.
+ * to real LLM, logs usage. Pure POSIX sockets + pthread. Budget checks
+ * and usage logging go through the in-memory ledger (sea_budget).
+ *
+ * One epoll thread accepts, reads, parses and writes; sockets are
+ * non-blocking and connections stay open between requests. Health
+ * checks and rejections are answered inline. Chat completions are
+ * queued to a pool of upstream workers, and the connection stops
+ * reading until its answer is back, so pipelined requests are answered
+ * in order. Workers hand responses back through an eventfd.
+ *
+ * A request with "stream":true is relayed as it is generated: each
+ * piece of the upstream SSE body becomes one HTTP chunk to the client.
+ * At most SEA_PROXY_STREAM_WINDOW bytes are in flight per stream; past
+ * that the worker stops reading upstream until the client catches up.
+ * Token usage is picked out of the SSE events as they pass, so the
+ * body is never held whole. A client that hangs up cancels the
+ * upstream call.
+ *
+ * Non-streamed requests go through the shared LLM cache: an identical
+ * request already in flight is waited on instead of sent again, and a
+ * deterministic one (temperature 0) may be answered from SQLite.
  *
  * Endpoint:
  *   POST /v1/chat/completions  — OpenAI-compatible proxy
@@ -15,7 +35,9 @@
  */
 
 #include "sea_proxy.h"
+#include "sea_budget.h"
 #include "seaclaw/sea_http.h"
+#include "seaclaw/sea_llm_cache.h"
 #include "seaclaw/sea_json.h"
 #include "seaclaw/sea_log.h"
 #include "seaclaw/sea_shield.h"
@@ -23,107 +45,331 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <errno.h>
 #include <time.h>
-#include <signal.h>
 
-#define PROXY_MAX_BODY      (256 * 1024)  /* 256KB max request body */
-#define PROXY_MAX_HEADERS   (8 * 1024)    /* 8KB max headers        */
-#define PROXY_BACKLOG       8
-#define PROXY_ARENA_SIZE    (512 * 1024)  /* 512KB per-request arena */
+#define PROXY_BACKLOG       128
+#define PROXY_READ_CHUNK    16384
+#define EV_LISTEN           0
+#define EV_WAKE             1
+#define EV_CONN(i)          ((i) + 2)
 
-/* ── Global State ──────────────────────────────────────────── */
+/* ── State ─────────────────────────────────────────────────── */
 
-static SeaProxyConfig s_proxy_cfg = {0};
-static int            s_listen_fd = -1;
-static pthread_t      s_proxy_tid;
-static volatile bool  s_proxy_running = false;
+typedef struct {
+    int   fd;                 /* -1 = free slot                         */
+    u32   gen;                /* Bumped on close; stale answers dropped */
+    char* in;
+    u32   in_len;
+    u32   in_cap;
+    char* out;
+    u32   out_len;
+    u32   out_sent;
+    bool  busy;               /* A worker owns the current request      */
+    bool  close_after;        /* Close once out is flushed              */
+    bool  want_write;         /* EPOLLOUT registered                    */
+    u64   last_active;
+    struct ProxyJob* job;     /* Upstream call in flight, while busy    */
+} ProxyConn;
+
+typedef struct ProxyJob {
+    struct ProxyJob* next;
+    u32   conn;
+    u32   gen;
+    bool  keep_alive;
+    char* body;               /* Copy of the request body               */
+    u32   body_len;
+    char* response;           /* Full HTTP response (or final chunk)    */
+    u32   response_len;
+    bool  stream;             /* Chunked SSE answer                     */
+    bool  head_sent;          /* Stream status line queued              */
+    _Atomic bool abandoned;   /* Client hung up                         */
+    _Atomic u32  unsent;      /* Stream bytes not yet written to client */
+} ProxyJob;
+
+/* A piece of a streamed answer on its way to a connection. */
+typedef struct ProxyFrame {
+    struct ProxyFrame* next;
+    u32   conn;
+    u32   gen;
+    u32   len;
+    char  data[];
+} ProxyFrame;
+
+static SeaProxyConfig   s_proxy_cfg = {0};
+static int              s_listen_fd = -1;
+static int              s_epoll_fd  = -1;
+static int              s_wake_fd   = -1;
+static pthread_t        s_proxy_tid;
+static pthread_t*       s_workers;
+static u32              s_worker_count;
+static volatile bool    s_proxy_running = false;
+static _Atomic bool     s_stop;
+static ProxyConn        s_conns[SEA_PROXY_CONNS];
+static SeaBudget*       s_budget;
+static SeaLlmCache*     s_cache;
+
+static pthread_mutex_t  s_lock = PTHREAD_MUTEX_INITIALIZER;   /* Job queues */
+static pthread_cond_t   s_job_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   s_window_cond = PTHREAD_COND_INITIALIZER; /* Streams drained */
+static ProxyJob*        s_todo_head;
+static ProxyJob*        s_todo_tail;
+static ProxyJob*        s_done;
+static ProxyFrame*      s_frame_head;     /* FIFO, drained before done */
+static ProxyFrame*      s_frame_tail;
+
+static u64 mono_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000 + (u64)ts.tv_nsec / 1000;
+}
+
+static u64 mono_ms(void) {
+    return mono_us() / 1000;
+}
+
+static void wake_loop(void) {
+    u64 one = 1;
+    ssize_t n = write(s_wake_fd, &one, sizeof(one));
+    (void)n;
+}
 
 /* ── HTTP Response Helpers ─────────────────────────────────── */
 
-static void send_response(int fd, int status, const char* status_text,
-                           const char* content_type, const char* body, int body_len) {
+static const char* status_text(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 413: return "Payload Too Large";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        default:  return status < 400 ? "OK" : "Error";
+    }
+}
+
+/* Build a complete response into a malloc'd buffer. */
+static char* build_response(int status, const char* content_type,
+                            const char* body, u32 body_len,
+                            bool keep_alive, u32* out_len) {
     char header[512];
     int hlen = snprintf(header, sizeof(header),
         "HTTP/1.1 %d %s\r\n"
         "Content-Type: %s\r\n"
-        "Content-Length: %d\r\n"
-        "Connection: close\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: %s\r\n"
         "Access-Control-Allow-Origin: *\r\n"
         "\r\n",
-        status, status_text, content_type, body_len);
-
-    ssize_t written = write(fd, header, (size_t)hlen);
-    if (written < 0) {
-        SEA_LOG_ERROR("PROXY", "Failed to write response header: %s", strerror(errno));
-        return;
-    }
-    if (body && body_len > 0) {
-        written = write(fd, body, (size_t)body_len);
-        if (written < 0) {
-            SEA_LOG_ERROR("PROXY", "Failed to write response body: %s", strerror(errno));
-        }
-    }
+        status, status_text(status), content_type, body_len,
+        keep_alive ? "keep-alive" : "close");
+    char* buf = malloc((size_t)hlen + body_len);
+    if (!buf) return NULL;
+    memcpy(buf, header, (size_t)hlen);
+    if (body_len) memcpy(buf + hlen, body, body_len);
+    *out_len = (u32)hlen + body_len;
+    return buf;
 }
 
-static void send_json_error(int fd, int status, const char* message) {
+static char* build_json_error(int status, const char* message,
+                              bool keep_alive, u32* out_len) {
     char body[256];
     int blen = snprintf(body, sizeof(body),
         "{\"error\":{\"message\":\"%s\",\"type\":\"proxy_error\",\"code\":%d}}",
         message, status);
-    send_response(fd, status, "Error", "application/json", body, blen);
+    return build_response(status, "application/json", body, (u32)blen, keep_alive, out_len);
 }
 
-static void send_json_ok(int fd, const char* body, int body_len) {
-    send_response(fd, 200, "OK", "application/json", body, body_len);
+/* ── Connections ───────────────────────────────────────────── */
+
+static void conn_close(u32 idx) {
+    ProxyConn* c = &s_conns[idx];
+    if (c->fd < 0) return;
+    if (c->busy && c->job) {
+        pthread_mutex_lock(&s_lock);
+        atomic_store(&c->job->abandoned, true);
+        pthread_cond_broadcast(&s_window_cond);
+        pthread_mutex_unlock(&s_lock);
+    }
+    epoll_ctl(s_epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    free(c->in);
+    free(c->out);
+    u32 gen = c->gen + 1;
+    memset(c, 0, sizeof(*c));
+    c->fd  = -1;
+    c->gen = gen;
+}
+
+static void conn_watch(u32 idx, bool want_write) {
+    ProxyConn* c = &s_conns[idx];
+    if (c->want_write == want_write) return;
+    struct epoll_event ev = {
+        .events = (want_write ? EPOLLOUT : EPOLLIN) | EPOLLRDHUP,
+        .data.u32 = EV_CONN(idx),
+    };
+    epoll_ctl(s_epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+    c->want_write = want_write;
+}
+
+/* Give a stalled stream its window back as the client reads. While a
+ * connection is busy everything in out is stream bytes. */
+static void stream_sent(ProxyConn* c, u32 sent) {
+    if (!sent || !c->busy || !c->job) return;
+    u32 before = atomic_fetch_sub(&c->job->unsent, sent);
+    if (before > SEA_PROXY_STREAM_WINDOW && before - sent <= SEA_PROXY_STREAM_WINDOW) {
+        pthread_mutex_lock(&s_lock);
+        pthread_cond_broadcast(&s_window_cond);
+        pthread_mutex_unlock(&s_lock);
+    }
+}
+
+/* Flush pending output; once drained go back to reading. */
+static void conn_write(u32 idx) {
+    ProxyConn* c = &s_conns[idx];
+    u32 start = c->out_sent;
+    while (c->out_sent < c->out_len) {
+        ssize_t n = send(c->fd, c->out + c->out_sent, c->out_len - c->out_sent, MSG_NOSIGNAL);
+        if (n > 0) { c->out_sent += (u32)n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            stream_sent(c, c->out_sent - start);
+            conn_watch(idx, true);
+            return;
+        }
+        conn_close(idx);
+        return;
+    }
+    stream_sent(c, c->out_sent - start);
+    free(c->out);
+    c->out = NULL;
+    c->out_len = c->out_sent = 0;
+    if (c->close_after) { conn_close(idx); return; }
+    conn_watch(idx, false);
+}
+
+static void conn_send(u32 idx, char* response, u32 len, bool keep_alive) {
+    ProxyConn* c = &s_conns[idx];
+    if (!response) { conn_close(idx); return; }
+    c->out = response;
+    c->out_len = len;
+    c->out_sent = 0;
+    if (!keep_alive) c->close_after = true;
+    conn_write(idx);
+}
+
+/* Queue bytes behind any unsent output (streamed answers). */
+static void conn_append(u32 idx, const char* data, u32 len) {
+    ProxyConn* c = &s_conns[idx];
+    u32 pending = c->out_len - c->out_sent;
+    char* out = malloc((size_t)pending + len);
+    if (!out) { conn_close(idx); return; }
+    if (pending) memcpy(out, c->out + c->out_sent, pending);
+    memcpy(out + pending, data, len);
+    free(c->out);
+    c->out = out;
+    c->out_len = pending + len;
+    c->out_sent = 0;
+    conn_write(idx);
+}
+
+static void reply_error(u32 idx, int status, const char* message, bool keep_alive) {
+    u32 len;
+    char* resp = build_json_error(status, message, keep_alive, &len);
+    conn_send(idx, resp, len, keep_alive);
 }
 
 /* ── Request Parsing ───────────────────────────────────────── */
 
 typedef struct {
-    char method[8];         /* GET, POST */
-    char path[128];         /* /v1/chat/completions */
-    char auth_token[128];   /* Bearer token from Authorization header */
-    char* body;             /* POST body (points into buf) */
-    int body_len;
+    const char* method;   u32 method_len;
+    const char* path;     u32 path_len;
+    const char* token;    u32 token_len;   /* Bearer token, if any */
+    const char* body;
+    u32         body_len;
+    u32         total;    /* Bytes consumed from the buffer */
+    bool        keep_alive;
+    int         error;    /* HTTP status for a malformed request */
 } ProxyRequest;
 
-static bool parse_request(char* buf, int buf_len, ProxyRequest* req) {
-    memset(req, 0, sizeof(*req));
+static bool span_eq(const char* p, u32 len, const char* lit) {
+    return strlen(lit) == len && memcmp(p, lit, len) == 0;
+}
 
-    /* Parse request line: METHOD PATH HTTP/1.x */
-    char* line_end = strstr(buf, "\r\n");
-    if (!line_end) return false;
-
-    if (sscanf(buf, "%7s %127s", req->method, req->path) != 2) return false;
-
-    /* Find Authorization header */
-    char* auth = strcasestr(buf, "\nAuthorization: Bearer ");
-    if (auth) {
-        auth += strlen("\nAuthorization: Bearer ");
-        char* auth_end = strstr(auth, "\r\n");
-        if (auth_end) {
-            int len = (int)(auth_end - auth);
-            if (len > 0 && len < (int)sizeof(req->auth_token)) {
-                memcpy(req->auth_token, auth, (size_t)len);
-                req->auth_token[len] = '\0';
-            }
+/* Parse one request from the front of buf. Returns false while it is
+ * still incomplete; a malformed request sets error instead. */
+static bool parse_request(const char* buf, u32 len, ProxyRequest* req) {
+    memset(req, 0, sizeof(*req));
+    const char* end = NULL;
+    for (u32 i = 0; i + 3 < len; i++) {
+        if (buf[i] == '\r' && buf[i + 1] == '\n' && buf[i + 2] == '\r' && buf[i + 3] == '\n') {
+            end = buf + i;
+            break;
         }
     }
+    if (!end) {
+        if (len > SEA_PROXY_MAX_HEADERS) { req->error = 431; return true; }
+        return false;
+    }
 
-    /* Find body (after \r\n\r\n) */
-    char* body_start = strstr(buf, "\r\n\r\n");
-    if (body_start) {
-        body_start += 4;
-        req->body = body_start;
-        req->body_len = buf_len - (int)(body_start - buf);
+    /* Request line: METHOD PATH HTTP/1.x */
+    const char* p = buf;
+    const char* eol = memchr(p, '\r', (size_t)(end - p) + 1);
+    const char* sp1 = memchr(p, ' ', (size_t)(eol - p));
+    const char* sp2 = sp1 ? memchr(sp1 + 1, ' ', (size_t)(eol - sp1 - 1)) : NULL;
+    if (!sp1 || !sp2) { req->error = 400; return true; }
+    req->method = p;       req->method_len = (u32)(sp1 - p);
+    req->path   = sp1 + 1; req->path_len   = (u32)(sp2 - sp1 - 1);
+    req->keep_alive = span_eq(sp2 + 1, (u32)(eol - sp2 - 1), "HTTP/1.1");
+
+    u64 content_length = 0;
+    for (p = eol + 2; p < end; ) {
+        const char* le = memchr(p, '\r', (size_t)(end - p) + 1);
+        const char* colon = memchr(p, ':', (size_t)(le - p));
+        if (colon) {
+            u32 nlen = (u32)(colon - p);
+            const char* v = colon + 1;
+            while (v < le && (*v == ' ' || *v == '\t')) v++;
+            u32 vlen = (u32)(le - v);
+            if (nlen == 14 && strncasecmp(p, "Content-Length", 14) == 0) {
+                content_length = strtoull(v, NULL, 10);
+            } else if (nlen == 10 && strncasecmp(p, "Connection", 10) == 0) {
+                if (vlen >= 5 && strncasecmp(v, "close", 5) == 0) req->keep_alive = false;
+                else if (vlen >= 10 && strncasecmp(v, "keep-alive", 10) == 0) req->keep_alive = true;
+            } else if (nlen == 13 && strncasecmp(p, "Authorization", 13) == 0) {
+                if (vlen > 7 && strncasecmp(v, "Bearer ", 7) == 0) {
+                    req->token = v + 7;
+                    req->token_len = vlen - 7;
+                }
+            } else if (nlen == 17 && strncasecmp(p, "Transfer-Encoding", 17) == 0) {
+                req->error = 501;                   /* No chunked bodies */
+                return true;
+            }
+        }
+        p = le + 2;
     }
 
+    u32 head = (u32)(end - buf) + 4;
+    if (content_length > SEA_PROXY_MAX_BODY) { req->error = 413; return true; }
+    if (len < head + content_length) return false;
+    req->body = buf + head;
+    req->body_len = (u32)content_length;
+    req->total = head + (u32)content_length;
     return true;
 }
 
@@ -133,46 +379,227 @@ static bool validate_token(const ProxyRequest* req) {
     if (!s_proxy_cfg.internal_token || !s_proxy_cfg.internal_token[0]) {
         return true; /* No token configured = allow all (dev mode) */
     }
-    return req->auth_token[0] &&
-           strcmp(req->auth_token, s_proxy_cfg.internal_token) == 0;
+    return req->token_len > 0 &&
+           span_eq(req->token, req->token_len, s_proxy_cfg.internal_token);
 }
 
 /* ── Budget Check ──────────────────────────────────────────── */
 
 static bool check_budget(const char* caller) {
-    if (s_proxy_cfg.daily_token_budget <= 0) return true; /* Unlimited */
-    if (!s_proxy_cfg.db) return true; /* No DB = can't track */
+    i64 used;
+    if (sea_budget_allow(s_budget, caller, &used)) return true;
+    SEA_LOG_WARN("PROXY", "Budget exceeded for %s: %lld/%lld tokens",
+                 caller, (long long)used, (long long)s_proxy_cfg.daily_token_budget);
+    return false;
+}
 
-    i64 used = sea_db_sz_llm_total_tokens(s_proxy_cfg.db, caller);
-    if (used >= s_proxy_cfg.daily_token_budget) {
-        SEA_LOG_WARN("PROXY", "Budget exceeded for %s: %lld/%lld tokens",
-                     caller, (long long)used, (long long)s_proxy_cfg.daily_token_budget);
-        return false;
-    }
+/* ── Handle /v1/chat/completions (worker) ──────────────────── */
+
+static void log_usage(i32 tokens_in, i32 tokens_out, i32 latency_ms, const char* status) {
+    SeaBudgetRecord rec = {
+        .caller     = "agent-zero",
+        .provider   = s_proxy_cfg.real_provider,
+        .model      = s_proxy_cfg.real_model,
+        .tokens_in  = tokens_in,
+        .tokens_out = tokens_out,
+        .latency_ms = latency_ms,
+        .status     = status,
+    };
+    sea_budget_record(s_budget, &rec);
+}
+
+/* Queue a piece of a streamed answer (prefix + data + suffix) for the
+ * loop, counting it against the stream's window. */
+static bool push_frame(ProxyJob* job, const char* prefix, u32 prefix_len,
+                       const u8* data, u32 len, const char* suffix, u32 suffix_len) {
+    u32 total = prefix_len + len + suffix_len;
+    ProxyFrame* f = malloc(sizeof(ProxyFrame) + total);
+    if (!f) return false;
+    f->next = NULL;
+    f->conn = job->conn;
+    f->gen  = job->gen;
+    f->len  = total;
+    memcpy(f->data, prefix, prefix_len);
+    if (len) memcpy(f->data + prefix_len, data, len);
+    if (suffix_len) memcpy(f->data + prefix_len + len, suffix, suffix_len);
+    atomic_fetch_add(&job->unsent, total);
+
+    pthread_mutex_lock(&s_lock);
+    if (s_frame_tail) s_frame_tail->next = f;
+    else s_frame_head = f;
+    s_frame_tail = f;
+    pthread_mutex_unlock(&s_lock);
+    wake_loop();
     return true;
 }
 
-/* ── Handle /v1/chat/completions ─────────────────────────── */
+#define SSE_LINE_MAX 8192
 
-static void handle_chat_completions(int fd, ProxyRequest* req) {
-    if (!req->body || req->body_len <= 0) {
-        send_json_error(fd, 400, "Empty request body");
-        return;
+typedef struct {
+    ProxyJob*    job;
+    SeaArena*    arena;       /* Usage events are parsed here          */
+    SeaArenaMark mark;        /* Rewind point before each event        */
+    char         line[SSE_LINE_MAX];
+    u32          line_len;
+    bool         line_skip;   /* Line overflowed; ignore it            */
+    i32          tokens_in;
+    i32          tokens_out;
+} StreamState;
+
+/* OpenAI sends usage in a final event (with include_usage); Anthropic
+ * splits it over message_start and message_delta. Counts are running
+ * totals, so keep the largest seen. */
+static void sse_event(StreamState* st, const char* data, u32 len) {
+    if (len >= 6 && memcmp(data, "[DONE]", 6) == 0) return;
+    if (!memmem(data, len, "\"usage\"", 7)) return;
+
+    sea_arena_rewind(st->arena, st->mark);
+    SeaJsonValue root;
+    if (sea_json_parse((SeaSlice){ .data = (const u8*)data, .len = len },
+                       st->arena, &root) != SEA_OK) return;
+    const SeaJsonValue* usage = sea_json_get(&root, "usage");
+    if (!usage || usage->type != SEA_JSON_OBJECT) {
+        const SeaJsonValue* msg = sea_json_get(&root, "message");
+        usage = msg ? sea_json_get(msg, "usage") : NULL;
     }
+    if (!usage || usage->type != SEA_JSON_OBJECT) return;
+
+    i32 in  = (i32)sea_json_get_number(usage, "prompt_tokens",
+                   sea_json_get_number(usage, "input_tokens", 0));
+    i32 out = (i32)sea_json_get_number(usage, "completion_tokens",
+                   sea_json_get_number(usage, "output_tokens", 0));
+    if (in > st->tokens_in) st->tokens_in = in;
+    if (out > st->tokens_out) st->tokens_out = out;
+}
 
-    /* Validate token */
-    if (!validate_token(req)) {
-        send_json_error(fd, 401, "Invalid authorization token");
-        if (s_proxy_cfg.db) {
-            sea_db_sz_audit(s_proxy_cfg.db, "auth_failure", "proxy",
-                            "agent-zero", "Invalid internal token", "warn");
+/* Split the SSE body into lines across reads; hand on data fields. */
+static void sse_scan(StreamState* st, const u8* data, u32 len) {
+    for (u32 i = 0; i < len; i++) {
+        char ch = (char)data[i];
+        if (ch != '\n') {
+            if (st->line_len < SSE_LINE_MAX) st->line[st->line_len++] = ch;
+            else st->line_skip = true;
+            continue;
         }
+        u32 n = st->line_len;
+        if (n > 0 && st->line[n - 1] == '\r') n--;
+        if (!st->line_skip && n > 5 && memcmp(st->line, "data:", 5) == 0) {
+            u32 off = st->line[5] == ' ' ? 6 : 5;
+            sse_event(st, st->line + off, n - off);
+        }
+        st->line_len = 0;
+        st->line_skip = false;
+    }
+}
+
+/* Upstream sink: relay each piece as one chunk, then wait while the
+ * client is more than a window behind. */
+static bool stream_data(i32 status, const u8* data, u32 len, void* arg) {
+    StreamState* st = (StreamState*)arg;
+    ProxyJob* job = st->job;
+    if (atomic_load(&job->abandoned)) return false;
+    if (len == 0) return true;                  /* A 0 chunk ends the body */
+
+    if (!job->head_sent) {
+        char head[320];
+        int hlen = snprintf(head, sizeof(head),
+            "HTTP/1.1 %d %s\r\n"
+            "Content-Type: %s\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Connection: %s\r\n"
+            "Access-Control-Allow-Origin: *\r\n"
+            "\r\n",
+            status, status_text(status),
+            status == 200 ? "text/event-stream" : "application/json",
+            job->keep_alive ? "keep-alive" : "close");
+        if (!push_frame(job, head, (u32)hlen, NULL, 0, NULL, 0)) return false;
+        job->head_sent = true;
+    }
+    if (status == 200) sse_scan(st, data, len);
+
+    char size[16];
+    int slen = snprintf(size, sizeof(size), "%x\r\n", len);
+    if (!push_frame(job, size, (u32)slen, data, len, "\r\n", 2)) return false;
+
+    pthread_mutex_lock(&s_lock);
+    while (atomic_load(&job->unsent) > SEA_PROXY_STREAM_WINDOW &&
+           !atomic_load(&job->abandoned) && !atomic_load(&s_stop))
+        pthread_cond_wait(&s_window_cond, &s_lock);
+    pthread_mutex_unlock(&s_lock);
+    return !atomic_load(&job->abandoned) && !atomic_load(&s_stop);
+}
+
+/* Ask an OpenAI-style upstream to end the stream with a usage event. */
+static SeaSlice with_stream_usage(SeaSlice body, SeaArena* arena) {
+    static const char opt[] = "\"stream_options\":{\"include_usage\":true}";
+    u32 i = 0;
+    while (i < body.len && body.data[i] != '{') i++;
+    if (i == body.len) return body;
+    u32 j = i + 1;
+    while (j < body.len && (body.data[j] == ' ' || body.data[j] == '\t' ||
+                            body.data[j] == '\r' || body.data[j] == '\n')) j++;
+    bool empty = j < body.len && body.data[j] == '}';
+
+    u32 len = body.len + (u32)sizeof(opt) - 1 + (empty ? 0 : 1);
+    u8* out = (u8*)sea_arena_alloc(arena, len, 1);
+    if (!out) return body;
+    memcpy(out, body.data, i + 1);
+    memcpy(out + i + 1, opt, sizeof(opt) - 1);
+    u32 pos = i + 1 + (u32)sizeof(opt) - 1;
+    if (!empty) out[pos++] = ',';
+    memcpy(out + pos, body.data + i + 1, body.len - i - 1);
+    return (SeaSlice){ .data = out, .len = len };
+}
+
+static void run_stream(ProxyJob* job, SeaArena* arena, const char* auth_hdr, SeaSlice body) {
+    StreamState* st = (StreamState*)sea_arena_alloc(arena, sizeof(StreamState), 8);
+    if (!st) {
+        job->response = build_json_error(500, "Internal arena allocation failed",
+                                         job->keep_alive, &job->response_len);
         return;
     }
+    memset(st, 0, sizeof(*st));
+    st->job = job;
+    st->arena = arena;
+    st->mark = sea_arena_mark(arena);
+
+    SeaHttpResponse resp = {0};
+    u64 t0 = mono_us();
+    SeaError err = sea_http_post_stream(s_proxy_cfg.real_api_url, body, auth_hdr,
+                                        stream_data, st, &resp);
+    i32 latency_ms = (i32)((mono_us() - t0 + 500) / 1000);
+    bool cancelled = atomic_load(&job->abandoned);
+
+    if (job->head_sent && err == SEA_OK) {
+        job->response = malloc(5);
+        if (job->response) memcpy(job->response, "0\r\n\r\n", 5);
+        job->response_len = 5;
+    } else if (job->head_sent) {
+        job->keep_alive = false;            /* Cut short: close, no terminator */
+    } else if (err != SEA_OK) {
+        SEA_LOG_ERROR("PROXY", "LLM stream failed: %s", sea_error_str(err));
+        job->response = build_json_error(502, "LLM provider unreachable",
+                                         job->keep_alive, &job->response_len);
+    } else {
+        job->response = build_response(resp.status_code, "application/json", NULL, 0,
+                                       job->keep_alive, &job->response_len);
+    }
+
+    log_usage(st->tokens_in, st->tokens_out, latency_ms,
+              cancelled ? "cancelled" : err == SEA_OK ? "ok" : "error");
+    SEA_LOG_INFO("PROXY", "LLM stream: HTTP %d, %dms, %s (in=%d, out=%d)",
+                 resp.status_code, latency_ms,
+                 cancelled ? "cancelled by client" : err == SEA_OK ? "complete" : "failed",
+                 st->tokens_in, st->tokens_out);
+}
+
+static void run_chat_completions(ProxyJob* job, SeaArena* arena) {
+    bool ka = job->keep_alive;
 
     /* Check budget */
     if (!check_budget("agent-zero")) {
-        send_json_error(fd, 429, "Daily token budget exceeded");
+        job->response = build_json_error(429, "Daily token budget exceeded", ka, &job->response_len);
         if (s_proxy_cfg.db) {
             sea_db_sz_audit(s_proxy_cfg.db, "budget_exceeded", "proxy",
                             "agent-zero", NULL, "warn");
@@ -180,17 +607,13 @@ static void handle_chat_completions(int fd, ProxyRequest* req) {
         return;
     }
 
-    /* Create per-request arena */
-    SeaArena arena;
-    if (sea_arena_create(&arena, PROXY_ARENA_SIZE) != SEA_OK) {
-        send_json_error(fd, 500, "Internal arena allocation failed");
-        return;
-    }
+    sea_arena_reset(arena);
 
     /* Forward to real LLM */
+    bool anthropic = s_proxy_cfg.real_provider &&
+                     strcmp(s_proxy_cfg.real_provider, "anthropic") == 0;
     char auth_hdr[256];
-    if (s_proxy_cfg.real_provider &&
-        strcmp(s_proxy_cfg.real_provider, "anthropic") == 0) {
+    if (anthropic) {
         snprintf(auth_hdr, sizeof(auth_hdr), "x-api-key: %s",
                  s_proxy_cfg.real_api_key);
     } else {
@@ -198,158 +621,371 @@ static void handle_chat_completions(int fd, ProxyRequest* req) {
                  s_proxy_cfg.real_api_key);
     }
 
-    SeaSlice body = { .data = (const u8*)req->body, .len = (u32)req->body_len };
+    SeaSlice body = { .data = (const u8*)job->body, .len = job->body_len };
+
+    /* Streaming request? */
+    bool want_usage = false;
+    SeaJsonValue req;
+    if (sea_json_parse(body, arena, &req) == SEA_OK && req.type == SEA_JSON_OBJECT) {
+        job->stream = sea_json_get_bool(&req, "stream", false);
+        want_usage = job->stream && !anthropic && !sea_json_get(&req, "stream_options");
+    }
+    sea_arena_reset(arena);
+
+    SEA_LOG_INFO("PROXY", "Forwarding %u bytes to %s%s",
+                 job->body_len, s_proxy_cfg.real_api_url, job->stream ? " (stream)" : "");
+
+    if (job->stream) {
+        if (want_usage) body = with_stream_usage(body, arena);
+        run_stream(job, arena, auth_hdr, body);
+        return;
+    }
 
-    SEA_LOG_INFO("PROXY", "Forwarding %d bytes to %s",
-                 req->body_len, s_proxy_cfg.real_api_url);
+    /* Identical request cached or in flight? */
+    u64 t0 = mono_us();
+    SeaLlmCacheKey key;
+    SeaCacheResult cached = SEA_CACHE_BYPASS;
+    SeaSlice reused;
+    if (sea_llm_cache_key(s_cache, s_proxy_cfg.real_api_url, body, arena, &key) == SEA_OK)
+        cached = sea_llm_cache_begin(s_cache, &key, arena, &reused);
+    if (cached == SEA_CACHE_HIT || cached == SEA_CACHE_SHARED) {
+        i32 wait_ms = (i32)((mono_us() - t0 + 500) / 1000);
+        log_usage(0, 0, wait_ms, cached == SEA_CACHE_HIT ? "cached" : "shared");
+        SEA_LOG_INFO("PROXY", "LLM response %s: %u bytes, %dms",
+                     cached == SEA_CACHE_HIT ? "from cache" : "shared", reused.len, wait_ms);
+        job->response = build_response(200, "application/json",
+                                       (const char*)reused.data, reused.len,
+                                       ka, &job->response_len);
+        return;
+    }
 
-    time_t t0 = time(NULL);
-    SeaHttpResponse resp;
+    SeaHttpResponse resp = {0};
     SeaError err = sea_http_post_json_auth(
-        s_proxy_cfg.real_api_url, body, auth_hdr, &arena, &resp);
-    time_t t1 = time(NULL);
-    i32 latency_ms = (i32)(difftime(t1, t0) * 1000);
+        s_proxy_cfg.real_api_url, body, auth_hdr, arena, &resp);
+    i32 latency_ms = (i32)((mono_us() - t0 + 500) / 1000);
+    if (cached == SEA_CACHE_LEADER)
+        sea_llm_cache_complete(s_cache, &key, resp.body,
+                               err == SEA_OK && resp.status_code == 200);
 
     if (err != SEA_OK) {
         SEA_LOG_ERROR("PROXY", "LLM request failed: %s", sea_error_str(err));
-        send_json_error(fd, 502, "LLM provider unreachable");
-
-        if (s_proxy_cfg.db) {
-            sea_db_sz_llm_log(s_proxy_cfg.db, "agent-zero",
-                s_proxy_cfg.real_provider ? s_proxy_cfg.real_provider : "unknown",
-                s_proxy_cfg.real_model ? s_proxy_cfg.real_model : "unknown",
-                0, 0, 0.0, latency_ms, "error", NULL);
-        }
-
-        sea_arena_destroy(&arena);
+        job->response = build_json_error(502, "LLM provider unreachable", ka, &job->response_len);
+        log_usage(0, 0, latency_ms, "error");
         return;
     }
 
     /* Log usage — try to extract token counts from response */
     i32 tokens_in = 0, tokens_out = 0;
     SeaJsonValue root;
-    if (sea_json_parse(resp.body, &arena, &root) == SEA_OK) {
+    if (sea_json_parse(resp.body, arena, &root) == SEA_OK) {
         const SeaJsonValue* usage = sea_json_get(&root, "usage");
         if (usage) {
             tokens_in  = (i32)sea_json_get_number(usage, "prompt_tokens", 0);
             tokens_out = (i32)sea_json_get_number(usage, "completion_tokens", 0);
         }
     }
-
-    if (s_proxy_cfg.db) {
-        sea_db_sz_llm_log(s_proxy_cfg.db, "agent-zero",
-            s_proxy_cfg.real_provider ? s_proxy_cfg.real_provider : "unknown",
-            s_proxy_cfg.real_model ? s_proxy_cfg.real_model : "unknown",
-            tokens_in, tokens_out, 0.0, latency_ms, "ok", NULL);
-    }
+    log_usage(tokens_in, tokens_out, latency_ms, "ok");
 
     SEA_LOG_INFO("PROXY", "LLM response: HTTP %d, %u bytes, %dms (in=%d, out=%d)",
                  resp.status_code, resp.body.len, latency_ms, tokens_in, tokens_out);
 
     /* Forward response back to Agent Zero */
-    send_response(fd, resp.status_code,
-                  resp.status_code == 200 ? "OK" : "Error",
-                  "application/json",
-                  (const char*)resp.body.data, (int)resp.body.len);
-
-    sea_arena_destroy(&arena);
+    job->response = build_response(resp.status_code, "application/json",
+                                   (const char*)resp.body.data, resp.body.len,
+                                   ka, &job->response_len);
 }
 
-/* ── Handle /health ────────────────────────────────────────── */
-
-static void handle_health(int fd) {
-    const char* body = "{\"status\":\"ok\",\"service\":\"seazero-proxy\"}";
-    send_json_ok(fd, body, (int)strlen(body));
-}
-
-/* ── Connection Handler ────────────────────────────────────── */
-
-static void handle_connection(int fd) {
-    /* Read request (headers + body) */
-    char buf[PROXY_MAX_HEADERS + PROXY_MAX_BODY];
-    int total = 0;
-    int n;
-
-    while (total < (int)sizeof(buf) - 1) {
-        n = (int)read(fd, buf + total, (size_t)(sizeof(buf) - 1 - (size_t)total));
-        if (n <= 0) break;
-        total += n;
-
-        /* Check if we have the full request (headers end with \r\n\r\n) */
-        buf[total] = '\0';
-        char* header_end = strstr(buf, "\r\n\r\n");
-        if (header_end) {
-            /* Check Content-Length to know if we have the full body */
-            char* cl = strcasestr(buf, "\nContent-Length: ");
-            if (cl) {
-                int content_len = atoi(cl + strlen("\nContent-Length: "));
-                int header_size = (int)(header_end + 4 - buf);
-                if (total >= header_size + content_len) break;
-            } else {
-                break; /* No Content-Length = no body expected */
-            }
-        }
+static void queue_chat_completions(u32 idx, const ProxyRequest* req) {
+    bool ka = req->keep_alive;
+    if (!req->body || req->body_len == 0) {
+        reply_error(idx, 400, "Empty request body", ka);
+        return;
     }
 
-    if (total <= 0) {
-        close(fd);
+    /* Validate token */
+    if (!validate_token(req)) {
+        reply_error(idx, 401, "Invalid authorization token", ka);
+        if (s_proxy_cfg.db) {
+            sea_db_sz_audit(s_proxy_cfg.db, "auth_failure", "proxy",
+                            "agent-zero", "Invalid internal token", "warn");
+        }
         return;
     }
-    buf[total] = '\0';
 
-    /* Parse request */
-    ProxyRequest req;
-    if (!parse_request(buf, total, &req)) {
-        send_json_error(fd, 400, "Malformed request");
-        close(fd);
+    ProxyJob* job = calloc(1, sizeof(ProxyJob));
+    char* body = job ? malloc(req->body_len) : NULL;
+    if (!body) {
+        free(job);
+        reply_error(idx, 503, "Proxy out of memory", false);
         return;
     }
+    memcpy(body, req->body, req->body_len);
+    job->body = body;
+    job->body_len = req->body_len;
+    job->conn = idx;
+    job->gen = s_conns[idx].gen;
+    job->keep_alive = ka;
+    s_conns[idx].busy = true;
+    s_conns[idx].job = job;
+
+    pthread_mutex_lock(&s_lock);
+    if (s_todo_tail) s_todo_tail->next = job;
+    else s_todo_head = job;
+    s_todo_tail = job;
+    pthread_cond_signal(&s_job_cond);
+    pthread_mutex_unlock(&s_lock);
+}
 
-    SEA_LOG_DEBUG("PROXY", "%s %s", req.method, req.path);
+/* ── Handle /health ────────────────────────────────────────── */
+
+static void handle_health(u32 idx, bool keep_alive) {
+    const char* body = "{\"status\":\"ok\",\"service\":\"seazero-proxy\"}";
+    u32 len;
+    char* resp = build_response(200, "application/json", body, (u32)strlen(body),
+                                keep_alive, &len);
+    conn_send(idx, resp, len, keep_alive);
+}
 
-    /* Route */
-    if (strcmp(req.method, "POST") == 0 &&
-        (strcmp(req.path, "/v1/chat/completions") == 0 ||
-         strcmp(req.path, "/chat/completions") == 0)) {
-        handle_chat_completions(fd, &req);
-    } else if (strcmp(req.method, "GET") == 0 &&
-               strcmp(req.path, "/health") == 0) {
-        handle_health(fd);
-    } else if (strcmp(req.method, "OPTIONS") == 0) {
+/* ── Routing ───────────────────────────────────────────────── */
+
+static void handle_request(u32 idx, const ProxyRequest* req) {
+    bool ka = req->keep_alive;
+    SEA_LOG_DEBUG("PROXY", "%.*s %.*s", (int)req->method_len, req->method,
+                  (int)req->path_len, req->path);
+
+    if (span_eq(req->method, req->method_len, "POST") &&
+        (span_eq(req->path, req->path_len, "/v1/chat/completions") ||
+         span_eq(req->path, req->path_len, "/chat/completions"))) {
+        queue_chat_completions(idx, req);
+    } else if (span_eq(req->method, req->method_len, "GET") &&
+               span_eq(req->path, req->path_len, "/health")) {
+        handle_health(idx, ka);
+    } else if (span_eq(req->method, req->method_len, "OPTIONS")) {
         /* CORS preflight */
-        send_response(fd, 204, "No Content", "text/plain", NULL, 0);
+        u32 len;
+        char* resp = build_response(204, "text/plain", NULL, 0, ka, &len);
+        conn_send(idx, resp, len, ka);
     } else {
-        send_json_error(fd, 404, "Not found");
+        reply_error(idx, 404, "Not found", ka);
     }
+}
 
-    close(fd);
+/* Parse and answer buffered requests, one at a time. */
+static void conn_process(u32 idx) {
+    ProxyConn* c = &s_conns[idx];
+    while (c->fd >= 0 && !c->busy && c->out_len == 0 && c->in_len > 0) {
+        ProxyRequest req;
+        if (!parse_request(c->in, c->in_len, &req)) return;
+        if (req.error) {
+            reply_error(idx, req.error, "Malformed request", false);
+            return;
+        }
+        handle_request(idx, &req);
+        if (c->fd < 0) return;
+        memmove(c->in, c->in + req.total, c->in_len - req.total);
+        c->in_len -= req.total;
+    }
 }
 
-/* ── Server Thread ─────────────────────────────────────────── */
+static void conn_read(u32 idx) {
+    ProxyConn* c = &s_conns[idx];
+    for (;;) {
+        if (c->in_cap - c->in_len < PROXY_READ_CHUNK) {
+            u32 cap = c->in_cap ? c->in_cap * 2 : PROXY_READ_CHUNK * 2;
+            if (cap > SEA_PROXY_MAX_HEADERS + SEA_PROXY_MAX_BODY + PROXY_READ_CHUNK * 2) {
+                /* A full buffer behind an upstream call is a client that
+                 * will not wait; otherwise the parser rejects it */
+                if (c->busy) { conn_close(idx); return; }
+                break;
+            }
+            char* in = realloc(c->in, cap);
+            if (!in) { conn_close(idx); return; }
+            c->in = in;
+            c->in_cap = cap;
+        }
+        ssize_t n = recv(c->fd, c->in + c->in_len, c->in_cap - c->in_len, 0);
+        if (n > 0) { c->in_len += (u32)n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n < 0) { conn_close(idx); return; }
+
+        /* Peer finished sending: answer what it sent, then close */
+        c->close_after = true;
+        conn_process(idx);
+        if (c->fd < 0) return;
+        if (!c->busy && c->out_len == 0) { conn_close(idx); return; }
+        struct epoll_event ev = { .events = 0, .data.u32 = EV_CONN(idx) };
+        epoll_ctl(s_epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+        c->want_write = false;
+        return;
+    }
+    c->last_active = mono_ms();
+    conn_process(idx);
+}
 
-static void* proxy_thread(void* arg) {
+static void accept_all(void) {
+    for (;;) {
+        int fd = accept4(s_listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK && s_proxy_running)
+                SEA_LOG_ERROR("PROXY", "accept() failed: %s", strerror(errno));
+            return;
+        }
+
+        u32 idx = 0;
+        while (idx < SEA_PROXY_CONNS && s_conns[idx].fd >= 0) idx++;
+        if (idx == SEA_PROXY_CONNS) {
+            SEA_LOG_WARN("PROXY", "Connection table full; dropping client");
+            close(fd);
+            continue;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        ProxyConn* c = &s_conns[idx];
+        c->fd = fd;
+        c->last_active = mono_ms();
+        struct epoll_event ev = { .events = EPOLLIN | EPOLLRDHUP, .data.u32 = EV_CONN(idx) };
+        if (epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) conn_close(idx);
+    }
+}
+
+/* ── Upstream Workers ──────────────────────────────────────── */
+
+static void* worker_main(void* arg) {
     (void)arg;
+    /* Starts small; a large upstream reply grows it, and the pages
+     * above SEA_PROXY_WORKER_ARENA go back to the kernel on reset */
+    SeaArenaConfig acfg = {
+        .size   = SEA_PROXY_WORKER_ARENA / 4,
+        .max    = SEA_PROXY_WORKER_ARENA_MAX,
+        .retain = SEA_PROXY_WORKER_ARENA,
+        .flags  = SEA_ARENA_GROW,
+        .name   = "proxy.worker",
+    };
+    SeaArena arena;
+    if (sea_arena_create_ex(&arena, &acfg) != SEA_OK) return NULL;
+
+    for (;;) {
+        pthread_mutex_lock(&s_lock);
+        while (!s_todo_head && !atomic_load(&s_stop))
+            pthread_cond_wait(&s_job_cond, &s_lock);
+        ProxyJob* job = s_todo_head;
+        if (!job) { pthread_mutex_unlock(&s_lock); break; }   /* Stopping */
+        s_todo_head = job->next;
+        if (!s_todo_head) s_todo_tail = NULL;
+        pthread_mutex_unlock(&s_lock);
+
+        run_chat_completions(job, &arena);
+
+        pthread_mutex_lock(&s_lock);
+        job->next = s_done;
+        s_done = job;
+        pthread_mutex_unlock(&s_lock);
+        wake_loop();
+    }
+    sea_arena_destroy(&arena);
+    return NULL;
+}
 
-    SEA_LOG_INFO("PROXY", "LLM proxy listening on port %u", s_proxy_cfg.port);
+static void free_job(ProxyJob* job) {
+    free(job->body);
+    free(job->response);
+    free(job);
+}
 
-    while (s_proxy_running) {
-        struct sockaddr_in client_addr;
-        socklen_t client_len = sizeof(client_addr);
+static void free_frames(ProxyFrame* f) {
+    while (f) { ProxyFrame* n = f->next; free(f); f = n; }
+}
 
-        int client_fd = accept(s_listen_fd,
-                               (struct sockaddr*)&client_addr, &client_len);
-        if (client_fd < 0) {
-            if (s_proxy_running && errno != EINTR) {
-                SEA_LOG_ERROR("PROXY", "accept() failed: %s", strerror(errno));
+/* Hand streamed pieces and finished upstream calls back to their
+ * connections. Frames go first: a job's frames were queued before it
+ * finished, so its final chunk stays last. */
+static void collect_done(void) {
+    pthread_mutex_lock(&s_lock);
+    ProxyJob* job = s_done;
+    ProxyFrame* frame = s_frame_head;
+    s_done = NULL;
+    s_frame_head = s_frame_tail = NULL;
+    pthread_mutex_unlock(&s_lock);
+
+    for (ProxyFrame* f = frame; f; f = f->next) {
+        ProxyConn* c = &s_conns[f->conn];
+        if (c->fd >= 0 && c->gen == f->gen && c->busy) {
+            c->last_active = mono_ms();
+            conn_append(f->conn, f->data, f->len);
+        }
+    }
+    free_frames(frame);
+
+    while (job) {
+        ProxyJob* next = job->next;
+        ProxyConn* c = &s_conns[job->conn];
+        if (c->fd >= 0 && c->gen == job->gen && c->busy) {
+            c->busy = false;
+            c->job = NULL;
+            c->last_active = mono_ms();
+            if (job->head_sent) {
+                if (!job->keep_alive) c->close_after = true;
+                if (job->response) conn_append(job->conn, job->response, job->response_len);
+                else if (c->out_len == 0) conn_close(job->conn);
+            } else {
+                char* resp = job->response;
+                job->response = NULL;
+                conn_send(job->conn, resp, job->response_len, job->keep_alive);
             }
-            continue;
+            if (c->fd >= 0) conn_process(job->conn);   /* Pipelined requests */
         }
+        free_job(job);
+        job = next;
+    }
+}
 
-        /* Set read timeout on client socket */
-        struct timeval tv = { .tv_sec = 30, .tv_usec = 0 };
-        setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+/* ── Server Thread ─────────────────────────────────────────── */
 
-        handle_connection(client_fd);
+static void* proxy_thread(void* arg) {
+    (void)arg;
+    struct epoll_event events[64];
+    u64 next_sweep = mono_ms() + 1000;
+
+    SEA_LOG_INFO("PROXY", "LLM proxy listening on port %u (%u workers)",
+                 s_proxy_cfg.port, s_worker_count);
+
+    while (!atomic_load(&s_stop)) {
+        int n = epoll_wait(s_epoll_fd, events, 64, 1000);
+        for (int i = 0; i < n; i++) {
+            u32 tag = events[i].data.u32;
+            if (tag == EV_LISTEN) { accept_all(); continue; }
+            if (tag == EV_WAKE) {
+                u64 v;
+                ssize_t r = read(s_wake_fd, &v, sizeof(v));
+                (void)r;
+                collect_done();
+                continue;
+            }
+            u32 idx = tag - 2;
+            if (s_conns[idx].fd < 0) continue;
+            u32 ev = events[i].events;
+            if (ev & EPOLLOUT) {
+                conn_write(idx);
+                conn_process(idx);
+            }
+            if (s_conns[idx].fd >= 0 && (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+                conn_read(idx);
+        }
+
+        /* Close idle keep-alive connections */
+        u64 now = mono_ms();
+        if (now >= next_sweep) {
+            for (u32 i = 0; i < SEA_PROXY_CONNS; i++) {
+                ProxyConn* c = &s_conns[i];
+                if (c->fd >= 0 && !c->busy && c->out_len == 0 &&
+                    now - c->last_active > SEA_PROXY_IDLE_MS)
+                    conn_close(i);
+            }
+            next_sweep = now + 1000;
+        }
     }
 
     SEA_LOG_INFO("PROXY", "Proxy thread exiting");
@@ -358,6 +994,32 @@ static void* proxy_thread(void* arg) {
 
 /* ── Public API ────────────────────────────────────────────── */
 
+static void close_fds(void) {
+    if (s_listen_fd >= 0) { close(s_listen_fd); s_listen_fd = -1; }
+    if (s_epoll_fd >= 0)  { close(s_epoll_fd);  s_epoll_fd = -1; }
+    if (s_wake_fd >= 0)   { close(s_wake_fd);   s_wake_fd = -1; }
+}
+
+/* Stop and join the workers, dropping any queued or finished jobs. */
+static void stop_workers(u32 started) {
+    pthread_mutex_lock(&s_lock);
+    atomic_store(&s_stop, true);
+    pthread_cond_broadcast(&s_job_cond);
+    pthread_cond_broadcast(&s_window_cond);
+    pthread_mutex_unlock(&s_lock);
+    for (u32 i = 0; i < started; i++) pthread_join(s_workers[i], NULL);
+    free(s_workers);
+    s_workers = NULL;
+
+    ProxyJob* lists[2] = { s_todo_head, s_done };
+    for (u32 l = 0; l < 2; l++) {
+        for (ProxyJob* j = lists[l]; j; ) { ProxyJob* n = j->next; free_job(j); j = n; }
+    }
+    s_todo_head = s_todo_tail = s_done = NULL;
+    free_frames(s_frame_head);
+    s_frame_head = s_frame_tail = NULL;
+}
+
 int sea_proxy_start(const SeaProxyConfig* cfg) {
     if (!cfg || !cfg->enabled) return -1;
     if (s_proxy_running) return 0; /* Already running */
@@ -370,8 +1032,14 @@ int sea_proxy_start(const SeaProxyConfig* cfg) {
         return -1;
     }
 
+    for (u32 i = 0; i < SEA_PROXY_CONNS; i++) {
+        memset(&s_conns[i], 0, sizeof(s_conns[i]));
+        s_conns[i].fd = -1;
+    }
+    atomic_store(&s_stop, false);
+
     /* Create socket */
-    s_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    s_listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (s_listen_fd < 0) {
         SEA_LOG_ERROR("PROXY", "socket() failed: %s", strerror(errno));
         return -1;
@@ -391,25 +1059,59 @@ int sea_proxy_start(const SeaProxyConfig* cfg) {
     if (bind(s_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
         SEA_LOG_ERROR("PROXY", "bind() port %u failed: %s",
                       s_proxy_cfg.port, strerror(errno));
-        close(s_listen_fd);
-        s_listen_fd = -1;
+        close_fds();
         return -1;
     }
 
     if (listen(s_listen_fd, PROXY_BACKLOG) < 0) {
         SEA_LOG_ERROR("PROXY", "listen() failed: %s", strerror(errno));
-        close(s_listen_fd);
-        s_listen_fd = -1;
+        close_fds();
         return -1;
     }
 
-    /* Start background thread */
+    s_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    s_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event lev = { .events = EPOLLIN, .data.u32 = EV_LISTEN };
+    struct epoll_event wev = { .events = EPOLLIN, .data.u32 = EV_WAKE };
+    if (s_epoll_fd < 0 || s_wake_fd < 0 ||
+        epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, s_listen_fd, &lev) != 0 ||
+        epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, s_wake_fd, &wev) != 0) {
+        SEA_LOG_ERROR("PROXY", "epoll setup failed: %s", strerror(errno));
+        close_fds();
+        return -1;
+    }
+
+    s_budget = sea_budget_create(s_proxy_cfg.db, s_proxy_cfg.daily_token_budget);
+    if (!s_budget) {
+        SEA_LOG_ERROR("PROXY", "Cannot allocate budget ledger");
+        close_fds();
+        return -1;
+    }
+    SeaLlmCacheConfig cache_cfg = {
+        .ttl_sec   = s_proxy_cfg.cache_ttl_sec,
+        .max_bytes = (u64)s_proxy_cfg.cache_max_mb * 1024 * 1024,
+    };
+    s_cache = sea_llm_cache_create(s_proxy_cfg.db, &cache_cfg);
+
+    /* Start upstream workers, then the event loop */
+    s_worker_count = s_proxy_cfg.workers ? s_proxy_cfg.workers : SEA_PROXY_WORKERS;
+    s_workers = calloc(s_worker_count, sizeof(pthread_t));
+    u32 started = 0;
+    while (s_workers && started < s_worker_count &&
+           pthread_create(&s_workers[started], NULL, worker_main, NULL) == 0) {
+        started++;
+    }
     s_proxy_running = true;
-    if (pthread_create(&s_proxy_tid, NULL, proxy_thread, NULL) != 0) {
+    if (started < s_worker_count ||
+        pthread_create(&s_proxy_tid, NULL, proxy_thread, NULL) != 0) {
         SEA_LOG_ERROR("PROXY", "pthread_create() failed: %s", strerror(errno));
         s_proxy_running = false;
-        close(s_listen_fd);
-        s_listen_fd = -1;
+        stop_workers(started);
+        sea_budget_destroy(s_budget);
+        s_budget = NULL;
+        sea_llm_cache_destroy(s_cache);
+        s_cache = NULL;
+        close_fds();
         return -1;
     }
 
@@ -429,13 +1131,18 @@ void sea_proxy_stop(void) {
 
     s_proxy_running = false;
 
-    /* Close listen socket to unblock accept() */
-    if (s_listen_fd >= 0) {
-        close(s_listen_fd);
-        s_listen_fd = -1;
-    }
-
+    /* Stop the loop first so no new jobs are queued */
+    atomic_store(&s_stop, true);
+    wake_loop();
     pthread_join(s_proxy_tid, NULL);
+    stop_workers(s_worker_count);
+    sea_budget_destroy(s_budget);               /* Writes queued usage rows */
+    s_budget = NULL;
+    sea_llm_cache_destroy(s_cache);
+    s_cache = NULL;
+
+    for (u32 i = 0; i < SEA_PROXY_CONNS; i++) conn_close(i);
+    close_fds();
 
     SEA_LOG_INFO("PROXY", "LLM proxy stopped");
 
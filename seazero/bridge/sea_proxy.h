@@ -6,10 +6,12 @@
  * talking to OpenAI; SeaClaw validates, budgets, and forwards.
  *
  * Design:
- *   - POSIX sockets, single-threaded accept loop in a background thread
+ *   - One epoll thread accepts and parses; connections are kept alive
+ *   - Upstream calls run on a worker pool, each with a reusable arena
  *   - Validates internal token on every request
  *   - Checks daily token budget before forwarding
  *   - Forwards to real LLM using sea_http (existing, no new deps)
+ *   - "stream":true requests are relayed chunk by chunk as SSE
  *   - Logs all usage to seazero_llm_usage table
  *   - No new dependencies: uses sys/socket.h + pthread (already linked)
  */
@@ -21,6 +23,18 @@
 #include "seaclaw/sea_arena.h"
 #include "seaclaw/sea_db.h"
 
+/* ── Limits ────────────────────────────────────────────────── */
+
+#define SEA_PROXY_CONNS         64             /* Open client connections  */
+#define SEA_PROXY_WORKERS       4              /* Concurrent upstream calls */
+#define SEA_PROXY_IDLE_MS       30000          /* Keep-alive idle timeout  */
+#define SEA_PROXY_MAX_BODY      (256 * 1024)   /* Max request body         */
+#define SEA_PROXY_MAX_HEADERS   (8 * 1024)     /* Max request headers      */
+#define SEA_PROXY_WORKER_ARENA  (512 * 1024)   /* Per-worker, kept across calls */
+#define SEA_PROXY_WORKER_ARENA_MAX (32 * 1024 * 1024) /* Growth for large replies */
+#define SEA_PROXY_STREAM_WINDOW (256 * 1024)   /* Unsent stream bytes before
+                                                  upstream reads pause      */
+
 /* ── Proxy Configuration ───────────────────────────────────── */
 
 typedef struct {
@@ -32,6 +46,9 @@ typedef struct {
     const char* real_model;         /* Model name for logging              */
     i64         daily_token_budget; /* Max tokens/day for agents (0=unlimited) */
     SeaDb*      db;                 /* Database handle for usage logging   */
+    u32         workers;            /* Upstream workers (0 = SEA_PROXY_WORKERS) */
+    u32         cache_ttl_sec;      /* Response cache TTL (0 = SEA_LLM_CACHE_TTL_SEC) */
+    u32         cache_max_mb;       /* Response cache size (0 = SEA_LLM_CACHE_MAX_BYTES) */
     bool        enabled;            /* false = proxy not started           */
 } SeaProxyConfig;
 
@@ -2,7 +2,9 @@
  * sea_a2a.c — Agent-to-Agent Communication Protocol
  *
  * HTTP JSON-RPC based delegation to remote agents.
- * All results Shield-validated before returning.
+ * All results Shield-validated before returning. Multi-peer calls
+ * run concurrently; every answer is timed on the monotonic clock
+ * into a per-peer log-linear histogram used to rank peers.
  */
 
 #include "seaclaw/sea_a2a.h"
@@ -18,6 +20,13 @@ extern SeaDb* s_db;
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+
+static u64 mono_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000 + (u64)ts.tv_nsec / 1000;
+}
 
 /* ── Simple UUID-like ID generator ───────────────────────── */
 
@@ -77,86 +86,160 @@ static const char* build_delegate_json(const SeaA2aRequest* req,
     return buf;
 }
 
-/* ── Delegate a task to a remote agent ───────────────────── */
+/* ── Peer latency histograms ─────────────────────────────── */
+
+typedef struct {
+    char endpoint[256];
+    u64  samples;
+    u64  failures;
+    u32  buckets[SEA_A2A_HIST_BUCKETS];
+} PeerHist;
+
+static PeerHist        s_hist[SEA_A2A_MAX_TRACKED];
+static u32             s_hist_count = 0;
+static pthread_mutex_t s_hist_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* 0-3µs exact, then four buckets per power of two */
+static u32 hist_bucket(u64 us) {
+    if (us < 4) return (u32)us;
+    u32 msb = 63 - (u32)__builtin_clzll(us);
+    u32 b = (msb - 1) * 4 + (u32)((us >> (msb - 2)) & 3);
+    return b < SEA_A2A_HIST_BUCKETS ? b : SEA_A2A_HIST_BUCKETS - 1;
+}
 
-SeaA2aResult sea_a2a_delegate(const SeaA2aPeer* peer,
-                               const SeaA2aRequest* req,
-                               SeaArena* arena) {
-    SeaA2aResult result = {
-        .task_id = req->task_id,
-        .success = false,
-        .output = NULL,
-        .latency_ms = 0,
-        .agent_name = peer->name,
-        .verified = false,
-        .error = NULL,
-    };
+static u64 bucket_upper(u32 b) {
+    if (b < 4) return b;
+    u32 msb = b / 4 + 1;
+    return ((u64)(4 + b % 4 + 1) << (msb - 2)) - 1;
+}
 
-    if (!peer || !peer->endpoint || !req) {
-        result.error = "Invalid peer or request";
-        return result;
+/* Caller holds s_hist_lock. create: claim a slot (the least used one
+ * when the table is full). */
+static PeerHist* hist_find(const char* endpoint, bool create) {
+    for (u32 i = 0; i < s_hist_count; i++)
+        if (strcmp(s_hist[i].endpoint, endpoint) == 0) return &s_hist[i];
+    if (!create) return NULL;
+
+    PeerHist* h;
+    if (s_hist_count < SEA_A2A_MAX_TRACKED) {
+        h = &s_hist[s_hist_count++];
+    } else {
+        h = &s_hist[0];
+        for (u32 i = 1; i < SEA_A2A_MAX_TRACKED; i++)
+            if (s_hist[i].samples + s_hist[i].failures < h->samples + h->failures) h = &s_hist[i];
     }
+    memset(h, 0, sizeof(*h));
+    snprintf(h->endpoint, sizeof(h->endpoint), "%s", endpoint);
+    return h;
+}
 
-    /* Generate task ID if not provided */
-    char id_buf[64];
-    if (!req->task_id) {
-        gen_task_id(id_buf, sizeof(id_buf));
-        result.task_id = (const char*)sea_arena_push_bytes(arena, id_buf,
-                                                            (u64)strlen(id_buf));
-    }
+static void hist_record(const char* endpoint, bool ok, u64 latency_us) {
+    if (!endpoint) return;
+    pthread_mutex_lock(&s_hist_lock);
+    PeerHist* h = hist_find(endpoint, true);
+    if (ok) { h->samples++; h->buckets[hist_bucket(latency_us)]++; }
+    else h->failures++;
+    pthread_mutex_unlock(&s_hist_lock);
+}
 
-    SEA_LOG_INFO("A2A", "Delegating to %s: %s",
-                 peer->name ? peer->name : peer->endpoint,
-                 req->task_desc ? req->task_desc : "(no desc)");
+static u64 hist_percentile(const PeerHist* h, double q) {
+    if (h->samples == 0) return 0;
+    u64 rank = (u64)(q * (double)(h->samples - 1)) + 1, seen = 0;
+    for (u32 b = 0; b < SEA_A2A_HIST_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) return bucket_upper(b);
+    }
+    return bucket_upper(SEA_A2A_HIST_BUCKETS - 1);
+}
 
-    /* Build JSON payload */
-    const char* json = build_delegate_json(req, arena);
-    if (!json) {
-        result.error = "Failed to build request JSON";
-        return result;
+bool sea_a2a_peer_stats(const SeaA2aPeer* peer, SeaA2aPeerStats* out) {
+    if (!peer || !peer->endpoint || !out) return false;
+    pthread_mutex_lock(&s_hist_lock);
+    const PeerHist* h = hist_find(peer->endpoint, false);
+    if (h) {
+        out->samples  = h->samples;
+        out->failures = h->failures;
+        out->p50_us   = hist_percentile(h, 0.50);
+        out->p90_us   = hist_percentile(h, 0.90);
+        out->p99_us   = hist_percentile(h, 0.99);
     }
+    pthread_mutex_unlock(&s_hist_lock);
+    return h != NULL;
+}
 
-    /* Build auth header if peer has API key */
-    const char* auth_hdr = NULL;
-    if (peer->api_key) {
-        u32 klen = (u32)strlen(peer->api_key);
-        char* hdr = (char*)sea_arena_alloc(arena, 24 + klen + 1, 1);
-        if (hdr) {
-            snprintf(hdr, 24 + klen + 1, "Authorization: Bearer %s", peer->api_key);
-            auth_hdr = hdr;
-        }
+/* Lower is better; unmeasured peers score 0 so they are tried */
+static double peer_score(const SeaA2aPeer* peer) {
+    SeaA2aPeerStats st;
+    if (!sea_a2a_peer_stats(peer, &st)) return 0.0;
+    u64 total = st.samples + st.failures;
+    if (st.samples == 0) return 1e18;
+    double fail_rate = (double)st.failures / (double)total;
+    return (double)st.p90_us * (1.0 + 4.0 * fail_rate);
+}
+
+void sea_a2a_rank_peers(const SeaA2aPeer* peers, u32 count, u32* order) {
+    if (!peers || !order) return;
+    double score[count > 0 ? count : 1];
+    for (u32 i = 0; i < count; i++) { order[i] = i; score[i] = peer_score(&peers[i]); }
+    /* Insertion sort: stable, and peer lists are short */
+    for (u32 i = 1; i < count; i++) {
+        u32 o = order[i];
+        u32 j = i;
+        while (j > 0 && score[order[j - 1]] > score[o]) { order[j] = order[j - 1]; j--; }
+        order[j] = o;
     }
+}
 
-    /* Send HTTP POST */
-    u64 t0 = (u64)time(NULL) * 1000; /* rough ms */
-    SeaSlice body = { .data = (const u8*)json, .len = (u32)strlen(json) };
-    SeaHttpResponse resp;
-    SeaError err = sea_http_post_json_auth(peer->endpoint, body, auth_hdr,
-                                            arena, &resp);
+void sea_a2a_stats_reset(void) {
+    pthread_mutex_lock(&s_hist_lock);
+    memset(s_hist, 0, sizeof(s_hist));
+    s_hist_count = 0;
+    pthread_mutex_unlock(&s_hist_lock);
+}
 
-    u64 t1 = (u64)time(NULL) * 1000;
-    result.latency_ms = (u32)(t1 - t0);
+/* ── Response handling ───────────────────────────────────── */
 
-    if (err != SEA_OK) {
-        result.error = "HTTP request to peer failed";
-        SEA_LOG_ERROR("A2A", "Delegation failed: HTTP error");
-        return result;
+static const char* peer_label(const SeaA2aPeer* peer) {
+    return peer->name ? peer->name : peer->endpoint;
+}
+
+static char* arena_copy(SeaArena* arena, SeaSlice s) {
+    char* out = (char*)sea_arena_alloc(arena, (u64)s.len + 1, 1);
+    if (!out) return NULL;
+    if (s.len) memcpy(out, s.data, s.len);
+    out[s.len] = '\0';
+    return out;
+}
+
+/* Fill result from a finished request: JSON-RPC result or error,
+ * Shield verification of the output. */
+static void parse_response(const SeaA2aPeer* peer, const SeaHttpRequest* http,
+                           SeaArena* arena, SeaA2aResult* result) {
+    result->latency_us = http->elapsed_us;
+    result->latency_ms = (u32)(http->elapsed_us / 1000);
+
+    if (http->err != SEA_OK) {
+        result->error = http->err == SEA_ERR_TIMEOUT ? "Peer timed out"
+                                                     : "HTTP request to peer failed";
+        SEA_LOG_ERROR("A2A", "Delegation to %s failed: %s", peer_label(peer),
+                      sea_error_str(http->err));
+        return;
     }
 
-    if (resp.status_code != 200) {
+    if (http->resp.status_code != 200) {
         char* msg = (char*)sea_arena_alloc(arena, 64, 1);
         if (msg) {
-            snprintf(msg, 64, "Peer returned HTTP %d", resp.status_code);
-            result.error = msg;
+            snprintf(msg, 64, "Peer returned HTTP %d", http->resp.status_code);
+            result->error = msg;
         }
-        return result;
+        return;
     }
 
     /* Parse JSON-RPC response */
     SeaJsonValue root;
-    if (sea_json_parse(resp.body, arena, &root) != SEA_OK) {
-        result.error = "Failed to parse peer response JSON";
-        return result;
+    if (sea_json_parse(http->resp.body, arena, &root) != SEA_OK) {
+        result->error = "Failed to parse peer response JSON";
+        return;
     }
 
     /* Extract result */
@@ -164,74 +247,238 @@ SeaA2aResult sea_a2a_delegate(const SeaA2aPeer* peer,
     if (res) {
         SeaSlice output = sea_json_get_string(res, "output");
         if (output.len > 0) {
-            char* out = (char*)sea_arena_alloc(arena, output.len + 1, 1);
-            if (out) {
-                memcpy(out, output.data, output.len);
-                out[output.len] = '\0';
-                result.output = out;
-            }
+            SeaSlice text = sea_json_unescape(output, arena);
+            if (text.data) result->output = (const char*)text.data;
         }
 
         /* Check success flag */
         const SeaJsonValue* ok = sea_json_get(res, "success");
         if (ok && ok->type == SEA_JSON_BOOL) {
-            result.success = ok->boolean;
+            result->success = ok->boolean;
         } else {
-            result.success = (result.output != NULL);
+            result->success = (result->output != NULL);
         }
     }
 
     /* Check for JSON-RPC error */
     const SeaJsonValue* err_obj = sea_json_get(&root, "error");
     if (err_obj) {
-        SeaSlice err_msg = sea_json_get_string(err_obj, "message");
+        SeaSlice err_msg = sea_json_unescape(sea_json_get_string(err_obj, "message"), arena);
         if (err_msg.len > 0) {
-            char* emsg = (char*)sea_arena_alloc(arena, err_msg.len + 1, 1);
-            if (emsg) {
-                memcpy(emsg, err_msg.data, err_msg.len);
-                emsg[err_msg.len] = '\0';
-                result.error = emsg;
-                result.success = false;
-            }
+            result->error = (const char*)err_msg.data;
+            result->success = false;
         }
     }
 
     /* Shield-verify the output */
-    if (result.output) {
-        SeaSlice out_slice = { .data = (const u8*)result.output,
-                               .len = (u32)strlen(result.output) };
+    if (result->output) {
+        SeaSlice out_slice = { .data = (const u8*)result->output,
+                               .len = (u32)strlen(result->output) };
         if (sea_shield_detect_injection(out_slice)) {
             SEA_LOG_WARN("A2A", "Shield REJECTED output from %s (injection detected)",
                          peer->name ? peer->name : "unknown");
-            result.verified = false;
-            result.output = "[Shield rejected: injection detected in agent output]";
+            result->verified = false;
+            result->output = "[Shield rejected: injection detected in agent output]";
         } else {
-            result.verified = true;
+            result->verified = true;
         }
     }
+}
 
-    /* Audit: log A2A delegation */
+static void audit(const SeaA2aPeer* peer, const SeaA2aRequest* req, const SeaA2aResult* result) {
     if (s_db) {
-        char audit[512];
-        snprintf(audit, sizeof(audit), "peer=%s task=%s success=%s latency=%ums verified=%s",
-                 peer->name ? peer->name : peer->endpoint,
+        char audit_buf[512];
+        snprintf(audit_buf, sizeof(audit_buf),
+                 "peer=%s task=%s success=%s latency=%lluus verified=%s",
+                 peer_label(peer),
                  req->task_desc ? req->task_desc : "(none)",
-                 result.success ? "true" : "false",
-                 result.latency_ms,
-                 result.verified ? "true" : "false");
+                 result->success ? "true" : "false",
+                 (unsigned long long)result->latency_us,
+                 result->verified ? "true" : "false");
         sea_db_log_event(s_db, "a2a_delegate",
-                         peer->name ? peer->name : "unknown", audit);
+                         peer->name ? peer->name : "unknown", audit_buf);
+    }
+
+    SEA_LOG_INFO("A2A", "Delegation %s: %s via %s (%.1fms, verified=%s)",
+                 result->success ? "OK" : "FAILED",
+                 result->task_id ? result->task_id : "?", peer_label(peer),
+                 (double)result->latency_us / 1000.0,
+                 result->verified ? "yes" : "no");
+}
+
+/* Quorum answers agree when equal apart from surrounding whitespace */
+static bool same_answer(const char* a, const char* b) {
+    while (*a == ' ' || *a == '\n' || *a == '\t' || *a == '\r') a++;
+    while (*b == ' ' || *b == '\n' || *b == '\t' || *b == '\r') b++;
+    size_t la = strlen(a), lb = strlen(b);
+    while (la > 0 && (a[la - 1] == ' ' || a[la - 1] == '\n' || a[la - 1] == '\t' || a[la - 1] == '\r')) la--;
+    while (lb > 0 && (b[lb - 1] == ' ' || b[lb - 1] == '\n' || b[lb - 1] == '\t' || b[lb - 1] == '\r')) lb--;
+    return la == lb && memcmp(a, b, la) == 0;
+}
+
+/* ── Multi-peer delegation ───────────────────────────────── */
+
+typedef struct {
+    const SeaA2aPeer*    peers;
+    const u32*           order;       /* Slot → index into peers */
+    u32                  n;           /* Slots contacted         */
+    const SeaA2aRequest* req;
+    const SeaA2aPolicy*  policy;
+    SeaArena*            arena;
+    SeaA2aResult*        results;     /* Per slot                */
+    u32                  finished;
+    u32                  failed;
+    u32                  best_votes;
+    i32                  winner;      /* Slot, -1 = none yet     */
+} Delegation;
+
+static bool good(const SeaA2aResult* r) {
+    return r->success && r->verified && r->output;
+}
+
+static bool on_peer_done(SeaHttpRequest* http, u32 slot, void* arg) {
+    Delegation* d = (Delegation*)arg;
+    const SeaA2aPeer* peer = &d->peers[d->order[slot]];
+    SeaA2aResult* r = &d->results[slot];
+
+    parse_response(peer, http, d->arena, r);
+    hist_record(peer->endpoint, good(r), r->latency_us);
+    audit(peer, d->req, r);
+    d->finished++;
+
+    if (!good(r)) {
+        d->failed++;
+    } else if (d->policy->mode == SEA_A2A_FIRST_SUCCESS) {
+        r->votes = 1;
+        d->winner = (i32)slot;
+        return false;
+    } else {
+        u32 votes = 0;
+        for (u32 s = 0; s < d->n; s++)
+            if (good(&d->results[s]) && same_answer(d->results[s].output, r->output)) votes++;
+        r->votes = votes;
+        if (votes > d->best_votes) d->best_votes = votes;
+        if (votes >= d->policy->quorum) { d->winner = (i32)slot; return false; }
+    }
+
+    /* Quorum out of reach: stop waiting */
+    u32 need = d->policy->mode == SEA_A2A_QUORUM ? d->policy->quorum : 1;
+    return d->best_votes + (d->n - d->finished) >= need;
+}
+
+SeaA2aResult sea_a2a_delegate_multi(const SeaA2aPeer* peers, u32 count,
+                                    const SeaA2aRequest* req,
+                                    const SeaA2aPolicy* policy,
+                                    SeaArena* arena, SeaA2aResult* per_peer) {
+    SeaA2aResult result = { .task_id = req ? req->task_id : NULL, .success = false };
+    SeaA2aPolicy first = { .mode = SEA_A2A_FIRST_SUCCESS };
+    if (!policy) policy = &first;
+
+    if (!peers || count == 0 || !req || !arena) {
+        result.error = "Invalid peer or request";
+        return result;
+    }
+
+    /* Generate task ID if not provided */
+    SeaA2aRequest r = *req;
+    if (!r.task_id) {
+        char id_buf[64];
+        gen_task_id(id_buf, sizeof(id_buf));
+        r.task_id = arena_copy(arena, (SeaSlice){ .data = (const u8*)id_buf,
+                                                  .len = (u32)strlen(id_buf) });
+        result.task_id = r.task_id;
     }
 
-    SEA_LOG_INFO("A2A", "Delegation %s: %s (%ums, verified=%s)",
-                 result.success ? "OK" : "FAILED",
-                 result.task_id,
-                 result.latency_ms,
-                 result.verified ? "yes" : "no");
+    u32 n = policy->fanout && policy->fanout < count ? policy->fanout : count;
+    if (policy->mode == SEA_A2A_QUORUM && (policy->quorum == 0 || policy->quorum > n)) {
+        result.error = "Quorum larger than the peers asked";
+        return result;
+    }
 
+    u32* order = (u32*)sea_arena_alloc(arena, sizeof(u32) * count, 4);
+    SeaA2aResult* results = (SeaA2aResult*)sea_arena_alloc(arena, sizeof(SeaA2aResult) * n, 8);
+    SeaHttpRequest* http = (SeaHttpRequest*)sea_arena_alloc(arena, sizeof(SeaHttpRequest) * n, 8);
+    const char* json = build_delegate_json(&r, arena);
+    if (!order || !results || !http || !json) {
+        result.error = "Failed to build request JSON";
+        return result;
+    }
+    sea_a2a_rank_peers(peers, count, order);
+
+    SeaSlice body = { .data = (const u8*)json, .len = (u32)strlen(json) };
+    for (u32 s = 0; s < n; s++) {
+        const SeaA2aPeer* peer = &peers[order[s]];
+        results[s] = (SeaA2aResult){ .task_id = r.task_id, .agent_name = peer->name };
+
+        /* Auth header if peer has API key */
+        char* auth_hdr = NULL;
+        if (peer->api_key) {
+            u32 klen = (u32)strlen(peer->api_key);
+            auth_hdr = (char*)sea_arena_alloc(arena, 24 + klen + 1, 1);
+            if (auth_hdr) snprintf(auth_hdr, 24 + klen + 1, "Authorization: Bearer %s", peer->api_key);
+        }
+        http[s] = (SeaHttpRequest){ .url = peer->endpoint, .body = body, .header = auth_hdr,
+                                    .timeout_ms = r.timeout_ms > 0 ? r.timeout_ms : 30000 };
+        SEA_LOG_INFO("A2A", "Delegating to %s: %s", peer->endpoint ? peer_label(peer) : "(none)",
+                     r.task_desc ? r.task_desc : "(no desc)");
+    }
+
+    Delegation d = { .peers = peers, .order = order, .n = n, .req = &r, .policy = policy,
+                     .arena = arena, .results = results, .winner = -1 };
+    u64 t0 = mono_us();
+    if (sea_http_multi_until(http, n, arena, on_peer_done, &d) != SEA_OK) {
+        result.error = "Failed to start requests";
+        return result;
+    }
+    u64 elapsed = mono_us() - t0;
+
+    if (per_peer) {
+        for (u32 i = 0; i < count; i++)
+            per_peer[i] = (SeaA2aResult){ .task_id = r.task_id, .agent_name = peers[i].name,
+                                          .error = "Not asked" };
+    }
+    for (u32 s = 0; s < n; s++) {
+        if (!http[s].done && !results[s].error) results[s].error = "Cancelled";
+        if (per_peer) per_peer[order[s]] = results[s];
+    }
+
+    if (d.winner >= 0) {
+        result = results[d.winner];
+    } else if (n == 1) {
+        result = results[0];
+    } else {
+        char* msg = (char*)sea_arena_alloc(arena, 96, 1);
+        if (msg) {
+            if (policy->mode == SEA_A2A_QUORUM)
+                snprintf(msg, 96, "No quorum: best agreement %u of %u needed (%u failed)",
+                         d.best_votes, policy->quorum, d.failed);
+            else
+                snprintf(msg, 96, "All %u peers failed", n);
+        }
+        result.error = msg ? msg : "Delegation failed";
+        result.success = false;
+    }
+    /* The caller waited for the whole fan-out, not just the winner */
+    if (n > 1) {
+        result.latency_us = elapsed;
+        result.latency_ms = (u32)(elapsed / 1000);
+    }
     return result;
 }
 
+/* ── Delegate a task to a remote agent ───────────────────── */
+
+SeaA2aResult sea_a2a_delegate(const SeaA2aPeer* peer,
+                               const SeaA2aRequest* req,
+                               SeaArena* arena) {
+    if (!peer || !peer->endpoint || !req) {
+        return (SeaA2aResult){ .task_id = req ? req->task_id : NULL,
+                               .agent_name = peer ? peer->name : NULL,
+                               .error = "Invalid peer or request" };
+    }
+    return sea_a2a_delegate_multi(peer, 1, req, NULL, arena, NULL);
+}
+
 /* ── Heartbeat ───────────────────────────────────────────── */
 
 bool sea_a2a_heartbeat(const SeaA2aPeer* peer, SeaArena* arena) {
@@ -0,0 +1,571 @@
+/*
+ * sea_a2a_registry.c — A2A Peer Registry
+ *
+ * Peers live in a fixed table guarded by one mutex. A probe round
+ * snapshots the due peers, heartbeats them all at once through
+ * sea_http_multi with the lock released, then applies the results.
+ * Healthy peers are probed every interval; a failing peer's delay
+ * doubles per consecutive failure up to the backoff cap. Discovery is
+ * fetched at most once per TTL. Peers and the discovery timestamp are
+ * mirrored to the a2a_peers / a2a_discovery tables.
+ */
+
+#include "seaclaw/sea_a2a.h"
+#include "seaclaw/sea_http.h"
+#include "seaclaw/sea_json.h"
+#include "seaclaw/sea_log.h"
+
+#include <sqlite3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+/* ── Access internal DB handle ───────────────────────────── */
+
+struct SeaDb { sqlite3* handle; };
+
+/* ── Schema ──────────────────────────────────────────────── */
+
+static const char* SCHEMA_SQL =
+    "CREATE TABLE IF NOT EXISTS a2a_peers ("
+    "  endpoint       TEXT PRIMARY KEY,"
+    "  name           TEXT NOT NULL DEFAULT '',"
+    "  api_key        TEXT NOT NULL DEFAULT '',"
+    "  capabilities   TEXT NOT NULL DEFAULT '',"
+    "  healthy        INTEGER NOT NULL DEFAULT 0,"
+    "  fail_streak    INTEGER NOT NULL DEFAULT 0,"
+    "  last_seen      INTEGER NOT NULL DEFAULT 0,"
+    "  latency_us     INTEGER NOT NULL DEFAULT 0,"
+    "  probes         INTEGER NOT NULL DEFAULT 0,"
+    "  probe_failures INTEGER NOT NULL DEFAULT 0"
+    ");"
+    "CREATE TABLE IF NOT EXISTS a2a_discovery ("
+    "  url        TEXT PRIMARY KEY,"
+    "  fetched_at INTEGER NOT NULL"
+    ");";
+
+/* ── Registry ────────────────────────────────────────────── */
+
+#define REGISTRY_ARENA (1024 * 1024)
+
+struct SeaA2aRegistry {
+    SeaA2aRegistryConfig cfg;
+    char                 discovery_url[512];
+    SeaDb*               db;
+
+    pthread_mutex_t      lock;          /* Guards everything below     */
+    pthread_cond_t       wake;          /* Monotonic clock             */
+    SeaA2aRegistryPeer   peers[SEA_A2A_REGISTRY_MAX];
+    u32                  count;
+    u64                  fetched_at;    /* Epoch seconds; 0 = never    */
+    bool                 running;
+    bool                 has_thread;
+    pthread_t            thread;
+
+    pthread_mutex_t      io_lock;       /* One probe/refresh at a time */
+    SeaArena             arena;         /* Reset per round; io_lock    */
+};
+
+static u64 now_epoch(void) {
+    return (u64)time(NULL);
+}
+
+static u64 mono_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000 + (u64)ts.tv_nsec / 1000000;
+}
+
+/* Delay before the next probe: the interval while healthy, doubling
+ * for each consecutive failure up to the cap. */
+static u64 probe_delay(const SeaA2aRegistry* reg, u32 fail_streak) {
+    u64 delay = reg->cfg.interval_ms;
+    for (u32 i = 0; i < fail_streak && delay < reg->cfg.backoff_max_ms; i++) delay *= 2;
+    return delay < reg->cfg.backoff_max_ms ? delay : reg->cfg.backoff_max_ms;
+}
+
+/* Caller holds reg->lock. */
+static SeaA2aRegistryPeer* find_peer(SeaA2aRegistry* reg, const char* endpoint) {
+    for (u32 i = 0; i < reg->count; i++)
+        if (strcmp(reg->peers[i].endpoint, endpoint) == 0) return &reg->peers[i];
+    return NULL;
+}
+
+static bool has_cap(const SeaA2aRegistryPeer* p, const char* cap) {
+    for (u32 i = 0; i < p->cap_count; i++)
+        if (strcmp(p->caps[i], cap) == 0) return true;
+    return false;
+}
+
+/* ── Persistence ─────────────────────────────────────────── */
+
+static void join_caps(const SeaA2aRegistryPeer* p, char* buf, size_t size) {
+    size_t pos = 0;
+    buf[0] = '\0';
+    for (u32 i = 0; i < p->cap_count && pos < size; i++)
+        pos += (size_t)snprintf(buf + pos, size - pos, "%s%s", i ? "," : "", p->caps[i]);
+}
+
+static void split_caps(SeaA2aRegistryPeer* p, const char* list) {
+    p->cap_count = 0;
+    while (list && *list && p->cap_count < SEA_A2A_CAPS_MAX) {
+        const char* comma = strchr(list, ',');
+        size_t len = comma ? (size_t)(comma - list) : strlen(list);
+        if (len > 0 && len < SEA_A2A_CAP_NAME_MAX) {
+            memcpy(p->caps[p->cap_count], list, len);
+            p->caps[p->cap_count++][len] = '\0';
+        }
+        list = comma ? comma + 1 : NULL;
+    }
+}
+
+static void save_peers(SeaA2aRegistry* reg, const SeaA2aRegistryPeer* peers, u32 count) {
+    if (!reg->db || count == 0) return;
+    const char* sql =
+        "INSERT OR REPLACE INTO a2a_peers (endpoint, name, api_key, capabilities, healthy,"
+        " fail_streak, last_seen, latency_us, probes, probe_failures)"
+        " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(reg->db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return;
+
+    for (u32 i = 0; i < count; i++) {
+        const SeaA2aRegistryPeer* p = &peers[i];
+        char caps[SEA_A2A_CAPS_MAX * SEA_A2A_CAP_NAME_MAX];
+        join_caps(p, caps, sizeof(caps));
+        sqlite3_bind_text(stmt, 1, p->endpoint, -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 2, p->name, -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 3, p->api_key, -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 4, caps, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 5, p->healthy ? 1 : 0);
+        sqlite3_bind_int(stmt, 6, (int)p->fail_streak);
+        sqlite3_bind_int64(stmt, 7, (sqlite3_int64)p->last_seen);
+        sqlite3_bind_int64(stmt, 8, (sqlite3_int64)p->latency_us);
+        sqlite3_bind_int64(stmt, 9, (sqlite3_int64)p->probes);
+        sqlite3_bind_int64(stmt, 10, (sqlite3_int64)p->probe_failures);
+        if (sqlite3_step(stmt) != SQLITE_DONE)
+            SEA_LOG_WARN("A2A", "Saving peer %s failed: %s", p->endpoint,
+                         sqlite3_errmsg(reg->db->handle));
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+}
+
+static void save_fetched_at(SeaA2aRegistry* reg, u64 fetched_at) {
+    if (!reg->db || !reg->discovery_url[0]) return;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(reg->db->handle,
+            "INSERT OR REPLACE INTO a2a_discovery (url, fetched_at) VALUES (?, ?)",
+            -1, &stmt, NULL) != SQLITE_OK) return;
+    sqlite3_bind_text(stmt, 1, reg->discovery_url, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 2, (sqlite3_int64)fetched_at);
+    sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+}
+
+static void copy_col(char* dst, size_t size, sqlite3_stmt* stmt, int col) {
+    const char* v = (const char*)sqlite3_column_text(stmt, col);
+    snprintf(dst, size, "%s", v ? v : "");
+}
+
+static void load_state(SeaA2aRegistry* reg) {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(reg->db->handle,
+            "SELECT endpoint, name, api_key, capabilities, healthy, fail_streak, last_seen,"
+            " latency_us, probes, probe_failures FROM a2a_peers ORDER BY rowid",
+            -1, &stmt, NULL) != SQLITE_OK) return;
+
+    /* Keep persisted health only while it is recent; every restored
+     * peer is probed on the first round either way. */
+    u64 now = now_epoch(), mono = mono_ms();
+    while (sqlite3_step(stmt) == SQLITE_ROW && reg->count < SEA_A2A_REGISTRY_MAX) {
+        SeaA2aRegistryPeer* p = &reg->peers[reg->count++];
+        memset(p, 0, sizeof(*p));
+        copy_col(p->endpoint, sizeof(p->endpoint), stmt, 0);
+        copy_col(p->name, sizeof(p->name), stmt, 1);
+        copy_col(p->api_key, sizeof(p->api_key), stmt, 2);
+        split_caps(p, (const char*)sqlite3_column_text(stmt, 3));
+        p->fail_streak    = (u32)sqlite3_column_int(stmt, 5);
+        p->last_seen      = (u64)sqlite3_column_int64(stmt, 6);
+        p->latency_us     = (u64)sqlite3_column_int64(stmt, 7);
+        p->probes         = (u64)sqlite3_column_int64(stmt, 8);
+        p->probe_failures = (u64)sqlite3_column_int64(stmt, 9);
+        p->healthy = sqlite3_column_int(stmt, 4) != 0 && p->last_seen + reg->cfg.ttl_sec >= now;
+        p->next_probe_ms = mono;
+    }
+    sqlite3_finalize(stmt);
+
+    if (reg->discovery_url[0] &&
+        sqlite3_prepare_v2(reg->db->handle,
+            "SELECT fetched_at FROM a2a_discovery WHERE url = ?", -1, &stmt, NULL) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, reg->discovery_url, -1, SQLITE_STATIC);
+        if (sqlite3_step(stmt) == SQLITE_ROW) reg->fetched_at = (u64)sqlite3_column_int64(stmt, 0);
+        sqlite3_finalize(stmt);
+    }
+}
+
+/* ── Lifecycle ───────────────────────────────────────────── */
+
+SeaError sea_a2a_registry_create(SeaA2aRegistry** out, SeaDb* db,
+                                 const SeaA2aRegistryConfig* cfg) {
+    if (!out) return SEA_ERR_INVALID_INPUT;
+    SeaA2aRegistry* reg = (SeaA2aRegistry*)calloc(1, sizeof(SeaA2aRegistry));
+    if (!reg) return SEA_ERR_OOM;
+    if (sea_arena_create_named(&reg->arena, "a2a", REGISTRY_ARENA) != SEA_OK) {
+        free(reg);
+        return SEA_ERR_OOM;
+    }
+
+    if (cfg) reg->cfg = *cfg;
+    if (!reg->cfg.ttl_sec)          reg->cfg.ttl_sec = SEA_A2A_DISCOVERY_TTL_SEC;
+    if (!reg->cfg.interval_ms)      reg->cfg.interval_ms = SEA_A2A_PROBE_INTERVAL_MS;
+    if (!reg->cfg.backoff_max_ms)   reg->cfg.backoff_max_ms = SEA_A2A_PROBE_BACKOFF_MS;
+    if (!reg->cfg.probe_timeout_ms) reg->cfg.probe_timeout_ms = SEA_A2A_PROBE_TIMEOUT_MS;
+    if (reg->cfg.backoff_max_ms < reg->cfg.interval_ms) reg->cfg.backoff_max_ms = reg->cfg.interval_ms;
+    if (reg->cfg.discovery_url)
+        snprintf(reg->discovery_url, sizeof(reg->discovery_url), "%s", reg->cfg.discovery_url);
+    reg->cfg.discovery_url = reg->discovery_url[0] ? reg->discovery_url : NULL;
+
+    pthread_mutex_init(&reg->lock, NULL);
+    pthread_mutex_init(&reg->io_lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&reg->wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    reg->db = db;
+    if (db) {
+        char* err_msg = NULL;
+        if (sqlite3_exec(db->handle, SCHEMA_SQL, NULL, NULL, &err_msg) != SQLITE_OK) {
+            SEA_LOG_ERROR("A2A", "Registry schema failed: %s", err_msg ? err_msg : "unknown");
+            if (err_msg) sqlite3_free(err_msg);
+            reg->db = NULL;
+        } else {
+            load_state(reg);
+        }
+    }
+
+    SEA_LOG_INFO("A2A", "Peer registry ready (%u peers restored)", reg->count);
+    *out = reg;
+    return SEA_OK;
+}
+
+void sea_a2a_registry_destroy(SeaA2aRegistry* reg) {
+    if (!reg) return;
+    pthread_mutex_lock(&reg->lock);
+    reg->running = false;
+    pthread_cond_broadcast(&reg->wake);
+    pthread_mutex_unlock(&reg->lock);
+    if (reg->has_thread) pthread_join(reg->thread, NULL);
+
+    save_peers(reg, reg->peers, reg->count);
+    pthread_cond_destroy(&reg->wake);
+    pthread_mutex_destroy(&reg->io_lock);
+    pthread_mutex_destroy(&reg->lock);
+    sea_arena_destroy(&reg->arena);
+    free(reg);
+}
+
+/* ── Registration ────────────────────────────────────────── */
+
+/* Caller holds reg->lock. Returns the entry, NULL when the table is full. */
+static SeaA2aRegistryPeer* upsert(SeaA2aRegistry* reg, const char* name, const char* endpoint,
+                                  const char* api_key) {
+    SeaA2aRegistryPeer* p = find_peer(reg, endpoint);
+    if (!p) {
+        if (reg->count >= SEA_A2A_REGISTRY_MAX) return NULL;
+        p = &reg->peers[reg->count++];
+        memset(p, 0, sizeof(*p));
+        snprintf(p->endpoint, sizeof(p->endpoint), "%s", endpoint);
+        p->next_probe_ms = mono_ms();
+        pthread_cond_broadcast(&reg->wake);
+    }
+    if (name && *name) snprintf(p->name, sizeof(p->name), "%s", name);
+    if (api_key) snprintf(p->api_key, sizeof(p->api_key), "%s", api_key);
+    return p;
+}
+
+SeaError sea_a2a_registry_add(SeaA2aRegistry* reg, const SeaA2aPeer* peer,
+                              const char* const* caps, u32 cap_count) {
+    if (!reg || !peer || !peer->endpoint || !*peer->endpoint) return SEA_ERR_INVALID_INPUT;
+
+    pthread_mutex_lock(&reg->lock);
+    SeaA2aRegistryPeer* p = upsert(reg, peer->name, peer->endpoint, peer->api_key);
+    SeaA2aRegistryPeer copy;
+    if (p) {
+        if (caps) {
+            p->cap_count = 0;
+            for (u32 i = 0; i < cap_count && p->cap_count < SEA_A2A_CAPS_MAX; i++)
+                snprintf(p->caps[p->cap_count++], SEA_A2A_CAP_NAME_MAX, "%s", caps[i]);
+        }
+        copy = *p;
+    }
+    pthread_mutex_unlock(&reg->lock);
+
+    if (!p) return SEA_ERR_ARENA_FULL;
+    save_peers(reg, &copy, 1);
+    return SEA_OK;
+}
+
+/* ── Discovery ───────────────────────────────────────────── */
+
+/* Absent JSON fields come back as an empty slice with NULL data. */
+static void slice_cstr(SeaSlice s, char* dst, size_t size) {
+    if (!s.data || s.len == 0) { dst[0] = '\0'; return; }
+    size_t n = s.len < size - 1 ? s.len : size - 1;
+    memcpy(dst, s.data, n);
+    dst[n] = '\0';
+}
+
+SeaError sea_a2a_registry_refresh(SeaA2aRegistry* reg, bool force, u32* found) {
+    if (found) *found = 0;
+    if (!reg) return SEA_ERR_INVALID_INPUT;
+    if (!reg->discovery_url[0]) return SEA_OK;
+
+    pthread_mutex_lock(&reg->io_lock);
+    pthread_mutex_lock(&reg->lock);
+    bool fresh = reg->fetched_at && reg->fetched_at + reg->cfg.ttl_sec > now_epoch();
+    pthread_mutex_unlock(&reg->lock);
+    if (fresh && !force) {
+        pthread_mutex_unlock(&reg->io_lock);
+        return SEA_OK;
+    }
+
+    sea_arena_reset(&reg->arena);
+    SeaHttpResponse resp;
+    SeaError err = sea_http_get(reg->discovery_url, &reg->arena, &resp);
+    SeaJsonValue root;
+    if (err == SEA_OK && resp.status_code != 200) err = SEA_ERR_CONNECT;
+    if (err == SEA_OK && sea_json_parse(resp.body, &reg->arena, &root) != SEA_OK) err = SEA_ERR_INVALID_JSON;
+    const SeaJsonValue* agents = err == SEA_OK ? sea_json_get(&root, "agents") : NULL;
+    if (err == SEA_OK && (!agents || agents->type != SEA_JSON_ARRAY)) err = SEA_ERR_PARSE;
+    if (err != SEA_OK) {
+        pthread_mutex_unlock(&reg->io_lock);
+        SEA_LOG_WARN("A2A", "Discovery from %s failed: %s", reg->discovery_url, sea_error_str(err));
+        return err;
+    }
+
+    /* Expect: {"agents": [{"name", "endpoint", "api_key", "capabilities": [...]}]} */
+    SeaA2aRegistryPeer* changed = (SeaA2aRegistryPeer*)sea_arena_alloc(&reg->arena,
+        sizeof(SeaA2aRegistryPeer) * SEA_A2A_REGISTRY_MAX, 8);
+    u32 n = 0, listed = 0;
+    u64 fetched_at = now_epoch();
+    pthread_mutex_lock(&reg->lock);
+    for (u32 i = 0; i < agents->array.count; i++) {
+        const SeaJsonValue* agent = &agents->array.items[i];
+        char name[64], endpoint[256], key[128];
+        SeaSlice ep = sea_json_get_string(agent, "endpoint");
+        if (ep.len == 0 || ep.len >= sizeof(endpoint)) continue;
+        slice_cstr(ep, endpoint, sizeof(endpoint));
+        slice_cstr(sea_json_get_string(agent, "name"), name, sizeof(name));
+        SeaSlice k = sea_json_get_string(agent, "api_key");
+        slice_cstr(k, key, sizeof(key));
+        listed++;
+
+        SeaA2aRegistryPeer* p = upsert(reg, name, endpoint, k.len ? key : NULL);
+        if (!p) continue;
+        const SeaJsonValue* caps = sea_json_get(agent, "capabilities");
+        if (caps && caps->type == SEA_JSON_ARRAY) {
+            p->cap_count = 0;
+            for (u32 c = 0; c < caps->array.count && p->cap_count < SEA_A2A_CAPS_MAX; c++) {
+                const SeaJsonValue* cv = &caps->array.items[c];
+                if (cv->type != SEA_JSON_STRING || cv->string.len == 0) continue;
+                slice_cstr(cv->string, p->caps[p->cap_count++], SEA_A2A_CAP_NAME_MAX);
+            }
+        }
+        if (changed && n < SEA_A2A_REGISTRY_MAX) changed[n++] = *p;
+    }
+    reg->fetched_at = fetched_at;
+    pthread_mutex_unlock(&reg->lock);
+
+    if (changed) save_peers(reg, changed, n);
+    save_fetched_at(reg, fetched_at);
+    pthread_mutex_unlock(&reg->io_lock);
+
+    SEA_LOG_INFO("A2A", "Discovered %u agents from %s", listed, reg->discovery_url);
+    if (found) *found = listed;
+    return SEA_OK;
+}
+
+/* ── Health Probing ──────────────────────────────────────── */
+
+/* Caller holds reg->lock. Fold one outcome into a peer's health. */
+static void apply_outcome(SeaA2aRegistry* reg, SeaA2aRegistryPeer* p, bool ok,
+                          u64 latency_us, bool probe) {
+    if (probe) p->probes++;
+    if (ok) {
+        if (!p->healthy) SEA_LOG_INFO("A2A", "Peer %s is back", p->endpoint);
+        p->healthy = true;
+        p->fail_streak = 0;
+        p->last_seen = now_epoch();
+        if (probe) p->latency_us = p->latency_us ? (p->latency_us * 7 + latency_us) / 8 : latency_us;
+    } else {
+        if (probe) p->probe_failures++;
+        if (p->healthy) SEA_LOG_WARN("A2A", "Peer %s marked unhealthy", p->endpoint);
+        p->healthy = false;
+        p->fail_streak++;
+    }
+    p->next_probe_ms = mono_ms() + probe_delay(reg, ok ? 0 : p->fail_streak);
+}
+
+u32 sea_a2a_registry_probe(SeaA2aRegistry* reg) {
+    if (!reg) return 0;
+    pthread_mutex_lock(&reg->io_lock);
+    sea_arena_reset(&reg->arena);
+
+    SeaHttpRequest* reqs = (SeaHttpRequest*)sea_arena_alloc(&reg->arena,
+        sizeof(SeaHttpRequest) * SEA_A2A_REGISTRY_MAX, 8);
+    if (!reqs) { pthread_mutex_unlock(&reg->io_lock); return 0; }
+
+    /* Snapshot the due peers */
+    u32 n = 0;
+    u64 now = mono_ms();
+    pthread_mutex_lock(&reg->lock);
+    for (u32 i = 0; i < reg->count; i++) {
+        const SeaA2aRegistryPeer* p = &reg->peers[i];
+        if (p->next_probe_ms > now) continue;
+        size_t ulen = strlen(p->endpoint) + 16;
+        char* url = (char*)sea_arena_alloc(&reg->arena, ulen, 1);
+        char* hdr = NULL;
+        if (p->api_key[0]) {
+            size_t hlen = strlen(p->api_key) + 32;
+            hdr = (char*)sea_arena_alloc(&reg->arena, hlen, 1);
+            if (hdr) snprintf(hdr, hlen, "Authorization: Bearer %s", p->api_key);
+        }
+        if (!url) break;
+        snprintf(url, ulen, "%s/heartbeat", p->endpoint);
+        reqs[n++] = (SeaHttpRequest){ .url = url, .header = hdr,
+                                      .timeout_ms = reg->cfg.probe_timeout_ms };
+    }
+    pthread_mutex_unlock(&reg->lock);
+
+    if (n == 0 || sea_http_multi(reqs, n, &reg->arena) != SEA_OK) {
+        pthread_mutex_unlock(&reg->io_lock);
+        return 0;
+    }
+
+    /* Apply by endpoint: the table may have changed meanwhile */
+    SeaA2aRegistryPeer* changed = (SeaA2aRegistryPeer*)sea_arena_alloc(&reg->arena,
+        sizeof(SeaA2aRegistryPeer) * n, 8);
+    u32 saved = 0;
+    pthread_mutex_lock(&reg->lock);
+    for (u32 i = 0; i < n; i++) {
+        size_t elen = strlen(reqs[i].url) - strlen("/heartbeat");
+        char endpoint[256];
+        snprintf(endpoint, sizeof(endpoint), "%.*s", (int)elen, reqs[i].url);
+        SeaA2aRegistryPeer* p = find_peer(reg, endpoint);
+        if (!p) continue;
+        bool ok = reqs[i].err == SEA_OK && reqs[i].resp.status_code == 200;
+        apply_outcome(reg, p, ok, reqs[i].elapsed_us, true);
+        if (changed) changed[saved++] = *p;
+    }
+    pthread_mutex_unlock(&reg->lock);
+
+    if (changed) save_peers(reg, changed, saved);
+    pthread_mutex_unlock(&reg->io_lock);
+    return n;
+}
+
+void sea_a2a_registry_report(SeaA2aRegistry* reg, const char* endpoint, bool ok) {
+    if (!reg || !endpoint) return;
+    pthread_mutex_lock(&reg->lock);
+    SeaA2aRegistryPeer* p = find_peer(reg, endpoint);
+    if (p) apply_outcome(reg, p, ok, 0, false);
+    pthread_mutex_unlock(&reg->lock);
+}
+
+/* ── Background Thread ───────────────────────────────────── */
+
+static void* registry_thread(void* arg) {
+    SeaA2aRegistry* reg = (SeaA2aRegistry*)arg;
+    for (;;) {
+        sea_a2a_registry_refresh(reg, false, NULL);
+        sea_a2a_registry_probe(reg);
+
+        /* Sleep until the earliest probe or discovery deadline */
+        pthread_mutex_lock(&reg->lock);
+        u64 now = mono_ms();
+        u64 wake = now + reg->cfg.interval_ms;
+        for (u32 i = 0; i < reg->count; i++)
+            if (reg->peers[i].next_probe_ms < wake) wake = reg->peers[i].next_probe_ms;
+        if (reg->discovery_url[0]) {
+            u64 expires = reg->fetched_at + reg->cfg.ttl_sec, epoch = now_epoch();
+            /* After a failed fetch, retry on the probe interval */
+            u64 due = expires > epoch ? now + (expires - epoch) * 1000 : now + reg->cfg.interval_ms;
+            if (due < wake) wake = due;
+        }
+        if (reg->running && wake > now) {
+            struct timespec ts = { .tv_sec = (time_t)(wake / 1000),
+                                   .tv_nsec = (long)(wake % 1000) * 1000000 };
+            pthread_cond_timedwait(&reg->wake, &reg->lock, &ts);
+        }
+        bool running = reg->running;
+        pthread_mutex_unlock(&reg->lock);
+        if (!running) break;
+    }
+    return NULL;
+}
+
+SeaError sea_a2a_registry_start(SeaA2aRegistry* reg) {
+    if (!reg) return SEA_ERR_INVALID_INPUT;
+    pthread_mutex_lock(&reg->lock);
+    if (reg->has_thread) { pthread_mutex_unlock(&reg->lock); return SEA_OK; }
+    reg->running = true;
+    if (pthread_create(&reg->thread, NULL, registry_thread, reg) != 0) {
+        reg->running = false;
+        pthread_mutex_unlock(&reg->lock);
+        return SEA_ERR_IO;
+    }
+    reg->has_thread = true;
+    pthread_mutex_unlock(&reg->lock);
+    SEA_LOG_INFO("A2A", "Registry probing every %ums (backoff cap %ums)",
+                 reg->cfg.interval_ms, reg->cfg.backoff_max_ms);
+    return SEA_OK;
+}
+
+/* ── Queries ─────────────────────────────────────────────── */
+
+static const char* arena_str(SeaArena* arena, const char* s) {
+    size_t len = strlen(s);
+    char* out = (char*)sea_arena_alloc(arena, len + 1, 1);
+    if (out) memcpy(out, s, len + 1);
+    return out;
+}
+
+u32 sea_a2a_registry_pick(SeaA2aRegistry* reg, const char* capability,
+                          SeaA2aPeer* out, u32 max, SeaArena* arena) {
+    if (!reg || !out || !arena || max == 0) return 0;
+
+    SeaA2aPeer found[SEA_A2A_REGISTRY_MAX];
+    u32 n = 0;
+    pthread_mutex_lock(&reg->lock);
+    for (u32 i = 0; i < reg->count; i++) {
+        const SeaA2aRegistryPeer* p = &reg->peers[i];
+        if (!p->healthy || (capability && !has_cap(p, capability))) continue;
+        found[n++] = (SeaA2aPeer){
+            .name      = arena_str(arena, p->name[0] ? p->name : p->endpoint),
+            .endpoint  = arena_str(arena, p->endpoint),
+            .api_key   = p->api_key[0] ? arena_str(arena, p->api_key) : NULL,
+            .healthy   = true,
+            .last_seen = p->last_seen,
+        };
+    }
+    pthread_mutex_unlock(&reg->lock);
+
+    u32 order[SEA_A2A_REGISTRY_MAX];
+    sea_a2a_rank_peers(found, n, order);
+    u32 count = n < max ? n : max;
+    for (u32 i = 0; i < count; i++) out[i] = found[order[i]];
+    return count;
+}
+
+u32 sea_a2a_registry_snapshot(SeaA2aRegistry* reg, SeaA2aRegistryPeer* out, u32 max) {
+    if (!reg || !out) return 0;
+    pthread_mutex_lock(&reg->lock);
+    u32 n = reg->count < max ? reg->count : max;
+    memcpy(out, reg->peers, sizeof(SeaA2aRegistryPeer) * n);
+    pthread_mutex_unlock(&reg->lock);
+    return n;
+}
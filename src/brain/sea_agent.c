@@ -16,6 +16,10 @@
 #include "seaclaw/sea_memory.h"
 #include "seaclaw/sea_recall.h"
 #include "seaclaw/sea_pii.h"
+#include "seaclaw/sea_usage.h"
+#include "seaclaw/sea_llm_cache.h"
+#include "seaclaw/sea_metrics.h"
+#include "seaclaw/sea_trace.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -24,6 +28,8 @@
 extern SeaDb* s_db;
 extern SeaMemory* s_memory;
 extern SeaRecall* s_recall;
+extern SeaUsageTracker* s_usage;
+extern SeaLlmCache* s_llm_cache;
 
 /* ── Defaults ─────────────────────────────────────────────── */
 
@@ -79,17 +85,21 @@ void sea_agent_defaults(SeaAgentConfig* cfg) {
         cfg->max_tokens = 4096;
 }
 
+static const char* provider_name(SeaLlmProvider provider) {
+    switch (provider) {
+        case SEA_LLM_OPENAI:     return "OpenAI";
+        case SEA_LLM_ANTHROPIC:  return "Anthropic";
+        case SEA_LLM_GEMINI:     return "Gemini";
+        case SEA_LLM_OPENROUTER: return "OpenRouter";
+        case SEA_LLM_LOCAL:      return "Local";
+        case SEA_LLM_ZAI:        return "Z.AI";
+    }
+    return "Unknown";
+}
+
 void sea_agent_init(SeaAgentConfig* cfg) {
     sea_agent_defaults(cfg);
-    const char* prov_name = "Unknown";
-    switch (cfg->provider) {
-        case SEA_LLM_OPENAI:     prov_name = "OpenAI"; break;
-        case SEA_LLM_ANTHROPIC:  prov_name = "Anthropic"; break;
-        case SEA_LLM_GEMINI:     prov_name = "Gemini"; break;
-        case SEA_LLM_OPENROUTER: prov_name = "OpenRouter"; break;
-        case SEA_LLM_LOCAL:      prov_name = "Local"; break;
-        case SEA_LLM_ZAI:        prov_name = "Z.AI"; break;
-    }
+    const char* prov_name = provider_name(cfg->provider);
     SEA_LOG_INFO("AGENT", "Provider: %s, Model: %s (max_tokens=%u)", prov_name, cfg->model, cfg->max_tokens);
 }
 
@@ -282,6 +292,8 @@ typedef struct {
     const char* tool_name;
     const char* tool_args;
     const char* text;
+    u32         tokens_in;      /* From the provider's usage block */
+    u32         tokens_out;
 } ParsedResponse;
 
 static ParsedResponse parse_llm_response(const char* body, u32 body_len,
@@ -296,6 +308,15 @@ static ParsedResponse parse_llm_response(const char* body, u32 body_len,
         return pr;
     }
 
+    /* usage: prompt/completion_tokens (OpenAI) or input/output_tokens */
+    const SeaJsonValue* usage = sea_json_get(&root, "usage");
+    if (usage) {
+        pr.tokens_in  = (u32)sea_json_get_number(usage, "prompt_tokens",
+                            sea_json_get_number(usage, "input_tokens", 0.0));
+        pr.tokens_out = (u32)sea_json_get_number(usage, "completion_tokens",
+                            sea_json_get_number(usage, "output_tokens", 0.0));
+    }
+
     /* Extract choices[0].message.content */
     const SeaJsonValue* choices = sea_json_get(&root, "choices");
     if (!choices || choices->type != SEA_JSON_ARRAY || choices->array.count == 0) {
@@ -426,12 +447,38 @@ static const char* build_auth_header(SeaAgentConfig* cfg, SeaArena* arena) {
     return hdr;
 }
 
+/* ── Call accounting ──────────────────────────────────────── */
+
+/* One LLM round trip: the usage tracker plus the per-provider series. */
+static void record_llm_call(const char* provider, u32 tokens_in, u32 tokens_out,
+                            bool error, u64 ttfb_us, u64 total_us) {
+    sea_usage_record_timed(s_usage, provider, tokens_in, tokens_out, error,
+                           ttfb_us, total_us);
+    sea_metric_observe(sea_metric_histogram("sea_llm_request_duration_seconds",
+                       "LLM request time", "provider", provider, &SEA_METRICS_LATENCY),
+                       (f64)total_us / 1e6);
+    if (error) {
+        sea_metric_inc(sea_metric_counter("sea_llm_errors_total",
+                       "LLM requests that failed", "provider", provider));
+        return;
+    }
+    sea_metric_add(sea_metric_counter("sea_llm_input_tokens_total",
+                   "Prompt tokens sent", "provider", provider), tokens_in);
+    sea_metric_add(sea_metric_counter("sea_llm_output_tokens_total",
+                   "Completion tokens received", "provider", provider), tokens_out);
+}
+
+/* 0 = answered directly; the top bucket is the default round limit */
+static const SeaMetricBuckets TOOL_ROUND_BUCKETS = {
+    .bounds = { 0, 1, 2, 3, 5, 8 }, .count = 6
+};
+
 /* ── Main agent chat loop ─────────────────────────────────── */
 
-SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
-                              SeaChatMsg* history, u32 history_count,
-                              const char* user_input,
-                              SeaArena* arena) {
+static SeaAgentResult agent_chat(SeaAgentConfig* cfg,
+                                 SeaChatMsg* history, u32 history_count,
+                                 const char* user_input,
+                                 SeaArena* arena) {
     SeaAgentResult result = { .text = NULL, .tool_calls = 0,
                               .tokens_used = 0, .error = SEA_OK };
 
@@ -454,6 +501,7 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
 
     /* Inject memory context: SOUL + USER from files, recall facts from DB */
     const char* system_prompt = base_prompt;
+    SeaTraceSpan ctx_span = sea_trace_begin("memory.context");
     {
         StrBuf mp = strbuf_new(arena, 8192);
         strbuf_append(&mp, base_prompt);
@@ -477,7 +525,9 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
         /* Memory instructions + relevant facts from recall DB */
         strbuf_append(&mp, MEMORY_INSTRUCTIONS);
         if (s_recall) {
+            SeaTraceSpan recall_span = sea_trace_begin("recall");
             const char* recall_ctx = sea_recall_build_context(s_recall, user_input, arena);
+            sea_trace_end(recall_span);
             if (recall_ctx) {
                 strbuf_append(&mp, recall_ctx);
             } else {
@@ -487,6 +537,7 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
 
         system_prompt = mp.buf;
     }
+    sea_trace_end(ctx_span);
 
     /* Build auth header */
     const char* auth_hdr = build_auth_header(cfg, arena);
@@ -499,6 +550,9 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
     const char* current_input = user_input;
 
     for (u32 round = 0; round < cfg->max_tool_rounds; round++) {
+        sea_trace_round(round + 1);
+        SeaTraceSpan build_span = sea_trace_begin("prompt.build");
+
         /* Build combined history: original + extra tool messages */
         u32 total_hist = history_count + extra_count;
         SeaChatMsg* combined = NULL;
@@ -517,6 +571,7 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
         /* Build request JSON */
         const char* req_json = build_request_json(cfg, system_prompt,
             combined, total_hist, current_input, arena);
+        sea_trace_end(build_span);
         if (!req_json) {
             result.error = SEA_ERR_OOM;
             result.text = "Failed to build request";
@@ -532,15 +587,34 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
         SeaError err = SEA_ERR_IO;
         bool got_response = false;
 
-        /* Try primary provider */
-        if (auth_hdr) {
+        /* Try primary provider — unless an identical request is cached
+         * or already in flight, in which case its answer is reused */
+        SeaTraceSpan http_span = sea_trace_begin("llm.http");
+        const char* used_provider = provider_name(cfg->provider);
+        resp = (SeaHttpResponse){ 0 };
+        SeaLlmCacheKey ckey;
+        SeaCacheResult cached = SEA_CACHE_BYPASS;
+        if (s_llm_cache &&
+            sea_llm_cache_key(s_llm_cache, cfg->api_url, body, arena, &ckey) == SEA_OK)
+            cached = sea_llm_cache_begin(s_llm_cache, &ckey, arena, &resp.body);
+        bool reused = (cached == SEA_CACHE_HIT || cached == SEA_CACHE_SHARED);
+        if (reused) {
+            err = SEA_OK;
+            resp.status_code = 200;
+            SEA_LOG_INFO("AGENT", "Round %u: %s response reused", round + 1,
+                         cached == SEA_CACHE_HIT ? "cached" : "in-flight");
+        } else if (auth_hdr) {
             err = sea_http_post_json_auth(cfg->api_url, body, auth_hdr, arena, &resp);
         } else {
             err = sea_http_post_json(cfg->api_url, body, arena, &resp);
         }
+        if (cached == SEA_CACHE_LEADER)
+            sea_llm_cache_complete(s_llm_cache, &ckey, resp.body,
+                                   err == SEA_OK && resp.status_code == 200);
         if (err == SEA_OK && resp.status_code == 200) {
             got_response = true;
         } else {
+            record_llm_call(used_provider, 0, 0, true, resp.ttfb_us, resp.total_us);
             SEA_LOG_WARN("AGENT", "Primary provider failed (err=%d, http=%d), trying fallbacks...",
                          err, (err == SEA_OK) ? resp.status_code : 0);
             if (err == SEA_OK && resp.body.len > 0) {
@@ -572,6 +646,8 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
             SEA_LOG_INFO("AGENT", "Fallback %u: trying %s (%s)",
                          fb + 1, fb_cfg.api_url, fb_cfg.model);
 
+            used_provider = provider_name(fb_cfg.provider);
+            resp = (SeaHttpResponse){ 0 };
             if (fb_auth) {
                 err = sea_http_post_json_auth(fb_cfg.api_url, fb_body, fb_auth, arena, &resp);
             } else {
@@ -582,11 +658,14 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
                 got_response = true;
                 SEA_LOG_INFO("AGENT", "Fallback %u succeeded (%s)", fb + 1, fb_cfg.model);
             } else {
+                record_llm_call(used_provider, 0, 0, true, resp.ttfb_us, resp.total_us);
                 SEA_LOG_WARN("AGENT", "Fallback %u failed (err=%d, http=%d)",
                              fb + 1, err, (err == SEA_OK) ? resp.status_code : 0);
             }
         }
 
+        sea_trace_end(http_span);
+
         if (!got_response) {
             result.error = err;
             if (err == SEA_OK && resp.status_code != 200) {
@@ -607,8 +686,15 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
         }
 
         /* Parse response */
+        SeaTraceSpan parse_span = sea_trace_begin("llm.parse");
         ParsedResponse pr = parse_llm_response(
             (const char*)resp.body.data, resp.body.len, arena);
+        sea_trace_end(parse_span);
+        if (!reused) {
+            record_llm_call(used_provider, pr.tokens_in, pr.tokens_out, false,
+                            resp.ttfb_us, resp.total_us);
+            result.tokens_used += pr.tokens_in + pr.tokens_out;
+        }
 
         if (!pr.has_tool_call) {
             /* No tool call — we have the final answer */
@@ -616,7 +702,10 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
             if (pr.text && strlen(pr.text) > 0) {
                 SeaSlice out_slice = { .data = (const u8*)pr.text,
                                        .len = (u32)strlen(pr.text) };
-                if (sea_shield_detect_output_injection(out_slice)) {
+                SeaTraceSpan shield_span = sea_trace_begin("shield.output");
+                bool injected = sea_shield_detect_output_injection(out_slice);
+                sea_trace_end(shield_span);
+                if (injected) {
                     SEA_LOG_WARN("AGENT", "Shield REJECTED LLM output (injection)");
                     result.text = "[Output rejected by Shield: potential injection detected]";
                     result.error = SEA_ERR_INVALID_INPUT;
@@ -662,7 +751,9 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
             .len = pr.tool_args ? (u32)strlen(pr.tool_args) : 0
         };
         SeaSlice tool_output;
+        SeaTraceSpan tool_span = sea_trace_begin("tool");
         SeaError tool_err = sea_tool_exec(pr.tool_name, tool_args, arena, &tool_output);
+        sea_trace_end(tool_span);
 
         /* Audit: log tool execution */
         if (s_db && pr.tool_name) {
@@ -715,6 +806,17 @@ SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
     return result;
 }
 
+SeaAgentResult sea_agent_chat(SeaAgentConfig* cfg,
+                              SeaChatMsg* history, u32 history_count,
+                              const char* user_input,
+                              SeaArena* arena) {
+    SeaAgentResult result = agent_chat(cfg, history, history_count, user_input, arena);
+    sea_metric_observe(sea_metric_histogram("sea_agent_tool_rounds",
+                       "Tool calls made per agent turn", NULL, NULL, &TOOL_ROUND_BUCKETS),
+                       (f64)result.tool_calls);
+    return result;
+}
+
 /* ── Compact: summarize conversation history ──────────────── */
 
 const char* sea_agent_compact(SeaAgentConfig* cfg,
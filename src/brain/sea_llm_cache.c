@@ -0,0 +1,459 @@
+/*
+ * sea_llm_cache.c — LLM Response Cache
+ *
+ * The key walks the parsed request once, feeding SHA-256 a tagged,
+ * length-prefixed encoding of every value, so two bodies hash alike
+ * exactly when they mean the same JSON. Stored responses sit in the
+ * llm_cache table; in-flight calls are a short list of flights, each
+ * with its own condvar, under one mutex.
+ */
+
+#include "seaclaw/sea_llm_cache.h"
+#include "seaclaw/sea_json.h"
+#include "seaclaw/sea_hash.h"
+#include "seaclaw/sea_log.h"
+
+#include <sqlite3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+/* ── Access internal DB handle ───────────────────────────── */
+
+struct SeaDb { sqlite3* handle; };
+
+/* ── State ─────────────────────────────────────────────────── */
+
+typedef struct Flight {
+    struct Flight*  next;
+    char            key[65];
+    u32             waiters;
+    bool            done;
+    bool            ok;
+    u8*             body;       /* Leader's response, for the waiters */
+    u32             len;
+    pthread_cond_t  cond;
+} Flight;
+
+struct SeaLlmCache {
+    SeaDb*          db;
+    u32             ttl_sec;
+    u64             max_bytes;
+    f64             max_temperature;
+
+    pthread_mutex_t db_lock;
+    u64             bytes;      /* Sum of stored body sizes */
+    u64             entries;
+
+    pthread_mutex_t flight_lock;
+    Flight*         flights;
+
+    _Atomic u64     hits;
+    _Atomic u64     shared;
+    _Atomic u64     misses;
+    _Atomic u64     stored;
+    _Atomic u64     evicted;
+};
+
+static const char* SCHEMA =
+    "CREATE TABLE IF NOT EXISTS llm_cache ("
+    "  key TEXT PRIMARY KEY,"
+    "  body BLOB NOT NULL,"
+    "  size INTEGER NOT NULL,"
+    "  created_at INTEGER NOT NULL,"
+    "  last_hit INTEGER NOT NULL,"
+    "  hits INTEGER NOT NULL DEFAULT 0"
+    ");"
+    "CREATE INDEX IF NOT EXISTS idx_llm_cache_lru ON llm_cache(last_hit);";
+
+/* ── Canonical Key ─────────────────────────────────────────── */
+
+/* Transport-only fields that do not change the answer */
+static const char* IGNORED[] = { "stream", "stream_options", "user" };
+
+static bool slice_is(SeaSlice s, const char* lit) {
+    u32 n = (u32)strlen(lit);
+    return s.len == n && memcmp(s.data, lit, n) == 0;
+}
+
+static bool ignored_key(SeaSlice k) {
+    for (u32 i = 0; i < sizeof(IGNORED) / sizeof(IGNORED[0]); i++)
+        if (slice_is(k, IGNORED[i])) return true;
+    return false;
+}
+
+static i32 slice_cmp(SeaSlice a, SeaSlice b) {
+    u32 n = a.len < b.len ? a.len : b.len;
+    i32 c = memcmp(a.data, b.data, n);
+    if (c) return c;
+    return a.len < b.len ? -1 : (a.len > b.len ? 1 : 0);
+}
+
+/* Strings hash decoded, so an escape and its literal character agree */
+static void hash_string(SeaSha256* h, SeaSlice s, SeaArena* arena) {
+    if (s.len && memchr(s.data, '\\', s.len)) s = sea_json_unescape(s, arena);
+    u8 tag[5] = { 's', (u8)s.len, (u8)(s.len >> 8), (u8)(s.len >> 16), (u8)(s.len >> 24) };
+    sea_sha256_update(h, tag, sizeof(tag));
+    sea_sha256_update(h, s.data, s.len);
+}
+
+static void hash_value(SeaSha256* h, const SeaJsonValue* v, SeaArena* arena, bool top) {
+    char num[40];
+    switch (v->type) {
+        case SEA_JSON_NULL:   sea_sha256_update(h, (const u8*)"n", 1); break;
+        case SEA_JSON_BOOL:   sea_sha256_update(h, (const u8*)(v->boolean ? "t" : "f"), 1); break;
+        case SEA_JSON_NUMBER: {
+            int n = snprintf(num, sizeof(num), "d%.17g;", v->number);
+            sea_sha256_update(h, (const u8*)num, (u64)n);
+            break;
+        }
+        case SEA_JSON_STRING: hash_string(h, v->string, arena); break;
+        case SEA_JSON_ARRAY:
+            sea_sha256_update(h, (const u8*)"[", 1);
+            for (u32 i = 0; i < v->array.count; i++)
+                hash_value(h, &v->array.items[i], arena, false);
+            sea_sha256_update(h, (const u8*)"]", 1);
+            break;
+        case SEA_JSON_OBJECT: {
+            u32 n = v->object.count;
+            u32* order = n ? (u32*)sea_arena_alloc(arena, n * sizeof(u32), 4) : NULL;
+            if (n && !order) return;
+            for (u32 i = 0; i < n; i++) {            /* Insertion sort by key */
+                u32 j = i;
+                while (j > 0 && slice_cmp(v->object.keys[order[j - 1]], v->object.keys[i]) > 0) {
+                    order[j] = order[j - 1];
+                    j--;
+                }
+                order[j] = i;
+            }
+            sea_sha256_update(h, (const u8*)"{", 1);
+            for (u32 i = 0; i < n; i++) {
+                SeaSlice k = v->object.keys[order[i]];
+                if (top && ignored_key(k)) continue;
+                hash_string(h, k, arena);
+                hash_value(h, &v->object.values[order[i]], arena, false);
+            }
+            sea_sha256_update(h, (const u8*)"}", 1);
+            break;
+        }
+    }
+}
+
+SeaError sea_llm_cache_key(SeaLlmCache* cache, const char* url, SeaSlice body,
+                           SeaArena* arena, SeaLlmCacheKey* key) {
+    if (!key) return SEA_ERR_INVALID_INPUT;
+    key->hex[0] = '\0';
+    key->cacheable = false;
+    if (!cache || !arena) return SEA_ERR_INVALID_INPUT;
+
+    SeaJsonValue root;
+    if (sea_json_parse(body, arena, &root) != SEA_OK || root.type != SEA_JSON_OBJECT)
+        return SEA_ERR_PARSE;
+
+    SeaSha256 h;
+    sea_sha256_init(&h);
+    if (url) sea_sha256_update(&h, (const u8*)url, strlen(url) + 1);
+    hash_value(&h, &root, arena, true);
+    u8 digest[32];
+    sea_sha256_final(&h, digest);
+    sea_hash_hex(digest, 32, key->hex);
+
+    const SeaJsonValue* temp = sea_json_get(&root, "temperature");
+    key->cacheable = temp && temp->type == SEA_JSON_NUMBER &&
+                     temp->number <= cache->max_temperature;
+    return SEA_OK;
+}
+
+/* ── Store ─────────────────────────────────────────────────── */
+
+static void recount(SeaLlmCache* c) {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(c->db->handle,
+            "SELECT COUNT(*), COALESCE(SUM(size), 0) FROM llm_cache",
+            -1, &stmt, NULL) != SQLITE_OK) return;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        c->entries = (u64)sqlite3_column_int64(stmt, 0);
+        c->bytes   = (u64)sqlite3_column_int64(stmt, 1);
+    }
+    sqlite3_finalize(stmt);
+}
+
+/* Copy a stored body into arena and bump its hit time. db_lock held. */
+static bool lookup(SeaLlmCache* c, const char* key, SeaArena* arena, SeaSlice* out) {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(c->db->handle,
+            "SELECT body, created_at, size FROM llm_cache WHERE key = ?",
+            -1, &stmt, NULL) != SQLITE_OK) return false;
+    sqlite3_bind_text(stmt, 1, key, -1, SQLITE_STATIC);
+
+    i64 now = (i64)time(NULL);
+    bool found = false, expired = false;
+    i64 size = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        size = sqlite3_column_int64(stmt, 2);
+        if (now - sqlite3_column_int64(stmt, 1) >= (i64)c->ttl_sec) {
+            expired = true;
+        } else {
+            const void* blob = sqlite3_column_blob(stmt, 0);
+            u32 len = (u32)sqlite3_column_bytes(stmt, 0);
+            u8* dst = (u8*)sea_arena_alloc(arena, (u64)len + 1, 1);
+            if (dst) {
+                if (len) memcpy(dst, blob, len);
+                dst[len] = '\0';
+                out->data = dst;
+                out->len = len;
+                found = true;
+            }
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    const char* sql = expired ? "DELETE FROM llm_cache WHERE key = ?"
+                    : found   ? "UPDATE llm_cache SET last_hit = ?2, hits = hits + 1 WHERE key = ?1"
+                    : NULL;
+    if (sql && sqlite3_prepare_v2(c->db->handle, sql, -1, &stmt, NULL) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, key, -1, SQLITE_STATIC);
+        if (found) sqlite3_bind_int64(stmt, 2, now);
+        if (sqlite3_step(stmt) == SQLITE_DONE && expired) {
+            c->bytes -= (u64)size < c->bytes ? (u64)size : c->bytes;
+            if (c->entries) c->entries--;
+        }
+        sqlite3_finalize(stmt);
+    }
+    return found;
+}
+
+/* Drop least-recently-hit entries until under max_bytes. db_lock held. */
+static void evict(SeaLlmCache* c) {
+    recount(c);                     /* A replaced row was counted twice */
+    while (c->bytes > c->max_bytes && c->entries > 0) {
+        char keys[16][65];
+        i64  sizes[16];
+        u32  n = 0;
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(c->db->handle,
+                "SELECT key, size FROM llm_cache ORDER BY last_hit ASC LIMIT 16",
+                -1, &stmt, NULL) != SQLITE_OK) return;
+        while (n < 16 && sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* k = (const char*)sqlite3_column_text(stmt, 0);
+            snprintf(keys[n], sizeof(keys[n]), "%s", k ? k : "");
+            sizes[n++] = sqlite3_column_int64(stmt, 1);
+        }
+        sqlite3_finalize(stmt);
+        if (n == 0 || sqlite3_prepare_v2(c->db->handle,
+                "DELETE FROM llm_cache WHERE key = ?", -1, &stmt, NULL) != SQLITE_OK) {
+            recount(c);
+            return;
+        }
+        for (u32 i = 0; i < n && c->bytes > c->max_bytes; i++) {
+            sqlite3_bind_text(stmt, 1, keys[i], -1, SQLITE_STATIC);
+            if (sqlite3_step(stmt) == SQLITE_DONE) {
+                c->bytes -= (u64)sizes[i] < c->bytes ? (u64)sizes[i] : c->bytes;
+                c->entries--;
+                atomic_fetch_add_explicit(&c->evicted, 1, memory_order_relaxed);
+            }
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+    }
+}
+
+static void store(SeaLlmCache* c, const char* key, SeaSlice body) {
+    pthread_mutex_lock(&c->db_lock);
+    sqlite3_stmt* stmt;
+    i64 now = (i64)time(NULL);
+    if (sqlite3_prepare_v2(c->db->handle,
+            "INSERT OR REPLACE INTO llm_cache (key, body, size, created_at, last_hit)"
+            " VALUES (?, ?, ?, ?, ?)", -1, &stmt, NULL) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, key, -1, SQLITE_STATIC);
+        sqlite3_bind_blob(stmt, 2, body.data, (int)body.len, SQLITE_STATIC);
+        sqlite3_bind_int64(stmt, 3, body.len);
+        sqlite3_bind_int64(stmt, 4, now);
+        sqlite3_bind_int64(stmt, 5, now);
+        if (sqlite3_step(stmt) == SQLITE_DONE) {
+            c->bytes += body.len;
+            c->entries++;
+            atomic_fetch_add_explicit(&c->stored, 1, memory_order_relaxed);
+        } else {
+            SEA_LOG_WARN("CACHE", "Store failed: %s", sqlite3_errmsg(c->db->handle));
+        }
+        sqlite3_finalize(stmt);
+    }
+    if (c->bytes > c->max_bytes) evict(c);
+    pthread_mutex_unlock(&c->db_lock);
+}
+
+u32 sea_llm_cache_purge(SeaLlmCache* cache) {
+    if (!cache || !cache->db) return 0;
+    pthread_mutex_lock(&cache->db_lock);
+    u32 gone = 0;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(cache->db->handle,
+            "DELETE FROM llm_cache WHERE created_at <= ?", -1, &stmt, NULL) == SQLITE_OK) {
+        sqlite3_bind_int64(stmt, 1, (i64)time(NULL) - (i64)cache->ttl_sec);
+        if (sqlite3_step(stmt) == SQLITE_DONE) gone = (u32)sqlite3_changes(cache->db->handle);
+        sqlite3_finalize(stmt);
+    }
+    recount(cache);
+    pthread_mutex_unlock(&cache->db_lock);
+    return gone;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────── */
+
+SeaLlmCache* sea_llm_cache_create(SeaDb* db, const SeaLlmCacheConfig* cfg) {
+    SeaLlmCache* c = calloc(1, sizeof(SeaLlmCache));
+    if (!c) return NULL;
+    c->ttl_sec   = (cfg && cfg->ttl_sec) ? cfg->ttl_sec : SEA_LLM_CACHE_TTL_SEC;
+    c->max_bytes = (cfg && cfg->max_bytes) ? cfg->max_bytes : SEA_LLM_CACHE_MAX_BYTES;
+    c->max_temperature = cfg ? cfg->max_temperature : 0.0;
+    pthread_mutex_init(&c->db_lock, NULL);
+    pthread_mutex_init(&c->flight_lock, NULL);
+
+    if (db) {
+        char* err = NULL;
+        if (sqlite3_exec(db->handle, SCHEMA, NULL, NULL, &err) != SQLITE_OK) {
+            SEA_LOG_WARN("CACHE", "Schema failed (%s); responses not stored",
+                         err ? err : "?");
+            sqlite3_free(err);
+        } else {
+            c->db = db;
+            u32 gone = sea_llm_cache_purge(c);
+            SEA_LOG_INFO("CACHE", "LLM cache: %llu entries, %llu KB (%u expired)",
+                         (unsigned long long)c->entries,
+                         (unsigned long long)(c->bytes / 1024), gone);
+        }
+    }
+    return c;
+}
+
+void sea_llm_cache_destroy(SeaLlmCache* cache) {
+    if (!cache) return;
+    pthread_mutex_destroy(&cache->flight_lock);
+    pthread_mutex_destroy(&cache->db_lock);
+    free(cache);
+}
+
+/* ── Flights ───────────────────────────────────────────────── */
+
+static Flight* find_flight(SeaLlmCache* c, const char* key, Flight*** link) {
+    Flight** pp = &c->flights;
+    for (; *pp; pp = &(*pp)->next) {
+        if (strcmp((*pp)->key, key) == 0) {
+            if (link) *link = pp;
+            return *pp;
+        }
+    }
+    return NULL;
+}
+
+static void free_flight(Flight* f) {
+    pthread_cond_destroy(&f->cond);
+    free(f->body);
+    free(f);
+}
+
+SeaCacheResult sea_llm_cache_begin(SeaLlmCache* cache, const SeaLlmCacheKey* key,
+                                   SeaArena* arena, SeaSlice* out) {
+    if (out) *out = (SeaSlice){ 0 };
+    if (!cache || !key || !key->hex[0] || !arena || !out) return SEA_CACHE_BYPASS;
+
+    if (key->cacheable && cache->db) {
+        pthread_mutex_lock(&cache->db_lock);
+        bool hit = lookup(cache, key->hex, arena, out);
+        pthread_mutex_unlock(&cache->db_lock);
+        if (hit) {
+            atomic_fetch_add_explicit(&cache->hits, 1, memory_order_relaxed);
+            return SEA_CACHE_HIT;
+        }
+    }
+
+    pthread_mutex_lock(&cache->flight_lock);
+    Flight* f = find_flight(cache, key->hex, NULL);
+    if (!f) {
+        f = calloc(1, sizeof(Flight));
+        if (!f) {
+            pthread_mutex_unlock(&cache->flight_lock);
+            return SEA_CACHE_BYPASS;
+        }
+        memcpy(f->key, key->hex, sizeof(f->key));
+        pthread_cond_init(&f->cond, NULL);
+        f->next = cache->flights;
+        cache->flights = f;
+        pthread_mutex_unlock(&cache->flight_lock);
+        atomic_fetch_add_explicit(&cache->misses, 1, memory_order_relaxed);
+        return SEA_CACHE_LEADER;
+    }
+
+    f->waiters++;
+    while (!f->done) pthread_cond_wait(&f->cond, &cache->flight_lock);
+    SeaCacheResult res = SEA_CACHE_BYPASS;
+    if (f->ok) {
+        u8* dst = (u8*)sea_arena_alloc(arena, (u64)f->len + 1, 1);
+        if (dst) {
+            if (f->len) memcpy(dst, f->body, f->len);
+            dst[f->len] = '\0';
+            *out = (SeaSlice){ .data = dst, .len = f->len };
+            res = SEA_CACHE_SHARED;
+        }
+    }
+    /* The flight left the list when it completed; last one out frees it */
+    if (--f->waiters == 0) free_flight(f);
+    pthread_mutex_unlock(&cache->flight_lock);
+
+    if (res == SEA_CACHE_SHARED)
+        atomic_fetch_add_explicit(&cache->shared, 1, memory_order_relaxed);
+    return res;
+}
+
+void sea_llm_cache_complete(SeaLlmCache* cache, const SeaLlmCacheKey* key,
+                            SeaSlice body, bool ok) {
+    if (!cache || !key || !key->hex[0]) return;
+
+    /* Store before the flight ends, so a request arriving after it
+     * finds the row instead of starting a second call. */
+    if (ok && key->cacheable && cache->db && body.len > 0 &&
+        body.len <= SEA_LLM_CACHE_ENTRY_MAX)
+        store(cache, key->hex, body);
+
+    pthread_mutex_lock(&cache->flight_lock);
+    Flight** link = NULL;
+    Flight* f = find_flight(cache, key->hex, &link);
+    if (!f) {
+        pthread_mutex_unlock(&cache->flight_lock);
+        return;
+    }
+    *link = f->next;
+    f->done = true;
+    f->ok = ok;
+    if (ok && f->waiters > 0) {
+        f->body = malloc(body.len ? body.len : 1);
+        if (f->body) {
+            if (body.len) memcpy(f->body, body.data, body.len);
+            f->len = body.len;
+        } else {
+            f->ok = false;
+        }
+    }
+    pthread_cond_broadcast(&f->cond);
+    if (f->waiters == 0) free_flight(f);
+    pthread_mutex_unlock(&cache->flight_lock);
+}
+
+void sea_llm_cache_stats(SeaLlmCache* cache, SeaLlmCacheStats* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!cache) return;
+    out->hits    = atomic_load_explicit(&cache->hits, memory_order_relaxed);
+    out->shared  = atomic_load_explicit(&cache->shared, memory_order_relaxed);
+    out->misses  = atomic_load_explicit(&cache->misses, memory_order_relaxed);
+    out->stored  = atomic_load_explicit(&cache->stored, memory_order_relaxed);
+    out->evicted = atomic_load_explicit(&cache->evicted, memory_order_relaxed);
+    pthread_mutex_lock(&cache->db_lock);
+    out->entries = cache->entries;
+    out->bytes   = cache->bytes;
+    pthread_mutex_unlock(&cache->db_lock);
+}
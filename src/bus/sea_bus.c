@@ -8,11 +8,31 @@
 
 #include "seaclaw/sea_bus.h"
 #include "seaclaw/sea_log.h"
+#include "seaclaw/sea_metrics.h"
 
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 
+/* ── Metrics ──────────────────────────────────────────────── */
+
+/* Process-wide series; every bus reports into the same ones */
+static SeaMetric* s_in_depth;
+static SeaMetric* s_out_depth;
+static SeaMetric* s_in_dropped;
+static SeaMetric* s_out_dropped;
+
+static void metrics_init(void) {
+    s_in_depth    = sea_metric_gauge("sea_bus_queue_depth", "Messages waiting in a bus queue",
+                                     "queue", "inbound");
+    s_out_depth   = sea_metric_gauge("sea_bus_queue_depth", "Messages waiting in a bus queue",
+                                     "queue", "outbound");
+    s_in_dropped  = sea_metric_counter("sea_bus_dropped_total", "Messages dropped on a full queue",
+                                       "queue", "inbound");
+    s_out_dropped = sea_metric_counter("sea_bus_dropped_total", "Messages dropped on a full queue",
+                                       "queue", "outbound");
+}
+
 /* ── Helpers ──────────────────────────────────────────────── */
 
 static u64 now_ms(void) {
@@ -58,7 +78,7 @@ SeaError sea_bus_init(SeaBus* bus, u64 arena_size) {
 
     memset(bus, 0, sizeof(SeaBus));
 
-    SeaError err = sea_arena_create(&bus->arena, arena_size);
+    SeaError err = sea_arena_create_named(&bus->arena, "bus", arena_size);
     if (err != SEA_OK) return err;
 
     pthread_mutex_init(&bus->in_mutex, NULL);
@@ -67,6 +87,7 @@ SeaError sea_bus_init(SeaBus* bus, u64 arena_size) {
     pthread_cond_init(&bus->out_cond, NULL);
 
     bus->running = true;
+    metrics_init();
 
     SEA_LOG_INFO("BUS", "Message bus initialized (arena: %llu bytes)", (unsigned long long)arena_size);
     return SEA_OK;
@@ -102,6 +123,7 @@ SeaError sea_bus_publish_inbound(SeaBus* bus, SeaMsgType type,
 
     if (bus->in_count >= SEA_BUS_QUEUE_SIZE) {
         pthread_mutex_unlock(&bus->in_mutex);
+        sea_metric_inc(s_in_dropped);
         SEA_LOG_WARN("BUS", "Inbound queue full, dropping message");
         return SEA_ERR_ARENA_FULL;
     }
@@ -118,6 +140,7 @@ SeaError sea_bus_publish_inbound(SeaBus* bus, SeaMsgType type,
 
     bus->in_tail = (bus->in_tail + 1) % SEA_BUS_QUEUE_SIZE;
     bus->in_count++;
+    sea_metric_set(s_in_depth, bus->in_count);
 
     pthread_cond_signal(&bus->in_cond);
     pthread_mutex_unlock(&bus->in_mutex);
@@ -165,6 +188,7 @@ SeaError sea_bus_consume_inbound(SeaBus* bus, SeaBusMsg* out, u32 timeout_ms) {
     *out = bus->inbound[bus->in_head];
     bus->in_head = (bus->in_head + 1) % SEA_BUS_QUEUE_SIZE;
     bus->in_count--;
+    sea_metric_set(s_in_depth, bus->in_count);
 
     pthread_mutex_unlock(&bus->in_mutex);
     return SEA_OK;
@@ -180,6 +204,7 @@ SeaError sea_bus_publish_outbound(SeaBus* bus, const char* channel,
 
     if (bus->out_count >= SEA_BUS_QUEUE_SIZE) {
         pthread_mutex_unlock(&bus->out_mutex);
+        sea_metric_inc(s_out_dropped);
         SEA_LOG_WARN("BUS", "Outbound queue full, dropping message");
         return SEA_ERR_ARENA_FULL;
     }
@@ -196,6 +221,7 @@ SeaError sea_bus_publish_outbound(SeaBus* bus, const char* channel,
 
     bus->out_tail = (bus->out_tail + 1) % SEA_BUS_QUEUE_SIZE;
     bus->out_count++;
+    sea_metric_set(s_out_depth, bus->out_count);
 
     pthread_cond_signal(&bus->out_cond);
     pthread_mutex_unlock(&bus->out_mutex);
@@ -220,6 +246,7 @@ SeaError sea_bus_consume_outbound(SeaBus* bus, SeaBusMsg* out) {
     *out = bus->outbound[bus->out_head];
     bus->out_head = (bus->out_head + 1) % SEA_BUS_QUEUE_SIZE;
     bus->out_count--;
+    sea_metric_set(s_out_depth, bus->out_count);
 
     pthread_mutex_unlock(&bus->out_mutex);
     return SEA_OK;
@@ -246,6 +273,7 @@ SeaError sea_bus_consume_outbound_for(SeaBus* bus, const char* channel, SeaBusMs
                 bus->outbound[dst_idx] = bus->outbound[src];
             }
             bus->out_count--;
+            sea_metric_set(s_out_depth, bus->out_count);
             if (bus->out_count == 0) {
                 bus->out_head = 0;
                 bus->out_tail = 0;
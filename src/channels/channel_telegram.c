@@ -85,7 +85,7 @@ static SeaError tg_init(SeaChannel* ch, SeaBus* bus, SeaArena* arena) {
     s_tg_channel = ch;
 
     /* Create per-poll arena */
-    SeaError err = sea_arena_create(&data->poll_arena, 512 * 1024); /* 512KB */
+    SeaError err = sea_arena_create_named(&data->poll_arena, "telegram.poll", 512 * 1024); /* 512KB */
     if (err != SEA_OK) return err;
 
     /* Initialize the underlying Telegram bot */
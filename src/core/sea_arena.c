@@ -2,37 +2,214 @@
  * sea_arena.c — Arena allocator implementation
  *
  * The Memory Notebook: one mmap'd block, bump pointer, instant reset.
+ * Growable arenas chain more blocks; offsets run on across them, each
+ * segment starting where the previous one ends. Scratch arenas live in
+ * thread-local storage; a pthread key destructor unmaps them.
+ * Named arenas are listed in a small mutex-guarded table; only create,
+ * destroy and the readers take the lock, never the allocation path.
  */
 
+#define SEA_ARENA_IMPL
 #include "seaclaw/sea_arena.h"
 #include <sys/mman.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-SeaError sea_arena_create(SeaArena* arena, u64 size) {
-    if (!arena || size == 0) return SEA_ERR_OOM;
+#define PAGE_SIZE_4K    4096ULL
+#define HUGE_PAGE_SIZE  (2ULL * 1024 * 1024)
+#define ARENA_LISTED    (1u << 31)      /* Private flag: in the registry */
+
+struct SeaArenaSeg {
+    SeaArenaSeg* next;
+    u8*          data;
+    u64          start;     /* Arena offset of data[0] */
+    u64          cap;
+    bool         hugetlb;
+};
+
+static u64 round_up(u64 v, u64 to) {
+    return (v + to - 1) & ~(to - 1);
+}
+
+/* Map `*size` bytes, rounded up to the page size actually used. */
+static u8* map_pages(u64* size, u32 flags, bool* hugetlb) {
+    *hugetlb = false;
+    bool huge = (flags & SEA_ARENA_HUGE) && *size >= HUGE_PAGE_SIZE;
+#ifdef MAP_HUGETLB
+    if (huge) {
+        u64 len = round_up(*size, HUGE_PAGE_SIZE);
+        void* p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            *size = len;
+            *hugetlb = true;
+            return (u8*)p;
+        }
+        /* No reserved huge pages: fall back to a THP hint */
+    }
+#endif
+    void* p = mmap(NULL, *size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+    if (huge) madvise(p, *size, MADV_HUGEPAGE);
+#else
+    (void)huge;
+#endif
+    return (u8*)p;
+}
+
+/* Drop pages in [from, to) of a mapping, rounded inward to pages. */
+static void drop_pages(u8* data, u64 cap, u64 from, u64 to, bool hugetlb) {
+    u64 page = hugetlb ? HUGE_PAGE_SIZE : PAGE_SIZE_4K;
+    from = round_up(from, page);
+    if (to > cap) to = cap;
+    if (to < cap) to &= ~(page - 1);
+    if (to > from) madvise(data + from, to - from, MADV_DONTNEED);
+}
 
-    void* base = mmap(NULL, size,
-                      PROT_READ | PROT_WRITE,
-                      MAP_PRIVATE | MAP_ANONYMOUS,
-                      -1, 0);
+static void use_seg(SeaArena* arena, SeaArenaSeg* seg) {
+    arena->cur       = seg;
+    arena->base      = seg->data;
+    arena->seg_start = seg->start;
+    arena->seg_end   = seg->start + seg->cap;
+}
 
-    if (base == MAP_FAILED) return SEA_ERR_OOM;
+static void free_chain(SeaArenaSeg* seg) {
+    while (seg) {
+        SeaArenaSeg* next = seg->next;
+        munmap(seg->data, seg->cap);
+        free(seg);
+        seg = next;
+    }
+}
+
+/* ── Registry ─────────────────────────────────────────────── */
+
+typedef struct {
+    SeaArena* arena;
+    char      name[SEA_ARENA_NAME_MAX];
+} RegSlot;
+
+static pthread_mutex_t s_reg_lock = PTHREAD_MUTEX_INITIALIZER;
+static RegSlot         s_reg[SEA_ARENA_REGISTRY_MAX];
+
+static void reg_add(SeaArena* arena, const char* name) {
+    pthread_mutex_lock(&s_reg_lock);
+    for (u32 i = 0; i < SEA_ARENA_REGISTRY_MAX; i++) {
+        if (s_reg[i].arena) continue;
+        s_reg[i].arena = arena;
+        snprintf(s_reg[i].name, sizeof(s_reg[i].name), "%s", name);
+        arena->flags |= ARENA_LISTED;
+        break;
+    }
+    /* Table full: the arena works, it just goes unreported */
+    pthread_mutex_unlock(&s_reg_lock);
+}
+
+static void reg_remove(SeaArena* arena) {
+    pthread_mutex_lock(&s_reg_lock);
+    for (u32 i = 0; i < SEA_ARENA_REGISTRY_MAX; i++) {
+        if (s_reg[i].arena == arena) { s_reg[i].arena = NULL; break; }
+    }
+    pthread_mutex_unlock(&s_reg_lock);
+}
+
+static SeaArenaSeg* new_seg(u64 start, u64 cap, u32 flags) {
+    SeaArenaSeg* seg = calloc(1, sizeof(SeaArenaSeg));
+    if (!seg) return NULL;
+    seg->cap = round_up(cap, PAGE_SIZE_4K);
+    seg->data = map_pages(&seg->cap, flags, &seg->hugetlb);
+    if (!seg->data) { free(seg); return NULL; }
+    seg->start = start;
+    return seg;
+}
 
-    arena->base       = (u8*)base;
-    arena->size       = size;
-    arena->offset     = 0;
-    arena->high_water = 0;
+SeaError sea_arena_create_ex(SeaArena* arena, const SeaArenaConfig* cfg) {
+    if (!arena || !cfg || cfg->size == 0) return SEA_ERR_OOM;
+    memset(arena, 0, sizeof(*arena));
+    arena->flags  = cfg->flags;
+    arena->retain = cfg->retain;
+    arena->max    = cfg->max;
 
+    if (cfg->flags & SEA_ARENA_GROW) {
+        SeaArenaSeg* seg = new_seg(0, cfg->size, cfg->flags);
+        if (!seg) return SEA_ERR_OOM;
+        arena->segs = seg;
+        arena->size = seg->cap;
+        use_seg(arena, seg);
+        if (cfg->name) reg_add(arena, cfg->name);
+        return SEA_OK;
+    }
+
+    u64 size = cfg->size;
+    bool hugetlb;
+    u8* base = map_pages(&size, cfg->flags, &hugetlb);
+    if (!base) return SEA_ERR_OOM;
+    arena->base    = base;
+    arena->size    = size;
+    arena->seg_end = size;
+    if (hugetlb && arena->retain) arena->retain = round_up(arena->retain, HUGE_PAGE_SIZE);
+    if (cfg->name) reg_add(arena, cfg->name);
     return SEA_OK;
 }
 
+SeaError sea_arena_create(SeaArena* arena, u64 size) {
+    SeaArenaConfig cfg = { .size = size };
+    return sea_arena_create_ex(arena, &cfg);
+}
+
+SeaError sea_arena_create_named(SeaArena* arena, const char* name, u64 size) {
+    SeaArenaConfig cfg = { .size = size, .name = name };
+    return sea_arena_create_ex(arena, &cfg);
+}
+
 void sea_arena_destroy(SeaArena* arena) {
     if (!arena || !arena->base) return;
-    munmap(arena->base, arena->size);
-    arena->base       = NULL;
-    arena->size       = 0;
-    arena->offset     = 0;
-    arena->high_water = 0;
+    if (arena->flags & ARENA_LISTED) reg_remove(arena);
+    if (arena->segs) free_chain(arena->segs);
+    else munmap(arena->base, arena->size);
+    memset(arena, 0, sizeof(*arena));
+}
+
+/* Slow path of a growable arena: find or make a segment that holds
+ * `size` bytes at `*aligned`. False at the growth ceiling. */
+static bool seg_select(SeaArena* arena, u64* aligned, u64 size, u64 align) {
+    /* An earlier offset was restored: step back to its segment */
+    if (*aligned < arena->seg_start) {
+        SeaArenaSeg* seg = arena->segs;
+        while (seg->next && *aligned >= seg->start + seg->cap) seg = seg->next;
+        use_seg(arena, seg);
+        if (*aligned + size <= arena->seg_end) return true;
+    }
+
+    /* Move on to the next segment, reusing it if it is big enough */
+    SeaArenaSeg* cur = arena->cur;
+    u64 need = size + align;
+    if (cur->next && cur->next->cap >= need) {
+        use_seg(arena, cur->next);
+        *aligned = round_up(arena->seg_start, align);
+        return true;
+    }
+    free_chain(cur->next);
+    cur->next = NULL;
+    arena->size = cur->start + cur->cap;
+
+    /* Double each time, bounded by the ceiling */
+    u64 cap = cur->cap * 2 > need ? cur->cap * 2 : need;
+    if (arena->max && arena->size + cap > arena->max) {
+        if (arena->size + need > arena->max) return false;
+        cap = arena->max - arena->size;
+    }
+    SeaArenaSeg* seg = new_seg(arena->size, cap, arena->flags);
+    if (!seg) return false;
+    cur->next = seg;
+    arena->size += seg->cap;
+    use_seg(arena, seg);
+    *aligned = round_up(arena->seg_start, align);
+    return true;
 }
 
 void* sea_arena_alloc(SeaArena* arena, u64 size, u64 align) {
@@ -41,19 +218,47 @@ void* sea_arena_alloc(SeaArena* arena, u64 size, u64 align) {
     /* Align the current offset */
     u64 aligned = (arena->offset + (align - 1)) & ~(align - 1);
 
-    if (aligned + size > arena->size) return NULL;  /* Arena full */
+    if (aligned + size > arena->seg_end || aligned < arena->seg_start) {
+        if (!arena->segs || !seg_select(arena, &aligned, size, align)) {
+            arena->failed++;                            /* Arena full */
+            return NULL;
+        }
+    }
 
-    void* ptr = arena->base + aligned;
-    arena->offset = aligned + size;
+    void* ptr = arena->base + (aligned - arena->seg_start);
+    u64 end = aligned + size;
+    arena->offset = end;
 
-    /* Track peak usage */
-    if (arena->offset > arena->high_water) {
-        arena->high_water = arena->offset;
+    /* Track peak usage (touched <= high_water, so one test usually) */
+    if (end > arena->touched) {
+        arena->touched = end;
+        if (end > arena->high_water) arena->high_water = end;
     }
 
     return ptr;
 }
 
+void sea_arena_release(SeaArena* arena) {
+    if (!arena || !arena->base || !arena->retain) return;
+    u64 keep = arena->retain, peak = arena->touched;
+    arena->touched = 0;
+    if (peak <= keep) return;
+
+    if (!arena->segs) {
+        drop_pages(arena->base, arena->size, keep, peak, false);
+        return;
+    }
+
+    /* Unmap segments wholly above the watermark, trim the one it falls in */
+    SeaArenaSeg* seg = arena->segs;
+    while (seg->next && seg->next->start < keep) seg = seg->next;
+    free_chain(seg->next);
+    seg->next = NULL;
+    arena->size = seg->start + seg->cap;
+    drop_pages(seg->data, seg->cap, keep - seg->start, peak - seg->start, seg->hugetlb);
+    use_seg(arena, arena->segs);
+}
+
 SeaSlice sea_arena_push_cstr(SeaArena* arena, const char* cstr) {
     if (!cstr) return SEA_SLICE_EMPTY;
 
@@ -78,3 +283,197 @@ void* sea_arena_push_bytes(SeaArena* arena, const void* data, u64 len) {
     memcpy(dst, data, len);
     return dst;
 }
+
+/* ── Scratch ──────────────────────────────────────────────── */
+
+static _Thread_local SeaArena t_scratch[SEA_SCRATCH_COUNT];
+static pthread_key_t  s_scratch_key;
+static pthread_once_t s_scratch_once = PTHREAD_ONCE_INIT;
+
+static void scratch_free(void* set) {
+    for (u32 i = 0; i < SEA_SCRATCH_COUNT; i++)
+        sea_arena_destroy(&((SeaArena*)set)[i]);
+}
+
+static void scratch_key_init(void) {
+    pthread_key_create(&s_scratch_key, scratch_free);
+}
+
+SeaScratch sea_scratch_begin(const SeaArena* conflict) {
+    for (u32 i = 0; i < SEA_SCRATCH_COUNT; i++) {
+        SeaArena* arena = &t_scratch[i];
+        if (arena == conflict) continue;
+        if (!arena->base) {
+            SeaArenaConfig cfg = {
+                .size   = SEA_SCRATCH_SIZE,
+                .max    = SEA_SCRATCH_MAX,
+                .retain = SEA_SCRATCH_RETAIN,
+                .flags  = SEA_ARENA_GROW,
+            };
+            cfg.name = "scratch";
+            if (sea_arena_create_ex(arena, &cfg) != SEA_OK) break;
+            pthread_once(&s_scratch_once, scratch_key_init);
+            pthread_setspecific(s_scratch_key, t_scratch);
+        }
+        return (SeaScratch){ .arena = arena, .mark = sea_arena_mark(arena) };
+    }
+    return (SeaScratch){ .arena = NULL };
+}
+
+void sea_scratch_end(SeaScratch scratch) {
+    if (!scratch.arena) return;
+    /* The outermost user resets, which releases pages past the retain mark */
+    if (scratch.mark.offset == 0) sea_arena_reset(scratch.arena);
+    else sea_arena_rewind(scratch.arena, scratch.mark);
+}
+
+/* ── Reporting ────────────────────────────────────────────── */
+
+u32 sea_arena_stats(SeaArenaStats* out, u32 max) {
+    if (!out || max == 0) return 0;
+    u32 n = 0;
+    pthread_mutex_lock(&s_reg_lock);
+    for (u32 i = 0; i < SEA_ARENA_REGISTRY_MAX; i++) {
+        const SeaArena* a = s_reg[i].arena;
+        if (!a) continue;
+        SeaArenaStats* st = NULL;
+        for (u32 j = 0; j < n; j++) {
+            if (strcmp(out[j].name, s_reg[i].name) == 0) { st = &out[j]; break; }
+        }
+        if (!st) {
+            if (n == max) continue;
+            st = &out[n++];
+            memset(st, 0, sizeof(*st));
+            memcpy(st->name, s_reg[i].name, sizeof(st->name));
+        }
+        st->instances++;
+        st->used     += a->offset;
+        st->capacity += a->size;
+        st->resets   += a->resets;
+        st->failed   += a->failed;
+        if (a->high_water > st->high_water) st->high_water = a->high_water;
+    }
+    pthread_mutex_unlock(&s_reg_lock);
+    return n;
+}
+
+static const char* fmt_bytes(char* buf, size_t cap, u64 v) {
+    if (v >= 1024ULL * 1024 * 1024) snprintf(buf, cap, "%.1fG", (double)v / (1024.0 * 1024 * 1024));
+    else if (v >= 1024 * 1024)      snprintf(buf, cap, "%.1fM", (double)v / (1024.0 * 1024));
+    else if (v >= 1024)             snprintf(buf, cap, "%.1fK", (double)v / 1024.0);
+    else                            snprintf(buf, cap, "%lluB", (unsigned long long)v);
+    return buf;
+}
+
+#define REPORT_SITES 10
+
+u32 sea_arena_report(char* buf, u32 cap) {
+    if (!buf || cap == 0) return 0;
+    SeaArenaStats st[SEA_ARENA_REGISTRY_MAX];
+    u32 n = sea_arena_stats(st, SEA_ARENA_REGISTRY_MAX);
+
+    size_t pos = 0;
+#define EMIT(...) do { \
+        if (pos < cap) { \
+            int w_ = snprintf(buf + pos, cap - pos, __VA_ARGS__); \
+            if (w_ > 0) pos += (size_t)w_; \
+        } \
+    } while (0)
+
+    EMIT("%-16s %3s %8s %8s %8s %8s %6s\n",
+         "Arena", "n", "used", "peak", "mapped", "resets", "failed");
+    for (u32 i = 0; i < n; i++) {
+        char u[16], h[16], c[16];
+        EMIT("%-16s %3u %8s %8s %8s %8llu %6llu\n", st[i].name, st[i].instances,
+             fmt_bytes(u, sizeof(u), st[i].used),
+             fmt_bytes(h, sizeof(h), st[i].high_water),
+             fmt_bytes(c, sizeof(c), st[i].capacity),
+             (unsigned long long)st[i].resets, (unsigned long long)st[i].failed);
+    }
+
+    SeaArenaSite sites[REPORT_SITES];
+    u32 ns = sea_arena_sites(sites, REPORT_SITES);
+    if (ns > 0) EMIT("Top call sites:\n");
+    for (u32 i = 0; i < ns; i++) {
+        char b[16];
+        EMIT("  %8s %10llu  %s:%u\n", fmt_bytes(b, sizeof(b), sites[i].bytes),
+             (unsigned long long)sites[i].calls, sites[i].file, sites[i].line);
+    }
+#undef EMIT
+
+    if (pos >= cap) pos = cap - 1;              /* Truncated */
+    return (u32)pos;
+}
+
+/* ── Call sites ───────────────────────────────────────────── */
+
+#ifdef SEA_ARENA_SITES
+
+static pthread_mutex_t s_site_lock = PTHREAD_MUTEX_INITIALIZER;
+static SeaArenaSite    s_sites[SEA_ARENA_SITES_MAX];
+
+/* __FILE__ literals are unique per translation unit, so the pointer
+ * and line identify a site without comparing strings. */
+static void site_charge(const char* file, u32 line, u64 bytes) {
+    u64 h = ((u64)(uintptr_t)file * 31 + line) * 0x9E3779B97F4A7C15ULL;
+    pthread_mutex_lock(&s_site_lock);
+    for (u32 n = 0; n < SEA_ARENA_SITES_MAX; n++) {
+        SeaArenaSite* s = &s_sites[(h >> 32) % SEA_ARENA_SITES_MAX];
+        h += 0x100000000ULL;
+        if (!s->file) { s->file = file; s->line = line; }
+        else if (s->file != file || s->line != line) continue;
+        s->calls++;
+        s->bytes += bytes;
+        break;
+    }
+    pthread_mutex_unlock(&s_site_lock);
+}
+
+void* sea_arena_alloc_at(SeaArena* arena, u64 size, u64 align, const char* file, u32 line) {
+    void* p = sea_arena_alloc(arena, size, align);
+    if (p) site_charge(file, line, size);
+    return p;
+}
+
+SeaSlice sea_arena_push_cstr_at(SeaArena* arena, const char* cstr, const char* file, u32 line) {
+    SeaSlice s = sea_arena_push_cstr(arena, cstr);
+    if (s.data) site_charge(file, line, (u64)s.len + 1);
+    return s;
+}
+
+void* sea_arena_push_bytes_at(SeaArena* arena, const void* data, u64 len,
+                              const char* file, u32 line) {
+    void* p = sea_arena_push_bytes(arena, data, len);
+    if (p) site_charge(file, line, len);
+    return p;
+}
+
+static int site_cmp(const void* a, const void* b) {
+    u64 x = ((const SeaArenaSite*)a)->bytes, y = ((const SeaArenaSite*)b)->bytes;
+    return x < y ? 1 : x > y ? -1 : 0;
+}
+
+u32 sea_arena_sites(SeaArenaSite* out, u32 max) {
+    if (!out || max == 0) return 0;
+    SeaArenaSite* all = malloc(sizeof(s_sites));
+    if (!all) return 0;
+    u32 n = 0;
+    pthread_mutex_lock(&s_site_lock);
+    for (u32 i = 0; i < SEA_ARENA_SITES_MAX; i++)
+        if (s_sites[i].file) all[n++] = s_sites[i];
+    pthread_mutex_unlock(&s_site_lock);
+    qsort(all, n, sizeof(*all), site_cmp);
+    if (n > max) n = max;
+    memcpy(out, all, n * sizeof(*out));
+    free(all);
+    return n;
+}
+
+#else
+
+u32 sea_arena_sites(SeaArenaSite* out, u32 max) {
+    (void)out; (void)max;
+    return 0;
+}
+
+#endif /* SEA_ARENA_SITES */
@@ -19,7 +19,13 @@ void sea_config_defaults(SeaConfig* cfg) {
     if (!cfg) return;
     if (!cfg->db_path)          cfg->db_path = "seaclaw.db";
     if (!cfg->log_level)        cfg->log_level = "info";
+    if (!cfg->log_overflow)     cfg->log_overflow = "drop";
+    if (!cfg->trace)            cfg->trace = "all";
     if (cfg->arena_size_mb == 0) cfg->arena_size_mb = 16;
+    if (cfg->audit_retain_days == 0) cfg->audit_retain_days = 30;
+    if (cfg->audit_retain_rows == 0) cfg->audit_retain_rows = 100000;
+    if (cfg->llm_cache_ttl_sec == 0) cfg->llm_cache_ttl_sec = 3600;
+    if (cfg->llm_cache_max_mb == 0)  cfg->llm_cache_max_mb = 64;
 }
 
 /* ── Load ─────────────────────────────────────────────────── */
@@ -93,11 +99,26 @@ SeaError sea_config_load(SeaConfig* cfg, const char* path, SeaArena* arena) {
     SLICE_TO_CSTR(sv);
     if (_dst) cfg->db_path = _dst;
 
+    cfg->audit_retain_days = (u32)sea_json_get_number(&root, "audit_retain_days", 0.0);
+    cfg->audit_retain_rows = (u32)sea_json_get_number(&root, "audit_retain_rows", 0.0);
+
     _dst = NULL;
     sv = sea_json_get_string(&root, "log_level");
     SLICE_TO_CSTR(sv);
     if (_dst) cfg->log_level = _dst;
 
+    _dst = NULL;
+    sv = sea_json_get_string(&root, "log_overflow");
+    SLICE_TO_CSTR(sv);
+    if (_dst) cfg->log_overflow = _dst;
+
+    cfg->metrics_port = (u32)sea_json_get_number(&root, "metrics_port", 0.0);
+
+    _dst = NULL;
+    sv = sea_json_get_string(&root, "trace");
+    SLICE_TO_CSTR(sv);
+    if (_dst) cfg->trace = _dst;
+
     cfg->arena_size_mb = (u32)sea_json_get_number(&root, "arena_size_mb", 0.0);
 
     _dst = NULL;
@@ -120,6 +141,24 @@ SeaError sea_config_load(SeaConfig* cfg, const char* path, SeaArena* arena) {
     SLICE_TO_CSTR(sv);
     if (_dst) cfg->llm_api_url = _dst;
 
+    _dst = NULL;
+    sv = sea_json_get_string(&root, "a2a_discovery_url");
+    SLICE_TO_CSTR(sv);
+    if (_dst) cfg->a2a_discovery_url = _dst;
+
+    _dst = NULL;
+    sv = sea_json_get_string(&root, "mesh_secret");
+    SLICE_TO_CSTR(sv);
+    if (_dst) cfg->mesh_secret = _dst;
+
+    _dst = NULL;
+    sv = sea_json_get_string(&root, "mesh_allowed_subnet");
+    SLICE_TO_CSTR(sv);
+    if (_dst) cfg->mesh_allowed_subnet = _dst;
+
+    cfg->llm_cache_ttl_sec = (u32)sea_json_get_number(&root, "llm_cache_ttl_sec", 0.0);
+    cfg->llm_cache_max_mb  = (u32)sea_json_get_number(&root, "llm_cache_max_mb", 0.0);
+
     /* Parse fallback providers array */
     cfg->llm_fallback_count = 0;
     const SeaJsonValue* fallbacks = sea_json_get(&root, "llm_fallbacks");
@@ -172,11 +211,22 @@ void sea_config_print(const SeaConfig* cfg) {
     printf("    telegram_token:   %s\n", cfg->telegram_token ? "***set***" : "(not set)");
     printf("    telegram_chat_id: %lld\n", (long long)cfg->telegram_chat_id);
     printf("    db_path:          %s\n", cfg->db_path ? cfg->db_path : "(default)");
+    printf("    audit retention:  %u days, %u rows\n", cfg->audit_retain_days, cfg->audit_retain_rows);
     printf("    log_level:        %s\n", cfg->log_level ? cfg->log_level : "info");
+    printf("    log_overflow:     %s\n", cfg->log_overflow ? cfg->log_overflow : "drop");
+    if (cfg->metrics_port)
+        printf("    metrics_port:     %u\n", cfg->metrics_port);
+    else
+        printf("    metrics_port:     (off)\n");
+    printf("    trace:            %s\n", cfg->trace ? cfg->trace : "all");
     printf("    arena_size_mb:    %u\n", cfg->arena_size_mb);
     printf("    llm_provider:     %s\n", cfg->llm_provider ? cfg->llm_provider : "(not set)");
     printf("    llm_api_key:      %s\n", cfg->llm_api_key ? "***set***" : "(not set)");
     printf("    llm_model:        %s\n", cfg->llm_model ? cfg->llm_model : "(default)");
     printf("    llm_api_url:      %s\n", cfg->llm_api_url ? cfg->llm_api_url : "(default)");
+    printf("    a2a_discovery:    %s\n", cfg->a2a_discovery_url ? cfg->a2a_discovery_url : "(none)");
+    printf("    llm_cache:        %u s TTL, %u MB\n", cfg->llm_cache_ttl_sec, cfg->llm_cache_max_mb);
+    printf("    mesh_secret:      %s\n", cfg->mesh_secret ? "***set***" : "(not set)");
+    printf("    mesh_subnet:      %s\n", cfg->mesh_allowed_subnet ? cfg->mesh_allowed_subnet : "(any)");
     printf("\n");
 }
@@ -3,13 +3,25 @@
  *
  * Single-file persistent storage for the agent.
  * All strings returned via arena allocation.
+ *
+ * Audit rows (trajectory, cron_log) can be handed to a writer thread:
+ * producers copy the record into a bounded MPMC ring (per-slot sequence
+ * numbers, one CAS per push) and the writer commits them in batches on
+ * a second connection, so tool calls never wait on an fsync.
  */
 
 #include "seaclaw/sea_db.h"
 #include "seaclaw/sea_log.h"
+#include "seaclaw/sea_metrics.h"
 #include <sqlite3.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 /* Copy a C string into arena, returning a const char* (null-terminated). */
 static const char* arena_strdup(SeaArena* arena, const char* s) {
@@ -21,8 +33,52 @@ static const char* arena_strdup(SeaArena* arena, const char* s) {
     return p;
 }
 
+/* ── Audit ring ───────────────────────────────────────────── */
+
+enum { AUDIT_EVENT = 1, AUDIT_CRON = 2 };
+
+/* Up to three strings packed back to back in text[]. seq == pos + 1
+ * when the slot holds record `pos`; the consumer hands it back to the
+ * producers as pos + capacity. */
+typedef struct {
+    _Atomic u64 seq;
+    u8          kind;
+    i32         job_id;
+    u64         at;            /* Unix seconds */
+    u64         duration_ms;
+    u16         len[3];
+    char        text[SEA_DB_AUDIT_TEXT];
+} AuditSlot;
+
+typedef struct {
+    AuditSlot*       slots;
+    u64              mask;
+    SeaDbAuditConfig cfg;
+
+    _Alignas(64) _Atomic u64 tail;     /* Next position to claim        */
+    _Alignas(64) u64         head;     /* Writer thread only            */
+    _Atomic u64              done;     /* Positions committed or failed */
+    _Atomic u64              queued;
+    _Atomic u64              written;
+    _Atomic u64              dropped;
+    _Atomic u64              batches;
+    _Atomic u64              pruned;
+    _Atomic u32              waiters;
+    _Atomic bool             stop;
+
+    int              wake_fd;          /* eventfd                       */
+    sqlite3*         conn;             /* Writer connection             */
+    bool             own_conn;
+    sqlite3_stmt*    ins_event;
+    sqlite3_stmt*    ins_cron;
+    pthread_t        thread;
+    pthread_mutex_t  lock;             /* Guards flush waiters only     */
+    pthread_cond_t   flushed;
+} SeaDbAudit;
+
 struct SeaDb {
-    sqlite3* handle;
+    sqlite3*    handle;
+    SeaDbAudit* audit;                 /* NULL = synchronous writes     */
 };
 
 /* ── Schema ───────────────────────────────────────────────── */
@@ -56,16 +112,94 @@ static const char* SCHEMA_SQL =
     "  content  TEXT NOT NULL,"
     "  created_at DATETIME DEFAULT (datetime('now'))"
     ");"
+    "CREATE TABLE IF NOT EXISTS cron_log ("
+    "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  job_id INTEGER NOT NULL,"
+    "  job_name TEXT,"
+    "  status TEXT NOT NULL,"
+    "  output TEXT,"
+    "  executed_at INTEGER NOT NULL,"
+    "  duration_ms INTEGER DEFAULT 0"
+    ");"
     "CREATE INDEX IF NOT EXISTS idx_tasks_status ON tasks(status);"
     "CREATE INDEX IF NOT EXISTS idx_chat_history_chat ON chat_history(chat_id);"
-    "CREATE INDEX IF NOT EXISTS idx_trajectory_type ON trajectory(entry_type);";
+    "CREATE INDEX IF NOT EXISTS idx_trajectory_type ON trajectory(entry_type);"
+    "CREATE INDEX IF NOT EXISTS idx_trajectory_created ON trajectory(created_at);"
+    "CREATE INDEX IF NOT EXISTS idx_cron_log_executed ON cron_log(executed_at);"
+    /* SeaZero (v3): agents, delegated tasks, LLM usage, audit trail */
+    "CREATE TABLE IF NOT EXISTS seazero_agents ("
+    "  id         INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  agent_id   TEXT NOT NULL UNIQUE,"
+    "  status     TEXT NOT NULL DEFAULT 'stopped',"
+    "  container  TEXT,"
+    "  port       INTEGER,"
+    "  provider   TEXT,"
+    "  model      TEXT,"
+    "  created_at DATETIME DEFAULT (datetime('now')),"
+    "  last_seen  DATETIME DEFAULT (datetime('now'))"
+    ");"
+    "CREATE TABLE IF NOT EXISTS seazero_tasks ("
+    "  id           INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  task_id      TEXT NOT NULL UNIQUE,"
+    "  agent_id     TEXT NOT NULL,"
+    "  chat_id      INTEGER,"
+    "  status       TEXT NOT NULL DEFAULT 'pending',"
+    "  task_text    TEXT NOT NULL,"
+    "  context      TEXT,"
+    "  result       TEXT,"
+    "  error        TEXT,"
+    "  steps_taken  INTEGER DEFAULT 0,"
+    "  files        TEXT,"
+    "  created_at   DATETIME DEFAULT (datetime('now')),"
+    "  started_at   DATETIME,"
+    "  completed_at DATETIME,"
+    "  elapsed_sec  REAL DEFAULT 0"
+    ");"
+    "CREATE TABLE IF NOT EXISTS seazero_llm_usage ("
+    "  id         INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  caller     TEXT NOT NULL,"
+    "  provider   TEXT NOT NULL,"
+    "  model      TEXT NOT NULL,"
+    "  tokens_in  INTEGER DEFAULT 0,"
+    "  tokens_out INTEGER DEFAULT 0,"
+    "  cost_usd   REAL DEFAULT 0,"
+    "  latency_ms INTEGER DEFAULT 0,"
+    "  status     TEXT DEFAULT 'ok',"
+    "  task_id    TEXT,"
+    "  created_at DATETIME DEFAULT (datetime('now'))"
+    ");"
+    "CREATE TABLE IF NOT EXISTS seazero_audit ("
+    "  id         INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  event_type TEXT NOT NULL,"
+    "  source     TEXT NOT NULL,"
+    "  target     TEXT,"
+    "  detail     TEXT,"
+    "  severity   TEXT DEFAULT 'info',"
+    "  created_at DATETIME DEFAULT (datetime('now'))"
+    ");"
+    "CREATE INDEX IF NOT EXISTS idx_sz_tasks_status ON seazero_tasks(status);"
+    "CREATE INDEX IF NOT EXISTS idx_sz_tasks_agent ON seazero_tasks(agent_id);"
+    "CREATE INDEX IF NOT EXISTS idx_sz_llm_caller ON seazero_llm_usage(caller, created_at);"
+    "CREATE INDEX IF NOT EXISTS idx_sz_audit_type ON seazero_audit(event_type);";
+
+/* ── Statement timing ─────────────────────────────────────── */
+
+static SeaMetric* s_stmt_time;
+
+/* SQLITE_TRACE_PROFILE: x is the statement's run time in nanoseconds */
+static int profile_cb(unsigned type, void* ctx, void* stmt, void* x) {
+    (void)ctx; (void)stmt;
+    if (type == SQLITE_TRACE_PROFILE)
+        sea_metric_observe(s_stmt_time, (f64)*(sqlite3_int64*)x / 1e9);
+    return 0;
+}
 
 /* ── Lifecycle ────────────────────────────────────────────── */
 
 SeaError sea_db_open(SeaDb** db, const char* path) {
     if (!db || !path) return SEA_ERR_CONFIG;
 
-    *db = malloc(sizeof(SeaDb));
+    *db = calloc(1, sizeof(SeaDb));
     if (!*db) return SEA_ERR_OOM;
 
     int rc = sqlite3_open(path, &(*db)->handle);
@@ -80,6 +214,11 @@ SeaError sea_db_open(SeaDb** db, const char* path) {
     sqlite3_exec((*db)->handle, "PRAGMA journal_mode=WAL;", NULL, NULL, NULL);
     sqlite3_exec((*db)->handle, "PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
     sqlite3_exec((*db)->handle, "PRAGMA foreign_keys=ON;", NULL, NULL, NULL);
+    sqlite3_busy_timeout((*db)->handle, 5000);   /* Audit writer holds short write locks */
+
+    s_stmt_time = sea_metric_histogram("sea_db_statement_seconds", "SQLite statement run time",
+                                       NULL, NULL, &SEA_METRICS_FAST);
+    sqlite3_trace_v2((*db)->handle, SQLITE_TRACE_PROFILE, profile_cb, NULL);
 
     /* Create schema */
     char* errmsg = NULL;
@@ -97,8 +236,11 @@ SeaError sea_db_open(SeaDb** db, const char* path) {
     return SEA_OK;
 }
 
+static void audit_stop(SeaDb* db);
+
 void sea_db_close(SeaDb* db) {
     if (!db) return;
+    audit_stop(db);
     if (db->handle) {
         sqlite3_close(db->handle);
         SEA_LOG_INFO("DB", "Database closed.");
@@ -106,12 +248,38 @@ void sea_db_close(SeaDb* db) {
     free(db);
 }
 
+sqlite3* sea_db_handle(SeaDb* db) {
+    return db ? db->handle : NULL;
+}
+
+sqlite3* sea_db_connect(SeaDb* db) {
+    if (!db) return NULL;
+    const char* file = sqlite3_db_filename(db->handle, "main");
+    if (!file || !file[0]) return NULL;
+    sqlite3* conn = NULL;
+    if (sqlite3_open_v2(file, &conn, SQLITE_OPEN_READWRITE, NULL) != SQLITE_OK) {
+        sqlite3_close(conn);
+        return NULL;
+    }
+    sqlite3_busy_timeout(conn, 5000);
+    sqlite3_exec(conn, "PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
+    return conn;
+}
+
 /* ── Trajectory ───────────────────────────────────────────── */
 
+static bool audit_push(SeaDbAudit* a, u8 kind, i32 job_id, u64 at, u64 duration_ms,
+                       const char* s0, const char* s1, const char* s2);
+
 SeaError sea_db_log_event(SeaDb* db, const char* entry_type,
                           const char* title, const char* content) {
     if (!db || !entry_type || !title || !content) return SEA_ERR_IO;
 
+    if (db->audit) {
+        return audit_push(db->audit, AUDIT_EVENT, 0, (u64)time(NULL), 0,
+                          entry_type, title, content) ? SEA_OK : SEA_ERR_ARENA_FULL;
+    }
+
     sqlite3_stmt* stmt;
     const char* sql = "INSERT INTO trajectory (entry_type, title, content) VALUES (?, ?, ?)";
 
@@ -133,9 +301,43 @@ SeaError sea_db_log_event(SeaDb* db, const char* entry_type,
     return SEA_OK;
 }
 
+SeaError sea_db_log_cron(SeaDb* db, i32 job_id, const char* job_name,
+                         const char* status, const char* output,
+                         u64 executed_at, u64 duration_ms) {
+    if (!db || !status) return SEA_ERR_IO;
+    if (!job_name) job_name = "";
+    if (!output) output = "";
+
+    if (db->audit) {
+        return audit_push(db->audit, AUDIT_CRON, job_id, executed_at, duration_ms,
+                          job_name, status, output) ? SEA_OK : SEA_ERR_ARENA_FULL;
+    }
+
+    sqlite3_stmt* stmt;
+    const char* sql = "INSERT INTO cron_log (job_id, job_name, status, output, "
+                      "executed_at, duration_ms) VALUES (?, ?, ?, ?, ?, ?)";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_int(stmt, 1, job_id);
+    sqlite3_bind_text(stmt, 2, job_name, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, status, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, output, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 5, (sqlite3_int64)executed_at);
+    sqlite3_bind_int64(stmt, 6, (sqlite3_int64)duration_ms);
+
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        SEA_LOG_ERROR("DB", "log_cron failed: %s", sqlite3_errmsg(db->handle));
+        return SEA_ERR_IO;
+    }
+    return SEA_OK;
+}
+
 i32 sea_db_recent_events(SeaDb* db, SeaDbEvent* out, i32 max_count,
                          SeaArena* arena) {
     if (!db || !out || !arena || max_count <= 0) return 0;
+    sea_db_audit_flush(db);
 
     sqlite3_stmt* stmt;
     const char* sql =
@@ -364,6 +566,256 @@ SeaError sea_db_chat_clear(SeaDb* db, i64 chat_id) {
     return (rc == SQLITE_DONE) ? SEA_OK : SEA_ERR_IO;
 }
 
+/* ── SeaZero ──────────────────────────────────────────────── */
+
+/* Bind text, or NULL for a missing optional column. */
+static void bind_opt(sqlite3_stmt* stmt, int col, const char* s) {
+    if (s) sqlite3_bind_text(stmt, col, s, -1, SQLITE_STATIC);
+    else   sqlite3_bind_null(stmt, col);
+}
+
+/* Step a prepared write to completion and finalize it. */
+static SeaError step_done(SeaDb* db, sqlite3_stmt* stmt, const char* what) {
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        SEA_LOG_ERROR("DB", "%s failed: %s", what, sqlite3_errmsg(db->handle));
+        return SEA_ERR_IO;
+    }
+    return SEA_OK;
+}
+
+SeaError sea_db_sz_agent_register(SeaDb* db, const char* agent_id,
+                                  const char* container, i32 port,
+                                  const char* provider, const char* model) {
+    if (!db || !agent_id) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "INSERT INTO seazero_agents (agent_id, status, container, port, provider, model) "
+        "VALUES (?, 'ready', ?, ?, ?, ?) "
+        "ON CONFLICT(agent_id) DO UPDATE SET status = 'ready', container = excluded.container, "
+        "port = excluded.port, provider = excluded.provider, model = excluded.model, "
+        "last_seen = datetime('now')";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_text(stmt, 1, agent_id, -1, SQLITE_STATIC);
+    bind_opt(stmt, 2, container);
+    sqlite3_bind_int(stmt, 3, port);
+    bind_opt(stmt, 4, provider);
+    bind_opt(stmt, 5, model);
+    return step_done(db, stmt, "sz_agent_register");
+}
+
+SeaError sea_db_sz_agent_update_status(SeaDb* db, const char* agent_id,
+                                       const char* status) {
+    if (!db || !agent_id || !status) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "UPDATE seazero_agents SET status = ?, last_seen = datetime('now') WHERE agent_id = ?";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_text(stmt, 1, status, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, agent_id, -1, SQLITE_STATIC);
+    return step_done(db, stmt, "sz_agent_update_status");
+}
+
+SeaError sea_db_sz_agent_heartbeat(SeaDb* db, const char* agent_id) {
+    if (!db || !agent_id) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql = "UPDATE seazero_agents SET last_seen = datetime('now') WHERE agent_id = ?";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_text(stmt, 1, agent_id, -1, SQLITE_STATIC);
+    return step_done(db, stmt, "sz_agent_heartbeat");
+}
+
+i32 sea_db_sz_agent_list(SeaDb* db, SeaDbAgent* out, i32 max_count, SeaArena* arena) {
+    if (!db || !out || !arena || max_count <= 0) return 0;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "SELECT id, agent_id, status, container, port, provider, model, last_seen "
+        "FROM seazero_agents ORDER BY id LIMIT ?";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return 0;
+    sqlite3_bind_int(stmt, 1, max_count);
+
+    i32 count = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW && count < max_count) {
+        SeaDbAgent* a = &out[count++];
+        a->id        = sqlite3_column_int(stmt, 0);
+        a->agent_id  = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 1));
+        a->status    = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 2));
+        a->container = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 3));
+        a->port      = sqlite3_column_int(stmt, 4);
+        a->provider  = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 5));
+        a->model     = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 6));
+        a->last_seen = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 7));
+    }
+
+    sqlite3_finalize(stmt);
+    return count;
+}
+
+SeaError sea_db_sz_task_create(SeaDb* db, const char* task_id, const char* agent_id,
+                               i64 chat_id, const char* task_text, const char* context) {
+    if (!db || !task_id || !agent_id || !task_text) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "INSERT INTO seazero_tasks (task_id, agent_id, chat_id, task_text, context) "
+        "VALUES (?, ?, ?, ?, ?)";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_text(stmt, 1, task_id, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, agent_id, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 3, chat_id);
+    sqlite3_bind_text(stmt, 4, task_text, -1, SQLITE_STATIC);
+    bind_opt(stmt, 5, context);
+    return step_done(db, stmt, "sz_task_create");
+}
+
+SeaError sea_db_sz_task_start(SeaDb* db, const char* task_id) {
+    if (!db || !task_id) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "UPDATE seazero_tasks SET status = 'running', started_at = datetime('now') "
+        "WHERE task_id = ?";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_text(stmt, 1, task_id, -1, SQLITE_STATIC);
+    return step_done(db, stmt, "sz_task_start");
+}
+
+SeaError sea_db_sz_task_complete(SeaDb* db, const char* task_id, const char* result,
+                                 const char* files, i32 steps_taken, f64 elapsed_sec) {
+    if (!db || !task_id) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "UPDATE seazero_tasks SET status = 'completed', result = ?, files = ?, "
+        "steps_taken = ?, elapsed_sec = ?, completed_at = datetime('now') WHERE task_id = ?";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    bind_opt(stmt, 1, result);
+    bind_opt(stmt, 2, files);
+    sqlite3_bind_int(stmt, 3, steps_taken);
+    sqlite3_bind_double(stmt, 4, elapsed_sec);
+    sqlite3_bind_text(stmt, 5, task_id, -1, SQLITE_STATIC);
+    return step_done(db, stmt, "sz_task_complete");
+}
+
+SeaError sea_db_sz_task_fail(SeaDb* db, const char* task_id, const char* error,
+                             f64 elapsed_sec) {
+    if (!db || !task_id) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "UPDATE seazero_tasks SET status = 'failed', error = ?, elapsed_sec = ?, "
+        "completed_at = datetime('now') WHERE task_id = ?";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    bind_opt(stmt, 1, error);
+    sqlite3_bind_double(stmt, 2, elapsed_sec);
+    sqlite3_bind_text(stmt, 3, task_id, -1, SQLITE_STATIC);
+    return step_done(db, stmt, "sz_task_fail");
+}
+
+i32 sea_db_sz_task_list(SeaDb* db, const char* status_filter,
+                        SeaDbSzTask* out, i32 max_count, SeaArena* arena) {
+    if (!db || !out || !arena || max_count <= 0) return 0;
+
+    sqlite3_stmt* stmt;
+    const char* sql = status_filter
+        ? "SELECT id, task_id, agent_id, chat_id, status, task_text, result, error, "
+          "steps_taken, elapsed_sec FROM seazero_tasks WHERE status = ? ORDER BY id LIMIT ?"
+        : "SELECT id, task_id, agent_id, chat_id, status, task_text, result, error, "
+          "steps_taken, elapsed_sec FROM seazero_tasks ORDER BY id LIMIT ?";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return 0;
+
+    int col = 1;
+    if (status_filter) sqlite3_bind_text(stmt, col++, status_filter, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, col, max_count);
+
+    i32 count = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW && count < max_count) {
+        SeaDbSzTask* t = &out[count++];
+        t->id          = sqlite3_column_int(stmt, 0);
+        t->task_id     = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 1));
+        t->agent_id    = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 2));
+        t->chat_id     = sqlite3_column_int64(stmt, 3);
+        t->status      = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 4));
+        t->task_text   = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 5));
+        t->result      = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 6));
+        t->error       = arena_strdup(arena, (const char*)sqlite3_column_text(stmt, 7));
+        t->steps_taken = sqlite3_column_int(stmt, 8);
+        t->elapsed_sec = sqlite3_column_double(stmt, 9);
+    }
+
+    sqlite3_finalize(stmt);
+    return count;
+}
+
+SeaError sea_db_sz_llm_log(SeaDb* db, const char* caller, const char* provider,
+                           const char* model, i32 tokens_in, i32 tokens_out,
+                           f64 cost_usd, i32 latency_ms, const char* status,
+                           const char* task_id) {
+    if (!db || !caller || !provider || !model) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "INSERT INTO seazero_llm_usage (caller, provider, model, tokens_in, tokens_out, "
+        "cost_usd, latency_ms, status, task_id) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_text(stmt, 1, caller, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, provider, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, model, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 4, tokens_in);
+    sqlite3_bind_int(stmt, 5, tokens_out);
+    sqlite3_bind_double(stmt, 6, cost_usd);
+    sqlite3_bind_int(stmt, 7, latency_ms);
+    sqlite3_bind_text(stmt, 8, status ? status : "ok", -1, SQLITE_STATIC);
+    bind_opt(stmt, 9, task_id);
+    return step_done(db, stmt, "sz_llm_log");
+}
+
+i64 sea_db_sz_llm_total_tokens(SeaDb* db, const char* caller) {
+    if (!db || !caller) return 0;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "SELECT COALESCE(SUM(tokens_in + tokens_out), 0) FROM seazero_llm_usage "
+        "WHERE caller = ? AND created_at >= datetime('now', 'start of day')";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return 0;
+
+    sqlite3_bind_text(stmt, 1, caller, -1, SQLITE_STATIC);
+    i64 total = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : 0;
+    sqlite3_finalize(stmt);
+    return total;
+}
+
+SeaError sea_db_sz_audit(SeaDb* db, const char* event_type, const char* source,
+                         const char* target, const char* detail, const char* severity) {
+    if (!db || !event_type || !source) return SEA_ERR_IO;
+
+    sqlite3_stmt* stmt;
+    const char* sql =
+        "INSERT INTO seazero_audit (event_type, source, target, detail, severity) "
+        "VALUES (?, ?, ?, ?, ?)";
+    if (sqlite3_prepare_v2(db->handle, sql, -1, &stmt, NULL) != SQLITE_OK) return SEA_ERR_IO;
+
+    sqlite3_bind_text(stmt, 1, event_type, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, source, -1, SQLITE_STATIC);
+    bind_opt(stmt, 3, target);
+    bind_opt(stmt, 4, detail);
+    sqlite3_bind_text(stmt, 5, severity ? severity : "info", -1, SQLITE_STATIC);
+    return step_done(db, stmt, "sz_audit");
+}
+
 /* ── Raw SQL ──────────────────────────────────────────────── */
 
 SeaError sea_db_exec(SeaDb* db, const char* sql) {
@@ -379,3 +831,308 @@ SeaError sea_db_exec(SeaDb* db, const char* sql) {
 
     return SEA_OK;
 }
+
+/* ── Audit Writer ─────────────────────────────────────────── */
+
+static const char* AUDIT_INSERT_EVENT =
+    "INSERT INTO trajectory (entry_type, title, content, created_at) "
+    "VALUES (?, ?, ?, datetime(?, 'unixepoch'))";
+static const char* AUDIT_INSERT_CRON =
+    "INSERT INTO cron_log (job_id, job_name, status, output, executed_at, duration_ms) "
+    "VALUES (?, ?, ?, ?, ?, ?)";
+
+static void audit_wake(SeaDbAudit* a) {
+    u64 one = 1;
+    ssize_t n = write(a->wake_fd, &one, sizeof(one));
+    (void)n;
+}
+
+/* Copy at most cap bytes of s, backing off to a UTF-8 boundary. */
+static u16 audit_pack(char* dst, const char* s, u32 cap) {
+    u32 n = (u32)strlen(s);
+    if (n > cap) {
+        n = cap;
+        while (n > 0 && ((u8)s[n] & 0xC0) == 0x80) n--;
+    }
+    memcpy(dst, s, n);
+    return (u16)n;
+}
+
+static bool audit_push(SeaDbAudit* a, u8 kind, i32 job_id, u64 at, u64 duration_ms,
+                       const char* s0, const char* s1, const char* s2) {
+    u64 pos = atomic_load_explicit(&a->tail, memory_order_relaxed);
+    AuditSlot* slot;
+    for (;;) {
+        slot = &a->slots[pos & a->mask];
+        u64 seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        i64 diff = (i64)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&a->tail, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            atomic_fetch_add_explicit(&a->dropped, 1, memory_order_relaxed);
+            return false;                            /* Ring full */
+        } else {
+            pos = atomic_load_explicit(&a->tail, memory_order_relaxed);
+        }
+    }
+
+    /* Short identifiers first; the free text gets what is left */
+    slot->kind        = kind;
+    slot->job_id      = job_id;
+    slot->at          = at;
+    slot->duration_ms = duration_ms;
+    u32 off = 0;
+    slot->len[0] = audit_pack(slot->text, s0, 64);
+    off += slot->len[0];
+    slot->len[1] = audit_pack(slot->text + off, s1, 192);
+    off += slot->len[1];
+    slot->len[2] = audit_pack(slot->text + off, s2, SEA_DB_AUDIT_TEXT - off);
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    atomic_fetch_add_explicit(&a->queued, 1, memory_order_relaxed);
+
+    /* Nudge the writer each time another half ring has been queued */
+    if ((pos & (a->mask >> 1)) == 0) audit_wake(a);
+    return true;
+}
+
+static bool audit_insert(SeaDbAudit* a, const AuditSlot* r) {
+    const char* t0 = r->text;
+    const char* t1 = t0 + r->len[0];
+    const char* t2 = t1 + r->len[1];
+    sqlite3_stmt* st;
+    if (r->kind == AUDIT_EVENT) {
+        st = a->ins_event;
+        sqlite3_bind_text(st, 1, t0, r->len[0], SQLITE_STATIC);
+        sqlite3_bind_text(st, 2, t1, r->len[1], SQLITE_STATIC);
+        sqlite3_bind_text(st, 3, t2, r->len[2], SQLITE_STATIC);
+        sqlite3_bind_int64(st, 4, (sqlite3_int64)r->at);
+    } else {
+        st = a->ins_cron;
+        sqlite3_bind_int(st, 1, r->job_id);
+        sqlite3_bind_text(st, 2, t0, r->len[0], SQLITE_STATIC);
+        sqlite3_bind_text(st, 3, t1, r->len[1], SQLITE_STATIC);
+        sqlite3_bind_text(st, 4, t2, r->len[2], SQLITE_STATIC);
+        sqlite3_bind_int64(st, 5, (sqlite3_int64)r->at);
+        sqlite3_bind_int64(st, 6, (sqlite3_int64)r->duration_ms);
+    }
+    int rc = sqlite3_step(st);
+    sqlite3_reset(st);
+    sqlite3_clear_bindings(st);
+    return rc == SQLITE_DONE;
+}
+
+/* Commit everything published so far, SEA_DB_AUDIT_BATCH rows per
+ * transaction. Slots are released as soon as their row is stepped. */
+static void audit_drain(SeaDbAudit* a) {
+    for (;;) {
+        u32 n = 0, ok = 0;
+        while (n < SEA_DB_AUDIT_BATCH) {
+            AuditSlot* slot = &a->slots[a->head & a->mask];
+            if (atomic_load_explicit(&slot->seq, memory_order_acquire) != a->head + 1) break;
+            if (n == 0) sqlite3_exec(a->conn, "BEGIN", NULL, NULL, NULL);
+            if (audit_insert(a, slot)) ok++;
+            atomic_store_explicit(&slot->seq, a->head + a->mask + 1, memory_order_release);
+            a->head++;
+            n++;
+        }
+        if (n == 0) return;
+
+        if (sqlite3_exec(a->conn, "COMMIT", NULL, NULL, NULL) != SQLITE_OK) {
+            SEA_LOG_ERROR("DB", "audit commit failed: %s", sqlite3_errmsg(a->conn));
+            sqlite3_exec(a->conn, "ROLLBACK", NULL, NULL, NULL);
+            ok = 0;
+        }
+        atomic_fetch_add_explicit(&a->written, ok, memory_order_relaxed);
+        atomic_fetch_add_explicit(&a->dropped, n - ok, memory_order_relaxed);
+        atomic_fetch_add_explicit(&a->batches, 1, memory_order_relaxed);
+
+        pthread_mutex_lock(&a->lock);
+        atomic_store_explicit(&a->done, a->head, memory_order_release);
+        pthread_cond_broadcast(&a->flushed);
+        pthread_mutex_unlock(&a->lock);
+
+        if (n < SEA_DB_AUDIT_BATCH) return;
+    }
+}
+
+static u64 audit_delete(sqlite3* h, const char* sql, i64 arg) {
+    sqlite3_stmt* st;
+    if (sqlite3_prepare_v2(h, sql, -1, &st, NULL) != SQLITE_OK) return 0;
+    sqlite3_bind_int64(st, 1, arg);
+    u64 n = sqlite3_step(st) == SQLITE_DONE ? (u64)sqlite3_changes(h) : 0;
+    sqlite3_finalize(st);
+    return n;
+}
+
+/* Age limit, then downsampling, then the row cap. The cap is an id
+ * threshold (MAX(id) - N), which costs one index probe instead of a
+ * count. */
+static u64 audit_compact(sqlite3* h, const SeaDbAuditConfig* cfg) {
+    i64 now = (i64)time(NULL);
+    u64 n = 0;
+    if (cfg->retain_days) {
+        i64 cutoff = now - (i64)cfg->retain_days * 86400;
+        n += audit_delete(h, "DELETE FROM trajectory WHERE created_at < datetime(?, 'unixepoch')", cutoff);
+        n += audit_delete(h, "DELETE FROM cron_log WHERE executed_at < ?", cutoff);
+    }
+    if (cfg->downsample_days) {
+        /* Keep the first successful run per job per hour; failures stay */
+        i64 cutoff = now - (i64)cfg->downsample_days * 86400;
+        n += audit_delete(h,
+            "DELETE FROM cron_log WHERE status = 'ok' AND executed_at < ?1 "
+            "AND id NOT IN (SELECT MIN(id) FROM cron_log WHERE status = 'ok' "
+            "AND executed_at < ?1 GROUP BY job_id, executed_at / 3600)", cutoff);
+    }
+    if (cfg->retain_rows) {
+        n += audit_delete(h, "DELETE FROM trajectory WHERE id <= "
+                             "(SELECT MAX(id) FROM trajectory) - ?", (i64)cfg->retain_rows);
+        n += audit_delete(h, "DELETE FROM cron_log WHERE id <= "
+                             "(SELECT MAX(id) FROM cron_log) - ?", (i64)cfg->retain_rows);
+    }
+    return n;
+}
+
+static u64 mono_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec;
+}
+
+static void* audit_main(void* arg) {
+    SeaDbAudit* a = (SeaDbAudit*)arg;
+    bool retention = a->cfg.retain_days || a->cfg.retain_rows || a->cfg.downsample_days;
+    u64 next_compact = 0;
+
+    for (;;) {
+        bool stopping = atomic_load(&a->stop);
+        audit_drain(a);
+
+        if (retention && mono_sec() >= next_compact) {
+            u64 n = audit_compact(a->conn, &a->cfg);
+            atomic_fetch_add_explicit(&a->pruned, n, memory_order_relaxed);
+            if (n) SEA_LOG_INFO("DB", "Audit retention removed %llu rows", (unsigned long long)n);
+            next_compact = mono_sec() + a->cfg.compact_sec;
+        }
+
+        /* Exit only once everything claimed before stop is written */
+        if (stopping && a->head == atomic_load(&a->tail)) break;
+
+        /* A flush waiter may be behind a producer still copying its slot */
+        int timeout = atomic_load(&a->waiters) || stopping ? 1 : (int)a->cfg.flush_ms;
+        struct pollfd pfd = { .fd = a->wake_fd, .events = POLLIN };
+        if (poll(&pfd, 1, timeout) > 0) {
+            u64 v;
+            ssize_t r = read(a->wake_fd, &v, sizeof(v));
+            (void)r;
+        }
+    }
+    return NULL;
+}
+
+SeaError sea_db_audit_start(SeaDb* db, const SeaDbAuditConfig* cfg) {
+    if (!db) return SEA_ERR_INVALID_INPUT;
+    if (db->audit) return SEA_ERR_ALREADY_EXISTS;
+
+    SeaDbAudit* a = calloc(1, sizeof(SeaDbAudit));
+    if (!a) return SEA_ERR_OOM;
+    if (cfg) a->cfg = *cfg;
+    if (!a->cfg.flush_ms)    a->cfg.flush_ms = SEA_DB_AUDIT_FLUSH_MS;
+    if (!a->cfg.compact_sec) a->cfg.compact_sec = SEA_DB_AUDIT_COMPACT_SEC;
+    u32 slots = a->cfg.ring_slots ? a->cfg.ring_slots : SEA_DB_AUDIT_SLOTS;
+    u32 cap = 2;
+    while (cap < slots) cap <<= 1;
+    a->cfg.ring_slots = cap;
+    a->mask = cap - 1;
+
+    a->slots = calloc(cap, sizeof(AuditSlot));
+    a->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (!a->slots || a->wake_fd < 0) goto fail;
+    for (u32 i = 0; i < cap; i++) atomic_init(&a->slots[i].seq, i);
+
+    /* Own connection so batches do not serialize behind foreground
+     * queries; in-memory databases can only share the main handle. */
+    a->conn = sea_db_connect(db);
+    a->own_conn = a->conn != NULL;
+    if (!a->conn) a->conn = db->handle;
+    if (sqlite3_prepare_v2(a->conn, AUDIT_INSERT_EVENT, -1, &a->ins_event, NULL) != SQLITE_OK ||
+        sqlite3_prepare_v2(a->conn, AUDIT_INSERT_CRON, -1, &a->ins_cron, NULL) != SQLITE_OK) {
+        SEA_LOG_ERROR("DB", "audit prepare failed: %s", sqlite3_errmsg(a->conn));
+        goto fail;
+    }
+
+    pthread_mutex_init(&a->lock, NULL);
+    pthread_cond_init(&a->flushed, NULL);
+    if (pthread_create(&a->thread, NULL, audit_main, a) != 0) {
+        pthread_cond_destroy(&a->flushed);
+        pthread_mutex_destroy(&a->lock);
+        goto fail;
+    }
+    db->audit = a;
+    SEA_LOG_INFO("DB", "Audit writer started (%u slots, %ums flush)", cap, a->cfg.flush_ms);
+    return SEA_OK;
+
+fail:
+    sqlite3_finalize(a->ins_event);
+    sqlite3_finalize(a->ins_cron);
+    if (a->own_conn) sqlite3_close(a->conn);
+    if (a->wake_fd >= 0) close(a->wake_fd);
+    free(a->slots);
+    free(a);
+    return SEA_ERR_IO;
+}
+
+static void audit_stop(SeaDb* db) {
+    SeaDbAudit* a = db->audit;
+    if (!a) return;
+    atomic_store(&a->stop, true);
+    audit_wake(a);
+    pthread_join(a->thread, NULL);
+    db->audit = NULL;
+
+    sqlite3_finalize(a->ins_event);
+    sqlite3_finalize(a->ins_cron);
+    if (a->own_conn) sqlite3_close(a->conn);
+    close(a->wake_fd);
+    pthread_cond_destroy(&a->flushed);
+    pthread_mutex_destroy(&a->lock);
+    free(a->slots);
+    free(a);
+}
+
+SeaError sea_db_audit_flush(SeaDb* db) {
+    if (!db || !db->audit) return SEA_OK;
+    SeaDbAudit* a = db->audit;
+    u64 target = atomic_load(&a->tail);
+
+    atomic_fetch_add(&a->waiters, 1);
+    audit_wake(a);
+    pthread_mutex_lock(&a->lock);
+    while (atomic_load_explicit(&a->done, memory_order_acquire) < target)
+        pthread_cond_wait(&a->flushed, &a->lock);
+    pthread_mutex_unlock(&a->lock);
+    atomic_fetch_sub(&a->waiters, 1);
+    return SEA_OK;
+}
+
+u64 sea_db_audit_compact(SeaDb* db, const SeaDbAuditConfig* cfg) {
+    if (!db) return 0;
+    if (!cfg && db->audit) cfg = &db->audit->cfg;
+    if (!cfg) return 0;
+    u64 n = audit_compact(db->handle, cfg);
+    if (db->audit) atomic_fetch_add(&db->audit->pruned, n);
+    return n;
+}
+
+void sea_db_audit_stats(SeaDb* db, SeaDbAuditStats* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!db || !db->audit) return;
+    SeaDbAudit* a = db->audit;
+    out->queued  = atomic_load(&a->queued);
+    out->written = atomic_load(&a->written);
+    out->dropped = atomic_load(&a->dropped);
+    out->batches = atomic_load(&a->batches);
+    out->pruned  = atomic_load(&a->pruned);
+    out->pending = (u32)(atomic_load(&a->tail) - atomic_load(&a->done));
+}
@@ -0,0 +1,718 @@
+/*
+ * sea_hash.c — Checksum and digest implementation
+ *
+ * Portable slicing-by-8 CRC tables and a portable SHA-256 compressor are
+ * always built. Hardware variants are compiled with per-function target
+ * attributes, so a generic build still uses them when the CPU has them;
+ * the choice is made once, by CPUID (x86) or HWCAP (ARMv8).
+ */
+
+#include "seaclaw/sea_hash.h"
+#include "seaclaw/sea_log.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define HASH_X86 1
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <arm_neon.h>
+#ifdef __linux__
+#include <sys/auxv.h>
+#endif
+#define HASH_ARM 1
+#endif
+
+#define HASH_CHUNK (1024 * 1024)   /* Per-algorithm pass size in sea_hash_buffer */
+
+/* ── Little-endian loads ──────────────────────────────────── */
+
+static inline u32 load_le32(const u8* p) {
+    u32 v;
+    memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+static inline u64 load_le64(const u8* p) {
+    u64 v;
+    memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline u64 rotl64(u64 x, u32 r) { return (x << r) | (x >> (64 - r)); }
+static inline u32 rotr32(u32 x, u32 r) { return (x >> r) | (x << (32 - r)); }
+
+/* ── Slicing-by-8 CRC tables ──────────────────────────────── */
+
+static u32 s_crc32_tab[8][256];
+static u32 s_crc32c_tab[8][256];
+
+static void build_tables(u32 tab[8][256], u32 poly) {
+    for (u32 i = 0; i < 256; i++) {
+        u32 c = i;
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (poly & (0u - (c & 1)));
+        tab[0][i] = c;
+    }
+    for (u32 i = 0; i < 256; i++) {
+        for (u32 k = 1; k < 8; k++) {
+            tab[k][i] = (tab[k - 1][i] >> 8) ^ tab[0][tab[k - 1][i] & 0xff];
+        }
+    }
+}
+
+/* Works on the inverted register; callers do the ~ at the edges. */
+static u32 crc_slice8(u32 tab[8][256], u32 c, const u8* p, u64 len) {
+    while (len >= 8) {
+        u32 lo = c ^ load_le32(p);
+        u32 hi = load_le32(p + 4);
+        c = tab[7][lo & 0xff] ^ tab[6][(lo >> 8) & 0xff] ^
+            tab[5][(lo >> 16) & 0xff] ^ tab[4][lo >> 24] ^
+            tab[3][hi & 0xff] ^ tab[2][(hi >> 8) & 0xff] ^
+            tab[1][(hi >> 16) & 0xff] ^ tab[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) c = (c >> 8) ^ tab[0][(c ^ *p++) & 0xff];
+    return c;
+}
+
+static u32 crc32_slice8(u32 crc, const u8* p, u64 len) {
+    return ~crc_slice8(s_crc32_tab, ~crc, p, len);
+}
+
+static u32 crc32c_slice8(u32 crc, const u8* p, u64 len) {
+    return ~crc_slice8(s_crc32c_tab, ~crc, p, len);
+}
+
+/* ── SHA-256 (portable) ───────────────────────────────────── */
+
+static const u32 K256[64] __attribute__((aligned(16))) = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static void sha256_blocks_portable(u32 h[8], const u8* p, u64 nblocks) {
+    while (nblocks--) {
+        u32 w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = ((u32)p[4*i] << 24) | ((u32)p[4*i+1] << 16) | ((u32)p[4*i+2] << 8) | p[4*i+3];
+        }
+        for (int i = 16; i < 64; i++) {
+            u32 s0 = rotr32(w[i-15], 7) ^ rotr32(w[i-15], 18) ^ (w[i-15] >> 3);
+            u32 s1 = rotr32(w[i-2], 17) ^ rotr32(w[i-2], 19) ^ (w[i-2] >> 10);
+            w[i] = w[i-16] + s0 + w[i-7] + s1;
+        }
+        u32 a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+        for (int i = 0; i < 64; i++) {
+            u32 S1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+            u32 ch = (e & f) ^ (~e & g);
+            u32 t1 = hh + S1 + ch + K256[i] + w[i];
+            u32 S0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+            u32 mj = (a & b) ^ (a & c) ^ (b & c);
+            u32 t2 = S0 + mj;
+            hh = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+        p += 64;
+    }
+}
+
+/* ── x86: PCLMULQDQ CRC32, SSE4.2 CRC32C, SHA-NI ──────────── */
+
+#if defined(HASH_X86)
+
+/* Fold 64-byte blocks with carry-less multiplies, then Barrett-reduce.
+ * Constants are the bit-reflected k1..k5 and mu/P(x) for the IEEE
+ * polynomial. len must be >= 64 and a multiple of 16. */
+__attribute__((target("pclmul,sse4.1")))
+static u32 crc32_fold_pclmul(const u8* p, u64 len, u32 c) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163cd6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i*)(p + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i*)(p + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i*)(p + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i*)(p + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)c));
+    p += 64;
+    len -= 64;
+
+    while (len >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(p + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(p + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(p + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(p + 0x30)));
+        p += 64;
+        len -= 64;
+    }
+
+    /* Fold four lanes into one */
+    __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+
+    while (len >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)p));
+        p += 16;
+        len -= 16;
+    }
+
+    /* 128 → 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    /* Barrett reduction to 32 bits */
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (u32)_mm_extract_epi32(x1, 1);
+}
+
+static u32 crc32_pclmul(u32 crc, const u8* p, u64 len) {
+    u32 c = ~crc;
+    if (len >= 64) {
+        u64 chunk = len & ~(u64)15;
+        c = crc32_fold_pclmul(p, chunk, c);
+        p += chunk;
+        len -= chunk;
+    }
+    return ~crc_slice8(s_crc32_tab, c, p, len);
+}
+
+__attribute__((target("sse4.2")))
+static u32 crc32c_sse42(u32 crc, const u8* p, u64 len) {
+    u64 c = ~crc;
+    while (len > 0 && ((uintptr_t)p & 7)) {
+        c = _mm_crc32_u8((u32)c, *p++);
+        len--;
+    }
+    while (len >= 32) {
+        c = _mm_crc32_u64(c, load_le64(p));
+        c = _mm_crc32_u64(c, load_le64(p + 8));
+        c = _mm_crc32_u64(c, load_le64(p + 16));
+        c = _mm_crc32_u64(c, load_le64(p + 24));
+        p += 32;
+        len -= 32;
+    }
+    while (len >= 8) {
+        c = _mm_crc32_u64(c, load_le64(p));
+        p += 8;
+        len -= 8;
+    }
+    while (len--) c = _mm_crc32_u8((u32)c, *p++);
+    return ~(u32)c;
+}
+
+/* SHA-NI: state is kept as ABEF / CDGH; four rounds per message word
+ * group, with the schedule computed in a 4-register ring. */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_blocks_shani(u32 h[8], const u8* p, u64 nblocks) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+    __m128i tmp = _mm_loadu_si128((const __m128i*)&h[0]);
+    __m128i st1 = _mm_loadu_si128((const __m128i*)&h[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);                 /* CDAB */
+    st1 = _mm_shuffle_epi32(st1, 0x1B);                 /* EFGH */
+    __m128i st0 = _mm_alignr_epi8(tmp, st1, 8);         /* ABEF */
+    st1 = _mm_blend_epi16(st1, tmp, 0xF0);              /* CDGH */
+
+    while (nblocks--) {
+        __m128i abef = st0, cdgh = st1;
+        __m128i m[4];
+
+        for (int g = 0; g < 16; g++) {
+            if (g < 4) {
+                m[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 16 * g)), bswap);
+            } else {
+                __m128i t = _mm_sha256msg1_epu32(m[g & 3], m[(g + 1) & 3]);
+                t = _mm_add_epi32(t, _mm_alignr_epi8(m[(g + 3) & 3], m[(g + 2) & 3], 4));
+                m[g & 3] = _mm_sha256msg2_epu32(t, m[(g + 3) & 3]);
+            }
+            __m128i msg = _mm_add_epi32(m[g & 3], _mm_load_si128((const __m128i*)&K256[4 * g]));
+            st1 = _mm_sha256rnds2_epu32(st1, st0, msg);
+            st0 = _mm_sha256rnds2_epu32(st0, st1, _mm_shuffle_epi32(msg, 0x0E));
+        }
+
+        st0 = _mm_add_epi32(st0, abef);
+        st1 = _mm_add_epi32(st1, cdgh);
+        p += 64;
+    }
+
+    tmp = _mm_shuffle_epi32(st0, 0x1B);                 /* FEBA */
+    st1 = _mm_shuffle_epi32(st1, 0xB1);                 /* DCHG */
+    st0 = _mm_blend_epi16(tmp, st1, 0xF0);              /* DCBA */
+    st1 = _mm_alignr_epi8(st1, tmp, 8);                 /* HGFE */
+    _mm_storeu_si128((__m128i*)&h[0], st0);
+    _mm_storeu_si128((__m128i*)&h[4], st1);
+}
+
+#endif /* HASH_X86 */
+
+/* ── ARMv8: CRC32/CRC32C instructions, SHA-256 extensions ─── */
+
+#if defined(HASH_ARM)
+
+__attribute__((target("+crc")))
+static u32 crc32_armv8(u32 crc, const u8* p, u64 len) {
+    u32 c = ~crc;
+    while (len > 0 && ((uintptr_t)p & 7)) { c = __crc32b(c, *p++); len--; }
+    while (len >= 8) { c = __crc32d(c, load_le64(p)); p += 8; len -= 8; }
+    while (len--) c = __crc32b(c, *p++);
+    return ~c;
+}
+
+__attribute__((target("+crc")))
+static u32 crc32c_armv8(u32 crc, const u8* p, u64 len) {
+    u32 c = ~crc;
+    while (len > 0 && ((uintptr_t)p & 7)) { c = __crc32cb(c, *p++); len--; }
+    while (len >= 8) { c = __crc32cd(c, load_le64(p)); p += 8; len -= 8; }
+    while (len--) c = __crc32cb(c, *p++);
+    return ~c;
+}
+
+__attribute__((target("+crypto")))
+static void sha256_blocks_armv8(u32 h[8], const u8* p, u64 nblocks) {
+    uint32x4_t st0 = vld1q_u32(&h[0]);
+    uint32x4_t st1 = vld1q_u32(&h[4]);
+
+    while (nblocks--) {
+        uint32x4_t abcd = st0, efgh = st1;
+        uint32x4_t m[4];
+
+        for (int g = 0; g < 16; g++) {
+            if (g < 4) {
+                m[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p + 16 * g)));
+            } else {
+                m[g & 3] = vsha256su1q_u32(vsha256su0q_u32(m[g & 3], m[(g + 1) & 3]),
+                                           m[(g + 2) & 3], m[(g + 3) & 3]);
+            }
+            uint32x4_t wk = vaddq_u32(m[g & 3], vld1q_u32(&K256[4 * g]));
+            uint32x4_t prev = st0;
+            st0 = vsha256hq_u32(st0, st1, wk);
+            st1 = vsha256h2q_u32(st1, prev, wk);
+        }
+
+        st0 = vaddq_u32(st0, abcd);
+        st1 = vaddq_u32(st1, efgh);
+        p += 64;
+    }
+
+    vst1q_u32(&h[0], st0);
+    vst1q_u32(&h[4], st1);
+}
+
+#endif /* HASH_ARM */
+
+/* ── Runtime dispatch ─────────────────────────────────────── */
+
+static struct {
+    u32  (*crc32)(u32, const u8*, u64);
+    u32  (*crc32c)(u32, const u8*, u64);
+    void (*sha256)(u32*, const u8*, u64);
+    const char* crc32_name;
+    const char* crc32c_name;
+    const char* sha256_name;
+} s_impl;
+
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+
+static void hash_init_once(void) {
+    build_tables(s_crc32_tab,  0xEDB88320u);
+    build_tables(s_crc32c_tab, 0x82F63B78u);
+
+    s_impl.crc32       = crc32_slice8;
+    s_impl.crc32c      = crc32c_slice8;
+    s_impl.sha256      = sha256_blocks_portable;
+    s_impl.crc32_name  = "slice-by-8";
+    s_impl.crc32c_name = "slice-by-8";
+    s_impl.sha256_name = "portable";
+
+#if defined(HASH_X86)
+    unsigned a, b, c, d;
+    bool pclmul = false, sse42 = false, sse41 = false, ssse3 = false, sha = false;
+    if (__get_cpuid(1, &a, &b, &c, &d)) {
+        pclmul = (c & bit_PCLMUL) != 0;
+        sse42  = (c & bit_SSE4_2) != 0;
+        sse41  = (c & bit_SSE4_1) != 0;
+        ssse3  = (c & bit_SSSE3)  != 0;
+    }
+    if (__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+        sha = (b & (1u << 29)) != 0;
+    }
+    if (pclmul && sse41) { s_impl.crc32  = crc32_pclmul;        s_impl.crc32_name  = "pclmulqdq"; }
+    if (sse42)           { s_impl.crc32c = crc32c_sse42;        s_impl.crc32c_name = "sse4.2"; }
+    if (sha && sse41 && ssse3) { s_impl.sha256 = sha256_blocks_shani; s_impl.sha256_name = "sha-ni"; }
+#elif defined(HASH_ARM)
+    bool crc = false, sha2 = false;
+#if defined(__linux__)
+    unsigned long hw = getauxval(AT_HWCAP);
+    crc  = (hw & (1UL << 7)) != 0;   /* HWCAP_CRC32 */
+    sha2 = (hw & (1UL << 6)) != 0;   /* HWCAP_SHA2  */
+#elif defined(__APPLE__)
+    crc = sha2 = true;               /* Every Apple arm64 core has both */
+#endif
+    if (crc)  {
+        s_impl.crc32  = crc32_armv8;  s_impl.crc32_name  = "armv8-crc";
+        s_impl.crc32c = crc32c_armv8; s_impl.crc32c_name = "armv8-crc";
+    }
+    if (sha2) { s_impl.sha256 = sha256_blocks_armv8; s_impl.sha256_name = "armv8-sha2"; }
+#endif
+
+    SEA_LOG_DEBUG("HASH", "crc32=%s crc32c=%s sha256=%s",
+                  s_impl.crc32_name, s_impl.crc32c_name, s_impl.sha256_name);
+}
+
+static inline void hash_init(void) {
+    pthread_once(&s_once, hash_init_once);
+}
+
+const char* sea_hash_impl(SeaHashAlgo algo) {
+    hash_init();
+    switch (algo) {
+        case SEA_HASH_CRC32:  return s_impl.crc32_name;
+        case SEA_HASH_CRC32C: return s_impl.crc32c_name;
+        case SEA_HASH_SHA256: return s_impl.sha256_name;
+        default:              return "portable";
+    }
+}
+
+/* ── CRC / FNV ────────────────────────────────────────────── */
+
+u32 sea_crc32(u32 crc, const u8* data, u64 len) {
+    hash_init();
+    if (!data || len == 0) return crc;
+    return s_impl.crc32(crc, data, len);
+}
+
+u32 sea_crc32c(u32 crc, const u8* data, u64 len) {
+    hash_init();
+    if (!data || len == 0) return crc;
+    return s_impl.crc32c(crc, data, len);
+}
+
+u64 sea_fnv1a(u64 hash, const u8* data, u64 len) {
+    for (u64 i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/* ── xxHash64 ─────────────────────────────────────────────── */
+
+#define XXH_P1 11400714785074694791ULL
+#define XXH_P2 14029467366897019727ULL
+#define XXH_P3  1609587929392839161ULL
+#define XXH_P4  9650029242287828579ULL
+#define XXH_P5  2870177450012600261ULL
+
+static inline u64 xxh_round(u64 acc, u64 input) {
+    acc += input * XXH_P2;
+    acc  = rotl64(acc, 31);
+    return acc * XXH_P1;
+}
+
+static inline u64 xxh_merge(u64 acc, u64 val) {
+    acc ^= xxh_round(0, val);
+    return acc * XXH_P1 + XXH_P4;
+}
+
+void sea_xxh64_init(SeaXxh64* s, u64 seed) {
+    memset(s, 0, sizeof(*s));
+    s->seed = seed;
+    s->v[0] = seed + XXH_P1 + XXH_P2;
+    s->v[1] = seed + XXH_P2;
+    s->v[2] = seed;
+    s->v[3] = seed - XXH_P1;
+}
+
+void sea_xxh64_update(SeaXxh64* s, const u8* p, u64 len) {
+    if (!p || len == 0) return;
+    s->total += len;
+
+    if (s->buf_len + len < 32) {
+        memcpy(s->buf + s->buf_len, p, len);
+        s->buf_len += (u32)len;
+        return;
+    }
+    if (s->buf_len) {
+        u32 fill = 32 - s->buf_len;
+        memcpy(s->buf + s->buf_len, p, fill);
+        for (int i = 0; i < 4; i++) s->v[i] = xxh_round(s->v[i], load_le64(s->buf + 8 * i));
+        p += fill;
+        len -= fill;
+        s->buf_len = 0;
+    }
+
+    u64 v0 = s->v[0], v1 = s->v[1], v2 = s->v[2], v3 = s->v[3];
+    while (len >= 32) {
+        v0 = xxh_round(v0, load_le64(p));
+        v1 = xxh_round(v1, load_le64(p + 8));
+        v2 = xxh_round(v2, load_le64(p + 16));
+        v3 = xxh_round(v3, load_le64(p + 24));
+        p += 32;
+        len -= 32;
+    }
+    s->v[0] = v0; s->v[1] = v1; s->v[2] = v2; s->v[3] = v3;
+
+    if (len) {
+        memcpy(s->buf, p, len);
+        s->buf_len = (u32)len;
+    }
+}
+
+u64 sea_xxh64_final(const SeaXxh64* s) {
+    u64 h;
+    if (s->total >= 32) {
+        h = rotl64(s->v[0], 1) + rotl64(s->v[1], 7) + rotl64(s->v[2], 12) + rotl64(s->v[3], 18);
+        for (int i = 0; i < 4; i++) h = xxh_merge(h, s->v[i]);
+    } else {
+        h = s->seed + XXH_P5;
+    }
+    h += s->total;
+
+    const u8* p = s->buf;
+    u32 len = s->buf_len;
+    while (len >= 8) {
+        h ^= xxh_round(0, load_le64(p));
+        h  = rotl64(h, 27) * XXH_P1 + XXH_P4;
+        p += 8;
+        len -= 8;
+    }
+    if (len >= 4) {
+        h ^= (u64)load_le32(p) * XXH_P1;
+        h  = rotl64(h, 23) * XXH_P2 + XXH_P3;
+        p += 4;
+        len -= 4;
+    }
+    while (len--) {
+        h ^= (*p++) * XXH_P5;
+        h  = rotl64(h, 11) * XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+u64 sea_xxh64(const u8* data, u64 len, u64 seed) {
+    SeaXxh64 s;
+    sea_xxh64_init(&s, seed);
+    sea_xxh64_update(&s, data, len);
+    return sea_xxh64_final(&s);
+}
+
+/* ── SHA-256 streaming ────────────────────────────────────── */
+
+void sea_sha256_init(SeaSha256* s) {
+    static const u32 iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    hash_init();
+    memcpy(s->h, iv, sizeof(iv));
+    s->total   = 0;
+    s->buf_len = 0;
+}
+
+void sea_sha256_update(SeaSha256* s, const u8* p, u64 len) {
+    if (!p || len == 0) return;
+    s->total += len;
+
+    if (s->buf_len) {
+        u32 fill = 64 - s->buf_len;
+        if (len < fill) {
+            memcpy(s->buf + s->buf_len, p, len);
+            s->buf_len += (u32)len;
+            return;
+        }
+        memcpy(s->buf + s->buf_len, p, fill);
+        s_impl.sha256(s->h, s->buf, 1);
+        p += fill;
+        len -= fill;
+        s->buf_len = 0;
+    }
+
+    u64 blocks = len / 64;
+    if (blocks) {
+        s_impl.sha256(s->h, p, blocks);
+        p += blocks * 64;
+        len -= blocks * 64;
+    }
+    if (len) {
+        memcpy(s->buf, p, len);
+        s->buf_len = (u32)len;
+    }
+}
+
+void sea_sha256_final(SeaSha256* s, u8 out[32]) {
+    u64 bits = s->total * 8;
+    u8 pad[72];
+    u32 padlen = (s->buf_len < 56) ? (56 - s->buf_len) : (120 - s->buf_len);
+    memset(pad, 0, sizeof(pad));
+    pad[0] = 0x80;
+    for (int i = 0; i < 8; i++) pad[padlen + i] = (u8)(bits >> (56 - 8 * i));
+
+    u64 total = s->total;
+    sea_sha256_update(s, pad, padlen + 8);
+    s->total = total;
+
+    for (int i = 0; i < 8; i++) {
+        out[4*i]     = (u8)(s->h[i] >> 24);
+        out[4*i + 1] = (u8)(s->h[i] >> 16);
+        out[4*i + 2] = (u8)(s->h[i] >> 8);
+        out[4*i + 3] = (u8)(s->h[i]);
+    }
+}
+
+void sea_sha256(const u8* data, u64 len, u8 out[32]) {
+    SeaSha256 s;
+    sea_sha256_init(&s);
+    sea_sha256_update(&s, data, len);
+    sea_sha256_final(&s, out);
+}
+
+/* ── Bulk: every requested algorithm in one pass ─────────── */
+
+typedef struct {
+    u32       algos;
+    u64       size;
+    u32       crc32;
+    u32       crc32c;
+    u64       fnv;
+    SeaXxh64  xxh;
+    SeaSha256 sha;
+} HashMulti;
+
+static void multi_init(HashMulti* m, u32 algos) {
+    memset(m, 0, sizeof(*m));
+    m->algos = algos;
+    m->fnv   = SEA_FNV1A_INIT;
+    sea_xxh64_init(&m->xxh, 0);
+    sea_sha256_init(&m->sha);
+}
+
+static void multi_update(HashMulti* m, const u8* p, u64 len) {
+    m->size += len;
+    if (m->algos & SEA_HASH_CRC32)  m->crc32  = s_impl.crc32(m->crc32, p, len);
+    if (m->algos & SEA_HASH_CRC32C) m->crc32c = s_impl.crc32c(m->crc32c, p, len);
+    if (m->algos & SEA_HASH_XXH64)  sea_xxh64_update(&m->xxh, p, len);
+    if (m->algos & SEA_HASH_FNV1A)  m->fnv = sea_fnv1a(m->fnv, p, len);
+    if (m->algos & SEA_HASH_SHA256) sea_sha256_update(&m->sha, p, len);
+}
+
+static void multi_final(HashMulti* m, SeaHashDigest* out) {
+    memset(out, 0, sizeof(*out));
+    out->size   = m->size;
+    out->crc32  = m->crc32;
+    out->crc32c = m->crc32c;
+    out->fnv1a  = (m->algos & SEA_HASH_FNV1A) ? m->fnv : 0;
+    if (m->algos & SEA_HASH_XXH64)  out->xxh64 = sea_xxh64_final(&m->xxh);
+    if (m->algos & SEA_HASH_SHA256) sea_sha256_final(&m->sha, out->sha256);
+}
+
+void sea_hash_buffer(const u8* data, u64 len, u32 algos, SeaHashDigest* out) {
+    if (!out) return;
+    HashMulti m;
+    multi_init(&m, algos);
+    /* Chunked so each algorithm re-reads a cache-warm megabyte */
+    for (u64 off = 0; data && off < len; off += HASH_CHUNK) {
+        u64 n = len - off < HASH_CHUNK ? len - off : HASH_CHUNK;
+        multi_update(&m, data + off, n);
+    }
+    multi_final(&m, out);
+}
+
+SeaError sea_hash_file(const char* path, u32 algos, SeaHashDigest* out) {
+    if (!path || !out) return SEA_ERR_INVALID_INPUT;
+    hash_init();
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return SEA_ERR_IO;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || S_ISDIR(st.st_mode)) { close(fd); return SEA_ERR_IO; }
+
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        u64 size = (u64)st.st_size;
+        void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            close(fd);
+            madvise(map, size, MADV_SEQUENTIAL);
+            sea_hash_buffer((const u8*)map, size, algos, out);
+            munmap(map, size);
+            return SEA_OK;
+        }
+    }
+
+    /* Pipes, pseudo-files, or mmap refused: stream it */
+    HashMulti m;
+    multi_init(&m, algos);
+    u8 buf[64 * 1024];
+    for (;;) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) { close(fd); return SEA_ERR_IO; }
+        if (n == 0) break;
+        multi_update(&m, buf, (u64)n);
+    }
+    close(fd);
+    multi_final(&m, out);
+    return SEA_OK;
+}
+
+void sea_hash_hex(const u8* data, u32 len, char* out) {
+    static const char hex[] = "0123456789abcdef";
+    for (u32 i = 0; i < len; i++) {
+        out[2*i]     = hex[data[i] >> 4];
+        out[2*i + 1] = hex[data[i] & 0xf];
+    }
+    out[2*len] = '\0';
+}
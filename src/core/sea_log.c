@@ -2,12 +2,26 @@
  * sea_log.c — Structured logging implementation
  *
  * Format: T+<ms> [<TAG>] <message>
+ *
+ * Asynchronous mode: each thread owns a single-producer ring of
+ * length-prefixed lines. Whoever holds s_drain_lock — the writer
+ * thread, sea_log_flush, or a blocked producer — is the consumer for
+ * every ring; it gathers the lines into iovecs and writev()s them in
+ * place before moving the ring's tail. Rings outlive their threads
+ * and are handed to the next thread once drained.
  */
 
 #include "seaclaw/sea_log.h"
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/uio.h>
 
 static SeaLogLevel s_min_level = SEA_LOG_INFO;
 static struct timespec s_start_time;
@@ -39,20 +53,330 @@ static const char* level_str(SeaLogLevel level) {
     }
 }
 
-void sea_log(SeaLogLevel level, const char* tag, const char* fmt, ...) {
-    if (level < s_min_level) return;
+/* ── Rings ────────────────────────────────────────────────── */
+
+/* Record: u32 header then the line, padded to 4 bytes. A zero header
+ * means "skip to the end of the buffer" (the line did not fit there). */
+#define REC_ERR     (1u << 31)          /* Goes to fd_err */
+#define REC_LEN     0x00FFFFFFu
+#define BATCH_IOV   64
+
+typedef struct LogRing {
+    struct LogRing* next;
+    _Atomic u64     head;       /* Bytes written (producer)  */
+    _Atomic u64     tail;       /* Bytes consumed (consumer) */
+    _Atomic u64     dropped;
+    _Atomic bool    owned;      /* A live thread writes here */
+    u32             cap;
+    u8*             buf;
+} LogRing;
+
+static pthread_mutex_t s_rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static LogRing*        s_rings;             /* Only ever prepended */
+static _Atomic bool    s_async;
+static SeaLogConfig    s_cfg;
+static pthread_key_t   s_ring_key;
+static pthread_once_t  s_key_once = PTHREAD_ONCE_INIT;
+static _Thread_local LogRing* t_ring;
+
+static pthread_mutex_t s_drain_lock = PTHREAD_MUTEX_INITIALIZER;
+static u64             s_reported;          /* Drops already announced */
+
+static pthread_mutex_t s_wake_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  s_wake;              /* Never destroyed: late producers may signal */
+static pthread_once_t  s_wake_once = PTHREAD_ONCE_INIT;
+static _Atomic bool    s_writer_idle;
+static bool            s_running;
+static pthread_t       s_writer;
+static bool            s_atexit;
+
+static void ring_release(void* ring) {
+    atomic_store_explicit(&((LogRing*)ring)->owned, false, memory_order_release);
+}
+
+static void key_init(void) {
+    pthread_key_create(&s_ring_key, ring_release);
+}
+
+static void wake_init(void) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&s_wake, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/* This thread's ring: a drained orphan if there is one, else a new one. */
+static LogRing* ring_get(void) {
+    LogRing* mine = t_ring;
+    if (mine && mine->cap == s_cfg.ring_size) return mine;
+    if (mine) ring_release(mine);               /* Restarted with another size */
+    pthread_once(&s_key_once, key_init);
+    pthread_mutex_lock(&s_rings_lock);
+    LogRing* r = s_rings;
+    for (; r; r = r->next) {
+        if (atomic_load(&r->owned) || r->cap != s_cfg.ring_size) continue;
+        if (atomic_load(&r->head) != atomic_load(&r->tail)) continue;
+        atomic_store(&r->owned, true);
+        break;
+    }
+    if (!r && (r = calloc(1, sizeof(LogRing)))) {
+        r->cap = s_cfg.ring_size;
+        r->buf = malloc(r->cap);
+        if (!r->buf) { free(r); r = NULL; }
+        else {
+            atomic_store(&r->owned, true);
+            r->next = s_rings;
+            s_rings = r;
+        }
+    }
+    pthread_mutex_unlock(&s_rings_lock);
+    if (r) {
+        t_ring = r;
+        pthread_setspecific(s_ring_key, r);
+    }
+    return r;
+}
+
+/* Copy one line in. False if there is no room. */
+static bool ring_push(LogRing* r, const char* line, u32 len, bool err) {
+    u32 need = 4 + ((len + 3) & ~3u);
+    u64 head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    u64 tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    u32 pos = (u32)(head & (r->cap - 1));
+    u32 contig = r->cap - pos;
+    u32 total = contig < need ? contig + need : need;
+    if (head + total - tail > r->cap) return false;
+
+    if (contig < need) {
+        memset(r->buf + pos, 0, 4);             /* Skip marker */
+        pos = 0;
+    }
+    u32 hdr = len | (err ? REC_ERR : 0);
+    memcpy(r->buf + pos, &hdr, 4);
+    memcpy(r->buf + pos + 4, line, len);
+    atomic_store_explicit(&r->head, head + total, memory_order_release);
+    return true;
+}
+
+/* writev everything, resuming after short writes. */
+static void write_all(int fd, struct iovec* iov, int n) {
+    while (n > 0) {
+        ssize_t w = writev(fd, iov, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return;                             /* Nowhere to report it */
+        }
+        while (n > 0 && (size_t)w >= iov->iov_len) {
+            w -= (ssize_t)iov->iov_len;
+            iov++; n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (u8*)iov->iov_base + w;
+            iov->iov_len -= (size_t)w;
+        }
+    }
+}
+
+/* Consume what one ring holds now. Caller holds s_drain_lock. */
+static u32 ring_drain(LogRing* r) {
+    struct iovec out[BATCH_IOV], err[BATCH_IOV];
+    u32 lines = 0;
+    u64 head = atomic_load_explicit(&r->head, memory_order_acquire);
+    u64 tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+
+    while (tail != head) {
+        int no = 0, ne = 0;
+        u64 t = tail;
+        while (t != head && no < BATCH_IOV && ne < BATCH_IOV) {
+            u32 pos = (u32)(t & (r->cap - 1));
+            u32 hdr;
+            memcpy(&hdr, r->buf + pos, 4);
+            if (hdr == 0) { t += r->cap - pos; continue; }
+            u32 len = hdr & REC_LEN;
+            struct iovec* v = (hdr & REC_ERR) ? &err[ne++] : &out[no++];
+            v->iov_base = r->buf + pos + 4;
+            v->iov_len  = len;
+            t += 4 + ((len + 3) & ~3u);
+            lines++;
+        }
+        write_all(s_cfg.fd_out, out, no);
+        write_all(s_cfg.fd_err, err, ne);
+        atomic_store_explicit(&r->tail, t, memory_order_release);
+        tail = t;
+    }
+    return lines;
+}
+
+static u32 drain_all(void) {
+    pthread_mutex_lock(&s_drain_lock);
+    pthread_mutex_lock(&s_rings_lock);
+    LogRing* first = s_rings;
+    pthread_mutex_unlock(&s_rings_lock);
+
+    u32 lines = 0;
+    for (LogRing* r = first; r; r = r->next) lines += ring_drain(r);
+
+    u64 dropped = sea_log_dropped();
+    if (dropped > s_reported) {
+        char msg[96];
+        int n = snprintf(msg, sizeof(msg), "T+%lums [LOG] WRN: %llu lines dropped (ring full)\n",
+                         (unsigned long)sea_log_elapsed_ms(),
+                         (unsigned long long)(dropped - s_reported));
+        struct iovec v = { .iov_base = msg, .iov_len = (size_t)n };
+        write_all(s_cfg.fd_err, &v, 1);
+        s_reported = dropped;
+    }
+    pthread_mutex_unlock(&s_drain_lock);
+    return lines;
+}
+
+static void* writer_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&s_wake_lock);
+    while (s_running) {
+        pthread_mutex_unlock(&s_wake_lock);
+        drain_all();
+        pthread_mutex_lock(&s_wake_lock);
+        if (!s_running) break;
+
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        u64 ns = (u64)ts.tv_nsec + (u64)SEA_LOG_FLUSH_MS * 1000000;
+        ts.tv_sec += (time_t)(ns / 1000000000);
+        ts.tv_nsec = (long)(ns % 1000000000);
+        atomic_store(&s_writer_idle, true);
+        pthread_cond_timedwait(&s_wake, &s_wake_lock, &ts);
+        atomic_store(&s_writer_idle, false);
+    }
+    pthread_mutex_unlock(&s_wake_lock);
+    return NULL;
+}
+
+static void wake_writer(void) {
+    if (!atomic_load_explicit(&s_writer_idle, memory_order_relaxed)) return;
+    pthread_mutex_lock(&s_wake_lock);
+    pthread_cond_signal(&s_wake);
+    pthread_mutex_unlock(&s_wake_lock);
+}
+
+/* ── Public API ───────────────────────────────────────────── */
+
+SeaError sea_log_start(const SeaLogConfig* cfg) {
+    if (atomic_load(&s_async)) return SEA_OK;
+    SeaLogConfig c = cfg ? *cfg : (SeaLogConfig){0};
+    u32 size = c.ring_size ? c.ring_size : SEA_LOG_RING_SIZE;
+    c.ring_size = 1024;
+    while (c.ring_size < size) c.ring_size <<= 1;
+    if (c.ring_size < 2 * SEA_LOG_LINE_MAX) c.ring_size = 2 * SEA_LOG_LINE_MAX;
+    if (c.fd_out == 0) c.fd_out = STDOUT_FILENO;
+    if (c.fd_err == 0) c.fd_err = STDERR_FILENO;
+
+    pthread_mutex_lock(&s_rings_lock);
+    s_cfg = c;
+    pthread_mutex_unlock(&s_rings_lock);
+
+    pthread_once(&s_wake_once, wake_init);
+
+    /* Lines already sitting in stdio buffers go out first */
+    fflush(stdout);
+    fflush(stderr);
+
+    s_running = true;
+    if (pthread_create(&s_writer, NULL, writer_main, NULL) != 0) {
+        s_running = false;
+        return SEA_ERR_OOM;
+    }
+    atomic_store(&s_async, true);
+    if (!s_atexit) {
+        s_atexit = true;
+        atexit(sea_log_stop);
+    }
+    return SEA_OK;
+}
 
+void sea_log_stop(void) {
+    if (!atomic_exchange(&s_async, false)) return;
+    pthread_mutex_lock(&s_wake_lock);
+    s_running = false;
+    pthread_cond_signal(&s_wake);
+    pthread_mutex_unlock(&s_wake_lock);
+    pthread_join(s_writer, NULL);
+    drain_all();
+}
+
+void sea_log_flush(void) {
+    if (atomic_load(&s_async)) drain_all();
+}
+
+u64 sea_log_dropped(void) {
+    pthread_mutex_lock(&s_rings_lock);
+    LogRing* first = s_rings;
+    pthread_mutex_unlock(&s_rings_lock);
+    u64 n = 0;
+    for (LogRing* r = first; r; r = r->next)
+        n += atomic_load_explicit(&r->dropped, memory_order_relaxed);
+    return n;
+}
+
+/* "T+<ms> [TAG] LVL: " by hand — snprintf is most of a call's cost */
+static int format_prefix(char* line, size_t cap, SeaLogLevel level, const char* tag) {
+    char digits[24];
+    int nd = 0;
     u64 ms = sea_log_elapsed_ms();
+    do { digits[nd++] = (char)('0' + ms % 10); ms /= 10; } while (ms);
+
+    size_t tlen = strlen(tag);
+    if (tlen > cap / 2) tlen = cap / 2;
+    char* p = line;
+    *p++ = 'T'; *p++ = '+';
+    while (nd) *p++ = digits[--nd];
+    memcpy(p, "ms [", 4); p += 4;
+    memcpy(p, tag, tlen); p += tlen;
+    *p++ = ']'; *p++ = ' ';
+    memcpy(p, level_str(level), 3); p += 3;
+    *p++ = ':'; *p++ = ' ';
+    return (int)(p - line);
+}
 
-    FILE* out = (level >= SEA_LOG_WARN) ? stderr : stdout;
+void sea_log(SeaLogLevel level, const char* tag, const char* fmt, ...) {
+    if (level < s_min_level) return;
 
-    fprintf(out, "T+%lums [%s] %s: ", (unsigned long)ms, tag, level_str(level));
+    char line[SEA_LOG_LINE_MAX];
+    int n = format_prefix(line, sizeof(line), level, tag);
 
     va_list args;
     va_start(args, fmt);
-    vfprintf(out, fmt, args);
+    int m = vsnprintf(line + n, sizeof(line) - (size_t)n, fmt, args);
     va_end(args);
+    if (m > 0) n += m;
+
+    if (n > SEA_LOG_LINE_MAX - 1) {
+        n = SEA_LOG_LINE_MAX - 1;
+        memcpy(line + n - 3, "...", 3);         /* Truncated */
+    }
+    line[n++] = '\n';
+
+    bool err = level >= SEA_LOG_WARN;
+    LogRing* r = atomic_load_explicit(&s_async, memory_order_acquire) ? ring_get() : NULL;
+    if (!r) {
+        FILE* out = err ? stderr : stdout;
+        fwrite(line, 1, (size_t)n, out);
+        fflush(out);
+        return;
+    }
+
+    while (!ring_push(r, line, (u32)n, err)) {
+        if (s_cfg.overflow != SEA_LOG_BLOCK) {
+            atomic_fetch_add_explicit(&r->dropped, 1, memory_order_relaxed);
+            wake_writer();
+            return;
+        }
+        drain_all();                            /* Make room ourselves */
+    }
 
-    fputc('\n', out);
-    fflush(out);
+    /* Warnings go out promptly; otherwise wake the writer at half full */
+    u64 used = atomic_load_explicit(&r->head, memory_order_relaxed) -
+               atomic_load_explicit(&r->tail, memory_order_relaxed);
+    if (err || used > r->cap / 2) wake_writer();
 }
@@ -0,0 +1,432 @@
+/*
+ * sea_metrics.c — Metrics registry and Prometheus exposition
+ *
+ * Series are claimed in a fixed open-addressed table by CAS on the
+ * hash of name + label value, the same way the budget ledger interns
+ * callers. The update fields of a series fill its first cache lines
+ * and its identity starts on a line of its own, so a lookup probing
+ * past a busy series does not bounce the line being incremented.
+ *
+ * The exposition endpoint is one blocking thread: accept, read the
+ * request line, render, write, close. Scrapes are rare and small.
+ */
+
+#include "seaclaw/sea_metrics.h"
+#include "seaclaw/sea_log.h"
+#include "seaclaw/sea_hash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define CACHE_LINE      64
+#define LABEL_KEY_MAX   24
+#define MAX_COLLECTORS  8
+#define SERVE_ARENA     (64 * 1024)
+#define SERVE_ARENA_MAX (16 * 1024 * 1024)
+
+typedef enum { TYPE_COUNTER = 1, TYPE_GAUGE, TYPE_HISTOGRAM } MetricType;
+
+struct SeaMetric {
+    /* Hot: written on every update */
+    _Alignas(CACHE_LINE) _Atomic u64 value;     /* Counter, gauge (i64 bits), sample count */
+    _Atomic u64 sum;                            /* Histogram: f64 bits                     */
+    _Atomic u64 buckets[SEA_METRICS_BUCKETS + 1];   /* Per bucket, last is +Inf         */
+
+    /* Cold: identity, written once */
+    _Alignas(CACHE_LINE) _Atomic u64 hash;      /* 0 = free */
+    _Atomic bool ready;
+    u8          type;
+    const char* help;
+    SeaMetricBuckets bounds;
+    char        name[SEA_METRICS_NAME_MAX];
+    char        label[LABEL_KEY_MAX];
+    char        value_str[SEA_METRICS_LABEL_MAX];
+};
+
+const SeaMetricBuckets SEA_METRICS_LATENCY = {
+    .bounds = { 0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60 },
+    .count  = 14,
+};
+
+const SeaMetricBuckets SEA_METRICS_FAST = {
+    .bounds = { 0.00001, 0.00005, 0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1 },
+    .count  = 11,
+};
+
+static SeaMetric s_table[SEA_METRICS_MAX];
+
+static pthread_mutex_t     s_collect_lock = PTHREAD_MUTEX_INITIALIZER;
+static SeaMetricsCollectFn s_collect_fn[MAX_COLLECTORS];
+static void*               s_collect_ctx[MAX_COLLECTORS];
+static u32                 s_collect_count;
+
+u64 sea_metrics_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000 + (u64)ts.tv_nsec / 1000;
+}
+
+/* ── Registry ─────────────────────────────────────────────── */
+
+static u64 fnv(u64 h, const char* s) {
+    static const u8 sep = 0xff;                 /* Field separator */
+    if (s) h = sea_fnv1a(h, (const u8*)s, strlen(s));
+    return sea_fnv1a(h, &sep, 1);
+}
+
+static bool same(const char* a, const char* b) {
+    return strcmp(a, b ? b : "") == 0;
+}
+
+static SeaMetric* lookup(MetricType type, const char* name, const char* help,
+                         const char* label, const char* value,
+                         const SeaMetricBuckets* buckets) {
+    if (!name) return NULL;
+    if (!label || !value) label = value = NULL;
+    u64 h = fnv(fnv(fnv(SEA_FNV1A_INIT, name), label), value);
+    if (h == 0) h = 1;
+
+    for (u32 n = 0; n < SEA_METRICS_MAX; n++) {
+        SeaMetric* m = &s_table[(h + n) % SEA_METRICS_MAX];
+        u64 cur = atomic_load_explicit(&m->hash, memory_order_acquire);
+        if (cur == 0) {
+            if (atomic_compare_exchange_strong(&m->hash, &cur, h)) {
+                m->type = (u8)type;
+                m->help = help ? help : "";
+                snprintf(m->name, sizeof(m->name), "%s", name);
+                snprintf(m->label, sizeof(m->label), "%s", label ? label : "");
+                snprintf(m->value_str, sizeof(m->value_str), "%s", value ? value : "");
+                if (type == TYPE_HISTOGRAM) {
+                    m->bounds = buckets ? *buckets : SEA_METRICS_LATENCY;
+                    if (m->bounds.count > SEA_METRICS_BUCKETS) m->bounds.count = SEA_METRICS_BUCKETS;
+                }
+                atomic_store_explicit(&m->ready, true, memory_order_release);
+                return m;
+            }
+            /* Lost the slot: cur now holds the winner's hash */
+        }
+        if (cur != h) continue;
+        while (!atomic_load_explicit(&m->ready, memory_order_acquire)) { /* Being named */ }
+        if (same(m->name, name) && same(m->label, label) && same(m->value_str, value))
+            return m->type == type ? m : NULL;
+    }
+    return NULL;
+}
+
+SeaMetric* sea_metric_counter(const char* name, const char* help,
+                              const char* label, const char* value) {
+    return lookup(TYPE_COUNTER, name, help, label, value, NULL);
+}
+
+SeaMetric* sea_metric_gauge(const char* name, const char* help,
+                            const char* label, const char* value) {
+    return lookup(TYPE_GAUGE, name, help, label, value, NULL);
+}
+
+SeaMetric* sea_metric_histogram(const char* name, const char* help,
+                                const char* label, const char* value,
+                                const SeaMetricBuckets* buckets) {
+    return lookup(TYPE_HISTOGRAM, name, help, label, value, buckets);
+}
+
+/* ── Updates ──────────────────────────────────────────────── */
+
+void sea_metric_add(SeaMetric* m, u64 n) {
+    if (m) atomic_fetch_add_explicit(&m->value, n, memory_order_relaxed);
+}
+
+void sea_metric_set(SeaMetric* m, i64 v) {
+    if (m) atomic_store_explicit(&m->value, (u64)v, memory_order_relaxed);
+}
+
+void sea_metric_gauge_add(SeaMetric* m, i64 d) {
+    if (m) atomic_fetch_add_explicit(&m->value, (u64)d, memory_order_relaxed);
+}
+
+void sea_metric_observe(SeaMetric* m, f64 v) {
+    if (!m || m->type != TYPE_HISTOGRAM) return;
+    u32 i = 0;
+    while (i < m->bounds.count && v > m->bounds.bounds[i]) i++;
+    atomic_fetch_add_explicit(&m->buckets[i], 1, memory_order_relaxed);
+
+    u64 old = atomic_load_explicit(&m->sum, memory_order_relaxed), next;
+    do {
+        f64 s;
+        memcpy(&s, &old, sizeof(s));
+        s += v;
+        memcpy(&next, &s, sizeof(next));
+    } while (!atomic_compare_exchange_weak_explicit(&m->sum, &old, next,
+                                                    memory_order_relaxed, memory_order_relaxed));
+    atomic_fetch_add_explicit(&m->value, 1, memory_order_relaxed);
+}
+
+i64 sea_metric_value(const SeaMetric* m) {
+    return m ? (i64)atomic_load_explicit(&m->value, memory_order_relaxed) : 0;
+}
+
+void sea_metrics_on_collect(SeaMetricsCollectFn fn, void* ctx) {
+    if (!fn) return;
+    pthread_mutex_lock(&s_collect_lock);
+    if (s_collect_count < MAX_COLLECTORS) {
+        s_collect_fn[s_collect_count]  = fn;
+        s_collect_ctx[s_collect_count] = ctx;
+        s_collect_count++;
+    }
+    pthread_mutex_unlock(&s_collect_lock);
+}
+
+/* ── Exposition ───────────────────────────────────────────── */
+
+/* Named arenas are always exported; their peaks are what we size by. */
+static void collect_arenas(void) {
+    SeaArenaStats st[SEA_ARENA_REGISTRY_MAX];
+    u32 n = sea_arena_stats(st, SEA_ARENA_REGISTRY_MAX);
+    for (u32 i = 0; i < n; i++) {
+        sea_metric_set(sea_metric_gauge("sea_arena_used_bytes",
+                       "Bytes allocated in named arenas", "arena", st[i].name), (i64)st[i].used);
+        sea_metric_set(sea_metric_gauge("sea_arena_high_water_bytes",
+                       "Peak bytes of the largest arena of that name", "arena", st[i].name),
+                       (i64)st[i].high_water);
+        sea_metric_set(sea_metric_gauge("sea_arena_mapped_bytes",
+                       "Bytes mapped by named arenas", "arena", st[i].name), (i64)st[i].capacity);
+        sea_metric_set(sea_metric_counter("sea_arena_failed_allocations_total",
+                       "Arena allocations that returned NULL", "arena", st[i].name),
+                       (i64)st[i].failed);
+    }
+}
+
+static int by_name(const void* a, const void* b) {
+    const SeaMetric* x = *(const SeaMetric* const*)a;
+    const SeaMetric* y = *(const SeaMetric* const*)b;
+    int c = strcmp(x->name, y->name);
+    return c ? c : strcmp(x->value_str, y->value_str);
+}
+
+/* \ and newline escaped, and " too for label values (HELP keeps it). */
+static u32 escape(char* dst, const char* src, bool quote) {
+    u32 n = 0;
+    for (; *src; src++) {
+        if (*src == '\\' || (quote && *src == '"')) { dst[n++] = '\\'; dst[n++] = *src; }
+        else if (*src == '\n')           { dst[n++] = '\\'; dst[n++] = 'n'; }
+        else                             dst[n++] = *src;
+    }
+    dst[n] = '\0';
+    return n;
+}
+
+static const char* type_name(u8 type) {
+    switch (type) {
+        case TYPE_COUNTER:   return "counter";
+        case TYPE_GAUGE:     return "gauge";
+        default:             return "histogram";
+    }
+}
+
+SeaError sea_metrics_render(SeaArena* arena, SeaSlice* out) {
+    if (!arena || !out) return SEA_ERR_INVALID_INPUT;
+
+    pthread_mutex_lock(&s_collect_lock);
+    for (u32 i = 0; i < s_collect_count; i++) s_collect_fn[i](s_collect_ctx[i]);
+    pthread_mutex_unlock(&s_collect_lock);
+    collect_arenas();
+
+    SeaMetric** list = (SeaMetric**)sea_arena_alloc(arena, sizeof(SeaMetric*) * SEA_METRICS_MAX, 8);
+    if (!list) return SEA_ERR_ARENA_FULL;
+    u32 n = 0;
+    u64 cap = 0;
+    for (u32 i = 0; i < SEA_METRICS_MAX; i++) {
+        SeaMetric* m = &s_table[i];
+        if (!atomic_load_explicit(&m->ready, memory_order_acquire)) continue;
+        list[n++] = m;
+        /* Upper bound on the text: HELP/TYPE plus one line per sample */
+        u32 lines = m->type == TYPE_HISTOGRAM ? m->bounds.count + 3 : 1;
+        cap += 2 * (strlen(m->help) + 2 * SEA_METRICS_NAME_MAX + 24) +
+               lines * (SEA_METRICS_NAME_MAX + LABEL_KEY_MAX + 2 * SEA_METRICS_LABEL_MAX + 64);
+    }
+    qsort(list, n, sizeof(*list), by_name);
+
+    char* buf = (char*)sea_arena_alloc(arena, cap + 1, 1);
+    if (!buf) return SEA_ERR_ARENA_FULL;
+    u64 pos = 0;
+#define EMIT(...) do { \
+        int w_ = snprintf(buf + pos, cap + 1 - pos, __VA_ARGS__); \
+        if (w_ > 0) pos = pos + (u64)w_ > cap ? cap : pos + (u64)w_; \
+    } while (0)
+
+    const char* family = "";
+    for (u32 i = 0; i < n; i++) {
+        const SeaMetric* m = list[i];
+        if (strcmp(m->name, family) != 0) {
+            family = m->name;
+            char* help = (char*)sea_arena_alloc(arena, 2 * strlen(m->help) + 1, 1);
+            if (!help) return SEA_ERR_ARENA_FULL;
+            escape(help, m->help, false);
+            EMIT("# HELP %s %s\n# TYPE %s %s\n", m->name, help, m->name, type_name(m->type));
+        }
+
+        /* {label="value"} or {label="value", — histogram lines add le */
+        char lbl[LABEL_KEY_MAX + 2 * SEA_METRICS_LABEL_MAX + 8] = "";
+        if (m->label[0]) {
+            char esc[2 * SEA_METRICS_LABEL_MAX];
+            escape(esc, m->value_str, true);
+            snprintf(lbl, sizeof(lbl), "%s=\"%s\"", m->label, esc);
+        }
+        u64 value = atomic_load_explicit(&m->value, memory_order_relaxed);
+
+        if (m->type != TYPE_HISTOGRAM) {
+            if (m->type == TYPE_GAUGE)
+                EMIT("%s%s%s%s %lld\n", m->name, lbl[0] ? "{" : "", lbl, lbl[0] ? "}" : "",
+                     (long long)(i64)value);
+            else
+                EMIT("%s%s%s%s %llu\n", m->name, lbl[0] ? "{" : "", lbl, lbl[0] ? "}" : "",
+                     (unsigned long long)value);
+            continue;
+        }
+
+        const char* sep = lbl[0] ? "," : "";
+        u64 cum = 0;
+        for (u32 b = 0; b < m->bounds.count; b++) {
+            cum += atomic_load_explicit(&m->buckets[b], memory_order_relaxed);
+            EMIT("%s_bucket{%s%sle=\"%g\"} %llu\n", m->name, lbl, sep,
+                 m->bounds.bounds[b], (unsigned long long)cum);
+        }
+        cum += atomic_load_explicit(&m->buckets[m->bounds.count], memory_order_relaxed);
+        u64 bits = atomic_load_explicit(&m->sum, memory_order_relaxed);
+        f64 sum;
+        memcpy(&sum, &bits, sizeof(sum));
+        EMIT("%s_bucket{%s%sle=\"+Inf\"} %llu\n", m->name, lbl, sep, (unsigned long long)cum);
+        EMIT("%s_sum%s%s%s %.9g\n", m->name, lbl[0] ? "{" : "", lbl, lbl[0] ? "}" : "", sum);
+        /* Buckets are read one by one: report their total as the count */
+        EMIT("%s_count%s%s%s %llu\n", m->name, lbl[0] ? "{" : "", lbl, lbl[0] ? "}" : "",
+             (unsigned long long)cum);
+    }
+#undef EMIT
+
+    out->data = (const u8*)buf;
+    out->len  = (u32)pos;
+    return SEA_OK;
+}
+
+/* ── Endpoint ─────────────────────────────────────────────── */
+
+static int             s_listen_fd = -1;
+static pthread_t       s_serve_thread;
+static _Atomic bool    s_serving;
+
+static void write_full(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, data, len);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += w;
+        len  -= (size_t)w;
+    }
+}
+
+static void serve_one(int fd, SeaArena* arena) {
+    struct timeval tv = { .tv_sec = 2 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    char req[2048];
+    u32 len = 0;
+    while (len < sizeof(req) - 1) {
+        ssize_t r = read(fd, req + len, sizeof(req) - 1 - len);
+        if (r <= 0) break;
+        len += (u32)r;
+        req[len] = '\0';
+        if (strstr(req, "\r\n\r\n")) break;
+    }
+    req[len] = '\0';
+
+    char head[256];
+    SeaSlice body = SEA_SLICE_EMPTY;
+    int status = 404;
+    if (strncmp(req, "GET /metrics ", 13) == 0 || strncmp(req, "GET /metrics?", 13) == 0) {
+        status = sea_metrics_render(arena, &body) == SEA_OK ? 200 : 500;
+    }
+    if (status != 200) body = SEA_SLICE_LIT("not found\n");
+    if (status == 500) body = SEA_SLICE_LIT("render failed\n");
+
+    int hl = snprintf(head, sizeof(head),
+        "HTTP/1.1 %d %s\r\n"
+        "Content-Type: %s\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: close\r\n\r\n",
+        status, status == 200 ? "OK" : status == 404 ? "Not Found" : "Internal Server Error",
+        status == 200 ? "text/plain; version=0.0.4; charset=utf-8" : "text/plain",
+        body.len);
+    write_full(fd, head, (size_t)hl);
+    write_full(fd, (const char*)body.data, body.len);
+}
+
+static void* serve_main(void* arg) {
+    (void)arg;
+    SeaArena arena;
+    SeaArenaConfig acfg = {
+        .size   = SERVE_ARENA,
+        .max    = SERVE_ARENA_MAX,
+        .retain = SERVE_ARENA,
+        .flags  = SEA_ARENA_GROW,
+        .name   = "metrics",
+    };
+    if (sea_arena_create_ex(&arena, &acfg) != SEA_OK) return NULL;
+
+    while (atomic_load(&s_serving)) {
+        struct pollfd pfd = { .fd = s_listen_fd, .events = POLLIN };
+        if (poll(&pfd, 1, 200) <= 0) continue;
+        int fd = accept(s_listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        serve_one(fd, &arena);
+        close(fd);
+        sea_arena_reset(&arena);
+    }
+    sea_arena_destroy(&arena);
+    return NULL;
+}
+
+SeaError sea_metrics_serve(u16 port) {
+    if (atomic_load(&s_serving)) return SEA_OK;
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return SEA_ERR_IO;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = {
+        .sin_family      = AF_INET,
+        .sin_port        = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        SEA_LOG_WARN("METRICS", "Cannot listen on 127.0.0.1:%u: %s", port, strerror(errno));
+        close(fd);
+        return SEA_ERR_IO;
+    }
+    s_listen_fd = fd;
+    atomic_store(&s_serving, true);
+    if (pthread_create(&s_serve_thread, NULL, serve_main, NULL) != 0) {
+        atomic_store(&s_serving, false);
+        close(fd);
+        s_listen_fd = -1;
+        return SEA_ERR_OOM;
+    }
+    SEA_LOG_INFO("METRICS", "Serving /metrics on 127.0.0.1:%u", port);
+    return SEA_OK;
+}
+
+void sea_metrics_stop(void) {
+    if (!atomic_exchange(&s_serving, false)) return;
+    pthread_join(s_serve_thread, NULL);
+    close(s_listen_fd);
+    s_listen_fd = -1;
+}
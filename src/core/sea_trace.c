@@ -0,0 +1,267 @@
+/*
+ * sea_trace.c — Span rings and Chrome trace export
+ *
+ * Each tracing thread owns a ring of fixed-size spans and is its only
+ * writer: store the span, then publish it by bumping head. The
+ * exporter copies a ring and rereads head afterwards, discarding the
+ * spans the writer may have overwritten meanwhile. Rings outlive
+ * their threads and go to the next thread that traces, as log rings do.
+ *
+ * Timestamps are raw cycle-counter ticks; the exporter converts them
+ * with a rate measured between sea_trace_init() and the export.
+ */
+
+#include "seaclaw/sea_trace.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define RING_MASK   (SEA_TRACE_RING - 1)
+#define CALIBRATE_NS 20000000ULL            /* Minimum tick-rate baseline */
+
+_Static_assert((SEA_TRACE_RING & RING_MASK) == 0, "SEA_TRACE_RING must be a power of two");
+
+typedef struct TraceRing {
+    struct TraceRing* next;
+    _Atomic u64       head;                 /* Spans written */
+    _Atomic bool      owned;                /* A live thread writes here */
+    _Atomic u32       tid;                  /* Current owner, for export */
+    char              thread[16];
+    SeaTraceRecord    spans[SEA_TRACE_RING];
+} TraceRing;
+
+typedef struct {
+    _Atomic u32 id;                         /* 0 while the key is written */
+    char        key[SEA_TRACE_KEY_MAX];
+} TraceRequest;
+
+_Thread_local SeaTraceThread sea_trace_thread_;
+
+static _Thread_local TraceRing* t_ring;
+static _Thread_local u32        t_depth;
+static _Thread_local u64        t_request_start;
+
+static pthread_mutex_t s_rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static TraceRing*      s_rings;             /* Only ever prepended */
+static pthread_key_t   s_ring_key;
+static pthread_once_t  s_key_once = PTHREAD_ONCE_INIT;
+static _Atomic u32     s_next_tid;
+
+static TraceRequest    s_requests[SEA_TRACE_REQUESTS];
+static _Atomic u32     s_next_request;
+static _Atomic u64     s_seen;
+static _Atomic u32     s_every;
+
+static u64             s_tick0;             /* Calibration origin */
+static u64             s_ns0;
+
+static u64 now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+void sea_trace_init(u32 every) {
+#ifdef SEA_TRACE_DISABLED
+    every = 0;
+#endif
+    if (s_tick0 == 0) {
+        s_tick0 = sea_trace_ticks();
+        s_ns0   = now_ns();
+    }
+    atomic_store(&s_every, every);
+}
+
+/* ── Rings ────────────────────────────────────────────────── */
+
+static void ring_release(void* ring) {
+    atomic_store_explicit(&((TraceRing*)ring)->owned, false, memory_order_release);
+}
+
+static void key_init(void) {
+    pthread_key_create(&s_ring_key, ring_release);
+}
+
+/* This thread's ring: an orphan if there is one, else a new one. */
+static TraceRing* ring_get(void) {
+    if (t_ring) return t_ring;
+    pthread_once(&s_key_once, key_init);
+    pthread_mutex_lock(&s_rings_lock);
+    TraceRing* r = s_rings;
+    for (; r; r = r->next) {
+        bool free_ring = false;
+        if (atomic_compare_exchange_strong(&r->owned, &free_ring, true)) break;
+    }
+    if (!r && (r = calloc(1, sizeof(TraceRing)))) {
+        atomic_store(&r->owned, true);
+        r->next = s_rings;
+        s_rings = r;
+    }
+    pthread_mutex_unlock(&s_rings_lock);
+    if (!r) return NULL;
+
+    if (pthread_getname_np(pthread_self(), r->thread, sizeof(r->thread)) != 0)
+        r->thread[0] = '\0';
+    u32 tid = atomic_fetch_add(&s_next_tid, 1) + 1;
+    atomic_store(&r->tid, tid);
+    t_ring = r;
+    pthread_setspecific(s_ring_key, r);
+
+    SeaTraceThread* t = &sea_trace_thread_;
+    t->spans   = r->spans;
+    t->head    = &r->head;
+    t->next    = atomic_load(&r->head);     /* An adopted ring continues */
+    t->tag.tid = (u16)tid;
+    return r;
+}
+
+/* ── Requests ─────────────────────────────────────────────── */
+
+void sea_trace_request_begin(const char* session_key) {
+    if (t_depth++ > 0) return;              /* Joins the outer request */
+    u32 every = atomic_load_explicit(&s_every, memory_order_relaxed);
+    if (every == 0) return;
+    if (atomic_fetch_add_explicit(&s_seen, 1, memory_order_relaxed) % every != 0) return;
+    if (!ring_get()) return;
+
+    u32 id = atomic_fetch_add(&s_next_request, 1) + 1;
+    if (id == 0) id = atomic_fetch_add(&s_next_request, 1) + 1;
+    TraceRequest* req = &s_requests[id % SEA_TRACE_REQUESTS];
+    atomic_store_explicit(&req->id, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    snprintf(req->key, sizeof(req->key), "%s", session_key ? session_key : "");
+    atomic_store_explicit(&req->id, id, memory_order_release);
+
+    SeaTraceThread* t = &sea_trace_thread_;
+    t->tag.request  = id;
+    t->tag.round    = 0;
+    t_request_start = sea_trace_ticks();
+    t->on           = true;
+}
+
+void sea_trace_request_end(void) {
+    if (t_depth == 0 || --t_depth > 0) return;
+    SeaTraceThread* t = &sea_trace_thread_;
+    if (!t->on) return;
+    t->tag.round = 0;
+    SeaTraceSpan whole = { t_request_start, "request" };
+    sea_trace_end(whole);
+    t->on          = false;
+    t->tag.request = 0;
+}
+
+void sea_trace_round(u32 round) {
+    sea_trace_thread_.tag.round = (u16)(round > 0xFFFF ? 0xFFFF : round);
+}
+
+/* ── Export ───────────────────────────────────────────────── */
+
+static void put_json_str(FILE* out, const char* s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') { fputc('\\', out); fputc(c, out); }
+        else if (c < 0x20)         fprintf(out, "\\u%04x", c);
+        else                       fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+/* The session key of a request still in the table, else "". */
+static void request_key(u32 id, char* key) {
+    key[0] = '\0';
+    if (id == 0) return;
+    TraceRequest* req = &s_requests[id % SEA_TRACE_REQUESTS];
+    if (atomic_load_explicit(&req->id, memory_order_acquire) != id) return;
+    memcpy(key, req->key, SEA_TRACE_KEY_MAX);
+    key[SEA_TRACE_KEY_MAX - 1] = '\0';
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&req->id, memory_order_relaxed) != id) key[0] = '\0';
+}
+
+SeaError sea_trace_export(FILE* out, u32* spans) {
+    if (spans) *spans = 0;
+    if (!out) return SEA_ERR_INVALID_INPUT;
+
+    /* Ticks per microsecond, over at least CALIBRATE_NS */
+    if (s_tick0 == 0) sea_trace_init(0);
+    u64 ns = now_ns();
+    if (ns - s_ns0 < CALIBRATE_NS) {
+        usleep((useconds_t)((CALIBRATE_NS - (ns - s_ns0)) / 1000));
+    }
+    u64 ticks = sea_trace_ticks();
+    ns = now_ns();
+    f64 per_us = (f64)(ticks - s_tick0) / ((f64)(ns - s_ns0) / 1000.0);
+    if (per_us <= 0) per_us = 1000.0;
+
+    SeaTraceRecord* copy = malloc(sizeof(SeaTraceRecord) * SEA_TRACE_RING);
+    if (!copy) return SEA_ERR_OOM;
+
+    pthread_mutex_lock(&s_rings_lock);
+    TraceRing* first = s_rings;
+    pthread_mutex_unlock(&s_rings_lock);
+
+    int pid = (int)getpid();
+    u32 total = 0;
+    fprintf(out, "{\"traceEvents\":[\n");
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,"
+                 "\"args\":{\"name\":\"sea_claw\"}}", pid);
+
+    for (TraceRing* r = first; r; r = r->next) {
+        u64 head = atomic_load_explicit(&r->head, memory_order_acquire);
+        u64 from = head > SEA_TRACE_RING ? head - SEA_TRACE_RING : 0;
+        for (u64 i = from; i < head; i++) copy[i - from] = r->spans[i & RING_MASK];
+        atomic_thread_fence(memory_order_acquire);
+        u64 after = atomic_load_explicit(&r->head, memory_order_relaxed);
+        /* Spans at or below after - RING may have been overwritten */
+        u64 safe = after >= SEA_TRACE_RING ? after - SEA_TRACE_RING + 1 : 0;
+
+        if (r->thread[0]) {
+            fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,"
+                         "\"args\":{\"name\":", pid, atomic_load(&r->tid));
+            put_json_str(out, r->thread);
+            fprintf(out, "}}");
+        }
+
+        char key[SEA_TRACE_KEY_MAX];
+        for (u64 i = (from > safe ? from : safe); i < head; i++) {
+            const SeaTraceRecord* s = &copy[i - from];
+            if (!s->name || s->end < s->start || s->start < s_tick0) continue;
+            request_key(s->request, key);
+            fprintf(out, ",\n{\"name\":");
+            put_json_str(out, s->name);
+            fprintf(out, ",\"cat\":\"seaclaw\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                         "\"pid\":%d,\"tid\":%u,\"args\":{\"session\":",
+                    (f64)(s->start - s_tick0) / per_us, (f64)(s->end - s->start) / per_us,
+                    pid, (unsigned)s->tid);
+            put_json_str(out, key);
+            fprintf(out, ",\"request\":%u,\"round\":%u}}", s->request, (unsigned)s->round);
+            total++;
+        }
+    }
+    fprintf(out, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    free(copy);
+
+    if (spans) *spans = total;
+    return ferror(out) ? SEA_ERR_IO : SEA_OK;
+}
+
+SeaError sea_trace_dump(const char* path, u32* spans) {
+    if (!path) return SEA_ERR_INVALID_INPUT;
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        SEA_LOG_WARN("TRACE", "Cannot write %s: %s", path, strerror(errno));
+        return SEA_ERR_IO;
+    }
+    u32 n = 0;
+    SeaError err = sea_trace_export(f, &n);
+    if (fclose(f) != 0 && err == SEA_OK) err = SEA_ERR_IO;
+    if (spans) *spans = n;
+    if (err == SEA_OK) SEA_LOG_INFO("TRACE", "Wrote %u spans to %s", n, path);
+    return err;
+}
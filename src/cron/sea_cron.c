@@ -1,7 +1,13 @@
 /*
  * sea_cron.c — Persistent Cron Scheduler Implementation
  *
- * Tick-based scheduler: call sea_cron_tick() once per second.
+ * Deadline-driven scheduler: active jobs are kept in a binary min-heap
+ * on next_run, and the scheduler thread blocks on a timerfd armed for
+ * the heap top. Cron expressions are compiled to per-field bitmasks
+ * and the next fire time is found by jumping field by field. Due runs
+ * go to a bounded worker pool; each worker resets its own arena per
+ * run, and shell commands run in their own process group so a timeout
+ * can kill the whole tree.
  * Jobs are persisted to SQLite and survive restarts.
  */
 
@@ -12,7 +18,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <sys/wait.h>
 
 /* ── Helpers ──────────────────────────────────────────────── */
 
@@ -20,6 +35,12 @@ static u64 now_epoch(void) {
     return (u64)time(NULL);
 }
 
+static u64 mono_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000 + (u64)ts.tv_nsec / 1000000;
+}
+
 /* ── Schedule Parsing ─────────────────────────────────────── */
 
 /* Parse interval string like "30s", "5m", "1h", "2d" → seconds */
@@ -37,32 +58,206 @@ static u64 parse_duration(const char* s) {
     }
 }
 
-/* Parse cron-style "min hour dom mon dow" into next_run.
- * Simplified: supports only interval-like patterns for now.
- * Full 5-field cron parsing is complex; we handle common cases. */
-static u64 cron_next_from_expr(const char* expr) {
-    /* Handle simple patterns:
-     *   every-minute:  * * * * *
-     *   every-5-min:   star-slash-5 * * * *
-     *   hourly:        0 * * * *
-     *   daily:         0 0 * * *
-     */
-    if (!expr) return 60;
+/* ── Cron Compiler ────────────────────────────────────────── */
+
+static const char* const MONTH_NAMES[] = {
+    "jan", "feb", "mar", "apr", "may", "jun",
+    "jul", "aug", "sep", "oct", "nov", "dec", NULL
+};
+static const char* const DOW_NAMES[] = {
+    "sun", "mon", "tue", "wed", "thu", "fri", "sat", NULL
+};
+
+/* Parse a number or a three-letter name (names[i] ↔ first + i). */
+static bool parse_value(const char** p, const char* end, const char* const* names,
+                        int first, int* out) {
+    const char* s = *p;
+    if (s < end && *s >= '0' && *s <= '9') {
+        int v = 0;
+        while (s < end && *s >= '0' && *s <= '9' && v < 1000) v = v * 10 + (*s++ - '0');
+        *p = s;
+        *out = v;
+        return true;
+    }
+    if (!names || end - s < 3) return false;
+    for (int i = 0; names[i]; i++) {
+        if (strncasecmp(s, names[i], 3) == 0) {
+            *p = s + 3;
+            *out = first + i;
+            return true;
+        }
+    }
+    return false;
+}
 
-    /* Check for star-slash-N pattern in minutes field */
-    if (expr[0] == '*' && expr[1] == '/') {
-        u64 mins = (u64)atoi(expr + 2);
-        return mins > 0 ? mins * 60 : 60;
+/* One field: comma-separated items of *, N, N-M, each with an optional
+ * /step (a bare N/step runs to hi). Sets bits lo..hi of *out. */
+static bool parse_field(const char* s, const char* end, int lo, int hi,
+                        const char* const* names, int name_first, u64* out) {
+    u64 mask = 0;
+    while (s < end) {
+        int a, b, step = 1;
+        bool star = false;
+        if (*s == '*') {
+            a = lo; b = hi; s++; star = true;
+        } else {
+            if (!parse_value(&s, end, names, name_first, &a)) return false;
+            b = a;
+            if (s < end && *s == '-') {
+                s++;
+                if (!parse_value(&s, end, names, name_first, &b)) return false;
+            }
+        }
+        if (s < end && *s == '/') {
+            s++;
+            if (!parse_value(&s, end, NULL, 0, &step) || step < 1) return false;
+            if (!star && b == a) b = hi;
+        }
+        if (a < lo || b > hi || a > b) return false;
+        for (int v = a; v <= b; v += step) mask |= 1ULL << v;
+        if (s < end) {
+            if (*s != ',') return false;
+            s++;
+            if (s == end) return false;
+        }
     }
-    /* "* * * * *" → every minute */
-    if (strcmp(expr, "* * * * *") == 0) return 60;
-    /* "0 * * * *" → every hour */
-    if (strncmp(expr, "0 *", 3) == 0) return 3600;
-    /* "0 0 * * *" → daily */
-    if (strncmp(expr, "0 0 *", 5) == 0) return 86400;
+    if (!mask) return false;
+    *out = mask;
+    return true;
+}
+
+SeaError sea_cron_compile(const char* expr, SeaCronExpr* out) {
+    if (!expr || !out) return SEA_ERR_INVALID_INPUT;
+    while (*expr == ' ' || *expr == '\t') expr++;
+
+    static const struct { const char* name; const char* expr; } MACROS[] = {
+        { "@yearly",   "0 0 1 1 *" }, { "@annually", "0 0 1 1 *" },
+        { "@monthly",  "0 0 1 * *" }, { "@weekly",   "0 0 * * 0" },
+        { "@daily",    "0 0 * * *" }, { "@midnight", "0 0 * * *" },
+        { "@hourly",   "0 * * * *" },
+    };
+    if (*expr == '@') {
+        for (u32 i = 0; i < sizeof(MACROS) / sizeof(MACROS[0]); i++) {
+            u32 n = (u32)strlen(MACROS[i].name);
+            if (strncmp(expr, MACROS[i].name, n) == 0 &&
+                (expr[n] == '\0' || expr[n] == ' ' || expr[n] == '\t'))
+                return sea_cron_compile(MACROS[i].expr, out);
+        }
+        return SEA_ERR_INVALID_INPUT;
+    }
+
+    const char* field[5];
+    const char* field_end[5];
+    const char* p = expr;
+    for (int i = 0; i < 5; i++) {
+        while (*p == ' ' || *p == '\t') p++;
+        if (!*p) return SEA_ERR_INVALID_INPUT;
+        field[i] = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+        field_end[i] = p;
+    }
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p) return SEA_ERR_INVALID_INPUT;
+
+    u64 m[5];
+    if (!parse_field(field[0], field_end[0], 0, 59, NULL, 0, &m[0]) ||
+        !parse_field(field[1], field_end[1], 0, 23, NULL, 0, &m[1]) ||
+        !parse_field(field[2], field_end[2], 1, 31, NULL, 0, &m[2]) ||
+        !parse_field(field[3], field_end[3], 1, 12, MONTH_NAMES, 1, &m[3]) ||
+        !parse_field(field[4], field_end[4], 0, 7, DOW_NAMES, 0, &m[4]))
+        return SEA_ERR_INVALID_INPUT;
+
+    memset(out, 0, sizeof(*out));
+    out->minutes  = m[0];
+    out->hours    = (u32)m[1];
+    out->days     = (u32)m[2];
+    out->months   = (u16)m[3];
+    out->weekdays = (u8)((m[4] | (m[4] >> 7)) & 0x7F);   /* 7 → Sunday */
+    if (*field[2] == '*') out->flags |= SEA_CRON_DOM_STAR;
+    if (*field[4] == '*') out->flags |= SEA_CRON_DOW_STAR;
+    return SEA_OK;
+}
+
+/* ── Next Fire Time ───────────────────────────────────────── */
+
+static int days_in_month(int y, int m) {
+    static const u8 DAYS[13] = { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (m == 2 && ((y % 4 == 0 && y % 100 != 0) || y % 400 == 0)) return 29;
+    return DAYS[m];
+}
+
+/* Sakamoto's method, 0 = Sunday. */
+static int weekday(int y, int m, int d) {
+    static const u8 T[12] = { 0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4 };
+    if (m < 3) y--;
+    return (y + y / 4 - y / 100 + y / 400 + T[m - 1] + d) % 7;
+}
+
+/* Lowest set bit of mask at or above `from`, or -1. */
+static inline int next_bit(u64 mask, int from) {
+    if (from > 63) return -1;
+    u64 rest = mask >> from;
+    return rest ? from + __builtin_ctzll(rest) : -1;
+}
 
-    /* Default: every 60 seconds */
-    return 60;
+static bool day_matches(const SeaCronExpr* e, int y, int m, int d) {
+    bool dom = (e->days >> d) & 1;
+    bool dow = (e->weekdays >> weekday(y, m, d)) & 1;
+    if (e->flags & SEA_CRON_DOM_STAR) return dow;
+    if (e->flags & SEA_CRON_DOW_STAR) return dom;
+    return dom || dow;
+}
+
+SeaError sea_cron_next(const SeaCronExpr* e, u64 after, u64* out_next) {
+    if (!e || !out_next) return SEA_ERR_INVALID_INPUT;
+
+    time_t t = (time_t)after;
+    struct tm tm;
+    if (!localtime_r(&t, &tm)) return SEA_ERR_INVALID_INPUT;
+
+    int y = tm.tm_year + 1900, mo = tm.tm_mon + 1, d = tm.tm_mday;
+    int h = tm.tm_hour, mi = tm.tm_min + 1;
+    int y_limit = y + 8;
+
+    /* Each step jumps a whole field to its next allowed value, so the
+     * loop runs a handful of times per month searched, not per minute. */
+    for (;;) {
+        if (mi > 59) { mi = 0; h++; }
+        if (h > 23)  { h = 0; mi = 0; d++; }
+        if (d > days_in_month(y, mo)) { d = 1; h = 0; mi = 0; mo++; }
+        if (mo > 12) { mo = 1; d = 1; h = 0; mi = 0; y++; }
+        if (y > y_limit) return SEA_ERR_NOT_FOUND;
+
+        if (!((e->months >> mo) & 1)) {
+            int nm = next_bit(e->months, mo);
+            if (nm < 0) { y++; nm = next_bit(e->months, 1); }
+            mo = nm; d = 1; h = 0; mi = 0;
+            continue;
+        }
+        if (!day_matches(e, y, mo, d)) { d++; h = 0; mi = 0; continue; }
+
+        int nh = next_bit(e->hours, h);
+        if (nh < 0) { d++; h = 0; mi = 0; continue; }
+        if (nh != h) { h = nh; mi = 0; }
+
+        int nmi = next_bit(e->minutes, mi);
+        if (nmi < 0) { h++; mi = 0; continue; }
+        mi = nmi;
+
+        struct tm want = { 0 };
+        want.tm_year  = y - 1900;
+        want.tm_mon   = mo - 1;
+        want.tm_mday  = d;
+        want.tm_hour  = h;
+        want.tm_min   = mi;
+        want.tm_isdst = -1;
+        time_t r = mktime(&want);
+        /* A wall-clock time repeated by a DST fall-back fires once;
+         * one skipped by spring-forward fires at the shifted time. */
+        if (r == (time_t)-1 || (u64)r <= after) { mi++; continue; }
+        *out_next = (u64)r;
+        return SEA_OK;
+    }
 }
 
 SeaError sea_cron_parse_schedule(const char* schedule, SeaSchedType* out_type,
@@ -90,12 +285,106 @@ SeaError sea_cron_parse_schedule(const char* schedule, SeaSchedType* out_type,
     }
 
     /* Standard cron expression */
+    SeaCronExpr expr;
+    u64 second;
+    if (sea_cron_compile(schedule, &expr) != SEA_OK) return SEA_ERR_INVALID_INPUT;
+    if (sea_cron_next(&expr, now, out_next_run) != SEA_OK) return SEA_ERR_INVALID_INPUT;
     *out_type = SEA_SCHED_CRON;
-    *out_interval = cron_next_from_expr(schedule);
-    *out_next_run = now + *out_interval;
+    *out_interval = sea_cron_next(&expr, *out_next_run, &second) == SEA_OK
+                  ? second - *out_next_run : 0;
     return SEA_OK;
 }
 
+/* ── Deadline Heap ────────────────────────────────────────── */
+
+#define NO_HEAP UINT32_MAX
+
+static inline bool heap_less(const SeaCronScheduler* s, u32 i, u32 j) {
+    return s->jobs[s->heap[i]].next_run < s->jobs[s->heap[j]].next_run;
+}
+
+static inline void heap_swap(SeaCronScheduler* s, u32 i, u32 j) {
+    u32 t = s->heap[i];
+    s->heap[i] = s->heap[j];
+    s->heap[j] = t;
+    s->heap_pos[s->heap[i]] = i;
+    s->heap_pos[s->heap[j]] = j;
+}
+
+static void heap_up(SeaCronScheduler* s, u32 i) {
+    while (i > 0) {
+        u32 parent = (i - 1) / 2;
+        if (!heap_less(s, i, parent)) break;
+        heap_swap(s, i, parent);
+        i = parent;
+    }
+}
+
+static void heap_down(SeaCronScheduler* s, u32 i) {
+    for (;;) {
+        u32 l = 2 * i + 1, r = l + 1, m = i;
+        if (l < s->heap_len && heap_less(s, l, m)) m = l;
+        if (r < s->heap_len && heap_less(s, r, m)) m = r;
+        if (m == i) break;
+        heap_swap(s, i, m);
+        i = m;
+    }
+}
+
+static void heap_push(SeaCronScheduler* s, u32 slot) {
+    if (s->heap_pos[slot] != NO_HEAP) return;
+    s->heap[s->heap_len] = slot;
+    s->heap_pos[slot] = s->heap_len;
+    heap_up(s, s->heap_len++);
+}
+
+static void heap_remove(SeaCronScheduler* s, u32 slot) {
+    u32 i = s->heap_pos[slot];
+    if (i == NO_HEAP) return;
+    s->heap_pos[slot] = NO_HEAP;
+    if (i == --s->heap_len) return;
+    s->heap[i] = s->heap[s->heap_len];
+    s->heap_pos[s->heap[i]] = i;
+    heap_down(s, i);
+    heap_up(s, i);
+}
+
+/* Rebuild from scratch after slots move (remove compacts the table). */
+static void heap_rebuild(SeaCronScheduler* s) {
+    s->heap_len = 0;
+    for (u32 i = 0; i < s->count; i++) {
+        s->heap_pos[i] = NO_HEAP;
+        if (s->jobs[i].state == SEA_CRON_ACTIVE) {
+            s->heap_pos[i] = s->heap_len;
+            s->heap[s->heap_len++] = i;
+        }
+    }
+    for (u32 i = s->heap_len / 2; i-- > 0;) heap_down(s, i);
+}
+
+/* Point the timerfd at the earliest deadline (or disarm it). A deadline
+ * already past fires immediately. Caller holds the lock. */
+static void arm_timer(SeaCronScheduler* s) {
+    if (s->timer_fd < 0) return;
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    if (!s->running) {
+        its.it_value.tv_nsec = 1;                 /* Wake the thread to exit */
+    } else if (s->heap_len > 0) {
+        u64 due = s->jobs[s->heap[0]].next_run;
+        its.it_value.tv_sec = (time_t)(due > 0 ? due : 1);
+    }
+    timerfd_settime(s->timer_fd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &its, NULL);
+}
+
+/* Slot for a job id, or -1. Caller holds the lock. */
+static i32 find_slot(SeaCronScheduler* s, i32 job_id) {
+    for (u32 i = 0; i < s->count; i++) {
+        if (s->jobs[i].id == job_id) return (i32)i;
+    }
+    return -1;
+}
+
 /* ── Init / Destroy ───────────────────────────────────────── */
 
 SeaError sea_cron_init(SeaCronScheduler* sched, SeaDb* db, SeaBus* bus) {
@@ -105,10 +394,36 @@ SeaError sea_cron_init(SeaCronScheduler* sched, SeaDb* db, SeaBus* bus) {
     sched->db = db;
     sched->bus = bus;
     sched->running = true;
+    sched->timer_fd = -1;
 
-    SeaError err = sea_arena_create(&sched->arena, 64 * 1024);
+    SeaError err = sea_arena_create_named(&sched->arena, "cron", 64 * 1024);
     if (err != SEA_OK) return err;
 
+    /* Job table and heap are reserved up front; pages are only
+     * touched as jobs are added. */
+    u64 store = (u64)(SEA_MAX_CRON_JOBS + SEA_CRON_QUEUE_MAX) * sizeof(SeaCronJob)
+              + (u64)SEA_MAX_CRON_JOBS * 2 * sizeof(u32) + 4096;
+    err = sea_arena_create_named(&sched->store, "cron.store", store);
+    if (err != SEA_OK) { sea_arena_destroy(&sched->arena); return err; }
+    sched->jobs     = (SeaCronJob*)sea_arena_alloc(&sched->store,
+                          SEA_MAX_CRON_JOBS * sizeof(SeaCronJob), 64);
+    sched->heap     = (u32*)sea_arena_alloc(&sched->store, SEA_MAX_CRON_JOBS * sizeof(u32), 4);
+    sched->heap_pos = (u32*)sea_arena_alloc(&sched->store, SEA_MAX_CRON_JOBS * sizeof(u32), 4);
+    sched->queue    = (SeaCronJob*)sea_arena_alloc(&sched->store,
+                          SEA_CRON_QUEUE_MAX * sizeof(SeaCronJob), 64);
+    if (!sched->jobs || !sched->heap || !sched->heap_pos || !sched->queue) {
+        sea_arena_destroy(&sched->store);
+        sea_arena_destroy(&sched->arena);
+        return SEA_ERR_OOM;
+    }
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&sched->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    pthread_cond_init(&sched->work_cond, NULL);
+
     /* Create DB tables */
     if (db) {
         sea_db_exec(db,
@@ -145,12 +460,97 @@ SeaError sea_cron_init(SeaCronScheduler* sched, SeaDb* db, SeaBus* bus) {
 }
 
 void sea_cron_destroy(SeaCronScheduler* sched) {
-    if (!sched) return;
+    if (!sched || !sched->jobs) return;
+
+    /* Workers drop queued runs and kill in-flight shell jobs */
+    pthread_mutex_lock(&sched->lock);
     sched->running = false;
+    arm_timer(sched);
+    pthread_cond_broadcast(&sched->work_cond);
+    pthread_mutex_unlock(&sched->lock);
+    if (sched->timer_fd >= 0) {
+        pthread_join(sched->thread, NULL);
+        close(sched->timer_fd);
+        sched->timer_fd = -1;
+    }
+    for (u32 i = 0; i < sched->worker_count; i++) {
+        pthread_join(sched->workers[i].tid, NULL);
+        sea_arena_destroy(&sched->workers[i].arena);
+    }
+    sched->worker_count = 0;
+
     sea_cron_save(sched);
-    sea_arena_destroy(&sched->arena);
     SEA_LOG_INFO("CRON", "Scheduler destroyed (%u jobs, %llu ticks)",
                  sched->count, (unsigned long long)sched->tick_count);
+    pthread_cond_destroy(&sched->work_cond);
+    pthread_mutex_destroy(&sched->lock);
+    sea_arena_destroy(&sched->store);
+    sea_arena_destroy(&sched->arena);
+    sched->jobs = NULL;
+}
+
+/* ── Scheduler Thread ─────────────────────────────────────── */
+
+static void* worker_main(void* arg);
+
+static void* cron_thread(void* arg) {
+    SeaCronScheduler* sched = (SeaCronScheduler*)arg;
+    for (;;) {
+        u64 expirations;
+        ssize_t n = read(sched->timer_fd, &expirations, sizeof(expirations));
+        if (n < 0 && errno != ECANCELED && errno != EINTR) {
+            SEA_LOG_ERROR("CRON", "timerfd read failed: %s", strerror(errno));
+            break;
+        }
+
+        pthread_mutex_lock(&sched->lock);
+        bool running = sched->running;
+        pthread_mutex_unlock(&sched->lock);
+        if (!running) break;
+
+        /* ECANCELED means the wall clock was set: re-evaluate and re-arm. */
+        sea_cron_tick(sched);
+    }
+    return NULL;
+}
+
+SeaError sea_cron_start(SeaCronScheduler* sched) {
+    if (!sched || !sched->jobs) return SEA_ERR_INVALID_INPUT;
+    if (sched->timer_fd >= 0) return SEA_OK;
+
+    int fd = timerfd_create(CLOCK_REALTIME, TFD_CLOEXEC);
+    if (fd < 0) {
+        SEA_LOG_ERROR("CRON", "timerfd_create failed: %s", strerror(errno));
+        return SEA_ERR_IO;
+    }
+
+    pthread_mutex_lock(&sched->lock);
+    u32 want = sched->max_workers ? sched->max_workers : SEA_CRON_WORKERS;
+    if (want > SEA_CRON_MAX_WORKERS) want = SEA_CRON_MAX_WORKERS;
+    while (sched->worker_count < want) {
+        SeaCronWorker* w = &sched->workers[sched->worker_count];
+        w->sched = sched;
+        if (sea_arena_create_named(&w->arena, "cron.worker", SEA_CRON_WORKER_ARENA) != SEA_OK) break;
+        if (pthread_create(&w->tid, NULL, worker_main, w) != 0) {
+            sea_arena_destroy(&w->arena);
+            break;
+        }
+        sched->worker_count++;
+    }
+
+    sched->timer_fd = fd;
+    if (pthread_create(&sched->thread, NULL, cron_thread, sched) != 0) {
+        sched->timer_fd = -1;
+        pthread_mutex_unlock(&sched->lock);
+        close(fd);
+        return SEA_ERR_IO;
+    }
+    arm_timer(sched);
+    pthread_mutex_unlock(&sched->lock);
+
+    SEA_LOG_INFO("CRON", "Scheduler thread started (%u active jobs, %u workers)",
+                 sched->heap_len, sched->worker_count);
+    return SEA_OK;
 }
 
 /* ── Add Job ──────────────────────────────────────────────── */
@@ -159,7 +559,6 @@ i32 sea_cron_add(SeaCronScheduler* sched, const char* name,
                   SeaCronJobType type, const char* schedule,
                   const char* command, const char* args) {
     if (!sched || !name || !schedule || !command) return -1;
-    if (sched->count >= SEA_MAX_CRON_JOBS) return -1;
 
     SeaSchedType stype;
     u64 interval, next_run;
@@ -167,10 +566,17 @@ i32 sea_cron_add(SeaCronScheduler* sched, const char* name,
         return -1;
     }
 
-    SeaCronJob* job = &sched->jobs[sched->count];
+    pthread_mutex_lock(&sched->lock);
+    if (sched->count >= SEA_MAX_CRON_JOBS) {
+        pthread_mutex_unlock(&sched->lock);
+        return -1;
+    }
+
+    u32 slot = sched->count;
+    SeaCronJob* job = &sched->jobs[slot];
     memset(job, 0, sizeof(SeaCronJob));
 
-    job->id = (i32)sched->count + 1;
+    job->id = ++sched->next_id;
     strncpy(job->name, name, SEA_CRON_NAME_MAX - 1);
     job->type = type;
     job->state = SEA_CRON_ACTIVE;
@@ -178,11 +584,17 @@ i32 sea_cron_add(SeaCronScheduler* sched, const char* name,
     strncpy(job->schedule, schedule, SEA_CRON_EXPR_MAX - 1);
     strncpy(job->command, command, SEA_CRON_CMD_MAX - 1);
     if (args) strncpy(job->args, args, SEA_CRON_CMD_MAX - 1);
+    if (stype == SEA_SCHED_CRON) sea_cron_compile(schedule, &job->expr);
+    job->overlap = SEA_CRON_OVERLAP_SKIP;
+    job->timeout_sec = SEA_CRON_TIMEOUT_SEC;
     job->interval_sec = interval;
     job->next_run = next_run;
     job->created_at = now_epoch();
 
     sched->count++;
+    sched->heap_pos[slot] = NO_HEAP;
+    heap_push(sched, slot);
+    arm_timer(sched);
 
     SEA_LOG_INFO("CRON", "Added job #%d '%s' [%s] next=%llu",
                  job->id, job->name, job->schedule,
@@ -204,7 +616,9 @@ i32 sea_cron_add(SeaCronScheduler* sched, const char* name,
         sea_db_exec(sched->db, sql);
     }
 
-    return job->id;
+    i32 id = job->id;
+    pthread_mutex_unlock(&sched->lock);
+    return id;
 }
 
 /* ── Remove Job ───────────────────────────────────────────── */
@@ -212,64 +626,172 @@ i32 sea_cron_add(SeaCronScheduler* sched, const char* name,
 SeaError sea_cron_remove(SeaCronScheduler* sched, i32 job_id) {
     if (!sched) return SEA_ERR_INVALID_INPUT;
 
-    for (u32 i = 0; i < sched->count; i++) {
-        if (sched->jobs[i].id == job_id) {
-            SEA_LOG_INFO("CRON", "Removed job #%d '%s'",
-                         job_id, sched->jobs[i].name);
-            /* Shift remaining */
-            for (u32 j = i; j < sched->count - 1; j++) {
-                sched->jobs[j] = sched->jobs[j + 1];
-            }
-            sched->count--;
+    pthread_mutex_lock(&sched->lock);
+    i32 slot = find_slot(sched, job_id);
+    if (slot < 0) {
+        pthread_mutex_unlock(&sched->lock);
+        return SEA_ERR_NOT_FOUND;
+    }
 
-            if (sched->db) {
-                char sql[128];
-                snprintf(sql, sizeof(sql),
-                    "DELETE FROM cron_jobs WHERE id = %d;", job_id);
-                sea_db_exec(sched->db, sql);
-            }
-            return SEA_OK;
-        }
+    SEA_LOG_INFO("CRON", "Removed job #%d '%s'", job_id, sched->jobs[slot].name);
+    /* Shift remaining (keeps list order), then re-index the heap */
+    for (u32 j = (u32)slot; j < sched->count - 1; j++) {
+        sched->jobs[j] = sched->jobs[j + 1];
+    }
+    sched->count--;
+    heap_rebuild(sched);
+    arm_timer(sched);
+
+    if (sched->db) {
+        char sql[128];
+        snprintf(sql, sizeof(sql),
+            "DELETE FROM cron_jobs WHERE id = %d;", job_id);
+        sea_db_exec(sched->db, sql);
     }
-    return SEA_ERR_NOT_FOUND;
+    pthread_mutex_unlock(&sched->lock);
+    return SEA_OK;
 }
 
 /* ── Pause / Resume ───────────────────────────────────────── */
 
 SeaError sea_cron_pause(SeaCronScheduler* sched, i32 job_id) {
-    SeaCronJob* job = sea_cron_get(sched, job_id);
-    if (!job) return SEA_ERR_NOT_FOUND;
+    if (!sched) return SEA_ERR_INVALID_INPUT;
+    pthread_mutex_lock(&sched->lock);
+    i32 slot = find_slot(sched, job_id);
+    if (slot < 0) {
+        pthread_mutex_unlock(&sched->lock);
+        return SEA_ERR_NOT_FOUND;
+    }
+    SeaCronJob* job = &sched->jobs[slot];
     job->state = SEA_CRON_PAUSED;
+    heap_remove(sched, (u32)slot);
+    arm_timer(sched);
     SEA_LOG_INFO("CRON", "Paused job #%d '%s'", job_id, job->name);
+    pthread_mutex_unlock(&sched->lock);
     return SEA_OK;
 }
 
+/* Next run after `now` for a recurring job. */
+static u64 next_after(const SeaCronJob* job, u64 now) {
+    if (job->sched_type == SEA_SCHED_CRON) {
+        u64 next;
+        if (sea_cron_next(&job->expr, now, &next) == SEA_OK) return next;
+        return now + 86400;
+    }
+    return now + job->interval_sec;
+}
+
 SeaError sea_cron_resume(SeaCronScheduler* sched, i32 job_id) {
-    SeaCronJob* job = sea_cron_get(sched, job_id);
-    if (!job) return SEA_ERR_NOT_FOUND;
+    if (!sched) return SEA_ERR_INVALID_INPUT;
+    pthread_mutex_lock(&sched->lock);
+    i32 slot = find_slot(sched, job_id);
+    if (slot < 0) {
+        pthread_mutex_unlock(&sched->lock);
+        return SEA_ERR_NOT_FOUND;
+    }
+    SeaCronJob* job = &sched->jobs[slot];
     job->state = SEA_CRON_ACTIVE;
-    job->next_run = now_epoch() + job->interval_sec;
+    job->next_run = next_after(job, now_epoch());
+    heap_push(sched, (u32)slot);
+    arm_timer(sched);
     SEA_LOG_INFO("CRON", "Resumed job #%d '%s'", job_id, job->name);
+    pthread_mutex_unlock(&sched->lock);
+    return SEA_OK;
+}
+
+SeaError sea_cron_set_policy(SeaCronScheduler* sched, i32 job_id,
+                             SeaCronOverlap overlap, u32 timeout_sec) {
+    if (!sched || overlap > SEA_CRON_OVERLAP_ALLOW) return SEA_ERR_INVALID_INPUT;
+    pthread_mutex_lock(&sched->lock);
+    i32 slot = find_slot(sched, job_id);
+    if (slot < 0) {
+        pthread_mutex_unlock(&sched->lock);
+        return SEA_ERR_NOT_FOUND;
+    }
+    SeaCronJob* job = &sched->jobs[slot];
+    job->overlap = overlap;
+    if (timeout_sec) job->timeout_sec = timeout_sec;
+    if (overlap != SEA_CRON_OVERLAP_QUEUE) job->queued = false;
+    pthread_mutex_unlock(&sched->lock);
     return SEA_OK;
 }
 
 /* ── Execute a single job ─────────────────────────────────── */
 
-static void execute_job(SeaCronScheduler* sched, SeaCronJob* job) {
-    u64 start = now_epoch();
+static bool sched_running(SeaCronScheduler* sched) {
+    pthread_mutex_lock(&sched->lock);
+    bool running = sched->running;
+    pthread_mutex_unlock(&sched->lock);
+    return running;
+}
+
+/* Run `/bin/sh -c cmd` in its own process group and wait on a pidfd
+ * (polling where pidfds are unavailable) in 200 ms slices, so a
+ * timeout or shutdown can SIGKILL the whole group. Returns the exit
+ * status, or -1 if it could not be spawned or was killed. */
+static int run_shell(SeaCronScheduler* sched, const char* cmd, u32 timeout_sec,
+                     bool* timed_out) {
+    *timed_out = false;
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+    posix_spawnattr_setpgroup(&attr, 0);
+    char* argv[] = { "sh", "-c", (char*)cmd, NULL };
+    pid_t pid;
+    int rc = posix_spawn(&pid, "/bin/sh", NULL, &attr, argv, environ);
+    posix_spawnattr_destroy(&attr);
+    if (rc != 0) return -1;
+
+    int pfd = (int)syscall(SYS_pidfd_open, pid, 0);
+    u64 deadline = mono_ms() + (u64)timeout_sec * 1000;
+    int status = 0;
+    for (;;) {
+        pid_t done = waitpid(pid, &status, WNOHANG);
+        if (done == pid) break;
+        if (done < 0 && errno != EINTR) { status = -1; break; }
+
+        u64 now = mono_ms();
+        if (now >= deadline || !sched_running(sched)) {
+            *timed_out = now >= deadline;
+            kill(-pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            status = -1;
+            break;
+        }
+        u64 slice = deadline - now < 200 ? deadline - now : 200;
+        if (pfd >= 0) {
+            struct pollfd pf = { .fd = pfd, .events = POLLIN };
+            poll(&pf, 1, (int)slice);
+        } else {
+            usleep(20 * 1000);
+        }
+    }
+    if (pfd >= 0) close(pfd);
+    if (status == -1) return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* Runs without the scheduler lock on a worker (with it when inline).
+ * The job is a snapshot, so table slots may move underneath it. */
+static bool execute_job(SeaCronScheduler* sched, const SeaCronJob* job,
+                        SeaArena* arena, const char** output) {
     bool success = true;
-    const char* output = "ok";
+    *output = "ok";
 
     SEA_LOG_INFO("CRON", "Executing job #%d '%s' [%s]",
                  job->id, job->name, job->command);
 
     switch (job->type) {
         case SEA_CRON_SHELL: {
-            /* Execute shell command and capture exit code */
-            int rc = system(job->command);
-            if (rc != 0) {
+            bool timed_out;
+            int rc = run_shell(sched, job->command, job->timeout_sec, &timed_out);
+            if (timed_out) {
+                success = false;
+                *output = "timeout";
+            } else if (rc != 0) {
                 success = false;
-                output = "non-zero exit";
+                *output = "non-zero exit";
             }
             break;
         }
@@ -280,12 +802,11 @@ static void execute_job(SeaCronScheduler* sched, SeaCronJob* job) {
                 .len = (u32)strlen(job->args)
             };
             SeaSlice result;
-            sea_arena_reset(&sched->arena);
-            SeaError err = sea_tool_exec(job->command, args_slice,
-                                          &sched->arena, &result);
+            sea_arena_reset(arena);
+            SeaError err = sea_tool_exec(job->command, args_slice, arena, &result);
             if (err != SEA_OK) {
                 success = false;
-                output = "tool exec failed";
+                *output = "tool exec failed";
             }
             break;
         }
@@ -309,83 +830,205 @@ static void execute_job(SeaCronScheduler* sched, SeaCronJob* job) {
                                          job->command, (u32)strlen(job->command));
             } else {
                 success = false;
-                output = "no bus";
+                *output = "no bus";
             }
             break;
         }
     }
+    return success;
+}
+
+static bool start_run(SeaCronScheduler* sched, u32 slot);
+
+/* Record a finished run. Caller holds the lock. */
+static void finish_job(SeaCronScheduler* sched, i32 job_id, bool success,
+                       const char* output, u64 duration_ms) {
+    i32 slot = find_slot(sched, job_id);
+    if (slot < 0) return;                        /* Removed while running */
+    SeaCronJob* job = &sched->jobs[slot];
+
+    /* Tool and bus jobs cannot be interrupted; flag overruns after */
+    if (success && job->type != SEA_CRON_SHELL && job->timeout_sec &&
+        duration_ms > (u64)job->timeout_sec * 1000) {
+        success = false;
+        output = "timeout";
+    }
 
-    u64 duration = now_epoch() - start;
+    if (job->in_flight > 0) job->in_flight--;
     job->last_run = now_epoch();
+    job->last_duration_ms = duration_ms;
     job->run_count++;
     if (!success) job->fail_count++;
 
-    /* Schedule next run */
-    if (job->sched_type == SEA_SCHED_ONCE) {
-        job->state = SEA_CRON_COMPLETED;
-    } else {
-        job->next_run = now_epoch() + job->interval_sec;
-    }
-
     /* Log execution */
     if (sched->db) {
-        char sql[1024];
-        snprintf(sql, sizeof(sql),
-            "INSERT INTO cron_log (job_id, job_name, status, output, "
-            "executed_at, duration_ms) VALUES (%d, '%s', '%s', '%s', %llu, %llu);",
-            job->id, job->name, success ? "ok" : "error", output,
-            (unsigned long long)job->last_run,
-            (unsigned long long)(duration * 1000));
-        sea_db_exec(sched->db, sql);
+        sea_db_log_cron(sched->db, job->id, job->name, success ? "ok" : "error",
+                        output, job->last_run, duration_ms);
     }
 
-    SEA_LOG_INFO("CRON", "Job #%d '%s' %s (run #%u, %llus)",
+    SEA_LOG_INFO("CRON", "Job #%d '%s' %s (run #%u, %llums)",
                  job->id, job->name, success ? "OK" : "FAILED",
-                 job->run_count, (unsigned long long)duration);
+                 job->run_count, (unsigned long long)duration_ms);
+
+    if (job->queued && job->in_flight == 0 && job->state == SEA_CRON_ACTIVE) {
+        job->queued = false;
+        start_run(sched, (u32)slot);
+    }
+}
+
+/* Start one run of a job: inline before sea_cron_start(), otherwise
+ * by queueing a snapshot for the pool. Caller holds the lock. */
+static bool start_run(SeaCronScheduler* sched, u32 slot) {
+    SeaCronJob* job = &sched->jobs[slot];
+
+    if (sched->worker_count == 0) {
+        SeaCronJob snapshot = *job;
+        job->in_flight++;
+        const char* output;
+        u64 start = mono_ms();
+        bool ok = execute_job(sched, &snapshot, &sched->arena, &output);
+        finish_job(sched, snapshot.id, ok, output, mono_ms() - start);
+        return true;
+    }
+
+    if (sched->q_len == SEA_CRON_QUEUE_MAX) {
+        SEA_LOG_WARN("CRON", "Run queue full, dropping run of job #%d '%s'",
+                     job->id, job->name);
+        job->skip_count++;
+        return false;
+    }
+    sched->queue[(sched->q_head + sched->q_len) % SEA_CRON_QUEUE_MAX] = *job;
+    sched->q_len++;
+    job->in_flight++;
+    pthread_cond_signal(&sched->work_cond);
+    return true;
+}
+
+/* ── Worker Pool ──────────────────────────────────────────── */
+
+static void* worker_main(void* arg) {
+    SeaCronWorker* w = (SeaCronWorker*)arg;
+    SeaCronScheduler* sched = w->sched;
+
+    pthread_mutex_lock(&sched->lock);
+    for (;;) {
+        while (sched->running && sched->q_len == 0) {
+            pthread_cond_wait(&sched->work_cond, &sched->lock);
+        }
+        if (!sched->running) break;          /* Queued runs are dropped */
+
+        SeaCronJob job = sched->queue[sched->q_head];
+        sched->q_head = (sched->q_head + 1) % SEA_CRON_QUEUE_MAX;
+        sched->q_len--;
+        sched->active_runs++;
+        pthread_mutex_unlock(&sched->lock);
+
+        sea_arena_reset(&w->arena);
+        const char* output;
+        u64 start = mono_ms();
+        bool ok = execute_job(sched, &job, &w->arena, &output);
+        u64 elapsed = mono_ms() - start;
+
+        pthread_mutex_lock(&sched->lock);
+        sched->active_runs--;
+        finish_job(sched, job.id, ok, output, elapsed);
+    }
+    pthread_mutex_unlock(&sched->lock);
+    return NULL;
 }
 
 /* ── Tick ─────────────────────────────────────────────────── */
 
 u32 sea_cron_tick(SeaCronScheduler* sched) {
-    if (!sched || !sched->running) return 0;
+    if (!sched || !sched->jobs) return 0;
+
+    pthread_mutex_lock(&sched->lock);
+    if (!sched->running) {
+        pthread_mutex_unlock(&sched->lock);
+        return 0;
+    }
 
     sched->tick_count++;
     u64 now = now_epoch();
     u32 executed = 0;
 
-    for (u32 i = 0; i < sched->count; i++) {
-        SeaCronJob* job = &sched->jobs[i];
-        if (job->state != SEA_CRON_ACTIVE) continue;
-        if (now < job->next_run) continue;
+    /* Pop due jobs first, then start them, so a job rescheduled to
+     * `now` cannot be picked up twice in one tick. */
+    u32 due[64];
+    for (;;) {
+        u32 n = 0;
+        while (n < 64 && sched->heap_len > 0 &&
+               sched->jobs[sched->heap[0]].next_run <= now) {
+            u32 slot = sched->heap[0];
+            heap_remove(sched, slot);
+            due[n++] = (u32)sched->jobs[slot].id;
+        }
+        if (n == 0) break;
+
+        for (u32 i = 0; i < n; i++) {
+            i32 slot = find_slot(sched, (i32)due[i]);
+            if (slot < 0) continue;
+            SeaCronJob* job = &sched->jobs[slot];
+            if (job->state != SEA_CRON_ACTIVE) continue;
 
-        execute_job(sched, job);
-        executed++;
+            /* Reschedule before running, so a slow run never delays the
+             * next one. Intervals keep their phase; runs missed while
+             * the process was down are skipped, not replayed. */
+            if (job->sched_type == SEA_SCHED_ONCE) {
+                job->state = SEA_CRON_COMPLETED;
+            } else {
+                u64 next = job->sched_type == SEA_SCHED_INTERVAL
+                         ? job->next_run + job->interval_sec : next_after(job, now);
+                if (next <= now) next = next_after(job, now);
+                job->next_run = next;
+                heap_push(sched, (u32)slot);
+            }
+
+            if (job->in_flight > 0 && job->overlap != SEA_CRON_OVERLAP_ALLOW) {
+                if (job->overlap == SEA_CRON_OVERLAP_QUEUE && !job->queued) {
+                    job->queued = true;
+                } else {
+                    job->skip_count++;
+                    SEA_LOG_DEBUG("CRON", "Job #%d '%s' still running, skipped",
+                                  job->id, job->name);
+                }
+                continue;
+            }
+            if (start_run(sched, (u32)slot)) executed++;
+        }
     }
 
+    arm_timer(sched);
+    pthread_mutex_unlock(&sched->lock);
     return executed;
 }
 
 /* ── Lookup ───────────────────────────────────────────────── */
 
-SeaCronJob* sea_cron_get(SeaCronScheduler* sched, i32 job_id) {
-    if (!sched) return NULL;
-    for (u32 i = 0; i < sched->count; i++) {
-        if (sched->jobs[i].id == job_id) return &sched->jobs[i];
-    }
-    return NULL;
+bool sea_cron_get(SeaCronScheduler* sched, i32 job_id, SeaCronJob* out) {
+    if (!sched || !out || !sched->jobs) return false;
+    pthread_mutex_lock(&sched->lock);
+    i32 slot = find_slot(sched, job_id);
+    if (slot >= 0) *out = sched->jobs[slot];
+    pthread_mutex_unlock(&sched->lock);
+    return slot >= 0;
 }
 
-u32 sea_cron_list(SeaCronScheduler* sched, SeaCronJob** out, u32 max_count) {
-    if (!sched || !out) return 0;
+u32 sea_cron_list(SeaCronScheduler* sched, SeaCronJob* out, u32 max_count) {
+    if (!sched || !out || !sched->jobs) return 0;
+    pthread_mutex_lock(&sched->lock);
     u32 count = sched->count < max_count ? sched->count : max_count;
-    for (u32 i = 0; i < count; i++) {
-        out[i] = &sched->jobs[i];
-    }
+    memcpy(out, sched->jobs, count * sizeof(SeaCronJob));
+    pthread_mutex_unlock(&sched->lock);
     return count;
 }
 
 u32 sea_cron_count(SeaCronScheduler* sched) {
-    return sched ? sched->count : 0;
+    if (!sched || !sched->jobs) return 0;
+    pthread_mutex_lock(&sched->lock);
+    u32 count = sched->count;
+    pthread_mutex_unlock(&sched->lock);
+    return count;
 }
 
 /* ── Save / Load ──────────────────────────────────────────── */
@@ -3,26 +3,40 @@
  *
  * Tool ID:    40
  * Category:   File I/O / Security
- * Args:       <filepath>
- * Returns:    CRC32 and FNV-1a checksums of the file contents
+ * Args:       <filepath> [crc32|crc32c|xxh64|fnv1a|sha256|all ...]
+ * Returns:    Size and the selected checksums (default: CRC32 and FNV-1a)
  *
- * Useful for verifying file integrity and detecting changes.
+ * Useful for verifying file integrity and detecting changes. The file
+ * is memory-mapped and hashed in one pass; CRC32, CRC32C and SHA-256
+ * use CPU instructions when available (see sea_hash.h).
  *
  * Examples:
  *   /exec checksum_file /root/seaclaw/sea_claw
- *   /exec checksum_file /etc/hostname
+ *   /exec checksum_file /etc/hostname sha256
+ *   /exec checksum_file /var/log/syslog all
  *
  * Security: File path validated by Shield. Read-only operation.
  */
 
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_hash.h"
 #include <stdio.h>
 #include <string.h>
 
+static u32 parse_algo(const char* name) {
+    if (strcmp(name, "crc32") == 0)  return SEA_HASH_CRC32;
+    if (strcmp(name, "crc32c") == 0) return SEA_HASH_CRC32C;
+    if (strcmp(name, "xxh64") == 0)  return SEA_HASH_XXH64;
+    if (strcmp(name, "fnv1a") == 0)  return SEA_HASH_FNV1A;
+    if (strcmp(name, "sha256") == 0) return SEA_HASH_SHA256;
+    if (strcmp(name, "all") == 0)    return SEA_HASH_ALL;
+    return 0;
+}
+
 SeaError tool_checksum_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     if (args.len == 0) {
-        *output = SEA_SLICE_LIT("Usage: <filepath>");
+        *output = SEA_SLICE_LIT("Usage: <filepath> [crc32|crc32c|xxh64|fnv1a|sha256|all ...]");
         return SEA_OK;
     }
 
@@ -35,14 +49,26 @@ SeaError tool_checksum_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     char* end = p + strlen(p) - 1;
     while (end > p && (*end == ' ' || *end == '\n')) *end-- = '\0';
 
+    /* Trailing words naming algorithms select what to compute */
+    u32 algos = 0;
+    char* sp;
+    while ((sp = strrchr(p, ' ')) != NULL) {
+        u32 a = parse_algo(sp + 1);
+        if (!a) break;
+        algos |= a;
+        *sp = '\0';
+        while (sp > p && sp[-1] == ' ') *--sp = '\0';
+    }
+    if (!algos) algos = SEA_HASH_CRC32 | SEA_HASH_FNV1A;
+
     SeaSlice ps = { .data = (const u8*)p, .len = (u32)strlen(p) };
     if (sea_shield_detect_injection(ps)) {
         *output = SEA_SLICE_LIT("Error: path rejected by Shield");
         return SEA_OK;
     }
 
-    FILE* fp = fopen(p, "rb");
-    if (!fp) {
+    SeaHashDigest d;
+    if (sea_hash_file(p, algos, &d) != SEA_OK) {
         char buf[256];
         int len = snprintf(buf, sizeof(buf), "Error: cannot open '%s'", p);
         u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)len);
@@ -50,32 +76,27 @@ SeaError tool_checksum_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         return SEA_OK;
     }
 
-    u32 crc = 0xFFFFFFFF;
-    u64 fnv = 0xcbf29ce484222325ULL;
-    u64 total = 0;
-    u8 buf[4096];
-    size_t n;
-
-    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
-        total += n;
-        for (size_t i = 0; i < n; i++) {
-            crc ^= buf[i];
-            for (int j = 0; j < 8; j++)
-                crc = (crc >> 1) ^ (0xEDB88320 & (-(crc & 1)));
-            fnv ^= buf[i];
-            fnv *= 0x100000001b3ULL;
-        }
+    char out[1536];
+    int len = snprintf(out, sizeof(out), "File: %s\n  Size:   %lu bytes",
+                       p, (unsigned long)d.size);
+    if (algos & SEA_HASH_CRC32)
+        len += snprintf(out + len, sizeof(out) - (size_t)len, "\n  CRC32:  %08x  (%s)",
+                        d.crc32, sea_hash_impl(SEA_HASH_CRC32));
+    if (algos & SEA_HASH_CRC32C)
+        len += snprintf(out + len, sizeof(out) - (size_t)len, "\n  CRC32C: %08x  (%s)",
+                        d.crc32c, sea_hash_impl(SEA_HASH_CRC32C));
+    if (algos & SEA_HASH_XXH64)
+        len += snprintf(out + len, sizeof(out) - (size_t)len, "\n  XXH64:  %016llx",
+                        (unsigned long long)d.xxh64);
+    if (algos & SEA_HASH_FNV1A)
+        len += snprintf(out + len, sizeof(out) - (size_t)len, "\n  FNV-1a: %016llx",
+                        (unsigned long long)d.fnv1a);
+    if (algos & SEA_HASH_SHA256) {
+        char hex[65];
+        sea_hash_hex(d.sha256, 32, hex);
+        len += snprintf(out + len, sizeof(out) - (size_t)len, "\n  SHA256: %s  (%s)",
+                        hex, sea_hash_impl(SEA_HASH_SHA256));
     }
-    fclose(fp);
-    crc = ~crc;
-
-    char out[256];
-    int len = snprintf(out, sizeof(out),
-        "File: %s\n"
-        "  Size:   %lu bytes\n"
-        "  CRC32:  %08x\n"
-        "  FNV-1a: %016llx",
-        p, (unsigned long)total, crc, (unsigned long long)fnv);
 
     u8* dst = (u8*)sea_arena_push_bytes(arena, out, (u64)len);
     if (!dst) return SEA_ERR_ARENA_FULL;
@@ -4,24 +4,63 @@
  * Tool ID:    50
  * Category:   Development / Utility
  * Args:       [directory] [extension]
- * Returns:    Line counts per file and total, like cloc/sloccount
+ * Returns:    Line counts for the largest files and the total, like cloc/sloccount
  *
  * Default: current directory, all .c and .h files
  *
+ * Files are found and counted by the parallel walker (sea_walk): each
+ * file is read exactly once and newlines are counted with SIMD.
+ *
  * Examples:
  *   /exec count_lines /root/seaclaw/src
  *   /exec count_lines /root/seaclaw/src .c
  *   /exec count_lines /root/seaclaw/include .h
  *
- * Security: Directory path validated by Shield. Read-only.
+ * Security: Directory path validated by Shield. Read-only. No shell.
  */
 
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_walk.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define MAX_OUTPUT 8192
+#define TOP_FILES  30
+
+typedef struct {
+    u64  lines;
+    char path[224];
+} TopFile;
+
+typedef struct {
+    TopFile top[TOP_FILES];
+    u32     count;
+} CountCtx;
+
+/* Keep the TOP_FILES largest files; replace the current minimum. */
+static bool on_file(const SeaWalkEntry* e, void* ctx) {
+    CountCtx* cc = (CountCtx*)ctx;
+    u32 slot;
+    if (cc->count < TOP_FILES) {
+        slot = cc->count++;
+    } else {
+        slot = 0;
+        for (u32 i = 1; i < TOP_FILES; i++) {
+            if (cc->top[i].lines < cc->top[slot].lines) slot = i;
+        }
+        if (e->lines <= cc->top[slot].lines) return true;
+    }
+    cc->top[slot].lines = e->lines;
+    snprintf(cc->top[slot].path, sizeof(cc->top[slot].path), "%s", e->path);
+    return true;
+}
+
+static int cmp_lines(const void* a, const void* b) {
+    u64 la = ((const TopFile*)a)->lines, lb = ((const TopFile*)b)->lines;
+    return (la > lb) - (la < lb);
+}
 
 SeaError tool_count_lines(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     char dir[256] = ".";
@@ -41,37 +80,40 @@ SeaError tool_count_lines(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         return SEA_OK;
     }
 
-    char cmd[512];
+    CountCtx* cc = (CountCtx*)sea_arena_alloc(arena, sizeof(CountCtx), 8);
+    char* buf = (char*)sea_arena_alloc(arena, MAX_OUTPUT, 1);
+    if (!cc || !buf) return SEA_ERR_ARENA_FULL;
+    cc->count = 0;
+
+    SeaWalkOpts opts = {
+        .root  = dir,
+        .flags = SEA_WALK_FILES_ONLY | SEA_WALK_COUNT_LINES,
+        .visit = on_file,
+        .ctx   = cc,
+    };
     if (ext[0]) {
-        snprintf(cmd, sizeof(cmd),
-            "find '%s' -name '*%s' -type f | xargs wc -l 2>/dev/null | sort -n | tail -30",
-            dir, ext);
+        opts.exts[0] = ext;
     } else {
-        snprintf(cmd, sizeof(cmd),
-            "find '%s' \\( -name '*.c' -o -name '*.h' \\) -type f | xargs wc -l 2>/dev/null | sort -n | tail -30",
-            dir);
+        opts.exts[0] = ".c";
+        opts.exts[1] = ".h";
     }
 
-    FILE* fp = popen(cmd, "r");
-    if (!fp) {
+    SeaWalkStats st;
+    if (sea_walk(&opts, &st) != SEA_OK) {
         *output = SEA_SLICE_LIT("Error: line count failed");
         return SEA_OK;
     }
 
-    char* buf = (char*)sea_arena_alloc(arena, MAX_OUTPUT, 1);
-    if (!buf) { pclose(fp); return SEA_ERR_ARENA_FULL; }
-
-    int pos = snprintf(buf, MAX_OUTPUT, "Lines of code in %s%s%s:\n",
-                       dir, ext[0] ? " (*" : "", ext[0] ? ext : "");
-    if (ext[0]) pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "):\n") - 2;
+    qsort(cc->top, cc->count, sizeof(TopFile), cmp_lines);
 
-    char line[512];
-    while (fgets(line, sizeof(line), fp) && pos < MAX_OUTPUT - 512) {
-        u32 llen = (u32)strlen(line);
-        memcpy(buf + pos, line, llen);
-        pos += (int)llen;
+    int pos = snprintf(buf, MAX_OUTPUT, "Lines of code in %s%s%s%s:\n",
+                       dir, ext[0] ? " (*" : "", ext, ext[0] ? ")" : "");
+    for (u32 i = 0; i < cc->count && pos < MAX_OUTPUT - 512; i++) {
+        pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "%8lu %s\n",
+                        (unsigned long)cc->top[i].lines, cc->top[i].path);
     }
-    pclose(fp);
+    pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "%8lu total (%lu files)\n",
+                    (unsigned long)st.lines, (unsigned long)st.matched);
 
     output->data = (const u8*)buf;
     output->len  = (u32)pos;
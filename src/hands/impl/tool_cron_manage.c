@@ -7,6 +7,8 @@
  *   remove <id>                   — Remove a job by ID
  *   pause <id>                    — Pause a job
  *   resume <id>                   — Resume a job
+ *   policy <id> skip|queue|allow [timeout_sec]
+ *                                 — Overlap policy and run timeout
  */
 
 #include "seaclaw/sea_tools.h"
@@ -22,7 +24,8 @@ SeaError tool_cron_manage(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     if (args.len == 0) {
         *output = SEA_SLICE_LIT(
             "Usage: list | add <name> <schedule> <command> | "
-            "remove <id> | pause <id> | resume <id>");
+            "remove <id> | pause <id> | resume <id> | "
+            "policy <id> skip|queue|allow [timeout_sec]");
         return SEA_OK;
     }
 
@@ -46,18 +49,26 @@ SeaError tool_cron_manage(SeaSlice args, SeaArena* arena, SeaSlice* output) {
             pos = snprintf(result, 4096, "No cron jobs scheduled.");
         } else {
             pos = snprintf(result, 4096, "Cron jobs (%u):\n", count);
-            SeaCronJob* jobs[SEA_MAX_CRON_JOBS];
-            u32 n = sea_cron_list(s_cron, jobs, SEA_MAX_CRON_JOBS);
+            /* The reply holds ~40 lines; copy no more jobs than that */
+            u32 max = count < 64 ? count : 64;
+            SeaCronJob* jobs = (SeaCronJob*)sea_arena_alloc(arena, max * sizeof(SeaCronJob), 8);
+            if (!jobs) return SEA_ERR_ARENA_FULL;
+            u32 n = sea_cron_list(s_cron, jobs, max);
             for (u32 i = 0; i < n && pos < 3900; i++) {
+                const SeaCronJob* job = &jobs[i];
                 const char* state = "active";
-                if (jobs[i]->state == SEA_CRON_PAUSED) state = "paused";
-                else if (jobs[i]->state == SEA_CRON_COMPLETED) state = "completed";
-                else if (jobs[i]->state == SEA_CRON_FAILED) state = "failed";
+                if (job->state == SEA_CRON_PAUSED) state = "paused";
+                else if (job->state == SEA_CRON_COMPLETED) state = "completed";
+                else if (job->state == SEA_CRON_FAILED) state = "failed";
+                static const char* overlap[] = { "skip", "queue", "allow" };
 
                 pos += snprintf(result + pos, 4096 - (size_t)pos,
-                    "  #%d %s [%s] %s — runs: %u, cmd: %s\n",
-                    jobs[i]->id, jobs[i]->name, state,
-                    jobs[i]->schedule, jobs[i]->run_count, jobs[i]->command);
+                    "  #%d %s [%s] %s — runs: %u (%u failed, %u skipped, last %llums), "
+                    "overlap: %s, cmd: %s\n",
+                    job->id, job->name, state,
+                    job->schedule, job->run_count, job->fail_count,
+                    job->skip_count, (unsigned long long)job->last_duration_ms,
+                    overlap[job->overlap], job->command);
             }
         }
     } else if (strncmp(buf, "add ", 4) == 0) {
@@ -118,9 +129,29 @@ SeaError tool_cron_manage(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         } else {
             pos = snprintf(result, 4096, "Error: job #%d not found", id);
         }
+    } else if (strncmp(buf, "policy ", 7) == 0) {
+        char mode[16] = "";
+        int id = 0;
+        unsigned timeout = 0;
+        int n = sscanf(buf + 7, "%d %15s %u", &id, mode, &timeout);
+        SeaCronOverlap ov = SEA_CRON_OVERLAP_SKIP;
+        bool valid = n >= 2;
+        if (strcmp(mode, "queue") == 0) ov = SEA_CRON_OVERLAP_QUEUE;
+        else if (strcmp(mode, "allow") == 0) ov = SEA_CRON_OVERLAP_ALLOW;
+        else if (strcmp(mode, "skip") != 0) valid = false;
+
+        if (!valid) {
+            pos = snprintf(result, 4096,
+                "Error: usage: policy <id> skip|queue|allow [timeout_sec]");
+        } else if (sea_cron_set_policy(s_cron, id, ov, timeout) == SEA_OK) {
+            pos = snprintf(result, 4096, "Cron job #%d: overlap %s%s", id, mode,
+                           timeout ? ", timeout updated" : "");
+        } else {
+            pos = snprintf(result, 4096, "Error: job #%d not found", id);
+        }
     } else {
         pos = snprintf(result, 4096,
-            "Unknown subcommand. Use: list | add | remove | pause | resume");
+            "Unknown subcommand. Use: list | add | remove | pause | resume | policy");
     }
 
     output->data = (const u8*)result;
@@ -4,7 +4,8 @@
  * Tool ID:    33
  * Category:   System / Utility
  * Args:       <cron_expression>
- * Returns:    Human-readable explanation of the schedule
+ * Returns:    Human-readable explanation of the schedule and its next
+ *             five run times (via sea_cron_compile / sea_cron_next)
  *
  * Format: minute hour day_of_month month day_of_week
  *
@@ -17,8 +18,10 @@
  */
 
 #include "seaclaw/sea_tools.h"
+#include "seaclaw/sea_cron.h"
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 static int str_to_int(const char* s) {
     int v = 0, neg = 0;
@@ -56,6 +59,28 @@ SeaError tool_cron_parse(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     memcpy(input, args.data, ilen);
     input[ilen] = '\0';
 
+    SeaCronExpr expr;
+    if (sea_cron_compile(input, &expr) != SEA_OK) {
+        *output = SEA_SLICE_LIT("Error: invalid cron expression. Expected 5 fields "
+                                "(minute hour day month dow) or @hourly/@daily/@weekly/@monthly/@yearly");
+        return SEA_OK;
+    }
+    if (input[0] == '@') {
+        /* Explain shorthands through their expansion */
+        static const char* EXPAND[][2] = {
+            { "@yearly", "0 0 1 1 *" }, { "@annually", "0 0 1 1 *" },
+            { "@monthly", "0 0 1 * *" }, { "@weekly", "0 0 * * 0" },
+            { "@daily", "0 0 * * *" }, { "@midnight", "0 0 * * *" },
+            { "@hourly", "0 * * * *" },
+        };
+        for (u32 i = 0; i < sizeof(EXPAND) / sizeof(EXPAND[0]); i++) {
+            if (strncmp(input, EXPAND[i][0], strlen(EXPAND[i][0])) == 0) {
+                snprintf(input, sizeof(input), "%s", EXPAND[i][1]);
+                break;
+            }
+        }
+    }
+
     char minute[32] = "*", hour[32] = "*", dom[32] = "*", month[32] = "*", dow[32] = "*";
     sscanf(input, "%31s %31s %31s %31s %31s", minute, hour, dom, month, dow);
 
@@ -113,6 +138,21 @@ SeaError tool_cron_parse(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         "  Month:        %s\n  Day of Week:  %s",
         minute, hour, dom, month, dow);
 
+    pos += snprintf(buf + pos, sizeof(buf) - (size_t)pos, "\n\nNext runs:");
+    u64 t = (u64)time(NULL);
+    for (int i = 0; i < 5; i++) {
+        if (sea_cron_next(&expr, t, &t) != SEA_OK) {
+            if (i == 0) pos += snprintf(buf + pos, sizeof(buf) - (size_t)pos, "\n  (never)");
+            break;
+        }
+        time_t tt = (time_t)t;
+        struct tm tm;
+        char when[32];
+        localtime_r(&tt, &tm);
+        strftime(when, sizeof(when), "%a %Y-%m-%d %H:%M", &tm);
+        pos += snprintf(buf + pos, sizeof(buf) - (size_t)pos, "\n  %s", when);
+    }
+
     u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)pos);
     if (!dst) return SEA_ERR_ARENA_FULL;
     output->data = dst; output->len = (u32)pos;
@@ -4,7 +4,11 @@
  * Tool ID:    27
  * Category:   Text Processing
  * Args:       <text1>|||<text2>  (separated by |||)
- * Returns:    Line-by-line comparison showing additions/removals
+ * Returns:    Unified diff (3 lines of context) and a change summary
+ *
+ * Uses the Myers diff engine (sea_diff), so an inserted or deleted
+ * line shows up as exactly that rather than shifting everything after
+ * it. Input size is bounded only by the request arena.
  *
  * Examples:
  *   /exec diff_text "hello world"|||"hello earth"
@@ -14,22 +18,22 @@
  */
 
 #include "seaclaw/sea_tools.h"
+#include "seaclaw/sea_diff.h"
 #include <stdio.h>
 #include <string.h>
 
 #define MAX_OUTPUT 8192
-#define MAX_LINES  100
+#define CONTEXT    3
 
-static u32 split_lines(char* text, char** lines, u32 max) {
-    u32 count = 0;
-    char* tok = text;
-    while (tok && count < max) {
-        lines[count] = tok;
-        char* nl = strchr(tok, '\n');
-        if (nl) { *nl = '\0'; tok = nl + 1; } else tok = NULL;
-        count++;
-    }
-    return count;
+/* Trim spaces and one pair of surrounding double quotes */
+static void trim_text(char** start, char** end) {
+    char* s = *start;
+    char* e = *end;
+    while (s < e && (*s == ' ' || *s == '\t')) s++;
+    while (e > s && (e[-1] == ' ' || e[-1] == '\t')) e--;
+    if (e - s >= 2 && *s == '"' && e[-1] == '"') { s++; e--; }
+    *start = s;
+    *end = e;
 }
 
 SeaError tool_diff_text(SeaSlice args, SeaArena* arena, SeaSlice* output) {
@@ -38,15 +42,19 @@ SeaError tool_diff_text(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         return SEA_OK;
     }
 
-    char* input = (char*)sea_arena_alloc(arena, args.len + 1, 1);
+    /* Copy with \n unescaped in one pass; +2 leaves room for newlines */
+    char* input = (char*)sea_arena_alloc(arena, (u64)args.len + 2, 1);
     if (!input) return SEA_ERR_ARENA_FULL;
-    memcpy(input, args.data, args.len);
-    input[args.len] = '\0';
-
-    /* Unescape \n */
-    for (u32 i = 0; input[i]; i++) {
-        if (input[i] == '\\' && input[i+1] == 'n') { input[i] = '\n'; memmove(input+i+1, input+i+2, strlen(input+i+2)+1); }
+    u32 n = 0;
+    for (u32 i = 0; i < args.len; i++) {
+        if (args.data[i] == '\\' && i + 1 < args.len && args.data[i + 1] == 'n') {
+            input[n++] = '\n';
+            i++;
+        } else {
+            input[n++] = (char)args.data[i];
+        }
     }
+    input[n] = '\0';
 
     /* Split on ||| */
     char* sep = strstr(input, "|||");
@@ -54,35 +62,47 @@ SeaError tool_diff_text(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         *output = SEA_SLICE_LIT("Error: use ||| to separate the two texts");
         return SEA_OK;
     }
-    *sep = '\0';
-    char* text1 = input;
-    char* text2 = sep + 3;
-
-    char* lines1[MAX_LINES], *lines2[MAX_LINES];
-    u32 n1 = split_lines(text1, lines1, MAX_LINES);
-    u32 n2 = split_lines(text2, lines2, MAX_LINES);
-
-    char* buf = (char*)sea_arena_alloc(arena, MAX_OUTPUT, 1);
-    if (!buf) return SEA_ERR_ARENA_FULL;
+    char* t1 = input;
+    char* e1 = sep;
+    char* t2 = sep + 3;
+    char* e2 = input + n;
+    trim_text(&t1, &e1);
+    trim_text(&t2, &e2);
 
-    int pos = snprintf(buf, MAX_OUTPUT, "Diff (%u vs %u lines):\n", n1, n2);
-    u32 changes = 0;
-    u32 max = n1 > n2 ? n1 : n2;
+    /* Inline texts rarely end in a newline; treat both as terminated so
+     * the last line compares equal and needs no end-of-file marker. The
+     * separator and the spare byte make room for it. */
+    if (e1 > t1 && e1[-1] != '\n') *e1++ = '\n';
+    if (e2 > t2 && e2[-1] != '\n') *e2++ = '\n';
 
-    for (u32 i = 0; i < max && pos < MAX_OUTPUT - 256; i++) {
-        const char* l1 = (i < n1) ? lines1[i] : NULL;
-        const char* l2 = (i < n2) ? lines2[i] : NULL;
+    SeaDiff diff;
+    SeaError err = sea_diff_lines((const u8*)t1, (u64)(e1 - t1), (const u8*)t2, (u64)(e2 - t2),
+                                  arena, &diff);
+    if (err == SEA_ERR_ARENA_FULL) {
+        *output = SEA_SLICE_LIT("Error: texts too large to diff");
+        return SEA_OK;
+    }
+    if (err != SEA_OK) return err;
 
-        if (l1 && l2 && strcmp(l1, l2) == 0) {
-            pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "  %3u   %s\n", i + 1, l1);
-        } else {
-            if (l1) pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "- %3u   %s\n", i + 1, l1);
-            if (l2) pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "+ %3u   %s\n", i + 1, l2);
-            changes++;
-        }
+    if (diff.change_count == 0) {
+        char msg[64];
+        int len = snprintf(msg, sizeof(msg), "No differences (%u lines)", diff.a_count);
+        u8* dst = (u8*)sea_arena_push_bytes(arena, msg, (u64)len);
+        if (!dst) return SEA_ERR_ARENA_FULL;
+        output->data = dst; output->len = (u32)len;
+        return SEA_OK;
     }
 
-    pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "(%u lines changed)", changes);
+    SeaSlice body;
+    err = sea_diff_unified(&diff, "text1", "text2", CONTEXT, MAX_OUTPUT - 128, arena, &body);
+    if (err != SEA_OK) return err;
+
+    char* buf = (char*)sea_arena_alloc(arena, (u64)body.len + 128, 1);
+    if (!buf) return SEA_ERR_ARENA_FULL;
+    memcpy(buf, body.data, body.len);
+    int pos = (int)body.len;
+    pos += snprintf(buf + pos, 128, "(%u vs %u lines: %u removed, %u added)",
+                    diff.a_count, diff.b_count, diff.removed, diff.added);
 
     output->data = (const u8*)buf;
     output->len  = (u32)pos;
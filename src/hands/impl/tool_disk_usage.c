@@ -6,6 +6,9 @@
  * Args:       [path] (default: /)
  * Returns:    Disk usage for the given path and overall filesystem stats
  *
+ * When an explicit directory is given, its tree is also summed with the
+ * parallel walker (sea_walk), staying on the same filesystem like du -x.
+ *
  * Examples:
  *   /exec disk_usage
  *   /exec disk_usage /root/seaclaw
@@ -16,8 +19,10 @@
 
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_walk.h"
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/statvfs.h>
 
 #define MAX_OUTPUT 2048
@@ -87,6 +92,29 @@ SeaError tool_disk_usage(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         (unsigned long)st.f_files,
         st.f_files > 0 ? (double)(st.f_files - st.f_ffree) / (double)st.f_files * 100.0 : 0);
 
+    /* Tree totals for an explicit directory (never for the default "/") */
+    struct stat ds;
+    if (args.len > 0 && strcmp(path, "/") != 0 &&
+        stat(path, &ds) == 0 && S_ISDIR(ds.st_mode)) {
+        SeaWalkOpts opts = { .root = path, .flags = SEA_WALK_STAT | SEA_WALK_XDEV };
+        SeaWalkStats ws;
+        if (sea_walk(&opts, &ws) == SEA_OK) {
+            char ap[32], dk[32];
+            len += snprintf(buf + len, sizeof(buf) - (size_t)len,
+                "\nTree: %s\n"
+                "  Files:     %lu\n"
+                "  Dirs:      %lu\n"
+                "  Apparent:  %s\n"
+                "  On disk:   %s%s",
+                path,
+                (unsigned long)ws.files,
+                (unsigned long)ws.dirs,
+                human_size(ws.bytes, ap, sizeof(ap)),
+                human_size(ws.disk_bytes, dk, sizeof(dk)),
+                ws.errors ? " (some entries unreadable)" : "");
+        }
+    }
+
     u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)len);
     if (!dst) return SEA_ERR_ARENA_FULL;
     output->data = dst; output->len = (u32)len;
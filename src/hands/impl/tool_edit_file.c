@@ -1,20 +1,50 @@
 /*
  * tool_edit_file.c — Surgical find-and-replace within files
  *
- * Args: <filepath>|||<find>|||<replace>
+ * Args: [--preview] <filepath>|||<find>|||<replace>
  * Reads the file, replaces first occurrence of <find> with <replace>,
- * writes back. Returns confirmation or error.
+ * writes back. Returns confirmation and a unified diff of the change.
+ * With --preview the file is left untouched and only the diff is shown.
  */
 
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_diff.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define DIFF_OUTPUT  4096
+#define DIFF_CONTEXT 3
+
+/* Unified diff of old → new, copied into the tool arena. Diff working
+ * memory is sized to the file and lives in its own scratch arena so a
+ * large file cannot exhaust the request arena. */
+static SeaSlice edit_diff(const char* path, const char* old_text, size_t old_len,
+                          const char* new_text, size_t new_len, SeaArena* arena) {
+    SeaSlice none = { .data = NULL, .len = 0 };
+    SeaArena scratch;
+    if (sea_arena_create(&scratch, 64 * (u64)(old_len + new_len) + 64 * 1024) != SEA_OK) return none;
+
+    SeaDiff diff;
+    SeaSlice text = none;
+    if (sea_diff_lines((const u8*)old_text, old_len, (const u8*)new_text, new_len,
+                       &scratch, &diff) == SEA_OK) {
+        sea_diff_unified(&diff, path, path, DIFF_CONTEXT, DIFF_OUTPUT, &scratch, &text);
+    }
+
+    SeaSlice result = none;
+    if (text.len) {
+        u8* dst = (u8*)sea_arena_push_bytes(arena, text.data, text.len);
+        if (dst) { result.data = dst; result.len = text.len; }
+    }
+    sea_arena_destroy(&scratch);
+    return result;
+}
+
 SeaError tool_edit_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     if (args.len == 0) {
-        *output = SEA_SLICE_LIT("Usage: <filepath>|||<find>|||<replace>");
+        *output = SEA_SLICE_LIT("Usage: [--preview] <filepath>|||<find>|||<replace>");
         return SEA_OK;
     }
 
@@ -23,8 +53,17 @@ SeaError tool_edit_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     memcpy(buf, args.data, len);
     buf[len] = '\0';
 
+    char* start = buf;
+    bool preview = false;
+    while (*start == ' ') start++;
+    if (strncmp(start, "--preview ", 10) == 0) {
+        preview = true;
+        start += 10;
+        while (*start == ' ') start++;
+    }
+
     /* Parse three fields separated by ||| */
-    char* sep1 = strstr(buf, "|||");
+    char* sep1 = strstr(start, "|||");
     if (!sep1) {
         *output = SEA_SLICE_LIT("Error: expected <filepath>|||<find>|||<replace>");
         return SEA_OK;
@@ -40,7 +79,7 @@ SeaError tool_edit_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     *sep2 = '\0';
     char* replace_str = sep2 + 3;
 
-    char* filepath = buf;
+    char* filepath = start;
 
     /* Security: check path */
     SeaSlice path_slice = { .data = (const u8*)filepath, .len = (u32)strlen(filepath) };
@@ -94,6 +133,21 @@ SeaError tool_edit_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
            match + find_len, rd - prefix_len - find_len);
     new_content[new_size] = '\0';
 
+    SeaSlice diff = edit_diff(filepath, content, rd, new_content, new_size, arena);
+
+    if (preview) {
+        char head[320];
+        int hlen = snprintf(head, sizeof(head), "Preview of %s (not written):\n", filepath);
+        if (hlen >= (int)sizeof(head)) hlen = (int)sizeof(head) - 1;
+        char* result = (char*)sea_arena_alloc(arena, (u64)hlen + diff.len + 1, 1);
+        if (!result) return SEA_ERR_ARENA_FULL;
+        memcpy(result, head, (size_t)hlen);
+        if (diff.len) memcpy(result + hlen, diff.data, diff.len);
+        output->data = (const u8*)result;
+        output->len = (u32)hlen + diff.len;
+        return SEA_OK;
+    }
+
     /* Write back */
     f = fopen(filepath, "w");
     if (!f) {
@@ -104,12 +158,14 @@ SeaError tool_edit_file(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     fclose(f);
 
     /* Result */
-    char* result = (char*)sea_arena_alloc(arena, 256, 1);
+    char* result = (char*)sea_arena_alloc(arena, 256 + (u64)diff.len, 1);
     if (!result) return SEA_ERR_ARENA_FULL;
     int rlen = snprintf(result, 256,
-        "Edited %s: replaced %zu bytes with %zu bytes",
+        "Edited %s: replaced %zu bytes with %zu bytes\n",
         filepath, find_len, replace_len);
+    if (rlen > 255) rlen = 255;
+    if (diff.len) memcpy(result + rlen, diff.data, diff.len);
     output->data = (const u8*)result;
-    output->len = (u32)rlen;
+    output->len = (u32)rlen + diff.len;
     return SEA_OK;
 }
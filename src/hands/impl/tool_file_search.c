@@ -6,23 +6,44 @@
  * Args:       <pattern> [directory]
  * Returns:    List of matching files with sizes
  *
- * Uses recursive directory traversal. Pattern is substring match.
- * Default directory is current working directory.
+ * Uses the in-process parallel walker (sea_walk). Pattern is a substring
+ * match, or a glob if it contains * ? or [. Default directory is the
+ * current working directory. Matches are streamed into the output
+ * buffer as workers find them; the walk stops at MAX_RESULTS.
  *
  * Examples:
  *   /exec file_search .c /root/seaclaw/src
  *   /exec file_search config /root/seaclaw
- *   /exec file_search .log /var/log
+ *   /exec file_search *.log /var/log
  *
- * Security: Directory path validated by Shield. Read-only.
+ * Security: Directory path validated by Shield. Read-only. No shell.
  */
 
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_walk.h"
 #include <stdio.h>
 #include <string.h>
 
-#define MAX_OUTPUT 8192
+#define MAX_OUTPUT  8192
+#define MAX_RESULTS 30
+#define MAX_DEPTH   5
+
+typedef struct {
+    char* buf;
+    int   pos;
+    u32   count;
+} SearchCtx;
+
+static bool on_match(const SeaWalkEntry* e, void* ctx) {
+    SearchCtx* sc = (SearchCtx*)ctx;
+    if (sc->pos >= MAX_OUTPUT - 512) return false;
+    sc->pos += snprintf(sc->buf + sc->pos, (size_t)(MAX_OUTPUT - sc->pos),
+                        "%10lu  %.*s\n", (unsigned long)e->size,
+                        (int)(e->path_len < 400 ? e->path_len : 400), e->path);
+    sc->count++;
+    return sc->count < MAX_RESULTS;
+}
 
 SeaError tool_file_search(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     if (args.len == 0) {
@@ -49,36 +70,31 @@ SeaError tool_file_search(SeaSlice args, SeaArena* arena, SeaSlice* output) {
         return SEA_OK;
     }
 
-    char cmd[512];
-    int clen = snprintf(cmd, sizeof(cmd),
-        "find '%s' -maxdepth 5 -name '*%s*' -type f -printf '%%10s  %%p\\n' 2>/dev/null | head -30",
-        dir, pattern);
-    (void)clen;
-
-    FILE* fp = popen(cmd, "r");
-    if (!fp) {
-        *output = SEA_SLICE_LIT("Error: search failed");
-        return SEA_OK;
-    }
-
     char* buf = (char*)sea_arena_alloc(arena, MAX_OUTPUT, 1);
-    if (!buf) { pclose(fp); return SEA_ERR_ARENA_FULL; }
+    if (!buf) return SEA_ERR_ARENA_FULL;
 
-    int pos = snprintf(buf, MAX_OUTPUT, "Search: '*%s*' in %s\n", pattern, dir);
-    u32 count = 0;
-    char line[512];
+    SearchCtx sc = { .buf = buf, .pos = 0, .count = 0 };
+    sc.pos = snprintf(buf, MAX_OUTPUT, "Search: '%s' in %s\n", pattern, dir);
 
-    while (fgets(line, sizeof(line), fp) && pos < MAX_OUTPUT - 512) {
-        u32 llen = (u32)strlen(line);
-        memcpy(buf + pos, line, llen);
-        pos += (int)llen;
-        count++;
+    SeaWalkOpts opts = {
+        .root         = dir,
+        .max_depth    = MAX_DEPTH,
+        .flags        = SEA_WALK_FILES_ONLY | SEA_WALK_STAT,
+        .name_pattern = pattern,
+        .visit        = on_match,
+        .ctx          = &sc,
+    };
+    SeaWalkStats st;
+    if (sea_walk(&opts, &st) != SEA_OK) {
+        *output = SEA_SLICE_LIT("Error: search failed");
+        return SEA_OK;
     }
-    pclose(fp);
 
-    pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "(%u files found)", count);
+    sc.pos += snprintf(buf + sc.pos, (size_t)(MAX_OUTPUT - sc.pos),
+                       "(%u files found%s)", sc.count,
+                       st.stopped ? ", limit reached" : "");
 
     output->data = (const u8*)buf;
-    output->len  = (u32)pos;
+    output->len  = (u32)sc.pos;
     return SEA_OK;
 }
@@ -3,125 +3,163 @@
  *
  * Tool ID:    28
  * Category:   Text Processing
- * Args:       <pattern> <text_or_filepath>
- * Returns:    Matching lines with line numbers
+ * Args:       [-s] [-E] [-C N] <pattern> <text_or_filepath>
+ * Returns:    Matching lines with line numbers (and context lines)
  *
- * If the second argument is a valid file path, reads from file.
- * Otherwise treats it as inline text (with \n as line separators).
+ * If the second argument is a valid file path, the file is memory-mapped
+ * and searched in full, whatever its size. Otherwise treats it as inline
+ * text (with \n as line separators).
+ *
+ * Matching is case-insensitive by default; -s makes it case-sensitive.
+ * -E treats the pattern as a POSIX extended regex. -C N prints N lines of
+ * context around each match. Quote the pattern to include spaces.
  *
  * Examples:
  *   /exec grep_text error "line1\nerror: bad\nline3\nerror: fail"
  *   /exec grep_text TODO /root/seaclaw/src/main.c
+ *   /exec grep_text -E -C 2 "sea_[a-z]+_init" /root/seaclaw/src/main.c
  *
- * Security: File paths validated by Shield. Pattern is plain substring match.
+ * Security: File paths validated by Shield. Read-only.
  */
 
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_grep.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 
 #define MAX_OUTPUT 8192
+#define MAX_SHOWN  120   /* Characters shown per line */
+
+typedef struct {
+    char* buf;
+    int   pos;
+    u64   last_line;
+    bool  full;
+} GrepOut;
+
+static bool on_hit(const SeaGrepHit* h, void* ctx) {
+    GrepOut* o = (GrepOut*)ctx;
+    if (o->full) return true;               /* Keep counting, stop printing */
+    if (o->pos >= MAX_OUTPUT - 256) { o->full = true; return true; }
+
+    if (o->last_line && h->line_no > o->last_line + 1) {
+        o->pos += snprintf(o->buf + o->pos, (size_t)(MAX_OUTPUT - o->pos), "  --\n");
+    }
+    u32 shown = h->line_len > MAX_SHOWN ? MAX_SHOWN : h->line_len;
+    o->pos += snprintf(o->buf + o->pos, (size_t)(MAX_OUTPUT - o->pos),
+        "  %4lu%c %.*s%s\n", (unsigned long)h->line_no, h->context ? '-' : ':',
+        (int)shown, (const char*)h->line, h->line_len > MAX_SHOWN ? "..." : "");
+    o->last_line = h->line_no;
+    return true;
+}
 
-static bool icase_contains(const char* haystack, const char* needle) {
-    u32 nlen = (u32)strlen(needle);
-    u32 hlen = (u32)strlen(haystack);
-    if (nlen > hlen) return false;
-    for (u32 i = 0; i <= hlen - nlen; i++) {
-        bool match = true;
-        for (u32 j = 0; j < nlen; j++) {
-            if (tolower((unsigned char)haystack[i+j]) != tolower((unsigned char)needle[j])) {
-                match = false; break;
-            }
-        }
-        if (match) return true;
+/* Next whitespace-delimited (or quoted) token; NUL-terminates in place. */
+static char* next_token(char** cursor) {
+    char* p = *cursor;
+    while (*p == ' ') p++;
+    if (!*p) { *cursor = p; return NULL; }
+    char* tok;
+    if (*p == '"' || *p == '\'') {
+        char q = *p++;
+        tok = p;
+        while (*p && *p != q) p++;
+    } else {
+        tok = p;
+        while (*p && *p != ' ') p++;
     }
-    return false;
+    if (*p) *p++ = '\0';
+    *cursor = p;
+    return tok;
 }
 
 SeaError tool_grep_text(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     if (args.len == 0) {
-        *output = SEA_SLICE_LIT("Usage: <pattern> <text_or_filepath>");
+        *output = SEA_SLICE_LIT("Usage: [-s] [-E] [-C N] <pattern> <text_or_filepath>");
         return SEA_OK;
     }
 
-    char input[8192];
-    u32 ilen = args.len < sizeof(input) - 1 ? args.len : (u32)(sizeof(input) - 1);
-    memcpy(input, args.data, ilen);
-    input[ilen] = '\0';
-
-    /* Parse pattern */
-    char pattern[256];
-    u32 pi = 0;
-    char* p = input;
-    while (*p == ' ') p++;
-    while (*p && *p != ' ' && pi < sizeof(pattern) - 1) pattern[pi++] = *p++;
-    pattern[pi] = '\0';
-    while (*p == ' ') p++;
+    char* input = (char*)sea_arena_alloc(arena, (u64)args.len + 1, 1);
+    if (!input) return SEA_ERR_ARENA_FULL;
+    memcpy(input, args.data, args.len);
+    input[args.len] = '\0';
+
+    /* Options, then pattern */
+    u32 flags = SEA_GREP_ICASE, context = 0;
+    char* cur = input;
+    char* pattern = NULL;
+    while ((pattern = next_token(&cur)) != NULL) {
+        if (strcmp(pattern, "-s") == 0)      flags &= ~SEA_GREP_ICASE;
+        else if (strcmp(pattern, "-i") == 0) flags |= SEA_GREP_ICASE;
+        else if (strcmp(pattern, "-E") == 0) flags |= SEA_GREP_REGEX;
+        else if (strncmp(pattern, "-C", 2) == 0) {
+            const char* n = pattern[2] ? pattern + 2 : next_token(&cur);
+            context = n ? (u32)strtoul(n, NULL, 10) : 0;
+        }
+        else break;
+    }
+    while (*cur == ' ') cur++;
 
-    if (pi == 0 || *p == '\0') {
+    if (!pattern || !pattern[0] || *cur == '\0') {
         *output = SEA_SLICE_LIT("Error: need both pattern and text/filepath");
         return SEA_OK;
     }
 
-    /* Check if it's a file path */
-    char* text_data = NULL;
-    u32 text_len = 0;
-    FILE* fp = NULL;
+    SeaGrepPattern pat;
+    char rerr[128] = "";
+    SeaError err = sea_grep_compile(&pat, pattern, flags, rerr, sizeof(rerr));
+    if (err != SEA_OK) {
+        char msg[256];
+        int n = snprintf(msg, sizeof(msg), "Error: bad pattern%s%s",
+                         rerr[0] ? ": " : "", rerr);
+        u8* dst = (u8*)sea_arena_push_bytes(arena, msg, (u64)n);
+        if (!dst) return SEA_ERR_ARENA_FULL;
+        output->data = dst; output->len = (u32)n;
+        return SEA_OK;
+    }
+
+    char* buf = (char*)sea_arena_alloc(arena, MAX_OUTPUT, 1);
+    if (!buf) { sea_grep_free(&pat); return SEA_ERR_ARENA_FULL; }
+
+    GrepOut out = { .buf = buf, .pos = 0 };
+    out.pos = snprintf(buf, MAX_OUTPUT, "grep \"%s\":\n", pattern);
+
+    SeaGrepStats st;
+    err = SEA_ERR_IO;
 
-    if (*p == '/' || (*p == '.' && *(p+1) == '/')) {
-        SeaSlice ps = { .data = (const u8*)p, .len = (u32)strlen(p) };
+    /* File path: mmap and search the whole file */
+    if (*cur == '/' || (*cur == '.' && *(cur+1) == '/')) {
+        SeaSlice ps = { .data = (const u8*)cur, .len = (u32)strlen(cur) };
         if (!sea_shield_detect_injection(ps)) {
-            fp = fopen(p, "r");
+            err = sea_grep_file(&pat, cur, context, on_hit, &out, arena, &st);
         }
     }
 
-    if (fp) {
-        text_data = (char*)sea_arena_alloc(arena, 32768, 1);
-        if (!text_data) { fclose(fp); return SEA_ERR_ARENA_FULL; }
-        text_len = (u32)fread(text_data, 1, 32767, fp);
-        text_data[text_len] = '\0';
-        fclose(fp);
-    } else {
-        /* Unescape \n in inline text */
-        text_data = (char*)sea_arena_alloc(arena, strlen(p) + 1, 1);
-        if (!text_data) return SEA_ERR_ARENA_FULL;
-        u32 di = 0;
-        for (u32 j = 0; p[j]; j++) {
-            if (p[j] == '\\' && p[j+1] == 'n') { text_data[di++] = '\n'; j++; }
-            else text_data[di++] = p[j];
+    if (err != SEA_OK) {
+        /* Inline text: drop surrounding quotes, unescape \n in one pass */
+        u32 clen = (u32)strlen(cur);
+        if (clen >= 2 && (cur[0] == '"' || cur[0] == '\'') && cur[clen - 1] == cur[0]) {
+            cur[clen - 1] = '\0';
+            cur++;
         }
-        text_data[di] = '\0';
-        text_len = di;
-    }
-
-    char* buf = (char*)sea_arena_alloc(arena, MAX_OUTPUT, 1);
-    if (!buf) return SEA_ERR_ARENA_FULL;
-
-    int pos = snprintf(buf, MAX_OUTPUT, "grep \"%s\":\n", pattern);
-    u32 line_num = 1, matches = 0;
-    char* line = text_data;
-
-    while (line && pos < MAX_OUTPUT - 256) {
-        char* nl = strchr(line, '\n');
-        if (nl) *nl = '\0';
-
-        if (icase_contains(line, pattern)) {
-            u32 llen = (u32)strlen(line);
-            if (llen > 120) llen = 120;
-            pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos),
-                "  %4u: %.*s%s\n", line_num, (int)llen, line, strlen(line) > 120 ? "..." : "");
-            matches++;
+        char* text = (char*)sea_arena_alloc(arena, strlen(cur) + 1, 1);
+        if (!text) { sea_grep_free(&pat); return SEA_ERR_ARENA_FULL; }
+        u32 di = 0;
+        for (u32 j = 0; cur[j]; j++) {
+            if (cur[j] == '\\' && cur[j+1] == 'n') { text[di++] = '\n'; j++; }
+            else text[di++] = cur[j];
         }
-
-        line_num++;
-        line = nl ? nl + 1 : NULL;
+        sea_grep_buffer(&pat, (const u8*)text, di, context, on_hit, &out, &st);
     }
+    sea_grep_free(&pat);
 
-    pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "(%u matches in %u lines)", matches, line_num - 1);
+    out.pos += snprintf(buf + out.pos, (size_t)(MAX_OUTPUT - out.pos),
+                        "(%lu matches in %lu lines%s)",
+                        (unsigned long)st.matches, (unsigned long)st.lines,
+                        out.full ? ", output truncated" : "");
 
     output->data = (const u8*)buf;
-    output->len  = (u32)pos;
+    output->len  = (u32)out.pos;
     return SEA_OK;
 }
@@ -1,28 +1,17 @@
 /*
  * tool_hash_compute.c — Compute hash of text
  *
- * Args: <md5|sha256|crc32> <text>
+ * Args: <crc32|crc32c|xxh64|fnv1a|sha256|djb2> <text>
  * Returns: hex-encoded hash
  *
- * Uses simple public-domain implementations (no OpenSSL dependency).
+ * Backed by sea_hash (no OpenSSL dependency); djb2 is kept local.
  */
 
 #include "seaclaw/sea_tools.h"
+#include "seaclaw/sea_hash.h"
 #include <stdio.h>
 #include <string.h>
 
-/* ── CRC32 (IEEE) ─────────────────────────────────────────── */
-
-static u32 crc32_compute(const u8* data, u32 len) {
-    u32 crc = 0xFFFFFFFF;
-    for (u32 i = 0; i < len; i++) {
-        crc ^= data[i];
-        for (int j = 0; j < 8; j++)
-            crc = (crc >> 1) ^ (0xEDB88320 & (-(crc & 1)));
-    }
-    return ~crc;
-}
-
 /* ── DJB2 hash (fast, non-crypto) ────────────────────────── */
 
 static u64 djb2_compute(const u8* data, u32 len) {
@@ -32,20 +21,9 @@ static u64 djb2_compute(const u8* data, u32 len) {
     return hash;
 }
 
-/* ── FNV-1a 64-bit ───────────────────────────────────────── */
-
-static u64 fnv1a_compute(const u8* data, u32 len) {
-    u64 hash = 0xcbf29ce484222325ULL;
-    for (u32 i = 0; i < len; i++) {
-        hash ^= data[i];
-        hash *= 0x100000001b3ULL;
-    }
-    return hash;
-}
-
 SeaError tool_hash_compute(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     if (args.len == 0) {
-        *output = SEA_SLICE_LIT("Usage: <crc32|djb2|fnv1a> <text>");
+        *output = SEA_SLICE_LIT("Usage: <crc32|crc32c|xxh64|fnv1a|sha256|djb2> <text>");
         return SEA_OK;
     }
 
@@ -65,17 +43,29 @@ SeaError tool_hash_compute(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     int len;
 
     if (strcmp(algo, "crc32") == 0) {
-        u32 h = crc32_compute(text, tlen);
+        u32 h = sea_crc32(0, text, tlen);
         len = snprintf(buf, sizeof(buf), "CRC32: %08x", h);
+    } else if (strcmp(algo, "crc32c") == 0) {
+        u32 h = sea_crc32c(0, text, tlen);
+        len = snprintf(buf, sizeof(buf), "CRC32C: %08x", h);
+    } else if (strcmp(algo, "xxh64") == 0) {
+        u64 h = sea_xxh64(text, tlen, 0);
+        len = snprintf(buf, sizeof(buf), "XXH64: %016llx", (unsigned long long)h);
+    } else if (strcmp(algo, "sha256") == 0) {
+        u8 d[32];
+        char hex[65];
+        sea_sha256(text, tlen, d);
+        sea_hash_hex(d, 32, hex);
+        len = snprintf(buf, sizeof(buf), "SHA256: %s", hex);
     } else if (strcmp(algo, "djb2") == 0) {
         u64 h = djb2_compute(text, tlen);
         len = snprintf(buf, sizeof(buf), "DJB2: %016llx", (unsigned long long)h);
     } else if (strcmp(algo, "fnv1a") == 0) {
-        u64 h = fnv1a_compute(text, tlen);
+        u64 h = sea_fnv1a(SEA_FNV1A_INIT, text, tlen);
         len = snprintf(buf, sizeof(buf), "FNV-1a: %016llx", (unsigned long long)h);
     } else {
         len = snprintf(buf, sizeof(buf),
-            "Unknown algorithm: %s\nAvailable: crc32, djb2, fnv1a", algo);
+            "Unknown algorithm: %s\nAvailable: crc32, crc32c, xxh64, fnv1a, sha256, djb2", algo);
     }
 
     u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)len);
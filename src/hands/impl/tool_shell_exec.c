@@ -2,7 +2,8 @@
  * tool_shell_exec.c — Execute a shell command (sandboxed)
  *
  * Args: command string
- * Returns: stdout + stderr (truncated to 8KB)
+ * Returns: stdout + stderr (truncated to 8KB), also reported through
+ *          sea_tool_progress as it is read
  *
  * Security: Shield validates the command. Dangerous patterns rejected.
  */
@@ -12,6 +13,8 @@
 #include "seaclaw/sea_log.h"
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
 
 #define MAX_OUTPUT_SIZE (8 * 1024)
 
@@ -73,11 +76,15 @@ SeaError tool_shell_exec(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     u8* buf = (u8*)sea_arena_alloc(arena, MAX_OUTPUT_SIZE + 64, 1);
     if (!buf) { pclose(pipe); return SEA_ERR_ARENA_FULL; }
 
+    /* read() returns as output appears, so progress streams live */
     size_t total = 0;
+    int fd = fileno(pipe);
     while (total < MAX_OUTPUT_SIZE) {
-        size_t n = fread(buf + total, 1, MAX_OUTPUT_SIZE - total, pipe);
-        if (n == 0) break;
-        total += n;
+        ssize_t n = read(fd, buf + total, MAX_OUTPUT_SIZE - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        sea_tool_progress(buf + total, (u32)n);
+        total += (size_t)n;
     }
 
     int status = pclose(pipe);
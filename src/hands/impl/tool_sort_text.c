@@ -3,44 +3,99 @@
  *
  * Tool ID:    31
  * Category:   Text Processing
- * Args:       [options] <text>
- * Options:    -r (reverse), -n (numeric), -u (unique)
- * Returns:    Sorted lines
+ * Args:       [options] <text_or_filepath>
+ * Options:    -r (reverse), -n (numeric), -u (unique),
+ *             -k N (sort on field N), -t C (field separator, default blanks),
+ *             -o PATH (write the full result to a file; may be the input)
+ * Returns:    Sorted lines (first 8 KB), or a summary with -o
+ *
+ * Backed by the sort engine (sea_sort): keys are parsed once, numeric
+ * and prefix keys are radix sorted, ties are merge sorted, and inputs
+ * too large for memory are sorted in spilled runs. Sorting is stable.
+ * Paths starting with / or ./ are read as files (memory-mapped).
  *
  * Examples:
  *   /exec sort_text "banana\napple\ncherry"
  *   /exec sort_text -r "3\n1\n2"
  *   /exec sort_text -n "10\n2\n30\n1"
  *   /exec sort_text -u "a\nb\na\nc\nb"
+ *   /exec sort_text -n -k 3 /var/log/app/latency.log
+ *   /exec sort_text -u -o /tmp/hosts.sorted /tmp/hosts.txt
  *
- * Security: Input validated by standard tool pipeline.
+ * Security: File paths validated by Shield.
  */
 
 #include "seaclaw/sea_tools.h"
+#include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_sort.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define MAX_OUTPUT  8192
+#define SCRATCH_MIN (1024 * 1024)
+#define SCRATCH_MAX (256 * 1024 * 1024)   /* Larger inputs spill to runs */
 
-#define MAX_LINES 500
-#define MAX_OUTPUT 8192
+typedef struct {
+    char* buf;
+    int   pos;
+    bool  full;
+    FILE* file;        /* -o target, else NULL */
+    u64   shown;
+} SortOut;
 
-static int cmp_str_asc(const void* a, const void* b) {
-    return strcmp(*(const char**)a, *(const char**)b);
+static bool on_line(const u8* line, u32 len, void* ctx) {
+    SortOut* o = (SortOut*)ctx;
+    if (o->file) {
+        fwrite(line, 1, len, o->file);
+        fputc('\n', o->file);
+        return true;
+    }
+    if (o->pos + (int)len + 1 > MAX_OUTPUT - 128) {
+        o->full = true;
+        return false;
+    }
+    memcpy(o->buf + o->pos, line, len);
+    o->pos += (int)len;
+    o->buf[o->pos++] = '\n';
+    o->shown++;
+    return true;
 }
-static int cmp_str_desc(const void* a, const void* b) {
-    return strcmp(*(const char**)b, *(const char**)a);
+
+/* Next space-delimited (or quoted) token; NUL-terminates in place. */
+static char* next_token(char** cursor) {
+    char* p = *cursor;
+    while (*p == ' ') p++;
+    if (!*p) { *cursor = p; return NULL; }
+    char* tok;
+    if (*p == '"' || *p == '\'') {
+        char q = *p++;
+        tok = p;
+        while (*p && *p != q) p++;
+    } else {
+        tok = p;
+        while (*p && *p != ' ') p++;
+    }
+    if (*p) *p++ = '\0';
+    *cursor = p;
+    return tok;
 }
-static int cmp_num_asc(const void* a, const void* b) {
-    double da = atof(*(const char**)a), db = atof(*(const char**)b);
-    return (da > db) - (da < db);
+
+static bool path_ok(const char* path) {
+    SeaSlice ps = { .data = (const u8*)path, .len = (u32)strlen(path) };
+    return !sea_shield_detect_injection(ps);
 }
-static int cmp_num_desc(const void* a, const void* b) {
-    return cmp_num_asc(b, a);
+
+static u64 scratch_size(u64 bytes) {
+    u64 n = bytes * 48 + SCRATCH_MIN;
+    return n > SCRATCH_MAX ? SCRATCH_MAX : n;
 }
 
 SeaError tool_sort_text(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     if (args.len == 0) {
-        *output = SEA_SLICE_LIT("Usage: [-r] [-n] [-u] <text with \\n separators>");
+        *output = SEA_SLICE_LIT("Usage: [-r] [-n] [-u] [-k N] [-t C] [-o PATH] <text with \\n separators | filepath>");
         return SEA_OK;
     }
 
@@ -50,60 +105,132 @@ SeaError tool_sort_text(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     input[args.len] = '\0';
 
     /* Parse options */
-    bool reverse = false, numeric = false, unique = false;
+    SeaSortOpts opts = { .flags = 0 };
+    const char* out_path = NULL;
     char* p = input;
-    while (*p == ' ') p++;
-    while (*p == '-') {
-        p++;
-        while (*p && *p != ' ') {
-            if (*p == 'r') reverse = true;
-            else if (*p == 'n') numeric = true;
-            else if (*p == 'u') unique = true;
-            p++;
-        }
+    for (;;) {
         while (*p == ' ') p++;
+        if (p[0] != '-' || p[1] == '\0' || p[1] == ' ' || (p[1] >= '0' && p[1] <= '9')) break;
+        char* save = p;
+        char* tok = next_token(&p);
+        if (!tok) break;
+        if (strcmp(tok, "-k") == 0 || strcmp(tok, "-t") == 0 || strcmp(tok, "-o") == 0) {
+            char* val = next_token(&p);
+            if (!val) { p = save; break; }
+            if (tok[1] == 'k') opts.key_field = (u32)strtoul(val, NULL, 10);
+            else if (tok[1] == 't') opts.separator = val[0] == '\\' && val[1] == 't' ? '\t' : val[0];
+            else out_path = val;
+            continue;
+        }
+        for (char* f = tok + 1; *f; f++) {
+            if (*f == 'r') opts.flags |= SEA_SORT_REVERSE;
+            else if (*f == 'n') opts.flags |= SEA_SORT_NUMERIC;
+            else if (*f == 'u') opts.flags |= SEA_SORT_UNIQUE;
+        }
     }
 
-    /* Unescape \n */
-    char* text = (char*)sea_arena_alloc(arena, strlen(p) + 1, 1);
-    if (!text) return SEA_ERR_ARENA_FULL;
-    u32 ti = 0;
-    for (u32 i = 0; p[i]; i++) {
-        if (p[i] == '\\' && p[i+1] == 'n') { text[ti++] = '\n'; i++; }
-        else text[ti++] = p[i];
+    if (out_path && !path_ok(out_path)) {
+        *output = SEA_SLICE_LIT("Error: output path rejected by Shield");
+        return SEA_OK;
     }
-    text[ti] = '\0';
-
-    /* Split into lines */
-    char* lines[MAX_LINES];
-    u32 count = 0;
-    char* tok = text;
-    while (tok && count < MAX_LINES) {
-        lines[count] = tok;
-        char* nl = strchr(tok, '\n');
-        if (nl) { *nl = '\0'; tok = nl + 1; } else tok = NULL;
-        if (strlen(lines[count]) > 0) count++;
+    if (out_path && strstr(out_path, "..")) {
+        *output = SEA_SLICE_LIT("Error: path traversal not allowed");
+        return SEA_OK;
     }
 
-    /* Sort */
-    if (numeric)
-        qsort(lines, count, sizeof(char*), reverse ? cmp_num_desc : cmp_num_asc);
-    else
-        qsort(lines, count, sizeof(char*), reverse ? cmp_str_desc : cmp_str_asc);
-
-    /* Output */
     char* buf = (char*)sea_arena_alloc(arena, MAX_OUTPUT, 1);
     if (!buf) return SEA_ERR_ARENA_FULL;
-    int pos = 0;
-    const char* prev = NULL;
+    SortOut out = { .buf = buf };
+
+    bool is_file = (p[0] == '/' || (p[0] == '.' && p[1] == '/'));
+    struct stat st;
+    if (is_file) {
+        char* e = p + strlen(p);
+        while (e > p && (e[-1] == ' ' || e[-1] == '\n')) *--e = '\0';
+        if (!path_ok(p)) {
+            *output = SEA_SLICE_LIT("Error: path rejected by Shield");
+            return SEA_OK;
+        }
+        if (stat(p, &st) != 0 || !S_ISREG(st.st_mode)) is_file = false;
+    }
+
+    /* Inline text: drop surrounding quotes, unescape \n in one pass */
+    const u8* text = NULL;
+    u64 text_len = 0;
+    if (!is_file) {
+        u32 clen = (u32)strlen(p);
+        if (clen >= 2 && (p[0] == '"' || p[0] == '\'') && p[clen - 1] == p[0]) {
+            p[clen - 1] = '\0';
+            p++;
+        }
+        char* t = (char*)sea_arena_alloc(arena, strlen(p) + 1, 1);
+        if (!t) return SEA_ERR_ARENA_FULL;
+        u32 ti = 0;
+        for (u32 i = 0; p[i]; i++) {
+            if (p[i] == '\\' && p[i+1] == 'n') { t[ti++] = '\n'; i++; }
+            else t[ti++] = p[i];
+        }
+        text = (const u8*)t;
+        text_len = ti;
+    }
+
+    /* -o writes a temp file beside the target and renames it over the
+     * target only after a successful sort, so -o may name the input. */
+    char* tmp_path = NULL;
+    if (out_path) {
+        size_t n = strlen(out_path) + 8;
+        tmp_path = (char*)sea_arena_alloc(arena, n, 1);
+        if (!tmp_path) return SEA_ERR_ARENA_FULL;
+        snprintf(tmp_path, n, "%s.XXXXXX", out_path);
+        int fd = mkstemp(tmp_path);
+        if (fd >= 0) fchmod(fd, 0644);
+        out.file = fd >= 0 ? fdopen(fd, "w") : NULL;
+        if (!out.file) {
+            if (fd >= 0) { close(fd); unlink(tmp_path); }
+            *output = SEA_SLICE_LIT("Error: cannot open output file");
+            return SEA_OK;
+        }
+        setvbuf(out.file, NULL, _IOFBF, 256 * 1024);
+    }
+
+    /* Key arrays live in a scratch arena sized to the input */
+    SeaArena scratch;
+    if (sea_arena_create(&scratch, scratch_size(is_file ? (u64)st.st_size : text_len)) != SEA_OK) {
+        if (out.file) { fclose(out.file); unlink(tmp_path); }
+        return SEA_ERR_OOM;
+    }
+    SeaSortStats ss;
+    SeaError err = is_file
+        ? sea_sort_file(p, &opts, &scratch, on_line, &out, &ss)
+        : sea_sort_buffer(text, text_len, &opts, &scratch, on_line, &out, &ss);
+    sea_arena_destroy(&scratch);
+    if (out.file) {
+        if (fclose(out.file) != 0 && err == SEA_OK) err = SEA_ERR_IO;
+        if (err == SEA_OK && rename(tmp_path, out_path) != 0) err = SEA_ERR_IO;
+        if (err != SEA_OK) unlink(tmp_path);
+    }
+
+    if (err != SEA_OK) {
+        int len = snprintf(buf, MAX_OUTPUT, "Error: sort failed (%s)",
+                           is_file ? "cannot read file or spill runs" : "input too large");
+        output->data = (const u8*)buf;
+        output->len  = (u32)len;
+        return SEA_OK;
+    }
 
-    for (u32 i = 0; i < count && pos < MAX_OUTPUT - 256; i++) {
-        if (unique && prev && strcmp(prev, lines[i]) == 0) continue;
-        pos += snprintf(buf + pos, (size_t)(MAX_OUTPUT - pos), "%s\n", lines[i]);
-        prev = lines[i];
+    if (out_path) {
+        out.pos = snprintf(buf, MAX_OUTPUT, "Sorted %lu lines -> %s (%lu written",
+                           (unsigned long)ss.lines, out_path, (unsigned long)ss.emitted);
+        if (ss.runs) out.pos += snprintf(buf + out.pos, (size_t)(MAX_OUTPUT - out.pos),
+                                         ", %u runs merged", ss.runs);
+        out.pos += snprintf(buf + out.pos, (size_t)(MAX_OUTPUT - out.pos), ")");
+    } else if (out.full || is_file) {
+        out.pos += snprintf(buf + out.pos, (size_t)(MAX_OUTPUT - out.pos),
+                            "(%lu lines sorted%s)", (unsigned long)ss.lines,
+                            out.full ? ", output truncated; use -o PATH for all" : "");
     }
 
     output->data = (const u8*)buf;
-    output->len  = (u32)pos;
+    output->len  = (u32)out.pos;
     return SEA_OK;
 }
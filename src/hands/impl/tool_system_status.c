@@ -1,5 +1,8 @@
 /*
  * tool_system_status.c — Report memory usage and uptime
+ *
+ * Followed by the arena registry: use, peak, resets and failed
+ * allocations for every named arena in the process.
  */
 
 #include "seaclaw/sea_tools.h"
@@ -7,6 +10,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#define ARENA_REPORT_MAX 4096
+
 SeaError tool_system_status(SeaSlice args, SeaArena* arena, SeaSlice* output) {
     (void)args;
 
@@ -39,10 +44,14 @@ SeaError tool_system_status(SeaSlice args, SeaArena* arena, SeaSlice* output) {
 
     if (len <= 0 || (u32)len >= sizeof(buf)) return SEA_ERR_OOM;
 
-    u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)len);
+    char* dst = (char*)sea_arena_alloc(arena, (u64)len + 2 + ARENA_REPORT_MAX, 1);
     if (!dst) return SEA_ERR_ARENA_FULL;
+    memcpy(dst, buf, (size_t)len);
+    dst[len++] = '\n';
+    dst[len++] = '\n';
+    len += (int)sea_arena_report(dst + len, ARENA_REPORT_MAX);
 
-    output->data = dst;
+    output->data = (const u8*)dst;
     output->len  = (u32)len;
     return SEA_OK;
 }
@@ -0,0 +1,393 @@
+/*
+ * sea_diff.c — Myers diff for diff_text and edit_file
+ *
+ * The middle-snake search and its cost cutoff follow the classic
+ * formulation used by GNU diff: forward and backward furthest-reaching
+ * paths on each diagonal, meeting in the middle, recursing on both
+ * halves. Results are recorded as per-line changed flags and folded
+ * into runs at the end.
+ */
+
+#include "seaclaw/sea_diff.h"
+#include "seaclaw/sea_walk.h"
+#include "seaclaw/sea_hash.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#define MIN_TOO_EXPENSIVE 4096   /* Edit-distance steps before the cutoff */
+
+/* ── Line splitting ───────────────────────────────────────── */
+
+static SeaSlice* split_lines(const u8* data, u64 len, SeaArena* arena, u32* count) {
+    *count = 0;
+    if (!data || len == 0) return NULL;
+
+    u64 n = sea_count_newlines(data, len);
+    if (data[len - 1] != '\n') n++;
+    if (n >= INT_MAX / 2) return NULL;
+
+    SeaSlice* lines = (SeaSlice*)sea_arena_alloc(arena, n * sizeof(SeaSlice), _Alignof(SeaSlice));
+    if (!lines) return NULL;
+
+    const u8* p = data;
+    const u8* end = data + len;
+    u32 i = 0;
+    while (p < end) {
+        const u8* nl = memchr(p, '\n', (size_t)(end - p));
+        const u8* stop = nl ? nl + 1 : end;
+        lines[i].data = p;
+        lines[i].len  = (u32)(stop - p);
+        i++;
+        p = stop;
+    }
+    *count = i;
+    return lines;
+}
+
+/* ── Interning: equal lines share an id ───────────────────── */
+
+typedef struct {
+    u32 id;       /* id + 1; 0 = empty slot */
+    u32 hash;
+} Slot;
+
+typedef struct {
+    Slot*     slots;
+    u32       mask;
+    SeaSlice* uniq;     /* Representative line per id */
+    u32       next_id;
+} Interner;
+
+static u32 intern(Interner* in, SeaSlice line) {
+    u64 h64 = sea_xxh64(line.data, line.len, 0);
+    u32 h = (u32)h64;
+    u32 i = (u32)(h64 >> 32) & in->mask;
+    for (;;) {
+        Slot* s = &in->slots[i];
+        if (s->id == 0) {
+            u32 id = in->next_id++;
+            s->id = id + 1;
+            s->hash = h;
+            in->uniq[id] = line;
+            return id;
+        }
+        if (s->hash == h) {
+            SeaSlice u = in->uniq[s->id - 1];
+            if (u.len == line.len && memcmp(u.data, line.data, line.len) == 0) return s->id - 1;
+        }
+        i = (i + 1) & in->mask;
+    }
+}
+
+/* ── Myers middle snake ───────────────────────────────────── */
+
+typedef struct {
+    const u32* xv;
+    const u32* yv;
+    i32*       fd;          /* Forward furthest x per diagonal, offset */
+    i32*       bd;          /* Backward furthest x per diagonal        */
+    u8*        del;         /* del[i]: line i of A removed             */
+    u8*        ins;         /* ins[j]: line j of B inserted            */
+    i32        too_expensive;
+} Ctx;
+
+typedef struct { i32 xmid, ymid; } Split;
+
+static void middle_snake(const Ctx* c, i32 xoff, i32 xlim, i32 yoff, i32 ylim, Split* part) {
+    const u32* xv = c->xv;
+    const u32* yv = c->yv;
+    i32* fd = c->fd;
+    i32* bd = c->bd;
+
+    const i32 dmin = xoff - ylim;
+    const i32 dmax = xlim - yoff;
+    const i32 fmid = xoff - yoff;
+    const i32 bmid = xlim - ylim;
+    i32 fmin = fmid, fmax = fmid;
+    i32 bmin = bmid, bmax = bmid;
+    const bool odd = ((fmid - bmid) & 1) != 0;
+
+    fd[fmid] = xoff;
+    bd[bmid] = xlim;
+
+    for (i32 cost = 1;; cost++) {
+        /* Forward: extend each diagonal by one edit, then slide */
+        if (fmin > dmin) fd[--fmin - 1] = -1; else ++fmin;
+        if (fmax < dmax) fd[++fmax + 1] = -1; else --fmax;
+        for (i32 d = fmax; d >= fmin; d -= 2) {
+            i32 tlo = fd[d - 1], thi = fd[d + 1];
+            i32 x = tlo >= thi ? tlo + 1 : thi;
+            i32 y = x - d;
+            while (x < xlim && y < ylim && xv[x] == yv[y]) { x++; y++; }
+            fd[d] = x;
+            if (odd && bmin <= d && d <= bmax && bd[d] <= x) {
+                part->xmid = x; part->ymid = y;
+                return;
+            }
+        }
+
+        /* Backward */
+        if (bmin > dmin) bd[--bmin - 1] = INT_MAX; else ++bmin;
+        if (bmax < dmax) bd[++bmax + 1] = INT_MAX; else --bmax;
+        for (i32 d = bmax; d >= bmin; d -= 2) {
+            i32 tlo = bd[d - 1], thi = bd[d + 1];
+            i32 x = tlo < thi ? tlo : thi - 1;
+            i32 y = x - d;
+            while (xoff < x && yoff < y && xv[x - 1] == yv[y - 1]) { x--; y--; }
+            bd[d] = x;
+            if (!odd && fmin <= d && d <= fmax && x <= fd[d]) {
+                part->xmid = x; part->ymid = y;
+                return;
+            }
+        }
+
+        if (cost < c->too_expensive) continue;
+
+        /* Too costly for a minimal answer: split at whichever of the
+         * forward/backward frontiers has made the most progress. */
+        i32 fxybest = -1, fxbest = 0;
+        for (i32 d = fmax; d >= fmin; d -= 2) {
+            i32 x = fd[d] < xlim ? fd[d] : xlim;
+            i32 y = x - d;
+            if (ylim < y) { x = ylim + d; y = ylim; }
+            if (fxybest < x + y) { fxybest = x + y; fxbest = x; }
+        }
+        i32 bxybest = INT_MAX, bxbest = 0;
+        for (i32 d = bmax; d >= bmin; d -= 2) {
+            i32 x = bd[d] > xoff ? bd[d] : xoff;
+            i32 y = x - d;
+            if (y < yoff) { x = yoff + d; y = yoff; }
+            if (x + y < bxybest) { bxybest = x + y; bxbest = x; }
+        }
+        if ((xlim + ylim) - bxybest < fxybest - (xoff + yoff)) {
+            part->xmid = fxbest;
+            part->ymid = fxybest - fxbest;
+        } else {
+            part->xmid = bxbest;
+            part->ymid = bxybest - bxbest;
+        }
+        return;
+    }
+}
+
+static void compare(const Ctx* c, i32 xoff, i32 xlim, i32 yoff, i32 ylim) {
+    const u32* xv = c->xv;
+    const u32* yv = c->yv;
+
+    while (xoff < xlim && yoff < ylim && xv[xoff] == yv[yoff]) { xoff++; yoff++; }
+    while (xoff < xlim && yoff < ylim && xv[xlim - 1] == yv[ylim - 1]) { xlim--; ylim--; }
+
+    if (xoff == xlim) {
+        while (yoff < ylim) c->ins[yoff++] = 1;
+    } else if (yoff == ylim) {
+        while (xoff < xlim) c->del[xoff++] = 1;
+    } else {
+        Split part;
+        middle_snake(c, xoff, xlim, yoff, ylim, &part);
+        compare(c, xoff, part.xmid, yoff, part.ymid);
+        compare(c, part.xmid, xlim, part.ymid, ylim);
+    }
+}
+
+/* ── Public: diff ─────────────────────────────────────────── */
+
+SeaError sea_diff_lines(const u8* a, u64 a_len, const u8* b, u64 b_len,
+                        SeaArena* arena, SeaDiff* out) {
+    if (!arena || !out) return SEA_ERR_INVALID_INPUT;
+    memset(out, 0, sizeof(*out));
+
+    out->a_lines = split_lines(a, a_len, arena, &out->a_count);
+    if (a_len && !out->a_lines) return SEA_ERR_ARENA_FULL;
+    out->b_lines = split_lines(b, b_len, arena, &out->b_count);
+    if (b_len && !out->b_lines) return SEA_ERR_ARENA_FULL;
+
+    u32 na = out->a_count, nb = out->b_count;
+    u64 total = (u64)na + nb;
+
+    /* Intern */
+    u32 cap = 16;
+    while (cap < total * 2) cap <<= 1;
+    Interner in = {
+        .slots   = (Slot*)sea_arena_alloc(arena, (u64)cap * sizeof(Slot), _Alignof(Slot)),
+        .mask    = cap - 1,
+        .uniq    = (SeaSlice*)sea_arena_alloc(arena, (total + 1) * sizeof(SeaSlice), _Alignof(SeaSlice)),
+        .next_id = 0,
+    };
+    u32* xv  = (u32*)sea_arena_alloc(arena, ((u64)na + 1) * sizeof(u32), _Alignof(u32));
+    u32* yv  = (u32*)sea_arena_alloc(arena, ((u64)nb + 1) * sizeof(u32), _Alignof(u32));
+    u32* xmap = (u32*)sea_arena_alloc(arena, ((u64)na + 1) * sizeof(u32), _Alignof(u32));
+    u32* ymap = (u32*)sea_arena_alloc(arena, ((u64)nb + 1) * sizeof(u32), _Alignof(u32));
+    u8*  seen = (u8*)sea_arena_alloc(arena, total + 1, 1);
+    u8*  del  = (u8*)sea_arena_alloc(arena, (u64)na + 1, 1);
+    u8*  ins  = (u8*)sea_arena_alloc(arena, (u64)nb + 1, 1);
+    u8*  cdel = (u8*)sea_arena_alloc(arena, (u64)na + 1, 1);
+    u8*  cins = (u8*)sea_arena_alloc(arena, (u64)nb + 1, 1);
+    i32* diags = (i32*)sea_arena_alloc(arena, 2 * (total + 3) * sizeof(i32), _Alignof(i32));
+    if (!in.slots || !in.uniq || !xv || !yv || !xmap || !ymap || !seen ||
+        !del || !ins || !cdel || !cins || !diags) {
+        return SEA_ERR_ARENA_FULL;
+    }
+
+    memset(in.slots, 0, (u64)cap * sizeof(Slot));
+    memset(seen, 0, total + 1);
+    memset(del, 0, (u64)na + 1);
+    memset(ins, 0, (u64)nb + 1);
+    memset(cdel, 0, (u64)na + 1);
+    memset(cins, 0, (u64)nb + 1);
+    for (u32 i = 0; i < na; i++) { xv[i] = intern(&in, out->a_lines[i]); seen[xv[i]] |= 1; }
+    for (u32 j = 0; j < nb; j++) { yv[j] = intern(&in, out->b_lines[j]); seen[yv[j]] |= 2; }
+
+    /* A line with no counterpart on the other side can never be part
+     * of a match: mark it changed now and keep it out of the search.
+     * This leaves the edit script minimal and shrinks N and M, often
+     * drastically on unrelated inputs. */
+    u32 cn = 0, cm = 0;
+    for (u32 i = 0; i < na; i++) {
+        if (seen[xv[i]] == 3) { xmap[cn] = i; xv[cn++] = xv[i]; } else del[i] = 1;
+    }
+    for (u32 j = 0; j < nb; j++) {
+        if (seen[yv[j]] == 3) { ymap[cm] = j; yv[cm++] = yv[j]; } else ins[j] = 1;
+    }
+
+    /* Diagonals run from -(cm+1) to cn+1 */
+    u64 ctotal = (u64)cn + cm;
+    Ctx c = {
+        .xv  = xv,
+        .yv  = yv,
+        .fd  = diags + cm + 1,
+        .bd  = diags + (ctotal + 3) + cm + 1,
+        .del = cdel,
+        .ins = cins,
+        .too_expensive = 1,
+    };
+    for (u64 d = ctotal + 3; d != 0; d >>= 2) c.too_expensive <<= 1;
+    if (c.too_expensive < MIN_TOO_EXPENSIVE) c.too_expensive = MIN_TOO_EXPENSIVE;
+
+    compare(&c, 0, (i32)cn, 0, (i32)cm);
+
+    for (u32 k = 0; k < cn; k++) if (cdel[k]) del[xmap[k]] = 1;
+    for (u32 k = 0; k < cm; k++) if (cins[k]) ins[ymap[k]] = 1;
+
+    /* Fold flags into runs */
+    u32 runs = 0;
+    for (u32 i = 0, j = 0; i < na || j < nb;) {
+        if (i < na && j < nb && !del[i] && !ins[j]) { i++; j++; continue; }
+        runs++;
+        while (i < na && del[i]) i++;
+        while (j < nb && ins[j]) j++;
+    }
+    out->changes = runs
+        ? (SeaDiffChange*)sea_arena_alloc(arena, runs * sizeof(SeaDiffChange), _Alignof(SeaDiffChange))
+        : NULL;
+    if (runs && !out->changes) return SEA_ERR_ARENA_FULL;
+
+    for (u32 i = 0, j = 0; i < na || j < nb;) {
+        if (i < na && j < nb && !del[i] && !ins[j]) { i++; j++; continue; }
+        SeaDiffChange* ch = &out->changes[out->change_count++];
+        ch->a_start = i;
+        ch->b_start = j;
+        while (i < na && del[i]) i++;
+        while (j < nb && ins[j]) j++;
+        ch->a_count = i - ch->a_start;
+        ch->b_count = j - ch->b_start;
+        out->removed += ch->a_count;
+        out->added   += ch->b_count;
+    }
+    return SEA_OK;
+}
+
+/* ── Public: unified output ───────────────────────────────── */
+
+typedef struct {
+    char* buf;
+    u32   len;
+    u32   cap;       /* Reserve for the truncation note is kept aside */
+    bool  full;
+} Out;
+
+static void put(Out* o, const char* s, u32 n) {
+    if (o->full) return;
+    if (o->len + n > o->cap) { o->full = true; return; }
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+}
+
+static void put_line(Out* o, char tag, SeaSlice line) {
+    bool eol = line.len > 0 && line.data[line.len - 1] == '\n';
+    static const char noeol[] = "\n\\ No newline at end of file\n";
+    if (o->full) return;
+    if (o->len + 1 + line.len + (eol ? 0 : sizeof(noeol) - 1) > o->cap) { o->full = true; return; }
+    o->buf[o->len++] = tag;
+    put(o, (const char*)line.data, line.len);
+    if (!eol) put(o, noeol, sizeof(noeol) - 1);
+}
+
+/* GNU range form: "start,count", "start" if count is 1, and the line
+ * before the gap if count is 0. */
+static int fmt_range(char* dst, u32 size, u32 start, u32 count) {
+    if (count == 1) return snprintf(dst, size, "%u", start + 1);
+    return snprintf(dst, size, "%u,%u", count ? start + 1 : start, count);
+}
+
+SeaError sea_diff_unified(const SeaDiff* diff, const char* a_name, const char* b_name,
+                          u32 context, u32 max_bytes, SeaArena* arena, SeaSlice* out) {
+    static const char trunc[] = "... (diff truncated)\n";
+    if (!diff || !arena || !out) return SEA_ERR_INVALID_INPUT;
+    out->data = NULL;
+    out->len  = 0;
+    if (diff->change_count == 0) return SEA_OK;
+    if (max_bytes < sizeof(trunc)) return SEA_ERR_INVALID_INPUT;
+
+    Out o = { .buf = (char*)sea_arena_alloc(arena, max_bytes, 1), .len = 0,
+              .cap = max_bytes - (u32)(sizeof(trunc) - 1), .full = false };
+    if (!o.buf) return SEA_ERR_ARENA_FULL;
+
+    char hdr[320];
+    int n = snprintf(hdr, sizeof(hdr), "--- %s\n+++ %s\n", a_name ? a_name : "a", b_name ? b_name : "b");
+    put(&o, hdr, (u32)n);
+
+    const SeaDiffChange* ch = diff->changes;
+    u32 count = diff->change_count;
+
+    for (u32 first = 0; first < count && !o.full;) {
+        /* Merge changes whose gap fits inside both contexts */
+        u32 last = first;
+        while (last + 1 < count &&
+               ch[last + 1].a_start - (ch[last].a_start + ch[last].a_count) <= 2 * context) {
+            last++;
+        }
+
+        u32 a_lo = ch[first].a_start > context ? ch[first].a_start - context : 0;
+        u32 a_end = ch[last].a_start + ch[last].a_count;
+        u32 a_hi = a_end + context < diff->a_count ? a_end + context : diff->a_count;
+        u32 b_lo = ch[first].b_start - (ch[first].a_start - a_lo);
+        u32 b_hi = ch[last].b_start + ch[last].b_count + (a_hi - a_end);
+
+        char ra[32], rb[32];
+        fmt_range(ra, sizeof(ra), a_lo, a_hi - a_lo);
+        fmt_range(rb, sizeof(rb), b_lo, b_hi - b_lo);
+        n = snprintf(hdr, sizeof(hdr), "@@ -%s +%s @@\n", ra, rb);
+        put(&o, hdr, (u32)n);
+
+        u32 ai = a_lo;
+        for (u32 k = first; k <= last; k++) {
+            for (; ai < ch[k].a_start; ai++) put_line(&o, ' ', diff->a_lines[ai]);
+            for (u32 i = 0; i < ch[k].a_count; i++) put_line(&o, '-', diff->a_lines[ch[k].a_start + i]);
+            for (u32 j = 0; j < ch[k].b_count; j++) put_line(&o, '+', diff->b_lines[ch[k].b_start + j]);
+            ai = ch[k].a_start + ch[k].a_count;
+        }
+        for (; ai < a_hi; ai++) put_line(&o, ' ', diff->a_lines[ai]);
+
+        first = last + 1;
+    }
+
+    if (o.full) {
+        memcpy(o.buf + o.len, trunc, sizeof(trunc) - 1);
+        o.len += (u32)(sizeof(trunc) - 1);
+    }
+    out->data = (const u8*)o.buf;
+    out->len  = o.len;
+    return SEA_OK;
+}
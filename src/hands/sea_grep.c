@@ -0,0 +1,336 @@
+/*
+ * sea_grep.c — Search engine for grep_text
+ *
+ * The buffer is scanned for the next match as a whole; only when a
+ * candidate is confirmed do we look for its line boundaries and count
+ * the newlines since the previous hit. Non-matching lines are never
+ * split, copied or lower-cased.
+ */
+
+#include "seaclaw/sea_grep.h"
+#include "seaclaw/sea_walk.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(SEA_ARCH_X86) && defined(__AVX2__)
+#include <immintrin.h>
+#define GREP_AVX2 1
+#elif defined(SEA_ARCH_ARM) && defined(__aarch64__)
+#include <arm_neon.h>
+#define GREP_NEON 1
+#endif
+
+#define REGEX_WINDOW  (4 * 1024 * 1024)   /* Line-aligned regexec window   */
+#define SCRATCH_MAX   (1024 * 1024)       /* Non-mappable file read cap    */
+
+/* ── Case folding ─────────────────────────────────────────── */
+
+static inline u8 fold(u8 c) {
+    return (c >= 'A' && c <= 'Z') ? (u8)(c + 32) : c;
+}
+
+static inline u8 upper(u8 c) {
+    return (c >= 'a' && c <= 'z') ? (u8)(c - 32) : c;
+}
+
+/* ── Compile ──────────────────────────────────────────────── */
+
+SeaError sea_grep_compile(SeaGrepPattern* pat, const char* pattern, u32 flags,
+                          char* err, u32 err_len) {
+    if (!pat || !pattern || !pattern[0]) return SEA_ERR_INVALID_INPUT;
+
+    memset(pat, 0, sizeof(*pat));
+    pat->flags = flags;
+
+    u32 n = (u32)strlen(pattern);
+    if (n >= SEA_GREP_MAX_PATTERN) return SEA_ERR_INVALID_INPUT;
+
+    if (flags & SEA_GREP_REGEX) {
+        int cflags = REG_EXTENDED | REG_NEWLINE;
+        if (flags & SEA_GREP_ICASE) cflags |= REG_ICASE;
+        int rc = regcomp(&pat->re, pattern, cflags);
+        if (rc != 0) {
+            if (err && err_len) regerror(rc, &pat->re, err, err_len);
+            regfree(&pat->re);
+            return SEA_ERR_PARSE;
+        }
+        pat->re_ok = true;
+        return SEA_OK;
+    }
+
+    bool icase = (flags & SEA_GREP_ICASE) != 0;
+    for (u32 i = 0; i < n; i++) {
+        pat->needle[i] = icase ? fold((u8)pattern[i]) : (u8)pattern[i];
+    }
+    pat->needle_len = n;
+
+    for (u32 c = 0; c < 256; c++) pat->skip[c] = n;
+    for (u32 i = 0; i + 1 < n; i++) {
+        u8 c = pat->needle[i];
+        pat->skip[c] = n - 1 - i;
+        if (icase) pat->skip[upper(c)] = n - 1 - i;
+    }
+    return SEA_OK;
+}
+
+void sea_grep_free(SeaGrepPattern* pat) {
+    if (pat && pat->re_ok) {
+        regfree(&pat->re);
+        pat->re_ok = false;
+    }
+}
+
+/* ── Literal search ───────────────────────────────────────── */
+
+static inline bool verify(const SeaGrepPattern* pat, const u8* at) {
+    u32 n = pat->needle_len;
+    if (!(pat->flags & SEA_GREP_ICASE)) return memcmp(at, pat->needle, n) == 0;
+    for (u32 k = 0; k < n; k++) {
+        if (fold(at[k]) != pat->needle[k]) return false;
+    }
+    return true;
+}
+
+/* Boyer-Moore-Horspool from `i`; shift on the byte under the last slot. */
+static i64 find_horspool(const SeaGrepPattern* pat, const u8* data, u64 len, u64 i) {
+    u32 n = pat->needle_len;
+    u8  last = pat->needle[n - 1];
+    bool icase = (pat->flags & SEA_GREP_ICASE) != 0;
+    while (i + n <= len) {
+        u8 c = data[i + n - 1];
+        if ((icase ? fold(c) : c) == last && verify(pat, data + i)) return (i64)i;
+        i += pat->skip[c];
+    }
+    return -1;
+}
+
+i64 sea_grep_find(const SeaGrepPattern* pat, const u8* data, u64 len) {
+    if (!pat || !data || pat->needle_len == 0) return -1;
+    u32 n = pat->needle_len;
+    if (n > len) return -1;
+
+    u64 i = 0;
+    bool icase = (pat->flags & SEA_GREP_ICASE) != 0;
+
+    if (n == 1 && !icase) {
+        const u8* hit = memchr(data, pat->needle[0], len);
+        return hit ? (i64)(hit - data) : -1;
+    }
+
+#if defined(GREP_AVX2)
+    /* First/last byte filter: a candidate needs both ends to match. */
+    const u8 f = pat->needle[0], l = pat->needle[n - 1];
+    const __m256i f_lo = _mm256_set1_epi8((char)f);
+    const __m256i f_up = _mm256_set1_epi8((char)(icase ? upper(f) : f));
+    const __m256i l_lo = _mm256_set1_epi8((char)l);
+    const __m256i l_up = _mm256_set1_epi8((char)(icase ? upper(l) : l));
+
+    for (; i + n - 1 + 32 <= len; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(data + i + n - 1));
+        __m256i ea = _mm256_or_si256(_mm256_cmpeq_epi8(a, f_lo), _mm256_cmpeq_epi8(a, f_up));
+        __m256i eb = _mm256_or_si256(_mm256_cmpeq_epi8(b, l_lo), _mm256_cmpeq_epi8(b, l_up));
+        u32 mask = (u32)_mm256_movemask_epi8(_mm256_and_si256(ea, eb));
+        while (mask) {
+            u32 bit = (u32)__builtin_ctz(mask);
+            if (verify(pat, data + i + bit)) return (i64)(i + bit);
+            mask &= mask - 1;
+        }
+    }
+#elif defined(GREP_NEON)
+    const u8 f = pat->needle[0], l = pat->needle[n - 1];
+    const uint8x16_t f_lo = vdupq_n_u8(f), f_up = vdupq_n_u8(icase ? upper(f) : f);
+    const uint8x16_t l_lo = vdupq_n_u8(l), l_up = vdupq_n_u8(icase ? upper(l) : l);
+
+    for (; i + n - 1 + 16 <= len; i += 16) {
+        uint8x16_t a = vld1q_u8(data + i);
+        uint8x16_t b = vld1q_u8(data + i + n - 1);
+        uint8x16_t m = vandq_u8(vorrq_u8(vceqq_u8(a, f_lo), vceqq_u8(a, f_up)),
+                                vorrq_u8(vceqq_u8(b, l_lo), vceqq_u8(b, l_up)));
+        if (vmaxvq_u8(m) == 0) continue;
+        u8 lanes[16];
+        vst1q_u8(lanes, m);
+        for (u32 k = 0; k < 16; k++) {
+            if (lanes[k] && verify(pat, data + i + k)) return (i64)(i + k);
+        }
+    }
+#endif
+
+    return find_horspool(pat, data, len, i);
+}
+
+/* ── Regex search ─────────────────────────────────────────── */
+
+/* First match at or after `from` (a line start), or -1. regexec runs
+ * over line-aligned windows so offsets stay within regoff_t. */
+static i64 find_regex(const SeaGrepPattern* pat, const u8* data, u64 from, u64 len) {
+    while (from < len) {
+        u64 wend = from + REGEX_WINDOW;
+        if (wend >= len) {
+            wend = len;
+        } else {
+            const u8* nl = memchr(data + wend, '\n', len - wend);
+            wend = nl ? (u64)(nl - data) : len;
+        }
+        if (wend - from > (u64)INT_MAX) wend = from + (u64)INT_MAX;
+
+        regmatch_t m[1];
+        m[0].rm_so = 0;
+        m[0].rm_eo = (regoff_t)(wend - from);
+        if (regexec(&pat->re, (const char*)(data + from), 1, m, REG_STARTEND) == 0) {
+            return (i64)(from + (u64)m[0].rm_so);
+        }
+        from = wend + 1;
+    }
+    return -1;
+}
+
+static i64 find_next(const SeaGrepPattern* pat, const u8* data, u64 from, u64 len) {
+    if (pat->flags & SEA_GREP_REGEX) return find_regex(pat, data, from, len);
+    i64 r = sea_grep_find(pat, data + from, len - from);
+    return r < 0 ? -1 : (i64)from + r;
+}
+
+/* ── Line bookkeeping ─────────────────────────────────────── */
+
+typedef struct {
+    const u8*     data;
+    u64           len;
+    u64           counted_upto;   /* Newlines counted in [0, counted_upto) */
+    u64           newlines;
+    SeaGrepVisit  visit;
+    void*         ctx;
+    SeaGrepStats* st;
+    bool          stop;
+} GrepRun;
+
+/* Emit the line starting at `start`; returns the next line start. */
+static u64 emit_line(GrepRun* r, u64 start, bool context) {
+    const u8* nl = memchr(r->data + start, '\n', r->len - start);
+    u64 end = nl ? (u64)(nl - r->data) : r->len;
+
+    r->newlines    += sea_count_newlines(r->data + r->counted_upto, start - r->counted_upto);
+    r->counted_upto = start;
+
+    if (!context) r->st->matches++;
+    if (r->visit && !r->stop) {
+        u64 ll = end - start;
+        SeaGrepHit hit = {
+            .line_no  = r->newlines + 1,
+            .offset   = start,
+            .line     = r->data + start,
+            .line_len = ll > UINT32_MAX ? UINT32_MAX : (u32)ll,
+            .context  = context,
+        };
+        if (!r->visit(&hit, r->ctx)) r->stop = true;
+    }
+    return nl ? end + 1 : r->len;
+}
+
+/* ── Search ───────────────────────────────────────────────── */
+
+SeaError sea_grep_buffer(const SeaGrepPattern* pat, const u8* data, u64 len,
+                         u32 context, SeaGrepVisit visit, void* ctx,
+                         SeaGrepStats* stats) {
+    if (!pat || (!data && len > 0)) return SEA_ERR_INVALID_INPUT;
+    if (!(pat->flags & SEA_GREP_REGEX) && pat->needle_len == 0) return SEA_ERR_INVALID_INPUT;
+    if ((pat->flags & SEA_GREP_REGEX) && !pat->re_ok) return SEA_ERR_INVALID_INPUT;
+    if (context > SEA_GREP_MAX_CONTEXT) context = SEA_GREP_MAX_CONTEXT;
+
+    SeaGrepStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    GrepRun r = { .data = data, .len = len, .visit = visit, .ctx = ctx, .st = stats };
+
+    u64 pos     = 0;   /* Next search start (always a line start)   */
+    u64 emitted = 0;   /* Start of the first line not yet emitted    */
+    u32 after   = 0;   /* Context lines still owed to the last match */
+
+    while (pos < len && !r.stop) {
+        i64 m = find_next(pat, data, pos, len);
+        u64 ls = len;
+        if (m >= 0) {
+            const u8* prev = memrchr(data + pos, '\n', (u64)m - pos);
+            ls = prev ? (u64)(prev - data) + 1 : pos;
+        }
+
+        /* Trailing context of the previous match */
+        while (after > 0 && emitted < ls && !r.stop) {
+            emitted = emit_line(&r, emitted, true);
+            after--;
+        }
+        if (m < 0 || r.stop) break;
+
+        /* Leading context, never re-emitting lines */
+        u64 bstart = ls;
+        for (u32 k = 0; k < context && bstart > emitted; k++) {
+            const u8* q = memrchr(data + emitted, '\n', bstart - 1 - emitted);
+            bstart = q ? (u64)(q - data) + 1 : emitted;
+        }
+        while (bstart < ls && !r.stop) bstart = emit_line(&r, bstart, true);
+        if (r.stop) break;
+
+        emitted = emit_line(&r, ls, false);
+        pos     = emitted;
+        after   = context;
+    }
+
+    stats->stopped = r.stop;
+    stats->bytes   = r.stop ? r.counted_upto : len;
+    if (!r.stop) {
+        r.newlines += sea_count_newlines(data + r.counted_upto, len - r.counted_upto);
+        stats->lines = r.newlines + ((len > 0 && data[len - 1] != '\n') ? 1 : 0);
+    } else {
+        stats->lines = r.newlines + 1;
+    }
+    return SEA_OK;
+}
+
+SeaError sea_grep_file(const SeaGrepPattern* pat, const char* path,
+                       u32 context, SeaGrepVisit visit, void* ctx,
+                       SeaArena* scratch, SeaGrepStats* stats) {
+    if (!pat || !path) return SEA_ERR_INVALID_INPUT;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return SEA_ERR_IO;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || S_ISDIR(st.st_mode)) { close(fd); return SEA_ERR_IO; }
+
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        u64 size = (u64)st.st_size;
+        void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) return SEA_ERR_IO;
+        madvise(map, size, MADV_SEQUENTIAL);
+        SeaError err = sea_grep_buffer(pat, (const u8*)map, size, context, visit, ctx, stats);
+        munmap(map, size);
+        return err;
+    }
+
+    /* Pseudo-files report size 0 and cannot be mapped: read them. */
+    if (!scratch) { close(fd); return SEA_ERR_IO; }
+    u64 cap = sea_arena_remaining(scratch) / 2;
+    if (cap > SCRATCH_MAX) cap = SCRATCH_MAX;
+    u8* buf = cap ? (u8*)sea_arena_alloc(scratch, cap, 1) : NULL;
+    if (!buf) { close(fd); return SEA_ERR_ARENA_FULL; }
+
+    u64 got = 0;
+    while (got < cap) {
+        ssize_t n = read(fd, buf + got, cap - got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        got += (u64)n;
+    }
+    close(fd);
+    return sea_grep_buffer(pat, buf, got, context, visit, ctx, stats);
+}
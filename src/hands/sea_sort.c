@@ -0,0 +1,593 @@
+/*
+ * sea_sort.c — Sort engine for sort_text
+ *
+ * A run is an array of (key, index) records sorted with an LSD radix
+ * pass per non-constant key byte, ping-ponging between two buffers.
+ * String keys carry their first 16 bytes in the record; large groups
+ * tied on that prefix are radix sorted again on the next 16, small
+ * ones are merge sorted. Runs that do not fit are written to unlinked temp files
+ * and merged through a binary heap.
+ */
+
+#include "seaclaw/sea_sort.h"
+#include "seaclaw/sea_walk.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define WRITE_BUF     (256 * 1024)   /* Spill writer buffer            */
+#define ARENA_SLACK   (64 * 1024)    /* Kept free for bookkeeping      */
+#define INSERTION_MAX 16             /* Merge sort leaf size           */
+#define REFINE_MIN    64             /* Smaller tie groups merge sort  */
+
+/* key[0] is most significant. Strings carry 16 key bytes so the first
+ * refinement level needs no access to the line itself. */
+typedef struct {
+    u64 key[2];
+    u32 idx;
+    u32 pad;
+} Rec;
+
+/* Per-line cost of a run: line + key slices, record + scratch record */
+#define LINE_COST (2 * sizeof(SeaSlice) + 2 * sizeof(Rec))
+
+typedef struct {
+    const SeaSortOpts* o;
+    bool      numeric;
+    bool      reverse;
+    bool      unique;
+    SeaSlice* lines;
+    SeaSlice* keys;
+} Run;
+
+/* ── Key extraction ───────────────────────────────────────── */
+
+static inline bool is_blank(u8 c) { return c == ' ' || c == '\t'; }
+
+static SeaSlice key_of(const u8* line, u32 len, const SeaSortOpts* o) {
+    SeaSlice k = { .data = line, .len = len };
+    if (o->key_field == 0) return k;
+
+    const u8* p = line;
+    const u8* end = line + len;
+    if (o->separator) {
+        for (u32 f = 1; f < o->key_field; f++) {
+            const u8* s = memchr(p, o->separator, (size_t)(end - p));
+            if (!s) { p = end; break; }
+            p = s + 1;
+        }
+        const u8* s = memchr(p, o->separator, (size_t)(end - p));
+        k.data = p;
+        k.len  = (u32)((s ? s : end) - p);
+        return k;
+    }
+
+    /* Blank-separated, leading blanks ignored (awk-style) */
+    for (u32 f = 1;; f++) {
+        while (p < end && is_blank(*p)) p++;
+        const u8* s = p;
+        while (p < end && !is_blank(*p)) p++;
+        if (f == o->key_field || p >= end) {
+            k.data = s;
+            k.len  = f == o->key_field ? (u32)(p - s) : 0;
+            return k;
+        }
+    }
+}
+
+static const double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/* Leading number of the key, as atof() would read it. Plain decimals
+ * with at most 19 significant digits are converted exactly without
+ * strtod; anything else goes through it. */
+static double parse_num(SeaSlice k) {
+    const u8* p = k.data;
+    const u8* end = k.data + k.len;
+    while (p < end && is_blank(*p)) p++;
+    const u8* start = p;
+
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) { neg = (*p == '-'); p++; }
+
+    u64 m = 0;
+    u32 digits = 0, frac = 0;
+    while (p < end && *p >= '0' && *p <= '9') { m = m * 10 + (u64)(*p++ - '0'); digits++; }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') { m = m * 10 + (u64)(*p++ - '0'); digits++; frac++; }
+    }
+
+    bool slow = digits > 19 || frac > 22 || m > (1ULL << 53) ||
+                (p < end && (*p == 'e' || *p == 'E' || *p == 'x' || *p == 'X')) ||
+                (digits == 0 && p < end && (*p == 'i' || *p == 'I' || *p == 'n' || *p == 'N'));
+    if (!slow) {
+        double v = (double)m / POW10[frac];
+        return neg ? -v : v;
+    }
+
+    char buf[64];
+    u32 n = (u32)(end - start) < sizeof(buf) - 1 ? (u32)(end - start) : (u32)sizeof(buf) - 1;
+    memcpy(buf, start, n);
+    buf[n] = '\0';
+    return strtod(buf, NULL);
+}
+
+/* Order-preserving map from double to u64 */
+static inline u64 num_key(double v) {
+    if (v == 0) v = 0.0;   /* -0 == 0 */
+    u64 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+}
+
+/* 8 key bytes from `depth` on, big-endian, zero-padded */
+static inline u64 prefix_key(SeaSlice k, u32 depth) {
+    if (k.len >= depth + 8) {
+        u64 v;
+        memcpy(&v, k.data + depth, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        v = __builtin_bswap64(v);
+#endif
+        return v;
+    }
+    u64 v = 0;
+    for (u32 i = depth; i < depth + 8; i++) v = (v << 8) | (i < k.len ? k.data[i] : 0);
+    return v;
+}
+
+static inline int cmp_bytes(SeaSlice a, SeaSlice b) {
+    u32 n = a.len < b.len ? a.len : b.len;
+    int c = memcmp(a.data, b.data, n);
+    if (c) return c;
+    return (a.len > b.len) - (a.len < b.len);
+}
+
+/* ── Radix sort ───────────────────────────────────────────── */
+
+/* Stable LSD radix on the first `words` key words. Returns whichever
+ * of the two buffers holds the result. */
+static Rec* radix_sort(Rec* a, Rec* tmp, u32 n, u32 words) {
+    u32 hist[16][256];
+    memset(hist, 0, words * 8 * sizeof(hist[0]));
+    for (u32 i = 0; i < n; i++) {
+        for (u32 w = 0; w < words; w++) {
+            u64 k = a[i].key[w];
+            for (u32 b = 0; b < 8; b++) hist[w * 8 + b][(k >> (8 * b)) & 0xff]++;
+        }
+    }
+
+    Rec* src = a;
+    Rec* dst = tmp;
+    for (u32 w = words; w-- > 0;) {
+        for (u32 b = 0; b < 8; b++) {
+            u32* h = hist[w * 8 + b];
+            u32 shift = 8 * b;
+            if (h[(src[0].key[w] >> shift) & 0xff] == n) continue;   /* Constant byte */
+            u32 sum = 0;
+            for (u32 v = 0; v < 256; v++) { u32 c = h[v]; h[v] = sum; sum += c; }
+            for (u32 i = 0; i < n; i++) dst[h[(src[i].key[w] >> shift) & 0xff]++] = src[i];
+            Rec* t = src; src = dst; dst = t;
+        }
+    }
+    return src;
+}
+
+/* ── Ties on a string prefix ──────────────────────────────── */
+
+/* Key words first (they hold the bytes at the current depth, already
+ * inverted for reverse), whole key bytes only when those tie. */
+static inline bool rec_less(const Run* r, const Rec* x, const Rec* y) {
+    if (x->key[0] != y->key[0]) return x->key[0] < y->key[0];
+    if (x->key[1] != y->key[1]) return x->key[1] < y->key[1];
+    int c = cmp_bytes(r->keys[x->idx], r->keys[y->idx]);
+    return r->reverse ? c > 0 : c < 0;
+}
+
+static void merge_sort(const Run* r, Rec* a, Rec* tmp, u32 n) {
+    if (n <= INSERTION_MAX) {
+        for (u32 i = 1; i < n; i++) {
+            Rec v = a[i];
+            u32 j = i;
+            while (j > 0 && rec_less(r, &v, &a[j - 1])) { a[j] = a[j - 1]; j--; }
+            a[j] = v;
+        }
+        return;
+    }
+    u32 h = n / 2;
+    merge_sort(r, a, tmp, h);
+    merge_sort(r, a + h, tmp, n - h);
+    if (!rec_less(r, &a[h], &a[h - 1])) return;   /* Already in order */
+
+    memcpy(tmp, a, h * sizeof(Rec));
+    u32 i = 0, j = h, k = 0;
+    while (i < h && j < n) a[k++] = rec_less(r, &a[j], &tmp[i]) ? a[j++] : tmp[i++];
+    while (i < h) a[k++] = tmp[i++];
+}
+
+static inline void set_key(const Run* r, Rec* rec, SeaSlice k, u32 depth) {
+    u64 k0 = prefix_key(k, depth);
+    u64 k1 = prefix_key(k, depth + 8);
+    rec->key[0] = r->reverse ? ~k0 : k0;
+    rec->key[1] = r->reverse ? ~k1 : k1;
+}
+
+static inline bool key_eq(const Rec* x, const Rec* y) {
+    return x->key[0] == y->key[0] && x->key[1] == y->key[1];
+}
+
+/* Records in a[0..n) agree on their first `depth` key bytes. Re-key
+ * them on the next 16 (the only pass that touches the lines; they
+ * are in shuffled order by now, hence the prefetch), then radix sort
+ * large groups and recurse, or merge sort small ones. A long shared
+ * prefix such as a timestamp therefore never degrades to memcmp. */
+static void refine(const Run* r, Rec* a, Rec* spare, u32 n, u32 depth) {
+    bool longer = false;
+    for (u32 i = 0; i < n; i++) {
+        if (i + 8 < n) __builtin_prefetch(&r->keys[a[i + 8].idx]);
+        if (i + 4 < n) __builtin_prefetch(r->keys[a[i + 4].idx].data + depth);
+        SeaSlice k = r->keys[a[i].idx];
+        if (k.len > depth + 16) longer = true;
+        set_key(r, &a[i], k, depth);
+    }
+
+    if (n <= REFINE_MIN || !longer) {
+        merge_sort(r, a, spare, n);
+        return;
+    }
+
+    Rec* out = radix_sort(a, spare, n, 2);
+    if (out != a) memcpy(a, out, n * sizeof(Rec));
+    for (u32 s = 0; s < n;) {
+        u32 e = s + 1;
+        while (e < n && key_eq(&a[e], &a[s])) e++;
+        if (e - s > 1) refine(r, a + s, spare, e - s, depth + 16);
+        s = e;
+    }
+}
+
+/* Sort n lines already in r->lines. Returns the sorted record array. */
+static Rec* sort_run(Run* r, Rec* recs, Rec* tmp, u32 n) {
+    for (u32 i = 0; i < n; i++) {
+        SeaSlice k = key_of(r->lines[i].data, r->lines[i].len, r->o);
+        if (r->numeric) {
+            u64 key = num_key(parse_num(k));
+            recs[i].key[0] = r->reverse ? ~key : key;
+            recs[i].key[1] = 0;
+        } else {
+            r->keys[i] = k;
+            set_key(r, &recs[i], k, 0);
+        }
+        recs[i].idx = i;
+    }
+    if (n < 2) return recs;
+
+    Rec* out = radix_sort(recs, tmp, n, r->numeric ? 1 : 2);
+    if (r->numeric) return out;
+
+    Rec* spare = out == recs ? tmp : recs;
+    for (u32 s = 0; s < n;) {
+        u32 e = s + 1;
+        while (e < n && key_eq(&out[e], &out[s])) e++;
+        if (e - s > 1) refine(r, out + s, spare, e - s, 16);
+        s = e;
+    }
+    return out;
+}
+
+static inline bool same_key(const Run* r, const Rec* x, const Rec* y) {
+    if (!key_eq(x, y)) return false;
+    return r->numeric || cmp_bytes(r->keys[x->idx], r->keys[y->idx]) == 0;
+}
+
+/* ── Spill runs ───────────────────────────────────────────── */
+
+typedef struct {
+    int fd;
+    u64 size;
+} Spill;
+
+typedef struct {
+    int  fd;
+    u8*  buf;
+    u32  len;
+    u64  total;
+    bool failed;
+} Writer;
+
+static void w_raw(Writer* w, const u8* data, u64 len) {
+    u64 off = 0;
+    while (off < len && !w->failed) {
+        ssize_t n = write(w->fd, data + off, len - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) { w->failed = true; break; }
+        off += (u64)n;
+    }
+    w->total += len;
+}
+
+static void w_flush(Writer* w) {
+    w_raw(w, w->buf, w->len);
+    w->len = 0;
+}
+
+static void w_line(Writer* w, SeaSlice line) {
+    if (w->len + line.len + 1 > WRITE_BUF) w_flush(w);
+    if (line.len + 1 > WRITE_BUF) {
+        w_raw(w, line.data, line.len);   /* Longer than the buffer */
+    } else {
+        memcpy(w->buf + w->len, line.data, line.len);
+        w->len += line.len;
+    }
+    w->buf[w->len++] = '\n';
+}
+
+static int spill_open(const SeaSortOpts* o) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/seaclaw_sort_XXXXXX", o->tmp_dir ? o->tmp_dir : "/tmp");
+    int fd = mkstemp(path);
+    if (fd >= 0) unlink(path);
+    return fd;
+}
+
+/* ── Merge ────────────────────────────────────────────────── */
+
+typedef struct {
+    const u8* p;
+    const u8* end;
+    SeaSlice  line;
+    SeaSlice  key;
+    u64       nkey;
+    u32       run;
+} Cursor;
+
+static bool cur_next(Cursor* c, const SeaSortOpts* o, bool numeric, bool reverse) {
+    while (c->p < c->end) {
+        const u8* nl = memchr(c->p, '\n', (size_t)(c->end - c->p));
+        const u8* stop = nl ? nl : c->end;
+        c->line.data = c->p;
+        c->line.len  = (u32)(stop - c->p);
+        c->p = nl ? nl + 1 : c->end;
+        if (c->line.len == 0) continue;
+        c->key = key_of(c->line.data, c->line.len, o);
+        if (numeric) {
+            u64 k = num_key(parse_num(c->key));
+            c->nkey = reverse ? ~k : k;
+        }
+        return true;
+    }
+    return false;
+}
+
+static inline bool cur_less(const Cursor* a, const Cursor* b, bool numeric, bool reverse) {
+    int c;
+    if (numeric) c = (a->nkey > b->nkey) - (a->nkey < b->nkey);
+    else         c = reverse ? cmp_bytes(b->key, a->key) : cmp_bytes(a->key, b->key);
+    return c ? c < 0 : a->run < b->run;   /* Earlier run first: stable */
+}
+
+static void sift_down(Cursor** heap, u32 n, u32 i, bool numeric, bool reverse) {
+    for (;;) {
+        u32 l = 2 * i + 1, m = i;
+        if (l < n && cur_less(heap[l], heap[m], numeric, reverse)) m = l;
+        if (l + 1 < n && cur_less(heap[l + 1], heap[m], numeric, reverse)) m = l + 1;
+        if (m == i) return;
+        Cursor* t = heap[i]; heap[i] = heap[m]; heap[m] = t;
+        i = m;
+    }
+}
+
+static SeaError merge_runs(const SeaSortOpts* o, bool numeric, bool reverse, bool unique,
+                           Spill* spills, u32 nruns, SeaArena* arena,
+                           SeaSortEmit emit, void* ctx, SeaSortStats* st) {
+    Cursor*  cur  = (Cursor*)sea_arena_alloc(arena, nruns * sizeof(Cursor), _Alignof(Cursor));
+    Cursor** heap = (Cursor**)sea_arena_alloc(arena, nruns * sizeof(Cursor*), _Alignof(Cursor*));
+    u8**     maps = (u8**)sea_arena_alloc(arena, nruns * sizeof(u8*), _Alignof(u8*));
+    if (!cur || !heap || !maps) return SEA_ERR_ARENA_FULL;
+
+    SeaError err = SEA_OK;
+    u32 n = 0;
+    for (u32 i = 0; i < nruns; i++) {
+        maps[i] = NULL;
+        if (spills[i].size == 0) continue;
+        void* m = mmap(NULL, spills[i].size, PROT_READ, MAP_PRIVATE, spills[i].fd, 0);
+        if (m == MAP_FAILED) { err = SEA_ERR_IO; continue; }
+        madvise(m, spills[i].size, MADV_SEQUENTIAL);
+        maps[i] = (u8*)m;
+        cur[i].p   = maps[i];
+        cur[i].end = maps[i] + spills[i].size;
+        cur[i].run = i;
+        if (cur_next(&cur[i], o, numeric, reverse)) heap[n++] = &cur[i];
+    }
+    if (err != SEA_OK) n = 0;
+
+    for (u32 i = n / 2; i-- > 0;) sift_down(heap, n, i, numeric, reverse);
+
+    Cursor prev = { .p = NULL };
+    bool have_prev = false;
+    while (n > 0) {
+        Cursor* top = heap[0];
+        bool dup = unique && have_prev &&
+                   (numeric ? top->nkey == prev.nkey : cmp_bytes(top->key, prev.key) == 0);
+        if (!dup) {
+            st->emitted++;
+            if (emit && !emit(top->line.data, top->line.len, ctx)) { st->stopped = true; break; }
+            prev = *top;
+            have_prev = true;
+        }
+        if (!cur_next(top, o, numeric, reverse)) heap[0] = heap[--n];
+        sift_down(heap, n, 0, numeric, reverse);
+    }
+
+    for (u32 i = 0; i < nruns; i++) {
+        if (maps[i]) munmap(maps[i], spills[i].size);
+    }
+    return err;
+}
+
+/* ── Public ───────────────────────────────────────────────── */
+
+SeaError sea_sort_buffer(const u8* data, u64 len, const SeaSortOpts* opts,
+                         SeaArena* arena, SeaSortEmit emit, void* ctx,
+                         SeaSortStats* stats) {
+    SeaSortStats st;
+    memset(&st, 0, sizeof(st));
+    if (!arena || !opts) return SEA_ERR_INVALID_INPUT;
+
+    SeaSortOpts o = *opts;
+    Run r = {
+        .o       = &o,
+        .numeric = (o.flags & SEA_SORT_NUMERIC) != 0,
+        .reverse = (o.flags & SEA_SORT_REVERSE) != 0,
+        .unique  = (o.flags & SEA_SORT_UNIQUE) != 0,
+    };
+
+    SeaArenaMark mark = sea_arena_mark(arena);
+    u64 total_lines = len ? sea_count_newlines(data, len) + 1 : 0;
+
+    /* Size a run from what the arena can hold */
+    u64 avail = sea_arena_remaining(arena);
+    avail = avail > ARENA_SLACK ? avail - ARENA_SLACK : 0;
+    u64 cap = avail / (LINE_COST + 8);
+    if (o.run_lines && cap > o.run_lines) cap = o.run_lines;
+    if (cap > total_lines) cap = total_lines;
+    if (cap > 0xFFFFFFF0u) cap = 0xFFFFFFF0u;
+    if (total_lines && cap == 0) { sea_arena_rewind(arena, mark); return SEA_ERR_ARENA_FULL; }
+
+    u32 max_runs = cap ? (u32)((total_lines + cap - 1) / cap) : 0;
+    Spill* spills = NULL;
+    u32 spill_slots = 0;
+    u8* wbuf = NULL;
+    if (max_runs > 1) {
+        /* Spilling: the writer buffer and the slot table come out of the
+         * run budget, and a smaller run means more slots. Settle both
+         * before allocating; the table only grows, so this ends. */
+        u64 table = 0;
+        for (;;) {
+            u64 reserve = WRITE_BUF + table + 128;       /* + alignment */
+            u64 c = avail > reserve ? (avail - reserve) / (LINE_COST + 8) : 0;
+            if (c > cap) c = cap;
+            if (c == 0) { sea_arena_rewind(arena, mark); return SEA_ERR_ARENA_FULL; }
+            u64 runs = (total_lines + c - 1) / c;
+            if (runs * sizeof(Spill) <= table) { cap = c; max_runs = (u32)runs; break; }
+            table = runs * sizeof(Spill);
+        }
+        spills = (Spill*)sea_arena_alloc(arena, max_runs * sizeof(Spill), _Alignof(Spill));
+        wbuf = (u8*)sea_arena_alloc(arena, WRITE_BUF, 64);
+        if (!spills || !wbuf) { sea_arena_rewind(arena, mark); return SEA_ERR_ARENA_FULL; }
+        spill_slots = max_runs;
+        avail = sea_arena_remaining(arena);
+        avail = avail > ARENA_SLACK ? avail - ARENA_SLACK : 0;
+        if (cap > avail / (LINE_COST + 8)) cap = avail / (LINE_COST + 8);
+        if (cap == 0) { sea_arena_rewind(arena, mark); return SEA_ERR_ARENA_FULL; }
+    }
+
+    r.lines   = (SeaSlice*)sea_arena_alloc(arena, (cap + 1) * sizeof(SeaSlice), _Alignof(SeaSlice));
+    r.keys    = r.numeric ? NULL
+              : (SeaSlice*)sea_arena_alloc(arena, (cap + 1) * sizeof(SeaSlice), _Alignof(SeaSlice));
+    Rec* recs = (Rec*)sea_arena_alloc(arena, (cap + 1) * sizeof(Rec), _Alignof(Rec));
+    Rec* tmp  = (Rec*)sea_arena_alloc(arena, (cap + 1) * sizeof(Rec), _Alignof(Rec));
+    if (!r.lines || (!r.numeric && !r.keys) || !recs || !tmp) {
+        sea_arena_rewind(arena, mark);
+        return SEA_ERR_ARENA_FULL;
+    }
+
+    SeaError err = SEA_OK;
+    u32 nruns = 0;
+    const u8* p = data;
+    const u8* end = data + len;
+
+    while (p < end) {
+        u32 n = 0;
+        while (p < end && n < cap) {
+            const u8* nl = memchr(p, '\n', (size_t)(end - p));
+            const u8* stop = nl ? nl : end;
+            if (stop > p) {
+                r.lines[n].data = p;
+                r.lines[n].len  = (u32)(stop - p);
+                n++;
+            }
+            p = nl ? nl + 1 : end;
+        }
+        while (p < end && *p == '\n') p++;
+        st.lines += n;
+        if (n == 0) break;
+
+        Rec* sorted = sort_run(&r, recs, tmp, n);
+
+        if (nruns == 0 && p >= end) {
+            /* Everything fit: emit straight from memory */
+            const Rec* prev = NULL;
+            for (u32 i = 0; i < n; i++) {
+                if (r.unique && prev && same_key(&r, prev, &sorted[i])) continue;
+                prev = &sorted[i];
+                st.emitted++;
+                const SeaSlice* l = &r.lines[sorted[i].idx];
+                if (emit && !emit(l->data, l->len, ctx)) { st.stopped = true; break; }
+            }
+            break;
+        }
+
+        /* Spill this run */
+        if (nruns >= spill_slots) { err = SEA_ERR_ARENA_FULL; break; }
+        int fd = spill_open(&o);
+        if (fd < 0) { err = SEA_ERR_IO; break; }
+        Writer w = { .fd = fd, .buf = wbuf };
+        const Rec* prev = NULL;
+        for (u32 i = 0; i < n; i++) {
+            if (r.unique && prev && same_key(&r, prev, &sorted[i])) continue;
+            prev = &sorted[i];
+            w_line(&w, r.lines[sorted[i].idx]);
+        }
+        w_flush(&w);
+        spills[nruns].fd = fd;
+        spills[nruns].size = w.total;
+        nruns++;
+        if (w.failed) { err = SEA_ERR_IO; break; }
+    }
+
+    if (err == SEA_OK && nruns > 0) {
+        st.runs = nruns;
+        SEA_LOG_DEBUG("SORT", "Merging %u runs (%lu lines)", nruns, (unsigned long)st.lines);
+        err = merge_runs(&o, r.numeric, r.reverse, r.unique, spills, nruns, arena, emit, ctx, &st);
+    }
+
+    for (u32 i = 0; i < nruns; i++) close(spills[i].fd);
+    sea_arena_rewind(arena, mark);
+    if (stats) *stats = st;
+    return err;
+}
+
+SeaError sea_sort_file(const char* path, const SeaSortOpts* opts,
+                       SeaArena* arena, SeaSortEmit emit, void* ctx,
+                       SeaSortStats* stats) {
+    if (!path) return SEA_ERR_INVALID_INPUT;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return SEA_ERR_IO;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) { close(fd); return SEA_ERR_IO; }
+    if (st.st_size == 0) {
+        close(fd);
+        return sea_sort_buffer(NULL, 0, opts, arena, emit, ctx, stats);
+    }
+
+    u64 size = (u64)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return SEA_ERR_IO;
+    madvise(map, size, MADV_WILLNEED);
+
+    SeaError err = sea_sort_buffer((const u8*)map, size, opts, arena, emit, ctx, stats);
+    munmap(map, size);
+    return err;
+}
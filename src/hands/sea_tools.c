@@ -6,6 +6,8 @@
 
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_log.h"
+#include "seaclaw/sea_metrics.h"
+#include "seaclaw/sea_trace.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -84,7 +86,7 @@ static const SeaTool s_registry[] = {
     {10, "text_summarize","Analyze text stats. Args: text",                       tool_text_summarize },
     {11, "text_transform","Transform text. Args: <upper|lower|reverse|base64enc|base64dec> text", tool_text_transform },
     {12, "json_format",   "Pretty-print/validate JSON. Args: json string",        tool_json_format },
-    {13, "hash_compute",  "Hash text. Args: <crc32|djb2|fnv1a> text",             tool_hash_compute },
+    {13, "hash_compute",  "Hash text. Args: <crc32|crc32c|xxh64|fnv1a|sha256|djb2> text",tool_hash_compute },
     {14, "env_get",       "Get env variable (whitelisted). Args: VAR_NAME",       tool_env_get },
     {15, "dir_list",      "List directory contents. Args: path",                  tool_dir_list },
     {16, "file_info",     "File metadata. Args: file_path",                       tool_file_info },
@@ -98,11 +100,11 @@ static const SeaTool s_registry[] = {
     {24, "encode_decode", "Encode/decode. Args: <urlencode|urldecode|htmlencode|htmldecode> text", tool_encode_decode },
     {25, "regex_match",   "Regex match. Args: <pattern> <text>",                  tool_regex_match },
     {26, "csv_parse",     "Parse CSV. Args: <headers|count|col_num> <csv>",        tool_csv_parse },
-    {27, "diff_text",     "Compare texts. Args: <text1>|||<text2>",                tool_diff_text },
-    {28, "grep_text",     "Search text/file. Args: <pattern> <text_or_path>",      tool_grep_text },
+    {27, "diff_text",     "Compare texts (unified diff). Args: <text1>|||<text2>",tool_diff_text },
+    {28, "grep_text",     "Search text/file. Args: [-s] [-E] [-C N] <pattern> <text_or_path>", tool_grep_text },
     {29, "wc",            "Word count. Args: <filepath_or_text>",                  tool_wc },
     {30, "head_tail",     "First/last lines. Args: <head|tail> [N] <path_or_text>",tool_head_tail },
-    {31, "sort_text",     "Sort lines. Args: [-r] [-n] [-u] <text>",               tool_sort_text },
+    {31, "sort_text",     "Sort lines. Args: [-r] [-n] [-u] [-k N] [-t C] [-o PATH] <text|filepath>", tool_sort_text },
     {32, "net_info",      "Network info. Args: <interfaces|ip|ping|ports>",        tool_net_info },
     {33, "cron_parse",    "Explain cron. Args: <min hour dom mon dow>",            tool_cron_parse },
     {34, "disk_usage",    "Disk usage. Args: [path]",                              tool_disk_usage },
@@ -111,7 +113,7 @@ static const SeaTool s_registry[] = {
     {37, "http_request",  "HTTP request. Args: <GET|POST|HEAD> <url> [body]",      tool_http_request },
     {38, "string_replace","Find/replace. Args: <find>|||<replace>|||<text>",        tool_string_replace },
     {39, "calendar",      "Calendar/dates. Args: [month year|weekday|diff]",        tool_calendar },
-    {40, "checksum_file", "File checksum. Args: <filepath>",                       tool_checksum_file },
+    {40, "checksum_file", "File checksum. Args: <filepath> [crc32|crc32c|xxh64|fnv1a|sha256|all]",tool_checksum_file },
     {41, "file_search",   "Find files by name. Args: <pattern> [directory]",        tool_file_search },
     {42, "uptime",        "System uptime and load. Args: (none)",                  tool_uptime },
     {43, "ip_info",       "IP geolocation. Args: [ip_address]",                    tool_ip_info },
@@ -122,8 +124,8 @@ static const SeaTool s_registry[] = {
     {48, "unit_convert",  "Unit conversion. Args: <val> <from> <to>",              tool_unit_convert },
     {49, "password_gen",  "Generate password. Args: [length] [-n no symbols]",      tool_password_gen },
     {50, "count_lines",   "Count lines of code. Args: [dir] [ext]",                tool_count_lines },
-    {51, "edit_file",     "Edit file. Args: <path>|||<find>|||<replace>",           tool_edit_file },
-    {52, "cron_manage",   "Manage cron. Args: list|add|remove|pause|resume",       tool_cron_manage },
+    {51, "edit_file",     "Edit file. Args: [--preview] <path>|||<find>|||<replace>",tool_edit_file },
+    {52, "cron_manage",   "Manage cron. Args: list|add|remove|pause|resume|policy", tool_cron_manage },
     {53, "memory_manage", "Memory. Args: read|write|append|daily|bootstrap",       tool_memory_manage },
     {54, "web_search",    "Brave web search. Args: <query>",                       tool_web_search },
     {55, "spawn",         "Spawn sub-agent. Args: <task description>",              tool_spawn },
@@ -166,14 +168,36 @@ SeaError sea_tool_exec(const char* name, SeaSlice args, SeaArena* arena, SeaSlic
     if (!tool) return SEA_ERR_TOOL_NOT_FOUND;
 
     SEA_LOG_INFO("HANDS", "Executing tool: %s", tool->name);
+    u64 t0 = sea_metrics_now_us();
+    SeaTraceSpan span = sea_trace_begin(tool->name);
     SeaError err = tool->func(args, arena, output);
+    sea_trace_end(span);
+    sea_metric_observe(sea_metric_histogram("sea_tool_duration_seconds",
+                       "Tool execution time", "tool", tool->name, &SEA_METRICS_LATENCY),
+                       (f64)(sea_metrics_now_us() - t0) / 1e6);
 
     if (err != SEA_OK) {
+        sea_metric_inc(sea_metric_counter("sea_tool_errors_total",
+                       "Tool executions that returned an error", "tool", tool->name));
         SEA_LOG_ERROR("HANDS", "Tool '%s' failed: %s", tool->name, sea_error_str(err));
     }
     return err;
 }
 
+/* ── Progress ─────────────────────────────────────────────── */
+
+static _Thread_local SeaToolProgressFn s_progress_fn  = NULL;
+static _Thread_local void*             s_progress_ctx = NULL;
+
+void sea_tool_set_progress(SeaToolProgressFn fn, void* ctx) {
+    s_progress_fn  = fn;
+    s_progress_ctx = ctx;
+}
+
+void sea_tool_progress(const u8* data, u32 len) {
+    if (s_progress_fn && data && len > 0) s_progress_fn(data, len, s_progress_ctx);
+}
+
 void sea_tools_list(void) {
     printf("  %-4s %-20s %s\n", "ID", "Name", "Description");
     printf("  %-4s %-20s %s\n", "──", "────────────────────", "───────────────────────────");
@@ -0,0 +1,535 @@
+/*
+ * sea_walk.c — Parallel directory walker
+ *
+ * Each worker owns a deque of directories still to be read. The owner
+ * pops from the tail (depth-first, warm dentries); idle workers steal
+ * from the head (shallow directories, big subtrees). A shared pending
+ * counter tracks queued + in-flight directories, and the walk is over
+ * when it drops to zero.
+ *
+ * Directory paths and deque storage live in per-worker arenas that are
+ * unmapped when the walk returns. Nothing is malloc'd.
+ */
+
+#include "seaclaw/sea_walk.h"
+#include "seaclaw/sea_arena.h"
+#include "seaclaw/sea_log.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#if defined(SEA_ARCH_X86) && defined(__AVX2__)
+#include <immintrin.h>
+#define WALK_AVX2 1
+#elif defined(SEA_ARCH_ARM) && defined(__aarch64__)
+#include <arm_neon.h>
+#define WALK_NEON 1
+#endif
+
+#define WORKER_ARENA   (32 * 1024 * 1024)  /* Paths + deque, per worker (lazily committed) */
+#define DENTS_BUF      (32 * 1024)
+#define READ_BUF       (128 * 1024)
+#define DEQUE_INIT     256
+#define IDLE_WAIT_NS   (1000 * 1000)       /* 1 ms */
+
+/* ── Newline counting ─────────────────────────────────────── */
+
+u64 sea_count_newlines(const u8* data, u64 len) {
+    u64 n = 0, i = 0;
+    if (!data) return 0;
+
+#if defined(WALK_AVX2)
+    const __m256i nl = _mm256_set1_epi8('\n');
+    for (; i + 128 <= len; i += 128) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + i)),      nl);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + i + 32)), nl);
+        __m256i c = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + i + 64)), nl);
+        __m256i d = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + i + 96)), nl);
+        n += (u64)__builtin_popcount((u32)_mm256_movemask_epi8(a));
+        n += (u64)__builtin_popcount((u32)_mm256_movemask_epi8(b));
+        n += (u64)__builtin_popcount((u32)_mm256_movemask_epi8(c));
+        n += (u64)__builtin_popcount((u32)_mm256_movemask_epi8(d));
+    }
+    for (; i + 32 <= len; i += 32) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + i)), nl);
+        n += (u64)__builtin_popcount((u32)_mm256_movemask_epi8(a));
+    }
+#elif defined(WALK_NEON)
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(data + i), nl);
+        n += vaddvq_u8(vshrq_n_u8(eq, 7));
+    }
+#else
+    const u8* p   = data;
+    const u8* end = data + len;
+    while (p < end && (p = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+        n++;
+        p++;
+    }
+    i = len;
+#endif
+
+    for (; i < len; i++) n += (data[i] == '\n');
+    return n;
+}
+
+static SeaError count_fd(int fd, u8* buf, u64 cap, u64* lines, u64* bytes) {
+    u64 nl = 0, total = 0;
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    for (;;) {
+        ssize_t r = read(fd, buf, cap);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return SEA_ERR_IO;
+        }
+        if (r == 0) break;
+        nl    += sea_count_newlines(buf, (u64)r);
+        total += (u64)r;
+    }
+    if (lines) *lines = nl;
+    if (bytes) *bytes = total;
+    return SEA_OK;
+}
+
+SeaError sea_count_lines_fd(int fd, u64* lines, u64* bytes) {
+    u8 buf[64 * 1024];
+    if (fd < 0) return SEA_ERR_IO;
+    return count_fd(fd, buf, sizeof(buf), lines, bytes);
+}
+
+/* ── Name matching ────────────────────────────────────────── */
+
+static bool has_glob(const char* s) {
+    for (; *s; s++) {
+        if (*s == '*' || *s == '?' || *s == '[') return true;
+    }
+    return false;
+}
+
+bool sea_walk_name_match(const char* pattern, const char* name) {
+    if (!pattern || !pattern[0]) return true;
+    if (!name) return false;
+    if (has_glob(pattern)) return fnmatch(pattern, name, FNM_PERIOD) == 0;
+    return strstr(name, pattern) != NULL;
+}
+
+static bool ext_match(const char* const* exts, const char* name, u32 name_len) {
+    if (!exts[0]) return true;
+    for (u32 i = 0; i < SEA_WALK_MAX_EXTS && exts[i]; i++) {
+        u32 el = (u32)strlen(exts[i]);
+        if (el <= name_len && memcmp(name + name_len - el, exts[i], el) == 0) return true;
+    }
+    return false;
+}
+
+/* ── Walker state ─────────────────────────────────────────── */
+
+typedef struct {
+    const char* path;
+    u32         len;
+    u32         depth;
+} WalkJob;
+
+struct Walk;
+
+typedef struct {
+    pthread_mutex_t lock;
+    WalkJob*        jobs;      /* Ring buffer in the worker arena */
+    u32             head;
+    u32             count;
+    u32             cap;
+
+    SeaArena        arena;
+    u8*             dents;
+    u8*             rbuf;
+    SeaWalkStats    stats;
+    u32             id;
+    pthread_t       tid;
+    struct Walk*    walk;
+} WalkWorker;
+
+typedef struct Walk {
+    const SeaWalkOpts* opts;
+    WalkWorker*        workers;
+    u32                nworkers;
+    dev_t              root_dev;
+
+    atomic_uint_fast64_t pending;   /* Directories queued or being read */
+    atomic_bool          stop;
+    atomic_uint          idle;
+
+    pthread_mutex_t    visit_lock;
+    pthread_mutex_t    idle_lock;
+    pthread_cond_t     idle_cond;
+} Walk;
+
+/* ── Deque ────────────────────────────────────────────────── */
+
+static bool deque_push(WalkWorker* w, WalkJob job) {
+    pthread_mutex_lock(&w->lock);
+    if (w->count == w->cap) {
+        u32 ncap = w->cap ? w->cap * 2 : DEQUE_INIT;
+        WalkJob* nj = (WalkJob*)sea_arena_alloc(&w->arena, (u64)ncap * sizeof(WalkJob), 8);
+        if (!nj) {
+            pthread_mutex_unlock(&w->lock);
+            return false;
+        }
+        for (u32 i = 0; i < w->count; i++) {
+            nj[i] = w->jobs[(w->head + i) % w->cap];
+        }
+        w->jobs = nj;
+        w->head = 0;
+        w->cap  = ncap;
+    }
+    w->jobs[(w->head + w->count) % w->cap] = job;
+    w->count++;
+    pthread_mutex_unlock(&w->lock);
+    return true;
+}
+
+/* Owner end: newest directory first. */
+static bool deque_pop(WalkWorker* w, WalkJob* out) {
+    bool ok = false;
+    pthread_mutex_lock(&w->lock);
+    if (w->count > 0) {
+        w->count--;
+        *out = w->jobs[(w->head + w->count) % w->cap];
+        ok = true;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return ok;
+}
+
+/* Thief end: oldest (shallowest) directory first. */
+static bool deque_steal(WalkWorker* w, WalkJob* out) {
+    bool ok = false;
+    if (pthread_mutex_trylock(&w->lock) != 0) return false;
+    if (w->count > 0) {
+        *out = w->jobs[w->head];
+        w->head = (w->head + 1) % w->cap;
+        w->count--;
+        ok = true;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return ok;
+}
+
+static bool steal_any(Walk* walk, WalkWorker* self, WalkJob* out) {
+    for (u32 i = 1; i < walk->nworkers; i++) {
+        WalkWorker* victim = &walk->workers[(self->id + i) % walk->nworkers];
+        if (deque_steal(victim, out)) return true;
+    }
+    return false;
+}
+
+static void enqueue_dir(Walk* walk, WalkWorker* self, const char* path, u32 len, u32 depth) {
+    char* copy = (char*)sea_arena_alloc(&self->arena, len + 1, 1);
+    if (!copy) { self->stats.errors++; return; }
+    memcpy(copy, path, len);
+    copy[len] = '\0';
+
+    atomic_fetch_add(&walk->pending, 1);
+    if (!deque_push(self, (WalkJob){ .path = copy, .len = len, .depth = depth })) {
+        atomic_fetch_sub(&walk->pending, 1);
+        self->stats.errors++;
+        return;
+    }
+    if (atomic_load(&walk->idle) > 0) {
+        pthread_mutex_lock(&walk->idle_lock);
+        pthread_cond_signal(&walk->idle_cond);
+        pthread_mutex_unlock(&walk->idle_lock);
+    }
+}
+
+/* ── Directory reading ────────────────────────────────────── */
+
+#ifdef __linux__
+struct walk_dirent64 {
+    u64            d_ino;
+    i64            d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[];
+};
+#endif
+
+static SeaWalkType type_from_mode(mode_t m) {
+    if (S_ISREG(m)) return SEA_WALK_FILE;
+    if (S_ISDIR(m)) return SEA_WALK_DIR;
+    if (S_ISLNK(m)) return SEA_WALK_LINK;
+    return SEA_WALK_OTHER;
+}
+
+/* Handle one name inside an open directory. */
+static void visit_name(Walk* walk, WalkWorker* self, int dfd,
+                       char* path, u32 dir_len, u32 depth,
+                       const char* name, int dtype) {
+    const SeaWalkOpts* o = walk->opts;
+
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) return;
+    if ((o->flags & SEA_WALK_SKIP_HIDDEN) && name[0] == '.') return;
+
+    u32 nlen = (u32)strlen(name);
+    if (dir_len + nlen + 1 >= SEA_MAX_PATH) { self->stats.errors++; return; }
+    memcpy(path + dir_len, name, nlen + 1);
+    u32 plen = dir_len + nlen;
+
+    struct stat st;
+    bool have_st = false;
+    SeaWalkType type;
+
+    switch (dtype) {
+        case DT_REG: type = SEA_WALK_FILE; break;
+        case DT_DIR: type = SEA_WALK_DIR;  break;
+        case DT_LNK: type = SEA_WALK_LINK; break;
+        case DT_UNKNOWN:
+            if (fstatat(dfd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) { self->stats.errors++; return; }
+            have_st = true;
+            type = type_from_mode(st.st_mode);
+            break;
+        default:     type = SEA_WALK_OTHER; break;
+    }
+
+    if (type == SEA_WALK_DIR) {
+        self->stats.dirs++;
+        if (o->max_depth == 0 || depth < o->max_depth) {
+            enqueue_dir(walk, self, path, plen, depth);
+        }
+    } else if (type == SEA_WALK_FILE) {
+        self->stats.files++;
+    }
+
+    if ((o->flags & SEA_WALK_FILES_ONLY) && type != SEA_WALK_FILE) return;
+    if (!sea_walk_name_match(o->name_pattern, name)) return;
+    if (!ext_match(o->exts, name, nlen)) return;
+
+    SeaWalkEntry e = {
+        .path = path, .path_len = plen, .name = path + dir_len,
+        .type = type, .depth = depth,
+    };
+
+    if (o->flags & SEA_WALK_STAT) {
+        if (!have_st && fstatat(dfd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) have_st = true;
+        if (have_st) {
+            e.size       = (u64)st.st_size;
+            e.disk_bytes = (u64)st.st_blocks * 512;
+        }
+    }
+
+    if ((o->flags & SEA_WALK_COUNT_LINES) && type == SEA_WALK_FILE) {
+        int fd = openat(dfd, name, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+        if (fd < 0 || count_fd(fd, self->rbuf, READ_BUF, &e.lines,
+                               (o->flags & SEA_WALK_STAT) ? NULL : &e.size) != SEA_OK) {
+            self->stats.errors++;
+        }
+        if (fd >= 0) close(fd);
+    }
+
+    self->stats.matched++;
+    self->stats.bytes      += e.size;
+    self->stats.disk_bytes += e.disk_bytes;
+    self->stats.lines      += e.lines;
+
+    if (o->visit) {
+        pthread_mutex_lock(&walk->visit_lock);
+        bool more = !atomic_load(&walk->stop) && o->visit(&e, o->ctx);
+        pthread_mutex_unlock(&walk->visit_lock);
+        if (!more) atomic_store(&walk->stop, true);
+    }
+}
+
+static void scan_dir(Walk* walk, WalkWorker* self, const WalkJob* job) {
+    /* The root may be a symlink; entries below it are never followed */
+    int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC | (job->depth ? O_NOFOLLOW : 0);
+    int dfd = open(job->path, flags);
+    if (dfd < 0) { self->stats.errors++; return; }
+
+    if (walk->opts->flags & SEA_WALK_XDEV) {
+        struct stat st;
+        if (fstat(dfd, &st) != 0 || st.st_dev != walk->root_dev) {
+            close(dfd);
+            return;
+        }
+    }
+
+    char path[SEA_MAX_PATH];
+    u32 dir_len = job->len;
+    memcpy(path, job->path, dir_len);
+    if (dir_len == 0 || path[dir_len - 1] != '/') path[dir_len++] = '/';
+    path[dir_len] = '\0';
+
+    u32 depth = job->depth + 1;
+
+#ifdef __linux__
+    for (;;) {
+        long n = syscall(SYS_getdents64, dfd, self->dents, DENTS_BUF);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            self->stats.errors++;
+            break;
+        }
+        if (n == 0) break;
+        for (long off = 0; off < n; ) {
+            struct walk_dirent64* d = (struct walk_dirent64*)(self->dents + off);
+            visit_name(walk, self, dfd, path, dir_len, depth, d->d_name, d->d_type);
+            off += d->d_reclen;
+            if (atomic_load(&walk->stop)) break;
+        }
+        if (atomic_load(&walk->stop)) break;
+    }
+    close(dfd);
+#else
+    DIR* dir = fdopendir(dfd);
+    if (!dir) { close(dfd); self->stats.errors++; return; }
+    struct dirent* d;
+    while ((d = readdir(dir)) != NULL && !atomic_load(&walk->stop)) {
+        visit_name(walk, self, dfd, path, dir_len, depth, d->d_name, d->d_type);
+    }
+    closedir(dir);
+#endif
+}
+
+/* ── Worker loop ──────────────────────────────────────────── */
+
+static void* worker_main(void* arg) {
+    WalkWorker* self = (WalkWorker*)arg;
+    Walk* walk = self->walk;
+
+    while (!atomic_load(&walk->stop)) {
+        WalkJob job;
+        if (deque_pop(self, &job) || steal_any(walk, self, &job)) {
+            scan_dir(walk, self, &job);
+            if (atomic_fetch_sub(&walk->pending, 1) == 1) {
+                pthread_mutex_lock(&walk->idle_lock);
+                pthread_cond_broadcast(&walk->idle_cond);
+                pthread_mutex_unlock(&walk->idle_lock);
+            }
+            continue;
+        }
+
+        if (atomic_load(&walk->pending) == 0) break;
+
+        /* Nothing to steal yet: someone is still reading a directory. */
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += IDLE_WAIT_NS;
+        if (ts.tv_nsec >= 1000000000L) { ts.tv_sec++; ts.tv_nsec -= 1000000000L; }
+
+        atomic_fetch_add(&walk->idle, 1);
+        pthread_mutex_lock(&walk->idle_lock);
+        if (atomic_load(&walk->pending) != 0) {
+            pthread_cond_timedwait(&walk->idle_cond, &walk->idle_lock, &ts);
+        }
+        pthread_mutex_unlock(&walk->idle_lock);
+        atomic_fetch_sub(&walk->idle, 1);
+    }
+    return NULL;
+}
+
+/* ── API ──────────────────────────────────────────────────── */
+
+static u32 default_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) n = 1;
+    if (n > SEA_WALK_MAX_THREADS) n = SEA_WALK_MAX_THREADS;
+    return (u32)n;
+}
+
+SeaError sea_walk(const SeaWalkOpts* opts, SeaWalkStats* stats) {
+    if (!opts || !opts->root || !opts->root[0]) return SEA_ERR_INVALID_INPUT;
+
+    struct stat rst;
+    if (stat(opts->root, &rst) != 0 || !S_ISDIR(rst.st_mode)) return SEA_ERR_IO;
+
+    u32 root_len = (u32)strlen(opts->root);
+    if (root_len >= SEA_MAX_PATH - 1) return SEA_ERR_INVALID_INPUT;
+
+    u32 nthreads = opts->threads ? opts->threads : default_threads();
+    if (nthreads > SEA_WALK_MAX_THREADS) nthreads = SEA_WALK_MAX_THREADS;
+
+    Walk walk;
+    memset(&walk, 0, sizeof(walk));
+    WalkWorker workers[SEA_WALK_MAX_THREADS];
+    memset(workers, 0, sizeof(workers));
+
+    walk.opts     = opts;
+    walk.workers  = workers;
+    walk.root_dev = rst.st_dev;
+    atomic_init(&walk.pending, 0);
+    atomic_init(&walk.stop, false);
+    atomic_init(&walk.idle, 0);
+    pthread_mutex_init(&walk.visit_lock, NULL);
+    pthread_mutex_init(&walk.idle_lock, NULL);
+    pthread_cond_init(&walk.idle_cond, NULL);
+
+    SeaError err = SEA_OK;
+    for (u32 i = 0; i < nthreads; i++) {
+        WalkWorker* w = &workers[i];
+        if (sea_arena_create(&w->arena, WORKER_ARENA) != SEA_OK) { err = SEA_ERR_OOM; break; }
+        w->dents = (u8*)sea_arena_alloc(&w->arena, DENTS_BUF, 64);
+        w->rbuf  = (u8*)sea_arena_alloc(&w->arena, READ_BUF, 64);
+        w->id    = i;
+        w->walk  = &walk;
+        pthread_mutex_init(&w->lock, NULL);
+        walk.nworkers++;
+    }
+
+    if (err == SEA_OK) {
+        /* Seed worker 0 with the root; depth 0 so children are depth 1. */
+        atomic_fetch_add(&walk.pending, 1);
+        WalkJob root = { .path = opts->root, .len = root_len, .depth = 0 };
+        if (!deque_push(&workers[0], root)) err = SEA_ERR_OOM;
+    }
+
+    if (err == SEA_OK) {
+        u32 started = 1;
+        for (u32 i = 1; i < walk.nworkers; i++) {
+            if (pthread_create(&workers[i].tid, NULL, worker_main, &workers[i]) != 0) break;
+            started++;
+        }
+        worker_main(&workers[0]);
+        for (u32 i = 1; i < started; i++) pthread_join(workers[i].tid, NULL);
+    }
+
+    SeaWalkStats total;
+    memset(&total, 0, sizeof(total));
+    for (u32 i = 0; i < walk.nworkers; i++) {
+        SeaWalkStats* s = &workers[i].stats;
+        total.dirs       += s->dirs;
+        total.files      += s->files;
+        total.matched    += s->matched;
+        total.bytes      += s->bytes;
+        total.disk_bytes += s->disk_bytes;
+        total.lines      += s->lines;
+        total.errors     += s->errors;
+        pthread_mutex_destroy(&workers[i].lock);
+        sea_arena_destroy(&workers[i].arena);
+    }
+    total.stopped = atomic_load(&walk.stop);
+
+    pthread_mutex_destroy(&walk.visit_lock);
+    pthread_mutex_destroy(&walk.idle_lock);
+    pthread_cond_destroy(&walk.idle_cond);
+
+    if (stats) *stats = total;
+
+    SEA_LOG_DEBUG("WALK", "%s: %lu dirs, %lu files, %lu matched, %u threads",
+                  opts->root, (unsigned long)total.dirs, (unsigned long)total.files,
+                  (unsigned long)total.matched, walk.nworkers);
+    return err;
+}
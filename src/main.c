@@ -24,6 +24,9 @@
 #include "seaclaw/sea_memory.h"
 #include "seaclaw/sea_skill.h"
 #include "seaclaw/sea_usage.h"
+#include "seaclaw/sea_llm_cache.h"
+#include "seaclaw/sea_metrics.h"
+#include "seaclaw/sea_trace.h"
 #include "seaclaw/sea_recall.h"
 #include "seaclaw/sea_pii.h"
 #include "seaclaw/sea_mesh.h"
@@ -39,10 +42,25 @@
 /* ── Constants ────────────────────────────────────────────── */
 
 #define ARENA_SIZE       (16 * 1024 * 1024)   /* 16 MB */
-#define REQUEST_ARENA    (1  * 1024 * 1024)    /* 1 MB per request */
+#define REQUEST_ARENA    (1  * 1024 * 1024)    /* 1 MB kept per request arena */
+#define REQUEST_ARENA_MIN (256 * 1024)          /* First segment            */
+#define REQUEST_ARENA_MAX (32 * 1024 * 1024)    /* Growth ceiling           */
 #define INPUT_BUF_SIZE   4096
 #define DEFAULT_DB_PATH  "seaclaw.db"
 
+/* Request arenas start small, grow for the odd large reply, and hand
+ * anything past REQUEST_ARENA back to the kernel on reset. */
+static SeaError request_arena_create(SeaArena* arena, const char* name) {
+    SeaArenaConfig cfg = {
+        .size   = REQUEST_ARENA_MIN,
+        .max    = REQUEST_ARENA_MAX,
+        .retain = REQUEST_ARENA,
+        .flags  = SEA_ARENA_GROW,
+        .name   = name,
+    };
+    return sea_arena_create_ex(arena, &cfg);
+}
+
 /* ── ASCII Banner ─────────────────────────────────────────── */
 
 static const char* BANNER =
@@ -77,10 +95,13 @@ SeaMemory*               s_memory = NULL;
 static SeaSkillRegistry  s_skill_reg;
 static SeaUsageTracker   s_usage_inst;
 SeaUsageTracker*         s_usage = NULL;
+SeaLlmCache*             s_llm_cache = NULL;
 static SeaRecall         s_recall_inst;
 SeaRecall*               s_recall = NULL;
 static SeaMesh           s_mesh_inst;
 SeaMesh*                 s_mesh = NULL;
+static SeaMeshServer*    s_mesh_server = NULL;
+static SeaA2aRegistry*   s_a2a_registry = NULL;
 static bool              s_mesh_mode = false;
 static const char*       s_mesh_role_str = NULL;
 
@@ -91,6 +112,31 @@ static void handle_signal(int sig) {
     s_running = false;
 }
 
+/* SIGUSR2 asks for a trace dump; the main loops write it. */
+#define TRACE_DUMP_PATH "seaclaw-trace.json"
+
+static volatile sig_atomic_t s_trace_dump_requested = 0;
+
+static void handle_trace_signal(int sig) {
+    (void)sig;
+    s_trace_dump_requested = 1;
+}
+
+static void trace_poll(void) {
+    if (!s_trace_dump_requested) return;
+    s_trace_dump_requested = 0;
+    sea_trace_dump(TRACE_DUMP_PATH, NULL);
+}
+
+/* "all" (default), "off", or "1/N" for one request in N */
+static u32 trace_every(const char* mode) {
+    if (!mode || strcmp(mode, "all") == 0) return 1;
+    if (strcmp(mode, "off") == 0) return 0;
+    if (strncmp(mode, "1/", 2) == 0 && atoi(mode + 2) > 0) return (u32)atoi(mode + 2);
+    SEA_LOG_WARN("CONFIG", "Unknown trace mode '%s', tracing all requests", mode);
+    return 1;
+}
+
 /* ── .env file loader ────────────────────────────────────── */
 
 static void load_dotenv(const char* path) {
@@ -151,6 +197,7 @@ static void cmd_help(void) {
     printf("    /tools             List available tools\n");
     printf("    /exec <tool> <arg> Execute a tool\n");
     printf("    /tasks             List pending tasks\n");
+    printf("    /trace [path]      Dump recent request traces\n");
     printf("    /clear             Clear screen\n");
     printf("    /quit              Exit Sea-Claw\n");
     printf("\n");
@@ -238,6 +285,16 @@ static void dispatch_command(const char* input) {
             printf("\n");
             sea_arena_reset(&s_request_arena);
         }
+    } else if (strcmp(input, "/trace") == 0 || strncmp(input, "/trace ", 7) == 0) {
+        const char* path = input[6] ? input + 7 : TRACE_DUMP_PATH;
+        while (*path == ' ') path++;
+        if (!*path) path = TRACE_DUMP_PATH;
+        u32 spans = 0;
+        SeaError err = sea_trace_dump(path, &spans);
+        if (err == SEA_OK)
+            printf("  Wrote %u spans to %s (open in ui.perfetto.dev)\n", spans, path);
+        else
+            printf("  Trace dump failed: %s\n", sea_error_str(err));
     } else if (strcmp(input, "/clear") == 0) {
         printf("\033[2J\033[H");
         printf("%s\n", BANNER);
@@ -251,15 +308,22 @@ static void dispatch_command(const char* input) {
 
         /* Shield: validate input grammar */
         u64 t0 = sea_log_elapsed_ms();
+        sea_trace_request_begin("tui");
         printf("\n  \033[33m[SHIELD]\033[0m Validating input grammar... ");
 
-        if (sea_shield_detect_injection(input_slice)) {
+        SeaTraceSpan shield_span = sea_trace_begin("shield");
+        bool injected = sea_shield_detect_injection(input_slice);
+        bool safe     = !injected && sea_shield_check(input_slice, SEA_GRAMMAR_SAFE_TEXT);
+        sea_trace_end(shield_span);
+        if (injected) {
             printf("\033[31mREJECTED\033[0m (injection detected)\n\n");
+            sea_trace_request_end();
             sea_arena_reset(&s_request_arena);
             return;
         }
-        if (!sea_shield_check(input_slice, SEA_GRAMMAR_SAFE_TEXT)) {
+        if (!safe) {
             printf("\033[31mREJECTED\033[0m (invalid characters)\n\n");
+            sea_trace_request_end();
             sea_arena_reset(&s_request_arena);
             return;
         }
@@ -271,10 +335,12 @@ static void dispatch_command(const char* input) {
             /* Load conversation history from DB */
             SeaDbChatMsg db_msgs[20];
             i32 hist_count = 0;
+            SeaTraceSpan hist_span = sea_trace_begin("history");
             if (s_db) {
                 hist_count = sea_db_chat_history(s_db, 0, db_msgs, 20,
                                                  &s_request_arena);
             }
+            sea_trace_end(hist_span);
 
             /* Convert DB messages to agent format */
             SeaChatMsg history[20];
@@ -299,10 +365,12 @@ static void dispatch_command(const char* input) {
                            ar.tool_calls, ar.tool_calls > 1 ? "s" : "");
                 }
                 /* Save to conversation memory */
+                SeaTraceSpan save_span = sea_trace_begin("chat.save");
                 if (s_db) {
                     sea_db_chat_log(s_db, 0, "user", input);
                     sea_db_chat_log(s_db, 0, "assistant", ar.text);
                 }
+                sea_trace_end(save_span);
             } else {
                 printf("  \033[31m[ERROR]\033[0m %s\n",
                        ar.text ? ar.text : "Agent failed");
@@ -313,6 +381,7 @@ static void dispatch_command(const char* input) {
             printf("  \033[33m[BRAIN]\033[0m No LLM configured. Set llm_api_key in config.json\n");
             printf("  \033[37m[ECHO]\033[0m %s\n", input);
         }
+        sea_trace_request_end();
         u64 t1 = sea_log_elapsed_ms();
         printf("  \033[37m[CORE]\033[0m Arena reset. (%lums)\n\n", (unsigned long)(t1 - t0));
         sea_arena_reset(&s_request_arena);
@@ -321,10 +390,13 @@ static void dispatch_command(const char* input) {
 
 /* ── Telegram message handler ───────────────────────────── */
 
-static SeaError telegram_handler(i64 chat_id, SeaSlice text,
-                                  SeaArena* arena, SeaSlice* response) {
+static SeaError telegram_handle(i64 chat_id, SeaSlice text,
+                                 SeaArena* arena, SeaSlice* response) {
     /* Shield check */
-    if (sea_shield_detect_injection(text)) {
+    SeaTraceSpan shield_span = sea_trace_begin("shield");
+    bool injected = sea_shield_detect_injection(text);
+    sea_trace_end(shield_span);
+    if (injected) {
         *response = SEA_SLICE_LIT("Rejected: injection detected.");
         return SEA_OK;
     }
@@ -375,10 +447,13 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
                 "/model set <name> — Hot-swap LLM model\n"
                 "/think [off|low|medium|high] — Set thinking level\n"
                 "/usage — Token spend dashboard\n"
+                "/trace — Dump recent request traces\n"
                 "/pii [on|off] — Toggle PII firewall\n"
                 "/mesh — Show mesh network status\n"
                 "/audit — View recent audit trail\n"
-                "/delegate <url> <task> — Delegate to remote agent\n"
+                "/peers — Known A2A peers and their health\n"
+                "/delegate <url[,url...]> <task> — Delegate to remote agent(s)\n"
+                "/delegate <task> — Delegate to the best healthy known peer\n"
                 "/exec <tool> <args> — Raw tool exec\n\n"
                 "Or just type naturally — I'll use AI + tools.");
             return SEA_OK;
@@ -489,30 +564,64 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
             return SEA_OK;
         }
 
-        /* /delegate <endpoint> <task> — delegate task to remote agent */
+        /* /delegate [endpoint[,endpoint...]] <task> — delegate task to remote agent */
         if (text.len > 10 && memcmp(text.data, "/delegate ", 10) == 0) {
             const char* rest = (const char*)text.data + 10;
             u32 rlen = text.len - 10;
             /* Parse: endpoint task_description */
             u32 i = 0;
             while (i < rlen && rest[i] != ' ') i++;
-            if (i == 0 || i >= rlen) {
-                *response = SEA_SLICE_LIT("Usage: /delegate <endpoint> <task description>");
-                return SEA_OK;
-            }
             char* ep = (char*)sea_arena_alloc(arena, i + 1, 1);
             if (!ep) { *response = SEA_SLICE_LIT("Memory error."); return SEA_ERR_OOM; }
             memcpy(ep, rest, i); ep[i] = '\0';
+
+            /* No URL: the whole line is the task, sent to registry peers */
+            bool from_registry = strstr(ep, "://") == NULL;
+            if (from_registry) i = 0;
+            else if (i >= rlen) {
+                *response = SEA_SLICE_LIT("Usage: /delegate [endpoint[,endpoint...]] <task description>");
+                return SEA_OK;
+            }
             while (i < rlen && rest[i] == ' ') i++;
             char* task = (char*)sea_arena_alloc(arena, rlen - i + 1, 1);
             if (!task) { *response = SEA_SLICE_LIT("Memory error."); return SEA_ERR_OOM; }
             memcpy(task, rest + i, rlen - i); task[rlen - i] = '\0';
+            if (!*task) {
+                *response = SEA_SLICE_LIT("Usage: /delegate [endpoint[,endpoint...]] <task description>");
+                return SEA_OK;
+            }
 
-            SeaA2aPeer peer = { .name = ep, .endpoint = ep, .api_key = NULL,
-                                .healthy = false, .last_seen = 0 };
+            /* Comma-separated endpoints race; first verified answer wins */
+            SeaA2aPeer peers[8];
+            u32 npeers = 0;
+            if (from_registry) {
+                npeers = sea_a2a_registry_pick(s_a2a_registry, NULL, peers, 3, arena);
+                if (npeers == 0) {
+                    *response = SEA_SLICE_LIT("No healthy A2A peers known. See /peers.");
+                    return SEA_OK;
+                }
+            }
+            char* save = NULL;
+            for (char* tok = from_registry ? NULL : strtok_r(ep, ",", &save); tok && npeers < 8;
+                 tok = strtok_r(NULL, ",", &save)) {
+                peers[npeers++] = (SeaA2aPeer){ .name = tok, .endpoint = tok, .api_key = NULL,
+                                                .healthy = false, .last_seen = 0 };
+            }
+            if (npeers == 0) {
+                *response = SEA_SLICE_LIT("Usage: /delegate [endpoint[,endpoint...]] <task description>");
+                return SEA_OK;
+            }
             SeaA2aRequest req = { .task_id = NULL, .task_desc = task,
                                   .context = NULL, .timeout_ms = 30000 };
-            SeaA2aResult ar = sea_a2a_delegate(&peer, &req, arena);
+            SeaA2aPolicy policy = { .mode = SEA_A2A_FIRST_SUCCESS };
+            SeaA2aResult per_peer[8];
+            SeaA2aResult ar = sea_a2a_delegate_multi(peers, npeers, &req, &policy, arena, per_peer);
+            for (u32 p = 0; p < npeers; p++) {
+                /* Cancelled losers said nothing about their health */
+                if (per_peer[p].success || !per_peer[p].error ||
+                    strcmp(per_peer[p].error, "Cancelled") != 0)
+                    sea_a2a_registry_report(s_a2a_registry, peers[p].endpoint, per_peer[p].success);
+            }
 
             char buf[2048];
             int n;
@@ -636,6 +745,22 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
             return SEA_OK;
         }
 
+        /* /trace — dump recent spans as Chrome trace JSON. Always to
+         * TRACE_DUMP_PATH: a chat may not choose where the process writes. */
+        if (sea_slice_eq_cstr(text, "/trace") ||
+            (text.len > 7 && memcmp(text.data, "/trace ", 7) == 0)) {
+            const char* path = TRACE_DUMP_PATH;
+            u32 spans = 0;
+            SeaError err = sea_trace_dump(path, &spans);
+            char buf[384];
+            int n = err == SEA_OK
+                ? snprintf(buf, sizeof(buf), "Wrote %u spans to %s", spans, path)
+                : snprintf(buf, sizeof(buf), "Trace dump failed: %s", sea_error_str(err));
+            u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)n);
+            if (dst) { response->data = dst; response->len = (u32)n; }
+            return SEA_OK;
+        }
+
         /* /usage — token spend dashboard */
         if (sea_slice_eq_cstr(text, "/usage")) {
             if (!s_usage) {
@@ -644,6 +769,17 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
             }
             char buf[2048];
             u32 slen = sea_usage_summary(s_usage, buf, sizeof(buf));
+            if (s_llm_cache && slen > 0 && slen < sizeof(buf)) {
+                SeaLlmCacheStats cs;
+                sea_llm_cache_stats(s_llm_cache, &cs);
+                int n = snprintf(buf + slen, sizeof(buf) - slen,
+                    "\nResponse cache: %llu hits, %llu shared, %llu misses "
+                    "(%llu entries, %llu KB)\n",
+                    (unsigned long long)cs.hits, (unsigned long long)cs.shared,
+                    (unsigned long long)cs.misses, (unsigned long long)cs.entries,
+                    (unsigned long long)(cs.bytes / 1024));
+                if (n > 0) slen += ((u32)n < sizeof(buf) - slen) ? (u32)n : (u32)(sizeof(buf) - slen - 1);
+            }
             if (slen > 0) {
                 u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)slen);
                 if (dst) { response->data = dst; response->len = slen; }
@@ -683,12 +819,39 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
                 *response = SEA_SLICE_LIT("Mesh not enabled. Use --mode captain|crew");
                 return SEA_OK;
             }
+            /* Refresh node health before reporting it */
+            if (s_mesh->config.role == SEA_MESH_CAPTAIN)
+                sea_mesh_probe_health(s_mesh, arena, NULL, 0);
             const char* status = sea_mesh_status(s_mesh, arena);
             response->data = (const u8*)status;
             response->len = (u32)strlen(status);
             return SEA_OK;
         }
 
+        /* /peers — A2A peer registry */
+        if (sea_slice_eq_cstr(text, "/peers")) {
+            SeaA2aRegistryPeer peers[SEA_A2A_REGISTRY_MAX];
+            u32 n = sea_a2a_registry_snapshot(s_a2a_registry, peers, SEA_A2A_REGISTRY_MAX);
+            if (n == 0) {
+                *response = SEA_SLICE_LIT("No A2A peers known. Set a2a_discovery_url in config.json.");
+                return SEA_OK;
+            }
+            char buf[4096];
+            int pos = snprintf(buf, sizeof(buf), "A2A peers (%u):\n", n);
+            for (u32 i = 0; i < n && pos < (int)sizeof(buf) - 256; i++) {
+                const SeaA2aRegistryPeer* p = &peers[i];
+                pos += snprintf(buf + pos, sizeof(buf) - (size_t)pos,
+                    "%s %s — %s\n  heartbeat %.1fms, %llu/%llu probes failed%s\n",
+                    p->healthy ? "●" : "○", p->name[0] ? p->name : "(unnamed)", p->endpoint,
+                    (double)p->latency_us / 1000.0,
+                    (unsigned long long)p->probe_failures, (unsigned long long)p->probes,
+                    p->fail_streak ? ", backing off" : "");
+            }
+            u8* dst = (u8*)sea_arena_push_bytes(arena, buf, (u64)pos);
+            if (dst) { response->data = dst; response->len = (u32)pos; }
+            return SEA_OK;
+        }
+
         /* /exec <tool> <args> — raw tool execution */
         if (text.len > 6 && memcmp(text.data, "/exec ", 6) == 0) {
             const u8* rest = text.data + 6;
@@ -724,9 +887,11 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
         /* Load conversation history from DB */
         SeaDbChatMsg db_msgs[20];
         i32 hist_count = 0;
+        SeaTraceSpan hist_span = sea_trace_begin("history");
         if (s_db) {
             hist_count = sea_db_chat_history(s_db, chat_id, db_msgs, 20, arena);
         }
+        sea_trace_end(hist_span);
 
         /* Convert DB messages to agent format */
         SeaChatMsg history[20];
@@ -747,10 +912,12 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
             response->data = (const u8*)ar.text;
             response->len  = (u32)strlen(ar.text);
             /* Save to conversation memory */
+            SeaTraceSpan save_span = sea_trace_begin("chat.save");
             if (s_db) {
                 sea_db_chat_log(s_db, chat_id, "user", input);
                 sea_db_chat_log(s_db, chat_id, "assistant", ar.text);
             }
+            sea_trace_end(save_span);
         } else {
             const char* err_msg = ar.text ? ar.text : "Agent error.";
             response->data = (const u8*)err_msg;
@@ -763,6 +930,17 @@ static SeaError telegram_handler(i64 chat_id, SeaSlice text,
     return sea_tool_exec("echo", text, arena, response);
 }
 
+/* Each inbound message is one traced request, keyed by its chat. */
+static SeaError telegram_handler(i64 chat_id, SeaSlice text,
+                                  SeaArena* arena, SeaSlice* response) {
+    char key[SEA_TRACE_KEY_MAX];
+    snprintf(key, sizeof(key), "telegram:%lld", (long long)chat_id);
+    sea_trace_request_begin(key);
+    SeaError err = telegram_handle(chat_id, text, arena, response);
+    sea_trace_request_end();
+    return err;
+}
+
 /* ── Telegram polling loop (legacy direct mode) ─────────── */
 
 static int run_telegram(const char* token, i64 chat_id) {
@@ -784,6 +962,7 @@ static int run_telegram(const char* token, i64 chat_id) {
     SEA_LOG_INFO("STATUS", "Telegram polling started. Ctrl+C to stop.");
 
     while (s_running) {
+        trace_poll();
         err = sea_telegram_poll(&s_telegram);
         if (err != SEA_OK && err != SEA_ERR_TIMEOUT) {
             SEA_LOG_WARN("TELEGRAM", "Poll error: %s (retrying in 5s)", sea_error_str(err));
@@ -805,7 +984,7 @@ static void* gateway_agent_thread(void* arg) {
     SEA_LOG_INFO("GATEWAY", "Agent loop started (bus consumer)");
 
     SeaArena agent_arena;
-    if (sea_arena_create(&agent_arena, REQUEST_ARENA) != SEA_OK) {
+    if (request_arena_create(&agent_arena, "agent") != SEA_OK) {
         SEA_LOG_ERROR("GATEWAY", "Failed to create agent arena");
         return NULL;
     }
@@ -824,10 +1003,16 @@ static void* gateway_agent_thread(void* arg) {
         /* Check if it's a command (starts with /) — handle via telegram_handler logic */
         SeaSlice text_slice = { .data = (const u8*)msg.content, .len = msg.content_len };
 
+        sea_trace_request_begin(msg.session_key);
+
         /* Shield check */
-        if (!sea_shield_check(text_slice, SEA_GRAMMAR_SAFE_TEXT)) {
+        SeaTraceSpan shield_span = sea_trace_begin("shield");
+        bool safe = sea_shield_check(text_slice, SEA_GRAMMAR_SAFE_TEXT);
+        sea_trace_end(shield_span);
+        if (!safe) {
             sea_bus_publish_outbound(&s_bus, msg.channel, msg.chat_id,
                                      "Rejected: invalid input.", 24);
+            sea_trace_request_end();
             sea_arena_reset(&agent_arena);
             continue;
         }
@@ -837,10 +1022,12 @@ static void* gateway_agent_thread(void* arg) {
             /* Load conversation history from DB */
             SeaDbChatMsg db_msgs[20];
             i32 hist_count = 0;
+            SeaTraceSpan hist_span = sea_trace_begin("history");
             if (s_db) {
                 hist_count = sea_db_chat_history(s_db, msg.chat_id, db_msgs, 20,
                                                  &agent_arena);
             }
+            sea_trace_end(hist_span);
 
             /* Convert DB messages to agent format */
             SeaChatMsg history[20];
@@ -862,10 +1049,12 @@ static void* gateway_agent_thread(void* arg) {
                 sea_bus_publish_outbound(&s_bus, msg.channel, msg.chat_id,
                                          ar.text, rlen);
                 /* Save to conversation memory */
+                SeaTraceSpan save_span = sea_trace_begin("chat.save");
                 if (s_db) {
                     sea_db_chat_log(s_db, msg.chat_id, "user", msg.content);
                     sea_db_chat_log(s_db, msg.chat_id, "assistant", ar.text);
                 }
+                sea_trace_end(save_span);
             } else {
                 const char* err_msg = ar.text ? ar.text : "Agent error.";
                 sea_bus_publish_outbound(&s_bus, msg.channel, msg.chat_id,
@@ -876,6 +1065,7 @@ static void* gateway_agent_thread(void* arg) {
                                      "No LLM configured.", 19);
         }
 
+        sea_trace_request_end();
         sea_arena_reset(&agent_arena);
     }
 
@@ -949,6 +1139,7 @@ static int run_gateway(const char* tg_token, i64 tg_chat_id) {
     /* Wait for shutdown signal */
     while (s_running) {
         sleep(1);
+        trace_poll();
     }
 
     /* Graceful shutdown */
@@ -1246,6 +1437,7 @@ int main(int argc, char** argv) {
     /* Trap signals for clean shutdown */
     signal(SIGINT,  handle_signal);
     signal(SIGTERM, handle_signal);
+    signal(SIGUSR2, handle_trace_signal);
 
     /* Initialize logging */
     sea_log_init(SEA_LOG_INFO);
@@ -1262,6 +1454,17 @@ int main(int argc, char** argv) {
     sea_arena_create(&cfg_arena, 8192);
     sea_config_load(&s_config, s_config_path, &cfg_arena);
 
+    /* From here on, log lines are queued and written by a background thread */
+    SeaLogConfig log_cfg = {
+        .overflow = (s_config.log_overflow && strcmp(s_config.log_overflow, "block") == 0)
+                    ? SEA_LOG_BLOCK : SEA_LOG_DROP,
+    };
+    if (sea_log_start(&log_cfg) != SEA_OK)
+        SEA_LOG_WARN("SYSTEM", "Log writer unavailable, logging synchronously");
+
+    /* Request tracing; /trace or SIGUSR2 dumps the recent spans */
+    sea_trace_init(trace_every(s_config.trace));
+
     /* Environment variable overrides for secrets (non-empty only) */
     const char* env_val;
     /* Note: LLM API keys are resolved per-provider below in the agent init section */
@@ -1289,11 +1492,16 @@ int main(int argc, char** argv) {
     u64 arena_bytes = (u64)arena_mb * 1024 * 1024;
     SEA_LOG_INFO("SYSTEM", "Substrate initializing. Arena: %uMB (Fixed).", arena_mb);
 
-    if (sea_arena_create(&s_session_arena, arena_bytes) != SEA_OK) {
+    SeaArenaConfig session_cfg = {
+        .size  = arena_bytes,
+        .flags = SEA_ARENA_HUGE,
+        .name  = "session",
+    };
+    if (sea_arena_create_ex(&s_session_arena, &session_cfg) != SEA_OK) {
         SEA_LOG_ERROR("SYSTEM", "Failed to create session arena");
         return 1;
     }
-    if (sea_arena_create(&s_request_arena, REQUEST_ARENA) != SEA_OK) {
+    if (request_arena_create(&s_request_arena, "request") != SEA_OK) {
         SEA_LOG_ERROR("SYSTEM", "Failed to create request arena");
         sea_arena_destroy(&s_session_arena);
         return 1;
@@ -1305,6 +1513,13 @@ int main(int argc, char** argv) {
     /* Initialize database */
     if (sea_db_open(&s_db, s_db_path) == SEA_OK) {
         SEA_LOG_INFO("DB", "Ledger open: %s", s_db_path);
+        SeaDbAuditConfig audit_cfg = {
+            .retain_days     = s_config.audit_retain_days,
+            .retain_rows     = s_config.audit_retain_rows,
+            .downsample_days = 7,
+        };
+        if (sea_db_audit_start(s_db, &audit_cfg) != SEA_OK)
+            SEA_LOG_WARN("DB", "Audit writer unavailable, logging synchronously");
         sea_db_log_event(s_db, "startup", "Sea-Claw started", SEA_VERSION_STRING);
     } else {
         SEA_LOG_WARN("DB", "Running without database.");
@@ -1373,6 +1588,7 @@ int main(int argc, char** argv) {
     if (sea_cron_init(&s_cron_inst, s_db, NULL) == SEA_OK) {
         s_cron = &s_cron_inst;
         sea_cron_load(s_cron);
+        sea_cron_start(s_cron);
         SEA_LOG_INFO("CRON", "Scheduler ready (%u jobs)", sea_cron_count(s_cron));
     }
 
@@ -1393,14 +1609,26 @@ int main(int argc, char** argv) {
     if (sea_usage_init(&s_usage_inst, s_db) == SEA_OK) {
         s_usage = &s_usage_inst;
         sea_usage_load(s_usage);
+        sea_usage_start(s_usage, 0);
     }
 
+    /* Response cache and request coalescing for LLM calls */
+    SeaLlmCacheConfig cache_cfg = {
+        .ttl_sec   = s_config.llm_cache_ttl_sec,
+        .max_bytes = (u64)s_config.llm_cache_max_mb * 1024 * 1024,
+    };
+    s_llm_cache = sea_llm_cache_create(s_db, &cache_cfg);
+
     /* Initialize recall engine (SQLite memory index) */
     if (s_db && sea_recall_init(&s_recall_inst, s_db, 800) == SEA_OK) {
         s_recall = &s_recall_inst;
         SEA_LOG_INFO("RECALL", "Memory index ready (%u facts)", sea_recall_count(s_recall));
     }
 
+    /* Prometheus endpoint, loopback only */
+    if (s_config.metrics_port > 0 && s_config.metrics_port <= 65535)
+        sea_metrics_serve((u16)s_config.metrics_port);
+
     /* Initialize mesh engine if --mode specified */
     if (s_mesh_mode && s_mesh_role_str) {
         SeaMeshConfig mcfg;
@@ -1419,12 +1647,26 @@ int main(int argc, char** argv) {
             char hostname[64] = "node";
             gethostname(hostname, sizeof(hostname));
             strncpy(mcfg.node_name, hostname, SEA_MESH_NODE_NAME_MAX - 1);
+            if (s_config.mesh_secret)
+                snprintf(mcfg.shared_secret, sizeof(mcfg.shared_secret), "%s", s_config.mesh_secret);
+            if (s_config.mesh_allowed_subnet)
+                snprintf(mcfg.allowed_subnet, sizeof(mcfg.allowed_subnet), "%s",
+                         s_config.mesh_allowed_subnet);
             if (sea_mesh_init(&s_mesh_inst, &mcfg, s_db) == SEA_OK) {
                 s_mesh = &s_mesh_inst;
+                if (!mcfg.shared_secret[0])
+                    SEA_LOG_WARN("MESH", "HTTP endpoint disabled: set mesh_secret in config");
+                else if (sea_mesh_server_start(s_mesh, NULL, 0, &s_mesh_server) != SEA_OK)
+                    SEA_LOG_WARN("MESH", "HTTP endpoint unavailable on port %u", mcfg.port);
             }
         }
     }
 
+    /* A2A peer registry: restored from the ledger, probed in background */
+    SeaA2aRegistryConfig a2a_cfg = { .discovery_url = s_config.a2a_discovery_url };
+    if (sea_a2a_registry_create(&s_a2a_registry, s_db, &a2a_cfg) == SEA_OK)
+        sea_a2a_registry_start(s_a2a_registry);
+
     SEA_LOG_INFO("SHIELD", "Grammar Filter: ACTIVE.");
 
     int ret = 0;
@@ -1456,6 +1698,7 @@ int main(int argc, char** argv) {
                 input[--len] = '\0';
             }
 
+            trace_poll();
             if (len == 0) continue;
 
             dispatch_command(input);
@@ -1466,8 +1709,12 @@ int main(int argc, char** argv) {
 
     printf("\n");
     SEA_LOG_INFO("SYSTEM", "Shutting down...");
+    sea_metrics_stop();
+    if (s_mesh_server) { sea_mesh_server_stop(s_mesh_server); s_mesh_server = NULL; }
     if (s_mesh) { sea_mesh_destroy(s_mesh); s_mesh = NULL; }
-    if (s_usage) { sea_usage_save(s_usage); s_usage = NULL; }
+    if (s_a2a_registry) { sea_a2a_registry_destroy(s_a2a_registry); s_a2a_registry = NULL; }
+    if (s_usage) { sea_usage_destroy(s_usage); s_usage = NULL; }
+    if (s_llm_cache) { sea_llm_cache_destroy(s_llm_cache); s_llm_cache = NULL; }
     if (s_recall) { sea_recall_destroy(s_recall); s_recall = NULL; }
     if (s_cron) { sea_cron_destroy(s_cron); s_cron = NULL; }
     if (s_memory) { sea_memory_destroy(s_memory); s_memory = NULL; }
@@ -1480,6 +1727,7 @@ int main(int argc, char** argv) {
     sea_arena_destroy(&s_session_arena);
     sea_arena_destroy(&cfg_arena);
     SEA_LOG_INFO("SYSTEM", "Goodbye. The Vault stands.");
+    sea_log_stop();
 
     return ret;
 }
@@ -82,7 +82,7 @@ SeaError sea_memory_init(SeaMemory* mem, const char* workspace_path, u64 arena_s
     build_path(notes_dir, sizeof(notes_dir), mem->workspace, SEA_MEMORY_NOTES_DIR);
     ensure_dir(notes_dir);
 
-    SeaError err = sea_arena_create(&mem->arena, arena_size);
+    SeaError err = sea_arena_create_named(&mem->arena, "memory", arena_size);
     if (err != SEA_OK) return err;
 
     mem->initialized = true;
@@ -3,16 +3,18 @@
  *
  * Captain/Crew architecture. All communication over HTTP JSON-RPC
  * within the local network. HMAC-authenticated, Shield-verified.
+ * Tool calls are routed through a hashed capability index and a
+ * power-of-two-choices pick over in-flight load and EWMA latency.
  */
 
 #include "seaclaw/sea_mesh.h"
 #include "seaclaw/sea_http.h"
 #include "seaclaw/sea_json.h"
-#include "seaclaw/sea_shield.h"
 #include "seaclaw/sea_log.h"
 #include "seaclaw/sea_tools.h"
 
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
 
@@ -44,6 +46,59 @@ static u64 fnv1a_hash(const u8* data, u32 len) {
     return h;
 }
 
+static u64 mono_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000 + (u64)ts.tv_nsec / 1000;
+}
+
+/* ── Capability Index ────────────────────────────────────── */
+
+#define CAP_MASK (SEA_MESH_CAP_SLOTS - 1)
+
+static u64 cap_hash(const char* name) {
+    u64 h = fnv1a_hash((const u8*)name, (u32)strlen(name));
+    return h ? h : 1;                            /* 0 marks empty slots */
+}
+
+/* Called after every registry change; node indices shift on removal. */
+static void rebuild_cap_index(SeaMesh* mesh) {
+    memset(mesh->cap_index, 0, sizeof(mesh->cap_index));
+    for (u32 i = 0; i < mesh->node_count; i++) {
+        const SeaMeshNode* n = &mesh->nodes[i];
+        for (u32 c = 0; c < n->capability_count; c++) {
+            const char* name = n->capabilities[c];
+            u64 h = cap_hash(name);
+            for (u32 at = (u32)h & CAP_MASK;; at = (at + 1) & CAP_MASK) {
+                SeaMeshCapSlot* slot = &mesh->cap_index[at];
+                if (slot->hash == 0) {
+                    slot->hash  = h;
+                    slot->nodes = 1ULL << i;
+                    slot->node  = (u8)i;
+                    slot->cap   = (u8)c;
+                    break;
+                }
+                if (slot->hash == h &&
+                    strcmp(mesh->nodes[slot->node].capabilities[slot->cap], name) == 0) {
+                    slot->nodes |= 1ULL << i;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static u64 cap_lookup(const SeaMesh* mesh, const char* tool_name) {
+    u64 h = cap_hash(tool_name);
+    for (u32 at = (u32)h & CAP_MASK;; at = (at + 1) & CAP_MASK) {
+        const SeaMeshCapSlot* slot = &mesh->cap_index[at];
+        if (slot->hash == 0) return 0;
+        if (slot->hash == h &&
+            strcmp(mesh->nodes[slot->node].capabilities[slot->cap], tool_name) == 0)
+            return slot->nodes;
+    }
+}
+
 /* ── Init / Destroy ──────────────────────────────────────── */
 
 SeaError sea_mesh_init(SeaMesh* mesh, SeaMeshConfig* config, SeaDb* db) {
@@ -54,6 +109,9 @@ SeaError sea_mesh_init(SeaMesh* mesh, SeaMeshConfig* config, SeaDb* db) {
     mesh->db = db;
     mesh->running = true;
     mesh->initialized = true;
+    mesh->rng = mono_us() ^ (u64)(uintptr_t)mesh;
+    if (!mesh->rng) mesh->rng = 0x9E3779B97F4A7C15ULL;
+    pthread_mutex_init(&mesh->lock, NULL);
 
     /* Defaults */
     if (mesh->config.port == 0) {
@@ -74,19 +132,19 @@ SeaError sea_mesh_init(SeaMesh* mesh, SeaMeshConfig* config, SeaDb* db) {
 }
 
 void sea_mesh_destroy(SeaMesh* mesh) {
-    if (!mesh) return;
+    if (!mesh || !mesh->initialized) return;
+    sea_mesh_tasks_shutdown(mesh);
     mesh->running = false;
     mesh->initialized = false;
+    pthread_mutex_destroy(&mesh->lock);
     SEA_LOG_INFO("MESH", "Mesh engine destroyed");
 }
 
 /* ── Node Registry (Captain) ─────────────────────────────── */
 
-SeaError sea_mesh_register_node(SeaMesh* mesh, const char* name,
-                                 const char* endpoint,
-                                 const char** capabilities, u32 cap_count) {
-    if (!mesh || !name || !endpoint) return SEA_ERR_CONFIG;
-
+static SeaError register_locked(SeaMesh* mesh, const char* name,
+                                const char* endpoint,
+                                const char** capabilities, u32 cap_count) {
     /* Check if node already exists — update it */
     SeaMeshNode* existing = find_node(mesh, name);
     if (existing) {
@@ -98,6 +156,7 @@ SeaError sea_mesh_register_node(SeaMesh* mesh, const char* name,
         }
         existing->healthy = true;
         existing->last_heartbeat = now_ms();
+        rebuild_cap_index(mesh);
         SEA_LOG_INFO("MESH", "Node '%s' re-registered (%u capabilities)", name, cap_count);
         return SEA_OK;
     }
@@ -118,10 +177,24 @@ SeaError sea_mesh_register_node(SeaMesh* mesh, const char* name,
     node->healthy = true;
     node->last_heartbeat = now_ms();
     node->registered_at = now_ms();
+    node->id = ++mesh->next_node_id;
     mesh->node_count++;
+    rebuild_cap_index(mesh);
 
     SEA_LOG_INFO("MESH", "Node '%s' registered at %s (%u capabilities)",
                  name, endpoint, cap_count);
+    return SEA_OK;
+}
+
+SeaError sea_mesh_register_node(SeaMesh* mesh, const char* name,
+                                 const char* endpoint,
+                                 const char** capabilities, u32 cap_count) {
+    if (!mesh || !name || !endpoint) return SEA_ERR_CONFIG;
+
+    pthread_mutex_lock(&mesh->lock);
+    SeaError err = register_locked(mesh, name, endpoint, capabilities, cap_count);
+    pthread_mutex_unlock(&mesh->lock);
+    if (err != SEA_OK) return err;
 
     /* Audit log */
     if (mesh->db) {
@@ -136,6 +209,7 @@ SeaError sea_mesh_register_node(SeaMesh* mesh, const char* name,
 SeaError sea_mesh_remove_node(SeaMesh* mesh, const char* name) {
     if (!mesh || !name) return SEA_ERR_CONFIG;
 
+    pthread_mutex_lock(&mesh->lock);
     for (u32 i = 0; i < mesh->node_count; i++) {
         if (strcmp(mesh->nodes[i].name, name) == 0) {
             /* Shift remaining nodes */
@@ -143,125 +217,131 @@ SeaError sea_mesh_remove_node(SeaMesh* mesh, const char* name) {
                 mesh->nodes[j] = mesh->nodes[j + 1];
             }
             mesh->node_count--;
+            rebuild_cap_index(mesh);
+            pthread_mutex_unlock(&mesh->lock);
             SEA_LOG_INFO("MESH", "Node '%s' removed", name);
             return SEA_OK;
         }
     }
+    pthread_mutex_unlock(&mesh->lock);
     return SEA_ERR_TOOL_NOT_FOUND;
 }
 
 /* ── Capability-Based Routing ────────────────────────────── */
 
-const SeaMeshNode* sea_mesh_route_tool(SeaMesh* mesh, const char* tool_name) {
-    if (!mesh || !tool_name) return NULL;
-
-    const SeaMeshNode* best = NULL;
-    u32 best_load = UINT32_MAX; /* Prefer least-loaded node */
-
-    for (u32 i = 0; i < mesh->node_count; i++) {
-        SeaMeshNode* node = &mesh->nodes[i];
-        if (!node->healthy) continue;
-
-        /* Check if node has this capability */
-        for (u32 c = 0; c < node->capability_count; c++) {
-            if (strcmp(node->capabilities[c], tool_name) == 0) {
-                u32 load = node->tasks_completed + node->tasks_failed;
-                if (!best || load < best_load) {
-                    best = node;
-                    best_load = load;
-                }
-                break;
-            }
-        }
-    }
-
-    return best;
+static u64 next_rand(SeaMesh* mesh) {
+    u64 x = mesh->rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    mesh->rng = x;
+    return x;
 }
 
-/* ── Task Dispatch (Captain → Crew) ──────────────────────── */
+/* Index of the n-th set bit. */
+static u32 nth_bit(u64 set, u32 n) {
+    while (n--) set &= set - 1;
+    return (u32)__builtin_ctzll(set);
+}
 
-SeaMeshResult sea_mesh_dispatch(SeaMesh* mesh, SeaMeshTask* task,
-                                 SeaArena* arena) {
-    SeaMeshResult result = { .task_id = task->task_id, .success = false,
-                              .output = NULL, .node_name = NULL,
-                              .latency_ms = 0, .error = NULL };
+static double route_cost(const SeaMeshNode* n, double latency_ms) {
+    return (double)(n->in_flight + 1) * latency_ms * (1.0 + 4.0 * n->ewma_error);
+}
 
-    /* Find the best node for this tool */
-    const SeaMeshNode* node = sea_mesh_route_tool(mesh, task->tool_name);
-    if (!node) {
-        result.error = "No node available for this tool";
-        SEA_LOG_WARN("MESH", "No node for tool '%s'", task->tool_name);
-        return result;
+static SeaMeshNode* pick_node(SeaMesh* mesh, const char* tool_name) {
+    u64 set = cap_lookup(mesh, tool_name);
+    for (u64 rest = set; rest; rest &= rest - 1) {
+        u32 i = (u32)__builtin_ctzll(rest);
+        if (!mesh->nodes[i].healthy) set &= ~(1ULL << i);
     }
 
-    result.node_name = node->name;
-
-    /* Build JSON-RPC request */
-    char url[512];
-    snprintf(url, sizeof(url), "%s/node/exec", node->endpoint);
-
-    char json[2048];
-    int jlen = snprintf(json, sizeof(json),
-        "{\"task_id\":\"%s\",\"tool\":\"%s\",\"args\":\"%s\"}",
-        task->task_id ? task->task_id : "0",
-        task->tool_name,
-        task->tool_args ? task->tool_args : "");
-
-    SeaSlice body = { .data = (const u8*)json, .len = (u32)jlen };
-    SeaHttpResponse resp;
-
-    u64 t0 = now_ms();
-    SeaError err = sea_http_post_json(url, body, arena, &resp);
-    u64 t1 = now_ms();
+    u32 count = (u32)__builtin_popcountll(set);
+    if (count == 0) return NULL;
+    if (count == 1) return &mesh->nodes[__builtin_ctzll(set)];
+
+    /* Two distinct candidates */
+    u64 r = next_rand(mesh);
+    u32 ia = (u32)(r % count);
+    u32 ib = (u32)((r >> 32) % (count - 1));
+    if (ib >= ia) ib++;
+    SeaMeshNode* a = &mesh->nodes[nth_bit(set, ia)];
+    SeaMeshNode* b = &mesh->nodes[nth_bit(set, ib)];
+
+    double la = a->ewma_latency_ms > 0 ? a->ewma_latency_ms : b->ewma_latency_ms;
+    double lb = b->ewma_latency_ms > 0 ? b->ewma_latency_ms : a->ewma_latency_ms;
+    if (la <= 0) la = lb = 1.0;                  /* Neither measured yet */
+    return route_cost(a, la) <= route_cost(b, lb) ? a : b;
+}
 
-    result.latency_ms = (u32)(t1 - t0);
+/* Handle for nodes[i]; caller holds the lock. */
+static void fill_route(SeaMesh* mesh, const SeaMeshNode* node, SeaMeshRoute* out) {
+    out->index = (u32)(node - mesh->nodes);
+    out->id = node->id;
+    memcpy(out->name, node->name, sizeof(out->name));
+    memcpy(out->endpoint, node->endpoint, sizeof(out->endpoint));
+}
 
-    if (err != SEA_OK || resp.status_code != 200) {
-        result.error = "HTTP request to node failed";
-        SEA_LOG_WARN("MESH", "Dispatch to '%s' failed (err=%d)", node->name, err);
-        return result;
-    }
+bool sea_mesh_route_tool(SeaMesh* mesh, const char* tool_name, SeaMeshRoute* out) {
+    if (!mesh || !tool_name || !out) return false;
+    pthread_mutex_lock(&mesh->lock);
+    const SeaMeshNode* node = pick_node(mesh, tool_name);
+    if (node) fill_route(mesh, node, out);
+    pthread_mutex_unlock(&mesh->lock);
+    return node != NULL;
+}
 
-    /* Parse response */
-    SeaJsonValue root;
-    if (sea_json_parse(resp.body, arena, &root) == SEA_OK) {
-        SeaSlice output_sl = sea_json_get_string(&root, "output");
-        if (output_sl.len > 0) {
-            char* out = (char*)sea_arena_alloc(arena, output_sl.len + 1, 1);
-            if (out) {
-                memcpy(out, output_sl.data, output_sl.len);
-                out[output_sl.len] = '\0';
-                result.output = out;
-                result.success = true;
-            }
-        }
+bool sea_mesh_route_acquire(SeaMesh* mesh, const char* tool_name, SeaMeshRoute* out) {
+    if (!mesh || !tool_name || !out) return false;
+    pthread_mutex_lock(&mesh->lock);
+    SeaMeshNode* node = pick_node(mesh, tool_name);
+    if (node) {
+        node->in_flight++;
+        fill_route(mesh, node, out);
     }
+    pthread_mutex_unlock(&mesh->lock);
+    return node != NULL;
+}
 
-    /* Shield-verify output */
-    if (result.output) {
-        SeaSlice out_slice = { .data = (const u8*)result.output,
-                               .len = (u32)strlen(result.output) };
-        if (sea_shield_detect_output_injection(out_slice)) {
-            SEA_LOG_WARN("MESH", "Shield REJECTED output from node '%s'", node->name);
-            result.output = "[Output rejected by Shield]";
-            result.success = false;
-        }
-    }
+/* The routed node, wherever removals have moved it; NULL once gone. */
+static SeaMeshNode* route_node(SeaMesh* mesh, const SeaMeshRoute* route) {
+    if (route->index < mesh->node_count && mesh->nodes[route->index].id == route->id)
+        return &mesh->nodes[route->index];
+    for (u32 i = 0; i < mesh->node_count; i++)
+        if (mesh->nodes[i].id == route->id) return &mesh->nodes[i];
+    return NULL;
+}
 
-    /* Audit */
-    if (mesh->db) {
-        char audit[512];
-        snprintf(audit, sizeof(audit), "tool=%s node=%s latency=%ums success=%s",
-                 task->tool_name, node->name, result.latency_ms,
-                 result.success ? "yes" : "no");
-        sea_db_log_event(mesh->db, "mesh_dispatch", task->tool_name, audit);
-    }
+void sea_mesh_route_release(SeaMesh* mesh, const SeaMeshRoute* route,
+                            bool success, double latency_ms) {
+    if (!mesh || !route || !route->id) return;
+    pthread_mutex_lock(&mesh->lock);
+    SeaMeshNode* node = route_node(mesh, route);
+    if (!node) { pthread_mutex_unlock(&mesh->lock); return; }
+    if (node->in_flight > 0) node->in_flight--;
+    if (latency_ms < 0) { pthread_mutex_unlock(&mesh->lock); return; }
+    if (success) node->tasks_completed++;
+    else node->tasks_failed++;
+
+    if (node->ewma_latency_ms <= 0) node->ewma_latency_ms = latency_ms;
+    else node->ewma_latency_ms += SEA_MESH_EWMA_LATENCY * (latency_ms - node->ewma_latency_ms);
+    node->ewma_error += SEA_MESH_EWMA_ERROR * ((success ? 0.0 : 1.0) - node->ewma_error);
+    pthread_mutex_unlock(&mesh->lock);
+}
 
-    SEA_LOG_INFO("MESH", "Dispatched '%s' to '%s' (%ums, %s)",
-                 task->tool_name, node->name, result.latency_ms,
-                 result.success ? "ok" : "fail");
+/* POST with the X-Mesh-Token header when a shared secret is set. */
+static SeaError mesh_post(SeaMesh* mesh, const char* url, SeaSlice body,
+                          SeaArena* arena, SeaHttpResponse* resp) {
+    if (!mesh->config.shared_secret[0])
+        return sea_http_post_json(url, body, arena, resp);
+    const char* token = sea_mesh_generate_token(mesh, arena);
+    if (!token) return SEA_ERR_OOM;
+    char header[128];
+    snprintf(header, sizeof(header), "X-Mesh-Token: %s", token);
+    return sea_http_post_json_auth(url, body, header, arena, resp);
+}
 
-    return result;
+static SeaSlice cstr_slice(const char* s) {
+    return (SeaSlice){ .data = (const u8*)s, .len = (u32)strlen(s) };
 }
 
 /* ── Crew Registration ───────────────────────────────────── */
@@ -296,7 +376,7 @@ SeaError sea_mesh_crew_register(SeaMesh* mesh, SeaArena* arena) {
 
     SeaSlice body = { .data = (const u8*)json, .len = (u32)pos };
     SeaHttpResponse resp;
-    SeaError err = sea_http_post_json(url, body, arena, &resp);
+    SeaError err = mesh_post(mesh, url, body, arena, &resp);
 
     if (err == SEA_OK && resp.status_code == 200) {
         SEA_LOG_INFO("MESH", "Registered with Captain at %s", mesh->config.captain_url);
@@ -322,34 +402,40 @@ SeaError sea_mesh_crew_heartbeat(SeaMesh* mesh, SeaArena* arena) {
 
     SeaSlice body = { .data = (const u8*)json, .len = (u32)jlen };
     SeaHttpResponse resp;
-    SeaError err = sea_http_post_json(url, body, arena, &resp);
+    SeaError err = mesh_post(mesh, url, body, arena, &resp);
 
     return (err == SEA_OK && resp.status_code == 200) ? SEA_OK : SEA_ERR_IO;
 }
 
 SeaError sea_mesh_process_heartbeat(SeaMesh* mesh, const char* node_name) {
+    if (!mesh || !node_name) return SEA_ERR_CONFIG;
+    pthread_mutex_lock(&mesh->lock);
     SeaMeshNode* node = find_node(mesh, node_name);
-    if (!node) return SEA_ERR_TOOL_NOT_FOUND;
-    node->healthy = true;
-    node->last_heartbeat = now_ms();
-    return SEA_OK;
+    if (node) {
+        node->healthy = true;
+        node->last_heartbeat = now_ms();
+    }
+    pthread_mutex_unlock(&mesh->lock);
+    return node ? SEA_OK : SEA_ERR_TOOL_NOT_FOUND;
 }
 
 /* ── Status ──────────────────────────────────────────────── */
 
-u32 sea_mesh_healthy_nodes(SeaMesh* mesh, const SeaMeshNode** out, u32 max) {
+u32 sea_mesh_healthy_nodes(SeaMesh* mesh, SeaMeshRoute* out, u32 max) {
     u32 count = 0;
     u64 stale_threshold = now_ms() - (mesh->config.heartbeat_interval_ms * 3);
 
+    pthread_mutex_lock(&mesh->lock);
     for (u32 i = 0; i < mesh->node_count && count < max; i++) {
         /* Mark stale nodes as unhealthy */
         if (mesh->nodes[i].last_heartbeat < stale_threshold) {
             mesh->nodes[i].healthy = false;
         }
         if (mesh->nodes[i].healthy) {
-            out[count++] = &mesh->nodes[i];
+            fill_route(mesh, &mesh->nodes[i], &out[count++]);
         }
     }
+    pthread_mutex_unlock(&mesh->lock);
     return count;
 }
 
@@ -371,14 +457,17 @@ const char* sea_mesh_status(SeaMesh* mesh, SeaArena* arena) {
         mesh->config.shared_secret[0] ? "configured" : "none");
 
     if (mesh->config.role == SEA_MESH_CAPTAIN) {
-        for (u32 i = 0; i < mesh->node_count; i++) {
+        for (u32 i = 0; i < mesh->node_count && pos < (int)sizeof(buf) - 256; i++) {
             SeaMeshNode* n = &mesh->nodes[i];
             pos += snprintf(buf + pos, sizeof(buf) - (size_t)pos,
-                "  %s %s (%s) — %u caps, %u tasks, %s\n",
+                "  %s %s (%s) — %u caps, %u tasks, %u in flight, %.1fms, %.0f%% err, %s\n",
                 n->healthy ? "●" : "○",
                 n->name, n->endpoint,
                 n->capability_count,
                 n->tasks_completed,
+                n->in_flight,
+                n->ewma_latency_ms,
+                n->ewma_error * 100.0,
                 n->healthy ? "healthy" : "stale");
         }
     } else {
@@ -397,7 +486,7 @@ const char* sea_mesh_status(SeaMesh* mesh, SeaArena* arena) {
 
 bool sea_mesh_validate_token(SeaMesh* mesh, const char* token) {
     if (!mesh || !token) return false;
-    if (!mesh->config.shared_secret[0]) return true; /* No secret = open */
+    if (!mesh->config.shared_secret[0]) return false; /* No secret, no entry */
 
     /* Token format: "timestamp:hash" */
     const char* colon = strchr(token, ':');
@@ -436,26 +525,116 @@ const char* sea_mesh_generate_token(SeaMesh* mesh, SeaArena* arena) {
     return out;
 }
 
-SeaError sea_mesh_broadcast(SeaMesh* mesh, const char* message, SeaArena* arena) {
-    if (!mesh || !message) return SEA_ERR_CONFIG;
+/* ── Fan-out ─────────────────────────────────────────────── */
+
+typedef struct {
+    char name[SEA_MESH_NODE_NAME_MAX];
+    char url[300];
+} FanoutTarget;
+
+/* Snapshot the endpoints under the lock, then run every request
+ * concurrently without it. Returns the number of requests made. */
+static u32 fanout(SeaMesh* mesh, const char* path, bool healthy_only, SeaSlice body,
+                  SeaArena* arena, FanoutTarget** targets_out, SeaHttpRequest** reqs_out) {
+    FanoutTarget* targets = (FanoutTarget*)sea_arena_alloc(
+        arena, sizeof(FanoutTarget) * SEA_MESH_MAX_NODES, 8);
+    SeaHttpRequest* reqs = (SeaHttpRequest*)sea_arena_alloc(
+        arena, sizeof(SeaHttpRequest) * SEA_MESH_MAX_NODES, 8);
+    if (!targets || !reqs) return 0;
+
+    u32 n = 0;
+    pthread_mutex_lock(&mesh->lock);
+    for (u32 i = 0; i < mesh->node_count; i++) {
+        const SeaMeshNode* node = &mesh->nodes[i];
+        if (healthy_only && !node->healthy) continue;
+        memcpy(targets[n].name, node->name, SEA_MESH_NODE_NAME_MAX);
+        snprintf(targets[n].url, sizeof(targets[n].url), "%s%s", node->endpoint, path);
+        n++;
+    }
+    pthread_mutex_unlock(&mesh->lock);
+
+    char* header = NULL;
+    if (mesh->config.shared_secret[0]) {
+        const char* token = sea_mesh_generate_token(mesh, arena);
+        header = token ? (char*)sea_arena_alloc(arena, 128, 1) : NULL;
+        if (header) snprintf(header, 128, "X-Mesh-Token: %s", token);
+    }
+    for (u32 i = 0; i < n; i++) {
+        reqs[i] = (SeaHttpRequest){ .url = targets[i].url, .body = body, .header = header,
+                                    .timeout_ms = SEA_MESH_FANOUT_TIMEOUT_MS };
+    }
+    if (n > 0 && sea_http_multi(reqs, n, arena) != SEA_OK) return 0;
+
+    *targets_out = targets;
+    *reqs_out = reqs;
+    return n;
+}
+
+static void fanout_report(const FanoutTarget* t, const SeaHttpRequest* r,
+                          SeaMeshFanoutResult* out, u32 i, u32 max) {
+    if (!out || i >= max) return;
+    memcpy(out[i].name, t->name, SEA_MESH_NODE_NAME_MAX);
+    out[i].err        = r->err;
+    out[i].status     = r->err == SEA_OK ? r->resp.status_code : 0;
+    out[i].latency_ms = r->elapsed_ms;
+}
+
+u32 sea_mesh_broadcast_status(SeaMesh* mesh, const char* message, SeaArena* arena,
+                              SeaMeshFanoutResult* out, u32 max) {
+    if (!mesh || !message || !arena) return 0;
+
+    SeaSlice msg = sea_json_escape(cstr_slice(message), arena);
+    char* json = msg.data ? (char*)sea_arena_alloc(arena, (u64)msg.len + 16, 1) : NULL;
+    if (!json) return 0;
+    int jlen = snprintf(json, (size_t)msg.len + 16, "{\"message\":\"%.*s\"}",
+                        (int)msg.len, (const char*)msg.data);
+    SeaSlice body = { .data = (const u8*)json, .len = (u32)jlen };
+
+    FanoutTarget* targets = NULL;
+    SeaHttpRequest* reqs = NULL;
+    u32 n = fanout(mesh, "/mesh/broadcast", true, body, arena, &targets, &reqs);
 
     u32 sent = 0;
-    for (u32 i = 0; i < mesh->node_count; i++) {
-        if (!mesh->nodes[i].healthy) continue;
+    for (u32 i = 0; i < n; i++) {
+        if (reqs[i].err == SEA_OK && reqs[i].resp.status_code == 200) sent++;
+        else SEA_LOG_WARN("MESH", "Broadcast to %s failed (%s, HTTP %d)", targets[i].name,
+                          sea_error_str(reqs[i].err), reqs[i].resp.status_code);
+        fanout_report(&targets[i], &reqs[i], out, i, max);
+    }
 
-        char url[512];
-        snprintf(url, sizeof(url), "%s/mesh/broadcast", mesh->nodes[i].endpoint);
+    SEA_LOG_INFO("MESH", "Broadcast sent to %u/%u nodes", sent, n);
+    return sent;
+}
 
-        char json[1024];
-        int jlen = snprintf(json, sizeof(json), "{\"message\":\"%s\"}", message);
-        SeaSlice body = { .data = (const u8*)json, .len = (u32)jlen };
-        SeaHttpResponse resp;
+SeaError sea_mesh_broadcast(SeaMesh* mesh, const char* message, SeaArena* arena) {
+    if (!mesh || !message) return SEA_ERR_CONFIG;
+    sea_mesh_broadcast_status(mesh, message, arena, NULL, 0);
+    return SEA_OK;
+}
 
-        if (sea_http_post_json(url, body, arena, &resp) == SEA_OK) {
-            sent++;
+u32 sea_mesh_probe_health(SeaMesh* mesh, SeaArena* arena,
+                          SeaMeshFanoutResult* out, u32 max) {
+    if (!mesh || !arena) return 0;
+
+    FanoutTarget* targets = NULL;
+    SeaHttpRequest* reqs = NULL;
+    u32 n = fanout(mesh, "/mesh/health", false, SEA_SLICE_EMPTY, arena, &targets, &reqs);
+
+    u32 healthy = 0;
+    u64 now = now_ms();
+    pthread_mutex_lock(&mesh->lock);
+    for (u32 i = 0; i < n; i++) {
+        bool ok = reqs[i].err == SEA_OK && reqs[i].resp.status_code == 200;
+        SeaMeshNode* node = find_node(mesh, targets[i].name);
+        if (node) {                       /* May have been removed meanwhile */
+            if (ok) node->last_heartbeat = now;
+            node->healthy = ok;
         }
+        if (ok) healthy++;
+        fanout_report(&targets[i], &reqs[i], out, i, max);
     }
+    pthread_mutex_unlock(&mesh->lock);
 
-    SEA_LOG_INFO("MESH", "Broadcast sent to %u/%u nodes", sent, mesh->node_count);
-    return SEA_OK;
+    SEA_LOG_DEBUG("MESH", "Health probe: %u/%u nodes healthy", healthy, n);
+    return healthy;
 }
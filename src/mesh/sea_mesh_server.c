@@ -0,0 +1,974 @@
+/*
+ * sea_mesh_server.c — Mesh HTTP/1.1 endpoint
+ *
+ * One epoll thread accepts, reads, parses and writes; sockets are
+ * non-blocking and connections stay open between requests. Control
+ * routes (register, heartbeat, broadcast, health) are answered
+ * inline. Tool calls are queued to worker threads, and the connection
+ * stops reading until its answer is back, so pipelined requests are
+ * answered in order. Workers return results through an eventfd.
+ *
+ * A streaming call ("stream":true) is answered with a chunked body of
+ * NDJSON records: {"chunk"} for each piece of progress the tool
+ * reports, then one {"done","success","output"}. If the caller hangs
+ * up mid-stream the task is abandoned: a queued tool never runs and a
+ * running one has its result dropped.
+ */
+
+#include "seaclaw/sea_mesh.h"
+#include "seaclaw/sea_json.h"
+#include "seaclaw/sea_tools.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#define MAX_HEADER   8192
+#define READ_CHUNK   16384
+#define FRAME_PIECE  16384            /* Raw progress bytes per frame   */
+#define MAX_PENDING  (4 * 1024 * 1024)  /* Unsent stream bytes per conn */
+#define EV_LISTEN    0
+#define EV_WAKE      1
+#define EV_CONN(i)   ((i) + 2)
+
+typedef struct {
+    int   fd;                 /* -1 = free slot                         */
+    u32   gen;                /* Bumped on close; stale results dropped */
+    char* in;
+    u32   in_len;
+    u32   in_cap;
+    char* out;
+    u32   out_len;
+    u32   out_sent;
+    bool  busy;               /* A worker owns the current request      */
+    bool  close_after;        /* Close once out is flushed              */
+    bool  want_write;         /* EPOLLOUT registered                    */
+    u64   last_active;
+    struct Job* job;          /* Tool call in flight, while busy        */
+} Conn;
+
+typedef struct Job {
+    struct Job* next;
+    u32   conn;
+    u32   gen;
+    bool  keep_alive;
+    bool  stream;             /* Chunked NDJSON answer                  */
+    _Atomic bool abandoned;   /* Caller hung up                         */
+    char* task_id;            /* Decoded, NUL-terminated                */
+    char* tool;
+    char* args;
+    u32   args_len;
+    char* response;           /* Full HTTP response (or final chunk)    */
+    u32   response_len;
+} Job;
+
+/* A chunk of streamed progress on its way to a connection. */
+typedef struct Frame {
+    struct Frame* next;
+    u32   conn;
+    u32   gen;
+    char* data;               /* Chunk-encoded NDJSON record            */
+    u32   len;
+} Frame;
+
+struct SeaMeshServer {
+    SeaMesh*        mesh;
+    int             listen_fd;
+    int             epoll_fd;
+    int             wake_fd;
+    u32             subnet;           /* Host order; mask 0 = any */
+    u32             subnet_mask;
+    Conn            conns[SEA_MESH_SERVER_CONNS];
+    SeaArena        arena;            /* Loop thread, reset per request */
+
+    pthread_t       loop;
+    pthread_t*      workers;
+    u32             worker_count;
+    pthread_mutex_t lock;             /* Job queues */
+    pthread_cond_t  job_cond;
+    Job*            todo_head;
+    Job*            todo_tail;
+    Job*            done;
+    Frame*          frame_head;       /* FIFO, drained before done */
+    Frame*          frame_tail;
+    _Atomic bool    stop;
+
+    _Atomic u64     connections;
+    _Atomic u64     requests;
+    _Atomic u64     tasks;
+    _Atomic u64     rejected;
+    _Atomic u64     broadcasts;
+    _Atomic u64     abandoned;
+};
+
+static u64 mono_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000 + (u64)ts.tv_nsec / 1000000;
+}
+
+static void wake(SeaMeshServer* srv) {
+    u64 one = 1;
+    ssize_t n = write(srv->wake_fd, &one, sizeof(one));
+    (void)n;
+}
+
+static const char* status_text(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default:  return "Error";
+    }
+}
+
+/* Build a complete response into a malloc'd buffer. */
+static char* build_response(int status, const char* body, u32 body_len,
+                            bool keep_alive, u32* out_len) {
+    char head[192];
+    int hlen = snprintf(head, sizeof(head),
+        "HTTP/1.1 %d %s\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: %s\r\n\r\n",
+        status, status_text(status), body_len, keep_alive ? "keep-alive" : "close");
+    char* buf = malloc((size_t)hlen + body_len);
+    if (!buf) return NULL;
+    memcpy(buf, head, (size_t)hlen);
+    memcpy(buf + hlen, body, body_len);
+    *out_len = (u32)hlen + body_len;
+    return buf;
+}
+
+/* ── Connections ──────────────────────────────────────────── */
+
+static void conn_close(SeaMeshServer* srv, u32 idx) {
+    Conn* c = &srv->conns[idx];
+    if (c->fd < 0) return;
+    if (c->busy && c->job) atomic_store(&c->job->abandoned, true);
+    epoll_ctl(srv->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    free(c->in);
+    free(c->out);
+    u32 gen = c->gen + 1;
+    memset(c, 0, sizeof(*c));
+    c->fd  = -1;
+    c->gen = gen;
+}
+
+static void conn_watch(SeaMeshServer* srv, u32 idx, bool want_write) {
+    Conn* c = &srv->conns[idx];
+    if (c->want_write == want_write) return;
+    struct epoll_event ev = {
+        .events = (want_write ? EPOLLOUT : EPOLLIN) | EPOLLRDHUP,
+        .data.u32 = EV_CONN(idx),
+    };
+    epoll_ctl(srv->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+    c->want_write = want_write;
+}
+
+/* Flush pending output; once drained go back to reading. The caller
+ * resumes parsing buffered requests (conn_process). */
+static void conn_write(SeaMeshServer* srv, u32 idx) {
+    Conn* c = &srv->conns[idx];
+    while (c->out_sent < c->out_len) {
+        ssize_t n = send(c->fd, c->out + c->out_sent, c->out_len - c->out_sent, MSG_NOSIGNAL);
+        if (n > 0) { c->out_sent += (u32)n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            conn_watch(srv, idx, true);
+            return;
+        }
+        conn_close(srv, idx);
+        return;
+    }
+    free(c->out);
+    c->out = NULL;
+    c->out_len = c->out_sent = 0;
+    if (c->close_after) { conn_close(srv, idx); return; }
+    conn_watch(srv, idx, false);
+}
+
+static void conn_send(SeaMeshServer* srv, u32 idx, char* response, u32 len, bool keep_alive) {
+    Conn* c = &srv->conns[idx];
+    if (!response) { conn_close(srv, idx); return; }
+    c->out = response;
+    c->out_len = len;
+    c->out_sent = 0;
+    if (!keep_alive) c->close_after = true;
+    conn_write(srv, idx);
+}
+
+/* Queue bytes behind any unsent output (streamed responses). A caller
+ * that stops reading is dropped rather than buffered without bound. */
+static void conn_append(SeaMeshServer* srv, u32 idx, const char* data, u32 len) {
+    Conn* c = &srv->conns[idx];
+    u32 pending = c->out_len - c->out_sent;
+    if (pending + len > MAX_PENDING) {
+        SEA_LOG_WARN("MESH", "Dropping stream: caller is not reading");
+        conn_close(srv, idx);
+        return;
+    }
+    char* out = malloc((size_t)pending + len);
+    if (!out) { conn_close(srv, idx); return; }
+    if (pending) memcpy(out, c->out + c->out_sent, pending);
+    memcpy(out + pending, data, len);
+    free(c->out);
+    c->out = out;
+    c->out_len = pending + len;
+    c->out_sent = 0;
+    conn_write(srv, idx);
+}
+
+static void reply(SeaMeshServer* srv, u32 idx, int status, const char* body, bool keep_alive) {
+    if (status >= 400) atomic_fetch_add(&srv->rejected, 1);
+    u32 len;
+    char* resp = build_response(status, body, (u32)strlen(body), keep_alive, &len);
+    conn_send(srv, idx, resp, len, keep_alive);
+}
+
+/* ── Request Parsing ──────────────────────────────────────── */
+
+typedef struct {
+    const char* method;   u32 method_len;
+    const char* path;     u32 path_len;
+    const char* token;    u32 token_len;
+    const char* body;
+    u32         body_len;
+    u32         total;    /* Bytes consumed from the buffer */
+    bool        keep_alive;
+    int         error;    /* HTTP status for a malformed request */
+} Request;
+
+static bool span_eq(const char* p, u32 len, const char* lit) {
+    return strlen(lit) == len && memcmp(p, lit, len) == 0;
+}
+
+/* Returns false while the request is incomplete. */
+static bool parse_request(const char* buf, u32 len, Request* r) {
+    memset(r, 0, sizeof(*r));
+    const char* end = NULL;
+    for (u32 i = 0; i + 3 < len; i++) {
+        if (buf[i] == '\r' && buf[i + 1] == '\n' && buf[i + 2] == '\r' && buf[i + 3] == '\n') {
+            end = buf + i;
+            break;
+        }
+    }
+    if (!end) {
+        if (len > MAX_HEADER) { r->error = 431; return true; }
+        return false;
+    }
+
+    /* Request line */
+    const char* p = buf;
+    const char* eol = memchr(p, '\r', (size_t)(end - p) + 1);
+    const char* sp1 = memchr(p, ' ', (size_t)(eol - p));
+    const char* sp2 = sp1 ? memchr(sp1 + 1, ' ', (size_t)(eol - sp1 - 1)) : NULL;
+    if (!sp1 || !sp2) { r->error = 400; return true; }
+    r->method = p;       r->method_len = (u32)(sp1 - p);
+    r->path   = sp1 + 1; r->path_len   = (u32)(sp2 - sp1 - 1);
+    r->keep_alive = span_eq(sp2 + 1, (u32)(eol - sp2 - 1), "HTTP/1.1");
+
+    u64 content_length = 0;
+    for (p = eol + 2; p < end; ) {
+        const char* le = memchr(p, '\r', (size_t)(end - p) + 1);
+        const char* colon = memchr(p, ':', (size_t)(le - p));
+        if (colon) {
+            u32 nlen = (u32)(colon - p);
+            const char* v = colon + 1;
+            while (v < le && (*v == ' ' || *v == '\t')) v++;
+            u32 vlen = (u32)(le - v);
+            if (nlen == 14 && strncasecmp(p, "Content-Length", 14) == 0) {
+                content_length = strtoull(v, NULL, 10);
+            } else if (nlen == 10 && strncasecmp(p, "Connection", 10) == 0) {
+                if (vlen >= 5 && strncasecmp(v, "close", 5) == 0) r->keep_alive = false;
+                else if (vlen >= 10 && strncasecmp(v, "keep-alive", 10) == 0) r->keep_alive = true;
+            } else if (nlen == 12 && strncasecmp(p, "X-Mesh-Token", 12) == 0) {
+                r->token = v;
+                r->token_len = vlen;
+            } else if (nlen == 17 && strncasecmp(p, "Transfer-Encoding", 17) == 0) {
+                r->error = 501;                     /* No chunked bodies */
+                return true;
+            }
+        }
+        p = le + 2;
+    }
+
+    u32 head = (u32)(end - buf) + 4;
+    if (content_length > SEA_MESH_MAX_REQUEST - head) { r->error = 413; return true; }
+    if (len < head + content_length) return false;
+    r->body = buf + head;
+    r->body_len = (u32)content_length;
+    r->total = head + (u32)content_length;
+    return true;
+}
+
+/* NUL-terminated, unescaped copy of a JSON string field. */
+static char* json_field(const SeaJsonValue* root, const char* key, SeaArena* arena) {
+    SeaSlice raw = sea_json_get_string(root, key);
+    SeaSlice s = sea_json_unescape(raw, arena);
+    return s.data ? (char*)s.data : NULL;
+}
+
+static char* heap_dup(const char* s, u32 len) {
+    char* d = malloc((size_t)len + 1);
+    if (d) { memcpy(d, s, len); d[len] = '\0'; }
+    return d;
+}
+
+/* ── Routes ───────────────────────────────────────────────── */
+
+static void route_exec(SeaMeshServer* srv, u32 idx, const SeaJsonValue* root, bool keep_alive) {
+    char* tool = json_field(root, "tool", &srv->arena);
+    if (!tool || !tool[0]) { reply(srv, idx, 400, "{\"error\":\"missing tool\"}", keep_alive); return; }
+    char* task_id = json_field(root, "task_id", &srv->arena);
+    SeaSlice args = sea_json_unescape(sea_json_get_string(root, "args"), &srv->arena);
+
+    Job* job = calloc(1, sizeof(Job));
+    if (job) {
+        job->task_id  = heap_dup(task_id ? task_id : "", task_id ? (u32)strlen(task_id) : 0);
+        job->tool     = heap_dup(tool, (u32)strlen(tool));
+        job->args     = heap_dup(args.data ? (const char*)args.data : "", args.len);
+        job->args_len = args.len;
+    }
+    if (!job || !job->task_id || !job->tool || !job->args) {
+        if (job) { free(job->task_id); free(job->tool); free(job->args); free(job); }
+        reply(srv, idx, 503, "{\"error\":\"out of memory\"}", false);
+        return;
+    }
+    job->conn = idx;
+    job->gen = srv->conns[idx].gen;
+    job->keep_alive = keep_alive;
+    job->stream = sea_json_get_bool(root, "stream", false);
+    srv->conns[idx].busy = true;
+    srv->conns[idx].job = job;
+
+    if (job->stream) {
+        char head[160];
+        int hlen = snprintf(head, sizeof(head),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/x-ndjson\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Connection: %s\r\n\r\n", keep_alive ? "keep-alive" : "close");
+        conn_append(srv, idx, head, (u32)hlen);
+    }
+
+    pthread_mutex_lock(&srv->lock);
+    if (srv->todo_tail) srv->todo_tail->next = job;
+    else srv->todo_head = job;
+    srv->todo_tail = job;
+    pthread_cond_signal(&srv->job_cond);
+    pthread_mutex_unlock(&srv->lock);
+}
+
+static void route_register(SeaMeshServer* srv, u32 idx, const SeaJsonValue* root, bool keep_alive) {
+    char* name = json_field(root, "name", &srv->arena);
+    char* endpoint = json_field(root, "endpoint", &srv->arena);
+    if (!name || !name[0] || !endpoint || !endpoint[0]) {
+        reply(srv, idx, 400, "{\"error\":\"name and endpoint required\"}", keep_alive);
+        return;
+    }
+    const char* caps[SEA_MESH_MAX_CAPABILITIES];
+    u32 cap_count = 0;
+    const SeaJsonValue* arr = sea_json_get(root, "capabilities");
+    if (arr && arr->type == SEA_JSON_ARRAY) {
+        for (u32 i = 0; i < arr->array.count && cap_count < SEA_MESH_MAX_CAPABILITIES; i++) {
+            const SeaJsonValue* v = &arr->array.items[i];
+            if (v->type != SEA_JSON_STRING) continue;
+            SeaSlice s = sea_json_unescape(v->string, &srv->arena);
+            if (s.data && s.len > 0 && s.len < 64) caps[cap_count++] = (const char*)s.data;
+        }
+    }
+    SeaError err = sea_mesh_register_node(srv->mesh, name, endpoint, caps, cap_count);
+    if (err != SEA_OK) reply(srv, idx, 503, "{\"error\":\"registry full\"}", keep_alive);
+    else reply(srv, idx, 200, "{\"ok\":true}", keep_alive);
+}
+
+static void route_heartbeat(SeaMeshServer* srv, u32 idx, const SeaJsonValue* root, bool keep_alive) {
+    char* name = json_field(root, "name", &srv->arena);
+    if (!name || sea_mesh_process_heartbeat(srv->mesh, name) != SEA_OK) {
+        reply(srv, idx, 404, "{\"error\":\"unknown node\"}", keep_alive);
+        return;
+    }
+    reply(srv, idx, 200, "{\"ok\":true}", keep_alive);
+}
+
+static void route_broadcast(SeaMeshServer* srv, u32 idx, const SeaJsonValue* root, bool keep_alive) {
+    char* message = json_field(root, "message", &srv->arena);
+    if (!message) { reply(srv, idx, 400, "{\"error\":\"missing message\"}", keep_alive); return; }
+    atomic_fetch_add(&srv->broadcasts, 1);
+    SEA_LOG_INFO("MESH", "Broadcast received: %.200s", message);
+    if (srv->mesh->db) sea_db_log_event(srv->mesh->db, "mesh_broadcast", "broadcast", message);
+    reply(srv, idx, 200, "{\"ok\":true}", keep_alive);
+}
+
+static void route_health(SeaMeshServer* srv, u32 idx, bool keep_alive) {
+    SeaSlice name = sea_json_escape((SeaSlice){ .data = (const u8*)srv->mesh->config.node_name,
+                                                .len = (u32)strlen(srv->mesh->config.node_name) },
+                                    &srv->arena);
+    char body[256];
+    snprintf(body, sizeof(body), "{\"ok\":true,\"node\":\"%.*s\"}",
+             (int)name.len, name.data ? (const char*)name.data : "");
+    reply(srv, idx, 200, body, keep_alive);
+}
+
+static void handle_request(SeaMeshServer* srv, u32 idx, const Request* r) {
+    atomic_fetch_add(&srv->requests, 1);
+    sea_arena_reset(&srv->arena);
+    bool ka = r->keep_alive;
+
+    bool exec      = span_eq(r->path, r->path_len, "/node/exec");
+    bool reg       = span_eq(r->path, r->path_len, "/mesh/register");
+    bool heartbeat = span_eq(r->path, r->path_len, "/mesh/heartbeat");
+    bool broadcast = span_eq(r->path, r->path_len, "/mesh/broadcast");
+    bool health    = span_eq(r->path, r->path_len, "/mesh/health");
+    if (!exec && !reg && !heartbeat && !broadcast && !health) {
+        reply(srv, idx, 404, "{\"error\":\"not found\"}", ka);
+        return;
+    }
+    if (health && !span_eq(r->method, r->method_len, "GET")) {
+        reply(srv, idx, 405, "{\"error\":\"GET only\"}", ka);
+        return;
+    }
+    if (!health && !span_eq(r->method, r->method_len, "POST")) {
+        reply(srv, idx, 405, "{\"error\":\"POST only\"}", ka);
+        return;
+    }
+
+    char* token = (char*)sea_arena_alloc(&srv->arena, (u64)r->token_len + 1, 1);
+    if (!token) { reply(srv, idx, 503, "{\"error\":\"out of memory\"}", false); return; }
+    memcpy(token, r->token ? r->token : "", r->token_len);
+    token[r->token_len] = '\0';
+    if (!sea_mesh_validate_token(srv->mesh, token)) {
+        reply(srv, idx, 401, "{\"error\":\"invalid token\"}", ka);
+        return;
+    }
+
+    if (health) { route_health(srv, idx, ka); return; }
+
+    if ((reg || heartbeat) && srv->mesh->config.role != SEA_MESH_CAPTAIN) {
+        reply(srv, idx, 403, "{\"error\":\"not a captain\"}", ka);
+        return;
+    }
+
+    SeaJsonValue root;
+    SeaSlice body = { .data = (const u8*)r->body, .len = r->body_len };
+    if (sea_json_parse(body, &srv->arena, &root) != SEA_OK || root.type != SEA_JSON_OBJECT) {
+        reply(srv, idx, 400, "{\"error\":\"invalid JSON\"}", ka);
+        return;
+    }
+
+    if (exec)           route_exec(srv, idx, &root, ka);
+    else if (reg)       route_register(srv, idx, &root, ka);
+    else if (heartbeat) route_heartbeat(srv, idx, &root, ka);
+    else                route_broadcast(srv, idx, &root, ka);
+}
+
+/* Parse and answer buffered requests, one at a time. */
+static void conn_process(SeaMeshServer* srv, u32 idx) {
+    Conn* c = &srv->conns[idx];
+    while (c->fd >= 0 && !c->busy && c->out_len == 0 && c->in_len > 0) {
+        Request r;
+        if (!parse_request(c->in, c->in_len, &r)) return;
+        if (r.error) {
+            reply(srv, idx, r.error, "{\"error\":\"bad request\"}", false);
+            return;
+        }
+        handle_request(srv, idx, &r);
+        if (c->fd < 0) return;
+        memmove(c->in, c->in + r.total, c->in_len - r.total);
+        c->in_len -= r.total;
+    }
+}
+
+static void conn_read(SeaMeshServer* srv, u32 idx) {
+    Conn* c = &srv->conns[idx];
+    for (;;) {
+        if (c->in_cap - c->in_len < READ_CHUNK) {
+            u32 cap = c->in_cap ? c->in_cap * 2 : READ_CHUNK * 2;
+            if (cap > SEA_MESH_MAX_REQUEST + READ_CHUNK) {
+                /* A full buffer behind a running tool is a client that
+                 * will not wait; otherwise the parser rejects it */
+                if (c->busy) { conn_close(srv, idx); return; }
+                break;
+            }
+            char* in = realloc(c->in, cap);
+            if (!in) { conn_close(srv, idx); return; }
+            c->in = in;
+            c->in_cap = cap;
+        }
+        ssize_t n = recv(c->fd, c->in + c->in_len, c->in_cap - c->in_len, 0);
+        if (n > 0) { c->in_len += (u32)n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n < 0) { conn_close(srv, idx); return; }
+
+        /* A streaming caller hanging up is a cancel */
+        if (c->busy && c->job && c->job->stream) { conn_close(srv, idx); return; }
+
+        /* Peer finished sending: answer what it sent, then close */
+        c->close_after = true;
+        conn_process(srv, idx);
+        if (c->fd < 0) return;
+        if (!c->busy && c->out_len == 0) { conn_close(srv, idx); return; }
+        struct epoll_event ev = { .events = 0, .data.u32 = EV_CONN(idx) };
+        epoll_ctl(srv->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+        c->want_write = false;
+        return;
+    }
+    c->last_active = mono_ms();
+    conn_process(srv, idx);
+}
+
+/* ── Accept ───────────────────────────────────────────────── */
+
+static void accept_all(SeaMeshServer* srv) {
+    for (;;) {
+        struct sockaddr_in peer;
+        socklen_t plen = sizeof(peer);
+        int fd = accept4(srv->listen_fd, (struct sockaddr*)&peer, &plen,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;                              /* EAGAIN or transient */
+        }
+
+        u32 addr = ntohl(peer.sin_addr.s_addr);
+        bool loopback = (addr >> 24) == 127;
+        if (srv->subnet_mask && !loopback && (addr & srv->subnet_mask) != srv->subnet) {
+            SEA_LOG_WARN("MESH", "Refused connection from %s (outside allowed subnet)",
+                         inet_ntoa(peer.sin_addr));
+            close(fd);
+            continue;
+        }
+
+        u32 idx = 0;
+        while (idx < SEA_MESH_SERVER_CONNS && srv->conns[idx].fd >= 0) idx++;
+        if (idx == SEA_MESH_SERVER_CONNS) {
+            SEA_LOG_WARN("MESH", "Connection table full; dropping client");
+            close(fd);
+            continue;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        Conn* c = &srv->conns[idx];
+        c->fd = fd;
+        c->last_active = mono_ms();
+        struct epoll_event ev = { .events = EPOLLIN | EPOLLRDHUP, .data.u32 = EV_CONN(idx) };
+        if (epoll_ctl(srv->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            conn_close(srv, idx);
+            continue;
+        }
+        atomic_fetch_add(&srv->connections, 1);
+    }
+}
+
+/* ── Workers ──────────────────────────────────────────────── */
+
+/* Wrap one NDJSON record in HTTP chunk framing, malloc'd. */
+static char* chunk_frame(const char* record, u32 record_len, bool last, u32* out_len) {
+    char head[16];
+    int hlen = snprintf(head, sizeof(head), "%x\r\n", record_len);
+    const char* tail = last ? "\r\n0\r\n\r\n" : "\r\n";
+    u32 tlen = (u32)strlen(tail);
+    char* buf = malloc((size_t)hlen + record_len + tlen);
+    if (!buf) return NULL;
+    memcpy(buf, head, (size_t)hlen);
+    memcpy(buf + hlen, record, record_len);
+    memcpy(buf + hlen + record_len, tail, tlen);
+    *out_len = (u32)hlen + record_len + tlen;
+    return buf;
+}
+
+typedef struct {
+    SeaMeshServer* srv;
+    Job*           job;
+    SeaArena*      scratch;
+} StreamCtx;
+
+/* Progress sink for streaming jobs: one frame per FRAME_PIECE bytes. */
+static void stream_progress(const u8* data, u32 len, void* arg) {
+    StreamCtx* sc = (StreamCtx*)arg;
+    while (len > 0 && !atomic_load(&sc->job->abandoned)) {
+        u32 piece = len < FRAME_PIECE ? len : FRAME_PIECE;
+        sea_arena_reset(sc->scratch);
+        SeaSlice esc = sea_json_escape((SeaSlice){ .data = data, .len = piece }, sc->scratch);
+        char* record = esc.data ? (char*)sea_arena_alloc(sc->scratch, esc.len + 16, 1) : NULL;
+        if (!record) return;
+        u32 rlen = (u32)snprintf(record, esc.len + 16, "{\"chunk\":\"%.*s\"}\n",
+                                 (int)esc.len, (const char*)esc.data);
+        Frame* f = calloc(1, sizeof(Frame));
+        if (!f) return;
+        f->data = chunk_frame(record, rlen, false, &f->len);
+        if (!f->data) { free(f); return; }
+        f->conn = sc->job->conn;
+        f->gen = sc->job->gen;
+
+        pthread_mutex_lock(&sc->srv->lock);
+        if (sc->srv->frame_tail) sc->srv->frame_tail->next = f;
+        else sc->srv->frame_head = f;
+        sc->srv->frame_tail = f;
+        pthread_mutex_unlock(&sc->srv->lock);
+        wake(sc->srv);
+
+        data += piece;
+        len -= piece;
+    }
+}
+
+static void run_job(SeaMeshServer* srv, Job* job, SeaArena* arena, SeaArena* scratch) {
+    if (atomic_load(&job->abandoned)) {            /* Cancelled while queued */
+        atomic_fetch_add(&srv->abandoned, 1);
+        return;
+    }
+    sea_arena_reset(arena);
+    SeaSlice args = { .data = (const u8*)job->args, .len = job->args_len };
+    SeaSlice output = SEA_SLICE_EMPTY;
+    StreamCtx sc = { .srv = srv, .job = job, .scratch = scratch };
+    if (job->stream) sea_tool_set_progress(stream_progress, &sc);
+    SeaError err = sea_tool_exec(job->tool, args, arena, &output);
+    sea_tool_set_progress(NULL, NULL);
+    if (atomic_load(&job->abandoned)) atomic_fetch_add(&srv->abandoned, 1);
+
+    const char* text;
+    u32 text_len;
+    char errbuf[128];
+    if (err == SEA_OK) {
+        text = (const char*)output.data;
+        text_len = output.len;
+    } else {
+        text_len = (u32)snprintf(errbuf, sizeof(errbuf), "Error: %s", sea_error_str(err));
+        text = errbuf;
+    }
+
+    SeaSlice esc_out = sea_json_escape((SeaSlice){ .data = (const u8*)(text ? text : ""),
+                                                   .len = text ? text_len : 0 }, arena);
+    SeaSlice esc_id = sea_json_escape((SeaSlice){ .data = (const u8*)job->task_id,
+                                                  .len = (u32)strlen(job->task_id) }, arena);
+    int status = 200;
+    u32 cap = esc_out.len + esc_id.len + 80;
+    char* body = esc_out.data && esc_id.data ? (char*)sea_arena_alloc(arena, cap, 1) : NULL;
+    u32 body_len;
+    if (body) {
+        body_len = (u32)snprintf(body, cap,
+                                 "{\"task_id\":\"%s\",%s\"success\":%s,\"output\":\"%s\"}%s",
+                                 (const char*)esc_id.data, job->stream ? "\"done\":true," : "",
+                                 err == SEA_OK ? "true" : "false", (const char*)esc_out.data,
+                                 job->stream ? "\n" : "");
+    } else if (job->stream) {
+        body = "{\"done\":true,\"success\":false,\"output\":\"Error: tool output too large\"}\n";
+        body_len = (u32)strlen(body);
+    } else {
+        status = 503;
+        body = "{\"error\":\"tool output too large\"}";
+        body_len = (u32)strlen(body);
+        job->keep_alive = false;
+        atomic_fetch_add(&srv->rejected, 1);
+    }
+    if (job->stream) job->response = chunk_frame(body, body_len, true, &job->response_len);
+    else job->response = build_response(status, body, body_len, job->keep_alive, &job->response_len);
+    atomic_fetch_add(&srv->tasks, 1);
+}
+
+static void* worker_main(void* arg) {
+    SeaMeshServer* srv = (SeaMeshServer*)arg;
+    SeaArena arena, scratch;
+    if (sea_arena_create_named(&arena, "mesh.worker", SEA_MESH_WORKER_ARENA) != SEA_OK) return NULL;
+    if (sea_arena_create(&scratch, FRAME_PIECE * 8) != SEA_OK) {
+        sea_arena_destroy(&arena);
+        return NULL;
+    }
+
+    for (;;) {
+        pthread_mutex_lock(&srv->lock);
+        while (!srv->todo_head && !atomic_load(&srv->stop))
+            pthread_cond_wait(&srv->job_cond, &srv->lock);
+        Job* job = srv->todo_head;
+        if (!job) { pthread_mutex_unlock(&srv->lock); break; }   /* Stopping */
+        srv->todo_head = job->next;
+        if (!srv->todo_head) srv->todo_tail = NULL;
+        pthread_mutex_unlock(&srv->lock);
+
+        run_job(srv, job, &arena, &scratch);
+
+        pthread_mutex_lock(&srv->lock);
+        job->next = srv->done;
+        srv->done = job;
+        pthread_mutex_unlock(&srv->lock);
+        wake(srv);
+    }
+    sea_arena_destroy(&scratch);
+    sea_arena_destroy(&arena);
+    return NULL;
+}
+
+static void free_job(Job* job) {
+    free(job->task_id);
+    free(job->tool);
+    free(job->args);
+    free(job->response);
+    free(job);
+}
+
+static void free_frames(Frame* f) {
+    while (f) { Frame* n = f->next; free(f->data); free(f); f = n; }
+}
+
+/* Hand streamed progress and finished tool calls back to their
+ * connections. Frames go first: a job's frames were queued before it
+ * finished, so its final chunk stays last. */
+static void collect_done(SeaMeshServer* srv) {
+    pthread_mutex_lock(&srv->lock);
+    Job* job = srv->done;
+    Frame* frame = srv->frame_head;
+    srv->done = NULL;
+    srv->frame_head = srv->frame_tail = NULL;
+    pthread_mutex_unlock(&srv->lock);
+
+    for (Frame* f = frame; f; f = f->next) {
+        Conn* c = &srv->conns[f->conn];
+        if (c->fd >= 0 && c->gen == f->gen && c->busy) {
+            c->last_active = mono_ms();
+            conn_append(srv, f->conn, f->data, f->len);
+        }
+    }
+    free_frames(frame);
+
+    while (job) {
+        Job* next = job->next;
+        Conn* c = &srv->conns[job->conn];
+        if (c->fd >= 0 && c->gen == job->gen && c->busy) {
+            c->busy = false;
+            c->job = NULL;
+            c->last_active = mono_ms();
+            if (job->stream) {
+                if (!job->keep_alive) c->close_after = true;
+                if (job->response) conn_append(srv, job->conn, job->response, job->response_len);
+                else conn_close(srv, job->conn);
+            } else {
+                char* resp = job->response;
+                job->response = NULL;
+                conn_send(srv, job->conn, resp, job->response_len, job->keep_alive);
+            }
+            if (c->fd >= 0) conn_process(srv, job->conn);   /* Pipelined requests */
+        }
+        free_job(job);
+        job = next;
+    }
+}
+
+/* ── Event Loop ───────────────────────────────────────────── */
+
+static void* loop_main(void* arg) {
+    SeaMeshServer* srv = (SeaMeshServer*)arg;
+    struct epoll_event events[64];
+    u64 next_sweep = mono_ms() + 1000;
+
+    while (!atomic_load(&srv->stop)) {
+        int n = epoll_wait(srv->epoll_fd, events, 64, 1000);
+        for (int i = 0; i < n; i++) {
+            u32 tag = events[i].data.u32;
+            if (tag == EV_LISTEN) { accept_all(srv); continue; }
+            if (tag == EV_WAKE) {
+                u64 v;
+                ssize_t r = read(srv->wake_fd, &v, sizeof(v));
+                (void)r;
+                collect_done(srv);
+                continue;
+            }
+            u32 idx = tag - 2;
+            if (srv->conns[idx].fd < 0) continue;
+            u32 ev = events[i].events;
+            if (ev & EPOLLOUT) {
+                conn_write(srv, idx);
+                conn_process(srv, idx);
+            }
+            if (srv->conns[idx].fd >= 0 && (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+                conn_read(srv, idx);
+        }
+
+        /* Close idle keep-alive connections */
+        u64 now = mono_ms();
+        if (now >= next_sweep) {
+            for (u32 i = 0; i < SEA_MESH_SERVER_CONNS; i++) {
+                Conn* c = &srv->conns[i];
+                if (c->fd >= 0 && !c->busy && c->out_len == 0 &&
+                    now - c->last_active > SEA_MESH_IDLE_MS)
+                    conn_close(srv, i);
+            }
+            next_sweep = now + 1000;
+        }
+    }
+    return NULL;
+}
+
+/* ── Lifecycle ────────────────────────────────────────────── */
+
+static bool parse_subnet(const char* cidr, u32* net, u32* mask) {
+    char ip[64];
+    strncpy(ip, cidr, sizeof(ip) - 1);
+    ip[sizeof(ip) - 1] = '\0';
+    u32 bits = 32;
+    char* slash = strchr(ip, '/');
+    if (slash) {
+        *slash = '\0';
+        bits = (u32)strtoul(slash + 1, NULL, 10);
+        if (bits > 32) return false;
+    }
+    struct in_addr a;
+    if (inet_pton(AF_INET, ip, &a) != 1) return false;
+    *mask = bits == 0 ? 0 : 0xFFFFFFFFu << (32 - bits);
+    *net = ntohl(a.s_addr) & *mask;
+    return true;
+}
+
+SeaError sea_mesh_server_start(SeaMesh* mesh, const char* bind_ip, u32 workers,
+                               SeaMeshServer** out) {
+    if (!mesh || !out) return SEA_ERR_INVALID_INPUT;
+    *out = NULL;
+    if (!mesh->config.shared_secret[0]) {
+        SEA_LOG_ERROR("MESH", "Refusing to serve without a shared secret");
+        return SEA_ERR_CONFIG;
+    }
+
+    SeaMeshServer* srv = calloc(1, sizeof(SeaMeshServer));
+    if (!srv) return SEA_ERR_OOM;
+    srv->mesh = mesh;
+    srv->listen_fd = srv->epoll_fd = srv->wake_fd = -1;
+    for (u32 i = 0; i < SEA_MESH_SERVER_CONNS; i++) srv->conns[i].fd = -1;
+    if (mesh->config.allowed_subnet[0] &&
+        !parse_subnet(mesh->config.allowed_subnet, &srv->subnet, &srv->subnet_mask)) {
+        SEA_LOG_WARN("MESH", "Ignoring invalid allowed_subnet '%s'", mesh->config.allowed_subnet);
+    }
+
+    SeaError err = SEA_ERR_IO;
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(mesh->config.port) };
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind_ip && inet_pton(AF_INET, bind_ip, &addr.sin_addr) != 1) {
+        err = SEA_ERR_CONFIG;
+        goto fail;
+    }
+
+    srv->listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    if (srv->listen_fd < 0 ||
+        setsockopt(srv->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+        bind(srv->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(srv->listen_fd, 128) != 0) {
+        SEA_LOG_ERROR("MESH", "Cannot listen on port %u: %s", mesh->config.port, strerror(errno));
+        err = SEA_ERR_CONNECT;
+        goto fail;
+    }
+    socklen_t alen = sizeof(addr);
+    getsockname(srv->listen_fd, (struct sockaddr*)&addr, &alen);
+    mesh->config.port = ntohs(addr.sin_port);
+
+    srv->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    srv->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (srv->epoll_fd < 0 || srv->wake_fd < 0) goto fail;
+    struct epoll_event lev = { .events = EPOLLIN, .data.u32 = EV_LISTEN };
+    struct epoll_event wev = { .events = EPOLLIN, .data.u32 = EV_WAKE };
+    if (epoll_ctl(srv->epoll_fd, EPOLL_CTL_ADD, srv->listen_fd, &lev) != 0 ||
+        epoll_ctl(srv->epoll_fd, EPOLL_CTL_ADD, srv->wake_fd, &wev) != 0) goto fail;
+
+    if (sea_arena_create_named(&srv->arena, "mesh", SEA_MESH_MAX_REQUEST * 2) != SEA_OK) {
+        err = SEA_ERR_OOM;
+        goto fail;
+    }
+
+    pthread_mutex_init(&srv->lock, NULL);
+    pthread_cond_init(&srv->job_cond, NULL);
+    srv->worker_count = workers ? workers : SEA_MESH_SERVER_WORKERS;
+    srv->workers = calloc(srv->worker_count, sizeof(pthread_t));
+    if (!srv->workers) { err = SEA_ERR_OOM; goto fail_threads; }
+    u32 started = 0;
+    for (; started < srv->worker_count; started++)
+        if (pthread_create(&srv->workers[started], NULL, worker_main, srv) != 0) break;
+    if (started < srv->worker_count || pthread_create(&srv->loop, NULL, loop_main, srv) != 0) {
+        atomic_store(&srv->stop, true);
+        pthread_mutex_lock(&srv->lock);
+        pthread_cond_broadcast(&srv->job_cond);
+        pthread_mutex_unlock(&srv->lock);
+        for (u32 i = 0; i < started; i++) pthread_join(srv->workers[i], NULL);
+        goto fail_threads;
+    }
+
+    SEA_LOG_INFO("MESH", "HTTP endpoint listening on %s:%u (%u workers)",
+                 bind_ip ? bind_ip : "0.0.0.0", mesh->config.port, srv->worker_count);
+    *out = srv;
+    return SEA_OK;
+
+fail_threads:
+    free(srv->workers);
+    pthread_cond_destroy(&srv->job_cond);
+    pthread_mutex_destroy(&srv->lock);
+    sea_arena_destroy(&srv->arena);
+fail:
+    if (srv->listen_fd >= 0) close(srv->listen_fd);
+    if (srv->epoll_fd >= 0) close(srv->epoll_fd);
+    if (srv->wake_fd >= 0) close(srv->wake_fd);
+    free(srv);
+    return err;
+}
+
+void sea_mesh_server_stop(SeaMeshServer* srv) {
+    if (!srv) return;
+    atomic_store(&srv->stop, true);
+    wake(srv);
+    pthread_join(srv->loop, NULL);
+
+    /* Workers finish the tool they are running, then see stop */
+    pthread_mutex_lock(&srv->lock);
+    Job* pending = srv->todo_head;
+    srv->todo_head = srv->todo_tail = NULL;
+    pthread_cond_broadcast(&srv->job_cond);
+    pthread_mutex_unlock(&srv->lock);
+    for (u32 i = 0; i < srv->worker_count; i++) pthread_join(srv->workers[i], NULL);
+
+    for (u32 i = 0; i < SEA_MESH_SERVER_CONNS; i++) conn_close(srv, i);
+    while (pending) { Job* n = pending->next; free_job(pending); pending = n; }
+    while (srv->done) { Job* n = srv->done->next; free_job(srv->done); srv->done = n; }
+    free_frames(srv->frame_head);
+
+    close(srv->listen_fd);
+    close(srv->epoll_fd);
+    close(srv->wake_fd);
+    free(srv->workers);
+    pthread_cond_destroy(&srv->job_cond);
+    pthread_mutex_destroy(&srv->lock);
+    sea_arena_destroy(&srv->arena);
+    SEA_LOG_INFO("MESH", "HTTP endpoint stopped");
+    free(srv);
+}
+
+void sea_mesh_server_stats(SeaMeshServer* srv, SeaMeshServerStats* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!srv) return;
+    out->connections = atomic_load(&srv->connections);
+    out->requests    = atomic_load(&srv->requests);
+    out->tasks       = atomic_load(&srv->tasks);
+    out->rejected    = atomic_load(&srv->rejected);
+    out->broadcasts  = atomic_load(&srv->broadcasts);
+    out->abandoned   = atomic_load(&srv->abandoned);
+}
@@ -0,0 +1,562 @@
+/*
+ * sea_mesh_task.c — Asynchronous tool dispatch (Captain)
+ *
+ * Futures are queued to a single engine thread that owns a curl multi
+ * handle. Each task is one streaming POST /node/exec; the NDJSON body
+ * is split into records as it arrives, {"chunk"} records feed the
+ * future's stream buffer and the {"done"} record carries the result.
+ * Callers poll, wait on a condition variable, or cancel; cancelling
+ * drops the transfer, which the crew treats as an abandoned task.
+ */
+
+#include "seaclaw/sea_mesh.h"
+#include "seaclaw/sea_json.h"
+#include "seaclaw/sea_shield.h"
+#include "seaclaw/sea_log.h"
+
+#include <curl/curl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#define TASK_SCRATCH   (16 * 1024 * 1024)               /* One parsed record */
+#define MAX_RECORD     (6 * SEA_MESH_WORKER_ARENA + 1024) /* Escaped output  */
+
+typedef struct SeaMeshTasks SeaMeshTasks;
+
+struct SeaMeshFuture {
+    SeaMeshFuture*  next;             /* Engine queue or active list       */
+    SeaMeshTasks*   eng;
+    _Atomic int     refs;             /* Caller + engine                   */
+    pthread_mutex_t lock;             /* State, stream and result          */
+    pthread_cond_t  cond;
+    SeaMeshTaskState state;
+    bool            cancel;           /* Guarded by eng->lock              */
+
+    /* Request, owned copies */
+    char*           task_id;
+    char*           tool;
+    char*           args;
+    u32             timeout_ms;
+
+    /* Transfer, engine thread only */
+    CURL*           easy;
+    struct curl_slist* headers;
+    char*           body;
+    SeaMeshRoute    route;            /* route.id 0 until acquired         */
+    u64             started_us;
+    char*           line;             /* Partial NDJSON record             */
+    u32             line_len;
+    u32             line_cap;
+    bool            got_done;
+    bool            too_large;
+    bool            success;
+    char*           output;
+
+    /* Streamed progress */
+    char*           stream;
+    u32             stream_len;
+    u32             stream_cap;
+    u32             stream_read;
+
+    /* Outcome */
+    char            node_name[SEA_MESH_NODE_NAME_MAX];
+    u32             latency_ms;
+    char            error[128];
+};
+
+struct SeaMeshTasks {
+    SeaMesh*        mesh;
+    CURLM*          multi;
+    pthread_t       thread;
+    pthread_mutex_t lock;             /* Queue, cancel flags, stop         */
+    SeaMeshFuture*  queue_head;
+    SeaMeshFuture*  queue_tail;
+    bool            cancels;          /* Some future has cancel set        */
+    bool            stop;
+    SeaMeshFuture*  active;           /* Engine thread only                */
+    SeaArena        scratch;          /* Engine thread: one record         */
+};
+
+static u64 mono_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000 + (u64)ts.tv_nsec / 1000;
+}
+
+static char* dup_str(const char* s) {
+    size_t n = strlen(s);
+    char* d = malloc(n + 1);
+    if (d) memcpy(d, s, n + 1);
+    return d;
+}
+
+static SeaSlice cstr_slice(const char* s) {
+    return (SeaSlice){ .data = (const u8*)s, .len = (u32)strlen(s) };
+}
+
+/* ── Futures ─────────────────────────────────────────────── */
+
+static void future_unref(SeaMeshFuture* f) {
+    if (atomic_fetch_sub(&f->refs, 1) != 1) return;
+    pthread_mutex_destroy(&f->lock);
+    pthread_cond_destroy(&f->cond);
+    free(f->task_id);
+    free(f->tool);
+    free(f->args);
+    free(f->body);
+    free(f->line);
+    free(f->output);
+    free(f->stream);
+    free(f);
+}
+
+/* Publish the outcome and drop the engine's reference. Engine thread. */
+static void finish(SeaMeshTasks* eng, SeaMeshFuture* f, SeaMeshTaskState state,
+                   const char* error) {
+    SeaMesh* mesh = eng->mesh;
+    if (f->easy) {
+        curl_multi_remove_handle(eng->multi, f->easy);
+        curl_easy_cleanup(f->easy);
+        curl_slist_free_all(f->headers);
+        f->easy = NULL;
+        f->headers = NULL;
+    }
+
+    bool success = state == SEA_MESH_TASK_DONE && f->success;
+    u32 latency = f->started_us ? (u32)((mono_us() - f->started_us) / 1000) : 0;
+    if (f->route.id) {
+        sea_mesh_route_release(mesh, &f->route, success,
+                               state == SEA_MESH_TASK_CANCELLED ? -1.0 : (double)latency);
+        f->route.id = 0;
+    }
+
+    if (state != SEA_MESH_TASK_CANCELLED && f->node_name[0]) {
+        if (mesh->db) {
+            char audit[512];
+            snprintf(audit, sizeof(audit), "tool=%s node=%s latency=%ums success=%s",
+                     f->tool, f->node_name, latency, success ? "yes" : "no");
+            sea_db_log_event(mesh->db, "mesh_dispatch", f->tool, audit);
+        }
+        SEA_LOG_INFO("MESH", "Dispatched '%s' to '%s' (%ums, %s)",
+                     f->tool, f->node_name, latency, success ? "ok" : "fail");
+    }
+
+    pthread_mutex_lock(&f->lock);
+    f->state = state;
+    f->latency_ms = latency;
+    if (error) snprintf(f->error, sizeof(f->error), "%s", error);
+    pthread_cond_broadcast(&f->cond);
+    pthread_mutex_unlock(&f->lock);
+    future_unref(f);
+}
+
+/* ── Stream parsing ──────────────────────────────────────── */
+
+static void handle_record(SeaMeshTasks* eng, SeaMeshFuture* f, const char* rec, u32 len) {
+    sea_arena_reset(&eng->scratch);
+    SeaJsonValue root;
+    SeaSlice raw = { .data = (const u8*)rec, .len = len };
+    if (sea_json_parse(raw, &eng->scratch, &root) != SEA_OK || root.type != SEA_JSON_OBJECT) {
+        SEA_LOG_WARN("MESH", "Task %s: malformed stream record", f->task_id);
+        return;
+    }
+
+    if (sea_json_get_bool(&root, "done", false)) {
+        SeaSlice out = sea_json_unescape(sea_json_get_string(&root, "output"), &eng->scratch);
+        f->got_done = true;
+        f->success = sea_json_get_bool(&root, "success", true);
+        if (out.data && sea_shield_detect_output_injection(out)) {
+            SEA_LOG_WARN("MESH", "Shield REJECTED output from node '%s'", f->node_name);
+            out = SEA_SLICE_LIT("[Output rejected by Shield]");
+            f->success = false;
+        }
+        free(f->output);
+        f->output = malloc((size_t)out.len + 1);
+        if (f->output) {
+            if (out.len) memcpy(f->output, out.data, out.len);
+            f->output[out.len] = '\0';
+        }
+        return;
+    }
+
+    SeaSlice chunk = sea_json_unescape(sea_json_get_string(&root, "chunk"), &eng->scratch);
+    if (!chunk.data || chunk.len == 0) return;
+    if (sea_shield_detect_output_injection(chunk)) {
+        SEA_LOG_WARN("MESH", "Shield dropped streamed output from node '%s'", f->node_name);
+        return;
+    }
+    pthread_mutex_lock(&f->lock);
+    if (f->stream_len + chunk.len > f->stream_cap) {
+        u32 cap = f->stream_cap ? f->stream_cap : 4096;
+        while (cap < f->stream_len + chunk.len) cap *= 2;
+        char* grown = realloc(f->stream, cap);
+        if (!grown) { pthread_mutex_unlock(&f->lock); return; }
+        f->stream = grown;
+        f->stream_cap = cap;
+    }
+    memcpy(f->stream + f->stream_len, chunk.data, chunk.len);
+    f->stream_len += chunk.len;
+    pthread_cond_broadcast(&f->cond);
+    pthread_mutex_unlock(&f->lock);
+}
+
+/* curl write callback: split the body into newline-terminated records. */
+static size_t on_body(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    SeaMeshFuture* f = (SeaMeshFuture*)userdata;
+    size_t bytes = size * nmemb;
+    if (f->line_len + bytes > MAX_RECORD) { f->too_large = true; return 0; }
+    if (f->line_len + bytes > f->line_cap) {
+        u32 cap = f->line_cap ? f->line_cap : 16384;
+        while (cap < f->line_len + bytes) cap *= 2;
+        char* grown = realloc(f->line, cap);
+        if (!grown) return 0;
+        f->line = grown;
+        f->line_cap = cap;
+    }
+    memcpy(f->line + f->line_len, ptr, bytes);
+    f->line_len += (u32)bytes;
+
+    u32 start = 0;
+    for (u32 i = f->line_len - (u32)bytes; i < f->line_len; i++) {
+        if (f->line[i] != '\n') continue;
+        if (i > start) handle_record(f->eng, f, f->line + start, i - start);
+        start = i + 1;
+    }
+    if (start > 0) {
+        memmove(f->line, f->line + start, f->line_len - start);
+        f->line_len -= start;
+    }
+    return bytes;
+}
+
+/* ── Engine ──────────────────────────────────────────────── */
+
+static void start(SeaMeshTasks* eng, SeaMeshFuture* f) {
+    SeaMesh* mesh = eng->mesh;
+    if (!sea_mesh_route_acquire(mesh, f->tool, &f->route)) {
+        SEA_LOG_WARN("MESH", "No node for tool '%s'", f->tool);
+        finish(eng, f, SEA_MESH_TASK_FAILED, "No node available for this tool");
+        return;
+    }
+    f->started_us = mono_us();
+
+    char url[300];
+    memcpy(f->node_name, f->route.name, SEA_MESH_NODE_NAME_MAX);
+    snprintf(url, sizeof(url), "%s/node/exec", f->route.endpoint);
+
+    sea_arena_reset(&eng->scratch);
+    SeaSlice id   = sea_json_escape(cstr_slice(f->task_id), &eng->scratch);
+    SeaSlice tool = sea_json_escape(cstr_slice(f->tool), &eng->scratch);
+    SeaSlice args = sea_json_escape(cstr_slice(f->args), &eng->scratch);
+    u32 cap = id.len + tool.len + args.len + 80;
+    f->body = id.data && tool.data && args.data ? malloc(cap) : NULL;
+    f->easy = f->body ? curl_easy_init() : NULL;
+    if (!f->easy) {
+        finish(eng, f, SEA_MESH_TASK_FAILED, "Out of memory");
+        return;
+    }
+    int blen = snprintf(f->body, cap,
+        "{\"task_id\":\"%.*s\",\"tool\":\"%.*s\",\"args\":\"%.*s\",\"stream\":true}",
+        (int)id.len, (const char*)id.data, (int)tool.len, (const char*)tool.data,
+        (int)args.len, (const char*)args.data);
+
+    f->headers = curl_slist_append(NULL, "Content-Type: application/json");
+    if (mesh->config.shared_secret[0]) {
+        const char* token = sea_mesh_generate_token(mesh, &eng->scratch);
+        char header[160];
+        snprintf(header, sizeof(header), "X-Mesh-Token: %s", token ? token : "");
+        f->headers = curl_slist_append(f->headers, header);
+    }
+
+    curl_easy_setopt(f->easy, CURLOPT_URL, url);
+    curl_easy_setopt(f->easy, CURLOPT_POSTFIELDS, f->body);
+    curl_easy_setopt(f->easy, CURLOPT_POSTFIELDSIZE, (long)blen);
+    curl_easy_setopt(f->easy, CURLOPT_HTTPHEADER, f->headers);
+    curl_easy_setopt(f->easy, CURLOPT_WRITEFUNCTION, on_body);
+    curl_easy_setopt(f->easy, CURLOPT_WRITEDATA, f);
+    curl_easy_setopt(f->easy, CURLOPT_PRIVATE, (void*)f);
+    curl_easy_setopt(f->easy, CURLOPT_TIMEOUT_MS, (long)f->timeout_ms);
+    curl_easy_setopt(f->easy, CURLOPT_CONNECTTIMEOUT_MS, 10000L);
+    curl_easy_setopt(f->easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(f->easy, CURLOPT_USERAGENT, "Sea-Claw/" SEA_VERSION_STRING);
+    if (curl_multi_add_handle(eng->multi, f->easy) != CURLM_OK) {
+        finish(eng, f, SEA_MESH_TASK_FAILED, "Cannot start transfer");
+        return;
+    }
+    f->next = eng->active;
+    eng->active = f;
+}
+
+static void unlink_active(SeaMeshTasks* eng, SeaMeshFuture* f) {
+    for (SeaMeshFuture** p = &eng->active; *p; p = &(*p)->next) {
+        if (*p == f) { *p = f->next; f->next = NULL; return; }
+    }
+}
+
+static void complete(SeaMeshTasks* eng, SeaMeshFuture* f, CURLcode res) {
+    unlink_active(eng, f);
+    long status = 0;
+    curl_easy_getinfo(f->easy, CURLINFO_RESPONSE_CODE, &status);
+
+    char error[128];
+    if (res == CURLE_OK && status == 200 && f->got_done) {
+        finish(eng, f, SEA_MESH_TASK_DONE, NULL);
+        return;
+    }
+    if (f->too_large)                       snprintf(error, sizeof(error), "Response too large");
+    else if (res == CURLE_OPERATION_TIMEDOUT) snprintf(error, sizeof(error), "Task timed out");
+    else if (res != CURLE_OK)               snprintf(error, sizeof(error), "HTTP request to node failed: %s",
+                                                     curl_easy_strerror(res));
+    else if (status != 200)                 snprintf(error, sizeof(error), "Node answered HTTP %ld", status);
+    else                                    snprintf(error, sizeof(error), "Stream ended before the result");
+    SEA_LOG_WARN("MESH", "Dispatch of '%s' to '%s' failed: %s", f->tool, f->node_name, error);
+    finish(eng, f, SEA_MESH_TASK_FAILED, error);
+}
+
+static void* engine_main(void* arg) {
+    SeaMeshTasks* eng = (SeaMeshTasks*)arg;
+    for (;;) {
+        pthread_mutex_lock(&eng->lock);
+        SeaMeshFuture* queued = eng->queue_head;
+        eng->queue_head = eng->queue_tail = NULL;
+        bool stop = eng->stop;
+        bool cancels = eng->cancels;
+        eng->cancels = false;
+        pthread_mutex_unlock(&eng->lock);
+
+        while (queued) {
+            SeaMeshFuture* next = queued->next;
+            queued->next = NULL;
+            pthread_mutex_lock(&eng->lock);
+            bool cancel = queued->cancel;
+            pthread_mutex_unlock(&eng->lock);
+            if (stop)        finish(eng, queued, SEA_MESH_TASK_FAILED, "Mesh shutting down");
+            else if (cancel) finish(eng, queued, SEA_MESH_TASK_CANCELLED, "Cancelled");
+            else             start(eng, queued);
+            queued = next;
+        }
+
+        if (cancels || stop) {
+            SeaMeshFuture** p = &eng->active;
+            while (*p) {
+                SeaMeshFuture* f = *p;
+                pthread_mutex_lock(&eng->lock);
+                bool cancel = f->cancel;
+                pthread_mutex_unlock(&eng->lock);
+                if (!cancel && !stop) { p = &f->next; continue; }
+                *p = f->next;
+                f->next = NULL;
+                if (cancel) finish(eng, f, SEA_MESH_TASK_CANCELLED, "Cancelled");
+                else        finish(eng, f, SEA_MESH_TASK_FAILED, "Mesh shutting down");
+            }
+        }
+        if (stop) break;
+
+        int running = 0;
+        curl_multi_perform(eng->multi, &running);
+        CURLMsg* msg;
+        int left;
+        while ((msg = curl_multi_info_read(eng->multi, &left))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            SeaMeshFuture* f = NULL;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&f);
+            if (f) complete(eng, f, msg->data.result);
+        }
+        curl_multi_poll(eng->multi, NULL, 0, 1000, NULL);
+    }
+    return NULL;
+}
+
+/* Start the engine on first use. */
+static SeaMeshTasks* engine(SeaMesh* mesh) {
+    pthread_mutex_lock(&mesh->lock);
+    SeaMeshTasks* eng = mesh->tasks;
+    if (eng) { pthread_mutex_unlock(&mesh->lock); return eng; }
+
+    eng = calloc(1, sizeof(SeaMeshTasks));
+    if (eng) {
+        eng->mesh = mesh;
+        eng->multi = curl_multi_init();
+        if (eng->multi && sea_arena_create(&eng->scratch, TASK_SCRATCH) == SEA_OK) {
+            curl_multi_setopt(eng->multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                              (long)SEA_MESH_TASK_HOST_CONNS);
+            pthread_mutex_init(&eng->lock, NULL);
+            if (pthread_create(&eng->thread, NULL, engine_main, eng) == 0) {
+                mesh->tasks = eng;
+                pthread_mutex_unlock(&mesh->lock);
+                return eng;
+            }
+            pthread_mutex_destroy(&eng->lock);
+            sea_arena_destroy(&eng->scratch);
+        }
+        if (eng->multi) curl_multi_cleanup(eng->multi);
+        free(eng);
+    }
+    pthread_mutex_unlock(&mesh->lock);
+    SEA_LOG_ERROR("MESH", "Cannot start task engine");
+    return NULL;
+}
+
+void sea_mesh_tasks_shutdown(SeaMesh* mesh) {
+    if (!mesh) return;
+    pthread_mutex_lock(&mesh->lock);
+    SeaMeshTasks* eng = mesh->tasks;
+    mesh->tasks = NULL;
+    pthread_mutex_unlock(&mesh->lock);
+    if (!eng) return;
+
+    pthread_mutex_lock(&eng->lock);
+    eng->stop = true;
+    pthread_mutex_unlock(&eng->lock);
+    curl_multi_wakeup(eng->multi);
+    pthread_join(eng->thread, NULL);
+
+    curl_multi_cleanup(eng->multi);
+    pthread_mutex_destroy(&eng->lock);
+    sea_arena_destroy(&eng->scratch);
+    free(eng);
+}
+
+/* ── API ─────────────────────────────────────────────────── */
+
+SeaMeshFuture* sea_mesh_dispatch_async(SeaMesh* mesh, const SeaMeshTask* task) {
+    if (!mesh || !task || !task->tool_name) return NULL;
+    SeaMeshFuture* f = calloc(1, sizeof(SeaMeshFuture));
+    if (!f) return NULL;
+    f->task_id = dup_str(task->task_id ? task->task_id : "0");
+    f->tool    = dup_str(task->tool_name);
+    f->args    = dup_str(task->tool_args ? task->tool_args : "");
+    if (!f->task_id || !f->tool || !f->args) {
+        free(f->task_id); free(f->tool); free(f->args); free(f);
+        return NULL;
+    }
+    f->timeout_ms = task->timeout_ms ? task->timeout_ms : mesh->config.task_timeout_ms;
+    if (!f->timeout_ms) f->timeout_ms = 60000;
+    f->state = SEA_MESH_TASK_PENDING;
+    pthread_mutex_init(&f->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&f->cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    SeaMeshTasks* eng = engine(mesh);
+    if (!eng) {
+        f->state = SEA_MESH_TASK_FAILED;
+        snprintf(f->error, sizeof(f->error), "Task engine unavailable");
+        atomic_store(&f->refs, 1);
+        return f;
+    }
+    f->eng = eng;
+    atomic_store(&f->refs, 2);
+
+    pthread_mutex_lock(&eng->lock);
+    if (eng->queue_tail) eng->queue_tail->next = f;
+    else eng->queue_head = f;
+    eng->queue_tail = f;
+    pthread_mutex_unlock(&eng->lock);
+    curl_multi_wakeup(eng->multi);
+    return f;
+}
+
+SeaMeshTaskState sea_mesh_future_state(SeaMeshFuture* f) {
+    if (!f) return SEA_MESH_TASK_FAILED;
+    pthread_mutex_lock(&f->lock);
+    SeaMeshTaskState s = f->state;
+    pthread_mutex_unlock(&f->lock);
+    return s;
+}
+
+SeaMeshTaskState sea_mesh_future_poll(SeaMeshFuture* f, SeaArena* arena, SeaSlice* chunk) {
+    if (chunk) *chunk = SEA_SLICE_EMPTY;
+    if (!f) return SEA_MESH_TASK_FAILED;
+    pthread_mutex_lock(&f->lock);
+    SeaMeshTaskState s = f->state;
+    u32 avail = f->stream_len - f->stream_read;
+    if (chunk && arena && avail > 0) {
+        u8* copy = (u8*)sea_arena_alloc(arena, avail, 1);
+        if (copy) {
+            memcpy(copy, f->stream + f->stream_read, avail);
+            f->stream_read = f->stream_len;
+            *chunk = (SeaSlice){ .data = copy, .len = avail };
+        }
+    }
+    pthread_mutex_unlock(&f->lock);
+    return s;
+}
+
+SeaMeshTaskState sea_mesh_future_wait(SeaMeshFuture* f, u32 timeout_ms) {
+    if (!f) return SEA_MESH_TASK_FAILED;
+    /* Monotonic, so a wall-clock step cannot stretch or cut the wait */
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec  += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) { deadline.tv_sec++; deadline.tv_nsec -= 1000000000L; }
+
+    pthread_mutex_lock(&f->lock);
+    while (f->state == SEA_MESH_TASK_PENDING) {
+        if (timeout_ms == 0) pthread_cond_wait(&f->cond, &f->lock);
+        else if (pthread_cond_timedwait(&f->cond, &f->lock, &deadline) == ETIMEDOUT) break;
+    }
+    SeaMeshTaskState s = f->state;
+    pthread_mutex_unlock(&f->lock);
+    return s;
+}
+
+static const char* arena_str(SeaArena* arena, const char* s) {
+    if (!s || !arena) return NULL;
+    u32 len = (u32)strlen(s);
+    char* d = (char*)sea_arena_alloc(arena, (u64)len + 1, 1);
+    if (d) memcpy(d, s, (size_t)len + 1);
+    return d;
+}
+
+SeaMeshResult sea_mesh_future_result(SeaMeshFuture* f, SeaArena* arena) {
+    SeaMeshResult r = { .success = false };
+    if (!f) return r;
+    pthread_mutex_lock(&f->lock);
+    r.task_id = arena_str(arena, f->task_id);
+    if (f->state != SEA_MESH_TASK_PENDING) {
+        r.success    = f->state == SEA_MESH_TASK_DONE && f->success;
+        r.output     = f->state == SEA_MESH_TASK_DONE ? arena_str(arena, f->output) : NULL;
+        r.node_name  = f->node_name[0] ? arena_str(arena, f->node_name) : NULL;
+        r.latency_ms = f->latency_ms;
+        r.error      = f->error[0] ? arena_str(arena, f->error) : NULL;
+    }
+    pthread_mutex_unlock(&f->lock);
+    return r;
+}
+
+void sea_mesh_future_cancel(SeaMeshFuture* f) {
+    if (!f || !f->eng || sea_mesh_future_state(f) != SEA_MESH_TASK_PENDING) return;
+    pthread_mutex_lock(&f->eng->lock);
+    f->cancel = true;
+    f->eng->cancels = true;
+    pthread_mutex_unlock(&f->eng->lock);
+    curl_multi_wakeup(f->eng->multi);
+}
+
+void sea_mesh_future_free(SeaMeshFuture* f) {
+    if (!f) return;
+    sea_mesh_future_cancel(f);
+    future_unref(f);
+}
+
+/* ── Synchronous dispatch ────────────────────────────────── */
+
+SeaMeshResult sea_mesh_dispatch(SeaMesh* mesh, SeaMeshTask* task, SeaArena* arena) {
+    SeaMeshFuture* f = sea_mesh_dispatch_async(mesh, task);
+    if (!f) {
+        return (SeaMeshResult){ .task_id = task ? task->task_id : NULL,
+                                .success = false, .error = "Out of memory" };
+    }
+    sea_mesh_future_wait(f, 0);
+    SeaMeshResult r = sea_mesh_future_result(f, arena);
+    sea_mesh_future_free(f);
+    return r;
+}
@@ -9,6 +9,7 @@
 #include "seaclaw/sea_recall.h"
 #include "seaclaw/sea_db.h"
 #include "seaclaw/sea_log.h"
+#include "seaclaw/sea_metrics.h"
 
 #include <sqlite3.h>
 #include <stdio.h>
@@ -243,9 +244,9 @@ SeaError sea_recall_store(SeaRecall* rc, const char* category,
 
 /* ── Query ────────────────────────────────────────────────── */
 
-i32 sea_recall_query(SeaRecall* rc, const char* query,
-                     SeaRecallFact* out, i32 max_results,
-                     SeaArena* arena) {
+static i32 recall_query(SeaRecall* rc, const char* query,
+                        SeaRecallFact* out, i32 max_results,
+                        SeaArena* arena) {
     if (!rc || !rc->initialized || !query || !out || max_results <= 0) return 0;
 
     /* Extract query keywords */
@@ -347,6 +348,20 @@ i32 sea_recall_query(SeaRecall* rc, const char* query,
     return result_count;
 }
 
+i32 sea_recall_query(SeaRecall* rc, const char* query,
+                     SeaRecallFact* out, i32 max_results,
+                     SeaArena* arena) {
+    u64 t0 = sea_metrics_now_us();
+    i32 n = recall_query(rc, query, out, max_results, arena);
+    static SeaMetric* s_query_time;
+    if (!s_query_time)
+        s_query_time = sea_metric_histogram("sea_recall_query_seconds",
+                                            "Recall fact lookup time", NULL, NULL,
+                                            &SEA_METRICS_FAST);
+    sea_metric_observe(s_query_time, (f64)(sea_metrics_now_us() - t0) / 1e6);
+    return n;
+}
+
 /* ── Build Context ────────────────────────────────────────── */
 
 const char* sea_recall_build_context(SeaRecall* rc, const char* query,
@@ -42,20 +42,53 @@ static size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdat
     return bytes;
 }
 
+/* ── Write callback: hand bytes to a stream sink ──────────── */
+
+typedef struct {
+    CURL*           curl;
+    SeaHttpStreamFn fn;
+    void*           ctx;
+    bool            aborted;
+} StreamCtx;
+
+static size_t stream_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    StreamCtx* sc = (StreamCtx*)userdata;
+    u64 bytes = size * nmemb;
+    long status = 0;
+    curl_easy_getinfo(sc->curl, CURLINFO_RESPONSE_CODE, &status);
+    if (!sc->fn((i32)status, (const u8*)ptr, (u32)bytes, sc->ctx)) {
+        sc->aborted = true;
+        return 0;
+    }
+    return bytes;
+}
+
 /* ── Internal request ─────────────────────────────────────── */
 
+/* With a stream context the body goes to its sink instead of arena. */
 static SeaError do_request(const char* url, const char* method,
                            SeaSlice* post_body, const char* auth_header,
-                           SeaArena* arena, SeaHttpResponse* resp) {
+                           SeaArena* arena, StreamCtx* stream,
+                           SeaHttpResponse* resp) {
     CURL* curl = curl_easy_init();
     if (!curl) return SEA_ERR_CONNECT;
 
     WriteCtx ctx = { .arena = arena, .buf = NULL, .len = 0, .cap = 0 };
 
     curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ctx);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 120L);
+    if (stream) {
+        /* A stream lasts as long as generation does; give up only
+         * when it stalls */
+        stream->curl = curl;
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, stream_callback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, stream);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 120L);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ctx);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 120L);
+    }
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "Sea-Claw/" SEA_VERSION_STRING);
@@ -79,18 +112,25 @@ static SeaError do_request(const char* url, const char* method,
 
     CURLcode res = curl_easy_perform(curl);
 
+    curl_off_t ttfb_us = 0, total_us = 0;
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &ttfb_us);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total_us);
+    resp->ttfb_us  = (u64)ttfb_us;
+    resp->total_us = (u64)total_us;
+
+    long status = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+    resp->status_code = (i32)status;
+
     if (res != CURLE_OK) {
-        SEA_LOG_ERROR("HTTP", "%s %s failed: %s", method, url, curl_easy_strerror(res));
         curl_slist_free_all(headers);
         curl_easy_cleanup(curl);
+        if (stream && stream->aborted) return SEA_ERR_IO;   /* Sink said stop */
+        SEA_LOG_ERROR("HTTP", "%s %s failed: %s", method, url, curl_easy_strerror(res));
         if (res == CURLE_OPERATION_TIMEDOUT) return SEA_ERR_TIMEOUT;
         return SEA_ERR_CONNECT;
     }
 
-    long status = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
-
-    resp->status_code = (i32)status;
     resp->body.data   = ctx.buf;
     resp->body.len    = (u32)ctx.len;
     resp->headers     = SEA_SLICE_EMPTY;
@@ -106,21 +146,21 @@ static SeaError do_request(const char* url, const char* method,
 SeaError sea_http_get(const char* url, SeaArena* arena, SeaHttpResponse* resp) {
     if (!url || !arena || !resp) return SEA_ERR_IO;
     SEA_LOG_DEBUG("HTTP", "GET %s", url);
-    return do_request(url, "GET", NULL, NULL, arena, resp);
+    return do_request(url, "GET", NULL, NULL, arena, NULL, resp);
 }
 
 SeaError sea_http_get_auth(const char* url, const char* auth_header,
                             SeaArena* arena, SeaHttpResponse* resp) {
     if (!url || !arena || !resp) return SEA_ERR_IO;
     SEA_LOG_DEBUG("HTTP", "GET %s (auth)", url);
-    return do_request(url, "GET", NULL, auth_header, arena, resp);
+    return do_request(url, "GET", NULL, auth_header, arena, NULL, resp);
 }
 
 SeaError sea_http_post_json(const char* url, SeaSlice json_body,
                             SeaArena* arena, SeaHttpResponse* resp) {
     if (!url || !arena || !resp) return SEA_ERR_IO;
     SEA_LOG_DEBUG("HTTP", "POST %s (%u bytes)", url, json_body.len);
-    return do_request(url, "POST", &json_body, NULL, arena, resp);
+    return do_request(url, "POST", &json_body, NULL, arena, NULL, resp);
 }
 
 SeaError sea_http_post_json_auth(const char* url, SeaSlice json_body,
@@ -128,5 +168,122 @@ SeaError sea_http_post_json_auth(const char* url, SeaSlice json_body,
                                  SeaArena* arena, SeaHttpResponse* resp) {
     if (!url || !arena || !resp) return SEA_ERR_IO;
     SEA_LOG_DEBUG("HTTP", "POST %s (%u bytes, auth)", url, json_body.len);
-    return do_request(url, "POST", &json_body, auth_header, arena, resp);
+    return do_request(url, "POST", &json_body, auth_header, arena, NULL, resp);
+}
+
+SeaError sea_http_post_stream(const char* url, SeaSlice json_body,
+                              const char* auth_header, SeaHttpStreamFn on_data,
+                              void* ctx, SeaHttpResponse* resp) {
+    if (!url || !on_data || !resp) return SEA_ERR_IO;
+    SEA_LOG_DEBUG("HTTP", "POST %s (%u bytes, stream)", url, json_body.len);
+    StreamCtx sc = { .fn = on_data, .ctx = ctx };
+    return do_request(url, "POST", &json_body, auth_header, NULL, &sc, resp);
+}
+
+/* ── Concurrent requests ──────────────────────────────────── */
+
+#define MULTI_DEFAULT_TIMEOUT_MS 10000
+
+static SeaError curl_error(CURLcode res) {
+    if (res == CURLE_OPERATION_TIMEDOUT) return SEA_ERR_TIMEOUT;
+    if (res == CURLE_WRITE_ERROR)        return SEA_ERR_ARENA_FULL;
+    return SEA_ERR_CONNECT;
+}
+
+SeaError sea_http_multi(SeaHttpRequest* reqs, u32 count, SeaArena* arena) {
+    return sea_http_multi_until(reqs, count, arena, NULL, NULL);
+}
+
+SeaError sea_http_multi_until(SeaHttpRequest* reqs, u32 count, SeaArena* arena,
+                              SeaHttpDoneFn on_done, void* ctx) {
+    if (!reqs || !arena) return SEA_ERR_IO;
+    if (count == 0) return SEA_OK;
+
+    WriteCtx*           ctx_buf = (WriteCtx*)sea_arena_alloc(arena, sizeof(WriteCtx) * count, 8);
+    CURL**              easy    = (CURL**)sea_arena_alloc(arena, sizeof(CURL*) * count, 8);
+    struct curl_slist** headers = (struct curl_slist**)sea_arena_alloc(arena, sizeof(void*) * count, 8);
+    if (!ctx_buf || !easy || !headers) return SEA_ERR_ARENA_FULL;
+
+    CURLM* multi = curl_multi_init();
+    if (!multi) return SEA_ERR_CONNECT;
+
+    for (u32 i = 0; i < count; i++) {
+        SeaHttpRequest* r = &reqs[i];
+        r->err = SEA_ERR_CONNECT;
+        r->resp = (SeaHttpResponse){ 0 };
+        r->elapsed_ms = 0;
+        r->elapsed_us = 0;
+        r->done = false;
+        ctx_buf[i] = (WriteCtx){ .arena = arena };
+        headers[i] = NULL;
+        easy[i] = r->url ? curl_easy_init() : NULL;
+        if (!easy[i]) continue;
+
+        long timeout = r->timeout_ms ? (long)r->timeout_ms : MULTI_DEFAULT_TIMEOUT_MS;
+        curl_easy_setopt(easy[i], CURLOPT_URL, r->url);
+        curl_easy_setopt(easy[i], CURLOPT_WRITEFUNCTION, write_callback);
+        curl_easy_setopt(easy[i], CURLOPT_WRITEDATA, &ctx_buf[i]);
+        curl_easy_setopt(easy[i], CURLOPT_TIMEOUT_MS, timeout);
+        curl_easy_setopt(easy[i], CURLOPT_CONNECTTIMEOUT_MS, timeout);
+        curl_easy_setopt(easy[i], CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy[i], CURLOPT_USERAGENT, "Sea-Claw/" SEA_VERSION_STRING);
+        curl_easy_setopt(easy[i], CURLOPT_PRIVATE, (void*)r);
+        if (r->header) headers[i] = curl_slist_append(headers[i], r->header);
+        if (r->body.data) {
+            headers[i] = curl_slist_append(headers[i], "Content-Type: application/json");
+            curl_easy_setopt(easy[i], CURLOPT_POSTFIELDS, (const char*)r->body.data);
+            curl_easy_setopt(easy[i], CURLOPT_POSTFIELDSIZE, (long)r->body.len);
+        }
+        if (headers[i]) curl_easy_setopt(easy[i], CURLOPT_HTTPHEADER, headers[i]);
+        curl_multi_add_handle(multi, easy[i]);
+    }
+
+    int running = 1;
+    bool stop = false;
+    while (running && !stop) {
+        if (curl_multi_perform(multi, &running) != CURLM_OK) break;
+
+        CURLMsg* msg;
+        int left;
+        while (!stop && (msg = curl_multi_info_read(multi, &left))) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            SeaHttpRequest* r = NULL;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&r);
+            if (!r) continue;
+            u32 i = (u32)(r - reqs);
+
+            curl_off_t ttfb_us = 0, total_us = 0;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_STARTTRANSFER_TIME_T, &ttfb_us);
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_TOTAL_TIME_T, &total_us);
+            r->elapsed_us = (u64)total_us;
+            r->elapsed_ms = (u32)(total_us / 1000);
+            r->resp.ttfb_us  = (u64)ttfb_us;
+            r->resp.total_us = (u64)total_us;
+            r->done = true;
+
+            if (msg->data.result != CURLE_OK) {
+                SEA_LOG_DEBUG("HTTP", "%s failed: %s", r->url, curl_easy_strerror(msg->data.result));
+                r->err = curl_error(msg->data.result);
+            } else {
+                long status = 0;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &status);
+                r->err = SEA_OK;
+                r->resp.status_code = (i32)status;
+                r->resp.body.data   = ctx_buf[i].buf;
+                r->resp.body.len    = (u32)ctx_buf[i].len;
+                r->resp.headers     = SEA_SLICE_EMPTY;
+            }
+            if (on_done && !on_done(r, i, ctx)) stop = true;
+        }
+        if (running && !stop) curl_multi_poll(multi, NULL, 0, 100, NULL);
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        if (!easy[i]) continue;
+        curl_multi_remove_handle(multi, easy[i]);
+        curl_easy_cleanup(easy[i]);
+        curl_slist_free_all(headers[i]);
+    }
+    curl_multi_cleanup(multi);
+    return SEA_OK;
 }
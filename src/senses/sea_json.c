@@ -426,3 +426,105 @@ void sea_json_debug_print(const SeaJsonValue* val, int indent) {
             break;
     }
 }
+
+/* ── Strings ──────────────────────────────────────────────── */
+
+static i32 hex4(const u8* p) {
+    i32 v = 0;
+    for (int i = 0; i < 4; i++) {
+        u8 c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9')      v |= c - '0';
+        else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+        else return -1;
+    }
+    return v;
+}
+
+static u32 put_utf8(u8* o, u32 cp) {
+    if (cp < 0x80)    { o[0] = (u8)cp; return 1; }
+    if (cp < 0x800)   { o[0] = (u8)(0xC0 | (cp >> 6)); o[1] = (u8)(0x80 | (cp & 0x3F)); return 2; }
+    if (cp < 0x10000) {
+        o[0] = (u8)(0xE0 | (cp >> 12));
+        o[1] = (u8)(0x80 | ((cp >> 6) & 0x3F));
+        o[2] = (u8)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    o[0] = (u8)(0xF0 | (cp >> 18));
+    o[1] = (u8)(0x80 | ((cp >> 12) & 0x3F));
+    o[2] = (u8)(0x80 | ((cp >> 6) & 0x3F));
+    o[3] = (u8)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+SeaSlice sea_json_unescape(SeaSlice raw, SeaArena* arena) {
+    /* Decoding never grows the text */
+    u8* out = (u8*)sea_arena_alloc(arena, (u64)raw.len + 1, 1);
+    if (!out) return SEA_SLICE_EMPTY;
+    const u8* s = raw.data;
+    u32 n = 0;
+    for (u32 i = 0; i < raw.len; i++) {
+        if (s[i] != '\\' || i + 1 >= raw.len) { out[n++] = s[i]; continue; }
+        u8 e = s[++i];
+        switch (e) {
+            case 'n': out[n++] = '\n'; break;
+            case 't': out[n++] = '\t'; break;
+            case 'r': out[n++] = '\r'; break;
+            case 'b': out[n++] = '\b'; break;
+            case 'f': out[n++] = '\f'; break;
+            case 'u': {
+                i32 cp = i + 4 < raw.len ? hex4(s + i + 1) : -1;
+                if (cp < 0) { out[n++] = 'u'; break; }
+                i += 4;
+                /* High surrogate followed by \uDC00-\uDFFF */
+                if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 < raw.len &&
+                    s[i + 1] == '\\' && s[i + 2] == 'u') {
+                    i32 lo = hex4(s + i + 3);
+                    if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                        i += 6;
+                    }
+                }
+                if (cp >= 0xD800 && cp <= 0xDFFF) cp = 0xFFFD;   /* Lone surrogate */
+                n += put_utf8(out + n, (u32)cp);
+                break;
+            }
+            default: out[n++] = e; break;   /* \" \\ \/ */
+        }
+    }
+    out[n] = '\0';
+    return (SeaSlice){ .data = out, .len = n };
+}
+
+SeaSlice sea_json_escape(SeaSlice text, SeaArena* arena) {
+    static const char hex[] = "0123456789abcdef";
+    u32 need = 0;
+    for (u32 i = 0; i < text.len; i++) {
+        u8 c = text.data[i];
+        need += (c == '"' || c == '\\' || c == '\n' || c == '\r' || c == '\t') ? 2
+              : c < 0x20 ? 6 : 1;
+    }
+    u8* out = (u8*)sea_arena_alloc(arena, (u64)need + 1, 1);
+    if (!out) return SEA_SLICE_EMPTY;
+    u32 n = 0;
+    for (u32 i = 0; i < text.len; i++) {
+        u8 c = text.data[i];
+        switch (c) {
+            case '"':  out[n++] = '\\'; out[n++] = '"';  break;
+            case '\\': out[n++] = '\\'; out[n++] = '\\'; break;
+            case '\n': out[n++] = '\\'; out[n++] = 'n';  break;
+            case '\r': out[n++] = '\\'; out[n++] = 'r';  break;
+            case '\t': out[n++] = '\\'; out[n++] = 't';  break;
+            default:
+                if (c < 0x20) {
+                    out[n++] = '\\'; out[n++] = 'u'; out[n++] = '0'; out[n++] = '0';
+                    out[n++] = (u8)hex[c >> 4]; out[n++] = (u8)hex[c & 0xF];
+                } else {
+                    out[n++] = c;
+                }
+        }
+    }
+    out[n] = '\0';
+    return (SeaSlice){ .data = out, .len = n };
+}
@@ -62,7 +62,7 @@ SeaError sea_session_init(SeaSessionManager* mgr, SeaDb* db,
     mgr->max_history = 30;   /* Summarize when history exceeds 30 messages */
     mgr->keep_recent = 10;   /* Keep last 10 messages after summarization  */
 
-    SeaError err = sea_arena_create(&mgr->arena, arena_size);
+    SeaError err = sea_arena_create_named(&mgr->arena, "sessions", arena_size);
     if (err != SEA_OK) return err;
 
     /* Create sessions table in DB if it doesn't exist */
@@ -277,19 +277,14 @@ SeaError sea_session_summarize(SeaSessionManager* mgr, const char* key) {
 
     SEA_LOG_INFO("SESSION", "Summarizing session %s (%u messages)", key, s->history_count);
 
-    /* Build conversation text for summarization */
-    SeaArena sum_arena;
-    if (sea_arena_create(&sum_arena, 256 * 1024) != SEA_OK) {
-        return SEA_ERR_OOM;
-    }
-
     /* Determine how many messages to summarize (all except keep_recent) */
     u32 to_summarize = s->history_count > mgr->keep_recent
                        ? s->history_count - mgr->keep_recent : 0;
-    if (to_summarize == 0) {
-        sea_arena_destroy(&sum_arena);
-        return SEA_OK; /* Nothing to summarize */
-    }
+    if (to_summarize == 0) return SEA_OK; /* Nothing to summarize */
+
+    /* The LLM round trip runs in this thread's scratch arena */
+    SeaScratch tmp = sea_scratch_begin(&mgr->arena);
+    if (!tmp.arena) return SEA_ERR_OOM;
 
     /* Build prompt: existing summary + messages to compress */
     char prompt[8192];
@@ -322,7 +317,7 @@ SeaError sea_session_summarize(SeaSessionManager* mgr, const char* key) {
     }
 
     /* Call LLM for summarization */
-    SeaAgentResult ar = sea_agent_chat(mgr->agent_cfg, NULL, 0, prompt, &sum_arena);
+    SeaAgentResult ar = sea_agent_chat(mgr->agent_cfg, NULL, 0, prompt, tmp.arena);
 
     if (ar.error == SEA_OK && ar.text) {
         /* Store new summary */
@@ -371,7 +366,7 @@ SeaError sea_session_summarize(SeaSessionManager* mgr, const char* key) {
                      key, ar.text ? ar.text : "unknown error");
     }
 
-    sea_arena_destroy(&sum_arena);
+    sea_scratch_end(tmp);
     return SEA_OK;
 }
 
@@ -128,7 +128,7 @@ SeaError sea_skill_init(SeaSkillRegistry* reg, const char* skills_dir) {
         mkdir(reg->skills_dir, 0755);
     }
 
-    SeaError err = sea_arena_create(&reg->arena, 64 * 1024);
+    SeaError err = sea_arena_create_named(&reg->arena, "skills", 64 * 1024);
     if (err != SEA_OK) return err;
 
     SEA_LOG_INFO("SKILL", "Registry initialized (dir: %s)", reg->skills_dir);
@@ -90,7 +90,7 @@ SeaError sea_telegram_send(SeaTelegram* tg, i64 chat_id, const char* text) {
     SeaSlice json_body = { .data = (const u8*)body, .len = (u32)len };
 
     SeaHttpResponse resp;
-    u64 saved_offset = tg->arena->offset;
+    SeaArenaMark mark = sea_arena_mark(tg->arena);
     SeaError err = sea_http_post_json(url, json_body, tg->arena, &resp);
 
     if (err != SEA_OK) {
@@ -101,7 +101,7 @@ SeaError sea_telegram_send(SeaTelegram* tg, i64 chat_id, const char* text) {
     }
 
     /* Reset arena to before this call */
-    tg->arena->offset = saved_offset;
+    sea_arena_rewind(tg->arena, mark);
     return err;
 }
 
@@ -135,18 +135,18 @@ SeaError sea_telegram_poll(SeaTelegram* tg) {
 
     build_url(url, sizeof(url), tg->bot_token, params);
 
-    u64 saved_offset = tg->arena->offset;
+    SeaArenaMark mark = sea_arena_mark(tg->arena);
 
     SeaHttpResponse resp;
     SeaError err = sea_http_get(url, tg->arena, &resp);
     if (err != SEA_OK) {
-        tg->arena->offset = saved_offset;
+        sea_arena_rewind(tg->arena, mark);
         return err;
     }
 
     if (resp.status_code != 200) {
         SEA_LOG_WARN("TELEGRAM", "getUpdates HTTP %d", resp.status_code);
-        tg->arena->offset = saved_offset;
+        sea_arena_rewind(tg->arena, mark);
         return SEA_ERR_CONNECT;
     }
 
@@ -154,13 +154,13 @@ SeaError sea_telegram_poll(SeaTelegram* tg) {
     SeaJsonValue json;
     err = sea_json_parse(resp.body, tg->arena, &json);
     if (err != SEA_OK) {
-        tg->arena->offset = saved_offset;
+        sea_arena_rewind(tg->arena, mark);
         return err;
     }
 
     const SeaJsonValue* result = sea_json_get(&json, "result");
     if (!result || result->type != SEA_JSON_ARRAY) {
-        tg->arena->offset = saved_offset;
+        sea_arena_rewind(tg->arena, mark);
         return SEA_OK; /* No updates */
     }
 
@@ -219,6 +219,6 @@ SeaError sea_telegram_poll(SeaTelegram* tg) {
     }
 
     /* Reset arena after processing all updates */
-    tg->arena->offset = saved_offset;
+    sea_arena_rewind(tg->arena, mark);
     return SEA_OK;
 }
@@ -1,13 +1,22 @@
 /*
  * sea_usage.c — Usage Tracking Implementation
  *
- * Lightweight token counters per provider and per day.
- * Persisted to SQLite usage_stats table.
+ * Token counters and latency histograms per provider, sharded per
+ * thread and summed on read. Providers are interned into a small slot
+ * table by CAS on the name hash, so recording never takes a lock.
+ * Daily totals are built by folding the change since the last flush
+ * into today's row, and the same deltas are upserted to the SQLite
+ * usage_stats table in one transaction, on a connection of the
+ * tracker's own.
  */
 
 #include "seaclaw/sea_usage.h"
 #include "seaclaw/sea_log.h"
+#include "seaclaw/sea_hash.h"
 
+#include <sqlite3.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -16,23 +25,109 @@
 
 static u32 today_date(void) {
     time_t now = time(NULL);
-    struct tm* tm = localtime(&now);
-    return (u32)((tm->tm_year + 1900) * 10000 +
-                  (tm->tm_mon + 1) * 100 +
-                  tm->tm_mday);
+    struct tm tm;
+    localtime_r(&now, &tm);
+    return (u32)((tm.tm_year + 1900) * 10000 +
+                  (tm.tm_mon + 1) * 100 +
+                  tm.tm_mday);
 }
 
-static SeaUsageProvider* find_or_create_provider(SeaUsageTracker* t, const char* name) {
-    for (u32 i = 0; i < t->provider_count; i++) {
-        if (strcmp(t->providers[i].name, name) == 0) return &t->providers[i];
+static u64 name_hash(const char* s) {
+    u64 h = sea_fnv1a(SEA_FNV1A_INIT, (const u8*)s, strlen(s));
+    return h ? h : 1;                               /* 0 marks a free slot */
+}
+
+/* Slot of provider; claims a free one if create. -1 if absent/full. */
+static i32 provider_slot(SeaUsageTracker* t, const char* name, bool create) {
+    u64 h = name_hash(name);
+    for (u32 i = 0; i < SEA_USAGE_PROVIDER_MAX; i++) {
+        SeaUsageSlot* s = &t->slots[i];
+        u64 cur = atomic_load_explicit(&s->hash, memory_order_acquire);
+        if (cur == 0) {
+            if (!create) return -1;
+            if (!atomic_compare_exchange_strong(&s->hash, &cur, h)) {
+                if (cur != h) continue;       /* Lost the slot to another name */
+            } else {
+                strncpy(s->name, name, SEA_USAGE_PROVIDER_NAME_MAX - 1);
+                atomic_store_explicit(&s->ready, true, memory_order_release);
+                return (i32)i;
+            }
+        }
+        if (cur != h) continue;
+        while (!atomic_load_explicit(&s->ready, memory_order_acquire)) { /* Being named */ }
+        if (strncmp(s->name, name, SEA_USAGE_PROVIDER_NAME_MAX - 1) == 0) return (i32)i;
+    }
+    return -1;
+}
+
+static _Atomic u32 s_next_shard;
+static _Thread_local u32 t_shard = UINT32_MAX;
+
+static u32 my_shard(void) {
+    if (t_shard == UINT32_MAX)
+        t_shard = atomic_fetch_add_explicit(&s_next_shard, 1, memory_order_relaxed) % SEA_USAGE_SHARDS;
+    return t_shard;
+}
+
+/* 0-7µs exact, then eight buckets per power of two */
+static u32 hist_bucket(u64 us) {
+    const u32 sub = 1u << SEA_USAGE_HIST_SUB_BITS;
+    if (us < sub) return (u32)us;
+    u32 msb = 63 - (u32)__builtin_clzll(us);
+    u32 b = (msb - SEA_USAGE_HIST_SUB_BITS + 1) * sub +
+            (u32)((us >> (msb - SEA_USAGE_HIST_SUB_BITS)) & (sub - 1));
+    return b < SEA_USAGE_HIST_BUCKETS ? b : SEA_USAGE_HIST_BUCKETS - 1;
+}
+
+static u64 bucket_upper(u32 b) {
+    const u32 sub = 1u << SEA_USAGE_HIST_SUB_BITS;
+    if (b < sub) return b;
+    u32 shift = b / sub - 1;
+    return ((u64)(sub + b % sub + 1) << shift) - 1;
+}
+
+static u64 cell_sum(SeaUsageTracker* t, u32 slot, size_t offset) {
+    u64 sum = 0;
+    for (u32 s = 0; s < SEA_USAGE_SHARDS; s++) {
+        _Atomic u64* c = (_Atomic u64*)((u8*)&t->shards[s].cells[slot] + offset);
+        sum += atomic_load_explicit(c, memory_order_relaxed);
+    }
+    return sum;
+}
+
+/* Counters of one provider summed over shards (lifetime of process) */
+static SeaUsageDay live_totals(SeaUsageTracker* t, u32 slot) {
+    return (SeaUsageDay){
+        .tokens_in  = cell_sum(t, slot, offsetof(SeaUsageCell, tokens_in)),
+        .tokens_out = cell_sum(t, slot, offsetof(SeaUsageCell, tokens_out)),
+        .requests   = cell_sum(t, slot, offsetof(SeaUsageCell, requests)),
+        .errors     = cell_sum(t, slot, offsetof(SeaUsageCell, errors)),
+    };
+}
+
+/* p50 and p99 of one histogram kind; returns the sample count */
+static u64 percentiles(SeaUsageTracker* t, u32 slot, bool ttfb, u64* p50, u64* p99) {
+    u64 buckets[SEA_USAGE_HIST_BUCKETS] = {0}, n = 0;
+    for (u32 s = 0; s < SEA_USAGE_SHARDS; s++) {
+        const SeaUsageCell* c = &t->shards[s].cells[slot];
+        for (u32 b = 0; b < SEA_USAGE_HIST_BUCKETS; b++) {
+            u32 v = atomic_load_explicit(ttfb ? &c->ttfb[b] : &c->total[b], memory_order_relaxed);
+            buckets[b] += v;
+            n += v;
+        }
     }
-    if (t->provider_count >= SEA_USAGE_PROVIDER_MAX) return NULL;
-    SeaUsageProvider* p = &t->providers[t->provider_count++];
-    memset(p, 0, sizeof(SeaUsageProvider));
-    strncpy(p->name, name, SEA_USAGE_PROVIDER_NAME_MAX - 1);
-    return p;
+    *p50 = *p99 = 0;
+    if (n == 0) return 0;
+    u64 r50 = (n - 1) / 2 + 1, r99 = (u64)((double)(n - 1) * 0.99) + 1, seen = 0;
+    for (u32 b = 0; b < SEA_USAGE_HIST_BUCKETS; b++) {
+        seen += buckets[b];
+        if (!*p50 && seen >= r50) *p50 = bucket_upper(b);
+        if (seen >= r99) { *p99 = bucket_upper(b); break; }
+    }
+    return n;
 }
 
+/* Caller holds t->lock. */
 static SeaUsageDay* find_or_create_day(SeaUsageTracker* t, u32 date) {
     for (u32 i = 0; i < t->day_count; i++) {
         if (t->days[i].date == date) return &t->days[i];
@@ -56,8 +151,20 @@ SeaError sea_usage_init(SeaUsageTracker* tracker, SeaDb* db) {
     if (!tracker) return SEA_ERR_INVALID_INPUT;
     memset(tracker, 0, sizeof(SeaUsageTracker));
     tracker->db = db;
+    pthread_mutex_init(&tracker->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&tracker->wake, &attr);
+    pthread_condattr_destroy(&attr);
 
     if (db) {
+        /* Own connection: a BEGIN on the shared handle would take in
+         * every other thread's statements. In-memory databases can
+         * only share it, and then flush without a transaction. */
+        tracker->conn = sea_db_connect(db);
+        tracker->own_conn = tracker->conn != NULL;
+        if (!tracker->conn) tracker->conn = sea_db_handle(db);
         sea_db_exec(db,
             "CREATE TABLE IF NOT EXISTS usage_stats ("
             "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
@@ -75,133 +182,320 @@ SeaError sea_usage_init(SeaUsageTracker* tracker, SeaDb* db) {
     return SEA_OK;
 }
 
+void sea_usage_destroy(SeaUsageTracker* tracker) {
+    if (!tracker) return;
+    pthread_mutex_lock(&tracker->lock);
+    tracker->running = false;
+    pthread_cond_broadcast(&tracker->wake);
+    pthread_mutex_unlock(&tracker->lock);
+    if (tracker->has_thread) {
+        pthread_join(tracker->thread, NULL);
+        tracker->has_thread = false;
+    }
+    sea_usage_flush(tracker);
+    if (tracker->own_conn) sqlite3_close(tracker->conn);
+    tracker->conn = NULL;
+    pthread_cond_destroy(&tracker->wake);
+    pthread_mutex_destroy(&tracker->lock);
+}
+
 /* ── Record ───────────────────────────────────────────────── */
 
-void sea_usage_record(SeaUsageTracker* tracker, const char* provider,
-                       u32 tokens_in, u32 tokens_out, bool error) {
+void sea_usage_record_timed(SeaUsageTracker* tracker, const char* provider,
+                            u32 tokens_in, u32 tokens_out, bool error,
+                            u64 ttfb_us, u64 total_us) {
     if (!tracker || !provider) return;
+    i32 slot = provider_slot(tracker, provider, true);
+    if (slot < 0) return;
 
-    /* Update provider stats */
-    SeaUsageProvider* p = find_or_create_provider(tracker, provider);
-    if (p) {
-        p->tokens_in += tokens_in;
-        p->tokens_out += tokens_out;
-        p->requests++;
-        if (error) p->errors++;
-    }
-
-    /* Update daily stats */
-    u32 date = today_date();
-    SeaUsageDay* d = find_or_create_day(tracker, date);
-    if (d) {
-        d->tokens_in += tokens_in;
-        d->tokens_out += tokens_out;
-        d->requests++;
-        if (error) d->errors++;
-    }
+    SeaUsageCell* c = &tracker->shards[my_shard()].cells[slot];
+    atomic_fetch_add_explicit(&c->tokens_in, tokens_in, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->tokens_out, tokens_out, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->requests, 1, memory_order_relaxed);
+    if (error) atomic_fetch_add_explicit(&c->errors, 1, memory_order_relaxed);
+    if (ttfb_us)  atomic_fetch_add_explicit(&c->ttfb[hist_bucket(ttfb_us)], 1, memory_order_relaxed);
+    if (total_us) atomic_fetch_add_explicit(&c->total[hist_bucket(total_us)], 1, memory_order_relaxed);
+}
 
-    /* Update totals */
-    tracker->total_tokens_in += tokens_in;
-    tracker->total_tokens_out += tokens_out;
-    tracker->total_requests++;
-    if (error) tracker->total_errors++;
+void sea_usage_record(SeaUsageTracker* tracker, const char* provider,
+                       u32 tokens_in, u32 tokens_out, bool error) {
+    sea_usage_record_timed(tracker, provider, tokens_in, tokens_out, error, 0, 0);
 }
 
 /* ── Lookup ───────────────────────────────────────────────── */
 
-const SeaUsageProvider* sea_usage_provider(const SeaUsageTracker* tracker,
-                                            const char* provider) {
-    if (!tracker || !provider) return NULL;
-    for (u32 i = 0; i < tracker->provider_count; i++) {
-        if (strcmp(tracker->providers[i].name, provider) == 0) {
-            return &tracker->providers[i];
-        }
-    }
-    return NULL;
+bool sea_usage_provider(SeaUsageTracker* tracker, const char* provider,
+                        SeaUsageProvider* out) {
+    if (!tracker || !provider || !out) return false;
+    i32 slot = provider_slot(tracker, provider, false);
+    if (slot < 0) return false;
+
+    SeaUsageDay live = live_totals(tracker, (u32)slot);
+    pthread_mutex_lock(&tracker->lock);
+    SeaUsageDay base = tracker->base[slot];
+    pthread_mutex_unlock(&tracker->lock);
+
+    memset(out, 0, sizeof(*out));
+    strncpy(out->name, tracker->slots[slot].name, SEA_USAGE_PROVIDER_NAME_MAX - 1);
+    out->tokens_in  = base.tokens_in + live.tokens_in;
+    out->tokens_out = base.tokens_out + live.tokens_out;
+    out->requests   = base.requests + live.requests;
+    out->errors     = base.errors + live.errors;
+    u64 t50, t99;
+    out->timed = percentiles(tracker, (u32)slot, false, &t50, &t99);
+    out->total_p50_us = t50;
+    out->total_p99_us = t99;
+    percentiles(tracker, (u32)slot, true, &out->ttfb_p50_us, &out->ttfb_p99_us);
+    return true;
 }
 
-const SeaUsageDay* sea_usage_today(const SeaUsageTracker* tracker) {
-    if (!tracker) return NULL;
+bool sea_usage_today(SeaUsageTracker* tracker, SeaUsageDay* out) {
+    if (!tracker || !out) return false;
     u32 date = today_date();
+    memset(out, 0, sizeof(*out));
+    out->date = date;
+
+    pthread_mutex_lock(&tracker->lock);
+    bool found = false;
     for (u32 i = 0; i < tracker->day_count; i++) {
-        if (tracker->days[i].date == date) return &tracker->days[i];
+        if (tracker->days[i].date == date) { *out = tracker->days[i]; found = true; }
     }
-    return NULL;
+    for (u32 i = 0; i < SEA_USAGE_PROVIDER_MAX; i++) {
+        if (!atomic_load_explicit(&tracker->slots[i].ready, memory_order_acquire)) continue;
+        SeaUsageDay live = live_totals(tracker, i);
+        const SeaUsageDay* f = &tracker->flushed[i];
+        out->tokens_in  += live.tokens_in - f->tokens_in;
+        out->tokens_out += live.tokens_out - f->tokens_out;
+        out->requests   += live.requests - f->requests;
+        out->errors     += live.errors - f->errors;
+    }
+    pthread_mutex_unlock(&tracker->lock);
+    return found || out->requests > 0;
 }
 
-u64 sea_usage_total_tokens(const SeaUsageTracker* tracker) {
-    return tracker ? tracker->total_tokens_in + tracker->total_tokens_out : 0;
+u64 sea_usage_total_tokens(SeaUsageTracker* tracker) {
+    if (!tracker) return 0;
+    u64 total = 0;
+    for (u32 i = 0; i < SEA_USAGE_PROVIDER_MAX; i++) {
+        if (!atomic_load_explicit(&tracker->slots[i].ready, memory_order_acquire)) continue;
+        SeaUsageDay live = live_totals(tracker, i);
+        pthread_mutex_lock(&tracker->lock);
+        total += tracker->base[i].tokens_in + tracker->base[i].tokens_out;
+        pthread_mutex_unlock(&tracker->lock);
+        total += live.tokens_in + live.tokens_out;
+    }
+    return total;
 }
 
-/* ── Save / Load ──────────────────────────────────────────── */
+/* ── Flush / Save / Load ──────────────────────────────────── */
+
+SeaError sea_usage_flush(SeaUsageTracker* tracker) {
+    if (!tracker) return SEA_ERR_INVALID_INPUT;
+    u32 date = today_date();
+
+    pthread_mutex_lock(&tracker->lock);
+    sqlite3_stmt* stmt = NULL;
+    if (tracker->conn &&
+        sqlite3_prepare_v2(tracker->conn,
+            "INSERT INTO usage_stats (provider, date, tokens_in, tokens_out, requests, errors)"
+            " VALUES (?, ?, ?, ?, ?, ?) ON CONFLICT(provider, date) DO UPDATE SET"
+            " tokens_in = tokens_in + excluded.tokens_in,"
+            " tokens_out = tokens_out + excluded.tokens_out,"
+            " requests = requests + excluded.requests,"
+            " errors = errors + excluded.errors",
+            -1, &stmt, NULL) == SQLITE_OK && tracker->own_conn) {
+        sqlite3_exec(tracker->conn, "BEGIN", NULL, NULL, NULL);
+    }
+
+    u32 rows = 0;
+    for (u32 i = 0; i < SEA_USAGE_PROVIDER_MAX; i++) {
+        if (!atomic_load_explicit(&tracker->slots[i].ready, memory_order_acquire)) continue;
+        SeaUsageDay live = live_totals(tracker, i);
+        SeaUsageDay* f = &tracker->flushed[i];
+        SeaUsageDay delta = {
+            .tokens_in  = live.tokens_in - f->tokens_in,
+            .tokens_out = live.tokens_out - f->tokens_out,
+            .requests   = live.requests - f->requests,
+            .errors     = live.errors - f->errors,
+        };
+        if (delta.requests == 0 && delta.tokens_in == 0 && delta.tokens_out == 0) continue;
+        *f = live;
+
+        SeaUsageDay* d = find_or_create_day(tracker, date);
+        d->tokens_in  += delta.tokens_in;
+        d->tokens_out += delta.tokens_out;
+        d->requests   += delta.requests;
+        d->errors     += delta.errors;
+
+        if (stmt) {
+            sqlite3_bind_text(stmt, 1, tracker->slots[i].name, -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt, 2, (int)date);
+            sqlite3_bind_int64(stmt, 3, (sqlite3_int64)delta.tokens_in);
+            sqlite3_bind_int64(stmt, 4, (sqlite3_int64)delta.tokens_out);
+            sqlite3_bind_int64(stmt, 5, (sqlite3_int64)delta.requests);
+            sqlite3_bind_int64(stmt, 6, (sqlite3_int64)delta.errors);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                SEA_LOG_WARN("USAGE", "Upsert failed: %s", sqlite3_errmsg(tracker->conn));
+            sqlite3_reset(stmt);
+        }
+        rows++;
+    }
+
+    if (stmt && tracker->own_conn) sqlite3_exec(tracker->conn, "COMMIT", NULL, NULL, NULL);
+    sqlite3_finalize(stmt);
+    pthread_mutex_unlock(&tracker->lock);
+
+    if (rows) SEA_LOG_DEBUG("USAGE", "Flushed %u provider rows", rows);
+    return SEA_OK;
+}
 
 SeaError sea_usage_save(SeaUsageTracker* tracker) {
     if (!tracker || !tracker->db) return SEA_ERR_CONFIG;
+    return sea_usage_flush(tracker);
+}
 
-    for (u32 i = 0; i < tracker->provider_count; i++) {
-        SeaUsageProvider* p = &tracker->providers[i];
-        u32 date = today_date();
-        char sql[512];
-        snprintf(sql, sizeof(sql),
-            "INSERT OR REPLACE INTO usage_stats "
-            "(provider, date, tokens_in, tokens_out, requests, errors) "
-            "VALUES ('%s', %u, %llu, %llu, %llu, %llu);",
-            p->name, date,
-            (unsigned long long)p->tokens_in,
-            (unsigned long long)p->tokens_out,
-            (unsigned long long)p->requests,
-            (unsigned long long)p->errors);
-        sea_db_exec(tracker->db, sql);
-    }
-
-    SEA_LOG_INFO("USAGE", "Saved usage stats (%u providers)", tracker->provider_count);
+SeaError sea_usage_load(SeaUsageTracker* tracker) {
+    if (!tracker || !tracker->conn) return SEA_ERR_CONFIG;
+    sqlite3_stmt* stmt;
+
+    pthread_mutex_lock(&tracker->lock);
+    if (sqlite3_prepare_v2(tracker->conn,
+            "SELECT provider, SUM(tokens_in), SUM(tokens_out), SUM(requests), SUM(errors)"
+            " FROM usage_stats GROUP BY provider", -1, &stmt, NULL) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* name = (const char*)sqlite3_column_text(stmt, 0);
+            i32 slot = name ? provider_slot(tracker, name, true) : -1;
+            if (slot < 0) continue;
+            tracker->base[slot] = (SeaUsageDay){
+                .tokens_in  = (u64)sqlite3_column_int64(stmt, 1),
+                .tokens_out = (u64)sqlite3_column_int64(stmt, 2),
+                .requests   = (u64)sqlite3_column_int64(stmt, 3),
+                .errors     = (u64)sqlite3_column_int64(stmt, 4),
+            };
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    tracker->day_count = 0;
+    if (sqlite3_prepare_v2(tracker->conn,
+            "SELECT date, SUM(tokens_in), SUM(tokens_out), SUM(requests), SUM(errors) FROM"
+            " (SELECT * FROM usage_stats WHERE date IN (SELECT DISTINCT date FROM usage_stats"
+            "  ORDER BY date DESC LIMIT ?)) GROUP BY date ORDER BY date",
+            -1, &stmt, NULL) == SQLITE_OK) {
+        sqlite3_bind_int(stmt, 1, SEA_USAGE_DAYS_MAX);
+        while (sqlite3_step(stmt) == SQLITE_ROW && tracker->day_count < SEA_USAGE_DAYS_MAX) {
+            tracker->days[tracker->day_count++] = (SeaUsageDay){
+                .date       = (u32)sqlite3_column_int(stmt, 0),
+                .tokens_in  = (u64)sqlite3_column_int64(stmt, 1),
+                .tokens_out = (u64)sqlite3_column_int64(stmt, 2),
+                .requests   = (u64)sqlite3_column_int64(stmt, 3),
+                .errors     = (u64)sqlite3_column_int64(stmt, 4),
+            };
+        }
+        sqlite3_finalize(stmt);
+    }
+    pthread_mutex_unlock(&tracker->lock);
+
+    SEA_LOG_INFO("USAGE", "Loaded usage stats (%u days)", tracker->day_count);
     return SEA_OK;
 }
 
-SeaError sea_usage_load(SeaUsageTracker* tracker) {
-    if (!tracker || !tracker->db) return SEA_ERR_CONFIG;
-    SEA_LOG_INFO("USAGE", "Loading usage stats from DB (lazy)");
+/* ── Periodic flush ───────────────────────────────────────── */
+
+static void* flush_thread(void* arg) {
+    SeaUsageTracker* t = (SeaUsageTracker*)arg;
+    pthread_mutex_lock(&t->lock);
+    while (t->running) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        u64 ns = (u64)ts.tv_nsec + (u64)t->flush_ms * 1000000;
+        ts.tv_sec += (time_t)(ns / 1000000000);
+        ts.tv_nsec = (long)(ns % 1000000000);
+        pthread_cond_timedwait(&t->wake, &t->lock, &ts);
+        if (!t->running) break;
+        pthread_mutex_unlock(&t->lock);
+        sea_usage_flush(t);
+        pthread_mutex_lock(&t->lock);
+    }
+    pthread_mutex_unlock(&t->lock);
+    return NULL;
+}
+
+SeaError sea_usage_start(SeaUsageTracker* tracker, u32 interval_ms) {
+    if (!tracker) return SEA_ERR_INVALID_INPUT;
+    pthread_mutex_lock(&tracker->lock);
+    if (tracker->has_thread) { pthread_mutex_unlock(&tracker->lock); return SEA_OK; }
+    tracker->flush_ms = interval_ms ? interval_ms : SEA_USAGE_FLUSH_MS;
+    tracker->running = true;
+    if (pthread_create(&tracker->thread, NULL, flush_thread, tracker) != 0) {
+        tracker->running = false;
+        pthread_mutex_unlock(&tracker->lock);
+        return SEA_ERR_IO;
+    }
+    tracker->has_thread = true;
+    pthread_mutex_unlock(&tracker->lock);
     return SEA_OK;
 }
 
 /* ── Summary ──────────────────────────────────────────────── */
 
-u32 sea_usage_summary(const SeaUsageTracker* tracker, char* buf, u32 buf_size) {
+u32 sea_usage_summary(SeaUsageTracker* tracker, char* buf, u32 buf_size) {
     if (!tracker || !buf || buf_size == 0) return 0;
 
+    SeaUsageProvider providers[SEA_USAGE_PROVIDER_MAX];
+    SeaUsageProvider all = {0};
+    u32 count = 0;
+    for (u32 i = 0; i < SEA_USAGE_PROVIDER_MAX; i++) {
+        if (!atomic_load_explicit(&tracker->slots[i].ready, memory_order_acquire)) continue;
+        SeaUsageProvider* p = &providers[count];
+        if (!sea_usage_provider(tracker, tracker->slots[i].name, p)) continue;
+        all.tokens_in += p->tokens_in;
+        all.tokens_out += p->tokens_out;
+        all.requests += p->requests;
+        all.errors += p->errors;
+        count++;
+    }
+
     int pos = 0;
     pos += snprintf(buf + pos, buf_size - (u32)pos,
         "Usage Summary:\n"
         "  Total tokens: %llu (in: %llu, out: %llu)\n"
         "  Total requests: %llu (errors: %llu)\n",
-        (unsigned long long)(tracker->total_tokens_in + tracker->total_tokens_out),
-        (unsigned long long)tracker->total_tokens_in,
-        (unsigned long long)tracker->total_tokens_out,
-        (unsigned long long)tracker->total_requests,
-        (unsigned long long)tracker->total_errors);
+        (unsigned long long)(all.tokens_in + all.tokens_out),
+        (unsigned long long)all.tokens_in,
+        (unsigned long long)all.tokens_out,
+        (unsigned long long)all.requests,
+        (unsigned long long)all.errors);
 
-    if (tracker->provider_count > 0) {
+    if (count > 0) {
         pos += snprintf(buf + pos, buf_size - (u32)pos, "\n  By Provider:\n");
-        for (u32 i = 0; i < tracker->provider_count && pos < (int)buf_size - 100; i++) {
-            const SeaUsageProvider* p = &tracker->providers[i];
+        for (u32 i = 0; i < count && pos < (int)buf_size - 200; i++) {
+            const SeaUsageProvider* p = &providers[i];
             pos += snprintf(buf + pos, buf_size - (u32)pos,
                 "    %-16s  tokens: %llu  requests: %llu  errors: %llu\n",
                 p->name,
                 (unsigned long long)(p->tokens_in + p->tokens_out),
                 (unsigned long long)p->requests,
                 (unsigned long long)p->errors);
+            if (p->timed > 0) {
+                pos += snprintf(buf + pos, buf_size - (u32)pos,
+                    "    %-16s  first byte p50 %.0fms p99 %.0fms, total p50 %.0fms p99 %.0fms\n",
+                    "",
+                    (double)p->ttfb_p50_us / 1000.0, (double)p->ttfb_p99_us / 1000.0,
+                    (double)p->total_p50_us / 1000.0, (double)p->total_p99_us / 1000.0);
+            }
         }
     }
 
-    const SeaUsageDay* today = sea_usage_today(tracker);
-    if (today) {
+    SeaUsageDay today;
+    if (sea_usage_today(tracker, &today) && pos < (int)buf_size - 100) {
         pos += snprintf(buf + pos, buf_size - (u32)pos,
             "\n  Today (%u):\n"
             "    tokens: %llu  requests: %llu  errors: %llu\n",
-            today->date,
-            (unsigned long long)(today->tokens_in + today->tokens_out),
-            (unsigned long long)today->requests,
-            (unsigned long long)today->errors);
+            today.date,
+            (unsigned long long)(today.tokens_in + today.tokens_out),
+            (unsigned long long)today.requests,
+            (unsigned long long)today.errors);
     }
 
     return (u32)pos;
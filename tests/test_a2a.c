@@ -0,0 +1,498 @@
+/*
+ * test_a2a.c — Agent-to-agent delegation tests
+ *
+ * Fake JSON-RPC peers on loopback with scripted delays and answers:
+ * first-success racing, quorum voting and early give-up, the per-peer
+ * latency histograms that rank peers, and the peer registry (discovery
+ * TTL, probe backoff, SQLite persistence).
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_a2a.h"
+#include "seaclaw/sea_db.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+SeaDb* s_db = NULL;
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-44s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+static double wall_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* ── Fake peer ───────────────────────────────────────────── */
+
+typedef struct {
+    int         fd;
+    u16         port;
+    u32         delay_ms;
+    const char* output;      /* NULL → JSON-RPC error */
+    const char* raw;         /* Sent verbatim instead, if set */
+    _Atomic u32 hits;
+    char        endpoint[64];
+    pthread_t   thread;
+} FakePeer;
+
+/* Read a whole request (headers + Content-Length body) */
+static void drain_request(int c) {
+    char buf[8192];
+    size_t got = 0;
+    for (;;) {
+        ssize_t n = recv(c, buf + got, sizeof(buf) - 1 - got, 0);
+        if (n <= 0) return;
+        got += (size_t)n;
+        buf[got] = '\0';
+        char* end = strstr(buf, "\r\n\r\n");
+        if (!end) continue;
+        char* cl = strcasestr(buf, "Content-Length:");
+        size_t want = (size_t)(end + 4 - buf) + (cl ? strtoul(cl + 15, NULL, 10) : 0);
+        if (got >= want || got >= sizeof(buf) - 1) return;
+    }
+}
+
+static void* fake_peer_main(void* arg) {
+    FakePeer* p = (FakePeer*)arg;
+    for (;;) {
+        int c = accept(p->fd, NULL, NULL);
+        if (c < 0) return NULL;
+        drain_request(c);
+        p->hits++;
+        usleep(p->delay_ms * 1000);
+
+        char body[1024], resp[2048];
+        if (p->raw)
+            snprintf(body, sizeof(body), "%s", p->raw);
+        else if (p->output)
+            snprintf(body, sizeof(body),
+                     "{\"jsonrpc\":\"2.0\",\"id\":\"t\",\"result\":{\"success\":true,\"output\":\"%s\"}}",
+                     p->output);
+        else
+            snprintf(body, sizeof(body),
+                     "{\"jsonrpc\":\"2.0\",\"id\":\"t\",\"error\":{\"code\":-1,\"message\":\"busy\"}}");
+        int n = snprintf(resp, sizeof(resp),
+                         "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                         "Content-Length: %zu\r\nConnection: close\r\n\r\n%s",
+                         strlen(body), body);
+        send(c, resp, (size_t)n, MSG_NOSIGNAL);
+        close(c);
+    }
+}
+
+static bool fake_peer_start(FakePeer* p, u32 delay_ms, const char* output) {
+    memset(p, 0, sizeof(*p));
+    p->delay_ms = delay_ms;
+    p->output = output;
+    p->fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { .sin_family = AF_INET };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t alen = sizeof(addr);
+    if (bind(p->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(p->fd, 8) != 0 ||
+        getsockname(p->fd, (struct sockaddr*)&addr, &alen) != 0) {
+        close(p->fd);
+        return false;
+    }
+    p->port = ntohs(addr.sin_port);
+    snprintf(p->endpoint, sizeof(p->endpoint), "http://127.0.0.1:%u/a2a", p->port);
+    return pthread_create(&p->thread, NULL, fake_peer_main, p) == 0;
+}
+
+static void fake_peer_stop(FakePeer* p) {
+    shutdown(p->fd, SHUT_RDWR);
+    close(p->fd);
+    pthread_join(p->thread, NULL);
+}
+
+static SeaA2aPeer as_peer(FakePeer* p, const char* name) {
+    return (SeaA2aPeer){ .name = name, .endpoint = p->endpoint };
+}
+
+static const SeaA2aRequest s_req = { .task_id = "task-1", .task_desc = "sum \"it\"\nup",
+                                     .timeout_ms = 5000 };
+
+/* ── Tests ───────────────────────────────────────────────── */
+
+static void test_single_peer(void) {
+    TEST("single peer: output unescaped, timed");
+    sea_a2a_stats_reset();
+    FakePeer fp;
+    if (!fake_peer_start(&fp, 20, "line one\\nline \\\"two\\\"")) { FAIL("listen"); return; }
+    SeaA2aPeer peer = as_peer(&fp, "solo");
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+
+    SeaA2aResult r = sea_a2a_delegate(&peer, &s_req, &arena);
+    SeaA2aPeerStats st = {0};
+    bool have = sea_a2a_peer_stats(&peer, &st);
+    fake_peer_stop(&fp);
+
+    if (!r.success || !r.verified)                          FAIL("not successful");
+    else if (strcmp(r.output, "line one\nline \"two\"") != 0) FAIL("output not unescaped");
+    else if (r.latency_us < 20000 || r.latency_ms < 20)     FAIL("latency below server delay");
+    else if (!have || st.samples != 1)                      FAIL("no histogram sample");
+    else PASS();
+    sea_arena_destroy(&arena);
+}
+
+static void test_first_success(void) {
+    TEST("first success: slow peers cancelled");
+    sea_a2a_stats_reset();
+    FakePeer slow1, slow2, fast;
+    if (!fake_peer_start(&slow1, 1500, "slow") || !fake_peer_start(&slow2, 1500, "slow") ||
+        !fake_peer_start(&fast, 30, "fast")) { FAIL("listen"); return; }
+    SeaA2aPeer peers[3] = { as_peer(&slow1, "slow-1"), as_peer(&fast, "fast"),
+                            as_peer(&slow2, "slow-2") };
+    SeaA2aPolicy policy = { .mode = SEA_A2A_FIRST_SUCCESS };
+    SeaA2aResult per[3];
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+
+    double t0 = wall_ms();
+    SeaA2aResult r = sea_a2a_delegate_multi(peers, 3, &s_req, &policy, &arena, per);
+    double elapsed = wall_ms() - t0;
+
+    SeaA2aPeerStats st;
+    bool slow_seen = sea_a2a_peer_stats(&peers[0], &st);
+    fake_peer_stop(&slow1); fake_peer_stop(&slow2); fake_peer_stop(&fast);
+
+    if (!r.success || strcmp(r.output, "fast") != 0)   FAIL("wrong winner");
+    else if (elapsed > 1000.0)                         FAIL("waited for slow peers");
+    else if (!per[1].success || per[0].success)        FAIL("per-peer results misplaced");
+    else if (!per[0].error || strcmp(per[0].error, "Cancelled") != 0) FAIL("loser not cancelled");
+    else if (slow_seen)                                FAIL("cancelled peer recorded");
+    else PASS();
+    sea_arena_destroy(&arena);
+}
+
+static void test_quorum(void) {
+    TEST("quorum: two of three agree");
+    sea_a2a_stats_reset();
+    FakePeer a, b, c;
+    if (!fake_peer_start(&a, 10, "42") || !fake_peer_start(&b, 30, "41") ||
+        !fake_peer_start(&c, 60, " 42\\n")) { FAIL("listen"); return; }
+    SeaA2aPeer peers[3] = { as_peer(&a, "a"), as_peer(&b, "b"), as_peer(&c, "c") };
+    SeaA2aPolicy policy = { .mode = SEA_A2A_QUORUM, .quorum = 2 };
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+
+    SeaA2aResult r = sea_a2a_delegate_multi(peers, 3, &s_req, &policy, &arena, NULL);
+    fake_peer_stop(&a); fake_peer_stop(&b); fake_peer_stop(&c);
+
+    if (!r.success)                 FAIL("no quorum");
+    else if (r.votes != 2)          FAIL("vote count");
+    else if (strstr(r.output, "42") == NULL) FAIL("wrong answer");
+    else PASS();
+    sea_arena_destroy(&arena);
+}
+
+static void test_quorum_unreachable(void) {
+    TEST("quorum: gives up once out of reach");
+    sea_a2a_stats_reset();
+    FakePeer a, b, slow;
+    if (!fake_peer_start(&a, 10, NULL) || !fake_peer_start(&b, 20, NULL) ||
+        !fake_peer_start(&slow, 1500, "late")) { FAIL("listen"); return; }
+    SeaA2aPeer peers[3] = { as_peer(&a, "a"), as_peer(&b, "b"), as_peer(&slow, "slow") };
+    SeaA2aPolicy policy = { .mode = SEA_A2A_QUORUM, .quorum = 2 };
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+
+    double t0 = wall_ms();
+    SeaA2aResult r = sea_a2a_delegate_multi(peers, 3, &s_req, &policy, &arena, NULL);
+    double elapsed = wall_ms() - t0;
+    fake_peer_stop(&a); fake_peer_stop(&b); fake_peer_stop(&slow);
+
+    if (r.success)                  FAIL("quorum from failures");
+    else if (!r.error || !strstr(r.error, "quorum")) FAIL("error message");
+    else if (elapsed > 1000.0)      FAIL("waited for the last peer");
+    else PASS();
+    sea_arena_destroy(&arena);
+}
+
+static void test_histogram_ranking(void) {
+    TEST("histograms: percentiles rank peers");
+    sea_a2a_stats_reset();
+    FakePeer quick, lazy, flaky;
+    if (!fake_peer_start(&quick, 5, "ok") || !fake_peer_start(&lazy, 80, "ok") ||
+        !fake_peer_start(&flaky, 5, NULL)) { FAIL("listen"); return; }
+    SeaA2aPeer peers[4] = { as_peer(&flaky, "flaky"), as_peer(&lazy, "lazy"),
+                            as_peer(&quick, "quick"),
+                            { .name = "new", .endpoint = "http://127.0.0.1:1/a2a" } };
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+    for (int i = 0; i < 5; i++) {
+        for (int p = 0; p < 3; p++) {
+            sea_arena_reset(&arena);
+            sea_a2a_delegate(&peers[p], &s_req, &arena);
+        }
+    }
+
+    SeaA2aPeerStats qs = {0}, ls = {0}, fs = {0};
+    sea_a2a_peer_stats(&peers[2], &qs);
+    sea_a2a_peer_stats(&peers[1], &ls);
+    sea_a2a_peer_stats(&peers[0], &fs);
+    u32 order[4];
+    sea_a2a_rank_peers(peers, 4, order);
+    fake_peer_stop(&quick); fake_peer_stop(&lazy); fake_peer_stop(&flaky);
+
+    if (qs.samples != 5 || ls.samples != 5)           FAIL("sample count");
+    else if (fs.failures != 5 || fs.samples != 0)     FAIL("failure count");
+    else if (ls.p50_us < 80000 || ls.p99_us < ls.p50_us) FAIL("lazy percentiles");
+    else if (qs.p90_us >= ls.p50_us)                  FAIL("quick not faster");
+    else if (order[0] != 3 || order[1] != 2 || order[2] != 1 || order[3] != 0)
+        FAIL("rank order");
+    else PASS();
+    sea_arena_destroy(&arena);
+}
+
+/* ── Registry ────────────────────────────────────────────── */
+
+#define REG_DB "/tmp/test_a2a_registry.db"
+
+static const SeaA2aRegistryPeer* find_entry(const SeaA2aRegistryPeer* e, u32 n, const char* ep) {
+    for (u32 i = 0; i < n; i++) if (strcmp(e[i].endpoint, ep) == 0) return &e[i];
+    return NULL;
+}
+
+static void test_registry_discovery_ttl(void) {
+    TEST("registry: discovery cached for the TTL");
+    FakePeer disco;
+    if (!fake_peer_start(&disco, 0, NULL)) { FAIL("listen"); return; }
+    disco.raw = "{\"agents\":["
+                "{\"name\":\"coder\",\"endpoint\":\"http://127.0.0.1:1/a\",\"capabilities\":[\"code\",\"shell\"]},"
+                "{\"name\":\"writer\",\"endpoint\":\"http://127.0.0.1:2/a\",\"capabilities\":[\"prose\"]},"
+                "{\"name\":\"broken\"}]}";
+    char url[96];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/agents", disco.port);
+    SeaA2aRegistryConfig cfg = { .discovery_url = url, .ttl_sec = 60 };
+    SeaA2aRegistry* reg = NULL;
+    sea_a2a_registry_create(&reg, NULL, &cfg);
+
+    u32 f1 = 0, f2 = 99, f3 = 0;
+    SeaError e1 = sea_a2a_registry_refresh(reg, false, &f1);
+    sea_a2a_registry_refresh(reg, false, &f2);
+    u32 hits_cached = disco.hits;
+    sea_a2a_registry_refresh(reg, true, &f3);
+
+    SeaA2aRegistryPeer snap[8];
+    u32 n = sea_a2a_registry_snapshot(reg, snap, 8);
+    const SeaA2aRegistryPeer* coder = find_entry(snap, n, "http://127.0.0.1:1/a");
+    u32 hits = disco.hits;
+    sea_a2a_registry_destroy(reg);
+    fake_peer_stop(&disco);
+
+    if (e1 != SEA_OK || f1 != 2)          FAIL("first fetch");
+    else if (f2 != 0 || hits_cached != 1) FAIL("TTL not honoured");
+    else if (f3 != 2 || hits != 2)        FAIL("force refresh");
+    else if (n != 2)                      FAIL("duplicate peers");
+    else if (!coder || coder->cap_count != 2 || strcmp(coder->caps[1], "shell") != 0)
+        FAIL("capabilities");
+    else PASS();
+}
+
+static void test_registry_discovery_sparse(void) {
+    TEST("registry: discovery without name or key");
+    FakePeer disco;
+    if (!fake_peer_start(&disco, 0, NULL)) { FAIL("listen"); return; }
+    disco.raw = "{\"agents\":["
+                "{\"endpoint\":\"http://127.0.0.1:3/a\"},"
+                "{\"name\":\"keyless\",\"endpoint\":\"http://127.0.0.1:4/a\"},"
+                "{\"endpoint\":\"http://127.0.0.1:5/a\",\"api_key\":\"k5\"}]}";
+    char url[96];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/agents", disco.port);
+    SeaA2aRegistryConfig cfg = { .discovery_url = url };
+    SeaA2aRegistry* reg = NULL;
+    sea_a2a_registry_create(&reg, NULL, &cfg);
+
+    u32 found = 0;
+    SeaError err = sea_a2a_registry_refresh(reg, true, &found);
+    SeaA2aRegistryPeer snap[8];
+    u32 n = sea_a2a_registry_snapshot(reg, snap, 8);
+    const SeaA2aRegistryPeer* bare    = find_entry(snap, n, "http://127.0.0.1:3/a");
+    const SeaA2aRegistryPeer* keyless = find_entry(snap, n, "http://127.0.0.1:4/a");
+    const SeaA2aRegistryPeer* keyed   = find_entry(snap, n, "http://127.0.0.1:5/a");
+    sea_a2a_registry_destroy(reg);
+    fake_peer_stop(&disco);
+
+    if (err != SEA_OK || found != 3 || n != 3)            FAIL("fetch");
+    else if (!bare || bare->name[0] || bare->api_key[0])  FAIL("bare peer");
+    else if (!keyless || strcmp(keyless->name, "keyless") != 0 || keyless->api_key[0])
+        FAIL("peer without key");
+    else if (!keyed || keyed->name[0] || strcmp(keyed->api_key, "k5") != 0)
+        FAIL("peer without name");
+    else PASS();
+}
+
+static void test_registry_backoff(void) {
+    TEST("registry: failing peers back off");
+    FakePeer live, gone;
+    if (!fake_peer_start(&live, 0, "ok") || !fake_peer_start(&gone, 0, "ok")) { FAIL("listen"); return; }
+    fake_peer_stop(&gone);                        /* Refuses connections */
+    SeaA2aRegistryConfig cfg = { .interval_ms = 100, .backoff_max_ms = 400,
+                                 .probe_timeout_ms = 1000 };
+    SeaA2aRegistry* reg = NULL;
+    sea_a2a_registry_create(&reg, NULL, &cfg);
+    SeaA2aPeer a = as_peer(&live, "live"), b = as_peer(&gone, "gone");
+    sea_a2a_registry_add(reg, &a, NULL, 0);
+    sea_a2a_registry_add(reg, &b, NULL, 0);
+
+    u32 first = sea_a2a_registry_probe(reg);
+    u32 again = sea_a2a_registry_probe(reg);     /* Nobody due yet */
+    SeaA2aRegistryPeer snap[4];
+    u32 n = sea_a2a_registry_snapshot(reg, snap, 4);
+    const SeaA2aRegistryPeer* pl = find_entry(snap, n, live.endpoint);
+    const SeaA2aRegistryPeer* pg = find_entry(snap, n, gone.endpoint);
+    bool round1 = pl && pg && pl->healthy && !pg->healthy && pg->fail_streak == 1 &&
+                  pg->next_probe_ms - pl->next_probe_ms >= 90;      /* 200ms vs 100ms */
+
+    /* Three more failures, each delay at the 400ms cap */
+    u64 gaps[3];
+    for (int i = 0; i < 3; i++) {
+        n = sea_a2a_registry_snapshot(reg, snap, 4);
+        pg = find_entry(snap, n, gone.endpoint);
+        while (wall_ms() < (double)pg->next_probe_ms + 5) usleep(5000);
+        sea_a2a_registry_probe(reg);
+        n = sea_a2a_registry_snapshot(reg, snap, 4);
+        const SeaA2aRegistryPeer* after = find_entry(snap, n, gone.endpoint);
+        gaps[i] = after->next_probe_ms - (u64)wall_ms();
+    }
+    n = sea_a2a_registry_snapshot(reg, snap, 4);
+    pg = find_entry(snap, n, gone.endpoint);
+    pl = find_entry(snap, n, live.endpoint);
+
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaA2aPeer picked[4];
+    u32 np = sea_a2a_registry_pick(reg, NULL, picked, 4, &arena);
+    sea_a2a_registry_destroy(reg);
+    fake_peer_stop(&live);
+
+    if (first != 2 || again != 0)                 FAIL("probe scheduling");
+    else if (!round1)                             FAIL("first round");
+    else if (pg->fail_streak != 4 || pg->probe_failures != 4) FAIL("failure count");
+    else if (gaps[0] < 300 || gaps[0] > 420 || gaps[1] < 300 || gaps[2] > 420)
+        FAIL("backoff delays");
+    else if (pl->probes < 2 || pl->latency_us == 0) FAIL("live peer not re-probed");
+    else if (np != 1 || strcmp(picked[0].endpoint, live.endpoint) != 0) FAIL("pick");
+    else PASS();
+    sea_arena_destroy(&arena);
+}
+
+static void test_registry_persist(void) {
+    TEST("registry: restarts warm from SQLite");
+    unlink(REG_DB);
+    FakePeer peer, disco;
+    if (!fake_peer_start(&peer, 0, "ok") || !fake_peer_start(&disco, 0, NULL)) { FAIL("listen"); return; }
+    char raw[256], url[96];
+    snprintf(raw, sizeof(raw),
+             "{\"agents\":[{\"name\":\"scout\",\"endpoint\":\"%s\",\"api_key\":\"k1\","
+             "\"capabilities\":[\"search\"]}]}", peer.endpoint);
+    disco.raw = raw;
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/agents", disco.port);
+    SeaA2aRegistryConfig cfg = { .discovery_url = url };
+
+    SeaDb* db = NULL;
+    if (sea_db_open(&db, REG_DB) != SEA_OK) { FAIL("db open"); return; }
+    SeaA2aRegistry* reg = NULL;
+    sea_a2a_registry_create(&reg, db, &cfg);
+    sea_a2a_registry_refresh(reg, false, NULL);
+    sea_a2a_registry_probe(reg);
+    sea_a2a_registry_destroy(reg);
+    sea_db_close(db);
+
+    /* Second run: no discovery fetch, peer healthy before any probe */
+    sea_db_open(&db, REG_DB);
+    sea_a2a_registry_create(&reg, db, &cfg);
+    u32 found = 99;
+    sea_a2a_registry_refresh(reg, false, &found);
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaA2aPeer picked[2];
+    u32 np = sea_a2a_registry_pick(reg, "search", picked, 2, &arena);
+    u32 none = sea_a2a_registry_pick(reg, "prose", picked + 1, 1, &arena);
+    SeaA2aRegistryPeer snap[2];
+    u32 n = sea_a2a_registry_snapshot(reg, snap, 2);
+    sea_a2a_registry_destroy(reg);
+    sea_db_close(db);
+    u32 hits = disco.hits;
+    fake_peer_stop(&peer); fake_peer_stop(&disco);
+    unlink(REG_DB);
+
+    if (found != 0 || hits != 1)                     FAIL("discovery refetched");
+    else if (np != 1 || none != 0)                   FAIL("capability pick");
+    else if (!picked[0].api_key || strcmp(picked[0].api_key, "k1") != 0) FAIL("api key");
+    else if (n != 1 || snap[0].probes != 1 || snap[0].latency_us == 0) FAIL("stats lost");
+    else PASS();
+    sea_arena_destroy(&arena);
+}
+
+static void test_registry_background(void) {
+    TEST("registry: background thread probes");
+    FakePeer peer;
+    if (!fake_peer_start(&peer, 0, "ok")) { FAIL("listen"); return; }
+    SeaA2aRegistryConfig cfg = { .interval_ms = 50 };
+    SeaA2aRegistry* reg = NULL;
+    sea_a2a_registry_create(&reg, NULL, &cfg);
+    sea_a2a_registry_start(reg);
+    SeaA2aPeer p = as_peer(&peer, "bg");
+    sea_a2a_registry_add(reg, &p, NULL, 0);       /* Wakes the thread */
+    usleep(300 * 1000);
+
+    SeaA2aRegistryPeer snap[1];
+    sea_a2a_registry_snapshot(reg, snap, 1);
+    sea_a2a_registry_report(reg, peer.endpoint, false);
+    SeaA2aRegistryPeer after[1];
+    sea_a2a_registry_snapshot(reg, after, 1);
+    sea_a2a_registry_destroy(reg);
+    fake_peer_stop(&peer);
+
+    if (snap[0].probes < 3 || !snap[0].healthy) FAIL("not probed on interval");
+    else if (after[0].healthy || after[0].fail_streak != 1) FAIL("report ignored");
+    else PASS();
+}
+
+/* ── Main ────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_ERROR);
+    printf("\n  \033[1mSea-Claw A2A Delegation Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════════\n\n");
+
+    test_single_peer();
+    test_first_success();
+    test_quorum();
+    test_quorum_unreachable();
+    test_histogram_ranking();
+    test_registry_discovery_ttl();
+    test_registry_discovery_sparse();
+    test_registry_backoff();
+    test_registry_persist();
+    test_registry_background();
+
+    printf("\n  ────────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
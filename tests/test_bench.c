@@ -16,6 +16,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/resource.h>
 
 /* ── Timing helpers ───────────────────────────────────────── */
@@ -43,16 +45,20 @@ const SeaTool* sea_tool_by_id(u32 id) { (void)id; return NULL; }
 
 /* ── Benchmarks ───────────────────────────────────────────── */
 
+/* Named, and kept until the end so the arena profile can show them */
+static SeaArena s_alloc_arena;
+static SeaArena s_json_arena;
+
 static void bench_arena(void) {
     printf("  \033[1mArena Allocation\033[0m\n");
 
     /* 1M allocations */
-    SeaArena arena;
-    sea_arena_create(&arena, 64 * 1024 * 1024);
+    SeaArena* arena = &s_alloc_arena;
+    sea_arena_create_named(arena, "bench.alloc", 64 * 1024 * 1024);
 
     double t0 = now_ms();
     for (int i = 0; i < 1000000; i++) {
-        sea_arena_alloc(&arena, 64, 8);
+        sea_arena_alloc(arena, 64, 8);
     }
     double t1 = now_ms();
     printf("    1M allocs (64B each):   %.1f ms  (%.0f ns/alloc)\n",
@@ -61,13 +67,11 @@ static void bench_arena(void) {
     /* Reset speed */
     t0 = now_ms();
     for (int i = 0; i < 1000000; i++) {
-        sea_arena_reset(&arena);
+        sea_arena_reset(arena);
     }
     t1 = now_ms();
     printf("    1M resets:              %.1f ms  (%.0f ns/reset)\n",
            t1 - t0, (t1 - t0) * 1000.0);
-
-    sea_arena_destroy(&arena);
 }
 
 static void bench_json(void) {
@@ -79,14 +83,14 @@ static void bench_json(void) {
         "\"config\":{\"arena_mb\":16,\"provider\":\"openrouter\"}}";
     SeaSlice json = { .data = (const u8*)json_str, .len = (u32)strlen(json_str) };
 
-    SeaArena arena;
-    sea_arena_create(&arena, 4 * 1024 * 1024);
+    SeaArena* arena = &s_json_arena;
+    sea_arena_create_named(arena, "bench.json", 4 * 1024 * 1024);
 
     /* Warmup */
     for (int i = 0; i < 100; i++) {
         SeaJsonValue root;
-        sea_json_parse(json, &arena, &root);
-        sea_arena_reset(&arena);
+        sea_json_parse(json, arena, &root);
+        sea_arena_reset(arena);
     }
 
     /* Benchmark */
@@ -94,15 +98,13 @@ static void bench_json(void) {
     int iters = 100000;
     for (int i = 0; i < iters; i++) {
         SeaJsonValue root;
-        sea_json_parse(json, &arena, &root);
-        sea_arena_reset(&arena);
+        sea_json_parse(json, arena, &root);
+        sea_arena_reset(arena);
     }
     double t1 = now_ms();
     double per = (t1 - t0) * 1000.0 / (double)iters;
     printf("    100K parses (~180B):    %.1f ms  (%.1f us/parse)\n",
            t1 - t0, per / 1000.0);
-
-    sea_arena_destroy(&arena);
 }
 
 static void bench_shield(void) {
@@ -142,6 +144,26 @@ static void bench_shield(void) {
            t1 - t0, per);
 }
 
+static void bench_log(void) {
+    printf("  \033[1mLogging\033[0m\n");
+
+    /* ERROR passes the runtime filter; lines go to /dev/null */
+    int null_fd = open("/dev/null", O_WRONLY);
+    SeaLogConfig cfg = { .ring_size = 1024 * 1024, .fd_out = null_fd, .fd_err = null_fd };
+    sea_log_start(&cfg);
+    int iters = 100000;
+    double t0 = now_ms();
+    for (int i = 0; i < iters; i++) {
+        SEA_LOG_ERROR("BENCH", "Published message %d to topic %s", i, "agent.inbound");
+    }
+    double t1 = now_ms();
+    sea_log_stop();
+    close(null_fd);
+    printf("    100K async lines:       %.1f ms  (%.0f ns/line, %llu dropped)\n",
+           t1 - t0, (t1 - t0) * 1e6 / (double)iters,
+           (unsigned long long)sea_log_dropped());
+}
+
 static void bench_memory(void) {
     printf("  \033[1mMemory Usage\033[0m\n");
     long rss = peak_rss_kb();
@@ -149,6 +171,22 @@ static void bench_memory(void) {
     printf("    Binary size:            ~3 MB (debug), ~1.5 MB (release)\n");
 }
 
+static void bench_arena_profile(void) {
+    printf("  \033[1mArena Profile\033[0m\n");
+    char report[4096];
+    u32 len = sea_arena_report(report, sizeof(report));
+    /* Indent each line to match the rest of the report */
+    const char* line = report;
+    while (line < report + len) {
+        const char* nl = memchr(line, '\n', (size_t)(report + len - line));
+        int n = nl ? (int)(nl - line) : (int)(report + len - line);
+        printf("    %.*s\n", n, line);
+        line += n + 1;
+    }
+    sea_arena_destroy(&s_alloc_arena);
+    sea_arena_destroy(&s_json_arena);
+}
+
 /* ── Main ─────────────────────────────────────────────────── */
 
 int main(void) {
@@ -170,7 +208,11 @@ int main(void) {
     printf("\n");
     bench_shield();
     printf("\n");
+    bench_log();
+    printf("\n");
     bench_memory();
+    printf("\n");
+    bench_arena_profile();
 
     double total = now_ms() - start;
     printf("\n  \033[1mTotal benchmark time:\033[0m %.0f ms\n", total);
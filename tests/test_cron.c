@@ -1,8 +1,10 @@
 /*
  * test_cron.c — Cron Scheduler Tests
  *
- * Tests schedule parsing, job CRUD, tick execution,
- * pause/resume, one-shot jobs, and DB persistence.
+ * Tests schedule parsing, the cron compiler and next-fire evaluation,
+ * job CRUD, tick execution, pause/resume, one-shot jobs, the deadline
+ * heap and scheduler thread, the worker pool (concurrency, timeouts,
+ * overlap policies), and DB persistence.
  */
 
 #include "seaclaw/sea_cron.h"
@@ -10,7 +12,9 @@
 #include "seaclaw/sea_db.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 /* Stubs for symbols referenced by sea_cron.o → sea_tool_exec */
@@ -26,6 +30,15 @@ SeaError sea_tool_exec(const char* n, SeaSlice a, SeaArena* ar, SeaSlice* o) {
     return SEA_OK;
 }
 
+/* The scheduler's own row for id. White-box: only for forcing a
+ * deadline before any thread runs; everything else reads a copy. */
+static SeaCronJob* job_slot(SeaCronScheduler* s, i32 id) {
+    for (u32 i = 0; i < s->count; i++) {
+        if (s->jobs[i].id == id) return &s->jobs[i];
+    }
+    return NULL;
+}
+
 static int s_pass = 0;
 static int s_fail = 0;
 
@@ -90,6 +103,122 @@ static void test_parse_cron(void) {
     PASS();
 }
 
+/* ── Test: Cron compiler ──────────────────────────────────── */
+
+static void test_compile_fields(void) {
+    TEST("compile_fields");
+    SeaCronExpr e;
+    if (sea_cron_compile("30 9 * * 1-5", &e) != SEA_OK) { FAIL("compile failed"); return; }
+    if (e.minutes != (1ULL << 30)) { FAIL("minutes mask"); return; }
+    if (e.hours != (1u << 9)) { FAIL("hours mask"); return; }
+    if (e.weekdays != 0x3E) { FAIL("weekday mask"); return; }
+    if (e.months != 0x1FFE) { FAIL("month mask"); return; }
+    if (!(e.flags & SEA_CRON_DOM_STAR) || (e.flags & SEA_CRON_DOW_STAR)) { FAIL("flags"); return; }
+
+    if (sea_cron_compile("*/20 9-17/4 1,15 JAN,jul sun,7", &e) != SEA_OK) { FAIL("names"); return; }
+    if (e.minutes != ((1ULL << 0) | (1ULL << 20) | (1ULL << 40))) { FAIL("step mask"); return; }
+    if (e.hours != ((1u << 9) | (1u << 13) | (1u << 17))) { FAIL("range step"); return; }
+    if (e.days != ((1u << 1) | (1u << 15))) { FAIL("list"); return; }
+    if (e.months != ((1u << 1) | (1u << 7))) { FAIL("month names"); return; }
+    if (e.weekdays != 1) { FAIL("sunday as 0 and 7"); return; }
+
+    SeaCronExpr daily;
+    sea_cron_compile("0 0 * * *", &e);
+    if (sea_cron_compile("@daily", &daily) != SEA_OK ||
+        memcmp(&e, &daily, sizeof(e)) != 0) { FAIL("@daily"); return; }
+    PASS();
+}
+
+static void test_compile_invalid(void) {
+    TEST("compile_invalid");
+    static const char* bad[] = {
+        "60 * * * *", "* 24 * * *", "* * 0 * *", "* * * 13 *", "* * * * 8",
+        "* * * *", "* * * * * *", "5-1 * * * *", "*/0 * * * *", "1,,2 * * * *",
+        "a * * * *", "* * * foo *", "@sometimes", "",
+    };
+    SeaCronExpr e;
+    for (u32 i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        if (sea_cron_compile(bad[i], &e) == SEA_OK) { FAIL(bad[i]); return; }
+    }
+    SeaSchedType type;
+    u64 interval, next;
+    if (sea_cron_parse_schedule("61 * * * *", &type, &interval, &next) == SEA_OK) {
+        FAIL("parse_schedule accepted bad expr"); return;
+    }
+    PASS();
+}
+
+/* Epoch seconds for a UTC date (tests run with TZ=UTC). */
+static u64 utc(int y, int mo, int d, int h, int mi) {
+    struct tm tm = { 0 };
+    tm.tm_year = y - 1900; tm.tm_mon = mo - 1; tm.tm_mday = d;
+    tm.tm_hour = h; tm.tm_min = mi;
+    return (u64)timegm(&tm);
+}
+
+static bool next_is(const char* expr, u64 after, u64 want) {
+    SeaCronExpr e;
+    u64 got = 0;
+    if (sea_cron_compile(expr, &e) != SEA_OK) return false;
+    if (sea_cron_next(&e, after, &got) != SEA_OK) return false;
+    return got == want;
+}
+
+static void test_next_fire(void) {
+    TEST("next_fire_exact");
+    /* Friday 2026-10-16 10:00 → Monday 09:30 */
+    if (!next_is("30 9 * * 1-5", utc(2026, 10, 16, 10, 0), utc(2026, 10, 19, 9, 30))) {
+        FAIL("weekday skip"); return;
+    }
+    /* Strictly after: on the minute itself moves to the next slot */
+    if (!next_is("*/15 * * * *", utc(2026, 10, 16, 10, 15), utc(2026, 10, 16, 10, 30))) {
+        FAIL("strictly after"); return;
+    }
+    /* Both day fields restricted: the 13th OR a Friday */
+    if (!next_is("0 0 13 * 5", utc(2026, 10, 10, 0, 0), utc(2026, 10, 13, 0, 0))) {
+        FAIL("dom or dow (13th)"); return;
+    }
+    if (!next_is("0 0 13 * 5", utc(2026, 10, 13, 0, 0), utc(2026, 10, 16, 0, 0))) {
+        FAIL("dom or dow (Friday)"); return;
+    }
+    /* Month and year rollover, leap day */
+    if (!next_is("0 12 31 * *", utc(2026, 10, 31, 13, 0), utc(2026, 12, 31, 12, 0))) {
+        FAIL("skip 30-day month"); return;
+    }
+    if (!next_is("0 0 29 2 *", utc(2026, 10, 18, 0, 0), utc(2028, 2, 29, 0, 0))) {
+        FAIL("leap day"); return;
+    }
+    if (!next_is("@yearly", utc(2026, 10, 18, 0, 0), utc(2027, 1, 1, 0, 0))) {
+        FAIL("@yearly"); return;
+    }
+
+    SeaCronExpr e;
+    u64 next;
+    sea_cron_compile("0 0 30 2 *", &e);
+    if (sea_cron_next(&e, utc(2026, 1, 1, 0, 0), &next) != SEA_ERR_NOT_FOUND) {
+        FAIL("impossible date"); return;
+    }
+    PASS();
+}
+
+static void test_parse_cron_weekday(void) {
+    TEST("parse_cron_weekday_interval");
+    SeaSchedType type;
+    u64 interval, next;
+    if (sea_cron_parse_schedule("30 9 * * 1-5", &type, &interval, &next) != SEA_OK) {
+        FAIL("parse failed"); return;
+    }
+    /* Next two runs are a day or a weekend apart — never "60 s" */
+    if (interval != 86400 && interval != 3 * 86400) { FAIL("interval"); return; }
+    struct tm tm;
+    time_t t = (time_t)next;
+    gmtime_r(&t, &tm);
+    if (tm.tm_hour != 9 || tm.tm_min != 30 || tm.tm_wday == 0 || tm.tm_wday == 6) {
+        FAIL("next_run not a weekday 09:30"); return;
+    }
+    PASS();
+}
+
 /* ── Test: Init and Destroy ───────────────────────────────── */
 
 static void test_init_destroy(void) {
@@ -114,12 +243,12 @@ static void test_add_job(void) {
     if (id < 0) { FAIL("add returned -1"); sea_cron_destroy(&sched); return; }
     if (sea_cron_count(&sched) != 1) { FAIL("count != 1"); sea_cron_destroy(&sched); return; }
 
-    SeaCronJob* job = sea_cron_get(&sched, id);
-    if (!job) { FAIL("get returned NULL"); sea_cron_destroy(&sched); return; }
-    if (strcmp(job->name, "heartbeat") != 0) { FAIL("wrong name"); sea_cron_destroy(&sched); return; }
-    if (job->type != SEA_CRON_SHELL) { FAIL("wrong type"); sea_cron_destroy(&sched); return; }
-    if (job->state != SEA_CRON_ACTIVE) { FAIL("wrong state"); sea_cron_destroy(&sched); return; }
-    if (job->interval_sec != 30) { FAIL("wrong interval"); sea_cron_destroy(&sched); return; }
+    SeaCronJob job;
+    if (!sea_cron_get(&sched, id, &job)) { FAIL("get found nothing"); sea_cron_destroy(&sched); return; }
+    if (strcmp(job.name, "heartbeat") != 0) { FAIL("wrong name"); sea_cron_destroy(&sched); return; }
+    if (job.type != SEA_CRON_SHELL) { FAIL("wrong type"); sea_cron_destroy(&sched); return; }
+    if (job.state != SEA_CRON_ACTIVE) { FAIL("wrong state"); sea_cron_destroy(&sched); return; }
+    if (job.interval_sec != 30) { FAIL("wrong interval"); sea_cron_destroy(&sched); return; }
 
     sea_cron_destroy(&sched);
     PASS();
@@ -140,7 +269,8 @@ static void test_remove_job(void) {
     if (sea_cron_count(&sched) != 1) { FAIL("count != 1"); sea_cron_destroy(&sched); return; }
 
     /* Removed job should not be found */
-    if (sea_cron_get(&sched, id1) != NULL) { FAIL("job1 still found"); sea_cron_destroy(&sched); return; }
+    SeaCronJob job;
+    if (sea_cron_get(&sched, id1, &job)) { FAIL("job1 still found"); sea_cron_destroy(&sched); return; }
 
     sea_cron_destroy(&sched);
     PASS();
@@ -156,11 +286,13 @@ static void test_pause_resume(void) {
     i32 id = sea_cron_add(&sched, "pauser", SEA_CRON_SHELL, "@every 10s", "echo p", NULL);
 
     sea_cron_pause(&sched, id);
-    SeaCronJob* job = sea_cron_get(&sched, id);
-    if (job->state != SEA_CRON_PAUSED) { FAIL("not paused"); sea_cron_destroy(&sched); return; }
+    SeaCronJob job;
+    sea_cron_get(&sched, id, &job);
+    if (job.state != SEA_CRON_PAUSED) { FAIL("not paused"); sea_cron_destroy(&sched); return; }
 
     sea_cron_resume(&sched, id);
-    if (job->state != SEA_CRON_ACTIVE) { FAIL("not resumed"); sea_cron_destroy(&sched); return; }
+    sea_cron_get(&sched, id, &job);
+    if (job.state != SEA_CRON_ACTIVE) { FAIL("not resumed"); sea_cron_destroy(&sched); return; }
 
     sea_cron_destroy(&sched);
     PASS();
@@ -176,13 +308,14 @@ static void test_tick_execution(void) {
     /* Add a job with next_run in the past (should fire immediately) */
     i32 id = sea_cron_add(&sched, "immediate", SEA_CRON_TOOL,
                            "@every 1s", "echo", "hello");
-    SeaCronJob* job = sea_cron_get(&sched, id);
-    job->next_run = 1; /* Set to epoch 1 = way in the past */
+    job_slot(&sched, id)->next_run = 1; /* Set to epoch 1 = way in the past */
 
     u32 executed = sea_cron_tick(&sched);
     if (executed != 1) { FAIL("expected 1 execution"); sea_cron_destroy(&sched); return; }
-    if (job->run_count != 1) { FAIL("run_count != 1"); sea_cron_destroy(&sched); return; }
-    if (job->last_run == 0) { FAIL("last_run not set"); sea_cron_destroy(&sched); return; }
+    SeaCronJob job;
+    sea_cron_get(&sched, id, &job);
+    if (job.run_count != 1) { FAIL("run_count != 1"); sea_cron_destroy(&sched); return; }
+    if (job.last_run == 0) { FAIL("last_run not set"); sea_cron_destroy(&sched); return; }
 
     /* Next tick should NOT execute (next_run is in the future now) */
     executed = sea_cron_tick(&sched);
@@ -201,15 +334,16 @@ static void test_oneshot(void) {
 
     i32 id = sea_cron_add(&sched, "once", SEA_CRON_TOOL,
                            "@once 1s", "echo", "fire");
-    SeaCronJob* job = sea_cron_get(&sched, id);
-    job->next_run = 1; /* Force immediate */
+    job_slot(&sched, id)->next_run = 1; /* Force immediate */
 
     sea_cron_tick(&sched);
-    if (job->state != SEA_CRON_COMPLETED) { FAIL("not completed"); sea_cron_destroy(&sched); return; }
-    if (job->run_count != 1) { FAIL("run_count != 1"); sea_cron_destroy(&sched); return; }
+    SeaCronJob job;
+    sea_cron_get(&sched, id, &job);
+    if (job.state != SEA_CRON_COMPLETED) { FAIL("not completed"); sea_cron_destroy(&sched); return; }
+    if (job.run_count != 1) { FAIL("run_count != 1"); sea_cron_destroy(&sched); return; }
 
     /* Should not fire again */
-    job->next_run = 1;
+    job_slot(&sched, id)->next_run = 1;
     u32 executed = sea_cron_tick(&sched);
     if (executed != 0) { FAIL("fired again"); sea_cron_destroy(&sched); return; }
 
@@ -226,13 +360,14 @@ static void test_paused_no_exec(void) {
 
     i32 id = sea_cron_add(&sched, "paused", SEA_CRON_TOOL,
                            "@every 1s", "echo", "nope");
-    SeaCronJob* job = sea_cron_get(&sched, id);
-    job->next_run = 1;
+    job_slot(&sched, id)->next_run = 1;
     sea_cron_pause(&sched, id);
 
     u32 executed = sea_cron_tick(&sched);
     if (executed != 0) { FAIL("paused job executed"); sea_cron_destroy(&sched); return; }
-    if (job->run_count != 0) { FAIL("run_count != 0"); sea_cron_destroy(&sched); return; }
+    SeaCronJob job;
+    sea_cron_get(&sched, id, &job);
+    if (job.run_count != 0) { FAIL("run_count != 0"); sea_cron_destroy(&sched); return; }
 
     sea_cron_destroy(&sched);
     PASS();
@@ -249,13 +384,172 @@ static void test_list_jobs(void) {
     sea_cron_add(&sched, "j2", SEA_CRON_TOOL, "@every 20s", "echo", "2");
     sea_cron_add(&sched, "j3", SEA_CRON_SHELL, "@once 5s", "echo 3", NULL);
 
-    SeaCronJob* jobs[10];
+    SeaCronJob jobs[10];
     u32 count = sea_cron_list(&sched, jobs, 10);
     if (count != 3) { FAIL("count != 3"); sea_cron_destroy(&sched); return; }
-    if (strcmp(jobs[0]->name, "j1") != 0) { FAIL("wrong job[0]"); sea_cron_destroy(&sched); return; }
-    if (strcmp(jobs[2]->name, "j3") != 0) { FAIL("wrong job[2]"); sea_cron_destroy(&sched); return; }
+    if (strcmp(jobs[0].name, "j1") != 0) { FAIL("wrong job[0]"); sea_cron_destroy(&sched); return; }
+    if (strcmp(jobs[2].name, "j3") != 0) { FAIL("wrong job[2]"); sea_cron_destroy(&sched); return; }
+
+    sea_cron_destroy(&sched);
+    PASS();
+}
+
+/* ── Test: Deadline heap ──────────────────────────────────── */
+
+static bool heap_ok(SeaCronScheduler* s) {
+    u64 min = UINT64_MAX;
+    u32 active = 0;
+    for (u32 i = 0; i < s->count; i++) {
+        if (s->jobs[i].state != SEA_CRON_ACTIVE) continue;
+        active++;
+        if (s->jobs[i].next_run < min) min = s->jobs[i].next_run;
+    }
+    if (active != s->heap_len) return false;
+    return active == 0 || s->jobs[s->heap[0]].next_run == min;
+}
+
+static void test_heap_many_jobs(void) {
+    TEST("heap_many_jobs");
+    SeaCronScheduler sched;
+    sea_cron_init(&sched, NULL, NULL);
+
+    char sched_str[32];
+    for (u32 i = 0; i < 2000; i++) {
+        snprintf(sched_str, sizeof(sched_str), "@every %us", 10 + (i * 7919) % 5000);
+        if (sea_cron_add(&sched, "bulk", SEA_CRON_TOOL, sched_str, "echo", "x") < 0) {
+            FAIL("add failed"); sea_cron_destroy(&sched); return;
+        }
+    }
+    if (sea_cron_count(&sched) != 2000 || !heap_ok(&sched)) {
+        FAIL("heap after add"); sea_cron_destroy(&sched); return;
+    }
+
+    i32 top = sched.jobs[sched.heap[0]].id;
+    sea_cron_pause(&sched, top);
+    sea_cron_remove(&sched, 1000);
+    sea_cron_remove(&sched, 3);
+    if (!heap_ok(&sched) || sched.jobs[sched.heap[0]].id == top) {
+        FAIL("heap after pause/remove"); sea_cron_destroy(&sched); return;
+    }
+    sea_cron_resume(&sched, top);
+    if (!heap_ok(&sched) || sched.heap_len != 1998) {
+        FAIL("heap after resume"); sea_cron_destroy(&sched); return;
+    }
+
+    /* IDs are never reused after a remove */
+    i32 id = sea_cron_add(&sched, "late", SEA_CRON_TOOL, "@every 1h", "echo", "x");
+    if (id != 2001) { FAIL("id reused"); sea_cron_destroy(&sched); return; }
+
+    sea_cron_destroy(&sched);
+    PASS();
+}
+
+/* ── Test: Scheduler thread fires on the timerfd ──────────── */
+
+static void test_thread_fires(void) {
+    TEST("thread_fires_due_job");
+    SeaCronScheduler sched;
+    sea_cron_init(&sched, NULL, NULL);
+    if (sea_cron_start(&sched) != SEA_OK) { FAIL("start failed"); sea_cron_destroy(&sched); return; }
+
+    i32 id = sea_cron_add(&sched, "soon", SEA_CRON_TOOL, "@once 1s", "echo", "tick");
+    SeaCronJob job;
+    sea_cron_get(&sched, id, &job);
+    for (int i = 0; i < 40 && job.state != SEA_CRON_COMPLETED; i++) {
+        usleep(100 * 1000);
+        sea_cron_get(&sched, id, &job);
+    }
+
+    if (job.state != SEA_CRON_COMPLETED) { FAIL("job did not fire"); sea_cron_destroy(&sched); return; }
+    if (job.run_count != 1) { FAIL("run_count != 1"); sea_cron_destroy(&sched); return; }
+
+    sea_cron_destroy(&sched);
+    PASS();
+}
+
+/* ── Test: Worker pool runs jobs concurrently, kills overruns ── */
+
+static u64 test_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000 + (u64)ts.tv_nsec / 1000000;
+}
+
+static void test_pool_concurrency_timeout(void) {
+    TEST("pool_concurrency_and_timeout");
+    SeaCronScheduler sched;
+    sea_cron_init(&sched, NULL, NULL);
+    sched.max_workers = 4;
+    sea_cron_start(&sched);
+
+    i32 ids[3];
+    for (int i = 0; i < 3; i++) {
+        ids[i] = sea_cron_add(&sched, "sleeper", SEA_CRON_SHELL, "@once 1s", "sleep 1", NULL);
+    }
+    i32 slow = sea_cron_add(&sched, "stuck", SEA_CRON_SHELL, "@once 1s", "sleep 30", NULL);
+    sea_cron_set_policy(&sched, slow, SEA_CRON_OVERLAP_SKIP, 1);
+
+    u64 start = test_ms();
+    bool done = false;
+    SeaCronJob s, j;
+    while (!done && test_ms() - start < 6000) {
+        usleep(50 * 1000);
+        done = sea_cron_get(&sched, slow, &s) && s.run_count == 1;
+        for (int i = 0; i < 3; i++) done = done && sea_cron_get(&sched, ids[i], &j) && j.run_count == 1;
+    }
+    u64 elapsed = test_ms() - start;
+    if (!done) { FAIL("runs did not finish"); sea_cron_destroy(&sched); return; }
+
+    /* Serial would need 3 s of sleeps plus the 1 s timeout */
+    if (elapsed > 3500) { FAIL("runs were not concurrent"); sea_cron_destroy(&sched); return; }
+    sea_cron_get(&sched, slow, &s);
+    if (s.fail_count != 1) { FAIL("timeout not recorded"); sea_cron_destroy(&sched); return; }
+    if (s.last_duration_ms < 900 || s.last_duration_ms > 2000) {
+        FAIL("timed-out run duration"); sea_cron_destroy(&sched); return;
+    }
+    sea_cron_get(&sched, ids[0], &j);
+    if (j.fail_count != 0 || j.last_duration_ms < 900) {
+        FAIL("sleeper run"); sea_cron_destroy(&sched); return;
+    }
+
+    sea_cron_destroy(&sched);
+    PASS();
+}
+
+/* ── Test: Overlap policies ───────────────────────────────── */
+
+static void test_overlap_policies(void) {
+    TEST("overlap_skip_queue_allow");
+    SeaCronScheduler sched;
+    sea_cron_init(&sched, NULL, NULL);
+    sched.max_workers = 8;
+    sea_cron_start(&sched);
+
+    /* Each run takes ~2.5 s and the job comes due every second */
+    i32 skip  = sea_cron_add(&sched, "skip",  SEA_CRON_SHELL, "@every 1s", "sleep 2.5", NULL);
+    i32 queue = sea_cron_add(&sched, "queue", SEA_CRON_SHELL, "@every 1s", "sleep 2.5", NULL);
+    i32 allow = sea_cron_add(&sched, "allow", SEA_CRON_SHELL, "@every 1s", "sleep 2.5", NULL);
+    sea_cron_set_policy(&sched, queue, SEA_CRON_OVERLAP_QUEUE, 0);
+    sea_cron_set_policy(&sched, allow, SEA_CRON_OVERLAP_ALLOW, 0);
+
+    u32 max_skip = 0, max_allow = 0;
+    bool saw_queued = false;
+    SeaCronJob s, q, a;
+    u64 start = test_ms();
+    while (test_ms() - start < 3500) {
+        usleep(20 * 1000);
+        sea_cron_get(&sched, skip, &s);
+        sea_cron_get(&sched, queue, &q);
+        sea_cron_get(&sched, allow, &a);
+        if (s.in_flight > max_skip) max_skip = s.in_flight;
+        if (a.in_flight > max_allow) max_allow = a.in_flight;
+        if (q.queued) saw_queued = true;
+    }
 
+    sea_cron_get(&sched, skip, &s);
+    bool ok = max_skip == 1 && s.skip_count >= 1 && max_allow >= 2 && saw_queued;
     sea_cron_destroy(&sched);
+    if (!ok) { FAIL("policy not honoured"); return; }
     PASS();
 }
 
@@ -286,6 +580,8 @@ static void test_db_persist(void) {
 
 int main(void) {
     sea_log_init(SEA_LOG_WARN);
+    setenv("TZ", "UTC", 1);
+    tzset();
 
     printf("\n\033[1m=== Sea-Claw Cron Tests ===\033[0m\n\n");
 
@@ -294,6 +590,10 @@ int main(void) {
     test_parse_every_hours();
     test_parse_once();
     test_parse_cron();
+    test_compile_fields();
+    test_compile_invalid();
+    test_next_fire();
+    test_parse_cron_weekday();
     test_init_destroy();
     test_add_job();
     test_remove_job();
@@ -302,6 +602,10 @@ int main(void) {
     test_oneshot();
     test_paused_no_exec();
     test_list_jobs();
+    test_heap_many_jobs();
+    test_thread_fires();
+    test_pool_concurrency_timeout();
+    test_overlap_policies();
     test_db_persist();
 
     printf("\n\033[1mResults: %d passed, %d failed\033[0m\n\n", s_pass, s_fail);
@@ -10,6 +10,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sqlite3.h>
 
 static u32 s_pass = 0;
 static u32 s_fail = 0;
@@ -219,6 +222,140 @@ static void test_raw_exec(void) {
     sea_db_close(db);
 }
 
+/* Count rows through a separate connection, as an outside reader would */
+static i64 count_rows(const char* sql) {
+    sqlite3* h = NULL;
+    sqlite3_stmt* st = NULL;
+    i64 n = -1;
+    if (sqlite3_open(TEST_DB_PATH, &h) == SQLITE_OK &&
+        sqlite3_prepare_v2(h, sql, -1, &st, NULL) == SQLITE_OK &&
+        sqlite3_step(st) == SQLITE_ROW)
+        n = sqlite3_column_int64(st, 0);
+    sqlite3_finalize(st);
+    sqlite3_close(h);
+    return n;
+}
+
+static void test_audit_batched(void) {
+    TEST("audit writer batches events and cron runs");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+    sea_db_exec(db, "DELETE FROM trajectory; DELETE FROM cron_log;");
+
+    SeaDbAuditConfig cfg = { .flush_ms = 50 };
+    if (sea_db_audit_start(db, &cfg) != SEA_OK) { FAIL("start"); sea_db_close(db); return; }
+
+    char title[32];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(title, sizeof(title), "call %d", i);
+        sea_db_log_event(db, "tool_call", title, "ok");
+    }
+    for (int i = 0; i < 100; i++)
+        sea_db_log_cron(db, 7, "backup", "ok", "it's done", 1700000000 + (u64)i, 12);
+    sea_db_audit_flush(db);
+
+    SeaDbAuditStats st;
+    sea_db_audit_stats(db, &st);
+    if (st.written != 1100 || st.dropped != 0 || st.pending != 0) { FAIL("stats"); sea_db_close(db); return; }
+    if (st.batches >= 1100) { FAIL("not batched"); sea_db_close(db); return; }
+    if (count_rows("SELECT COUNT(*) FROM trajectory") != 1000) { FAIL("trajectory rows"); sea_db_close(db); return; }
+    if (count_rows("SELECT COUNT(*) FROM cron_log WHERE output = 'it''s done'") != 100) {
+        FAIL("cron rows"); sea_db_close(db); return;
+    }
+
+    /* Rows queued just before close are drained, not lost */
+    sea_db_log_event(db, "shutdown", "stopped", "clean");
+    sea_db_close(db);
+    if (count_rows("SELECT COUNT(*) FROM trajectory WHERE entry_type = 'shutdown'") != 1) {
+        FAIL("close did not drain"); return;
+    }
+    PASS();
+}
+
+typedef struct { SeaDb* db; int id; } AuditProducer;
+
+static void* audit_producer(void* arg) {
+    AuditProducer* p = (AuditProducer*)arg;
+    char title[32];
+    for (int i = 0; i < 2000; i++) {
+        snprintf(title, sizeof(title), "t%d-%d", p->id, i);
+        while (sea_db_log_event(p->db, "load", title, "x") != SEA_OK) usleep(100);
+    }
+    return NULL;
+}
+
+static void test_audit_concurrent(void) {
+    TEST("audit ring with concurrent producers");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+    sea_db_exec(db, "DELETE FROM trajectory;");
+
+    /* A small ring forces producers to wrap and occasionally hit full */
+    SeaDbAuditConfig cfg = { .ring_slots = 64, .flush_ms = 5 };
+    sea_db_audit_start(db, &cfg);
+
+    pthread_t th[4];
+    AuditProducer args[4];
+    for (int i = 0; i < 4; i++) {
+        args[i] = (AuditProducer){ db, i };
+        pthread_create(&th[i], NULL, audit_producer, &args[i]);
+    }
+    for (int i = 0; i < 4; i++) pthread_join(th[i], NULL);
+    sea_db_audit_flush(db);
+
+    SeaDbAuditStats st;
+    sea_db_audit_stats(db, &st);
+    sea_db_close(db);
+
+    if (st.queued != 8000 || st.written != 8000) { FAIL("lost records"); return; }
+    if (count_rows("SELECT COUNT(DISTINCT title) FROM trajectory WHERE entry_type = 'load'") != 8000) {
+        FAIL("duplicate or missing rows"); return;
+    }
+    PASS();
+}
+
+static void test_audit_retention(void) {
+    TEST("audit retention prunes and downsamples");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+    sea_db_exec(db, "DELETE FROM trajectory; DELETE FROM cron_log;");
+
+    u64 now = (u64)time(NULL);
+    u64 day = 86400;
+    /* 40 days old: pruned by age */
+    sea_db_exec(db, "INSERT INTO trajectory (entry_type, title, content, created_at) "
+                    "VALUES ('old', 'x', 'x', datetime('now', '-40 days'))");
+    sea_db_log_cron(db, 1, "ancient", "ok", "", now - 40 * day, 1);
+    /* 10 days old, every 5 minutes for 2 hours: thinned to 2 ok rows;
+     * the failure is kept */
+    u64 base = (now - 10 * day) / 3600 * 3600;
+    for (u64 m = 0; m < 120; m += 5)
+        sea_db_log_cron(db, 2, "poll", "ok", "", base + m * 60, 1);
+    sea_db_log_cron(db, 2, "poll", "error", "boom", base + 600, 1);
+    /* Recent rows are untouched */
+    for (int i = 0; i < 10; i++) sea_db_log_cron(db, 3, "fresh", "ok", "", now - 60, 1);
+    sea_db_log_event(db, "recent", "y", "y");
+
+    SeaDbAuditConfig cfg = { .retain_days = 30, .downsample_days = 7 };
+    u64 removed = sea_db_audit_compact(db, &cfg);
+
+    i64 traj  = count_rows("SELECT COUNT(*) FROM trajectory");
+    i64 poll  = count_rows("SELECT COUNT(*) FROM cron_log WHERE job_id = 2");
+    i64 fresh = count_rows("SELECT COUNT(*) FROM cron_log WHERE job_id = 3");
+    i64 old   = count_rows("SELECT COUNT(*) FROM cron_log WHERE job_id = 1");
+    if (traj != 1 || old != 0 || poll != 3 || fresh != 10 || removed != 24) {
+        FAIL("unexpected row counts"); sea_db_close(db); return;
+    }
+
+    /* Row cap keeps the newest ids */
+    cfg = (SeaDbAuditConfig){ .retain_rows = 4 };
+    sea_db_audit_compact(db, &cfg);
+    sea_db_close(db);
+    if (count_rows("SELECT COUNT(*) FROM cron_log") != 4 ||
+        count_rows("SELECT MIN(job_id) FROM cron_log") != 3) { FAIL("row cap"); return; }
+    PASS();
+}
+
 int main(void) {
     sea_log_init(SEA_LOG_WARN);
 
@@ -238,6 +375,9 @@ int main(void) {
     test_chat_log();
     test_persistence();
     test_raw_exec();
+    test_audit_batched();
+    test_audit_concurrent();
+    test_audit_retention();
 
     printf("\n  ────────────────────────────────────────────────\n");
     printf("  Results: \033[32m%u passed\033[0m", s_pass);
@@ -0,0 +1,160 @@
+/*
+ * test_diff.c — Tests for the Myers diff engine
+ *
+ * Minimal edit scripts, insert/delete alignment, unified output
+ * format, end-of-file markers and large inputs.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_diff.h"
+#include "seaclaw/sea_arena.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-40s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+static SeaArena s_arena;
+
+static SeaError diff_str(const char* a, const char* b, SeaDiff* d) {
+    return sea_diff_lines((const u8*)a, strlen(a), (const u8*)b, strlen(b), &s_arena, d);
+}
+
+/* Unified diff as a NUL-terminated string in the arena */
+static const char* unified(const char* a, const char* b, u32 context) {
+    SeaDiff d;
+    SeaSlice out;
+    if (diff_str(a, b, &d) != SEA_OK) return NULL;
+    if (sea_diff_unified(&d, "a", "b", context, 4096, &s_arena, &out) != SEA_OK) return NULL;
+    char* s = (char*)sea_arena_alloc(&s_arena, out.len + 1, 1);
+    if (out.len) memcpy(s, out.data, out.len);
+    s[out.len] = '\0';
+    return s;
+}
+
+/* ── Tests ────────────────────────────────────────────────── */
+
+static void test_identical(void) {
+    TEST("identical texts have no changes");
+    SeaDiff d;
+    if (diff_str("a\nb\nc\n", "a\nb\nc\n", &d) != SEA_OK) { FAIL("diff failed"); return; }
+    if (d.change_count != 0 || d.a_count != 3) { FAIL("unexpected changes"); return; }
+    const char* u = unified("x\n", "x\n", 3);
+    if (!u || u[0]) { FAIL("non-empty unified"); return; }
+    PASS();
+}
+
+static void test_insert_aligns(void) {
+    TEST("inserted line does not shift the rest");
+    SeaDiff d;
+    diff_str("1\n2\n3\n4\n5\n", "1\nnew\n2\n3\n4\n5\n", &d);
+    if (d.change_count != 1)                  { FAIL("change count"); return; }
+    if (d.removed != 0 || d.added != 1)       { FAIL("totals"); return; }
+    if (d.changes[0].b_start != 1 || d.changes[0].a_start != 1) { FAIL("position"); return; }
+    PASS();
+}
+
+static void test_minimal(void) {
+    TEST("edit script is minimal (ABCABBA/CBABAC)");
+    SeaDiff d;
+    diff_str("A\nB\nC\nA\nB\nB\nA\n", "C\nB\nA\nB\nA\nC\n", &d);
+    /* Myers' paper example: D = 5 */
+    if (d.removed + d.added != 5) { FAIL("not minimal"); return; }
+    PASS();
+}
+
+static void test_unified_format(void) {
+    TEST("unified hunks and ranges");
+    const char* u = unified("a\nb\nc\nd\ne\nf\ng\nh\n", "a\nb\nc\nD\ne\nf\ng\nh\n", 1);
+    const char* want =
+        "--- a\n+++ b\n"
+        "@@ -3,3 +3,3 @@\n"
+        " c\n-d\n+D\n e\n";
+    if (!u || strcmp(u, want) != 0) { FAIL("single hunk"); return; }
+
+    u = unified("x\n", "", 3);
+    if (!u || strcmp(u, "--- a\n+++ b\n@@ -1 +0,0 @@\n-x\n") != 0) { FAIL("delete all"); return; }
+    PASS();
+}
+
+static void test_hunk_merge(void) {
+    TEST("nearby changes share a hunk");
+    const char* u = unified("1\n2\n3\n4\n5\n6\n7\n8\n9\n10\n11\n12\n13\n14\n15\n16\n17\n18\n19\n20\n",
+                            "1\nX\n3\n4\n5\n6\nY\n8\n9\n10\n11\n12\n13\n14\n15\n16\n17\n18\nZ\n20\n", 3);
+    if (!u) { FAIL("diff failed"); return; }
+    u32 hunks = 0;
+    for (const char* p = u; (p = strstr(p, "@@ -")) != NULL; p += 4) hunks++;
+    if (hunks != 2) { FAIL("hunk count"); return; }
+    if (!strstr(u, "@@ -1,10 +1,10 @@")) { FAIL("merged range"); return; }
+    PASS();
+}
+
+static void test_no_newline(void) {
+    TEST("missing final newline is marked");
+    const char* u = unified("a\nb", "a\nb\n", 3);
+    if (!u || !strstr(u, "-b\n\\ No newline at end of file\n+b\n")) { FAIL("marker"); return; }
+    PASS();
+}
+
+static void test_large(void) {
+    TEST("large input through the arena");
+    u32 n = 200000;
+    char* a = (char*)malloc((u64)n * 12);
+    char* b = (char*)malloc((u64)n * 12);
+    u64 al = 0, bl = 0;
+    for (u32 i = 0; i < n; i++) {
+        al += (u64)sprintf(a + al, "line %u\n", i);
+        if (i % 1000 == 500) continue;                 /* 200 deletions  */
+        bl += (u64)sprintf(b + bl, "line %u\n", i);
+        if (i % 5000 == 0) bl += (u64)sprintf(b + bl, "extra %u\n", i);   /* 40 insertions */
+    }
+    SeaArena big;
+    sea_arena_create(&big, 64 * 1024 * 1024);
+    SeaDiff d;
+    SeaError err = sea_diff_lines((const u8*)a, al, (const u8*)b, bl, &big, &d);
+    bool ok = err == SEA_OK && d.removed == 200 && d.added == 40;
+    sea_arena_destroy(&big);
+    free(a);
+    free(b);
+    if (!ok) { FAIL("counts"); return; }
+    PASS();
+}
+
+/* ── Main ─────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_WARN);
+    sea_arena_create(&s_arena, 1024 * 1024);
+
+    printf("\n  \033[1mSea-Claw Diff Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════\n\n");
+
+    test_identical();
+    test_insert_aligns();
+    test_minimal();
+    test_unified_format();
+    test_hunk_merge();
+    test_no_newline();
+    test_large();
+
+    sea_arena_destroy(&s_arena);
+
+    printf("\n  ────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * test_grep.c — Tests for the grep engine
+ *
+ * Literal (SIMD + Horspool), case-insensitive, regex, context
+ * lines and memory-mapped file search.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_grep.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-40s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+#define TEST_FILE "/tmp/seaclaw_grep_test.log"
+
+/* Records up to 16 hits */
+typedef struct {
+    u64  line_no[16];
+    bool context[16];
+    u32  n;
+} Hits;
+
+static bool record(const SeaGrepHit* h, void* ctx) {
+    Hits* hs = (Hits*)ctx;
+    if (hs->n < 16) {
+        hs->line_no[hs->n] = h->line_no;
+        hs->context[hs->n] = h->context;
+        hs->n++;
+    }
+    return true;
+}
+
+static SeaGrepStats grep_str(const char* pattern, u32 flags, const char* text,
+                             u32 context, Hits* hits) {
+    SeaGrepPattern pat;
+    SeaGrepStats st;
+    memset(&st, 0, sizeof(st));
+    memset(hits, 0, sizeof(*hits));
+    if (sea_grep_compile(&pat, pattern, flags, NULL, 0) != SEA_OK) return st;
+    sea_grep_buffer(&pat, (const u8*)text, strlen(text), context, record, hits, &st);
+    sea_grep_free(&pat);
+    return st;
+}
+
+/* ── Tests ────────────────────────────────────────────────── */
+
+static void test_find_literal(void) {
+    TEST("literal find across SIMD boundaries");
+    char buf[300];
+    SeaGrepPattern pat;
+    sea_grep_compile(&pat, "needle", 0, NULL, 0);
+    for (u32 at = 0; at + 6 <= sizeof(buf); at++) {
+        memset(buf, 'x', sizeof(buf));
+        memcpy(buf + at, "needle", 6);
+        if (sea_grep_find(&pat, (const u8*)buf, sizeof(buf)) != (i64)at) {
+            FAIL("wrong offset"); return;
+        }
+    }
+    memset(buf, 'x', sizeof(buf));
+    memcpy(buf + 100, "needlx", 6);
+    if (sea_grep_find(&pat, (const u8*)buf, sizeof(buf)) != -1) { FAIL("false positive"); return; }
+    PASS();
+}
+
+static void test_icase(void) {
+    TEST("case-insensitive matches both cases");
+    Hits h;
+    SeaGrepStats st = grep_str("error", SEA_GREP_ICASE, "ok\nError one\nfine\nERROR two\n", 0, &h);
+    if (st.matches != 2) { FAIL("match count"); return; }
+    if (h.line_no[0] != 2 || h.line_no[1] != 4) { FAIL("line numbers"); return; }
+    if (st.lines != 4) { FAIL("line total"); return; }
+    st = grep_str("error", 0, "ok\nError one\nfine\nERROR two\n", 0, &h);
+    if (st.matches != 0) { FAIL("case-sensitive should miss"); return; }
+    PASS();
+}
+
+static void test_one_hit_per_line(void) {
+    TEST("one hit per line, last line unterminated");
+    Hits h;
+    SeaGrepStats st = grep_str("ab", 0, "abab ab\nxx\nzzab", 0, &h);
+    if (st.matches != 2) { FAIL("match count"); return; }
+    if (h.line_no[1] != 3) { FAIL("last line number"); return; }
+    if (st.lines != 3) { FAIL("line total"); return; }
+    PASS();
+}
+
+static void test_regex(void) {
+    TEST("regex with anchors");
+    Hits h;
+    SeaGrepStats st = grep_str("^[0-9]+$", SEA_GREP_REGEX, "12\nab12\n345\n\n7x\n", 0, &h);
+    if (st.matches != 2) { FAIL("match count"); return; }
+    if (h.line_no[0] != 1 || h.line_no[1] != 3) { FAIL("line numbers"); return; }
+
+    SeaGrepPattern bad;
+    char err[64] = "";
+    if (sea_grep_compile(&bad, "([", SEA_GREP_REGEX, err, sizeof(err)) != SEA_ERR_PARSE) {
+        FAIL("bad regex accepted"); return;
+    }
+    if (!err[0]) { FAIL("no error message"); return; }
+    PASS();
+}
+
+static void test_context(void) {
+    TEST("context lines merge without repeats");
+    Hits h;
+    /* matches on 3 and 5; context 1 → 2,3,4,5,6 */
+    SeaGrepStats st = grep_str("hit", 0, "a\nb\nhit\nc\nhit\nd\ne\nf\n", 1, &h);
+    if (st.matches != 2) { FAIL("match count"); return; }
+    if (h.n != 5) { FAIL("emitted line count"); return; }
+    for (u32 i = 0; i < 5; i++) {
+        if (h.line_no[i] != 2 + i) { FAIL("line order"); return; }
+    }
+    if (!h.context[0] || h.context[1] || !h.context[2] || h.context[3] || !h.context[4]) {
+        FAIL("context flags"); return;
+    }
+    PASS();
+}
+
+static void test_file(void) {
+    TEST("mmap file search, no truncation");
+    FILE* f = fopen(TEST_FILE, "w");
+    if (!f) { FAIL("cannot write fixture"); return; }
+    for (u32 i = 0; i < 200000; i++) {
+        fprintf(f, "%u INFO request handled in %u ms\n", i, i % 97);
+        if (i % 1000 == 999) fprintf(f, "%u WARN slow request\n", i);
+    }
+    fclose(f);
+
+    SeaGrepPattern pat;
+    sea_grep_compile(&pat, "warn", SEA_GREP_ICASE, NULL, 0);
+    SeaGrepStats st;
+    SeaError err = sea_grep_file(&pat, TEST_FILE, 0, NULL, NULL, NULL, &st);
+    sea_grep_free(&pat);
+    unlink(TEST_FILE);
+
+    if (err != SEA_OK)       { FAIL("grep_file failed"); return; }
+    if (st.matches != 200)   { FAIL("match count"); return; }
+    if (st.lines != 200200)  { FAIL("line total"); return; }
+    PASS();
+}
+
+/* ── Main ─────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_WARN);
+
+    printf("\n  \033[1mSea-Claw Grep Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════\n\n");
+
+    test_find_literal();
+    test_icase();
+    test_one_hit_per_line();
+    test_regex();
+    test_context();
+    test_file();
+
+    printf("\n  ────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
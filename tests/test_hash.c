@@ -0,0 +1,194 @@
+/*
+ * test_hash.c — Tests for checksums and digests
+ *
+ * Known-answer vectors for every algorithm, accelerated paths checked
+ * against incremental feeds at awkward lengths, and file hashing.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_hash.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-40s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+#define TEST_FILE "/tmp/seaclaw_hash_test.bin"
+
+static const u8 CHECK[] = "123456789";
+
+/* Reference bitwise CRC for cross-checking the fast paths */
+static u32 crc_bitwise(u32 poly, const u8* p, u64 len) {
+    u32 c = 0xFFFFFFFF;
+    for (u64 i = 0; i < len; i++) {
+        c ^= p[i];
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (poly & (0u - (c & 1)));
+    }
+    return ~c;
+}
+
+static void fill(u8* buf, u32 len) {
+    u32 x = 0x12345678;
+    for (u32 i = 0; i < len; i++) {
+        x = x * 1103515245u + 12345u;
+        buf[i] = (u8)(x >> 16);
+    }
+}
+
+/* ── Tests ────────────────────────────────────────────────── */
+
+static void test_crc_vectors(void) {
+    TEST("CRC32 / CRC32C check values");
+    if (sea_crc32(0, CHECK, 9) != 0xCBF43926)  { FAIL("crc32");  return; }
+    if (sea_crc32c(0, CHECK, 9) != 0xE3069283) { FAIL("crc32c"); return; }
+    if (sea_crc32(0, NULL, 0) != 0)            { FAIL("empty");  return; }
+    PASS();
+}
+
+static void test_crc_lengths(void) {
+    TEST("CRC fast paths match bitwise, all splits");
+    static u8 buf[4099];
+    fill(buf, sizeof(buf));
+    for (u32 len = 0; len <= sizeof(buf); len += (len < 300 ? 1 : 127)) {
+        u32 ref  = crc_bitwise(0xEDB88320u, buf, len);
+        u32 refc = crc_bitwise(0x82F63B78u, buf, len);
+        if (sea_crc32(0, buf, len) != ref)   { FAIL("crc32 one-shot");  return; }
+        if (sea_crc32c(0, buf, len) != refc) { FAIL("crc32c one-shot"); return; }
+        u32 split = len / 3;
+        if (sea_crc32(sea_crc32(0, buf, split), buf + split, len - split) != ref) {
+            FAIL("crc32 continued"); return;
+        }
+        if (sea_crc32c(sea_crc32c(0, buf + 0, split), buf + split, len - split) != refc) {
+            FAIL("crc32c continued"); return;
+        }
+    }
+    PASS();
+}
+
+static void test_xxh64(void) {
+    TEST("xxHash64 vectors and streaming");
+    if (sea_xxh64(NULL, 0, 0) != 0xEF46DB3751D8E999ULL)            { FAIL("empty"); return; }
+    if (sea_xxh64((const u8*)"abc", 3, 0) != 0x44BC2CF5AD770999ULL) { FAIL("abc");   return; }
+
+    static u8 buf[1000];
+    fill(buf, sizeof(buf));
+    u64 whole = sea_xxh64(buf, sizeof(buf), 7);
+    SeaXxh64 s;
+    sea_xxh64_init(&s, 7);
+    for (u32 off = 0, step = 1; off < sizeof(buf); off += step, step = step % 37 + 1) {
+        u32 n = off + step > sizeof(buf) ? (u32)sizeof(buf) - off : step;
+        sea_xxh64_update(&s, buf + off, n);
+    }
+    if (sea_xxh64_final(&s) != whole) { FAIL("streaming mismatch"); return; }
+    PASS();
+}
+
+static void test_sha256(void) {
+    TEST("SHA-256 vectors and streaming");
+    u8 d[32];
+    char hex[65];
+
+    sea_sha256((const u8*)"abc", 3, d);
+    sea_hash_hex(d, 32, hex);
+    if (strcmp(hex, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") != 0) {
+        FAIL("abc"); return;
+    }
+    sea_sha256(NULL, 0, d);
+    sea_hash_hex(d, 32, hex);
+    if (strcmp(hex, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855") != 0) {
+        FAIL("empty"); return;
+    }
+    const char* two = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    sea_sha256((const u8*)two, strlen(two), d);
+    sea_hash_hex(d, 32, hex);
+    if (strcmp(hex, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1") != 0) {
+        FAIL("two-block"); return;
+    }
+
+    /* One million 'a' fed in uneven pieces */
+    static u8 a[1000];
+    memset(a, 'a', sizeof(a));
+    SeaSha256 s;
+    sea_sha256_init(&s);
+    u64 fed = 0;
+    for (u32 step = 1; fed < 1000000; step = step % 997 + 1) {
+        u32 n = (u32)(1000000 - fed < step ? 1000000 - fed : step);
+        sea_sha256_update(&s, a, n);
+        fed += n;
+    }
+    sea_sha256_final(&s, d);
+    sea_hash_hex(d, 32, hex);
+    if (strcmp(hex, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0") != 0) {
+        FAIL("million a"); return;
+    }
+    PASS();
+}
+
+static void test_fnv1a(void) {
+    TEST("FNV-1a vectors");
+    if (sea_fnv1a(SEA_FNV1A_INIT, NULL, 0) != 0xcbf29ce484222325ULL) { FAIL("empty"); return; }
+    if (sea_fnv1a(SEA_FNV1A_INIT, (const u8*)"a", 1) != 0xaf63dc4c8601ec8cULL) { FAIL("a"); return; }
+    PASS();
+}
+
+static void test_file(void) {
+    TEST("file hash matches buffer hash");
+    static u8 buf[300000];
+    fill(buf, sizeof(buf));
+    FILE* f = fopen(TEST_FILE, "wb");
+    if (!f) { FAIL("cannot write fixture"); return; }
+    fwrite(buf, 1, sizeof(buf), f);
+    fclose(f);
+
+    SeaHashDigest fd, bd;
+    SeaError err = sea_hash_file(TEST_FILE, SEA_HASH_ALL, &fd);
+    unlink(TEST_FILE);
+    sea_hash_buffer(buf, sizeof(buf), SEA_HASH_ALL, &bd);
+
+    if (err != SEA_OK)                          { FAIL("hash_file failed"); return; }
+    if (fd.size != sizeof(buf))                 { FAIL("size"); return; }
+    if (memcmp(&fd, &bd, sizeof(fd)) != 0)      { FAIL("digest mismatch"); return; }
+    if (fd.crc32 != crc_bitwise(0xEDB88320u, buf, sizeof(buf))) { FAIL("crc32"); return; }
+    if (sea_hash_file("/nonexistent/x", SEA_HASH_CRC32, &fd) != SEA_ERR_IO) {
+        FAIL("missing file"); return;
+    }
+    PASS();
+}
+
+/* ── Main ─────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_WARN);
+
+    printf("\n  \033[1mSea-Claw Hash Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════\n");
+    printf("  crc32=%s crc32c=%s sha256=%s\n\n",
+           sea_hash_impl(SEA_HASH_CRC32), sea_hash_impl(SEA_HASH_CRC32C),
+           sea_hash_impl(SEA_HASH_SHA256));
+
+    test_crc_vectors();
+    test_crc_lengths();
+    test_xxh64();
+    test_sha256();
+    test_fnv1a();
+    test_file();
+
+    printf("\n  ────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
@@ -316,6 +316,30 @@ static void test_benchmark_1kb(void) {
 
 /* ── Main ─────────────────────────────────────────────────── */
 
+static void test_unescape(void) {
+    TEST("unescape strings and surrogate pairs");
+    reset();
+    SeaSlice raw = SEA_SLICE_LIT("a\\\"b\\n\\u00e9\\ud83d\\ude00\\/");
+    SeaSlice s = sea_json_unescape(raw, &arena);
+    if (!sea_slice_eq_cstr(s, "a\"b\n\xc3\xa9\xf0\x9f\x98\x80/")) { FAIL("wrong decode"); return; }
+    PASS();
+}
+
+static void test_escape_roundtrip(void) {
+    TEST("escape round-trips through the parser");
+    reset();
+    SeaSlice text = SEA_SLICE_LIT("say \"hi\"\n\tpath\\x \x01end");
+    SeaSlice esc = sea_json_escape(text, &arena);
+    char doc[128];
+    int n = snprintf(doc, sizeof(doc), "{\"v\":\"%.*s\"}", (int)esc.len, (const char*)esc.data);
+    SeaJsonValue val;
+    SeaSlice input = { .data = (const u8*)doc, .len = (u32)n };
+    if (sea_json_parse(input, &arena, &val) != SEA_OK) { FAIL("escaped text did not parse"); return; }
+    SeaSlice back = sea_json_unescape(sea_json_get_string(&val, "v"), &arena);
+    if (back.len != text.len || memcmp(back.data, text.data, text.len) != 0) { FAIL("round trip"); return; }
+    PASS();
+}
+
 int main(void) {
     sea_log_init(SEA_LOG_WARN);
     sea_arena_create(&arena, TEST_ARENA_SIZE);
@@ -339,6 +363,8 @@ int main(void) {
     test_get_missing_key();
     test_reject_invalid();
     test_telegram_message();
+    test_unescape();
+    test_escape_roundtrip();
     test_benchmark_1kb();
 
     printf("\n  ────────────────────────────────────────────────\n");
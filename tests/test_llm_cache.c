@@ -0,0 +1,323 @@
+/*
+ * test_llm_cache.c — Tests for the LLM response cache and request coalescing
+ */
+
+#include "seaclaw/sea_llm_cache.h"
+#include "seaclaw/sea_arena.h"
+#include "seaclaw/sea_db.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#define TEST_DB  "/tmp/test_llm_cache.db"
+#define URL      "http://llm.local/v1/chat/completions"
+
+static int s_pass = 0;
+static int s_fail = 0;
+
+#define TEST(name) printf("  [TEST] %s ... ", name)
+#define PASS() do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+#define FAIL(msg) do { printf("\033[31mFAIL: %s\033[0m\n", msg); s_fail++; } while(0)
+
+static SeaSlice lit(const char* s) {
+    return (SeaSlice){ .data = (const u8*)s, .len = (u32)strlen(s) };
+}
+
+static SeaDb* open_db(void) {
+    unlink(TEST_DB);
+    SeaDb* db = NULL;
+    return sea_db_open(&db, TEST_DB) == SEA_OK ? db : NULL;
+}
+
+/* ── Test: Canonical key ─────────────────────────────────── */
+
+static void test_key(void) {
+    TEST("canonical_key");
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaLlmCache* c = sea_llm_cache_create(NULL, NULL);
+
+    SeaLlmCacheKey a, b, d, e, f;
+    sea_llm_cache_key(c, URL, lit(
+        "{\"model\":\"m\",\"temperature\":0,\"messages\":[{\"role\":\"user\",\"content\":\"hi\"}]}"),
+        &arena, &a);
+    /* Reordered keys, whitespace, stream flag, escaped character */
+    sea_llm_cache_key(c, URL, lit(
+        "{ \"messages\" : [ { \"content\":\"h\\u0069\", \"role\":\"user\" } ],\n"
+        "  \"stream\": false, \"temperature\": 0.0, \"model\": \"m\" }"),
+        &arena, &b);
+    sea_llm_cache_key(c, URL, lit(
+        "{\"model\":\"m\",\"temperature\":0,\"messages\":[{\"role\":\"user\",\"content\":\"hi!\"}]}"),
+        &arena, &d);
+    sea_llm_cache_key(c, "http://other/v1/chat/completions", lit(
+        "{\"model\":\"m\",\"temperature\":0,\"messages\":[{\"role\":\"user\",\"content\":\"hi\"}]}"),
+        &arena, &e);
+    SeaError bad = sea_llm_cache_key(c, URL, lit("not json"), &arena, &f);
+
+    sea_llm_cache_destroy(c);
+    sea_arena_destroy(&arena);
+
+    if (strlen(a.hex) != 64) { FAIL("key not hex"); return; }
+    if (strcmp(a.hex, b.hex) != 0) { FAIL("equivalent bodies differ"); return; }
+    if (strcmp(a.hex, d.hex) == 0) { FAIL("different content collides"); return; }
+    if (strcmp(a.hex, e.hex) == 0) { FAIL("URL not in key"); return; }
+    if (!a.cacheable || !b.cacheable) { FAIL("temperature 0 not cacheable"); return; }
+    if (bad != SEA_ERR_PARSE) { FAIL("bad body accepted"); return; }
+    PASS();
+}
+
+/* ── Test: Temperature gate ──────────────────────────────── */
+
+static void test_temperature(void) {
+    TEST("nondeterministic_not_stored");
+    SeaDb* db = open_db();
+    if (!db) { FAIL("db open"); return; }
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaLlmCache* c = sea_llm_cache_create(db, NULL);
+
+    SeaLlmCacheKey warm, none;
+    sea_llm_cache_key(c, URL, lit("{\"model\":\"m\",\"temperature\":0.7}"), &arena, &warm);
+    sea_llm_cache_key(c, URL, lit("{\"model\":\"m\"}"), &arena, &none);
+
+    SeaSlice out;
+    SeaCacheResult r1 = sea_llm_cache_begin(c, &warm, &arena, &out);
+    sea_llm_cache_complete(c, &warm, lit("{\"ok\":1}"), true);
+    SeaCacheResult r2 = sea_llm_cache_begin(c, &warm, &arena, &out);
+    sea_llm_cache_complete(c, &warm, lit("{\"ok\":2}"), true);
+
+    SeaLlmCacheStats st;
+    sea_llm_cache_stats(c, &st);
+    sea_llm_cache_destroy(c);
+    sea_arena_destroy(&arena);
+    sea_db_close(db);
+
+    if (warm.cacheable || none.cacheable) { FAIL("sampled request marked cacheable"); return; }
+    if (r1 != SEA_CACHE_LEADER || r2 != SEA_CACHE_LEADER) { FAIL("sampled request reused"); return; }
+    if (st.stored != 0 || st.entries != 0) { FAIL("sampled response stored"); return; }
+    PASS();
+}
+
+/* ── Test: Hit, miss, failure ────────────────────────────── */
+
+static void test_hit(void) {
+    TEST("store_and_hit");
+    SeaDb* db = open_db();
+    if (!db) { FAIL("db open"); return; }
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaLlmCache* c = sea_llm_cache_create(db, NULL);
+
+    SeaLlmCacheKey k, k2;
+    sea_llm_cache_key(c, URL, lit("{\"model\":\"m\",\"temperature\":0,\"n\":1}"), &arena, &k);
+    sea_llm_cache_key(c, URL, lit("{\"model\":\"m\",\"temperature\":0,\"n\":2}"), &arena, &k2);
+
+    SeaSlice out;
+    SeaCacheResult r1 = sea_llm_cache_begin(c, &k, &arena, &out);
+    sea_llm_cache_complete(c, &k, lit("{\"answer\":42}"), true);
+    SeaCacheResult r2 = sea_llm_cache_begin(c, &k, &arena, &out);
+    bool same = out.len == 13 && memcmp(out.data, "{\"answer\":42}", 13) == 0;
+
+    /* A failed call is not stored */
+    SeaCacheResult r3 = sea_llm_cache_begin(c, &k2, &arena, &out);
+    sea_llm_cache_complete(c, &k2, lit("{\"error\":\"busy\"}"), false);
+    SeaCacheResult r4 = sea_llm_cache_begin(c, &k2, &arena, &out);
+    sea_llm_cache_complete(c, &k2, (SeaSlice){0}, false);
+
+    sea_llm_cache_destroy(c);
+
+    /* Stored entries survive a restart */
+    c = sea_llm_cache_create(db, NULL);
+    SeaCacheResult r5 = sea_llm_cache_begin(c, &k, &arena, &out);
+    SeaLlmCacheStats st;
+    sea_llm_cache_stats(c, &st);
+    sea_llm_cache_destroy(c);
+    sea_arena_destroy(&arena);
+    sea_db_close(db);
+
+    if (r1 != SEA_CACHE_LEADER) { FAIL("first call not leader"); return; }
+    if (r2 != SEA_CACHE_HIT || !same) { FAIL("stored response not returned"); return; }
+    if (r3 != SEA_CACHE_LEADER || r4 != SEA_CACHE_LEADER) { FAIL("failure was cached"); return; }
+    if (r5 != SEA_CACHE_HIT) { FAIL("entry lost on reopen"); return; }
+    if (st.entries != 1) { FAIL("entry count wrong"); return; }
+    PASS();
+}
+
+/* ── Test: TTL ───────────────────────────────────────────── */
+
+static void test_ttl(void) {
+    TEST("ttl_expiry");
+    SeaDb* db = open_db();
+    if (!db) { FAIL("db open"); return; }
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaLlmCacheConfig cfg = { .ttl_sec = 1 };
+    SeaLlmCache* c = sea_llm_cache_create(db, &cfg);
+
+    SeaLlmCacheKey k;
+    sea_llm_cache_key(c, URL, lit("{\"model\":\"m\",\"temperature\":0}"), &arena, &k);
+    SeaSlice out;
+    sea_llm_cache_begin(c, &k, &arena, &out);
+    sea_llm_cache_complete(c, &k, lit("{\"v\":1}"), true);
+    SeaCacheResult fresh = sea_llm_cache_begin(c, &k, &arena, &out);
+
+    sleep(2);
+    SeaCacheResult stale = sea_llm_cache_begin(c, &k, &arena, &out);
+    sea_llm_cache_complete(c, &k, (SeaSlice){0}, false);
+    SeaLlmCacheStats st;
+    sea_llm_cache_stats(c, &st);
+
+    sea_llm_cache_destroy(c);
+    sea_arena_destroy(&arena);
+    sea_db_close(db);
+
+    if (fresh != SEA_CACHE_HIT) { FAIL("fresh entry missed"); return; }
+    if (stale != SEA_CACHE_LEADER) { FAIL("expired entry served"); return; }
+    if (st.entries != 0) { FAIL("expired entry kept"); return; }
+    PASS();
+}
+
+/* ── Test: LRU eviction ──────────────────────────────────── */
+
+static void test_lru(void) {
+    TEST("lru_eviction");
+    SeaDb* db = open_db();
+    if (!db) { FAIL("db open"); return; }
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+    SeaLlmCacheConfig cfg = { .max_bytes = 40 * 1024 };
+    SeaLlmCache* c = sea_llm_cache_create(db, &cfg);
+
+    static char blob[8 * 1024];
+    memset(blob, 'x', sizeof(blob));
+    SeaSlice big = { .data = (const u8*)blob, .len = sizeof(blob) };
+
+    SeaLlmCacheKey keys[8];
+    SeaSlice out;
+    for (u32 i = 0; i < 8; i++) {
+        char body[64];
+        snprintf(body, sizeof(body), "{\"temperature\":0,\"i\":%u}", i);
+        sea_llm_cache_key(c, URL, lit(body), &arena, &keys[i]);
+        sea_llm_cache_begin(c, &keys[i], &arena, &out);
+        sea_llm_cache_complete(c, &keys[i], big, true);
+        if (i == 3) {
+            /* Touch the first entry so it is the most recently hit */
+            sleep(1);
+            sea_llm_cache_begin(c, &keys[0], &arena, &out);
+        }
+    }
+
+    SeaLlmCacheStats st;
+    sea_llm_cache_stats(c, &st);
+    SeaCacheResult first = sea_llm_cache_begin(c, &keys[0], &arena, &out);
+    SeaCacheResult second = sea_llm_cache_begin(c, &keys[1], &arena, &out);
+    if (second == SEA_CACHE_LEADER) sea_llm_cache_complete(c, &keys[1], (SeaSlice){0}, false);
+    SeaCacheResult last = sea_llm_cache_begin(c, &keys[7], &arena, &out);
+
+    sea_llm_cache_destroy(c);
+    sea_arena_destroy(&arena);
+    sea_db_close(db);
+
+    if (st.bytes > cfg.max_bytes) { FAIL("over size bound"); return; }
+    if (st.evicted == 0) { FAIL("nothing evicted"); return; }
+    if (first != SEA_CACHE_HIT) { FAIL("recently hit entry evicted"); return; }
+    if (second != SEA_CACHE_LEADER) { FAIL("stale entry kept"); return; }
+    if (last != SEA_CACHE_HIT) { FAIL("newest entry evicted"); return; }
+    PASS();
+}
+
+/* ── Test: Singleflight ──────────────────────────────────── */
+
+#define FOLLOWERS 6
+
+static SeaLlmCache*   s_cache;
+static SeaLlmCacheKey s_key;
+static _Atomic u32    s_shared;
+static _Atomic u32    s_bypass;
+static _Atomic u32    s_led;
+
+static void* follower(void* arg) {
+    bool expect_ok = (bool)(uintptr_t)arg;
+    SeaArena arena;
+    sea_arena_create(&arena, 16 * 1024);
+    SeaSlice out;
+    SeaCacheResult r = sea_llm_cache_begin(s_cache, &s_key, &arena, &out);
+    if (r == SEA_CACHE_SHARED && expect_ok && out.len == 9 &&
+        memcmp(out.data, "{\"one\":1}", 9) == 0)
+        atomic_fetch_add(&s_shared, 1);
+    else if (r == SEA_CACHE_BYPASS)
+        atomic_fetch_add(&s_bypass, 1);
+    else if (r == SEA_CACHE_LEADER) {
+        atomic_fetch_add(&s_led, 1);
+        sea_llm_cache_complete(s_cache, &s_key, (SeaSlice){0}, false);
+    }
+    sea_arena_destroy(&arena);
+    return NULL;
+}
+
+static void run_flight(bool ok) {
+    atomic_store(&s_shared, 0);
+    atomic_store(&s_bypass, 0);
+    atomic_store(&s_led, 0);
+
+    SeaArena arena;
+    sea_arena_create(&arena, 16 * 1024);
+    SeaSlice out;
+    SeaCacheResult lead = sea_llm_cache_begin(s_cache, &s_key, &arena, &out);
+    if (lead != SEA_CACHE_LEADER) atomic_store(&s_led, 100);
+
+    pthread_t th[FOLLOWERS];
+    for (u32 i = 0; i < FOLLOWERS; i++)
+        pthread_create(&th[i], NULL, follower, (void*)(uintptr_t)ok);
+    usleep(200 * 1000);                     /* Let them queue on the flight */
+    sea_llm_cache_complete(s_cache, &s_key, lit("{\"one\":1}"), ok);
+    for (u32 i = 0; i < FOLLOWERS; i++) pthread_join(th[i], NULL);
+    sea_arena_destroy(&arena);
+}
+
+static void test_singleflight(void) {
+    TEST("singleflight_shares_one_call");
+    SeaArena arena;
+    sea_arena_create(&arena, 16 * 1024);
+    /* No DB and a sampled request: only coalescing applies */
+    s_cache = sea_llm_cache_create(NULL, NULL);
+    sea_llm_cache_key(s_cache, URL, lit("{\"model\":\"m\",\"temperature\":1}"), &arena, &s_key);
+
+    run_flight(true);
+    u32 shared = atomic_load(&s_shared), led = atomic_load(&s_led);
+
+    run_flight(false);
+    u32 bypass = atomic_load(&s_bypass), led2 = atomic_load(&s_led);
+
+    SeaLlmCacheStats st;
+    sea_llm_cache_stats(s_cache, &st);
+    sea_llm_cache_destroy(s_cache);
+    sea_arena_destroy(&arena);
+
+    if (led != 0 || led2 != 0) { FAIL("second leader while in flight"); return; }
+    if (shared != FOLLOWERS) { FAIL("followers did not share result"); return; }
+    if (bypass != FOLLOWERS) { FAIL("failed flight not bypassed"); return; }
+    if (st.shared != FOLLOWERS || st.misses != 2) { FAIL("stats wrong"); return; }
+    PASS();
+}
+
+int main(void) {
+    printf("\n  ═══ test_llm_cache ═══\n\n");
+    sea_log_init(SEA_LOG_ERROR);
+
+    test_key();
+    test_temperature();
+    test_hit();
+    test_ttl();
+    test_lru();
+    test_singleflight();
+
+    printf("\n  Results: %d passed, %d failed\n\n", s_pass, s_fail);
+
+    unlink(TEST_DB);
+    return s_fail > 0 ? 1 : 0;
+}
@@ -0,0 +1,814 @@
+/*
+ * test_mesh.c — Mesh routing tests
+ *
+ * Capability index, least-outstanding / EWMA routing, a simulated
+ * 64-node fleet comparing the router against lifetime-count routing,
+ * and a captain and crew talking over loopback HTTP.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_mesh.h"
+#include "seaclaw/sea_tools.h"
+#include "seaclaw/sea_http.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <curl/curl.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-44s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+/* Local tools a crew node advertises and runs: echo returns its
+ * arguments, nap sleeps 100ms first */
+static SeaError tool_echo_stub(SeaSlice args, SeaArena* arena, SeaSlice* output) {
+    (void)arena;
+    *output = args;
+    return SEA_OK;
+}
+static SeaError tool_nap_stub(SeaSlice args, SeaArena* arena, SeaSlice* output) {
+    usleep(100 * 1000);
+    return tool_echo_stub(args, arena, output);
+}
+
+static _Thread_local SeaToolProgressFn s_progress_fn;
+static _Thread_local void*             s_progress_ctx;
+void sea_tool_set_progress(SeaToolProgressFn fn, void* ctx) { s_progress_fn = fn; s_progress_ctx = ctx; }
+void sea_tool_progress(const u8* data, u32 len) { if (s_progress_fn) s_progress_fn(data, len, s_progress_ctx); }
+
+/* tick reports three pieces of progress 80ms apart */
+static SeaError tool_tick_stub(SeaSlice args, SeaArena* arena, SeaSlice* output) {
+    (void)args; (void)arena;
+    const char* ticks[] = { "t1 ", "t2 \"q\"\n", "t3 " };
+    for (int i = 0; i < 3; i++) {
+        sea_tool_progress((const u8*)ticks[i], (u32)strlen(ticks[i]));
+        usleep(80 * 1000);
+    }
+    *output = SEA_SLICE_LIT("tick-done");
+    return SEA_OK;
+}
+
+static const SeaTool s_tools[] = {
+    { 1, "echo", "echo", tool_echo_stub },
+    { 2, "nap",  "nap",  tool_nap_stub  },
+    { 3, "tick", "tick", tool_tick_stub },
+};
+#define STUB_TOOLS 3
+
+u32 sea_tools_count(void) { return STUB_TOOLS; }
+const SeaTool* sea_tool_by_id(u32 id) { return id >= 1 && id <= STUB_TOOLS ? &s_tools[id - 1] : NULL; }
+SeaError sea_tool_exec(const char* name, SeaSlice args, SeaArena* arena, SeaSlice* output) {
+    for (u32 i = 0; i < STUB_TOOLS; i++)
+        if (strcmp(s_tools[i].name, name) == 0) return s_tools[i].func(args, arena, output);
+    return SEA_ERR_TOOL_NOT_FOUND;
+}
+
+static SeaMesh s_mesh;   /* Too large for the stack */
+
+static void mesh_reset(void) {
+    SeaMeshConfig cfg = { .role = SEA_MESH_CAPTAIN };
+    strcpy(cfg.node_name, "captain");
+    sea_mesh_init(&s_mesh, &cfg, NULL);
+}
+
+/* Name of the node routed to for tool, or NULL */
+static const char* routed(SeaMesh* mesh, const char* tool) {
+    static SeaMeshRoute r;
+    return sea_mesh_route_tool(mesh, tool, &r) ? r.name : NULL;
+}
+
+static void test_route_by_capability(void) {
+    TEST("route only to nodes with the tool");
+    mesh_reset();
+    const char* a[] = { "file_read", "shell_exec" };
+    const char* b[] = { "dns_lookup" };
+    sea_mesh_register_node(&s_mesh, "alpha", "http://10.0.0.1:9101", a, 2);
+    sea_mesh_register_node(&s_mesh, "beta",  "http://10.0.0.2:9101", b, 1);
+
+    for (int i = 0; i < 50; i++) {
+        const char* n = routed(&s_mesh, "shell_exec");
+        if (!n || strcmp(n, "alpha") != 0) { FAIL("shell_exec misrouted"); return; }
+        n = routed(&s_mesh, "dns_lookup");
+        if (!n || strcmp(n, "beta") != 0) { FAIL("dns_lookup misrouted"); return; }
+    }
+    if (routed(&s_mesh, "file_write")) { FAIL("unknown tool routed"); return; }
+    if (routed(&s_mesh, "file_rea"))   { FAIL("prefix matched"); return; }
+    PASS();
+}
+
+static void test_index_after_registry_change(void) {
+    TEST("index follows re-register and removal");
+    mesh_reset();
+    const char* a[] = { "echo" };
+    const char* b[] = { "echo", "hash_compute" };
+    const char* c[] = { "hash_compute" };
+    sea_mesh_register_node(&s_mesh, "alpha", "http://10.0.0.1:9101", a, 1);
+    sea_mesh_register_node(&s_mesh, "beta",  "http://10.0.0.2:9101", b, 2);
+    sea_mesh_register_node(&s_mesh, "gamma", "http://10.0.0.3:9101", c, 1);
+
+    /* Removing alpha shifts beta and gamma down one slot */
+    sea_mesh_remove_node(&s_mesh, "alpha");
+    for (int i = 0; i < 20; i++) {
+        const char* n = routed(&s_mesh, "echo");
+        if (!n || strcmp(n, "beta") != 0) { FAIL("stale index after remove"); return; }
+    }
+
+    /* beta drops echo */
+    sea_mesh_register_node(&s_mesh, "beta", "http://10.0.0.2:9101", c, 1);
+    if (routed(&s_mesh, "echo")) { FAIL("stale index after re-register"); return; }
+    if (!routed(&s_mesh, "hash_compute")) { FAIL("lost capability"); return; }
+    PASS();
+}
+
+static void test_skip_unhealthy(void) {
+    TEST("unhealthy nodes are not routed to");
+    mesh_reset();
+    const char* caps[] = { "echo" };
+    sea_mesh_register_node(&s_mesh, "alpha", "http://10.0.0.1:9101", caps, 1);
+    sea_mesh_register_node(&s_mesh, "beta",  "http://10.0.0.2:9101", caps, 1);
+    s_mesh.nodes[0].healthy = false;
+    for (int i = 0; i < 20; i++) {
+        const char* n = routed(&s_mesh, "echo");
+        if (!n || strcmp(n, "beta") != 0) { FAIL("routed to unhealthy"); return; }
+    }
+    s_mesh.nodes[1].healthy = false;
+    if (routed(&s_mesh, "echo")) { FAIL("no healthy node expected"); return; }
+    PASS();
+}
+
+/* A route naming nodes[i], as if acquired */
+static SeaMeshRoute route_of(u32 i) {
+    return (SeaMeshRoute){ .index = i, .id = s_mesh.nodes[i].id };
+}
+
+static void test_least_outstanding(void) {
+    TEST("in-flight tasks spread across nodes");
+    mesh_reset();
+    const char* caps[] = { "echo" };
+    sea_mesh_register_node(&s_mesh, "alpha", "http://10.0.0.1:9101", caps, 1);
+    sea_mesh_register_node(&s_mesh, "beta",  "http://10.0.0.2:9101", caps, 1);
+
+    /* With two nodes both are always the candidates */
+    SeaMeshRoute held[8];
+    for (int i = 0; i < 8; i++) sea_mesh_route_acquire(&s_mesh, "echo", &held[i]);
+    if (s_mesh.nodes[0].in_flight != 4 || s_mesh.nodes[1].in_flight != 4) {
+        FAIL("load not balanced"); return;
+    }
+    for (int i = 0; i < 8; i++) sea_mesh_route_release(&s_mesh, &held[i], true, 5.0);
+    if (s_mesh.nodes[0].in_flight != 0 || s_mesh.nodes[0].tasks_completed != 4) {
+        FAIL("release bookkeeping"); return;
+    }
+
+    /* Lifetime totals no longer count as load */
+    s_mesh.nodes[0].tasks_completed = 100000;
+    SeaMeshRoute n, m;
+    if (!sea_mesh_route_acquire(&s_mesh, "echo", &n) ||
+        !sea_mesh_route_acquire(&s_mesh, "echo", &m) || n.id == m.id) {
+        FAIL("history treated as load"); return;
+    }
+    PASS();
+}
+
+static void test_release_after_remove(void) {
+    TEST("release finds its node after removals");
+    mesh_reset();
+    const char* caps[] = { "echo" };
+    sea_mesh_register_node(&s_mesh, "alpha", "http://10.0.0.1:9101", caps, 1);
+    sea_mesh_register_node(&s_mesh, "beta",  "http://10.0.0.2:9101", caps, 1);
+    s_mesh.nodes[0].healthy = false;
+
+    SeaMeshRoute r;
+    if (!sea_mesh_route_acquire(&s_mesh, "echo", &r) || strcmp(r.name, "beta") != 0 ||
+        strcmp(r.endpoint, "http://10.0.0.2:9101") != 0) {
+        FAIL("route not filled"); return;
+    }
+
+    /* alpha goes, beta moves down a slot while the task runs */
+    sea_mesh_remove_node(&s_mesh, "alpha");
+    sea_mesh_register_node(&s_mesh, "gamma", "http://10.0.0.3:9101", caps, 1);
+    s_mesh.nodes[1].in_flight = 7;
+    sea_mesh_route_release(&s_mesh, &r, true, 5.0);
+    if (s_mesh.nodes[0].in_flight != 0 || s_mesh.nodes[0].tasks_completed != 1) {
+        FAIL("moved node not released"); return;
+    }
+    if (s_mesh.nodes[1].in_flight != 7 || s_mesh.nodes[1].tasks_completed != 0) {
+        FAIL("wrong node charged"); return;
+    }
+
+    /* Released after its own node is gone: nobody is charged */
+    sea_mesh_route_acquire(&s_mesh, "echo", &r);
+    u32 other = r.index == 0 ? 1 : 0;
+    u32 before = s_mesh.nodes[other].in_flight;
+    sea_mesh_remove_node(&s_mesh, r.name);
+    sea_mesh_route_release(&s_mesh, &r, false, 5.0);
+    if (s_mesh.nodes[0].in_flight != before || s_mesh.nodes[0].tasks_failed != 0) {
+        FAIL("stale route charged a node"); return;
+    }
+    PASS();
+}
+
+static void test_latency_and_errors(void) {
+    TEST("slow and failing nodes are avoided");
+    mesh_reset();
+    const char* caps[] = { "echo" };
+    sea_mesh_register_node(&s_mesh, "slow",  "http://10.0.0.1:9101", caps, 1);
+    sea_mesh_register_node(&s_mesh, "fast",  "http://10.0.0.2:9101", caps, 1);
+    SeaMeshRoute r0 = route_of(0), r1 = route_of(1);
+    sea_mesh_route_release(&s_mesh, &r0, true, 120.0);
+    sea_mesh_route_release(&s_mesh, &r1, true, 10.0);
+
+    const char* n = routed(&s_mesh, "echo");
+    if (!n || strcmp(n, "fast") != 0) { FAIL("picked slow node"); return; }
+
+    /* Same latency, but one node keeps failing */
+    mesh_reset();
+    sea_mesh_register_node(&s_mesh, "flaky", "http://10.0.0.1:9101", caps, 1);
+    sea_mesh_register_node(&s_mesh, "solid", "http://10.0.0.2:9101", caps, 1);
+    r0 = route_of(0);
+    r1 = route_of(1);
+    for (int i = 0; i < 10; i++) {
+        sea_mesh_route_release(&s_mesh, &r0, false, 10.0);
+        sea_mesh_route_release(&s_mesh, &r1, true, 10.0);
+    }
+    n = routed(&s_mesh, "echo");
+    if (!n || strcmp(n, "solid") != 0) { FAIL("picked failing node"); return; }
+
+    /* An unmeasured node is tried on load alone */
+    sea_mesh_register_node(&s_mesh, "fresh", "http://10.0.0.3:9101", caps, 1);
+    s_mesh.nodes[1].in_flight = 3;
+    int fresh = 0;
+    for (int i = 0; i < 30; i++) {
+        n = routed(&s_mesh, "echo");
+        if (n && strcmp(n, "fresh") == 0) fresh++;
+    }
+    if (fresh == 0) { FAIL("new node never tried"); return; }
+    PASS();
+}
+
+/* ── Simulation ───────────────────────────────────────────── */
+/*
+ * 64 nodes, each offering 24 of 32 tools. Most serve in 10ms, eight
+ * take 80ms and four fail 30% of calls. A node slows down linearly
+ * with its own concurrency (latency = base x (1 + in_flight)). Time is
+ * simulated in 1ms steps; two requests arrive per step.
+ */
+
+#define SIM_NODES    64
+#define SIM_TOOLS    32
+#define SIM_REQUESTS 40000
+#define SIM_RATE     2
+
+typedef struct { SeaMeshRoute route; u32 done_at; double latency; bool ok; } SimTask;
+
+/* Min-heap of in-flight tasks keyed on completion time */
+static void sim_push(SimTask* h, u32* n, SimTask t) {
+    u32 i = (*n)++;
+    while (i > 0 && h[(i - 1) / 2].done_at > t.done_at) { h[i] = h[(i - 1) / 2]; i = (i - 1) / 2; }
+    h[i] = t;
+}
+
+static SimTask sim_pop(SimTask* h, u32* n) {
+    SimTask top = h[0], last = h[--(*n)];
+    u32 i = 0;
+    for (;;) {
+        u32 c = 2 * i + 1;
+        if (c >= *n) break;
+        if (c + 1 < *n && h[c + 1].done_at < h[c].done_at) c++;
+        if (h[c].done_at >= last.done_at) break;
+        h[i] = h[c];
+        i = c;
+    }
+    if (*n > 0) h[i] = last;
+    return top;
+}
+
+static u64 s_sim_rng;
+
+static u32 sim_rand(void) {
+    s_sim_rng ^= s_sim_rng << 13;
+    s_sim_rng ^= s_sim_rng >> 7;
+    s_sim_rng ^= s_sim_rng << 17;
+    return (u32)(s_sim_rng >> 16);
+}
+
+static double sim_base(u32 i) { return (i % 8 == 3) ? 80.0 : 10.0; }
+static bool   sim_flaky(u32 i) { return i % 16 == 5; }
+
+/* The previous policy: fewest lifetime tasks wins */
+static bool lifetime_pick(const char* tool, SeaMeshRoute* out) {
+    SeaMeshNode* best = NULL;
+    u32 best_load = UINT32_MAX;
+    for (u32 i = 0; i < s_mesh.node_count; i++) {
+        SeaMeshNode* node = &s_mesh.nodes[i];
+        if (!node->healthy) continue;
+        for (u32 c = 0; c < node->capability_count; c++) {
+            if (strcmp(node->capabilities[c], tool) == 0) {
+                u32 load = node->tasks_completed + node->tasks_failed;
+                if (!best || load < best_load) { best = node; best_load = load; }
+                break;
+            }
+        }
+    }
+    if (!best) return false;
+    best->in_flight++;
+    *out = route_of((u32)(best - s_mesh.nodes));
+    return true;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+typedef struct { double p50, p99, mean; u32 errors; double route_ns; } SimReport;
+
+static void sim_setup(void) {
+    mesh_reset();
+    char names[SIM_TOOLS][16];
+    for (u32 t = 0; t < SIM_TOOLS; t++) snprintf(names[t], sizeof(names[t]), "tool_%02u", t);
+    for (u32 i = 0; i < SIM_NODES; i++) {
+        const char* caps[SIM_TOOLS];
+        u32 n = 0;
+        for (u32 t = 0; t < SIM_TOOLS; t++)
+            if ((t + i) % 4 != 0) caps[n++] = names[t];
+        char name[32], ep[64];
+        snprintf(name, sizeof(name), "crew-%02u", i);
+        snprintf(ep, sizeof(ep), "http://10.0.1.%u:9101", i + 1);
+        sea_mesh_register_node(&s_mesh, name, ep, caps, n);
+    }
+}
+
+static SimReport sim_run(bool use_router) {
+    sim_setup();
+    s_sim_rng = 0x2545F4914F6CDD1DULL;
+    SimTask* live = calloc(SIM_REQUESTS, sizeof(SimTask));
+    double* lat = calloc(SIM_REQUESTS, sizeof(double));
+    u32 live_n = 0, finished = 0, issued = 0, errors = 0;
+    double route_ns = 0;
+
+    for (u32 now = 0; finished < SIM_REQUESTS; now++) {
+        /* Once everything is issued, skip idle steps */
+        if (issued == SIM_REQUESTS && live_n > 0 && live[0].done_at > now) now = live[0].done_at;
+
+        /* Completions due this step */
+        while (live_n > 0 && live[0].done_at <= now) {
+            SimTask t = sim_pop(live, &live_n);
+            sea_mesh_route_release(&s_mesh, &t.route, t.ok, t.latency);
+            if (!t.ok) errors++;
+            lat[finished++] = t.latency;
+        }
+        for (u32 r = 0; r < SIM_RATE && issued < SIM_REQUESTS; r++, issued++) {
+            char tool[16];
+            snprintf(tool, sizeof(tool), "tool_%02u", sim_rand() % SIM_TOOLS);
+            struct timespec t0, t1;
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            SeaMeshRoute rt;
+            if (use_router) sea_mesh_route_acquire(&s_mesh, tool, &rt);
+            else lifetime_pick(tool, &rt);
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+            route_ns += (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+            u32 idx = rt.index;                 /* Nothing is removed mid-run */
+            double l = sim_base(idx) * (double)s_mesh.nodes[idx].in_flight;  /* Includes this task */
+            bool ok = !(sim_flaky(idx) && sim_rand() % 10 < 3);
+            sim_push(live, &live_n, (SimTask){ rt, now + (u32)l, l, ok });
+        }
+    }
+
+    qsort(lat, SIM_REQUESTS, sizeof(double), cmp_double);
+    SimReport rep = { .p50 = lat[SIM_REQUESTS / 2], .p99 = lat[SIM_REQUESTS * 99 / 100],
+                      .errors = errors, .route_ns = route_ns / SIM_REQUESTS };
+    for (u32 i = 0; i < SIM_REQUESTS; i++) rep.mean += lat[i];
+    rep.mean /= SIM_REQUESTS;
+    free(live);
+    free(lat);
+    return rep;
+}
+
+static void test_simulated_fleet(void) {
+    TEST("64-node fleet: router beats lifetime count");
+    SimReport old = sim_run(false);
+    SimReport neu = sim_run(true);
+    /* Spreading evenly would send 4/64 of calls to nodes failing 30% */
+    u32 even_errors = SIM_REQUESTS / 16 * 3 / 10;
+    bool ok = neu.p99 < old.p99 && neu.mean < old.mean && neu.p99 <= 2 * 80.0 &&
+              neu.errors < even_errors;
+    if (ok) PASS(); else FAIL("router did not improve latency or errors");
+    printf("    lifetime: p50 %5.1fms  p99 %6.1fms  mean %5.1fms  errors %5u  route %5.0fns\n",
+           old.p50, old.p99, old.mean, old.errors, old.route_ns);
+    printf("    router:   p50 %5.1fms  p99 %6.1fms  mean %5.1fms  errors %5u  route %5.0fns\n",
+           neu.p50, neu.p99, neu.mean, neu.errors, neu.route_ns);
+}
+
+/* ── Loopback captain and crew ────────────────────────────── */
+
+static SeaMesh        s_captain;
+static SeaMesh        s_crew;
+static SeaMeshServer* s_captain_srv;
+static SeaMeshServer* s_crew_srv;
+
+static double wall_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static bool fleet_start(void) {
+    SeaMeshConfig cap = { .role = SEA_MESH_CAPTAIN };
+    strcpy(cap.node_name, "captain");
+    strcpy(cap.shared_secret, "tide");
+    SeaMeshConfig crew = { .role = SEA_MESH_CREW };
+    strcpy(crew.node_name, "crew-1");
+    strcpy(crew.shared_secret, "tide");
+    sea_mesh_init(&s_captain, &cap, NULL);
+    sea_mesh_init(&s_crew, &crew, NULL);
+    s_captain.config.port = 0;                   /* Any free port */
+    s_crew.config.port = 0;
+    if (sea_mesh_server_start(&s_captain, "127.0.0.1", 2, &s_captain_srv) != SEA_OK) return false;
+    if (sea_mesh_server_start(&s_crew, "127.0.0.1", 4, &s_crew_srv) != SEA_OK) return false;
+    snprintf(s_crew.config.captain_url, sizeof(s_crew.config.captain_url),
+             "http://127.0.0.1:%u", s_captain.config.port);
+    return true;
+}
+
+static void fleet_stop(void) {
+    sea_mesh_server_stop(s_crew_srv);
+    sea_mesh_server_stop(s_captain_srv);
+    sea_mesh_destroy(&s_crew);
+    sea_mesh_destroy(&s_captain);
+}
+
+static void test_e2e_register_dispatch(void) {
+    TEST("e2e: crew registers, captain dispatches");
+    SeaArena arena;
+    sea_arena_create(&arena, 1024 * 1024);
+
+    if (sea_mesh_crew_register(&s_crew, &arena) != SEA_OK) { FAIL("register"); goto out; }
+    if (sea_mesh_node_count(&s_captain) != 1 ||
+        !routed(&s_captain, "echo")) { FAIL("captain registry"); goto out; }
+    if (sea_mesh_crew_heartbeat(&s_crew, &arena) != SEA_OK) { FAIL("heartbeat"); goto out; }
+
+    /* Quotes, newlines and non-ASCII survive both directions */
+    const char* args = "say \"ahoy\"\nline two \xe2\x9a\x93 tab\there";
+    SeaMeshTask task = { .task_id = "t-1", .tool_name = "echo", .tool_args = args };
+    SeaMeshResult r = sea_mesh_dispatch(&s_captain, &task, &arena);
+    if (!r.success || !r.output || strcmp(r.output, args) != 0) { FAIL("echo mismatch"); goto out; }
+    if (s_captain.nodes[0].in_flight != 0 || s_captain.nodes[0].tasks_completed != 1) {
+        FAIL("routing stats"); goto out;
+    }
+
+    task.tool_name = "nonexistent";
+    r = sea_mesh_dispatch(&s_captain, &task, &arena);
+    if (r.success) { FAIL("unknown tool succeeded"); goto out; }
+    PASS();
+out:
+    sea_arena_destroy(&arena);
+}
+
+static void test_e2e_token_required(void) {
+    TEST("e2e: requests without a valid token rejected");
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    char url[128];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/mesh/heartbeat", s_captain.config.port);
+    SeaSlice body = SEA_SLICE_LIT("{\"name\":\"crew-1\"}");
+    SeaHttpResponse resp;
+    bool ok = sea_http_post_json(url, body, &arena, &resp) == SEA_OK && resp.status_code == 401;
+    ok = ok && sea_http_post_json_auth(url, body, "X-Mesh-Token: 1:0000000000000000",
+                                       &arena, &resp) == SEA_OK && resp.status_code == 401;
+    sea_arena_destroy(&arena);
+    if (ok) PASS(); else FAIL("expected 401");
+}
+
+static void test_server_needs_secret(void) {
+    TEST("no server and no valid token without a secret");
+    SeaMesh open_mesh;
+    SeaMeshConfig cfg = { .role = SEA_MESH_CREW };
+    strcpy(cfg.node_name, "open");
+    sea_mesh_init(&open_mesh, &cfg, NULL);
+    open_mesh.config.port = 0;
+    SeaMeshServer* srv = NULL;
+    SeaError err = sea_mesh_server_start(&open_mesh, "127.0.0.1", 1, &srv);
+    bool token = sea_mesh_validate_token(&open_mesh, "1:0000000000000000");
+    if (srv) sea_mesh_server_stop(srv);
+    sea_mesh_destroy(&open_mesh);
+    if (err != SEA_ERR_CONFIG || srv) { FAIL("server started without a secret"); return; }
+    if (token) { FAIL("token accepted without a secret"); return; }
+    PASS();
+}
+
+/* Two requests in one write on one connection; both answered in order */
+static void test_e2e_keepalive_pipeline(void) {
+    TEST("e2e: keep-alive with pipelined requests");
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    const char* token = sea_mesh_generate_token(&s_crew, &arena);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(s_crew.config.port) };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        FAIL("connect"); close(fd); sea_arena_destroy(&arena); return;
+    }
+
+    char req[1024];
+    int n = 0;
+    const char* bodies[] = { "{\"task_id\":\"a\",\"tool\":\"nap\",\"args\":\"first\"}",
+                             "{\"task_id\":\"b\",\"tool\":\"echo\",\"args\":\"second\"}" };
+    for (int i = 0; i < 2; i++)
+        n += snprintf(req + n, sizeof(req) - (size_t)n,
+                      "POST /node/exec HTTP/1.1\r\nHost: x\r\nX-Mesh-Token: %s\r\n"
+                      "Content-Length: %zu\r\n\r\n%s", token, strlen(bodies[i]), bodies[i]);
+    if (write(fd, req, (size_t)n) != n) { FAIL("write"); close(fd); sea_arena_destroy(&arena); return; }
+
+    char buf[4096];
+    size_t got = 0;
+    double deadline = wall_ms() + 3000;
+    while (wall_ms() < deadline && got < sizeof(buf) - 1) {
+        ssize_t r = recv(fd, buf + got, sizeof(buf) - 1 - got, MSG_DONTWAIT);
+        if (r > 0) got += (size_t)r;
+        buf[got] = '\0';
+        if (strstr(buf, "second")) break;
+        usleep(5000);
+    }
+    close(fd);
+    sea_arena_destroy(&arena);
+
+    char* first = strstr(buf, "first");
+    char* second = strstr(buf, "second");
+    char* again = first ? strstr(first, "HTTP/1.1 200") : NULL;
+    if (!first || !second || second < first || !again) { FAIL("responses missing or out of order"); return; }
+    if (!strstr(buf, "Connection: keep-alive")) { FAIL("connection not kept alive"); return; }
+    PASS();
+}
+
+typedef struct { int ok; } DispatchArg;
+
+static void* dispatch_nap(void* arg) {
+    DispatchArg* d = (DispatchArg*)arg;
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+    SeaMeshTask task = { .task_id = "n", .tool_name = "nap", .tool_args = "zz" };
+    SeaMeshResult r = sea_mesh_dispatch(&s_captain, &task, &arena);
+    d->ok = r.success && r.output && strcmp(r.output, "zz") == 0;
+    sea_arena_destroy(&arena);
+    return NULL;
+}
+
+static void test_e2e_worker_pool(void) {
+    TEST("e2e: tool calls run on the worker pool");
+    pthread_t th[8];
+    DispatchArg args[8];
+    double t0 = wall_ms();
+    for (int i = 0; i < 8; i++) pthread_create(&th[i], NULL, dispatch_nap, &args[i]);
+    for (int i = 0; i < 8; i++) pthread_join(th[i], NULL);
+    double elapsed = wall_ms() - t0;
+
+    for (int i = 0; i < 8; i++) if (!args[i].ok) { FAIL("dispatch failed"); return; }
+    /* 8 x 100ms on 4 workers: two rounds, not eight */
+    if (elapsed > 600) { FAIL("tool calls serialized"); return; }
+    PASS();
+}
+
+static void test_e2e_broadcast(void) {
+    TEST("e2e: broadcast reaches the crew");
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaMeshServerStats before, after;
+    sea_mesh_server_stats(s_crew_srv, &before);
+    sea_mesh_broadcast(&s_captain, "all hands", &arena);
+    sea_mesh_server_stats(s_crew_srv, &after);
+    sea_arena_destroy(&arena);
+    if (after.broadcasts != before.broadcasts + 1) { FAIL("not delivered"); return; }
+    PASS();
+}
+
+/* Listening socket that never accepts: connects, then silence */
+static int blackhole(u16* port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { .sin_family = AF_INET };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t alen = sizeof(addr);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 8) != 0 ||
+        getsockname(fd, (struct sockaddr*)&addr, &alen) != 0) {
+        close(fd);
+        return -1;
+    }
+    *port = ntohs(addr.sin_port);
+    return fd;
+}
+
+static const SeaMeshFanoutResult* find_result(const SeaMeshFanoutResult* r, u32 n,
+                                              const char* name) {
+    for (u32 i = 0; i < n; i++) if (strcmp(r[i].name, name) == 0) return &r[i];
+    return NULL;
+}
+
+static void test_e2e_fanout(void) {
+    TEST("e2e: concurrent fan-out, per-node deadline");
+    u16 p1 = 0, p2 = 0, p3 = 0;
+    int hole1 = blackhole(&p1), hole2 = blackhole(&p2), gone = blackhole(&p3);
+    close(gone);                                 /* Refuses connections */
+    if (hole1 < 0 || hole2 < 0) { FAIL("listen"); return; }
+
+    const char* caps[] = { "echo" };
+    char ep[64];
+    snprintf(ep, sizeof(ep), "http://127.0.0.1:%u", p1);
+    sea_mesh_register_node(&s_captain, "sleepy-1", ep, caps, 1);
+    snprintf(ep, sizeof(ep), "http://127.0.0.1:%u", p2);
+    sea_mesh_register_node(&s_captain, "sleepy-2", ep, caps, 1);
+    snprintf(ep, sizeof(ep), "http://127.0.0.1:%u", p3);
+    sea_mesh_register_node(&s_captain, "ghost", ep, caps, 1);
+
+    SeaArena arena;
+    sea_arena_create(&arena, 1024 * 1024);
+    SeaMeshFanoutResult res[8];
+    SeaMeshServerStats before, after;
+    sea_mesh_server_stats(s_crew_srv, &before);
+
+    /* Serially the two silent nodes alone would take 2 x 2s */
+    double t0 = wall_ms();
+    u32 sent = sea_mesh_broadcast_status(&s_captain, "storm \"warning\"\nall hands", &arena, res, 8);
+    double elapsed = wall_ms() - t0;
+    sea_mesh_server_stats(s_crew_srv, &after);
+
+    const SeaMeshFanoutResult* crew = find_result(res, 4, "crew-1");
+    const SeaMeshFanoutResult* slow = find_result(res, 4, "sleepy-2");
+    const SeaMeshFanoutResult* dead = find_result(res, 4, "ghost");
+    bool ok = sent == 1 && crew && crew->status == 200 &&
+              after.broadcasts == before.broadcasts + 1 &&
+              slow && slow->err == SEA_ERR_TIMEOUT && dead && dead->err == SEA_ERR_CONNECT &&
+              elapsed < SEA_MESH_FANOUT_TIMEOUT_MS * 1.75;
+    if (!ok) { FAIL("broadcast outcomes"); goto out; }
+
+    /* Health probe: the live crew stays healthy, the rest drop out */
+    u32 healthy = sea_mesh_probe_health(&s_captain, &arena, res, 8);
+    SeaMeshRoute live[8];
+    u32 n = sea_mesh_healthy_nodes(&s_captain, live, 8);
+    if (healthy != 1 || n != 1 || strcmp(live[0].name, "crew-1") != 0) { FAIL("health probe"); goto out; }
+    PASS();
+out:
+    sea_mesh_remove_node(&s_captain, "sleepy-1");
+    sea_mesh_remove_node(&s_captain, "sleepy-2");
+    sea_mesh_remove_node(&s_captain, "ghost");
+    close(hole1);
+    close(hole2);
+    sea_arena_destroy(&arena);
+}
+
+static void test_e2e_future_stream(void) {
+    TEST("e2e: future streams progress, then result");
+    SeaArena arena;
+    sea_arena_create(&arena, 64 * 1024);
+    SeaMeshTask task = { .task_id = "s-1", .tool_name = "tick" };
+    SeaMeshFuture* f = sea_mesh_dispatch_async(&s_captain, &task);
+
+    char seen[128] = "";
+    bool live = false;                 /* Progress arrived before the end */
+    SeaMeshTaskState st;
+    double deadline = wall_ms() + 5000;
+    do {
+        SeaSlice chunk;
+        st = sea_mesh_future_poll(f, &arena, &chunk);
+        if (chunk.len) {
+            if (st == SEA_MESH_TASK_PENDING) live = true;
+            strncat(seen, (const char*)chunk.data, chunk.len < sizeof(seen) - strlen(seen) - 1
+                                                   ? chunk.len : sizeof(seen) - strlen(seen) - 1);
+        }
+        if (st == SEA_MESH_TASK_PENDING) usleep(10 * 1000);
+    } while (st == SEA_MESH_TASK_PENDING && wall_ms() < deadline);
+    SeaSlice rest;
+    sea_mesh_future_poll(f, &arena, &rest);
+    if (rest.len) strncat(seen, (const char*)rest.data, rest.len);
+
+    SeaMeshResult r = sea_mesh_future_result(f, &arena);
+    sea_mesh_future_free(f);
+    bool ok = st == SEA_MESH_TASK_DONE && live && strcmp(seen, "t1 t2 \"q\"\nt3 ") == 0 &&
+              r.success && r.output && strcmp(r.output, "tick-done") == 0 &&
+              r.node_name && strcmp(r.node_name, "crew-1") == 0;
+    sea_arena_destroy(&arena);
+    if (ok) PASS(); else FAIL("stream or result mismatch");
+}
+
+/* Many tasks in flight from one thread; none needs a thread of its own */
+static void test_e2e_future_fanin(void) {
+    TEST("e2e: 16 concurrent futures, one caller");
+    SeaArena arena;
+    sea_arena_create(&arena, 256 * 1024);
+    SeaMeshFuture* f[16];
+    char ids[16][8];
+    double t0 = wall_ms();
+    for (int i = 0; i < 16; i++) {
+        snprintf(ids[i], sizeof(ids[i]), "f%d", i);
+        SeaMeshTask task = { .task_id = ids[i], .tool_name = "nap", .tool_args = ids[i] };
+        f[i] = sea_mesh_dispatch_async(&s_captain, &task);
+    }
+    bool ok = true;
+    for (int i = 0; i < 16; i++) {
+        ok = ok && sea_mesh_future_wait(f[i], 5000) == SEA_MESH_TASK_DONE;
+        SeaMeshResult r = sea_mesh_future_result(f[i], &arena);
+        ok = ok && r.output && strcmp(r.output, ids[i]) == 0 && strcmp(r.task_id, ids[i]) == 0;
+        sea_mesh_future_free(f[i]);
+    }
+    double elapsed = wall_ms() - t0;
+    sea_arena_destroy(&arena);
+    /* 16 x 100ms on 4 crew workers: about four rounds */
+    if (!ok) { FAIL("task failed"); return; }
+    if (elapsed > 1200) { FAIL("tasks serialized"); return; }
+    if (s_captain.nodes[0].in_flight != 0) { FAIL("in-flight leak"); return; }
+    PASS();
+}
+
+static void test_e2e_future_cancel(void) {
+    TEST("e2e: cancel and wait timeout");
+    SeaMeshServerStats before, after;
+    sea_mesh_server_stats(s_crew_srv, &before);
+
+    /* Fill all four crew workers, then queue one more behind them */
+    SeaMeshFuture* busy[4];
+    for (int i = 0; i < 4; i++) {
+        SeaMeshTask task = { .task_id = "busy", .tool_name = "nap", .tool_args = "z" };
+        busy[i] = sea_mesh_dispatch_async(&s_captain, &task);
+    }
+    usleep(30 * 1000);
+    SeaMeshTask task = { .task_id = "victim", .tool_name = "echo", .tool_args = "never" };
+    SeaMeshFuture* victim = sea_mesh_dispatch_async(&s_captain, &task);
+
+    bool ok = sea_mesh_future_wait(victim, 20) == SEA_MESH_TASK_PENDING;
+    sea_mesh_future_cancel(victim);
+    ok = ok && sea_mesh_future_wait(victim, 1000) == SEA_MESH_TASK_CANCELLED;
+    sea_mesh_future_free(victim);
+    for (int i = 0; i < 4; i++) {
+        ok = ok && sea_mesh_future_wait(busy[i], 2000) == SEA_MESH_TASK_DONE;
+        sea_mesh_future_free(busy[i]);
+    }
+    if (!ok) { FAIL("states"); return; }
+
+    /* The queued call is skipped on the crew, not run */
+    double deadline = wall_ms() + 2000;
+    do {
+        usleep(10 * 1000);
+        sea_mesh_server_stats(s_crew_srv, &after);
+    } while (after.abandoned == before.abandoned && wall_ms() < deadline);
+    if (after.abandoned != before.abandoned + 1 || after.tasks != before.tasks + 4) {
+        FAIL("crew still ran the cancelled call");
+        return;
+    }
+    if (s_captain.nodes[0].in_flight != 0) { FAIL("in-flight leak"); return; }
+    PASS();
+}
+
+int main(void) {
+    sea_log_init(SEA_LOG_ERROR);
+
+    printf("\n  \033[1mSea-Claw Mesh Routing Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════════\n\n");
+
+    test_route_by_capability();
+    test_index_after_registry_change();
+    test_skip_unhealthy();
+    test_least_outstanding();
+    test_release_after_remove();
+    test_latency_and_errors();
+    test_simulated_fleet();
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    test_server_needs_secret();
+    if (fleet_start()) {
+        test_e2e_register_dispatch();
+        test_e2e_token_required();
+        test_e2e_keepalive_pipeline();
+        test_e2e_worker_pool();
+        test_e2e_broadcast();
+        test_e2e_fanout();
+        test_e2e_future_stream();
+        test_e2e_future_fanin();
+        test_e2e_future_cancel();
+        fleet_stop();
+    } else {
+        TEST("e2e: start loopback captain and crew");
+        FAIL("cannot listen on 127.0.0.1");
+    }
+    curl_global_cleanup();
+
+    printf("\n  ────────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+/*
+ * test_metrics.c — Tests for the metrics registry and exposition
+ *
+ * Series semantics, Prometheus text rendering, concurrent updates,
+ * collectors and the loopback /metrics endpoint.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_arena.h"
+#include "seaclaw/sea_log.h"
+#include "seaclaw/sea_metrics.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-40s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+static SeaArena s_arena;
+
+/* Render everything as a NUL-terminated string in s_arena. */
+static const char* render(void) {
+    sea_arena_reset(&s_arena);
+    SeaSlice out;
+    if (sea_metrics_render(&s_arena, &out) != SEA_OK) return NULL;
+    char* s = (char*)sea_arena_alloc(&s_arena, out.len + 1, 1);
+    if (!s) return NULL;
+    memcpy(s, out.data, out.len);
+    s[out.len] = '\0';
+    return s;
+}
+
+/* ── Tests ────────────────────────────────────────────────── */
+
+static void test_counter(void) {
+    TEST("counter: lookup is stable, adds");
+    SeaMetric* a = sea_metric_counter("t_requests_total", "Requests", "tool", "echo");
+    SeaMetric* b = sea_metric_counter("t_requests_total", "Requests", "tool", "echo");
+    SeaMetric* c = sea_metric_counter("t_requests_total", "Requests", "tool", "shell");
+    if (!a || a != b || a == c) { FAIL("lookup"); return; }
+    sea_metric_inc(a);
+    sea_metric_add(a, 4);
+    sea_metric_inc(c);
+    if (sea_metric_value(a) != 5 || sea_metric_value(c) != 1) { FAIL("values"); return; }
+    PASS();
+}
+
+static void test_gauge(void) {
+    TEST("gauge: set and add, negative ok");
+    SeaMetric* g = sea_metric_gauge("t_depth", "Depth", NULL, NULL);
+    sea_metric_set(g, 10);
+    sea_metric_gauge_add(g, -15);
+    if (sea_metric_value(g) != -5) { FAIL("value"); return; }
+    const char* s = render();
+    if (!s || !strstr(s, "# TYPE t_depth gauge\nt_depth -5\n")) { FAIL("render"); return; }
+    PASS();
+}
+
+static void test_type_mismatch(void) {
+    TEST("same series, other type: NULL");
+    sea_metric_counter("t_kind", "Kind", NULL, NULL);
+    if (sea_metric_gauge("t_kind", "Kind", NULL, NULL) != NULL) { FAIL("got a series"); return; }
+    sea_metric_inc(NULL);                   /* NULL is always safe */
+    sea_metric_observe(NULL, 1.0);
+    PASS();
+}
+
+static void test_histogram(void) {
+    TEST("histogram: cumulative buckets");
+    static const SeaMetricBuckets b = { .bounds = { 0.1, 1, 10 }, .count = 3 };
+    SeaMetric* h = sea_metric_histogram("t_seconds", "Time", "op", "get", &b);
+    sea_metric_observe(h, 0.05);
+    sea_metric_observe(h, 0.1);             /* le is inclusive */
+    sea_metric_observe(h, 5);
+    sea_metric_observe(h, 100);
+    const char* s = render();
+    if (!s) { FAIL("render"); return; }
+    bool ok = strstr(s, "# HELP t_seconds Time\n# TYPE t_seconds histogram\n") &&
+              strstr(s, "t_seconds_bucket{op=\"get\",le=\"0.1\"} 2\n") &&
+              strstr(s, "t_seconds_bucket{op=\"get\",le=\"1\"} 2\n") &&
+              strstr(s, "t_seconds_bucket{op=\"get\",le=\"10\"} 3\n") &&
+              strstr(s, "t_seconds_bucket{op=\"get\",le=\"+Inf\"} 4\n") &&
+              strstr(s, "t_seconds_sum{op=\"get\"} 105.15\n") &&
+              strstr(s, "t_seconds_count{op=\"get\"} 4\n");
+    if (!ok) { FAIL("wrong lines"); return; }
+    PASS();
+}
+
+static void test_render_families(void) {
+    TEST("render: one HELP per family, escaped");
+    sea_metric_inc(sea_metric_counter("t_family_total", "Family", "k", "b"));
+    sea_metric_inc(sea_metric_counter("t_family_total", "Family", "k", "a\"q\\"));
+    const char* s = render();
+    if (!s) { FAIL("render"); return; }
+    const char* help = strstr(s, "# HELP t_family_total");
+    const char* a = strstr(s, "t_family_total{k=\"a\\\"q\\\\\"} 1\n");
+    const char* b = strstr(s, "t_family_total{k=\"b\"} 1\n");
+    if (!help || strstr(help + 1, "# HELP t_family_total")) { FAIL("HELP repeated"); return; }
+    if (!a || !b) { FAIL("escaping"); return; }
+    if (!(help < a && a < b)) { FAIL("not grouped/sorted"); return; }
+    PASS();
+}
+
+static void test_help_escaped(void) {
+    TEST("render: HELP escapes \\ and newline");
+    sea_metric_inc(sea_metric_counter("t_help_total", "Path C:\\tmp\nsecond \"line\"", NULL, NULL));
+    const char* s = render();
+    if (!s) { FAIL("render"); return; }
+    if (!strstr(s, "# HELP t_help_total Path C:\\\\tmp\\nsecond \"line\"\n# TYPE t_help_total counter\n")) {
+        FAIL("HELP not escaped"); return;
+    }
+    PASS();
+}
+
+#define THREADS 4
+#define PER_THREAD 100000
+
+static void* hammer(void* arg) {
+    (void)arg;
+    SeaMetric* c = sea_metric_counter("t_hammer_total", "Hammer", NULL, NULL);
+    SeaMetric* h = sea_metric_histogram("t_hammer_seconds", "Hammer", NULL, NULL,
+                                        &SEA_METRICS_FAST);
+    for (int i = 0; i < PER_THREAD; i++) {
+        sea_metric_inc(c);
+        sea_metric_observe(h, 0.001);
+    }
+    return NULL;
+}
+
+static void test_concurrent(void) {
+    TEST("concurrent updates are exact");
+    pthread_t th[THREADS];
+    for (int i = 0; i < THREADS; i++) pthread_create(&th[i], NULL, hammer, NULL);
+    for (int i = 0; i < THREADS; i++) pthread_join(th[i], NULL);
+    SeaMetric* c = sea_metric_counter("t_hammer_total", "Hammer", NULL, NULL);
+    SeaMetric* h = sea_metric_histogram("t_hammer_seconds", "Hammer", NULL, NULL, NULL);
+    if (sea_metric_value(c) != THREADS * PER_THREAD) { FAIL("counter lost adds"); return; }
+    if (sea_metric_value(h) != THREADS * PER_THREAD) { FAIL("histogram lost samples"); return; }
+    const char* s = render();
+    if (!s || !strstr(s, "t_hammer_seconds_sum 400\n")) { FAIL("sum drifted"); return; }
+    PASS();
+}
+
+static u32 s_collected;
+
+static void collect(void* ctx) {
+    s_collected++;
+    sea_metric_set(sea_metric_gauge("t_sampled", "Sampled", NULL, NULL), *(i64*)ctx);
+}
+
+static void test_collector_and_arenas(void) {
+    TEST("collectors run; named arenas exported");
+    static i64 sample = 42;
+    sea_metrics_on_collect(collect, &sample);
+    const char* s = render();
+    if (!s || s_collected != 1 || !strstr(s, "t_sampled 42\n")) { FAIL("collector"); return; }
+    if (!strstr(s, "sea_arena_high_water_bytes{arena=\"test.metrics\"}")) {
+        FAIL("arena series missing");
+        return;
+    }
+    PASS();
+}
+
+/* GET path on 127.0.0.1:port; returns the response in buf. */
+static bool http_get(u16 port, const char* path, char* buf, u32 cap) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    struct sockaddr_in addr = {
+        .sin_family      = AF_INET,
+        .sin_port        = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); return false; }
+    char req[128];
+    int n = snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: localhost\r\n\r\n", path);
+    if (write(fd, req, (size_t)n) != n) { close(fd); return false; }
+    u32 len = 0;
+    ssize_t r;
+    while (len < cap - 1 && (r = read(fd, buf + len, cap - 1 - len)) > 0) len += (u32)r;
+    buf[len] = '\0';
+    close(fd);
+    return len > 0;
+}
+
+static void test_endpoint(void) {
+    TEST("endpoint: /metrics 200, other 404");
+    u16 port = (u16)(40000 + getpid() % 20000);
+    if (sea_metrics_serve(port) != SEA_OK) { FAIL("listen"); return; }
+    static char buf[256 * 1024];
+    bool ok = http_get(port, "/metrics", buf, sizeof(buf)) &&
+              strncmp(buf, "HTTP/1.1 200 OK\r\n", 17) == 0 &&
+              strstr(buf, "Content-Type: text/plain; version=0.0.4") &&
+              strstr(buf, "t_depth -5\n");
+    bool missing = http_get(port, "/other", buf, sizeof(buf)) &&
+                   strncmp(buf, "HTTP/1.1 404", 12) == 0;
+    sea_metrics_stop();
+    if (!ok) { FAIL("bad /metrics response"); return; }
+    if (!missing) { FAIL("expected 404"); return; }
+    PASS();
+}
+
+/* ── Main ─────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_ERROR);
+
+    printf("\n  \033[1mSea-Claw Metrics Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════\n\n");
+
+    if (sea_arena_create_named(&s_arena, "test.metrics", 1024 * 1024) != SEA_OK) {
+        printf("  arena create failed\n");
+        return 1;
+    }
+
+    test_counter();
+    test_gauge();
+    test_type_mismatch();
+    test_histogram();
+    test_render_families();
+    test_help_escaped();
+    test_concurrent();
+    test_collector_and_arenas();
+    test_endpoint();
+
+    sea_arena_destroy(&s_arena);
+
+    printf("\n  ────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
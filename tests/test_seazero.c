@@ -1,8 +1,9 @@
 /*
  * test_seazero.c — SeaZero v3 database + bridge tests
  *
- * Tests the v3 schema tables (agents, tasks, llm_usage, audit)
- * and the bridge config/tool registration.
+ * Tests the v3 schema tables (agents, tasks, llm_usage, audit),
+ * the bridge config/tool registration and the LLM proxy end to end
+ * over loopback.
  */
 
 #include "seaclaw/sea_types.h"
@@ -10,10 +11,19 @@
 #include "seaclaw/sea_arena.h"
 #include "seaclaw/sea_log.h"
 #include "sea_zero.h"
+#include "sea_budget.h"
+#include "sea_proxy.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sqlite3.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
 
 static u32 s_pass = 0;
 static u32 s_fail = 0;
@@ -317,6 +327,85 @@ static void test_llm_total_tokens(void) {
     sea_db_close(db);
 }
 
+/* ── Budget Ledger Tests ─────────────────────────────────── */
+
+static void test_budget_load(void) {
+    TEST("budget ledger loads today's usage");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+
+    /* seaclaw has 2300 tokens logged today (test_llm_log) */
+    SeaBudget* b = sea_budget_create(db, 2500);
+    if (!b) { FAIL("create failed"); sea_db_close(db); return; }
+
+    i64 used = 0;
+    if (!sea_budget_allow(b, "seaclaw", &used) || used != 2300) {
+        FAIL("loaded total mismatch"); sea_budget_destroy(b); sea_db_close(db); return;
+    }
+    if (sea_budget_used(b, "nobody") != 0) {
+        FAIL("unknown caller not 0"); sea_budget_destroy(b); sea_db_close(db); return;
+    }
+
+    PASS();
+    sea_budget_destroy(b);
+    sea_db_close(db);
+}
+
+static void test_budget_record(void) {
+    TEST("budget ledger records and writes back");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+
+    SeaBudget* b = sea_budget_create(db, 2500);
+    SeaBudgetRecord rec = {
+        .caller = "seaclaw", .provider = "openrouter", .model = "kimi-k2.5",
+        .tokens_in = 150, .tokens_out = 50, .latency_ms = 12, .status = "ok",
+    };
+    sea_budget_record(b, &rec);
+
+    /* 2300 + 200 reaches the limit without waiting for the DB */
+    if (sea_budget_allow(b, "seaclaw", NULL)) {
+        FAIL("limit not enforced"); sea_budget_destroy(b); sea_db_close(db); return;
+    }
+    sea_budget_destroy(b);
+
+    if (sea_db_sz_llm_total_tokens(db, "seaclaw") != 2500) {
+        FAIL("row not written back"); sea_db_close(db); return;
+    }
+
+    PASS();
+    sea_db_close(db);
+}
+
+static void test_budget_table_full(void) {
+    TEST("budget ledger holds overflow callers to the limit");
+    SeaBudget* b = sea_budget_create(NULL, 1000);
+    if (!b) { FAIL("create failed"); return; }
+
+    char name[32];
+    SeaBudgetRecord rec = { .provider = "openrouter", .model = "kimi-k2.5",
+                            .tokens_in = 1, .status = "ok" };
+    for (int i = 0; i < SEA_BUDGET_CALLERS; i++) {
+        snprintf(name, sizeof(name), "agent-%d", i);
+        rec.caller = name;
+        sea_budget_record(b, &rec);
+    }
+
+    /* Table full: later callers are charged to one shared total */
+    rec.caller = "flood-1";
+    rec.tokens_in = 1000;
+    sea_budget_record(b, &rec);
+    if (sea_budget_allow(b, "flood-1", NULL) || sea_budget_allow(b, "flood-2", NULL)) {
+        FAIL("overflow caller not denied"); sea_budget_destroy(b); return;
+    }
+    if (!sea_budget_allow(b, "agent-0", NULL) || sea_budget_used(b, "agent-0") != 1) {
+        FAIL("table caller affected"); sea_budget_destroy(b); return;
+    }
+
+    PASS();
+    sea_budget_destroy(b);
+}
+
 /* ── Audit Tests ─────────────────────────────────────────── */
 
 static void test_audit_log(void) {
@@ -409,6 +498,276 @@ static void test_bridge_delegate_empty_task(void) {
     sea_arena_destroy(&arena);
 }
 
+/* ── Proxy Tests ─────────────────────────────────────────── */
+
+/* A loopback port nothing is listening on */
+static u16 free_port(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { .sin_family = AF_INET };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t alen = sizeof(addr);
+    u16 port = 0;
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0 &&
+        getsockname(fd, (struct sockaddr*)&addr, &alen) == 0)
+        port = ntohs(addr.sin_port);
+    close(fd);
+    return port;
+}
+
+static int dial(u16 port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(port) };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    struct timeval tv = { .tv_sec = 5 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); return -1; }
+    return fd;
+}
+
+/* Send one raw request and read until the proxy closes. If mark is
+ * set, *seen is raised as soon as it shows up in the reply. */
+static size_t proxy_exchange(u16 port, const char* req, char* out, size_t cap,
+                             const char* mark, _Atomic bool* seen) {
+    int fd = dial(port);
+    if (fd < 0) return 0;
+    size_t len = strlen(req);
+    if (write(fd, req, len) != (ssize_t)len) { close(fd); return 0; }
+    size_t got = 0;
+    ssize_t n;
+    while (got + 1 < cap && (n = read(fd, out + got, cap - got - 1)) > 0) {
+        got += (size_t)n;
+        out[got] = '\0';
+        if (mark && strstr(out, mark)) atomic_store(seen, true);
+    }
+    out[got] = '\0';
+    close(fd);
+    return got;
+}
+
+static i64 audit_count(SeaDb* db, const char* event_type) {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(sea_db_handle(db),
+            "SELECT COUNT(*) FROM seazero_audit WHERE event_type = ?",
+            -1, &stmt, NULL) != SQLITE_OK) return -1;
+    sqlite3_bind_text(stmt, 1, event_type, -1, SQLITE_STATIC);
+    i64 n = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : -1;
+    sqlite3_finalize(stmt);
+    return n;
+}
+
+/* Fake LLM provider: answers `requests` calls, one per connection. In
+ * SSE mode it sends the first event, then holds the rest until the
+ * client has seen it (or 3s pass), so a proxy that buffers the whole
+ * body fails the test instead of hanging it. */
+typedef struct {
+    int           fd;
+    u16           port;
+    bool          sse;
+    u32           requests;
+    _Atomic bool  first_seen;      /* Raised by the client */
+    bool          held;            /* Rest sent only after first_seen */
+    char          body[2048];      /* Last request body */
+    pthread_t     tid;
+} Upstream;
+
+static const char SSE_HEAD[] =
+    "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nConnection: close\r\n\r\n";
+static const char SSE_FIRST[] = "data: {\"choices\":[{\"delta\":{\"content\":\"Hel\"}}]}\n\n";
+static const char SSE_REST[] =
+    "data: {\"choices\":[{\"delta\":{\"content\":\"lo\"}}]}\n\n"
+    "data: {\"choices\":[],\"usage\":{\"prompt_tokens\":7,\"completion_tokens\":3}}\n\n"
+    "data: [DONE]\n\n";
+static const char JSON_REPLY[] =
+    "{\"choices\":[{\"message\":{\"content\":\"hi\"}}],"
+    "\"usage\":{\"prompt_tokens\":100,\"completion_tokens\":50}}";
+
+static void send_all(int fd, const char* p, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n <= 0) return;
+        p += n;
+        len -= (size_t)n;
+    }
+}
+
+static void* upstream_main(void* arg) {
+    Upstream* u = (Upstream*)arg;
+    for (u32 r = 0; r < u->requests; r++) {
+        int c = accept(u->fd, NULL, NULL);
+        if (c < 0) break;
+        char buf[4096];
+        size_t got = 0;
+        char* head_end = NULL;
+        ssize_t n;
+        while (got + 1 < sizeof(buf) && (n = read(c, buf + got, sizeof(buf) - got - 1)) > 0) {
+            got += (size_t)n;
+            buf[got] = '\0';
+            if (!head_end) head_end = strstr(buf, "\r\n\r\n");
+            if (!head_end) continue;
+            const char* cl = strcasestr(buf, "Content-Length:");
+            size_t want = cl ? strtoul(cl + 15, NULL, 10) : 0;
+            if (got >= (size_t)(head_end + 4 - buf) + want) break;
+        }
+        if (head_end) snprintf(u->body, sizeof(u->body), "%s", head_end + 4);
+
+        if (u->sse) {
+            send_all(c, SSE_HEAD, sizeof(SSE_HEAD) - 1);
+            send_all(c, SSE_FIRST, sizeof(SSE_FIRST) - 1);
+            for (int i = 0; i < 300 && !atomic_load(&u->first_seen); i++) usleep(10000);
+            u->held = atomic_load(&u->first_seen);
+            send_all(c, SSE_REST, sizeof(SSE_REST) - 1);
+        } else {
+            char head[256];
+            int hl = snprintf(head, sizeof(head),
+                              "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                              "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+                              sizeof(JSON_REPLY) - 1);
+            send_all(c, head, (size_t)hl);
+            send_all(c, JSON_REPLY, sizeof(JSON_REPLY) - 1);
+        }
+        close(c);
+    }
+    return NULL;
+}
+
+static bool upstream_start(Upstream* u, bool sse, u32 requests) {
+    memset(u, 0, sizeof(*u));
+    u->sse = sse;
+    u->requests = requests;
+    u->fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { .sin_family = AF_INET };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t alen = sizeof(addr);
+    if (bind(u->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(u->fd, 8) != 0 ||
+        getsockname(u->fd, (struct sockaddr*)&addr, &alen) != 0) {
+        close(u->fd);
+        return false;
+    }
+    u->port = ntohs(addr.sin_port);
+    return pthread_create(&u->tid, NULL, upstream_main, u) == 0;
+}
+
+/* Unblocks accept() if fewer requests came than expected */
+static void upstream_stop(Upstream* u) {
+    shutdown(u->fd, SHUT_RDWR);
+    pthread_join(u->tid, NULL);
+    close(u->fd);
+}
+
+static void proxy_config(SeaProxyConfig* cfg, char* url, size_t url_cap,
+                         u16 upstream_port, SeaDb* db, i64 budget) {
+    snprintf(url, url_cap, "http://127.0.0.1:%u/v1/chat/completions", upstream_port);
+    *cfg = (SeaProxyConfig){
+        .port = free_port(), .internal_token = "sz-internal", .real_api_url = url,
+        .real_api_key = "sk-real", .real_provider = "openai", .real_model = "gpt-4o-mini",
+        .daily_token_budget = budget, .db = db, .workers = 1, .enabled = true,
+    };
+}
+
+static void chat_request(char* req, size_t cap, const char* body) {
+    snprintf(req, cap,
+             "POST /v1/chat/completions HTTP/1.1\r\nAuthorization: Bearer sz-internal\r\n"
+             "Content-Length: %zu\r\nConnection: close\r\n\r\n%s", strlen(body), body);
+}
+
+static void test_proxy_health_and_auth(void) {
+    TEST("proxy answers health, rejects bad token");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+
+    SeaProxyConfig cfg;
+    char url[64];
+    proxy_config(&cfg, url, sizeof(url), free_port(), db, 0);   /* No upstream */
+    if (sea_proxy_start(&cfg) != 0) { FAIL("start failed"); sea_db_close(db); return; }
+
+    char resp[4096];
+    proxy_exchange(cfg.port, "GET /health HTTP/1.1\r\nConnection: close\r\n\r\n",
+                   resp, sizeof(resp), NULL, NULL);
+    bool health_ok = strncmp(resp, "HTTP/1.1 200", 12) == 0 && strstr(resp, "seazero-proxy");
+
+    const char* body = "{\"model\":\"gpt-4o-mini\",\"messages\":[]}";
+    char req[512];
+    snprintf(req, sizeof(req),
+             "POST /v1/chat/completions HTTP/1.1\r\nAuthorization: Bearer wrong\r\n"
+             "Content-Length: %zu\r\nConnection: close\r\n\r\n%s", strlen(body), body);
+    proxy_exchange(cfg.port, req, resp, sizeof(resp), NULL, NULL);
+    bool auth_ok = strncmp(resp, "HTTP/1.1 401", 12) == 0;
+
+    sea_proxy_stop();
+    if (!health_ok) FAIL("health reply");
+    else if (!auth_ok) FAIL("bad token not rejected");
+    else if (audit_count(db, "auth_failure") != 1) FAIL("auth failure not audited");
+    else if (audit_count(db, "proxy_start") != 1 || audit_count(db, "proxy_stop") != 1)
+        FAIL("start/stop not audited");
+    else PASS();
+    sea_db_close(db);
+}
+
+static void test_proxy_stream_relay(void) {
+    TEST("proxy relays a stream as it arrives");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+    Upstream up;
+    if (!upstream_start(&up, true, 1)) { FAIL("upstream"); sea_db_close(db); return; }
+
+    SeaProxyConfig cfg;
+    char url[64];
+    proxy_config(&cfg, url, sizeof(url), up.port, db, 0);
+    if (sea_proxy_start(&cfg) != 0) {
+        FAIL("start failed"); upstream_stop(&up); sea_db_close(db); return;
+    }
+
+    char req[512], resp[8192];
+    chat_request(req, sizeof(req), "{\"model\":\"gpt-4o-mini\",\"stream\":true,\"messages\":[]}");
+    proxy_exchange(cfg.port, req, resp, sizeof(resp), "\"Hel\"", &up.first_seen);
+    upstream_stop(&up);
+    sea_proxy_stop();                            /* Writes the usage row */
+
+    if (strncmp(resp, "HTTP/1.1 200", 12) != 0 || !strstr(resp, "Transfer-Encoding: chunked"))
+        FAIL("not a chunked reply");
+    else if (!up.held) FAIL("first event not relayed before the upstream finished");
+    else if (!strstr(resp, "\"lo\"") || !strstr(resp, "[DONE]")) FAIL("events missing");
+    else if (!strstr(resp, "\r\n0\r\n\r\n")) FAIL("no terminating chunk");
+    else if (!strstr(up.body, "\"stream_options\":{\"include_usage\":true}"))
+        FAIL("usage not requested upstream");
+    else if (sea_db_sz_llm_total_tokens(db, "agent-zero") != 10) FAIL("stream usage not logged");
+    else PASS();
+    sea_db_close(db);
+}
+
+static void test_proxy_budget_rejection(void) {
+    TEST("proxy rejects calls over the daily budget");
+    SeaDb* db = NULL;
+    sea_db_open(&db, TEST_DB_PATH);
+    Upstream up;
+    if (!upstream_start(&up, false, 2)) { FAIL("upstream"); sea_db_close(db); return; }
+
+    /* agent-zero starts at 10 (stream test); one call adds 150 */
+    SeaProxyConfig cfg;
+    char url[64];
+    proxy_config(&cfg, url, sizeof(url), up.port, db, 100);
+    if (sea_proxy_start(&cfg) != 0) {
+        FAIL("start failed"); upstream_stop(&up); sea_db_close(db); return;
+    }
+
+    char req[512], first[4096], second[4096];
+    chat_request(req, sizeof(req), "{\"model\":\"gpt-4o-mini\",\"messages\":[\"one\"]}");
+    proxy_exchange(cfg.port, req, first, sizeof(first), NULL, NULL);
+    chat_request(req, sizeof(req), "{\"model\":\"gpt-4o-mini\",\"messages\":[\"two\"]}");
+    up.body[0] = '\0';
+    proxy_exchange(cfg.port, req, second, sizeof(second), NULL, NULL);
+    bool forwarded = up.body[0] != '\0';
+    upstream_stop(&up);
+    sea_proxy_stop();
+
+    if (strncmp(first, "HTTP/1.1 200", 12) != 0) FAIL("call under budget refused");
+    else if (strncmp(second, "HTTP/1.1 429", 12) != 0) FAIL("call over budget not refused");
+    else if (forwarded) FAIL("rejected call reached the provider");
+    else if (audit_count(db, "budget_exceeded") != 1) FAIL("rejection not audited");
+    else if (sea_db_sz_llm_total_tokens(db, "agent-zero") != 160) FAIL("usage not logged");
+    else PASS();
+    sea_db_close(db);
+}
 
 /* ── Main ────────────────────────────────────────────────── */
 
@@ -439,6 +798,11 @@ int main(void) {
     test_llm_log();
     test_llm_total_tokens();
 
+    /* Budget ledger */
+    test_budget_load();
+    test_budget_record();
+    test_budget_table_full();
+
     /* Audit */
     test_audit_log();
     test_audit_null_target();
@@ -449,6 +813,10 @@ int main(void) {
     test_bridge_delegate_disabled();
     test_bridge_delegate_empty_task();
 
+    /* Proxy */
+    test_proxy_health_and_auth();
+    test_proxy_stream_relay();
+    test_proxy_budget_rejection();
 
     printf("\n  ────────────────────────────────────────────────────\n");
     printf("  Results: \033[32m%u passed\033[0m", s_pass);
@@ -18,9 +18,13 @@
 #include "seaclaw/sea_tools.h"
 #include "seaclaw/sea_memory.h"
 #include "seaclaw/sea_recall.h"
+#include "seaclaw/sea_usage.h"
+#include "seaclaw/sea_llm_cache.h"
 SeaDb* s_db = NULL;
 SeaMemory* s_memory = NULL;
 SeaRecall* s_recall = NULL;
+SeaUsageTracker* s_usage = NULL;
+SeaLlmCache* s_llm_cache = NULL;
 const char* sea_memory_read_bootstrap(SeaMemory* m, const char* f) { (void)m; (void)f; return NULL; }
 const char* sea_recall_build_context(SeaRecall* r, const char* q, SeaArena* a) { (void)r; (void)q; (void)a; return NULL; }
 SeaError sea_tool_exec(const char* n, SeaSlice a, SeaArena* ar, SeaSlice* o) {
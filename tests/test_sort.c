@@ -0,0 +1,199 @@
+/*
+ * test_sort.c — Tests for the sort engine
+ *
+ * String and numeric ordering, stability, reverse, unique, field
+ * keys, and spilled runs matching the in-memory result.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_sort.h"
+#include "seaclaw/sea_arena.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-40s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+static SeaArena s_arena;
+
+/* Collects output as "a,b,c" */
+typedef struct {
+    char buf[4096];
+    u32  len;
+} Joined;
+
+static bool join(const u8* line, u32 len, void* ctx) {
+    Joined* j = (Joined*)ctx;
+    if (j->len + len + 2 >= sizeof(j->buf)) return false;
+    if (j->len) j->buf[j->len++] = ',';
+    memcpy(j->buf + j->len, line, len);
+    j->len += len;
+    j->buf[j->len] = '\0';
+    return true;
+}
+
+static const char* sort_str(const char* text, u32 flags, u32 field, char sep) {
+    static Joined j;
+    memset(&j, 0, sizeof(j));
+    SeaSortOpts o = { .flags = flags, .key_field = field, .separator = sep };
+    if (sea_sort_buffer((const u8*)text, strlen(text), &o, &s_arena, join, &j, NULL) != SEA_OK) {
+        return "(error)";
+    }
+    return j.buf;
+}
+
+/* ── Tests ────────────────────────────────────────────────── */
+
+static void test_strings(void) {
+    TEST("byte order, shared long prefixes");
+    const char* r = sort_str("prefix_long_b\nb\nprefix_long_a\n\nA\nprefix_lo\nab\n", 0, 0, 0);
+    if (strcmp(r, "A,ab,b,prefix_lo,prefix_long_a,prefix_long_b") != 0) { FAIL(r); return; }
+    PASS();
+}
+
+static void test_numeric(void) {
+    TEST("numeric: signs, decimals, exponents");
+    const char* r = sort_str("10\n-2.5\n3\n1e2\nx\n0.25\n-10\n", SEA_SORT_NUMERIC, 0, 0);
+    if (strcmp(r, "-10,-2.5,x,0.25,3,10,1e2") != 0) { FAIL(r); return; }
+    PASS();
+}
+
+static void test_stable_reverse(void) {
+    TEST("stable ties, reverse");
+    const char* r = sort_str("2 b\n1 a\n2 a\n1 b\n", SEA_SORT_NUMERIC, 0, 0);
+    if (strcmp(r, "1 a,1 b,2 b,2 a") != 0) { FAIL("numeric ties"); return; }
+    r = sort_str("b\nc\na\n", SEA_SORT_REVERSE, 0, 0);
+    if (strcmp(r, "c,b,a") != 0) { FAIL("reverse"); return; }
+    r = sort_str("1 x\n3 y\n1 z\n", SEA_SORT_NUMERIC | SEA_SORT_REVERSE, 0, 0);
+    if (strcmp(r, "3 y,1 x,1 z") != 0) { FAIL("reverse keeps tie order"); return; }
+    PASS();
+}
+
+static void test_unique(void) {
+    TEST("unique by key");
+    const char* r = sort_str("a\nb\na\nc\nb\n", SEA_SORT_UNIQUE, 0, 0);
+    if (strcmp(r, "a,b,c") != 0) { FAIL("strings"); return; }
+    r = sort_str("1.0\n1\n2\n", SEA_SORT_UNIQUE | SEA_SORT_NUMERIC, 0, 0);
+    if (strcmp(r, "1.0,2") != 0) { FAIL("numeric"); return; }
+    PASS();
+}
+
+static void test_fields(void) {
+    TEST("field keys, blank and explicit separator");
+    const char* r = sort_str("  x  30 a\ny 4 b\nz 100 c\n", SEA_SORT_NUMERIC, 2, 0);
+    if (strcmp(r, "y 4 b,  x  30 a,z 100 c") != 0) { FAIL(r); return; }
+    r = sort_str("a,zeta\nb,alpha\nc\n", 0, 2, ',');
+    if (strcmp(r, "c,b,alpha,a,zeta") != 0) { FAIL(r); return; }
+    PASS();
+}
+
+/* Hash of the emitted order, for comparing large outputs */
+typedef struct { u64 h; u64 n; } Digest;
+
+static bool digest(const u8* line, u32 len, void* ctx) {
+    Digest* d = (Digest*)ctx;
+    for (u32 i = 0; i < len; i++) d->h = (d->h ^ line[i]) * 0x100000001b3ULL;
+    d->h = (d->h ^ '\n') * 0x100000001b3ULL;
+    d->n++;
+    return true;
+}
+
+static void test_spill(void) {
+    TEST("spilled runs match in-memory sort");
+    u32 n = 50000;
+    char* text = (char*)malloc((u64)n * 24);
+    u64 len = 0;
+    u32 x = 1;
+    for (u32 i = 0; i < n; i++) {
+        x = x * 1103515245u + 12345u;
+        len += (u64)sprintf(text + len, "%u key%05u\n", (x >> 8) % 1000, (x >> 4) % 20000);
+    }
+
+    SeaArena big;
+    sea_arena_create(&big, 32 * 1024 * 1024);
+    u32 modes[] = { 0, SEA_SORT_NUMERIC, SEA_SORT_UNIQUE | SEA_SORT_REVERSE };
+    for (u32 m = 0; m < 3; m++) {
+        Digest a = {0xcbf29ce484222325ULL, 0}, b = a;
+        SeaSortOpts o = { .flags = modes[m], .key_field = m == 2 ? 2 : 0 };
+        SeaSortStats sa, sb;
+        sea_sort_buffer((const u8*)text, len, &o, &big, digest, &a, &sa);
+        o.run_lines = 3000;
+        sea_sort_buffer((const u8*)text, len, &o, &big, digest, &b, &sb);
+        if (sa.runs != 0 || sb.runs < 16) { FAIL("run count"); goto done; }
+        if (a.n != b.n || a.h != b.h)     { FAIL("order differs"); goto done; }
+        if (big.offset != 0)              { FAIL("arena not released"); goto done; }
+    }
+    PASS();
+done:
+    sea_arena_destroy(&big);
+    free(text);
+}
+
+static void test_spill_small_arena(void) {
+    TEST("small arena: more runs than first sized");
+    /* 512 KB: the spill writer buffer roughly halves the run size */
+    u32 n = 20000;
+    char* text = (char*)malloc((u64)n * 16);
+    u64 len = 0;
+    u32 x = 7;
+    for (u32 i = 0; i < n; i++) {
+        x = x * 1103515245u + 12345u;
+        len += (u64)sprintf(text + len, "k%08u\n", (x >> 4) % 10000000);
+    }
+
+    SeaArena big, small;
+    sea_arena_create(&big, 32 * 1024 * 1024);
+    sea_arena_create(&small, 512 * 1024);
+    Digest a = {0xcbf29ce484222325ULL, 0}, b = a;
+    SeaSortOpts o = { .flags = 0 };
+    SeaSortStats sa, sb;
+    SeaError ea = sea_sort_buffer((const u8*)text, len, &o, &big, digest, &a, &sa);
+    SeaError eb = sea_sort_buffer((const u8*)text, len, &o, &small, digest, &b, &sb);
+    if (ea != SEA_OK || eb != SEA_OK) { FAIL("sort failed"); goto done; }
+    if (sb.runs < 6)                  { FAIL("expected several runs"); goto done; }
+    if (a.n != b.n || a.h != b.h)     { FAIL("order differs"); goto done; }
+    PASS();
+done:
+    sea_arena_destroy(&small);
+    sea_arena_destroy(&big);
+    free(text);
+}
+
+/* ── Main ─────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_WARN);
+    sea_arena_create(&s_arena, 1024 * 1024);
+
+    printf("\n  \033[1mSea-Claw Sort Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════\n\n");
+
+    test_strings();
+    test_numeric();
+    test_stable_reverse();
+    test_unique();
+    test_fields();
+    test_spill();
+    test_spill_small_arena();
+
+    sea_arena_destroy(&s_arena);
+
+    printf("\n  ────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * test_trace.c — Tests for request spans and Chrome trace export
+ *
+ * Sampling, request/round tagging, nesting, ring wrap, per-thread
+ * rings and the cost of a span.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_log.h"
+#include "seaclaw/sea_trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-40s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+static char* s_json;
+
+/* Export everything into s_json. */
+static bool export_all(u32* spans) {
+    free(s_json);
+    s_json = NULL;
+    size_t len = 0;
+    FILE* f = open_memstream(&s_json, &len);
+    if (!f) return false;
+    SeaError err = sea_trace_export(f, spans);
+    fclose(f);
+    return err == SEA_OK && s_json;
+}
+
+/* Occurrences of needle in s_json */
+static u32 count(const char* needle) {
+    u32 n = 0;
+    for (const char* p = s_json; (p = strstr(p, needle)); p += strlen(needle)) n++;
+    return n;
+}
+
+static void span(const char* name) {
+    sea_trace_end(sea_trace_begin(name));
+}
+
+/* ── Tests ────────────────────────────────────────────────── */
+
+static void test_outside_request(void) {
+    TEST("no spans outside a request");
+    span("t.stray");
+    u32 n = 99;
+    if (!export_all(&n)) { FAIL("export"); return; }
+    if (n != 0 || count("t.stray")) { FAIL("span recorded"); return; }
+    if (strncmp(s_json, "{\"traceEvents\":[", 16) != 0) { FAIL("header"); return; }
+    PASS();
+}
+
+static void test_request_tags(void) {
+    TEST("spans carry session, request, round");
+    sea_trace_request_begin("telegram:42");
+    span("t.shield");
+    sea_trace_round(2);
+    span("t.llm");
+    sea_trace_request_end();
+    u32 n = 0;
+    if (!export_all(&n)) { FAIL("export"); return; }
+    if (n != 3) { FAIL("expected 3 spans"); return; }
+    const char* shield = strstr(s_json, "\"name\":\"t.shield\"");
+    const char* llm    = strstr(s_json, "\"name\":\"t.llm\"");
+    const char* req    = strstr(s_json, "\"name\":\"request\"");
+    if (!shield || !llm || !req) { FAIL("span missing"); return; }
+    if (!strstr(shield, "\"ph\":\"X\"") ||
+        !strstr(shield, "\"args\":{\"session\":\"telegram:42\",\"request\":1,\"round\":0}")) {
+        FAIL("shield tags");
+        return;
+    }
+    if (!strstr(llm, "\"session\":\"telegram:42\",\"request\":1,\"round\":2}")) {
+        FAIL("round tag");
+        return;
+    }
+    PASS();
+}
+
+static void test_nested_request(void) {
+    TEST("nested request joins the outer one");
+    sea_trace_request_begin("outer");
+    sea_trace_request_begin("inner");
+    span("t.nested");
+    sea_trace_request_end();
+    span("t.after_inner");                  /* Still inside outer */
+    sea_trace_request_end();
+    span("t.after_outer");
+    if (!export_all(NULL)) { FAIL("export"); return; }
+    if (count("\"session\":\"inner\"")) { FAIL("inner request opened"); return; }
+    if (count("\"session\":\"outer\"") != 3) { FAIL("outer spans"); return; }
+    if (count("t.after_outer")) { FAIL("span after end"); return; }
+    PASS();
+}
+
+static void test_sampling(void) {
+    TEST("sampling traces 1 request in N");
+    sea_trace_init(4);
+    for (int i = 0; i < 12; i++) {
+        sea_trace_request_begin("sampled");
+        span("t.sampled");
+        sea_trace_request_end();
+    }
+    sea_trace_init(0);
+    sea_trace_request_begin("off");
+    span("t.off");
+    sea_trace_request_end();
+    sea_trace_init(1);
+    if (!export_all(NULL)) { FAIL("export"); return; }
+    if (count("\"name\":\"t.sampled\"") != 3) { FAIL("expected 3 of 12"); return; }
+    if (count("t.off")) { FAIL("traced while off"); return; }
+    PASS();
+}
+
+static void test_ring_wrap(void) {
+    TEST("ring keeps the most recent spans");
+    sea_trace_request_begin("wrap");
+    for (int i = 0; i < SEA_TRACE_RING + 100; i++) span("t.wrap");
+    span("t.last");
+    sea_trace_request_end();
+    u32 n = 0;
+    if (!export_all(&n)) { FAIL("export"); return; }
+    /* A full ring exports RING - 1: the oldest slot is the next write */
+    if (n != SEA_TRACE_RING - 1) { FAIL("span count"); return; }
+    if (count("\"name\":\"t.wrap\"") != SEA_TRACE_RING - 3) { FAIL("wrap count"); return; }
+    if (!count("t.last") || !count("\"session\":\"wrap\"")) { FAIL("newest lost"); return; }
+    PASS();
+}
+
+#define THREADS 4
+
+static void* traced_thread(void* arg) {
+    char key[32];
+    snprintf(key, sizeof(key), "thread:%d", (int)(intptr_t)arg);
+    sea_trace_request_begin(key);
+    for (int i = 0; i < 10; i++) span("t.thread");
+    sea_trace_request_end();
+    return NULL;
+}
+
+static void test_threads(void) {
+    TEST("each thread writes its own ring");
+    pthread_t th[THREADS];
+    for (int i = 0; i < THREADS; i++)
+        pthread_create(&th[i], NULL, traced_thread, (void*)(intptr_t)i);
+    for (int i = 0; i < THREADS; i++) pthread_join(th[i], NULL);
+    if (!export_all(NULL)) { FAIL("export"); return; }
+    if (count("\"name\":\"t.thread\"") != THREADS * 10) { FAIL("spans lost"); return; }
+    for (int i = 0; i < THREADS; i++) {
+        char key[48];
+        snprintf(key, sizeof(key), "\"session\":\"thread:%d\"", i);
+        if (count(key) != 11) { FAIL("session tags"); return; }
+    }
+    /* Four distinct tids besides the main thread's */
+    u32 tids = 0;
+    for (u32 tid = 1; tid <= 16; tid++) {
+        char needle[64];
+        snprintf(needle, sizeof(needle), "\"tid\":%u,\"args\":{\"session\":\"thread:", tid);
+        if (count(needle)) tids++;
+    }
+    if (tids != THREADS) { FAIL("tids not distinct"); return; }
+    PASS();
+}
+
+static void test_dump(void) {
+    TEST("dump writes a file");
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/seaclaw_trace_test_%d.json", (int)getpid());
+    u32 n = 0;
+    if (sea_trace_dump(path, &n) != SEA_OK || n == 0) { FAIL("dump"); return; }
+    FILE* f = fopen(path, "r");
+    char head[32] = {0};
+    bool ok = f && fread(head, 1, 16, f) == 16 && strcmp(head, "{\"traceEvents\":[") == 0;
+    if (f) fclose(f);
+    remove(path);
+    if (!ok) { FAIL("bad file"); return; }
+    if (sea_trace_dump("/nonexistent/dir/trace.json", NULL) != SEA_ERR_IO) {
+        FAIL("expected IO error");
+        return;
+    }
+    PASS();
+}
+
+#define BENCH_SPANS 1000000
+
+static u64 now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+/* Best of three runs, ns per iteration */
+static f64 bench_spans(void) {
+    f64 best = 1e9;
+    for (int r = 0; r < 3; r++) {
+        u64 t0 = now_ns();
+        for (int i = 0; i < BENCH_SPANS; i++) span("t.bench");
+        f64 ns = (f64)(now_ns() - t0) / BENCH_SPANS;
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+static f64 bench_ticks(void) {
+    f64 best = 1e9;
+    volatile u64 sink = 0;
+    for (int r = 0; r < 3; r++) {
+        u64 t0 = now_ns();
+        for (int i = 0; i < BENCH_SPANS; i++) sink += sea_trace_ticks();
+        f64 ns = (f64)(now_ns() - t0) / BENCH_SPANS;
+        if (ns < best) best = ns;
+    }
+    (void)sink;
+    return best;
+}
+
+static void test_span_cost(void) {
+    TEST("span cost (enabled)");
+    sea_trace_request_begin("bench");
+    f64 ns = bench_spans();
+    sea_trace_request_end();
+    f64 tick = bench_ticks();
+    printf("%.1f ns/span, %.1f ns/tick ", ns, tick);
+#if defined(__OPTIMIZE__) && !defined(__SANITIZE_ADDRESS__)
+    /* Budget: 50ns, or, where one counter read alone costs more than
+     * 20ns (some VMs), the two reads plus 10ns of bookkeeping. */
+    f64 budget = 2 * tick + 10.0 > 50.0 ? 2 * tick + 10.0 : 50.0;
+#else
+    f64 budget = 5000.0;                    /* Unoptimised or sanitized */
+#endif
+    if (ns > budget) { FAIL("over budget"); return; }
+    PASS();
+}
+
+/* ── Main ─────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_ERROR);
+
+    printf("\n  \033[1mSea-Claw Trace Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════\n\n");
+
+    sea_trace_init(1);
+
+    test_outside_request();
+    test_request_tags();
+    test_nested_request();
+    test_sampling();
+    test_ring_wrap();
+    test_threads();
+    test_dump();
+    test_span_cost();
+
+    free(s_json);
+
+    printf("\n  ────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+/*
+ * test_usage.c — Tests for sharded usage counters and latency histograms
+ */
+
+#include "seaclaw/sea_usage.h"
+#include "seaclaw/sea_db.h"
+#include "seaclaw/sea_log.h"
+
+#include <sqlite3.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define TEST_DB "/tmp/test_usage.db"
+
+static int s_pass = 0;
+static int s_fail = 0;
+
+#define TEST(name) printf("  [TEST] %s ... ", name)
+#define PASS() do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+#define FAIL(msg) do { printf("\033[31mFAIL: %s\033[0m\n", msg); s_fail++; } while(0)
+
+#define THREADS 8
+#define PER_THREAD 20000
+
+static SeaUsageTracker s_tracker;
+
+static const char* s_names[] = { "OpenAI", "Anthropic", "Gemini", "Local" };
+
+static void* record_worker(void* arg) {
+    u32 id = (u32)(uintptr_t)arg;
+    for (u32 i = 0; i < PER_THREAD; i++) {
+        /* Every thread walks the providers from a different start so
+         * first use of each name races across threads. */
+        const char* name = s_names[(id + i) % 4];
+        sea_usage_record(&s_tracker, name, 3, 5, (i % 10) == 0);
+    }
+    return NULL;
+}
+
+/* ── Test: Concurrent recording is exact ─────────────────── */
+
+static void test_concurrent(void) {
+    TEST("concurrent_exact_totals");
+    sea_usage_init(&s_tracker, NULL);
+
+    pthread_t th[THREADS];
+    for (u32 i = 0; i < THREADS; i++)
+        pthread_create(&th[i], NULL, record_worker, (void*)(uintptr_t)i);
+    for (u32 i = 0; i < THREADS; i++) pthread_join(th[i], NULL);
+
+    u64 requests = 0, errors = 0;
+    u32 found = 0;
+    for (u32 i = 0; i < 4; i++) {
+        SeaUsageProvider p;
+        if (!sea_usage_provider(&s_tracker, s_names[i], &p)) continue;
+        found++;
+        requests += p.requests;
+        errors += p.errors;
+    }
+
+    u64 expect = (u64)THREADS * PER_THREAD;
+    u64 tokens = sea_usage_total_tokens(&s_tracker);
+    sea_usage_destroy(&s_tracker);
+
+    if (found != 4) { FAIL("provider interned twice or lost"); return; }
+    if (requests != expect) { FAIL("request count drifted"); return; }
+    if (errors != expect / 10) { FAIL("error count drifted"); return; }
+    if (tokens != expect * 8) { FAIL("token total drifted"); return; }
+    PASS();
+}
+
+/* ── Test: Unknown provider ──────────────────────────────── */
+
+static void test_unknown(void) {
+    TEST("unknown_provider");
+    sea_usage_init(&s_tracker, NULL);
+    SeaUsageProvider p;
+    bool got = sea_usage_provider(&s_tracker, "Nobody", &p);
+    SeaUsageDay d;
+    bool today = sea_usage_today(&s_tracker, &d);
+    sea_usage_destroy(&s_tracker);
+    if (got) { FAIL("lookup created a provider"); return; }
+    if (today) { FAIL("idle tracker reports activity"); return; }
+    PASS();
+}
+
+/* ── Test: Histogram percentiles ─────────────────────────── */
+
+static void test_percentiles(void) {
+    TEST("latency_percentiles");
+    sea_usage_init(&s_tracker, NULL);
+
+    /* 98 fast requests, two slow ones */
+    for (u32 i = 0; i < 98; i++)
+        sea_usage_record_timed(&s_tracker, "OpenAI", 1, 1, false, 10000, 100000);
+    for (u32 i = 0; i < 2; i++)
+        sea_usage_record_timed(&s_tracker, "OpenAI", 1, 1, false, 500000, 2000000);
+    sea_usage_record(&s_tracker, "OpenAI", 1, 1, true);     /* Untimed */
+
+    SeaUsageProvider p;
+    bool got = sea_usage_provider(&s_tracker, "OpenAI", &p);
+    sea_usage_destroy(&s_tracker);
+
+    if (!got) { FAIL("provider missing"); return; }
+    if (p.requests != 101 || p.timed != 100) { FAIL("sample counts wrong"); return; }
+    /* Buckets are ~12% wide; the reported value is the bucket bound */
+    if (p.ttfb_p50_us < 10000 || p.ttfb_p50_us > 11300) { FAIL("ttfb p50 off"); return; }
+    if (p.total_p50_us < 100000 || p.total_p50_us > 113000) { FAIL("total p50 off"); return; }
+    if (p.total_p99_us < 2000000 || p.total_p99_us > 2260000) { FAIL("total p99 off"); return; }
+    PASS();
+}
+
+/* ── Test: Flush, reopen, load ───────────────────────────── */
+
+static void test_persist(void) {
+    TEST("flush_and_reload");
+    unlink(TEST_DB);
+
+    SeaDb* db = NULL;
+    if (sea_db_open(&db, TEST_DB) != SEA_OK) { FAIL("db open"); return; }
+    sea_usage_init(&s_tracker, db);
+    sea_usage_record(&s_tracker, "Anthropic", 100, 50, false);
+    sea_usage_flush(&s_tracker);
+    /* A second flush must add only the new delta */
+    sea_usage_record(&s_tracker, "Anthropic", 10, 5, true);
+    sea_usage_flush(&s_tracker);
+    sea_usage_flush(&s_tracker);
+    sea_usage_destroy(&s_tracker);
+    sea_db_close(db);
+
+    db = NULL;
+    if (sea_db_open(&db, TEST_DB) != SEA_OK) { FAIL("db reopen"); return; }
+    sea_usage_init(&s_tracker, db);
+    sea_usage_load(&s_tracker);
+    sea_usage_record(&s_tracker, "Anthropic", 1, 1, false);
+
+    SeaUsageProvider p;
+    bool got = sea_usage_provider(&s_tracker, "Anthropic", &p);
+    SeaUsageDay d;
+    bool today = sea_usage_today(&s_tracker, &d);
+    sea_usage_destroy(&s_tracker);
+    sea_db_close(db);
+
+    if (!got) { FAIL("provider not restored"); return; }
+    if (p.tokens_in != 111 || p.tokens_out != 56) { FAIL("tokens not accumulated"); return; }
+    if (p.requests != 3 || p.errors != 1) { FAIL("requests not accumulated"); return; }
+    if (!today || d.requests != 3 || d.tokens_in != 111) { FAIL("today's row wrong"); return; }
+    PASS();
+}
+
+/* ── Test: Background flusher ────────────────────────────── */
+
+static void test_flusher(void) {
+    TEST("background_flush");
+    unlink(TEST_DB);
+
+    SeaDb* db = NULL;
+    if (sea_db_open(&db, TEST_DB) != SEA_OK) { FAIL("db open"); return; }
+    sea_usage_init(&s_tracker, db);
+    sea_usage_start(&s_tracker, 20);
+    sea_usage_record(&s_tracker, "Gemini", 7, 7, false);
+    usleep(150 * 1000);
+
+    /* A second tracker on the same DB sees the flushed row */
+    SeaUsageTracker reader;
+    sea_usage_init(&reader, db);
+    sea_usage_load(&reader);
+    SeaUsageProvider p;
+    bool got = sea_usage_provider(&reader, "Gemini", &p);
+    sea_usage_destroy(&reader);
+
+    sea_usage_destroy(&s_tracker);
+    sea_db_close(db);
+
+    if (!got || p.tokens_in != 7) { FAIL("flusher did not persist"); return; }
+    PASS();
+}
+
+/* ── Test: Flusher keeps off the shared connection ───────── */
+
+static void test_flusher_own_conn(void) {
+    TEST("flusher_own_connection");
+    unlink(TEST_DB);
+
+    SeaDb* db = NULL;
+    if (sea_db_open(&db, TEST_DB) != SEA_OK) { FAIL("db open"); return; }
+    sea_usage_init(&s_tracker, db);
+    sea_usage_start(&s_tracker, 1);
+
+    /* Other subsystems write through the shared handle meanwhile; it
+     * must never find itself inside the flusher's transaction. */
+    sqlite3* shared = sea_db_handle(db);
+    bool in_txn = false;
+    for (int i = 0; i < 200 && !in_txn; i++) {
+        sea_usage_record(&s_tracker, "Mistral", 1, 1, false);
+        sea_db_config_set(db, "usage_test", "x");
+        in_txn = !sqlite3_get_autocommit(shared);
+        usleep(500);
+    }
+    bool separate = s_tracker.own_conn && s_tracker.conn != shared;
+    sea_usage_destroy(&s_tracker);
+    sea_db_close(db);
+
+    if (!separate) { FAIL("flusher shares the handle"); return; }
+    if (in_txn) { FAIL("shared handle left in a transaction"); return; }
+    PASS();
+}
+
+/* ── Test: Summary ───────────────────────────────────────── */
+
+static void test_summary(void) {
+    TEST("summary_format");
+    sea_usage_init(&s_tracker, NULL);
+    sea_usage_record_timed(&s_tracker, "Local", 4, 6, false, 2000, 30000);
+    char buf[2048];
+    u32 len = sea_usage_summary(&s_tracker, buf, sizeof(buf));
+    sea_usage_destroy(&s_tracker);
+    if (len == 0) { FAIL("empty summary"); return; }
+    if (!strstr(buf, "Total tokens: 10")) { FAIL("total missing"); return; }
+    if (!strstr(buf, "Local")) { FAIL("provider missing"); return; }
+    PASS();
+}
+
+int main(void) {
+    printf("\n  ═══ test_usage ═══\n\n");
+    sea_log_init(SEA_LOG_ERROR);
+
+    test_concurrent();
+    test_unknown();
+    test_percentiles();
+    test_persist();
+    test_flusher();
+    test_flusher_own_conn();
+    test_summary();
+
+    printf("\n  Results: %d passed, %d failed\n\n", s_pass, s_fail);
+
+    unlink(TEST_DB);
+    return s_fail > 0 ? 1 : 0;
+}
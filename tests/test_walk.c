@@ -0,0 +1,204 @@
+/*
+ * test_walk.c — Tests for the parallel directory walker
+ *
+ * Builds a small tree under /tmp and checks totals, filters,
+ * depth limits, early stop and the SIMD newline counter.
+ */
+
+#include "seaclaw/sea_types.h"
+#include "seaclaw/sea_walk.h"
+#include "seaclaw/sea_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+static u32 s_pass = 0;
+static u32 s_fail = 0;
+
+#define TEST(name) \
+    do { printf("  %-40s ", name); } while(0)
+
+#define PASS() \
+    do { printf("\033[32mPASS\033[0m\n"); s_pass++; } while(0)
+
+#define FAIL(msg) \
+    do { printf("\033[31mFAIL\033[0m (%s)\n", msg); s_fail++; } while(0)
+
+#define TEST_ROOT "/tmp/seaclaw_walk_test"
+
+/* ── Fixture ──────────────────────────────────────────────── */
+
+static void write_lines(const char* path, u32 lines) {
+    FILE* f = fopen(path, "w");
+    if (!f) return;
+    for (u32 i = 0; i < lines; i++) fprintf(f, "line %u\n", i);
+    fclose(f);
+}
+
+/* 10 dirs x (3 .c + 2 .h + 1 .txt), plus a nested level under d0. */
+static void build_tree(void) {
+    char path[256];
+    if (system("rm -rf " TEST_ROOT) != 0) { /* first run */ }
+    mkdir(TEST_ROOT, 0755);
+    for (u32 d = 0; d < 10; d++) {
+        snprintf(path, sizeof(path), TEST_ROOT "/d%u", d);
+        mkdir(path, 0755);
+        for (u32 f = 0; f < 3; f++) {
+            snprintf(path, sizeof(path), TEST_ROOT "/d%u/f%u.c", d, f);
+            write_lines(path, 10);
+        }
+        for (u32 f = 0; f < 2; f++) {
+            snprintf(path, sizeof(path), TEST_ROOT "/d%u/h%u.h", d, f);
+            write_lines(path, 5);
+        }
+        snprintf(path, sizeof(path), TEST_ROOT "/d%u/notes.txt", d);
+        write_lines(path, 1);
+    }
+    mkdir(TEST_ROOT "/d0/deep", 0755);
+    write_lines(TEST_ROOT "/d0/deep/inner.c", 100);
+    write_lines(TEST_ROOT "/.hidden.c", 7);
+}
+
+/* ── Tests ────────────────────────────────────────────────── */
+
+static void test_newlines(void) {
+    TEST("SIMD newline count matches scalar");
+    static u8 buf[100003];
+    u64 expect = 0;
+    for (u32 i = 0; i < sizeof(buf); i++) {
+        buf[i] = (u8)((i * 7919u) % 97 == 0 ? '\n' : 'a' + (i % 26));
+        expect += buf[i] == '\n';
+    }
+    for (u32 off = 0; off < 40; off++) {
+        u64 scalar = 0;
+        for (u32 i = off; i < sizeof(buf); i++) scalar += buf[i] == '\n';
+        if (sea_count_newlines(buf + off, sizeof(buf) - off) != scalar) {
+            FAIL("mismatch at offset"); return;
+        }
+    }
+    if (sea_count_newlines(buf, sizeof(buf)) != expect) { FAIL("full buffer"); return; }
+    if (sea_count_newlines(buf, 0) != 0) { FAIL("empty"); return; }
+    PASS();
+}
+
+static void test_name_match(void) {
+    TEST("name match: substring and glob");
+    if (!sea_walk_name_match("conf", "config.json"))   { FAIL("substring"); return; }
+    if (sea_walk_name_match("xyz", "config.json"))     { FAIL("substring miss"); return; }
+    if (!sea_walk_name_match("*.json", "config.json")) { FAIL("glob"); return; }
+    if (sea_walk_name_match("*.c", "main.h"))          { FAIL("glob miss"); return; }
+    if (!sea_walk_name_match(NULL, "anything"))        { FAIL("NULL pattern"); return; }
+    PASS();
+}
+
+static void test_totals(void) {
+    TEST("walk totals across threads");
+    SeaWalkOpts opts = { .root = TEST_ROOT, .threads = 4 };
+    SeaWalkStats st;
+    if (sea_walk(&opts, &st) != SEA_OK) { FAIL("walk failed"); return; }
+    if (st.dirs != 11)  { FAIL("dir count"); return; }
+    if (st.files != 62) { FAIL("file count"); return; }
+    if (st.errors != 0) { FAIL("errors"); return; }
+    PASS();
+}
+
+static void test_count_lines(void) {
+    TEST("count lines with extension filter");
+    SeaWalkOpts opts = {
+        .root = TEST_ROOT, .flags = SEA_WALK_FILES_ONLY | SEA_WALK_COUNT_LINES,
+        .exts = { ".c", ".h" },
+    };
+    SeaWalkStats st;
+    if (sea_walk(&opts, &st) != SEA_OK) { FAIL("walk failed"); return; }
+    /* 30 .c x10 + 20 .h x5 + inner.c 100 + .hidden.c 7 */
+    if (st.matched != 52)  { FAIL("matched"); return; }
+    if (st.lines != 507)   { FAIL("line total"); return; }
+    PASS();
+}
+
+static void test_skip_hidden_and_depth(void) {
+    TEST("skip hidden and max depth");
+    SeaWalkOpts opts = {
+        .root = TEST_ROOT, .max_depth = 2,
+        .flags = SEA_WALK_FILES_ONLY | SEA_WALK_SKIP_HIDDEN,
+        .name_pattern = "*.c",
+    };
+    SeaWalkStats st;
+    if (sea_walk(&opts, &st) != SEA_OK) { FAIL("walk failed"); return; }
+    if (st.matched != 30) { FAIL("depth-limited match count"); return; }
+    PASS();
+}
+
+static bool stop_after_five(const SeaWalkEntry* e, void* ctx) {
+    (void)e;
+    u32* n = (u32*)ctx;
+    return ++(*n) < 5;
+}
+
+static void test_early_stop(void) {
+    TEST("visitor can stop the walk");
+    u32 seen = 0;
+    SeaWalkOpts opts = {
+        .root = TEST_ROOT, .flags = SEA_WALK_FILES_ONLY,
+        .visit = stop_after_five, .ctx = &seen,
+    };
+    SeaWalkStats st;
+    if (sea_walk(&opts, &st) != SEA_OK) { FAIL("walk failed"); return; }
+    if (seen != 5)   { FAIL("visitor ran past stop"); return; }
+    if (!st.stopped) { FAIL("stopped flag"); return; }
+    PASS();
+}
+
+static void test_symlink_root(void) {
+    TEST("symlinked root is followed");
+    unlink(TEST_ROOT "_link");
+    if (symlink(TEST_ROOT, TEST_ROOT "_link") != 0) { FAIL("symlink"); return; }
+    SeaWalkOpts opts = { .root = TEST_ROOT "_link", .threads = 2 };
+    SeaWalkStats st;
+    SeaError err = sea_walk(&opts, &st);
+    unlink(TEST_ROOT "_link");
+    if (err != SEA_OK)  { FAIL("walk failed"); return; }
+    if (st.files != 62) { FAIL("file count"); return; }
+    if (st.errors != 0) { FAIL("errors"); return; }
+    PASS();
+}
+
+static void test_bad_root(void) {
+    TEST("missing root returns IO error");
+    SeaWalkOpts opts = { .root = TEST_ROOT "/nope" };
+    if (sea_walk(&opts, NULL) != SEA_ERR_IO) { FAIL("expected SEA_ERR_IO"); return; }
+    PASS();
+}
+
+/* ── Main ─────────────────────────────────────────────────── */
+
+int main(void) {
+    sea_log_init(SEA_LOG_WARN);
+
+    printf("\n  \033[1mSea-Claw Walker Tests\033[0m\n");
+    printf("  ════════════════════════════════════════════\n\n");
+
+    build_tree();
+
+    test_newlines();
+    test_name_match();
+    test_totals();
+    test_count_lines();
+    test_skip_hidden_and_depth();
+    test_early_stop();
+    test_symlink_root();
+    test_bad_root();
+
+    if (system("rm -rf " TEST_ROOT) != 0) { /* best effort */ }
+
+    printf("\n  ────────────────────────────────────────────\n");
+    printf("  Results: \033[32m%u passed\033[0m", s_pass);
+    if (s_fail > 0) printf(", \033[31m%u failed\033[0m", s_fail);
+    printf("\n\n");
+
+    return s_fail > 0 ? 1 : 0;
+}